@@ -0,0 +1,430 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraDefinition.h"
+#include "QGCDecompressDevice.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QLocale>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtXml/QDomDocument>
+#include <QtXml/QDomNodeList>
+
+QGC_LOGGING_CATEGORY(CameraDefinitionLog, "qgc.camera.cameradefinition")
+
+static bool _readAttribute(const QDomNode &node, const char *name, QString &target)
+{
+    const QDomNode attribute = node.attributes().namedItem(name);
+    if (attribute.isNull()) {
+        return false;
+    }
+    target = attribute.nodeValue();
+    return true;
+}
+
+static bool _readAttribute(const QDomNode &node, const char *name, bool &target)
+{
+    QString value;
+    if (!_readAttribute(node, name, value)) {
+        return false;
+    }
+    target = value != QStringLiteral("0");
+    return true;
+}
+
+static bool _readValue(const QDomNode &node, const char *name, QString &target)
+{
+    const QDomElement element = node.firstChildElement(name);
+    if (element.isNull()) {
+        return false;
+    }
+    target = element.text();
+    return true;
+}
+
+/// Text of every <itemName> below the first <listName> of node
+static QStringList _readList(const QDomNode &node, const char *listName, const char *itemName)
+{
+    QStringList result;
+    const QDomNodeList root = node.toElement().elementsByTagName(listName);
+    if (root.size()) {
+        const QDomNodeList items = root.item(0).toElement().elementsByTagName(itemName);
+        for (int i = 0; i < items.size(); i++) {
+            const QString text = items.item(i).toElement().text();
+            if (!text.isEmpty()) {
+                result << text;
+            }
+        }
+    }
+    return result;
+}
+
+static void _replaceLocaleStrings(const QDomNode &locale, QByteArray &bytes)
+{
+    const QDomNodeList strings = locale.toElement().elementsByTagName(QStringLiteral("strings"));
+    for (int i = 0; i < strings.size(); i++) {
+        QString original;
+        QString translated;
+        if (_readAttribute(strings.item(i), "original", original) && _readAttribute(strings.item(i), "translated", translated)) {
+            (void) bytes.replace(QStringLiteral("\"%1\"").arg(original).toUtf8(), QStringLiteral("\"%1\"").arg(translated).toUtf8());
+            (void) bytes.replace(QStringLiteral(">%1<").arg(original).toUtf8(), QStringLiteral(">%1<").arg(translated).toUtf8());
+        }
+    }
+}
+
+/// @return true if bytes were changed
+static bool _applyLocalization(const QDomDocument &doc, const QString &localeName, QByteArray &bytes)
+{
+    if (localeName.isEmpty() || (localeName == QStringLiteral("en_us"))) {
+        return false;
+    }
+
+    const QDomNodeList locRoot = doc.elementsByTagName(QStringLiteral("localization"));
+    if (!locRoot.size()) {
+        return false;
+    }
+
+    const QDomNodeList locales = locRoot.item(0).toElement().elementsByTagName(QStringLiteral("locale"));
+
+    // A direct match first, then the first locale of the same language
+    for (int i = 0; i < locales.size(); i++) {
+        QString name;
+        if (!_readAttribute(locales.item(i), "name", name)) {
+            qCWarning(CameraDefinitionLog) << "Localization entry is missing its name attribute";
+            continue;
+        }
+        if (localeName == name.toLower().replace(u'-', u'_')) {
+            _replaceLocaleStrings(locales.item(i), bytes);
+            return true;
+        }
+    }
+
+    const QString language = localeName.left(3);
+    for (int i = 0; i < locales.size(); i++) {
+        QString name;
+        (void) _readAttribute(locales.item(i), "name", name);
+        if (name.toLower().startsWith(language)) {
+            _replaceLocaleStrings(locales.item(i), bytes);
+            return true;
+        }
+    }
+
+    qCDebug(CameraDefinitionLog) << "No match for" << localeName << "in camera definition file";
+    return false;
+}
+
+static bool _parseParameter(const QDomNode &node, CameraDefinition::Parameter &parameter, QString &errorString)
+{
+    if (!_readAttribute(node, "name", parameter.name)) {
+        errorString = QStringLiteral("Parameter entry missing parameter name");
+        return false;
+    }
+    if (!_readAttribute(node, "type", parameter.type)) {
+        errorString = QStringLiteral("Parameter %1 missing parameter type").arg(parameter.name);
+        return false;
+    }
+    if (!_readValue(node, "description", parameter.description)) {
+        errorString = QStringLiteral("Parameter %1 missing parameter description").arg(parameter.name);
+        return false;
+    }
+
+    (void) _readAttribute(node, "control", parameter.control);
+    (void) _readAttribute(node, "readonly", parameter.readOnly);
+    (void) _readAttribute(node, "writeonly", parameter.writeOnly);
+
+    static constexpr struct { const char *name; CameraDefinition::Attribute flag; QString CameraDefinition::Parameter::*value; } optionalAttributes[] = {
+        { "default",        CameraDefinition::HasDefault,       &CameraDefinition::Parameter::defaultValue },
+        { "min",            CameraDefinition::HasMin,           &CameraDefinition::Parameter::min },
+        { "max",            CameraDefinition::HasMax,           &CameraDefinition::Parameter::max },
+        { "step",           CameraDefinition::HasStep,          &CameraDefinition::Parameter::step },
+        { "decimalPlaces",  CameraDefinition::HasDecimalPlaces, &CameraDefinition::Parameter::decimalPlaces },
+        { "unit",           CameraDefinition::HasUnit,          &CameraDefinition::Parameter::unit },
+    };
+    for (const auto &attribute : optionalAttributes) {
+        if (_readAttribute(node, attribute.name, parameter.*attribute.value)) {
+            parameter.attributes |= attribute.flag;
+        }
+    }
+
+    parameter.updates = _readList(node, "updates", "update");
+
+    const QDomNodeList optionsRoot = node.toElement().elementsByTagName(QStringLiteral("options"));
+    if (!optionsRoot.size()) {
+        return true;
+    }
+
+    const QDomNodeList options = optionsRoot.item(0).toElement().elementsByTagName(QStringLiteral("option"));
+    parameter.options.reserve(options.size());
+    for (int i = 0; i < options.size(); i++) {
+        const QDomNode optionNode = options.item(i);
+        CameraDefinition::Option option;
+        if (!_readAttribute(optionNode, "name", option.name)) {
+            errorString = QStringLiteral("Malformed option for parameter %1").arg(parameter.name);
+            return false;
+        }
+        if (!_readAttribute(optionNode, "value", option.value)) {
+            errorString = QStringLiteral("Malformed value for parameter %1").arg(parameter.name);
+            return false;
+        }
+        option.exclusions = _readList(optionNode, "exclusions", "exclude");
+
+        const QDomNodeList rangeRoot = optionNode.toElement().elementsByTagName(QStringLiteral("parameterranges"));
+        if (rangeRoot.size()) {
+            const QDomNodeList parameterRanges = rangeRoot.item(0).toElement().elementsByTagName(QStringLiteral("parameterrange"));
+            for (int j = 0; j < parameterRanges.size(); j++) {
+                const QDomNode rangeNode = parameterRanges.item(j);
+                CameraDefinition::Range range;
+                if (!_readAttribute(rangeNode, "parameter", range.targetParam)) {
+                    errorString = QStringLiteral("Malformed option range for parameter %1").arg(parameter.name);
+                    return false;
+                }
+                (void) _readAttribute(rangeNode, "condition", range.condition);
+
+                const QDomNodeList rangeOptions = rangeNode.toElement().elementsByTagName(QStringLiteral("roption"));
+                for (int k = 0; k < rangeOptions.size(); k++) {
+                    QString optName;
+                    QString optValue;
+                    if (!_readAttribute(rangeOptions.item(k), "name", optName)) {
+                        errorString = QStringLiteral("Malformed roption for parameter %1").arg(parameter.name);
+                        return false;
+                    }
+                    if (!_readAttribute(rangeOptions.item(k), "value", optValue)) {
+                        errorString = QStringLiteral("Malformed rvalue for parameter %1").arg(parameter.name);
+                        return false;
+                    }
+                    range.optNames << optName;
+                    range.optValues << optValue;
+                }
+                if (!range.optNames.isEmpty()) {
+                    option.ranges.append(range);
+                }
+            }
+        }
+
+        parameter.options.append(option);
+    }
+
+    return true;
+}
+
+bool CameraDefinition::parse(const QByteArray &bytes, const QString &localeName, CameraDefinition &definition, QString &errorString, bool *wellFormed)
+{
+    definition = CameraDefinition();
+    if (wellFormed) {
+        *wellFormed = false;
+    }
+
+    QDomDocument doc;
+    QDomDocument::ParseResult result = doc.setContent(bytes);
+    if (result) {
+        QByteArray localized = bytes;
+        if (_applyLocalization(doc, localeName.toLower().replace(u'-', u'_'), localized)) {
+            doc.clear();
+            result = doc.setContent(localized);
+        }
+    }
+    if (!result) {
+        errorString = QStringLiteral("Unable to parse camera definition file on line %1: %2").arg(result.errorLine).arg(result.errorMessage);
+        return false;
+    }
+    if (wellFormed) {
+        *wellFormed = true;
+    }
+
+    const QDomNodeList defElements = doc.elementsByTagName(QStringLiteral("definition"));
+    if (!defElements.size()) {
+        errorString = QStringLiteral("Unable to load camera constants from camera definition");
+        return false;
+    }
+    const QDomNode defNode = defElements.item(0);
+    QString version;
+    if (!_readAttribute(defNode, "version", version) || !_readValue(defNode, "model", definition.model) || !_readValue(defNode, "vendor", definition.vendor)) {
+        errorString = QStringLiteral("Unable to load camera constants from camera definition");
+        return false;
+    }
+    definition.version = version.toInt();
+
+    const QDomNodeList paramElements = doc.elementsByTagName(QStringLiteral("parameters"));
+    if (!paramElements.size()) {
+        errorString = QStringLiteral("No parameters to load from camera");
+        return false;
+    }
+
+    const QDomNodeList parameters = paramElements.item(0).toElement().elementsByTagName(QStringLiteral("parameter"));
+    definition.parameters.reserve(parameters.size());
+    for (int i = 0; i < parameters.size(); i++) {
+        Parameter parameter;
+        if (!_parseParameter(parameters.item(i), parameter, errorString)) {
+            return false;
+        }
+        definition.parameters.append(parameter);
+    }
+
+    return true;
+}
+
+QString CameraDefinition::systemLocaleName()
+{
+    QLocale locale = QLocale::system();
+#if defined (Q_OS_MAC)
+    locale = QLocale(locale.name());
+#endif
+    return locale.name().toLower().replace(u'-', u'_');
+}
+
+QString CameraDefinition::cacheKey(const QByteArray &bytes, const QString &localeName)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArray::number(kCacheVersion));
+    hash.addData(localeName.toUtf8());
+    hash.addData(bytes);
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString CameraDefinition::defaultCacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/QGCCameraDefinitionCache");
+}
+
+CameraDefinition::LoadResult CameraDefinition::load(QByteArray bytes, const QString &fileName, const QString &cacheDir, const QString &localeName, const QString &xmlCopyFile)
+{
+    LoadResult result;
+
+    if (bytes.isEmpty()) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            result.errorString = QStringLiteral("Could not read camera definition file %1: %2").arg(fileName, file.errorString());
+            return result;
+        }
+
+        if (fileName.endsWith(QStringLiteral(".lzma"), Qt::CaseInsensitive) || fileName.endsWith(QStringLiteral(".xz"), Qt::CaseInsensitive)) {
+            // Decompressed as it is read, without an intermediate xml file
+            QGCDecompressDevice decompressor(&file, QGCDecompressDevice::Xz);
+            if (decompressor.open(QIODevice::ReadOnly)) {
+                bytes = decompressor.readAll();
+            }
+            if (!decompressor.isFinished()) {
+                result.errorString = QStringLiteral("Inflate of compressed xml failed: %1").arg(fileName);
+                return result;
+            }
+            file.close();
+            (void) QFile::remove(fileName);
+        } else {
+            bytes = file.readAll();
+        }
+    }
+
+    const QString key = cacheKey(bytes, localeName);
+    const QString cacheFileName = cacheDir.isEmpty() ? QString() : QDir(cacheDir).filePath(key + QStringLiteral(".camdef"));
+
+    if (!cacheFileName.isEmpty()) {
+        QFile cacheFile(cacheFileName);
+        if (cacheFile.open(QIODevice::ReadOnly)) {
+            QDataStream stream(&cacheFile);
+            stream.setVersion(QDataStream::Qt_6_0);
+            quint32 magic = 0;
+            quint32 version = 0;
+            stream >> magic >> version;
+            if ((magic == kCacheMagic) && (version == kCacheVersion)) {
+                stream >> result.definition;
+                if (stream.status() == QDataStream::Ok) {
+                    result.valid = true;
+                    result.wellFormed = true;
+                    result.fromCache = true;
+                }
+            }
+            if (!result.valid) {
+                qCWarning(CameraDefinitionLog) << "Discarding unreadable cache entry" << cacheFileName;
+                cacheFile.close();
+                (void) cacheFile.remove();
+                result.definition = CameraDefinition();
+            }
+        }
+    }
+
+    if (!result.valid) {
+        result.valid = parse(bytes, localeName, result.definition, result.errorString, &result.wellFormed);
+
+        if (result.valid && !cacheFileName.isEmpty()) {
+            (void) QDir().mkpath(cacheDir);
+            QSaveFile cacheFile(cacheFileName);
+            if (cacheFile.open(QIODevice::WriteOnly)) {
+                QDataStream stream(&cacheFile);
+                stream.setVersion(QDataStream::Qt_6_0);
+                stream << kCacheMagic << kCacheVersion << result.definition;
+                if (!cacheFile.commit()) {
+                    qCWarning(CameraDefinitionLog) << "Could not write cache entry" << cacheFileName << cacheFile.errorString();
+                }
+            }
+        }
+    }
+
+    if (result.valid && !xmlCopyFile.isEmpty()) {
+        QSaveFile xmlFile(xmlCopyFile);
+        if (!xmlFile.open(QIODevice::WriteOnly) || (xmlFile.write(bytes) != bytes.size()) || !xmlFile.commit()) {
+            qCWarning(CameraDefinitionLog) << "Could not save camera definition file" << xmlCopyFile << xmlFile.errorString();
+        }
+    }
+
+    return result;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Range &range)
+{
+    return stream << range.targetParam << range.condition << range.optNames << range.optValues;
+}
+
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Range &range)
+{
+    return stream >> range.targetParam >> range.condition >> range.optNames >> range.optValues;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Option &option)
+{
+    return stream << option.name << option.value << option.exclusions << option.ranges;
+}
+
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Option &option)
+{
+    return stream >> option.name >> option.value >> option.exclusions >> option.ranges;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Parameter &parameter)
+{
+    return stream << parameter.name << parameter.type << parameter.description
+                  << parameter.control << parameter.readOnly << parameter.writeOnly << parameter.attributes
+                  << parameter.defaultValue << parameter.min << parameter.max << parameter.step << parameter.decimalPlaces << parameter.unit
+                  << parameter.updates << parameter.options;
+}
+
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Parameter &parameter)
+{
+    return stream >> parameter.name >> parameter.type >> parameter.description
+                  >> parameter.control >> parameter.readOnly >> parameter.writeOnly >> parameter.attributes
+                  >> parameter.defaultValue >> parameter.min >> parameter.max >> parameter.step >> parameter.decimalPlaces >> parameter.unit
+                  >> parameter.updates >> parameter.options;
+}
+
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition &definition)
+{
+    return stream << static_cast<qint32>(definition.version) << definition.model << definition.vendor << definition.parameters;
+}
+
+QDataStream &operator>>(QDataStream &stream, CameraDefinition &definition)
+{
+    qint32 version = 0;
+    stream >> version >> definition.model >> definition.vendor >> definition.parameters;
+    definition.version = version;
+    return stream;
+}
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class QDataStream;
+
+Q_DECLARE_LOGGING_CATEGORY(CameraDefinitionLog)
+
+/// Camera definition file contents, parsed into plain values.
+///
+/// Holds no QObjects so it can be parsed on a worker thread and handed to the camera control, and so that it
+/// can be cached on disk in binary form instead of being parsed again every time the camera connects.
+struct CameraDefinition
+{
+    struct Range {
+        QString     targetParam;
+        QString     condition;
+        QStringList optNames;
+        QStringList optValues;
+    };
+
+    struct Option {
+        QString     name;
+        QString     value;
+        QStringList exclusions;
+        QList<Range> ranges;
+    };
+
+    enum Attribute {
+        HasDefault          = 1 << 0,
+        HasMin              = 1 << 1,
+        HasMax              = 1 << 2,
+        HasStep             = 1 << 3,
+        HasDecimalPlaces    = 1 << 4,
+        HasUnit             = 1 << 5
+    };
+
+    struct Parameter {
+        QString     name;
+        QString     type;
+        QString     description;
+        bool        control     = true;
+        bool        readOnly    = false;
+        bool        writeOnly   = false;
+        quint32     attributes  = 0;    ///< Attribute flags for the optional values below
+        QString     defaultValue;
+        QString     min;
+        QString     max;
+        QString     step;
+        QString     decimalPlaces;
+        QString     unit;
+        QStringList updates;
+        QList<Option> options;
+    };
+
+    int         version = 0;
+    QString     model;
+    QString     vendor;
+    QList<Parameter> parameters;
+
+    /// Parses a camera definition, applying the localization for localeName first
+    ///     @param localeName For example "de_DE", empty or "en_US" for none
+    ///     @param[out] errorString Set when false is returned
+    ///     @param[out] wellFormed Set to true if the XML itself could be read, even if the definition was rejected
+    static bool parse(const QByteArray &bytes, const QString &localeName, CameraDefinition &definition, QString &errorString, bool *wellFormed = nullptr);
+
+    /// @return Current locale in the form used by camera definition localizations
+    static QString systemLocaleName();
+
+    /// Result of load()
+    struct LoadResult {
+        CameraDefinition definition;
+        bool        valid       = false;    ///< Definition was loaded
+        bool        wellFormed  = false;    ///< Source was readable XML, even if the definition itself was rejected
+        bool        fromCache   = false;    ///< Came from the pre-parsed cache
+        QString     errorString;
+    };
+
+    /// Loads a definition, from the pre-parsed cache when the same content has been seen before. Thread safe, meant
+    /// to be run on a worker thread.
+    ///     @param bytes Definition file content. If empty, fileName is read instead. .xz/.lzma files are inflated in memory and removed.
+    ///     @param cacheDir Directory for pre-parsed definitions, empty to not use the cache
+    ///     @param xmlCopyFile If not empty, the source of a valid definition is also copied here
+    static LoadResult load(QByteArray bytes, const QString &fileName, const QString &cacheDir, const QString &localeName, const QString &xmlCopyFile = QString());
+
+    /// Pre-parsed cache key: hash of the content, the locale and the cache format
+    static QString cacheKey(const QByteArray &bytes, const QString &localeName);
+
+    /// Default pre-parsed cache location
+    static QString defaultCacheDir();
+
+    static constexpr quint32 kCacheMagic    = 0x51434344;   ///< "QCCD"
+    static constexpr quint32 kCacheVersion  = 1;
+};
+
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Range &range);
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Range &range);
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Option &option);
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Option &option);
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition::Parameter &parameter);
+QDataStream &operator>>(QDataStream &stream, CameraDefinition::Parameter &parameter);
+QDataStream &operator<<(QDataStream &stream, const CameraDefinition &definition);
+QDataStream &operator>>(QDataStream &stream, CameraDefinition &definition);
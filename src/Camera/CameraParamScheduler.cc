@@ -0,0 +1,230 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraParamScheduler.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(CameraParamSchedulerLog, "qgc.camera.cameraparamscheduler")
+
+CameraParamScheduler::CameraParamScheduler(const Sender &sender, QObject *parent)
+    : QObject(parent)
+    , _sender(sender)
+{
+    _clock.start();
+    _serviceTimer.setInterval(kServiceInterval);
+    (void) connect(&_serviceTimer, &QTimer::timeout, this, &CameraParamScheduler::_service);
+}
+
+bool CameraParamScheduler::busy() const
+{
+    return _listActive || !_readQueue.isEmpty() || !_readsInFlight.isEmpty() || !_writeQueue.isEmpty() || !_writesInFlight.isEmpty();
+}
+
+void CameraParamScheduler::_kick()
+{
+    _service();
+    if (busy() && !_serviceTimer.isActive()) {
+        _serviceTimer.start();
+    }
+}
+
+void CameraParamScheduler::requestAll(const QStringList &params)
+{
+    _listOrder.clear();
+    _listPending.clear();
+    for (const QString &param : params) {
+        // Individual reads already under way carry on as they are
+        if (!_readQueue.contains(param) && !_readsInFlight.contains(param) && !_listPending.contains(param)) {
+            _listOrder.append(param);
+            _listPending.insert(param);
+        }
+    }
+    if (_listPending.isEmpty()) {
+        return;
+    }
+
+    qCDebug(CameraParamSchedulerLog) << "Request list for" << _listPending.count() << "params";
+    _sender.requestList();
+    _listActive = true;
+    _listDeadline = _clock.elapsed() + _readTimeout;
+    _kick();
+}
+
+void CameraParamScheduler::requestRead(const QString &param)
+{
+    if (_listPending.contains(param) || _readQueue.contains(param) || _readsInFlight.contains(param)) {
+        return;
+    }
+
+    _readQueue.append(param);
+    _kick();
+}
+
+void CameraParamScheduler::queueWrite(const QString &param)
+{
+    if (_writeQueue.contains(param)) {
+        // Still waiting for its turn, the latest value goes out when it does
+        _writesCoalesced++;
+        return;
+    }
+    if (_writesInFlight.contains(param)) {
+        _writesDirty.insert(param);
+        return;
+    }
+
+    _writeQueue.append(param);
+    _kick();
+}
+
+void CameraParamScheduler::valueReceived(const QString &param)
+{
+    bool wanted = false;
+    if (_listPending.remove(param)) {
+        wanted = true;
+    }
+    if (_listActive) {
+        // The camera is still streaming the list, give it time to finish
+        _listDeadline = _clock.elapsed() + _listQuietTime;
+    }
+    if (_readQueue.removeOne(param)) {
+        wanted = true;
+    }
+    if (_readsInFlight.remove(param)) {
+        wanted = true;
+    }
+
+    if (wanted) {
+        emit readComplete(param, true);
+    }
+}
+
+bool CameraParamScheduler::ackReceived(const QString &param, int result)
+{
+    auto it = _writesInFlight.find(param);
+    if (it == _writesInFlight.end()) {
+        return true;
+    }
+
+    switch (result) {
+    case PARAM_ACK_ACCEPTED:
+        _finishWrite(param, true);
+        return true;
+    case PARAM_ACK_IN_PROGRESS:
+        // Wait a bit longer for this one
+        it->deadline = _clock.elapsed() + _writeTimeout;
+        return false;
+    case PARAM_ACK_FAILED:
+        if (it->retries < _maxRetries) {
+            // Resent on the next service pass
+            it->deadline = _clock.elapsed();
+            _kick();
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    _finishWrite(param, false);
+    return true;
+}
+
+void CameraParamScheduler::_finishWrite(const QString &param, bool accepted)
+{
+    (void) _writesInFlight.remove(param);
+    if (_writesDirty.remove(param)) {
+        _writeQueue.append(param);
+    }
+
+    emit writeComplete(param, accepted);
+    _kick();
+}
+
+void CameraParamScheduler::_service()
+{
+    const qint64 now = _clock.elapsed();
+
+    // Whatever the list did not deliver is requested individually
+    if (_listActive && (now >= _listDeadline)) {
+        _listActive = false;
+        if (!_listPending.isEmpty()) {
+            qCDebug(CameraParamSchedulerLog) << "Request list missed" << _listPending.count() << "params";
+            for (const QString &param : std::as_const(_listOrder)) {
+                if (_listPending.contains(param)) {
+                    _readQueue.append(param);
+                }
+            }
+            _listPending.clear();
+        }
+        _listOrder.clear();
+    }
+
+    QStringList failedReads;
+    for (auto it = _readsInFlight.begin(); it != _readsInFlight.end(); ) {
+        if (now < it->deadline) {
+            ++it;
+        } else if (it->retries >= _maxRetries) {
+            qCWarning(CameraParamSchedulerLog) << "No response for param request:" << it.key();
+            failedReads << it.key();
+            it = _readsInFlight.erase(it);
+        } else {
+            qCDebug(CameraParamSchedulerLog) << "Param request retry:" << it.key();
+            it->retries++;
+            it->deadline = now + _readTimeout;
+            _sender.requestRead(it.key());
+            _readsSent++;
+            ++it;
+        }
+    }
+
+    while (!_readQueue.isEmpty() && (_readsInFlight.count() < _readWindow)) {
+        const QString param = _readQueue.takeFirst();
+        _readsInFlight[param] = Pending{ 0, now + _readTimeout };
+        _sender.requestRead(param);
+        _readsSent++;
+    }
+
+    QStringList failedWrites;
+    for (auto it = _writesInFlight.begin(); it != _writesInFlight.end(); ++it) {
+        if (now < it->deadline) {
+            continue;
+        }
+        if (it->retries >= _maxRetries) {
+            qCWarning(CameraParamSchedulerLog) << "No response for param set:" << it.key();
+            failedWrites << it.key();
+        } else {
+            qCDebug(CameraParamSchedulerLog) << "Param set retry:" << it.key();
+            it->retries++;
+            it->deadline = now + _writeTimeout;
+            _sender.write(it.key());
+            _writesSent++;
+        }
+    }
+
+    while (!_writeQueue.isEmpty() && (_writesInFlight.count() < _writeWindow) && (now >= _nextWriteTime)) {
+        const QString param = _writeQueue.takeFirst();
+        _writesInFlight[param] = Pending{ 0, now + _writeTimeout };
+        _nextWriteTime = now + _writeInterval;
+        _sender.write(param);
+        _writesSent++;
+    }
+
+    if (!busy()) {
+        _serviceTimer.stop();
+    }
+
+    // Signalled last, receivers may queue new work
+    for (const QString &param : std::as_const(failedReads)) {
+        emit readComplete(param, false);
+    }
+    for (const QString &param : std::as_const(failedWrites)) {
+        _finishWrite(param, false);
+    }
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+#include <functional>
+
+Q_DECLARE_LOGGING_CATEGORY(CameraParamSchedulerLog)
+
+/// Schedules the PARAM_EXT traffic of one camera.
+///
+/// All parameters of a camera share this scheduler instead of each running its own timers. Reads start with a
+/// single PARAM_EXT_REQUEST_LIST; once the camera goes quiet only the parameters which did not arrive are requested
+/// individually, with a limited number outstanding at a time. Writes are rate limited, and a parameter which changes
+/// again before its write went out is only sent once, with its latest value.
+///
+/// The scheduler only tracks the protocol state, the messages themselves are built by the Sender callbacks.
+class CameraParamScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Sender {
+        std::function<void()>                   requestList;    ///< Send PARAM_EXT_REQUEST_LIST
+        std::function<void(const QString&)>     requestRead;    ///< Send PARAM_EXT_REQUEST_READ for the parameter
+        std::function<void(const QString&)>     write;          ///< Send PARAM_EXT_SET with the current value of the parameter
+    };
+
+    explicit CameraParamScheduler(const Sender &sender, QObject *parent = nullptr);
+
+    /// Requests the value of all params, starting with PARAM_EXT_REQUEST_LIST
+    void requestAll(const QStringList &params);
+
+    /// Requests a single parameter. Does nothing if the parameter is already being read.
+    void requestRead(const QString &param);
+
+    /// Queues a write of the parameter's current value
+    void queueWrite(const QString &param);
+
+    /// Call for every PARAM_EXT_VALUE received from the camera
+    void valueReceived(const QString &param);
+
+    /// Call for every PARAM_EXT_ACK received from the camera
+    ///     @param result PARAM_ACK value
+    ///     @return true if the write is finished, false if it will be retried
+    bool ackReceived(const QString &param, int result);
+
+    /// @return true while reads or writes are outstanding
+    bool busy() const;
+
+    void setReadWindow      (int count)     { _readWindow = qMax(1, count); }
+    void setWriteWindow     (int count)     { _writeWindow = qMax(1, count); }
+    void setWriteInterval   (int msecs)     { _writeInterval = msecs; }
+    void setReadTimeout     (int msecs)     { _readTimeout = msecs; }
+    void setWriteTimeout    (int msecs)     { _writeTimeout = msecs; }
+    void setListQuietTime   (int msecs)     { _listQuietTime = msecs; }
+    void setMaxRetries      (int count)     { _maxRetries = count; }
+
+    int readsSent       () const { return _readsSent; }         ///< Individual PARAM_EXT_REQUEST_READ messages
+    int writesSent      () const { return _writesSent; }        ///< PARAM_EXT_SET messages, including retries
+    int writesCoalesced () const { return _writesCoalesced; }   ///< Writes folded into one which was still queued
+
+    static constexpr int kDefaultReadWindow     = 8;
+    static constexpr int kDefaultWriteWindow    = 4;
+    static constexpr int kDefaultWriteInterval  = 50;
+    static constexpr int kDefaultReadTimeout    = 2000;
+    static constexpr int kDefaultWriteTimeout   = 3000;
+    static constexpr int kDefaultListQuietTime  = 1000;
+    static constexpr int kDefaultMaxRetries     = 3;
+
+signals:
+    /// A read finished
+    ///     @param received false if the camera never answered
+    void readComplete(const QString &param, bool received);
+
+    /// A write finished
+    ///     @param accepted false if the camera rejected the value or never answered
+    void writeComplete(const QString &param, bool accepted);
+
+private slots:
+    void _service();
+
+private:
+    struct Pending {
+        int     retries     = 0;
+        qint64  deadline    = 0;
+    };
+
+    void _kick();
+    void _finishWrite(const QString &param, bool accepted);
+
+    Sender                  _sender;
+    QTimer                  _serviceTimer;
+    QElapsedTimer           _clock;
+
+    bool                    _listActive     = false;
+    qint64                  _listDeadline   = 0;
+    QStringList             _listOrder;
+    QSet<QString>           _listPending;
+
+    QStringList             _readQueue;
+    QHash<QString, Pending> _readsInFlight;
+
+    QStringList             _writeQueue;
+    QHash<QString, Pending> _writesInFlight;
+    QSet<QString>           _writesDirty;       ///< Changed again while the previous write was in flight
+    qint64                  _nextWriteTime  = 0;
+
+    int                     _readWindow     = kDefaultReadWindow;
+    int                     _writeWindow    = kDefaultWriteWindow;
+    int                     _writeInterval  = kDefaultWriteInterval;
+    int                     _readTimeout    = kDefaultReadTimeout;
+    int                     _writeTimeout   = kDefaultWriteTimeout;
+    int                     _listQuietTime  = kDefaultListQuietTime;
+    int                     _maxRetries     = kDefaultMaxRetries;
+
+    int                     _readsSent      = 0;
+    int                     _writesSent     = 0;
+    int                     _writesCoalesced = 0;
+
+    static constexpr int kServiceInterval = 20;
+};
@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraRuleTable.h"
+#include "CameraDefinition.h"
+
+void CameraRuleTable::clear()
+{
+    _parameters.clear();
+    _parameterIndex.clear();
+    _exclusions.clear();
+    _ranges.clear();
+    _rangesByParam.clear();
+    _conditions.clear();
+}
+
+void CameraRuleTable::compile(const CameraDefinition &definition)
+{
+    clear();
+
+    for (const CameraDefinition::Parameter &parameter : definition.parameters) {
+        for (const CameraDefinition::Option &option : parameter.options) {
+            if (!option.exclusions.isEmpty()) {
+                const int param = _internParameter(parameter.name);
+                _exclusions[param][option.value] << option.exclusions;
+                qCDebug(CameraDefinitionLog) << "New exclusions:" << parameter.name << option.value << option.exclusions;
+            }
+
+            for (const CameraDefinition::Range &definitionRange : option.ranges) {
+                Range range;
+                range.param = _internParameter(parameter.name);
+                range.value = option.value;
+                range.target = _internParameter(definitionRange.targetParam);
+                range.condition = addCondition(definitionRange.condition);
+                range.optNames = definitionRange.optNames;
+                range.optValues = definitionRange.optValues;
+
+                const int rangeIndex = _ranges.count();
+                _ranges.append(range);
+
+                QList<int> dependsOn = { range.param };
+                for (const Test &test : _conditions[range.condition].tests) {
+                    if ((test.param >= 0) && !dependsOn.contains(test.param)) {
+                        dependsOn << test.param;
+                    }
+                }
+                for (int param : dependsOn) {
+                    _rangesByParam[param] << rangeIndex;
+                }
+
+                qCDebug(CameraDefinitionLog) << "New range limit:" << parameter.name << option.value << definitionRange.targetParam << definitionRange.condition << range.optNames << range.optValues;
+            }
+        }
+    }
+}
+
+int CameraRuleTable::_internParameter(const QString &name)
+{
+    const auto it = _parameterIndex.constFind(name);
+    if (it != _parameterIndex.constEnd()) {
+        return it.value();
+    }
+
+    const int index = _parameters.count();
+    _parameters << name;
+    _parameterIndex[name] = index;
+    return index;
+}
+
+int CameraRuleTable::addCondition(const QString &condition)
+{
+    Condition compiled;
+    compiled.text = condition;
+
+    // "test [AND|OR test]...", anything but AND joins with OR
+    const QStringList tokens = condition.split(u' ', Qt::SkipEmptyParts);
+    bool orWithPrevious = false;
+    for (qsizetype i = 0; i < tokens.count(); i += 2) {
+        const QString &testText = tokens[i];
+
+        Test test;
+        QString separator;
+        if (testText.contains(QStringLiteral("!="))) {
+            separator = QStringLiteral("!=");
+            test.op = OpNotEqual;
+        } else if (testText.contains(u'=')) {
+            separator = QStringLiteral("=");
+            test.op = OpEqual;
+        } else if (testText.contains(u'>')) {
+            separator = QStringLiteral(">");
+            test.op = OpGreater;
+        } else if (testText.contains(u'<')) {
+            separator = QStringLiteral("<");
+            test.op = OpSmaller;
+        }
+
+        const QStringList operands = separator.isEmpty() ? QStringList() : testText.split(separator, Qt::SkipEmptyParts);
+        if (operands.count() == 2) {
+            test.param = _internParameter(operands[0]);
+            test.value = operands[1];
+        } else {
+            test.op = OpInvalid;
+            test.value = testText;
+        }
+
+        compiled.tests << test;
+        compiled.orWithPrevious << orWithPrevious;
+
+        if (i + 1 < tokens.count()) {
+            orWithPrevious = tokens[i + 1].toUpper() != QStringLiteral("AND");
+        }
+    }
+
+    _conditions.append(compiled);
+    return _conditions.count() - 1;
+}
+
+bool CameraRuleTable::_evaluateTest(const Test &test, const ValueLookup &valueOf, const QString &conditionText, const QStringList &parameters)
+{
+    if (test.op == OpInvalid) {
+        qCWarning(CameraDefinitionLog) << "Invalid condition" << test.value << "in" << conditionText;
+        return false;
+    }
+
+    QString value;
+    if (!valueOf(test.param, value)) {
+        qCWarning(CameraDefinitionLog) << "Invalid condition parameter:" << parameters[test.param] << "in" << conditionText;
+        return false;
+    }
+
+    switch (test.op) {
+    case OpEqual:
+        return value == test.value;
+    case OpNotEqual:
+        return value != test.value;
+    case OpGreater:
+        return value > test.value;
+    case OpSmaller:
+        return value < test.value;
+    case OpInvalid:
+        break;
+    }
+
+    return false;
+}
+
+bool CameraRuleTable::evaluate(int condition, const ValueLookup &valueOf) const
+{
+    if ((condition < 0) || (condition >= _conditions.count())) {
+        return true;
+    }
+
+    const Condition &compiled = _conditions[condition];
+    bool result = true;
+    for (qsizetype i = 0; i < compiled.tests.count(); i++) {
+        if (compiled.orWithPrevious[i]) {
+            result = result || _evaluateTest(compiled.tests[i], valueOf, compiled.text, _parameters);
+        } else {
+            result = result && _evaluateTest(compiled.tests[i], valueOf, compiled.text, _parameters);
+        }
+    }
+
+    return result;
+}
+
+QStringList CameraRuleTable::exclusions(const ValueLookup &valueOf) const
+{
+    QStringList excluded;
+    for (auto it = _exclusions.constBegin(); it != _exclusions.constEnd(); ++it) {
+        QString value;
+        if (valueOf(it.key(), value)) {
+            const auto match = it.value().constFind(value);
+            if (match != it.value().constEnd()) {
+                excluded << match.value();
+            }
+        }
+    }
+
+    return excluded;
+}
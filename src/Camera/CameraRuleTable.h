@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+#include <QtCore/QVariantList>
+
+#include <functional>
+
+struct CameraDefinition;
+
+/// Option exclusions and parameter ranges of a camera definition, compiled once into indexed form.
+///
+/// Parameters referenced by rules are numbered, conditions are split into their individual tests up front and every
+/// rule is indexed by the parameters it depends on. Evaluating rules after a parameter change is then a few hash
+/// lookups and string compares instead of re-parsing every condition string of the definition.
+class CameraRuleTable
+{
+public:
+    /// Looks up the current raw value of a rule parameter
+    ///     @return false if the parameter does not exist
+    using ValueLookup = std::function<bool(int param, QString &value)>;
+
+    /// Limits the options of targetParam while param has value and condition holds
+    struct Range {
+        int         param       = -1;
+        QString     value;
+        int         target      = -1;
+        int         condition   = -1;
+        QStringList optNames;
+        QStringList optValues;
+        QVariantList optVariants;   ///< Filled in by the owner once the target's type is known
+    };
+
+    void compile(const CameraDefinition &definition);
+    void clear();
+
+    /// Names of all parameters referenced by rules, a parameter's position is its index
+    const QStringList &parameters() const { return _parameters; }
+    int parameterIndex(const QString &name) const { return _parameterIndex.value(name, -1); }
+
+    /// @return Names of the settings excluded by the current parameter values
+    QStringList exclusions(const ValueLookup &valueOf) const;
+
+    QList<Range> &ranges() { return _ranges; }
+    const QList<Range> &ranges() const { return _ranges; }
+
+    /// @return Indices of the ranges which depend on param, either as their source or through their condition
+    QList<int> rangesFor(int param) const { return _rangesByParam.value(param); }
+
+    /// Evaluates a compiled condition. Tests are combined left to right, AND and OR have equal precedence.
+    bool evaluate(int condition, const ValueLookup &valueOf) const;
+
+    /// Compiles a stand-alone condition, for example "CAM_MODE=1 AND CAM_EXPMODE!=0"
+    ///     @return Condition index for evaluate()
+    int addCondition(const QString &condition);
+
+private:
+    enum Op {
+        OpInvalid,
+        OpEqual,
+        OpNotEqual,
+        OpGreater,
+        OpSmaller
+    };
+
+    struct Test {
+        int     param   = -1;
+        Op      op      = OpInvalid;
+        QString value;
+    };
+
+    struct Condition {
+        QString     text;
+        QList<Test> tests;
+        QList<bool> orWithPrevious;     ///< One per test, the first is unused
+    };
+
+    int _internParameter(const QString &name);
+    static bool _evaluateTest(const Test &test, const ValueLookup &valueOf, const QString &conditionText, const QStringList &parameters);
+
+    QStringList             _parameters;
+    QHash<QString, int>     _parameterIndex;
+
+    /// Per parameter: option value -> settings excluded while the parameter has that value
+    QHash<int, QHash<QString, QStringList>> _exclusions;
+
+    QList<Range>            _ranges;
+    QHash<int, QList<int>>  _rangesByParam;
+    QList<Condition>        _conditions;
+};
@@ -9,6 +9,7 @@
 
 #include "MavlinkCameraControl.h"
 #include "QGCCameraIO.h"
+#include "CameraParamScheduler.h"
 #include "QGCLoggingCategory.h"
 #include "LinkInterface.h"
 #include "MAVLinkProtocol.h"
@@ -20,29 +21,21 @@ QGC_LOGGING_CATEGORY(CameraIOLog, "CameraIOLog")
 QGC_LOGGING_CATEGORY(CameraIOLogVerbose, "CameraIOLogVerbose")
 
 //-----------------------------------------------------------------------------
-QGCCameraParamIO::QGCCameraParamIO(MavlinkCameraControl *control, Fact* fact, Vehicle *vehicle)
+QGCCameraParamIO::QGCCameraParamIO(MavlinkCameraControl *control, Fact* fact, Vehicle *vehicle, CameraParamScheduler* scheduler)
     : QObject(control)
     , _control(control)
     , _fact(fact)
     , _vehicle(vehicle)
-    , _sentRetries(0)
-    , _requestRetries(0)
+    , _scheduler(scheduler)
     , _done(false)
     , _updateOnSet(false)
     , _forceUIUpdate(false)
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
-    _paramWriteTimer.setSingleShot(true);
-    _paramWriteTimer.setInterval(3000);
-    _paramRequestTimer.setSingleShot(true);
-    _paramRequestTimer.setInterval(3500);
     if(_fact->writeOnly()) {
         //-- Write mode is always "done" as it won't ever read
         _done = true;
-    } else {
-        connect(&_paramRequestTimer, &QTimer::timeout, this, &QGCCameraParamIO::_paramRequestTimeout);
     }
-    connect(&_paramWriteTimer,   &QTimer::timeout, this, &QGCCameraParamIO::_paramWriteTimeout);
     connect(_fact, &Fact::rawValueChanged, this, &QGCCameraParamIO::_factChanged);
     connect(_fact, &Fact::_containerRawValueChanged, this, &QGCCameraParamIO::_containerRawValueChanged);
     //-- TODO: Even though we don't use anything larger than 32-bit, this should
@@ -93,10 +86,9 @@ QGCCameraParamIO::QGCCameraParamIO(MavlinkCameraControl *control, Fact* fact, Ve
 void
 QGCCameraParamIO::setParamRequest()
 {
+    //-- The scheduler requests the list, this only flags the value as outstanding
     if(!_fact->writeOnly()) {
-        _paramRequestReceived = false;
-        _requestRetries = 0;
-        _paramRequestTimer.start();
+        _done = false;
     }
 }
 
@@ -118,8 +110,7 @@ QGCCameraParamIO::_containerRawValueChanged(const QVariant value)
     if(!_fact->readOnly()) {
         Q_UNUSED(value);
         qCDebug(CameraIOLog) << "Update Fact from camera" << _fact->name();
-        _sentRetries = 0;
-        _sendParameter();
+        _scheduler->queueWrite(_fact->name());
     }
 }
 
@@ -128,14 +119,13 @@ void
 QGCCameraParamIO::sendParameter(bool updateUI)
 {
     qCDebug(CameraIOLog) << "Send Fact" << _fact->name();
-    _sentRetries = 0;
     _updateOnSet = updateUI;
-    _sendParameter();
+    _scheduler->queueWrite(_fact->name());
 }
 
 //-----------------------------------------------------------------------------
 void
-QGCCameraParamIO::_sendParameter()
+QGCCameraParamIO::sendParamSet()
 {
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
@@ -200,21 +190,14 @@ QGCCameraParamIO::_sendParameter()
                     &p);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
     }
-    _paramWriteTimer.start();
 }
 
 //-----------------------------------------------------------------------------
 void
-QGCCameraParamIO::_paramWriteTimeout()
+QGCCameraParamIO::writeComplete(bool accepted)
 {
-    if(++_sentRetries > 3) {
-        qCWarning(CameraIOLog) << "No response for param set:" << _fact->name();
+    if(!accepted) {
         _updateOnSet = false;
-    } else {
-        //-- Send it again
-        qCDebug(CameraIOLog) << "Param set retry:" << _fact->name() << _sentRetries;
-        _sendParameter();
-        _paramWriteTimer.start();
     }
 }
 
@@ -222,7 +205,7 @@ QGCCameraParamIO::_paramWriteTimeout()
 void
 QGCCameraParamIO::handleParamAck(const mavlink_param_ext_ack_t& ack)
 {
-    _paramWriteTimer.stop();
+    const bool finished = _scheduler->ackReceived(_fact->name(), ack.param_result);
     if(ack.param_result == PARAM_ACK_ACCEPTED) {
         QVariant val = _valueFromMessage(ack.param_value, ack.param_type);
         if(_fact->rawValue() != val) {
@@ -235,15 +218,13 @@ QGCCameraParamIO::handleParamAck(const mavlink_param_ext_ack_t& ack)
     } else if(ack.param_result == PARAM_ACK_IN_PROGRESS) {
         //-- Wait a bit longer for this one
         qCDebug(CameraIOLogVerbose) << "Param set in progress:" << _fact->name();
-        _paramWriteTimer.start();
     } else {
         if(ack.param_result == PARAM_ACK_FAILED) {
-            if(++_sentRetries < 3) {
-                //-- Try again
-                qCWarning(CameraIOLog) << "Param set failed:" << _fact->name() << _sentRetries;
-                _paramWriteTimer.start();
+            if(!finished) {
+                //-- The scheduler tries again
+                qCWarning(CameraIOLog) << "Param set failed:" << _fact->name();
+                return;
             }
-            return;
         } else if(ack.param_result == PARAM_ACK_VALUE_UNSUPPORTED) {
             qCWarning(CameraIOLog) << "Param set unsuported:" << _fact->name();
         }
@@ -261,12 +242,11 @@ QGCCameraParamIO::handleParamAck(const mavlink_param_ext_ack_t& ack)
 void
 QGCCameraParamIO::handleParamValue(const mavlink_param_ext_value_t& value)
 {
-    _paramRequestTimer.stop();
+    _scheduler->valueReceived(_fact->name());
     QVariant newValue = _valueFromMessage(value.param_value, value.param_type);
     if(_control->incomingParameter(_fact, newValue)) {
         _fact->_containerSetRawValue(newValue);
     }
-    _paramRequestReceived = true;
     if(_forceUIUpdate) {
         emit _fact->rawValueChanged(_fact->rawValue());
         emit _fact->valueChanged(_fact->rawValue());
@@ -326,19 +306,14 @@ QGCCameraParamIO::_valueFromMessage(const char* value, uint8_t param_type)
 
 //-----------------------------------------------------------------------------
 void
-QGCCameraParamIO::_paramRequestTimeout()
+QGCCameraParamIO::readComplete(bool received)
 {
-    if(++_requestRetries > 3) {
+    if(!received) {
         qCWarning(CameraIOLog) << "No response for param request:" << _fact->name();
         if(!_done) {
             _done = true;
             _control->_paramDone();
         }
-    } else {
-        //-- Request it again
-        qCDebug(CameraIOLog) << "Param request retry:" << _fact->name();
-        paramRequest(false);
-        _paramRequestTimer.start();
     }
 }
 
@@ -355,10 +330,16 @@ QGCCameraParamIO::paramRequest(bool reset)
         return;
     }
     if(reset) {
-        _requestRetries = 0;
         _forceUIUpdate  = true;
     }
     qCDebug(CameraIOLog) << "Request parameter:" << _fact->name();
+    _scheduler->requestRead(_fact->name());
+}
+
+//-----------------------------------------------------------------------------
+void
+QGCCameraParamIO::sendParamRequestRead()
+{
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
         char param_id[MAVLINK_MSG_PARAM_EXT_REQUEST_READ_FIELD_PARAM_ID_LEN + 1];
@@ -376,5 +357,4 @@ QGCCameraParamIO::paramRequest(bool reset)
                     -1);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
     }
-    _paramRequestTimer.start();
 }
@@ -12,6 +12,7 @@
 #include "MAVLinkLib.h"
 #include <QtCore/QLoggingCategory>
 
+class CameraParamScheduler;
 class MavlinkCameraControl;
 class Fact;
 class Vehicle;
@@ -38,11 +39,11 @@ typedef struct {
 }) param_ext_union_t;
 
 //-----------------------------------------------------------------------------
-/// Camera parameter handler.
+/// Camera parameter handler. Timing and retries are left to the camera's CameraParamScheduler.
 class QGCCameraParamIO : public QObject
 {
 public:
-    QGCCameraParamIO(MavlinkCameraControl* control, Fact* fact, Vehicle* vehicle);
+    QGCCameraParamIO(MavlinkCameraControl* control, Fact* fact, Vehicle* vehicle, CameraParamScheduler* scheduler);
 
     void        handleParamAck              (const mavlink_param_ext_ack_t& ack);
     void        handleParamValue            (const mavlink_param_ext_value_t& value);
@@ -51,31 +52,29 @@ public:
     void        paramRequest                (bool reset = true);
     void        sendParameter               (bool updateUI = false);
 
+    //-- Called by the scheduler
+    void        sendParamSet                ();
+    void        sendParamRequestRead        ();
+    void        readComplete                (bool received);
+    void        writeComplete               (bool accepted);
+
     QStringList  optNames;
     QVariantList optVariants;
 
 private slots:
-    void        _paramWriteTimeout          ();
-    void        _paramRequestTimeout        ();
     void        _factChanged                (QVariant value);
     void        _containerRawValueChanged   (const QVariant value);
 
 private:
-    void        _sendParameter              ();
     QVariant    _valueFromMessage           (const char* value, uint8_t param_type);
 
 private:
     MavlinkCameraControl*   _control;
     Fact*               _fact;
     Vehicle*            _vehicle;
-    int                 _sentRetries;
-    int                 _requestRetries;
-    bool                _paramRequestReceived;
-    QTimer              _paramWriteTimer;
-    QTimer              _paramRequestTimer;
+    CameraParamScheduler* _scheduler;
     bool                _done;
     bool                _updateOnSet;
     MAV_PARAM_EXT_TYPE  _mavParamType;
     bool                _forceUIUpdate;
 };
-
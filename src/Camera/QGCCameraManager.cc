@@ -19,6 +19,7 @@
 #include "JsonHelper.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QFuture>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -28,6 +29,11 @@ QGC_LOGGING_CATEGORY(CameraManagerLog, "qgc.camera.qgccameramanager")
 
 QVariantList QGCCameraManager::_cameraList;
 
+static constexpr const char *kCameraMetaDataFile = ":/json/CameraMetaData.json";
+
+/// Read in the background as soon as the first camera manager exists, cameraList() only waits for what is left
+static QFuture<JsonHelper::JsonFile> s_cameraMetaDataFile;
+
 //-----------------------------------------------------------------------------
 QGCCameraManager::CameraStruct::CameraStruct(QObject* parent, uint8_t compID_, Vehicle* vehicle_)
     : QObject   (parent)
@@ -49,6 +55,10 @@ QGCCameraManager::QGCCameraManager(Vehicle *vehicle)
 
     _addCameraControlToLists(_simulatedCameraControl);
 
+    if (_cameraList.isEmpty() && !s_cameraMetaDataFile.isValid()) {
+        s_cameraMetaDataFile = JsonHelper::loadJsonFileAsync(QString::fromLatin1(kCameraMetaDataFile));
+    }
+
     connect(MultiVehicleManager::instance(), &MultiVehicleManager::parameterReadyVehicleAvailableChanged, this, &QGCCameraManager::_vehicleReady);
     connect(_vehicle, &Vehicle::mavlinkMessageReceived, this, &QGCCameraManager::_mavlinkMessageReceived);
     connect(&_camerasLostHeartbeatTimer, &QTimer::timeout, this, &QGCCameraManager::_checkForLostCameras);
@@ -578,7 +588,11 @@ QGCCameraManager::_stepStream(int direction)
 const QVariantList &QGCCameraManager::cameraList()
 {
     if (_cameraList.isEmpty()) {
-        const QList<CameraMetaData*> cams = _parseCameraMetaData(QStringLiteral(":/json/CameraMetaData.json"));
+        if (!s_cameraMetaDataFile.isValid()) {
+            s_cameraMetaDataFile = JsonHelper::loadJsonFileAsync(QString::fromLatin1(kCameraMetaDataFile));
+        }
+        const QList<CameraMetaData*> cams = _parseCameraMetaData(s_cameraMetaDataFile.result());
+        s_cameraMetaDataFile = QFuture<JsonHelper::JsonFile>();
         _cameraList.reserve(cams.size());
 
         for (CameraMetaData* cam : cams) {
@@ -590,12 +604,17 @@ const QVariantList &QGCCameraManager::cameraList()
 }
 
 QList<CameraMetaData*> QGCCameraManager::_parseCameraMetaData(const QString &jsonFilePath)
+{
+    return _parseCameraMetaData(JsonHelper::loadJsonFile(jsonFilePath));
+}
+
+QList<CameraMetaData*> QGCCameraManager::_parseCameraMetaData(const JsonHelper::JsonFile &jsonFile)
 {
     QList<CameraMetaData*> cameraList;
 
     QString errorString;
     int version;
-    const QJsonObject jsonObject = JsonHelper::openInternalQGCJsonFile(jsonFilePath, "CameraMetaData", 1, 1, version, errorString);
+    const QJsonObject jsonObject = JsonHelper::openInternalQGCJsonFile(jsonFile, "CameraMetaData", 1, 1, version, errorString);
     if (!errorString.isEmpty()) {
         qCWarning(CameraManagerLog) << "Internal Error:" << errorString;
         return cameraList;
@@ -609,7 +628,7 @@ QList<CameraMetaData*> QGCCameraManager::_parseCameraMetaData(const QString &jso
         return cameraList;
     }
 
-    static const QList<JsonHelper::KeyValidateInfo> cameraKeyInfoList = {
+    static const JsonHelper::KeyValidator cameraKeyValidator({
         { "canonicalName", QJsonValue::String, true },
         { "brand", QJsonValue::String, true },
         { "model", QJsonValue::String, true },
@@ -622,7 +641,7 @@ QList<CameraMetaData*> QGCCameraManager::_parseCameraMetaData(const QString &jso
         { "fixedOrientation", QJsonValue::Bool, true },
         { "minTriggerInterval", QJsonValue::Double, true },
         { "deprecatedTranslatedName", QJsonValue::String, true },
-    };
+    });
     const QJsonArray cameraInfo = jsonObject["cameraMetaData"].toArray();
     for (const QJsonValue &jsonValue : cameraInfo) {
         if (!jsonValue.isObject()) {
@@ -631,7 +650,7 @@ QList<CameraMetaData*> QGCCameraManager::_parseCameraMetaData(const QString &jso
         }
 
         const QJsonObject obj = jsonValue.toObject();
-        if (!JsonHelper::validateKeys(obj, cameraKeyInfoList, errorString)) {
+        if (!cameraKeyValidator.validate(obj, errorString)) {
             qCWarning(CameraManagerLog) << errorString;
             return cameraList;
         }
@@ -11,6 +11,7 @@
 
 #include "QmlObjectListModel.h"
 #include "MavlinkCameraControl.h"
+#include "JsonHelper.h"
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
@@ -103,6 +104,7 @@ protected:
     virtual void    _addCameraControlToLists(MavlinkCameraControl* cameraControl);
 
     static QList<CameraMetaData*> _parseCameraMetaData(const QString &jsonFilePath);
+    static QList<CameraMetaData*> _parseCameraMetaData(const JsonHelper::JsonFile &jsonFile);
 
     Vehicle*            _vehicle            = nullptr;
     Joystick*           _activeJoystick     = nullptr;
@@ -15,6 +15,7 @@
  */
 
 #include "VehicleCameraControl.h"
+#include "CameraParamScheduler.h"
 #include "QGCCameraIO.h"
 #include "QGCApplication.h"
 #include "SettingsManager.h"
@@ -22,102 +23,21 @@
 #include "VideoManager.h"
 #include "QGCCameraManager.h"
 #include "FTPManager.h"
-#include "QGCLZMA.h"
 #include "QGCCorePlugin.h"
 #include "Vehicle.h"
 #include "LinkInterface.h"
 #include "MAVLinkProtocol.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QSettings>
-#include <QtXml/QDomDocument>
-#include <QtXml/QDomNodeList>
 #include <QtQml/QQmlEngine>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 
-//-----------------------------------------------------------------------------
-QGCCameraOptionExclusion::QGCCameraOptionExclusion(QObject* parent, QString param_, QString value_, QStringList exclusions_)
-    : QObject(parent)
-    , param(param_)
-    , value(value_)
-    , exclusions(exclusions_)
-{
-}
-
-//-----------------------------------------------------------------------------
-QGCCameraOptionRange::QGCCameraOptionRange(QObject* parent, QString param_, QString value_, QString targetParam_, QString condition_, QStringList optNames_, QStringList optValues_)
-    : QObject(parent)
-    , param(param_)
-    , value(value_)
-    , targetParam(targetParam_)
-    , condition(condition_)
-    , optNames(optNames_)
-    , optValues(optValues_)
-{
-}
-
-//-----------------------------------------------------------------------------
-static bool
-read_attribute(QDomNode& node, const char* tagName, bool& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue() != "0";
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-static bool
-read_attribute(QDomNode& node, const char* tagName, int& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue().toInt();
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-static bool
-read_attribute(QDomNode& node, const char* tagName, QString& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue();
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-static bool
-read_value(QDomNode& element, const char* tagName, QString& target)
-{
-    QDomElement de = element.firstChildElement(tagName);
-    if(de.isNull()) {
-        return false;
-    }
-    target = de.text();
-    return true;
-}
-
 //-----------------------------------------------------------------------------
 VehicleCameraControl::VehicleCameraControl(const mavlink_camera_information_t *info, Vehicle* vehicle, int compID, QObject* parent)
     : MavlinkCameraControl(parent)
@@ -135,6 +55,32 @@ VehicleCameraControl::VehicleCameraControl(const mavlink_camera_information_t *i
         _vendor.toStdString().c_str(),
         _modelName.toStdString().c_str(),
         ver);
+    //-- One scheduler for all parameter traffic of this camera
+    CameraParamScheduler::Sender sender;
+    sender.requestList = [this]() {
+        _sendParamRequestList();
+    };
+    sender.requestRead = [this](const QString& param) {
+        if(_paramIO.contains(param)) {
+            _paramIO[param]->sendParamRequestRead();
+        }
+    };
+    sender.write = [this](const QString& param) {
+        if(_paramIO.contains(param)) {
+            _paramIO[param]->sendParamSet();
+        }
+    };
+    _paramScheduler = new CameraParamScheduler(sender, this);
+    connect(_paramScheduler, &CameraParamScheduler::readComplete, this, [this](const QString& param, bool received) {
+        if(_paramIO.contains(param)) {
+            _paramIO[param]->readComplete(received);
+        }
+    });
+    connect(_paramScheduler, &CameraParamScheduler::writeComplete, this, [this](const QString& param, bool accepted) {
+        if(_paramIO.contains(param)) {
+            _paramIO[param]->writeComplete(accepted);
+        }
+    });
     if(info->cam_definition_uri[0] != 0) {
         //-- Process camera definition file
         _handleDefinitionFile(info->cam_definition_uri);
@@ -164,6 +110,9 @@ VehicleCameraControl::VehicleCameraControl(const mavlink_camera_information_t *i
 //-----------------------------------------------------------------------------
 VehicleCameraControl::~VehicleCameraControl()
 {
+    if(_paramComplete) {
+        _saveParamCache();
+    }
     delete _netManager;
     _netManager = nullptr;
 }
@@ -773,115 +722,62 @@ VehicleCameraControl::_setPhotoStatus(PhotoCaptureStatus status)
 
 //-----------------------------------------------------------------------------
 bool
-VehicleCameraControl::_loadCameraDefinitionFile(QByteArray& bytes)
+VehicleCameraControl::_loadCameraDefinition(const CameraDefinition& definition)
 {
-    QByteArray originalData(bytes);
-    //-- Handle localization
-    if(!_handleLocalization(bytes)) {
-        return false;
-    }
-    int errorLine;
-    QString errorMsg;
-    QDomDocument doc;
-    if(!doc.setContent(bytes, false, &errorMsg, &errorLine)) {
-        qCCritical(CameraControlLog) << "Unable to parse camera definition file on line:" << errorLine;
-        qCCritical(CameraControlLog) << errorMsg;
-        return false;
-    }
     //-- Load camera constants
-    QDomNodeList defElements = doc.elementsByTagName(kDefnition);
-    if(!defElements.size() || !_loadConstants(defElements)) {
-        qCWarning(CameraControlLog) <<  "Unable to load camera constants from camera definition";
-        return false;
-    }
+    _version   = definition.version;
+    _modelName = definition.model;
+    _vendor    = definition.vendor;
     //-- Load camera parameters
-    QDomNodeList paramElements = doc.elementsByTagName(kParameters);
-    if(!paramElements.size()) {
+    if(definition.parameters.isEmpty()) {
         qCDebug(CameraControlLog) <<  "No parameters to load from camera";
         return false;
     }
-    if(!_loadSettings(paramElements)) {
+    if(!_loadSettings(definition)) {
         qCWarning(CameraControlLog) <<  "Unable to load camera parameters from camera definition";
         return false;
     }
-    //-- If this is new, cache it
-    if(!_cached) {
-        qCDebug(CameraControlLog) << "Saving camera definition file" << _cacheFile;
-        QFile file(_cacheFile);
-        if (!file.open(QIODevice::WriteOnly)) {
-            qWarning() << QString("Could not save cache file %1. Error: %2").arg(_cacheFile).arg(file.errorString());
-        } else {
-            file.write(originalData);
-        }
-    }
     return true;
 }
 
 //-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_loadConstants(const QDomNodeList nodeList)
+static bool
+convertAttribute(FactMetaData* metaData, const QString& factName, const char* attrName, const QString& attr, QVariant& typedValue)
 {
-    QDomNode node = nodeList.item(0);
-    if(!read_attribute(node, kVersion, _version)) {
-        return false;
-    }
-    if(!read_value(node, kModel, _modelName)) {
-        return false;
-    }
-    if(!read_value(node, kVendor, _vendor)) {
-        return false;
+    QString errorString;
+    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
+        return true;
     }
-    return true;
+    qWarning() << "Invalid" << attrName << "value for" << factName
+               << " type:"  << metaData->type()
+               << " value:" << attr
+               << " error:" << errorString;
+    return false;
 }
 
 //-----------------------------------------------------------------------------
 bool
-VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
+VehicleCameraControl::_loadSettings(const CameraDefinition& definition)
 {
-    QDomNode node = nodeList.item(0);
-    QDomElement elem = node.toElement();
-    QDomNodeList parameters = elem.elementsByTagName(kParameter);
     //-- Pre-process settings (maintain order and skip non-controls)
-    for(int i = 0; i < parameters.size(); i++) {
-        QDomNode parameterNode = parameters.item(i);
-        QString name;
-        if(read_attribute(parameterNode, kName, name)) {
-            bool control = true;
-            read_attribute(parameterNode, kControl, control);
-            if(control) {
-                _settings << name;
-            }
-        } else {
-            qCritical() << "Parameter entry missing parameter name";
-            return false;
+    for(const CameraDefinition::Parameter& parameter: definition.parameters) {
+        if(parameter.control) {
+            _settings << parameter.name;
         }
     }
+    //-- Last known values of this camera, shown until the camera reports its current ones
+    const QVariantMap cachedValues = _loadParamCache();
     //-- Load parameters
-    for(int i = 0; i < parameters.size(); i++) {
-        QDomNode parameterNode = parameters.item(i);
-        QString factName;
-        read_attribute(parameterNode, kName, factName);
-        QString type;
-        if(!read_attribute(parameterNode, kType, type)) {
-            qCritical() << QString("Parameter %1 missing parameter type").arg(factName);
-            return false;
-        }
-        //-- Does it have a control?
-        bool control = true;
-        read_attribute(parameterNode, kControl, control);
-        //-- Is it read only?
-        bool readOnly = false;
-        read_attribute(parameterNode, kReadOnly, readOnly);
-        //-- Is it write only?
-        bool writeOnly = false;
-        read_attribute(parameterNode, kWriteOnly, writeOnly);
+    for(const CameraDefinition::Parameter& parameter: definition.parameters) {
+        const QString& factName = parameter.name;
+        bool control = parameter.control;
         //-- It can't be both
-        if(readOnly && writeOnly) {
+        if(parameter.readOnly && parameter.writeOnly) {
             qCritical() << QString("Parameter %1 cannot be both read only and write only").arg(factName);
         }
         //-- Param type
         bool unknownType;
-        FactMetaData::ValueType_t factType = FactMetaData::stringToType(type, unknownType);
+        FactMetaData::ValueType_t factType = FactMetaData::stringToType(parameter.type, unknownType);
         if (unknownType) {
             qCritical() << QString("Unknown type for parameter %1").arg(factName);
             return false;
@@ -890,71 +786,42 @@ VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
         if(factType == FactMetaData::valueTypeCustom) {
             control = false;
         }
-        //-- Description
-        QString description;
-        if(!read_value(parameterNode, kDescription, description)) {
-            qCritical() << QString("Parameter %1 missing parameter description").arg(factName);
-            return false;
-        }
         //-- Check for updates
-        QStringList updates = _loadUpdates(parameterNode);
-        if(updates.size()) {
-            qCDebug(CameraControlVerboseLog) << "Parameter" << factName << "requires updates for:" << updates;
-            _requestUpdates[factName] = updates;
+        if(parameter.updates.size()) {
+            qCDebug(CameraControlVerboseLog) << "Parameter" << factName << "requires updates for:" << parameter.updates;
+            _requestUpdates[factName] = parameter.updates;
         }
         //-- Build metadata
         FactMetaData* metaData = new FactMetaData(factType, factName, this);
         QQmlEngine::setObjectOwnership(metaData, QQmlEngine::CppOwnership);
-        metaData->setShortDescription(description);
-        metaData->setLongDescription(description);
+        metaData->setShortDescription(parameter.description);
+        metaData->setLongDescription(parameter.description);
         metaData->setHasControl(control);
-        metaData->setReadOnly(readOnly);
-        metaData->setWriteOnly(writeOnly);
+        metaData->setReadOnly(parameter.readOnly);
+        metaData->setWriteOnly(parameter.writeOnly);
         //-- Options (enums)
-        QDomElement optionElem = parameterNode.toElement();
-        QDomNodeList optionsRoot = optionElem.elementsByTagName(kOptions);
-        if(optionsRoot.size()) {
-            //-- Iterate options
-            QDomNode node = optionsRoot.item(0);
-            QDomElement elem = node.toElement();
-            QDomNodeList options = elem.elementsByTagName(kOption);
-            for(int i = 0; i < options.size(); i++) {
-                QDomNode option = options.item(i);
-                QString optName;
-                QString optValue;
-                QVariant optVariant;
-                if(!_loadNameValue(option, factName, metaData, optName, optValue, optVariant)) {
-                    delete metaData;
-                    return false;
-                }
-                metaData->addEnumInfo(optName, optVariant);
-                _originalOptNames[factName]  << optName;
-                _originalOptValues[factName] << optVariant;
-                //-- Check for exclusions
-                QStringList exclusions = _loadExclusions(option);
-                if(exclusions.size()) {
-                    qCDebug(CameraControlVerboseLog) << "New exclusions:" << factName << optValue << exclusions;
-                    QGCCameraOptionExclusion* pExc = new QGCCameraOptionExclusion(this, factName, optValue, exclusions);
-                    QQmlEngine::setObjectOwnership(pExc, QQmlEngine::CppOwnership);
-                    _valueExclusions.append(pExc);
-                }
-                //-- Check for range rules
-                if(!_loadRanges(option, factName, optValue)) {
-                    delete metaData;
-                    return false;
-                }
+        for(const CameraDefinition::Option& option: parameter.options) {
+            QVariant optVariant;
+            QString  errorString;
+            if (!metaData->convertAndValidateRaw(option.value, false, optVariant, errorString)) {
+                qWarning() << "Invalid option value, name:" << factName
+                           << " type:"  << metaData->type()
+                           << " value:" << option.value
+                           << " error:" << errorString;
             }
+            metaData->addEnumInfo(option.name, optVariant);
+            _originalOptNames[factName]  << option.name;
+            _originalOptValues[factName] << optVariant;
         }
-        QString defaultValue;
-        if(read_attribute(parameterNode, kDefault, defaultValue)) {
+        if(parameter.attributes & CameraDefinition::HasDefault) {
             QVariant defaultVariant;
             QString  errorString;
-            if (metaData->convertAndValidateRaw(defaultValue, false, defaultVariant, errorString)) {
+            if (metaData->convertAndValidateRaw(parameter.defaultValue, false, defaultVariant, errorString)) {
                 metaData->setRawDefaultValue(defaultVariant);
             } else {
                 qWarning() << "Invalid default value for" << factName
                            << " type:"  << metaData->type()
-                           << " value:" << defaultValue
+                           << " value:" << parameter.defaultValue
                            << " error:" << errorString;
             }
         }
@@ -962,92 +829,51 @@ VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
         if (_nameToFactMetaDataMap.contains(factName)) {
             qWarning() << QStringLiteral("Duplicate fact name:") << factName;
             delete metaData;
-        } else {
-            {
-                //-- Check for Min Value
-                QString attr;
-                if(read_attribute(parameterNode, kMin, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawMin(typedValue);
-                    } else {
-                        qWarning() << "Invalid min value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
-                }
-            }
-            {
-                //-- Check for Max Value
-                QString attr;
-                if(read_attribute(parameterNode, kMax, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawMax(typedValue);
-                    } else {
-                        qWarning() << "Invalid max value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
-                }
-            }
-            {
-                //-- Check for Step Value
-                QString attr;
-                if(read_attribute(parameterNode, kStep, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawIncrement(typedValue.toDouble());
-                    } else {
-                        qWarning() << "Invalid step value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
-                }
-            }
-            {
-                //-- Check for Decimal Places
-                QString attr;
-                if(read_attribute(parameterNode, kDecimalPlaces, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setDecimalPlaces(typedValue.toInt());
-                    } else {
-                        qWarning() << "Invalid decimal places value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
-                }
-            }
-            {
-                //-- Check for Units
-                QString attr;
-                if(read_attribute(parameterNode, kUnit, attr)) {
-                    metaData->setRawUnits(attr);
-                }
+            continue;
+        }
+        QVariant typedValue;
+        if((parameter.attributes & CameraDefinition::HasMin) && convertAttribute(metaData, factName, kMin, parameter.min, typedValue)) {
+            metaData->setRawMin(typedValue);
+        }
+        if((parameter.attributes & CameraDefinition::HasMax) && convertAttribute(metaData, factName, kMax, parameter.max, typedValue)) {
+            metaData->setRawMax(typedValue);
+        }
+        if((parameter.attributes & CameraDefinition::HasStep) && convertAttribute(metaData, factName, kStep, parameter.step, typedValue)) {
+            metaData->setRawIncrement(typedValue.toDouble());
+        }
+        if((parameter.attributes & CameraDefinition::HasDecimalPlaces) && convertAttribute(metaData, factName, kDecimalPlaces, parameter.decimalPlaces, typedValue)) {
+            metaData->setDecimalPlaces(typedValue.toInt());
+        }
+        if(parameter.attributes & CameraDefinition::HasUnit) {
+            metaData->setRawUnits(parameter.unit);
+        }
+        qCDebug(CameraControlLog) << "New parameter:" << factName << (parameter.readOnly ? "ReadOnly" : "Writable") << (parameter.writeOnly ? "WriteOnly" : "Readable");
+        _nameToFactMetaDataMap[factName] = metaData;
+        Fact* pFact = new Fact(_compID, factName, factType, this);
+        QQmlEngine::setObjectOwnership(pFact, QQmlEngine::CppOwnership);
+        pFact->setMetaData(metaData);
+        QVariant initialValue = metaData->rawDefaultValue();
+        if(!parameter.writeOnly && cachedValues.contains(factName)) {
+            QVariant cachedValue;
+            QString  errorString;
+            if(metaData->convertAndValidateRaw(cachedValues[factName], true /* convertOnly */, cachedValue, errorString)) {
+                initialValue = cachedValue;
             }
-            qCDebug(CameraControlLog) << "New parameter:" << factName << (readOnly ? "ReadOnly" : "Writable") << (writeOnly ? "WriteOnly" : "Readable");
-            _nameToFactMetaDataMap[factName] = metaData;
-            Fact* pFact = new Fact(_compID, factName, factType, this);
-            QQmlEngine::setObjectOwnership(pFact, QQmlEngine::CppOwnership);
-            pFact->setMetaData(metaData);
-            pFact->_containerSetRawValue(metaData->rawDefaultValue());
-            QGCCameraParamIO* pIO = new QGCCameraParamIO(this, pFact, _vehicle);
-            QQmlEngine::setObjectOwnership(pIO, QQmlEngine::CppOwnership);
-            _paramIO[factName] = pIO;
-            _addFact(pFact, factName);
         }
+        pFact->_containerSetRawValue(initialValue);
+        QGCCameraParamIO* pIO = new QGCCameraParamIO(this, pFact, _vehicle, _paramScheduler);
+        QQmlEngine::setObjectOwnership(pIO, QQmlEngine::CppOwnership);
+        _paramIO[factName] = pIO;
+        _addFact(pFact, factName);
     }
     if(_nameToFactMetaDataMap.size() > 0) {
         _addFactGroup(this, "camera");
+        //-- Compile exclusions and ranges now that all facts exist
+        _rules.compile(definition);
+        _ruleFacts.clear();
+        for(const QString& param: _rules.parameters()) {
+            _ruleFacts << (_nameToFactMetaDataMap.contains(param) ? getFact(param) : nullptr);
+        }
         _processRanges();
         _activeSettings = _settings;
         emit activeSettingsChanged();
@@ -1058,85 +884,13 @@ VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
 
 //-----------------------------------------------------------------------------
 bool
-VehicleCameraControl::_handleLocalization(QByteArray& bytes)
-{
-    QString errorMsg;
-    int errorLine;
-    QDomDocument doc;
-    if(!doc.setContent(bytes, false, &errorMsg, &errorLine)) {
-        qCritical() << "Unable to parse camera definition file on line:" << errorLine;
-        qCritical() << errorMsg;
+VehicleCameraControl::_ruleValue(int param, QString& value) const
+{
+    Fact* pFact = _ruleFacts.value(param, nullptr);
+    if(!pFact) {
         return false;
     }
-    //-- Find out where we are
-    QLocale locale = QLocale::system();
-#if defined (Q_OS_MAC)
-    locale = QLocale(locale.name());
-#endif
-    QString localeName = locale.name().toLower().replace("-", "_");
-    qCDebug(CameraControlLog) << "Current locale:" << localeName;
-    if(localeName == "en_us") {
-        // Nothing to do
-        return true;
-    }
-    QDomNodeList locRoot = doc.elementsByTagName(kLocalization);
-    if(!locRoot.size()) {
-        // Nothing to do
-        return true;
-    }
-    //-- Iterate locales
-    QDomNode node = locRoot.item(0);
-    QDomElement elem = node.toElement();
-    QDomNodeList locales = elem.elementsByTagName(kLocale);
-    for(int i = 0; i < locales.size(); i++) {
-        QDomNode locale = locales.item(i);
-        QString name;
-        if(!read_attribute(locale, kName, name)) {
-            qWarning() << "Localization entry is missing its name attribute";
-            continue;
-        }
-        // If we found a direct match, deal with it now
-        if(localeName == name.toLower().replace("-", "_")) {
-            return _replaceLocaleStrings(locale, bytes);
-        }
-    }
-    //-- No direct match. Pick first matching language (if any)
-    localeName = localeName.left(3);
-    for(int i = 0; i < locales.size(); i++) {
-        QDomNode locale = locales.item(i);
-        QString name;
-        read_attribute(locale, kName, name);
-        if(name.toLower().startsWith(localeName)) {
-            return _replaceLocaleStrings(locale, bytes);
-        }
-    }
-    //-- Could not find a language to use
-    qWarning() <<  "No match for" << QLocale::system().name() << "in camera definition file";
-    //-- Just use default, en_US
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_replaceLocaleStrings(const QDomNode node, QByteArray& bytes)
-{
-    QDomElement stringElem = node.toElement();
-    QDomNodeList strings = stringElem.elementsByTagName(kStrings);
-    for(int i = 0; i < strings.size(); i++) {
-        QDomNode stringNode = strings.item(i);
-        QString original;
-        QString translated;
-        if(read_attribute(stringNode, kOriginal, original)) {
-            if(read_attribute(stringNode, kTranslated, translated)) {
-                QString o; o = "\"" + original + "\"";
-                QString t; t = "\"" + translated + "\"";
-                bytes.replace(o.toUtf8(), t.toUtf8());
-                o = ">" + original + "<";
-                t = ">" + translated + "<";
-                bytes.replace(o.toUtf8(), t.toUtf8());
-            }
-        }
-    }
+    value = pFact->rawValueString();
     return true;
 }
 
@@ -1145,13 +899,26 @@ void
 VehicleCameraControl::_requestAllParameters()
 {
     //-- Reset receive list
+    QStringList readable;
     for(const QString& paramName: _paramIO.keys()) {
         if(_paramIO[paramName]) {
             _paramIO[paramName]->setParamRequest();
+            if(!getFact(paramName)->writeOnly()) {
+                readable << paramName;
+            }
         } else {
             qCritical() << "QGCParamIO is NULL" << paramName;
         }
     }
+    //-- The scheduler requests the list and then fills in whatever did not arrive
+    _paramScheduler->requestAll(readable);
+    qCDebug(CameraControlVerboseLog) << "Request all parameters";
+}
+
+//-----------------------------------------------------------------------------
+void
+VehicleCameraControl::_sendParamRequestList()
+{
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
         mavlink_message_t msg;
@@ -1164,7 +931,53 @@ VehicleCameraControl::_requestAllParameters()
                     static_cast<uint8_t>(compID()));
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
     }
-    qCDebug(CameraControlVerboseLog) << "Request all parameters";
+}
+
+//-----------------------------------------------------------------------------
+QString
+VehicleCameraControl::_paramCacheGroup() const
+{
+    static const QRegularExpression invalidChars(QStringLiteral("[^A-Za-z0-9_]"));
+    QString camera = QStringLiteral("%1_%2").arg(_vendor, _modelName);
+    camera.replace(invalidChars, QStringLiteral("_"));
+    return QStringLiteral("%1/%2").arg(kParamCacheGroup, camera);
+}
+
+//-----------------------------------------------------------------------------
+QVariantMap
+VehicleCameraControl::_loadParamCache() const
+{
+    QVariantMap values;
+    QSettings settings;
+    settings.beginGroup(_paramCacheGroup());
+    //-- Values of a different definition version may no longer mean the same thing
+    if(settings.value(kParamCacheDefinitionVersion, -1).toInt() == _version) {
+        for(const QString& key: settings.childKeys()) {
+            if(key != QLatin1String(kParamCacheDefinitionVersion)) {
+                values[key] = settings.value(key);
+            }
+        }
+    }
+    settings.endGroup();
+    qCDebug(CameraControlLog) << "Loaded" << values.count() << "cached parameter values";
+    return values;
+}
+
+//-----------------------------------------------------------------------------
+void
+VehicleCameraControl::_saveParamCache()
+{
+    QSettings settings;
+    settings.remove(_paramCacheGroup());
+    settings.beginGroup(_paramCacheGroup());
+    settings.setValue(kParamCacheDefinitionVersion, _version);
+    for(const QString& paramName: _paramIO.keys()) {
+        const Fact* pFact = getFact(paramName);
+        if(pFact && !pFact->writeOnly()) {
+            settings.setValue(paramName, pFact->rawValue());
+        }
+    }
+    settings.endGroup();
 }
 
 //-----------------------------------------------------------------------------
@@ -1213,18 +1026,9 @@ void
 VehicleCameraControl::_updateActiveList()
 {
     //-- Clear out excluded parameters based on exclusion rules
-    QStringList exclusionList;
-    for(QGCCameraOptionExclusion* param: _valueExclusions) {
-        Fact* pFact = getFact(param->param);
-        if(pFact) {
-            QString option = pFact->rawValueString();
-            if(param->value == option) {
-                exclusionList << param->exclusions;
-            }
-        }
-    }
+    const QStringList exclusionList = _rules.exclusions([this](int param, QString& value) { return _ruleValue(param, value); });
     QStringList active;
-    for(QString key: _settings) {
+    for(const QString& key: _settings) {
         if(!exclusionList.contains(key)) {
             active.append(key);
         }
@@ -1240,130 +1044,48 @@ VehicleCameraControl::_updateActiveList()
     }
 }
 
-//-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_processConditionTest(const QString conditionTest)
-{
-    enum {
-        TEST_NONE,
-        TEST_EQUAL,
-        TEST_NOT_EQUAL,
-        TEST_GREATER,
-        TEST_SMALLER
-    };
-    qCDebug(CameraControlVerboseLog) << "_processConditionTest(" << conditionTest << ")";
-    int op = TEST_NONE;
-    QStringList test;
-
-    auto split = [&conditionTest](const QString& sep ) {
-        return conditionTest.split(sep, Qt::SkipEmptyParts);
-    };
-
-    if(conditionTest.contains("!=")) {
-        test = split("!=");
-        op = TEST_NOT_EQUAL;
-    } else if(conditionTest.contains("=")) {
-        test = split("=");
-        op = TEST_EQUAL;
-    } else if(conditionTest.contains(">")) {
-        test = split(">");
-        op = TEST_GREATER;
-    } else if(conditionTest.contains("<")) {
-        test = split("<");
-        op = TEST_SMALLER;
-    }
-    if(test.size() == 2) {
-        Fact* pFact = getFact(test[0]);
-        if(pFact) {
-            switch(op) {
-            case TEST_EQUAL:
-                return pFact->rawValueString() == test[1];
-            case TEST_NOT_EQUAL:
-                return pFact->rawValueString() != test[1];
-            case TEST_GREATER:
-                return pFact->rawValueString() > test[1];
-            case TEST_SMALLER:
-                return pFact->rawValueString() < test[1];
-            case TEST_NONE:
-                break;
-            }
-        } else {
-            qWarning() << "Invalid condition parameter:" << test[0] << "in" << conditionTest;
-            return false;
-        }
-    }
-    qWarning() << "Invalid condition" << conditionTest;
-    return false;
-}
-
-//-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_processCondition(const QString condition)
-{
-    qCDebug(CameraControlVerboseLog) << "_processCondition(" << condition << ")";
-    bool result = true;
-    bool andOp  = true;
-    if(!condition.isEmpty()) {
-        QStringList scond = condition.split(" ", Qt::SkipEmptyParts);
-        while(scond.size()) {
-            QString test = scond.first();
-            scond.removeFirst();
-            if(andOp) {
-                result = result && _processConditionTest(test);
-            } else {
-                result = result || _processConditionTest(test);
-            }
-            if(!scond.size()) {
-                return result;
-            }
-            andOp = scond.first().toUpper() == "AND";
-            scond.removeFirst();
-        }
-    }
-    return result;
-}
-
 //-----------------------------------------------------------------------------
 void
 VehicleCameraControl::_updateRanges(Fact* pFact)
 {
-    QMap<Fact*, QGCCameraOptionRange*> rangesSet;
+    const CameraRuleTable::ValueLookup valueOf = [this](int param, QString& value) { return _ruleValue(param, value); };
+    //-- Only the ranges which depend on this fact, either directly or through their condition
+    const QList<int> dependentRanges = _rules.rangesFor(_rules.parameterIndex(pFact->name()));
+    QMap<Fact*, const CameraRuleTable::Range*> rangesSet;
     QMap<Fact*, QString> rangesReset;
     QStringList changedList;
     QStringList resetList;
     QStringList updates;
     //-- Iterate range sets looking for limited ranges
-    for(QGCCameraOptionRange* pRange: _optionRanges) {
-        //-- If this fact or one of its conditions is part of this range set
-        if(!changedList.contains(pRange->targetParam) && (pRange->param == pFact->name() || pRange->condition.contains(pFact->name()))) {
-            Fact* pRFact = getFact(pRange->param);          //-- This parameter
-            Fact* pTFact = getFact(pRange->targetParam);    //-- The target parameter (the one its range is to change)
+    for(int rangeIndex: dependentRanges) {
+        const CameraRuleTable::Range& range = _rules.ranges()[rangeIndex];
+        const QString& targetParam = _rules.parameters()[range.target];
+        if(!changedList.contains(targetParam)) {
+            Fact* pRFact = _ruleFacts[range.param];     //-- This parameter
+            Fact* pTFact = _ruleFacts[range.target];    //-- The target parameter (the one its range is to change)
             if(pRFact && pTFact) {
-                //qCDebug(CameraControlVerboseLog) << "Check new set of options for" << pTFact->name();
-                QString option = pRFact->rawValueString();  //-- This parameter value
                 //-- If this value (and condition) triggers a change in the target range
-                //qCDebug(CameraControlVerboseLog) << "Range value:" << pRange->value << "Current value:" << option << "Condition:" << pRange->condition;
-                if(pRange->value == option && _processCondition(pRange->condition)) {
-                    if(pTFact->enumStrings() != pRange->optNames) {
+                if(range.value == pRFact->rawValueString() && _rules.evaluate(range.condition, valueOf)) {
+                    if(pTFact->enumStrings() != range.optNames) {
                         //-- Set limited range set
-                        rangesSet[pTFact] = pRange;
+                        rangesSet[pTFact] = &range;
                     }
-                    changedList << pRange->targetParam;
+                    changedList << targetParam;
                 }
             }
         }
     }
     //-- Iterate range sets again looking for resets
-    for(QGCCameraOptionRange* pRange: _optionRanges) {
-        if(!changedList.contains(pRange->targetParam) && (pRange->param == pFact->name() || pRange->condition.contains(pFact->name()))) {
-            Fact* pTFact = getFact(pRange->targetParam);    //-- The target parameter (the one its range is to change)
-            if(!resetList.contains(pRange->targetParam)) {
-                if(pTFact->enumStrings() != _originalOptNames[pRange->targetParam]) {
-                    //-- Restore full option set
-                    rangesReset[pTFact] = pRange->targetParam;
-                }
-                resetList << pRange->targetParam;
+    for(int rangeIndex: dependentRanges) {
+        const CameraRuleTable::Range& range = _rules.ranges()[rangeIndex];
+        const QString& targetParam = _rules.parameters()[range.target];
+        if(!changedList.contains(targetParam) && !resetList.contains(targetParam)) {
+            Fact* pTFact = _ruleFacts[range.target];    //-- The target parameter (the one its range is to change)
+            if(pTFact && pTFact->enumStrings() != _originalOptNames[targetParam]) {
+                //-- Restore full option set
+                rangesReset[pTFact] = targetParam;
             }
+            resetList << targetParam;
         }
     }
     //-- Update limited range set
@@ -1878,146 +1600,30 @@ VehicleCameraControl::_streamStatusTimeout()
     }
 }
 
-//-----------------------------------------------------------------------------
-QStringList
-VehicleCameraControl::_loadExclusions(QDomNode option)
-{
-    QStringList exclusionList;
-    QDomElement optionElem = option.toElement();
-    QDomNodeList excRoot = optionElem.elementsByTagName(kExclusions);
-    if(excRoot.size()) {
-        //-- Iterate exclusions
-        QDomNode node = excRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList exclusions = elem.elementsByTagName(kExclusion);
-        for(int i = 0; i < exclusions.size(); i++) {
-            QString exclude = exclusions.item(i).toElement().text();
-            if(!exclude.isEmpty()) {
-                exclusionList << exclude;
-            }
-        }
-    }
-    return exclusionList;
-}
-
-//-----------------------------------------------------------------------------
-QStringList
-VehicleCameraControl::_loadUpdates(QDomNode option)
-{
-    QStringList updateList;
-    QDomElement optionElem = option.toElement();
-    QDomNodeList updateRoot = optionElem.elementsByTagName(kUpdates);
-    if(updateRoot.size()) {
-        //-- Iterate updates
-        QDomNode node = updateRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList updates = elem.elementsByTagName(kUpdate);
-        for(int i = 0; i < updates.size(); i++) {
-            QString update = updates.item(i).toElement().text();
-            if(!update.isEmpty()) {
-                updateList << update;
-            }
-        }
-    }
-    return updateList;
-}
-
-//-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_loadRanges(QDomNode option, const QString factName, QString paramValue)
-{
-    QDomElement optionElem = option.toElement();
-    QDomNodeList rangeRoot = optionElem.elementsByTagName(kParameterranges);
-    if(rangeRoot.size()) {
-        QDomNode node = rangeRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList parameterRanges = elem.elementsByTagName(kParameterrange);
-        //-- Iterate parameter ranges
-        for(int i = 0; i < parameterRanges.size(); i++) {
-            QString param;
-            QString condition;
-            QDomNode paramRange = parameterRanges.item(i);
-            if(!read_attribute(paramRange, kParameter, param)) {
-                qCritical() << QString("Malformed option range for parameter %1").arg(factName);
-                return false;
-            }
-            read_attribute(paramRange, kCondition, condition);
-            QDomElement pelem = paramRange.toElement();
-            QDomNodeList rangeOptions = pelem.elementsByTagName(kRoption);
-            QStringList  optNames;
-            QStringList  optValues;
-            //-- Iterate options
-            for(int i = 0; i < rangeOptions.size(); i++) {
-                QString optName;
-                QString optValue;
-                QDomNode roption = rangeOptions.item(i);
-                if(!read_attribute(roption, kName, optName)) {
-                    qCritical() << QString("Malformed roption for parameter %1").arg(factName);
-                    return false;
-                }
-                if(!read_attribute(roption, kValue, optValue)) {
-                    qCritical() << QString("Malformed rvalue for parameter %1").arg(factName);
-                    return false;
-                }
-                optNames  << optName;
-                optValues << optValue;
-            }
-            if(optNames.size()) {
-                QGCCameraOptionRange* pRange = new QGCCameraOptionRange(this, factName, paramValue, param, condition, optNames, optValues);
-                _optionRanges.append(pRange);
-                qCDebug(CameraControlVerboseLog) << "New range limit:" << factName << paramValue << param << condition << optNames << optValues;
-            }
-        }
-    }
-    return true;
-}
-
 //-----------------------------------------------------------------------------
 void
 VehicleCameraControl::_processRanges()
 {
     //-- After all parameter are loaded, process parameter ranges
-    for(QGCCameraOptionRange* pRange: _optionRanges) {
-        Fact* pRFact = getFact(pRange->targetParam);
+    for(CameraRuleTable::Range& range: _rules.ranges()) {
+        Fact* pRFact = _ruleFacts[range.target];
         if(pRFact) {
-            for(int i = 0; i < pRange->optNames.size(); i++) {
+            for(int i = 0; i < range.optNames.size(); i++) {
                 QVariant optVariant;
                 QString  errorString;
-                if (!pRFact->metaData()->convertAndValidateRaw(pRange->optValues[i], false, optVariant, errorString)) {
-                    qWarning() << "Invalid roption value, name:" << pRange->targetParam
+                if (!pRFact->metaData()->convertAndValidateRaw(range.optValues[i], false, optVariant, errorString)) {
+                    qWarning() << "Invalid roption value, name:" << pRFact->name()
                                << " type:"  << pRFact->metaData()->type()
-                               << " value:" << pRange->optValues[i]
+                               << " value:" << range.optValues[i]
                                << " error:" << errorString;
                 } else {
-                    pRange->optVariants << optVariant;
+                    range.optVariants << optVariant;
                 }
             }
         }
     }
 }
 
-//-----------------------------------------------------------------------------
-bool
-VehicleCameraControl::_loadNameValue(QDomNode option, const QString factName, FactMetaData* metaData, QString& optName, QString& optValue, QVariant& optVariant)
-{
-    if(!read_attribute(option, kName, optName)) {
-        qCritical() << QString("Malformed option for parameter %1").arg(factName);
-        return false;
-    }
-    if(!read_attribute(option, kValue, optValue)) {
-        qCritical() << QString("Malformed value for parameter %1").arg(factName);
-        return false;
-    }
-    QString  errorString;
-    if (!metaData->convertAndValidateRaw(optValue, false, optVariant, errorString)) {
-        qWarning() << "Invalid option value, name:" << factName
-                   << " type:"  << metaData->type()
-                   << " value:" << optValue
-                   << " error:" << errorString;
-    }
-    return true;
-}
-
 //-----------------------------------------------------------------------------
 void
 VehicleCameraControl::_handleDefinitionFile(const QString &url)
@@ -2049,22 +1655,50 @@ VehicleCameraControl::_handleDefinitionFile(const QString &url)
         _httpRequest(url);
         return;
     }
-    if (!xmlFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not read cached camera definition file:" << _cacheFile;
-        _httpRequest(url);
+    //-- We have it. It is read and parsed in the background, falling back to a download if that fails.
+    qCDebug(CameraControlLog) << "Using cached camera definition file:" << _cacheFile;
+    _cached = true;
+    _loadDefinitionAsync(QByteArray(), _cacheFile, url);
+}
+
+//-----------------------------------------------------------------------------
+void
+VehicleCameraControl::_loadDefinitionAsync(const QByteArray& bytes, const QString& fileName, const QString& retryUrl)
+{
+    //-- Several cameras load their definitions in parallel on the thread pool
+    const QString xmlCopyFile = _cached ? QString() : _cacheFile;
+    const QString cacheDir    = CameraDefinition::defaultCacheDir();
+    const QString localeName  = CameraDefinition::systemLocaleName();
+    qCDebug(CameraControlLog) << "Current locale:" << localeName;
+
+    QFutureWatcher<CameraDefinition::LoadResult>* watcher = new QFutureWatcher<CameraDefinition::LoadResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, retryUrl]() {
+        const CameraDefinition::LoadResult result = watcher->result();
+        watcher->deleteLater();
+        _definitionLoaded(result, retryUrl);
+    });
+    watcher->setFuture(QtConcurrent::run([bytes, fileName, cacheDir, localeName, xmlCopyFile]() {
+        return CameraDefinition::load(bytes, fileName, cacheDir, localeName, xmlCopyFile);
+    }));
+}
+
+//-----------------------------------------------------------------------------
+void
+VehicleCameraControl::_definitionLoaded(const CameraDefinition::LoadResult& result, const QString& retryUrl)
+{
+    if(!result.wellFormed && !retryUrl.isEmpty()) {
+        qWarning() << "Could not read cached camera definition file:" << _cacheFile << result.errorString;
+        _cached = false;
+        _httpRequest(retryUrl);
         return;
     }
-    QByteArray bytes = xmlFile.readAll();
-    QDomDocument doc;
-    if(!doc.setContent(bytes, false)) {
-        qWarning() << "Could not parse cached camera definition file:" << _cacheFile;
-        _httpRequest(url);
-        return;
+    if(result.valid) {
+        qCDebug(CameraControlLog) << "Loading camera definition" << (result.fromCache ? "(pre-parsed)" : "");
+        _loadCameraDefinition(result.definition);
+    } else {
+        qCWarning(CameraControlLog) << "Unable to load camera definition:" << result.errorString;
     }
-    //-- We have it
-    qCDebug(CameraControlLog) << "Using cached camera definition file:" << _cacheFile;
-    _cached = true;
-    emit dataReady(bytes);
+    _initWhenReady();
 }
 
 //-----------------------------------------------------------------------------
@@ -2120,32 +1754,15 @@ void VehicleCameraControl::_ftpDownloadComplete(const QString& fileName, const Q
 
     disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &VehicleCameraControl::_ftpDownloadComplete);
 
-    QString outputFileName = fileName;
-
-    if (fileName.endsWith(".lzma", Qt::CaseInsensitive) || fileName.endsWith(".xz", Qt::CaseInsensitive)) {
-        outputFileName = fileName.left(fileName.lastIndexOf("."));
-        if (QGCLZMA::inflateLZMAFile(fileName, outputFileName)) {
-            QFile(fileName).remove();
-        } else {
-            qCWarning(CameraControlLog) << "Inflate of compressed xml failed" << fileName;
-            outputFileName.clear();
-        }
-    }
-
-    QFile xmlFile(outputFileName);
-
-    if (!xmlFile.exists()) {
+    if (!QFile::exists(fileName)) {
         qCDebug(CameraControlLog) << "No camera definition file present after ftp download completed";
         return;
     }
-    if (!xmlFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not read downloaded camera definition file: " << fileName;
-        return;
-    }
 
-    _cached = true;
-    QByteArray bytes = xmlFile.readAll();
-    emit dataReady(bytes);
+    //-- A compressed download is inflated and removed by the loader, which then saves the xml as the cached definition
+    const bool compressed = fileName.endsWith(QStringLiteral(".lzma"), Qt::CaseInsensitive) || fileName.endsWith(QStringLiteral(".xz"), Qt::CaseInsensitive);
+    _cached = !compressed;
+    _loadDefinitionAsync(QByteArray(), fileName);
 }
 
 //-----------------------------------------------------------------------------
@@ -2154,22 +1771,17 @@ VehicleCameraControl::_dataReady(QByteArray data)
 {
     if(data.size()) {
         qCDebug(CameraControlLog) << "Parsing camera definition";
-        _loadCameraDefinitionFile(data);
-    } else {
-        qCDebug(CameraControlLog) << "No camera definition received, trying to search on our own...";
-        QFile definitionFile;
-        if(QGCCorePlugin::instance()->getOfflineCameraDefinitionFile(_modelName, definitionFile)) {
-            qCDebug(CameraControlLog) << "Found offline definition file for: " << _modelName << ", loading: " << definitionFile.fileName();
-            if (definitionFile.open(QIODevice::ReadOnly)) {
-                QByteArray newData = definitionFile.readAll();
-                _loadCameraDefinitionFile(newData);
-            } else {
-                qCDebug(CameraControlLog) << "error opening offline definition file for: " << _modelName;
-            }
-        } else {
-            qCDebug(CameraControlLog) << "No offline camera definition file found";
-        }
+        _loadDefinitionAsync(data, QString());
+        return;
+    }
+    qCDebug(CameraControlLog) << "No camera definition received, trying to search on our own...";
+    QFile definitionFile;
+    if(QGCCorePlugin::instance()->getOfflineCameraDefinitionFile(_modelName, definitionFile)) {
+        qCDebug(CameraControlLog) << "Found offline definition file for: " << _modelName << ", loading: " << definitionFile.fileName();
+        _loadDefinitionAsync(QByteArray(), definitionFile.fileName());
+        return;
     }
+    qCDebug(CameraControlLog) << "No offline camera definition file found";
     _initWhenReady();
 }
 
@@ -2184,6 +1796,7 @@ VehicleCameraControl::_paramDone()
     }
     //-- All parameters loaded (or timed out)
     _paramComplete = true;
+    _saveParamCache();
     emit parametersReady();
     //-- Check for video streaming
     _checkForVideoStreams();
@@ -9,38 +9,13 @@
 
 #pragma once
 
+#include "CameraDefinition.h"
+#include "CameraRuleTable.h"
 #include "MavlinkCameraControl.h"
 #include "QmlObjectListModel.h"
 
+class CameraParamScheduler;
 class QNetworkAccessManager;
-class QDomNode;
-class QDomNodeList;
-
-//-----------------------------------------------------------------------------
-/// Camera option exclusions
-class QGCCameraOptionExclusion : public QObject
-{
-public:
-    QGCCameraOptionExclusion(QObject* parent, QString param_, QString value_, QStringList exclusions_);
-    QString param;
-    QString value;
-    QStringList exclusions;
-};
-
-//-----------------------------------------------------------------------------
-/// Camera option ranges
-class QGCCameraOptionRange : public QObject
-{
-public:
-    QGCCameraOptionRange(QObject* parent, QString param_, QString value_, QString targetParam_, QString condition_, QStringList optNames_, QStringList optValues_);
-    QString param;
-    QString value;
-    QString targetParam;
-    QString condition;
-    QStringList  optNames;
-    QStringList  optValues;
-    QVariantList optVariants;
-};
 
 //-----------------------------------------------------------------------------
 /// MAVLink Camera API controller
@@ -197,6 +172,8 @@ public:
     static constexpr const char* kPhotoLapseCount = "PhotoLapseCount";
     static constexpr const char* kThermalOpacity  = "ThermalOpacity";
     static constexpr const char* kThermalMode     = "ThermalMode";
+    static constexpr const char* kParamCacheGroup = "CameraParamCache";
+    static constexpr const char* kParamCacheDefinitionVersion = "DefinitionVersion";
 
     //-----------------------------------------------------------------------------
     // Known Parameters
@@ -235,24 +212,22 @@ protected slots:
     virtual void    _checkForVideoStreams   ();
 
 private:
-    bool    _handleLocalization             (QByteArray& bytes);
-    bool    _replaceLocaleStrings           (const QDomNode node, QByteArray& bytes);
-    bool    _loadCameraDefinitionFile       (QByteArray& bytes);
-    bool    _loadConstants                  (const QDomNodeList nodeList);
-    bool    _loadSettings                   (const QDomNodeList nodeList);
+    bool    _loadCameraDefinition           (const CameraDefinition& definition);
+    bool    _loadSettings                   (const CameraDefinition& definition);
     void    _processRanges                  ();
-    bool    _processCondition               (const QString condition);
-    bool    _processConditionTest           (const QString conditionTest);
-    bool    _loadNameValue                  (QDomNode option, const QString factName, FactMetaData* metaData, QString& optName, QString& optValue, QVariant& optVariant);
-    bool    _loadRanges                     (QDomNode option, const QString factName, QString paramValue);
+    bool    _ruleValue                      (int param, QString& value) const;
     void    _updateActiveList               ();
     void    _updateRanges                   (Fact* pFact);
     void    _httpRequest                    (const QString& url);
     void    _handleDefinitionFile           (const QString& url);
+    void    _loadDefinitionAsync            (const QByteArray& bytes, const QString& fileName, const QString& retryUrl = QString());
+    void    _definitionLoaded               (const CameraDefinition::LoadResult& result, const QString& retryUrl);
     void    _ftpDownloadComplete            (const QString& fileName, const QString& errorMsg);
+    void    _sendParamRequestList           ();
+    QString _paramCacheGroup                () const;
+    QVariantMap _loadParamCache             () const;
+    void    _saveParamCache                 ();
 
-    QStringList     _loadExclusions         (QDomNode option);
-    QStringList     _loadUpdates            (QDomNode option);
     QString         _getParamName           (const char* param_id);
 
 protected:
@@ -281,11 +256,12 @@ protected:
     QStringList                         _activeSettings;
     QStringList                         _settings;
     QTimer                              _captureStatusTimer;
-    QList<QGCCameraOptionExclusion*>    _valueExclusions;
-    QList<QGCCameraOptionRange*>        _optionRanges;
+    CameraRuleTable                     _rules;
+    QList<Fact*>                        _ruleFacts;         ///< Indexed like _rules.parameters(), nullptr if there is no such fact
     QMap<QString, QStringList>          _originalOptNames;
     QMap<QString, QVariantList>         _originalOptValues;
     QMap<QString, QGCCameraParamIO*>    _paramIO;
+    CameraParamScheduler*               _paramScheduler     = nullptr;
     int                                 _cameraSettingsRetries = 0;
     int                                 _storageInfoRetries = 0;
     int                                 _captureInfoRetries = 0;
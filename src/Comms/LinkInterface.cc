@@ -123,8 +123,9 @@ void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
         printf("sign error: %s\n", strerror(errno));
     }
 
+    // Queued to the link's thread, a functor avoids looking the slot up by name on every message
     const QByteArray data((const char *)final_message, final_len);
-    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
+    (void) QMetaObject::invokeMethod(this, [this, data]() { _writeBytes(data); }, Qt::AutoConnection);
 }
 
 void LinkInterface::removeVehicleReference()
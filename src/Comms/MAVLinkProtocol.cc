@@ -12,6 +12,7 @@
 #include "MultiVehicleManager.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
+#include "QGCProfiler.h"
 #include "QGCTemporaryFile.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
@@ -140,6 +141,9 @@ void MAVLinkProtocol::logSentBytes(const LinkInterface *link, const QByteArray &
 
 void MAVLinkProtocol::receiveBytes(LinkInterface *link, const QByteArray &data)
 {
+    QGC_PROFILE_SCOPE("MAVLinkProtocol::receiveBytes");
+    QGC_PROFILE_COUNT("MAVLinkProtocol::bytesReceived", static_cast<quint64>(data.size()));
+
     const SharedLinkInterfacePtr linkPtr = LinkManager::instance()->sharedLinkInterfacePointerForLink(link);
     if (!linkPtr) {
         qCDebug(MAVLinkProtocolLog) << "receiveBytes: link gone!" << data.size() << "bytes arrived too late";
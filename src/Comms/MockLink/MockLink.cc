@@ -40,6 +40,9 @@ double      MockLink::_defaultVehicleLongitude =    -122.08833157994995;
 double      MockLink::_defaultVehicleHomeAltitude = 19.0;
 #endif
 int         MockLink::_nextVehicleSystemId =        128;
+int         MockLink::_nextSwarmSystemId =          1;      // Below the MockLink vehicles
+QMap<int, int> MockLink::_freeSwarmSystemIds;
+QMutex      MockLink::_swarmSystemIdMutex;
 
 // The LinkManager is only forward declared in the header, so a static_assert is here instead to ensure we update if the value changes.
 static_assert(LinkManager::invalidMavlinkChannel() == std::numeric_limits<uint8_t>::max(), "update MockLink::_mavlinkAuxChannel");
@@ -96,6 +99,7 @@ MockLink::MockLink(SharedLinkConfigurationPtr& config)
     _vehicleLongitude   = _defaultVehicleLongitude + ((_vehicleSystemId - 128) * 0.0001);
     _boardVendorId      = mockConfig->boardVendorId();
     _boardProductId     = mockConfig->boardProductId();
+    _latencyMs          = mockConfig->latencyMs();
 
     QObject::connect(this, &MockLink::writeBytesQueuedSignal, this, &MockLink::_writeBytesQueued, Qt::QueuedConnection);
 
@@ -106,6 +110,23 @@ MockLink::MockLink(SharedLinkConfigurationPtr& config)
 
     _mockLinkFTP = new MockLinkFTP(_vehicleSystemId, _vehicleComponentId, this);
 
+    MockLinkSwarm::Config swarmConfig = mockConfig->swarmConfig();
+    if ((swarmConfig.systemCount > 0) || (swarmConfig.adsbTargets > 0)) {
+        // Without systems of its own the swarm sends its ADS-B traffic as the vehicle
+        if (swarmConfig.systemCount > 0) {
+            const int requestedCount = swarmConfig.systemCount;
+            swarmConfig.firstSystemId = _allocateSwarmSystemIds(swarmConfig.systemCount);
+            if (swarmConfig.systemCount < requestedCount) {
+                qCWarning(MockLinkLog) << "Out of swarm system ids, limited to" << swarmConfig.systemCount << "systems";
+            }
+        } else {
+            swarmConfig.firstSystemId = _vehicleSystemId;
+        }
+
+        const QGeoCoordinate center(_vehicleLatitude, _vehicleLongitude, _defaultVehicleHomeAltitude);
+        _swarm = new MockLinkSwarm(swarmConfig, center, [this](const mavlink_message_t& msg) { respondWithMavlinkMessage(msg); }, this);
+    }
+
     moveToThread(this);
 
     _loadParams();
@@ -115,12 +136,70 @@ MockLink::MockLink(SharedLinkConfigurationPtr& config)
 MockLink::~MockLink(void)
 {
     disconnect();
+    if (_swarm) {
+        _releaseSwarmSystemIds(_swarm->config().firstSystemId, _swarm->config().systemCount);
+    }
     if (!_logDownloadFilename.isEmpty()) {
         QFile::remove(_logDownloadFilename);
     }
     qCDebug(MockLinkLog) << "~MockLink" << this;
 }
 
+int MockLink::_allocateSwarmSystemIds(int& count)
+{
+    QMutexLocker locker(&_swarmSystemIdMutex);
+
+    // First fit from the ids given back by swarms which were torn down
+    for (auto it = _freeSwarmSystemIds.begin(); it != _freeSwarmSystemIds.end(); it++) {
+        if (it.value() >= count) {
+            const int firstSystemId = it.key();
+            const int remaining = it.value() - count;
+            (void) _freeSwarmSystemIds.erase(it);
+            if (remaining > 0) {
+                _freeSwarmSystemIds.insert(firstSystemId + count, remaining);
+            }
+            return firstSystemId;
+        }
+    }
+
+    // Swarm systems must stay below the MockLink vehicles
+    const int firstSystemId = _nextSwarmSystemId;
+    count = qBound(0, count, 128 - firstSystemId);
+    _nextSwarmSystemId += count;
+    return firstSystemId;
+}
+
+void MockLink::_releaseSwarmSystemIds(int firstSystemId, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    QMutexLocker locker(&_swarmSystemIdMutex);
+
+    // Merge with the free ranges on either side
+    auto next = _freeSwarmSystemIds.find(firstSystemId + count);
+    if (next != _freeSwarmSystemIds.end()) {
+        count += next.value();
+        (void) _freeSwarmSystemIds.erase(next);
+    }
+    auto previous = _freeSwarmSystemIds.lowerBound(firstSystemId);
+    if (previous != _freeSwarmSystemIds.begin()) {
+        previous--;
+        if ((previous.key() + previous.value()) == firstSystemId) {
+            firstSystemId = previous.key();
+            count += previous.value();
+            (void) _freeSwarmSystemIds.erase(previous);
+        }
+    }
+
+    if ((firstSystemId + count) == _nextSwarmSystemId) {
+        _nextSwarmSystemId = firstSystemId;
+    } else {
+        _freeSwarmSystemIds.insert(firstSystemId, count);
+    }
+}
+
 bool MockLink::_connect(void)
 {
     if (!_connected) {
@@ -212,6 +291,10 @@ void MockLink::run(void)
         timerStatusText.start(10000);
     }
 
+    if (_swarm) {
+        _swarm->start(mavlinkChannel());
+    }
+
     // Send first set right away
     _run1HzTasks();
     _run10HzTasks();
@@ -219,6 +302,10 @@ void MockLink::run(void)
 
     exec();
 
+    if (_swarm) {
+        _swarm->stop();
+    }
+
     QObject::disconnect(&timer1HzTasks,  &QTimer::timeout, this, &MockLink::_run1HzTasks);
     QObject::disconnect(&timer10HzTasks, &QTimer::timeout, this, &MockLink::_run10HzTasks);
     QObject::disconnect(&timer500HzTasks, &QTimer::timeout, this, &MockLink::_run500HzTasks);
@@ -557,6 +644,16 @@ void MockLink::_writeBytes(const QByteArray &bytes)
 }
 
 void MockLink::_writeBytesQueued(const QByteArray bytes)
+{
+    if (_latencyMs > 0) {
+        // Precise timers keep equal delays in order
+        QTimer::singleShot(_latencyMs, Qt::PreciseTimer, this, [this, bytes]() { _receiveBytes(bytes); });
+    } else {
+        _receiveBytes(bytes);
+    }
+}
+
+void MockLink::_receiveBytes(const QByteArray &bytes)
 {
     if (_inNSH) {
         _handleIncomingNSHBytes(bytes.constData(), bytes.length());
@@ -617,6 +714,15 @@ void MockLink::_handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes)
 
 void MockLink::_handleIncomingMavlinkMsg(const mavlink_message_t &msg)
 {
+    {
+        QMutexLocker locker(&_receivedMessageCountMutex);
+        _receivedMessageCountMap[msg.msgid]++;
+    }
+
+    if (_swarm && _swarm->handleMessage(msg)) {
+        return;
+    }
+
     if (_missionItemHandler.handleMessage(msg)) {
         return;
     }
@@ -1455,6 +1561,8 @@ MockConfiguration::MockConfiguration(const MockConfiguration* source)
     _sendStatusText     = source->_sendStatusText;
     _incrementVehicleId = source->_incrementVehicleId;
     _failureMode        = source->_failureMode;
+    _swarmConfig        = source->_swarmConfig;
+    _latencyMs          = source->_latencyMs;
 }
 
 void MockConfiguration::copyFrom(const LinkConfiguration *source)
@@ -1472,6 +1580,8 @@ void MockConfiguration::copyFrom(const LinkConfiguration *source)
     _sendStatusText     = usource->_sendStatusText;
     _incrementVehicleId = usource->_incrementVehicleId;
     _failureMode        = usource->_failureMode;
+    _swarmConfig        = usource->_swarmConfig;
+    _latencyMs          = usource->_latencyMs;
 }
 
 void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
@@ -1482,6 +1592,11 @@ void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
     settings.setValue(_sendStatusTextKey,       _sendStatusText);
     settings.setValue(_incrementVehicleIdKey,   _incrementVehicleId);
     settings.setValue(_failureModeKey,          (int)_failureMode);
+    settings.setValue(_swarmSystemCountKey,     _swarmConfig.systemCount);
+    settings.setValue(_swarmAdsbTargetsKey,     _swarmConfig.adsbTargets);
+    settings.setValue(_swarmLossPercentKey,     _swarmConfig.lossPercent);
+    settings.setValue(_swarmLatencyKey,         _swarmConfig.latencyMs);
+    settings.setValue(_latencyKey,              _latencyMs);
     settings.sync();
     settings.endGroup();
 }
@@ -1494,6 +1609,11 @@ void MockConfiguration::loadSettings(QSettings& settings, const QString& root)
     _sendStatusText     = settings.value(_sendStatusTextKey, false).toBool();
     _incrementVehicleId = settings.value(_incrementVehicleIdKey, true).toBool();
     _failureMode        = (FailureMode_t)settings.value(_failureModeKey, (int)FailNone).toInt();
+    _swarmConfig.systemCount    = settings.value(_swarmSystemCountKey, 0).toInt();
+    _swarmConfig.adsbTargets    = settings.value(_swarmAdsbTargetsKey, 0).toInt();
+    _swarmConfig.lossPercent    = settings.value(_swarmLossPercentKey, 0).toDouble();
+    _swarmConfig.latencyMs      = settings.value(_swarmLatencyKey, 0).toInt();
+    _latencyMs                  = settings.value(_latencyKey, 0).toInt();
     settings.endGroup();
 }
 
@@ -1531,6 +1651,17 @@ MockLink*  MockLink::startGenericMockLink(bool sendStatusText, MockConfiguration
     return _startMockLinkWorker("Generic MockLink", MAV_AUTOPILOT_GENERIC, MAV_TYPE_QUADROTOR, sendStatusText, failureMode);
 }
 
+MockLink* MockLink::startSwarmMockLink(const MockLinkSwarm::Config& swarmConfig)
+{
+    MockConfiguration* mockConfig = new MockConfiguration("PX4 Swarm MockLink");
+
+    mockConfig->setFirmwareType(MAV_AUTOPILOT_PX4);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setSwarmConfig(swarmConfig);
+
+    return _startMockLink(mockConfig);
+}
+
 MockLink* MockLink::startNoInitialConnectMockLink(bool sendStatusText, MockConfiguration::FailureMode_t failureMode)
 {
     return _startMockLinkWorker("No Initial Connect MockLink", MAV_AUTOPILOT_PX4, MAV_TYPE_GENERIC, sendStatusText, failureMode);
@@ -11,6 +11,7 @@
 
 #include "MockLinkMissionItemHandler.h"
 #include "MockLinkFTP.h"
+#include "MockLinkSwarm.h"
 #include "QGCMAVLink.h"
 #include "LinkInterface.h"
 #include "LinkConfiguration.h"
@@ -19,6 +20,7 @@
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
 #include <QtCore/QMutex>
 
 Q_DECLARE_LOGGING_CATEGORY(MockLinkLog)
@@ -71,6 +73,15 @@ public:
     FailureMode_t failureMode(void) { return _failureMode; }
     void setFailureMode(FailureMode_t failureMode) { _failureMode = failureMode; }
 
+    /// Simulated systems and ADS-B traffic in addition to the vehicle, none by default
+    const MockLinkSwarm::Config& swarmConfig(void) const { return _swarmConfig; }
+    void setSwarmConfig(const MockLinkSwarm::Config& swarmConfig) { _swarmConfig = swarmConfig; }
+
+    /// Delay before the vehicle sees anything sent to it, adds that much to every round trip. Messages sent by the
+    /// vehicle on its own are not delayed.
+    int latencyMs(void) const { return _latencyMs; }
+    void setLatencyMs(int latencyMs) { _latencyMs = qMax(0, latencyMs); }
+
     // Overrides from LinkConfiguration
     LinkType    type            (void) const override                                         { return LinkConfiguration::TypeMock; }
     void        copyFrom        (const LinkConfiguration* source) override;
@@ -93,12 +104,19 @@ private:
     bool            _incrementVehicleId = true;
     uint16_t        _boardVendorId      = 0;
     uint16_t        _boardProductId     = 0;
+    MockLinkSwarm::Config _swarmConfig;
+    int             _latencyMs          = 0;
 
     static constexpr const char* _firmwareTypeKey         = "FirmwareType";
     static constexpr const char* _vehicleTypeKey          = "VehicleType";
     static constexpr const char* _sendStatusTextKey       = "SendStatusText";
     static constexpr const char* _incrementVehicleIdKey   = "IncrementVehicleId";
     static constexpr const char* _failureModeKey          = "FailureMode";
+    static constexpr const char* _swarmSystemCountKey     = "SwarmSystemCount";
+    static constexpr const char* _swarmAdsbTargetsKey     = "SwarmAdsbTargets";
+    static constexpr const char* _swarmLossPercentKey     = "SwarmLossPercent";
+    static constexpr const char* _swarmLatencyKey         = "SwarmLatency";
+    static constexpr const char* _latencyKey              = "Latency";
 };
 
 class MockLink : public LinkInterface
@@ -128,6 +146,9 @@ public:
 
     MockLinkFTP* mockLinkFTP(void) { return _mockLinkFTP; }
 
+    /// Simulated systems on this link besides the vehicle, nullptr if there are none
+    MockLinkSwarm* swarm(void) { return _swarm; }
+
     // Overrides from LinkInterface
     bool isConnected(void) const override { return _connected; }
     void disconnect (void) override;
@@ -170,6 +191,8 @@ public:
     static MockLink* startAPMArduPlaneMockLink      (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduSubMockLink        (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduRoverMockLink      (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
+    /// PX4 vehicle plus the simulated systems and ADS-B traffic of swarmConfig
+    static MockLink* startSwarmMockLink             (const MockLinkSwarm::Config& swarmConfig);
 
     // Special commands for testing Vehicle::sendMavCommandWithHandler
     static constexpr MAV_CMD MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED            = MAV_CMD_USER_1;
@@ -184,6 +207,8 @@ public:
 
     void clearReceivedMavCommandCounts(void) { _receivedMavCommandCountMap.clear(); }
     int receivedMavCommandCount(MAV_CMD command) { return _receivedMavCommandCountMap[command]; }
+    /// Number of messages with this id received from QGC, thread safe
+    int receivedMessageCount(uint32_t msgId) const { QMutexLocker locker(&_receivedMessageCountMutex); return _receivedMessageCountMap.value(msgId); }
 
     typedef enum {
         FailRequestMessageNone,
@@ -202,6 +227,7 @@ private slots:
     void _writeBytes(const QByteArray &bytes) final;
 
     void _writeBytesQueued      (const QByteArray bytes);
+    void _receiveBytes          (const QByteArray &bytes);
     void _run1HzTasks           (void);
     void _run10HzTasks          (void);
     void _run500HzTasks         (void);
@@ -262,6 +288,12 @@ private:
     static MockLink* _startMockLinkWorker(QString configName, MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType, bool sendStatusText, MockConfiguration::FailureMode_t failureMode);
     static MockLink* _startMockLink(MockConfiguration* mockConfig);
 
+    /// Reserves a contiguous range of swarm system ids
+    ///     @param count Number of ids wanted, lowered if not that many are left
+    /// @return First id of the range
+    static int  _allocateSwarmSystemIds (int& count);
+    static void _releaseSwarmSystemIds  (int firstSystemId, int count);
+
     /// Creates a file with random contents of the specified size.
     /// @return Fully qualified path to created file
     static QString _createRandomFile(uint32_t byteCount);
@@ -308,6 +340,8 @@ private:
     uint16_t                    _boardProductId     = 0;
 
     MockLinkFTP* _mockLinkFTP = nullptr;
+    MockLinkSwarm* _swarm = nullptr;
+    int _latencyMs = 0;
 
     bool _sendStatusText;
     bool _apmSendHomePositionOnEmptyList;
@@ -333,6 +367,8 @@ private:
     RequestMessageFailureMode_t _requestMessageFailureMode = FailRequestMessageNone;
 
     QMap<MAV_CMD, int>                          _receivedMavCommandCountMap;
+    QHash<uint32_t, int>                        _receivedMessageCountMap;
+    mutable QMutex                              _receivedMessageCountMutex;
     QMap<int, QMap<QString, QVariant>>          _mapParamName2Value;
     QMap<int, QMap<QString, MAV_PARAM_TYPE>>    _mapParamName2MavParamType;
 
@@ -340,6 +376,9 @@ private:
     static double       _defaultVehicleLongitude;
     static double       _defaultVehicleHomeAltitude;
     static int          _nextVehicleSystemId;
+    static int          _nextSwarmSystemId;
+    static QMap<int, int> _freeSwarmSystemIds;  ///< First id to count, ids given back by swarms which were torn down
+    static QMutex       _swarmSystemIdMutex;
     static constexpr const char*  _failParam = "COM_FLTMODE6";
 };
 
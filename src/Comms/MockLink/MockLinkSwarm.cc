@@ -0,0 +1,307 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarm.h"
+
+#include <QtCore/QtMath>
+
+#include <cstdio>
+
+MockLinkSwarm::MockLinkSwarm(const Config &config, const QGeoCoordinate &center, const Sender &sender, QObject *parent)
+    : QObject(parent)
+    , _config(config)
+    , _sender(sender)
+    , _tickTimer(this)      // A child, so it moves to the link thread along with the swarm
+    , _random(static_cast<quint32>(config.firstSystemId))
+{
+    // Systems fly circles around the center, targets cross the area further out
+    for (int i = 0; i < config.systemCount; i++) {
+        System system;
+        system.id = static_cast<uint8_t>(config.firstSystemId + i);
+        system.heading = (360.0 * i) / config.systemCount;
+        system.coordinate = center.atDistanceAndAzimuth(50.0 + (10.0 * i), system.heading);
+        system.coordinate.setAltitude(center.altitude() + 20.0 + (i % 10));
+
+        // Spread the streams over their interval, so the systems do not all send at once
+        for (int stream = 0; stream < StreamCount; stream++) {
+            system.nextSend[stream] = (i * 997) % 1000;
+        }
+        _systems.append(system);
+    }
+
+    for (int i = 0; i < config.adsbTargets; i++) {
+        Target target;
+        target.heading = _random.bounded(360.0);
+        target.coordinate = center.atDistanceAndAzimuth(500.0 + _random.bounded(20000.0), _random.bounded(360.0));
+        target.coordinate.setAltitude(center.altitude() + 300.0 + _random.bounded(3000.0));
+        target.nextSend = _random.bounded(1000);
+        _targets.append(target);
+    }
+
+    _tickTimer.setInterval(kTickInterval);
+    _tickTimer.setTimerType(Qt::PreciseTimer);
+    (void) connect(&_tickTimer, &QTimer::timeout, this, &MockLinkSwarm::_tick);
+}
+
+void MockLinkSwarm::start(uint8_t mavlinkChannel)
+{
+    _mavlinkChannel = mavlinkChannel;
+    _clock.start();
+    _tickTimer.start();
+}
+
+void MockLinkSwarm::stop()
+{
+    _tickTimer.stop();
+    _delayed.clear();
+}
+
+MockLinkSwarm::System *MockLinkSwarm::_system(int systemId)
+{
+    const int index = systemId - _config.firstSystemId;
+    return ((index >= 0) && (index < _systems.count())) ? &_systems[index] : nullptr;
+}
+
+template<typename Pack>
+void MockLinkSwarm::_pack(System &system, mavlink_message_t &message, Pack pack)
+{
+    mavlink_status_t *const status = mavlink_get_channel_status(_mavlinkChannel);
+    const uint8_t channelSequence = status->current_tx_seq;
+    status->current_tx_seq = system.sequence;
+    pack(message);
+    system.sequence = status->current_tx_seq;
+    status->current_tx_seq = channelSequence;
+}
+
+void MockLinkSwarm::_tick()
+{
+    const qint64 now = _clock.elapsed();
+
+    for (System &system : _systems) {
+        for (int stream = 0; stream < StreamCount; stream++) {
+            if ((system.nextSend[stream] >= 0) && (now >= system.nextSend[stream])) {
+                _sendStream(system, static_cast<Stream>(stream), now);
+            }
+        }
+    }
+
+    for (int i = 0; i < _targets.count(); i++) {
+        if ((_targets[i].nextSend >= 0) && (now >= _targets[i].nextSend)) {
+            _sendTarget(i, now);
+        }
+    }
+
+    while (!_delayed.empty() && (_delayed.begin()->first <= now)) {
+        _sender(_delayed.begin()->second);
+        (void) _delayed.erase(_delayed.begin());
+    }
+}
+
+void MockLinkSwarm::_sendStream(System &system, Stream stream, qint64 now)
+{
+    double rateHz = 0;
+    switch (stream) {
+    case StreamHeartbeat:   rateHz = _config.heartbeatRateHz;   break;
+    case StreamPosition:    rateHz = _config.positionRateHz;    break;
+    case StreamAttitude:    rateHz = _config.attitudeRateHz;    break;
+    case StreamSysStatus:   rateHz = _config.sysStatusRateHz;   break;
+    default:                                                    break;
+    }
+
+    const qint64 interval = _interval(rateHz);
+    if (interval <= 0) {
+        system.nextSend[stream] = -1;
+        return;
+    }
+    // Catch up without bursting if the thread fell behind
+    system.nextSend[stream] = qMax(system.nextSend[stream] + interval, now);
+
+    const uint32_t bootMs = static_cast<uint32_t>(now);
+    mavlink_message_t message;
+
+    switch (stream) {
+    case StreamHeartbeat:
+        _pack(system, message, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_heartbeat_pack_chan(system.id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                   MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_GENERIC,
+                                                   MAV_MODE_FLAG_CUSTOM_MODE_ENABLED, 0, MAV_STATE_STANDBY);
+        });
+        break;
+    case StreamPosition:
+    {
+        // 5 m/s along the circle
+        system.heading = fmod(system.heading + (5.0 * interval / 1000.0), 360.0);
+        system.coordinate = system.coordinate.atDistanceAndAzimuth(5.0 * interval / 1000.0, system.heading);
+        _pack(system, message, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_global_position_int_pack_chan(system.id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                             bootMs,
+                                                             static_cast<int32_t>(system.coordinate.latitude() * 1e7),
+                                                             static_cast<int32_t>(system.coordinate.longitude() * 1e7),
+                                                             static_cast<int32_t>(system.coordinate.altitude() * 1000),
+                                                             20000,
+                                                             0, 0, 0,
+                                                             static_cast<uint16_t>(system.heading * 100));
+        });
+        break;
+    }
+    case StreamAttitude:
+        _pack(system, message, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_attitude_pack_chan(system.id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                  bootMs,
+                                                  0.05f * qSin(now / 1000.0), 0.05f * qCos(now / 1000.0),
+                                                  static_cast<float>(qDegreesToRadians(system.heading)),
+                                                  0, 0, 0);
+        });
+        break;
+    case StreamSysStatus:
+        _pack(system, message, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_sys_status_pack_chan(system.id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                    MAV_SYS_STATUS_SENSOR_GPS, 0, 0,
+                                                    250,            // load
+                                                    4200 * 4,       // voltage_battery
+                                                    8000,           // current_battery
+                                                    80,             // battery_remaining
+                                                    0,0,0,0,0,0,0,0,0);
+        });
+        break;
+    default:
+        return;
+    }
+
+    _send(message);
+}
+
+void MockLinkSwarm::_sendTarget(int index, qint64 now)
+{
+    const qint64 interval = _interval(_config.adsbRateHz);
+    if (interval <= 0) {
+        _targets[index].nextSend = -1;
+        return;
+    }
+    _targets[index].nextSend = qMax(_targets[index].nextSend + interval, now);
+
+    // Airliner speed, turning slowly
+    Target &target = _targets[index];
+    target.heading = fmod(target.heading + 0.5, 360.0);
+    target.coordinate = target.coordinate.atDistanceAndAzimuth(120.0 * interval / 1000.0, target.heading);
+
+    char callsign[MAVLINK_MSG_ADSB_VEHICLE_FIELD_CALLSIGN_LEN] = {};
+    (void) snprintf(callsign, sizeof(callsign), "SWM%04d", index % 10000);
+
+    mavlink_message_t message;
+    const auto pack = [&](mavlink_message_t &msg) {
+        (void) mavlink_msg_adsb_vehicle_pack_chan(static_cast<uint8_t>(_config.firstSystemId), MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                  0x100000 + index,     // ICAO address
+                                                  static_cast<int32_t>(target.coordinate.latitude() * 1e7),
+                                                  static_cast<int32_t>(target.coordinate.longitude() * 1e7),
+                                                  ADSB_ALTITUDE_TYPE_GEOMETRIC,
+                                                  static_cast<int32_t>(target.coordinate.altitude() * 1000),
+                                                  static_cast<uint16_t>(target.heading * 100),
+                                                  12000, 0,             // cm/s
+                                                  callsign,
+                                                  ADSB_EMITTER_TYPE_LARGE,
+                                                  1,
+                                                  ADSB_FLAGS_VALID_COORDS | ADSB_FLAGS_VALID_ALTITUDE | ADSB_FLAGS_VALID_HEADING | ADSB_FLAGS_VALID_VELOCITY | ADSB_FLAGS_VALID_CALLSIGN | ADSB_FLAGS_SIMULATED,
+                                                  0);
+    };
+    if (_systems.isEmpty()) {
+        // Sent on behalf of the link's own vehicle, which shares the channel sequence
+        pack(message);
+    } else {
+        // Sent by the first system
+        _pack(_systems.first(), message, pack);
+    }
+
+    _send(message);
+}
+
+void MockLinkSwarm::_send(const mavlink_message_t &message)
+{
+    if ((_config.lossPercent > 0) && (_random.bounded(100.0) < _config.lossPercent)) {
+        _messagesDropped++;
+        return;
+    }
+    _messagesSent++;
+
+    const int latency = _config.latencyMs + ((_config.latencyJitterMs > 0) ? _random.bounded(_config.latencyJitterMs + 1) : 0);
+    if (latency <= 0) {
+        _sender(message);
+        return;
+    }
+
+    (void) _delayed.emplace(_clock.elapsed() + latency, message);
+}
+
+int MockLinkSwarm::_targetSystem(const mavlink_message_t &message)
+{
+    const mavlink_msg_entry_t *const entry = mavlink_get_msg_entry(message.msgid);
+    if (!entry || !(entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM)) {
+        return -1;
+    }
+
+    // Trailing zeros of MAVLink 2 payloads are truncated
+    if (entry->target_system_ofs >= message.len) {
+        return 0;
+    }
+    return static_cast<uint8_t>(_MAV_PAYLOAD(&message)[entry->target_system_ofs]);
+}
+
+bool MockLinkSwarm::handleMessage(const mavlink_message_t &message)
+{
+    System *const system = _system(_targetSystem(message));
+    if (!system) {
+        return false;
+    }
+
+    mavlink_message_t response;
+
+    switch (message.msgid) {
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+    case MAVLINK_MSG_ID_COMMAND_INT:
+    {
+        uint16_t command = 0;
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_LONG) {
+            command = mavlink_msg_command_long_get_command(&message);
+        } else {
+            command = mavlink_msg_command_int_get_command(&message);
+        }
+        _pack(*system, response, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_command_ack_pack_chan(system->id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                     command, MAV_RESULT_UNSUPPORTED, 0, 0, message.sysid, message.compid);
+        });
+        _send(response);
+        break;
+    }
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+    {
+        char paramId[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN] = "SYSID_THISMAV";
+        _pack(*system, response, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_param_value_pack_chan(system->id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                     paramId, system->id, MAV_PARAM_TYPE_REAL32, 1, 0);
+        });
+        _send(response);
+        break;
+    }
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+    {
+        const uint8_t missionType = mavlink_msg_mission_request_list_get_mission_type(&message);
+        _pack(*system, response, [&](mavlink_message_t &msg) {
+            (void) mavlink_msg_mission_count_pack_chan(system->id, MAV_COMP_ID_AUTOPILOT1, _mavlinkChannel, &msg,
+                                                       message.sysid, message.compid, 0, missionType, 0);
+        });
+        _send(response);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return true;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "MAVLinkLib.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTimer>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <atomic>
+#include <functional>
+#include <map>
+
+/// Additional simulated systems and ADS-B traffic on a MockLink, to load the GCS like a large fleet does.
+///
+/// Each system sends telemetry at the configured rates and answers just enough of the initial connect sequence for
+/// QGC to finish it quickly: commands are acked as unsupported, the parameter list holds a single parameter and all
+/// missions are empty. Everything the swarm sends can be dropped or delayed to simulate a poor radio link.
+///
+/// Lives on the MockLink thread.
+class MockLinkSwarm : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        int     systemCount         = 0;
+        int     firstSystemId       = 1;
+        double  heartbeatRateHz     = 1;
+        double  positionRateHz      = 5;    ///< GLOBAL_POSITION_INT
+        double  attitudeRateHz      = 10;
+        double  sysStatusRateHz     = 1;
+        double  lossPercent         = 0;    ///< Messages dropped at random
+        int     latencyMs           = 0;
+        int     latencyJitterMs     = 0;    ///< Added to latencyMs at random, messages may arrive out of order
+        int     adsbTargets         = 0;
+        double  adsbRateHz          = 1;    ///< Per target
+    };
+
+    /// Hands a message to the link
+    using Sender = std::function<void(const mavlink_message_t &message)>;
+
+    MockLinkSwarm(const Config &config, const QGeoCoordinate &center, const Sender &sender, QObject *parent = nullptr);
+
+    const Config &config() const { return _config; }
+
+    /// Must be called from the link thread
+    ///     @param mavlinkChannel Channel the link sends on
+    void start(uint8_t mavlinkChannel);
+    void stop();
+
+    /// @return true if the message was addressed to one of the simulated systems, which then handled it
+    bool handleMessage(const mavlink_message_t &message);
+
+    quint64 messagesSent() const { return _messagesSent; }          ///< Thread safe
+    quint64 messagesDropped() const { return _messagesDropped; }    ///< Thread safe
+
+    static constexpr int kTickInterval = 10;
+
+private slots:
+    void _tick();
+
+private:
+    enum Stream {
+        StreamHeartbeat,
+        StreamPosition,
+        StreamAttitude,
+        StreamSysStatus,
+        StreamCount
+    };
+
+    struct System {
+        uint8_t         id          = 0;
+        uint8_t         sequence    = 0;
+        QGeoCoordinate  coordinate;
+        double          heading     = 0;
+        qint64          nextSend[StreamCount] = {};
+    };
+
+    struct Target {
+        QGeoCoordinate  coordinate;
+        double          heading     = 0;
+        qint64          nextSend    = 0;
+    };
+
+    void _sendStream(System &system, Stream stream, qint64 now);
+    void _sendTarget(int index, qint64 now);
+    /// Packs with the system's own sequence numbers, the channel is shared by all systems
+    template<typename Pack> void _pack(System &system, mavlink_message_t &message, Pack pack);
+    void _send(const mavlink_message_t &message);
+    System *_system(int systemId);
+    static int _targetSystem(const mavlink_message_t &message);
+    static qint64 _interval(double rateHz) { return (rateHz > 0) ? static_cast<qint64>(1000.0 / rateHz) : 0; }
+
+    Config          _config;
+    uint8_t         _mavlinkChannel = 0;
+    Sender          _sender;
+    QList<System>   _systems;
+    QList<Target>   _targets;
+    QTimer          _tickTimer;
+    QElapsedTimer   _clock;
+    QRandomGenerator _random;
+
+    std::multimap<qint64, mavlink_message_t> _delayed;  ///< By the time they are due
+
+    std::atomic<quint64> _messagesSent = 0;
+    std::atomic<quint64> _messagesDropped = 0;
+};
@@ -38,6 +38,7 @@ Item {
     property real   _circleRadius
     property bool   _circleRadiusDrag:          false
     property var    _circleRadiusDragCoord:     QtPositioning.coordinate()
+    property string _shapeFile                                  ///< File the user may still pick another polygon from
     property bool   _editCircleRadius:          false
     property string _instructionText:           _polygonToolsText
     property var    _savedVertices:             [ ]
@@ -205,6 +206,41 @@ Item {
         }
     }
 
+    Connections {
+        target: mapPolygon
+
+        function onLoadKMLOrSHPFileComplete(success, polygonCount) {
+            if (success) {
+                mapFitFunctions.fitMapViewportToMissionItems()
+                if (polygonCount > 1 && _shapeFile !== "") {
+                    shapeSelectDialogComponent.createObject(mainWindow, { shapeCount: polygonCount }).open()
+                    return
+                }
+            }
+            _shapeFile = ""
+            mapPolygon.clearLoadedPolygons()
+        }
+    }
+
+    Component {
+        id: shapeSelectDialogComponent
+
+        ShapeFileSelectDialog {
+            onShapeSelected: (shapeIndex) => {
+                _shapeFile = ""
+                if (shapeIndex !== 0 && mapPolygon.selectLoadedPolygon(shapeIndex)) {
+                    mapFitFunctions.fitMapViewportToMissionItems()
+                } else {
+                    mapPolygon.clearLoadedPolygons()
+                }
+            }
+            onRejected: {
+                _shapeFile = ""
+                mapPolygon.clearLoadedPolygons()
+            }
+        }
+    }
+
     Component.onCompleted: {
         addCommonVisuals()
         _handleInteractiveChanged()
@@ -224,8 +260,8 @@ Item {
         title:          qsTr("Select Polygon File")
 
         onAcceptedForLoad: (file) => {
-            mapPolygon.loadKMLOrSHPFile(file)
-            mapFitFunctions.fitMapViewportToMissionItems()
+            _shapeFile = file
+            mapPolygon.loadKMLOrSHPFileAsync(file, 0)
             close()
         }
     }
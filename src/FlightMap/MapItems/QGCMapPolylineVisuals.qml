@@ -36,6 +36,7 @@ Item {
     property real   _zorderDragHandle:      QGroundControl.zOrderMapItems + 3   // Highest to prevent splitting when items overlap
     property real   _zorderSplitHandle:     QGroundControl.zOrderMapItems + 2
     property var    _savedVertices:         [ ]
+    property string _shapeFile                  ///< File the user may still pick another polyline from
 
     readonly property string _corridorToolsText:    qsTr("Polyline Tools")
     readonly property string _traceText:            qsTr("Click in the map to add vertices. Click 'Done Tracing' when finished.")
@@ -108,6 +109,38 @@ Item {
         }
     }
 
+    Connections {
+        target: mapPolyline
+
+        function onLoadKMLFileComplete(success, polylineCount) {
+            if (success && polylineCount > 1 && _shapeFile !== "") {
+                shapeSelectDialogComponent.createObject(mainWindow, { shapeCount: polylineCount, shapeName: qsTr("Polyline") }).open()
+                return
+            }
+            _shapeFile = ""
+            mapPolyline.clearLoadedPolylines()
+        }
+    }
+
+    Component {
+        id: shapeSelectDialogComponent
+
+        ShapeFileSelectDialog {
+            onShapeSelected: (shapeIndex) => {
+                _shapeFile = ""
+                if (shapeIndex !== 0) {
+                    mapPolyline.selectLoadedPolyline(shapeIndex)
+                } else {
+                    mapPolyline.clearLoadedPolylines()
+                }
+            }
+            onRejected: {
+                _shapeFile = ""
+                mapPolyline.clearLoadedPolylines()
+            }
+        }
+    }
+
     Component.onCompleted: {
         _addCommonVisuals()
         if (interactive) {
@@ -129,7 +162,8 @@ Item {
         nameFilters:    ShapeFileHelper.fileDialogKMLFilters
 
         onAcceptedForLoad: (file) => {
-            mapPolyline.loadKMLFile(file)
+            _shapeFile = file
+            mapPolyline.loadKMLFileAsync(file, 0)
             close()
         }
     }
@@ -9,7 +9,12 @@
 
 #include "GPSManager.h"
 #include "GPSRtk.h"
+#include "NTRIPClient.h"
+#include "PositionManager.h"
 #include "QGCLoggingCategory.h"
+#include "RTCMMavlink.h"
+#include "RTKSettings.h"
+#include "SettingsManager.h"
 
 #include <QtCore/qapplicationstatic.h>
 
@@ -19,9 +24,32 @@ Q_APPLICATION_STATIC(GPSManager, _gpsManager);
 
 GPSManager::GPSManager(QObject *parent)
     : QObject(parent)
-    , _gpsRtk(new GPSRtk(this))
+    , _rtcmMavlink(new RTCMMavlink(this))
+    , _gpsRtk(new GPSRtk(_rtcmMavlink, this))
+    , _ntripClient(new NTRIPClient(this))
 {
     // qCDebug(GPSManagerLog) << Q_FUNC_INFO << this;
+
+    // Caster corrections share the link queues and budgets with those of a local base station
+    (void) connect(_ntripClient, &NTRIPClient::RTCMDataUpdate, _rtcmMavlink, &RTCMMavlink::RTCMDataUpdate);
+    (void) connect(QGCPositionManager::instance(), &QGCPositionManager::gcsPositionChanged, _ntripClient, &NTRIPClient::setPosition);
+
+    RTKSettings* const rtkSettings = SettingsManager::instance()->rtkSettings();
+    const QList<Fact*> ntripFacts = {
+        rtkSettings->ntripServerConnectEnabled(),
+        rtkSettings->ntripServerHostAddress(),
+        rtkSettings->ntripServerPort(),
+        rtkSettings->ntripMountpoint(),
+        rtkSettings->ntripUsername(),
+        rtkSettings->ntripPassword(),
+        rtkSettings->ntripVersion(),
+        rtkSettings->ntripWhitelist(),
+        rtkSettings->ntripSendGGA()
+    };
+    for (Fact *fact : ntripFacts) {
+        (void) connect(fact, &Fact::rawValueChanged, this, &GPSManager::_ntripSettingsChanged);
+    }
+    _ntripSettingsChanged();
 }
 
 GPSManager::~GPSManager()
@@ -33,3 +61,39 @@ GPSManager *GPSManager::instance()
 {
     return _gpsManager();
 }
+
+void GPSManager::_ntripSettingsChanged()
+{
+    RTKSettings* const rtkSettings = SettingsManager::instance()->rtkSettings();
+
+    NTRIPClient::Config config;
+    config.host = rtkSettings->ntripServerHostAddress()->rawValue().toString();
+    config.port = rtkSettings->ntripServerPort()->rawValue().toUInt();
+    config.mountpoint = rtkSettings->ntripMountpoint()->rawValue().toString();
+    config.username = rtkSettings->ntripUsername()->rawValue().toString();
+    config.password = rtkSettings->ntripPassword()->rawValue().toString();
+    config.version = rtkSettings->ntripVersion()->rawValue().toInt();
+    config.ggaInterval = rtkSettings->ntripSendGGA()->rawValue().toBool() ? NTRIPClient::kDefaultGgaInterval : 0;
+
+    const QStringList whitelist = rtkSettings->ntripWhitelist()->rawValue().toString().split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &type : whitelist) {
+        bool ok = false;
+        const int messageType = type.trimmed().toInt(&ok);
+        if (ok) {
+            config.messageFilter.insert(messageType);
+        } else {
+            qCWarning(GPSManagerLog) << "Invalid RTCM message type in filter:" << type;
+        }
+    }
+
+    if (!rtkSettings->ntripServerConnectEnabled()->rawValue().toBool() || config.host.isEmpty() || config.mountpoint.isEmpty()) {
+        _ntripClient->stop();
+        return;
+    }
+
+    const QGeoCoordinate position = QGCPositionManager::instance()->gcsPosition();
+    if (position.isValid()) {
+        _ntripClient->setPosition(position);
+    }
+    _ntripClient->start(config);
+}
@@ -15,6 +15,8 @@
 Q_DECLARE_LOGGING_CATEGORY(GPSManagerLog)
 
 class GPSRtk;
+class NTRIPClient;
+class RTCMMavlink;
 
 class GPSManager : public QObject
 {
@@ -27,7 +29,14 @@ public:
     static GPSManager *instance();
 
     GPSRtk *gpsRtk() { return _gpsRtk; }
+    NTRIPClient *ntripClient() { return _ntripClient; }
+    RTCMMavlink *rtcmMavlink() { return _rtcmMavlink; }
+
+private slots:
+    void _ntripSettingsChanged();
 
 private:
+    RTCMMavlink *_rtcmMavlink = nullptr;
     GPSRtk *_gpsRtk = nullptr;
+    NTRIPClient *_ntripClient = nullptr;
 };
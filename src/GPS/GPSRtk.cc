@@ -17,8 +17,9 @@
 
 QGC_LOGGING_CATEGORY(GPSRtkLog, "qgc.gps.gpsrtk")
 
-GPSRtk::GPSRtk(QObject *parent)
+GPSRtk::GPSRtk(RTCMMavlink *rtcmMavlink, QObject *parent)
     : QObject(parent)
+    , _rtcmMavlink(rtcmMavlink)
     , _gpsRtkFactGroup(new GPSRTKFactGroup(this))
 {
     // qCDebug(GPSRtkLog) << Q_FUNC_INFO << this;
@@ -98,7 +99,6 @@ void GPSRtk::connectGPS(const QString &device, QStringView gps_type)
     );
     (void) QMetaObject::invokeMethod(_gpsProvider, "start", Qt::AutoConnection);
 
-    _rtcmMavlink = new RTCMMavlink(this);
     (void) connect(_gpsProvider, &GPSProvider::RTCMDataUpdate, _rtcmMavlink, &RTCMMavlink::RTCMDataUpdate);
 
     (void) connect(_gpsProvider, &GPSProvider::satelliteInfoUpdate, this, &GPSRtk::_satelliteInfoUpdate);
@@ -120,11 +120,6 @@ void GPSRtk::disconnectGPS()
         _gpsProvider->deleteLater();
         _gpsProvider = nullptr;
     }
-
-    if (_rtcmMavlink) {
-        _rtcmMavlink->deleteLater();
-        _rtcmMavlink = nullptr;
-    }
 }
 
 bool GPSRtk::connected() const
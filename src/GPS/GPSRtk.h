@@ -29,7 +29,8 @@ class GPSRtk : public QObject
     Q_OBJECT
 
 public:
-    GPSRtk(QObject *parent = nullptr);
+    /// @param rtcmMavlink Forwards the corrections of the base station to the vehicles, not owned
+    GPSRtk(RTCMMavlink *rtcmMavlink, QObject *parent = nullptr);
     ~GPSRtk();
 
     static void registerQmlTypes();
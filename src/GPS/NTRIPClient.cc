@@ -0,0 +1,341 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "NTRIPClient.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDateTime>
+#include <QtNetwork/QTcpSocket>
+
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(NTRIPClientLog, "qgc.gps.ntripclient")
+
+NTRIPClient::NTRIPClient(QObject *parent)
+    : QObject(parent)
+    , _socket(new QTcpSocket(this))
+{
+    // qCDebug(NTRIPClientLog) << Q_FUNC_INFO << this;
+
+    (void) connect(_socket, &QTcpSocket::connected, this, &NTRIPClient::_onConnected);
+    (void) connect(_socket, &QTcpSocket::disconnected, this, &NTRIPClient::_onDisconnected);
+    (void) connect(_socket, &QTcpSocket::readyRead, this, &NTRIPClient::_onReadyRead);
+    (void) connect(_socket, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+        _fail(_socket->errorString());
+    });
+
+    _reconnectTimer.setSingleShot(true);
+    (void) connect(&_reconnectTimer, &QTimer::timeout, this, &NTRIPClient::_connect);
+
+    _timeoutTimer.setSingleShot(true);
+    (void) connect(&_timeoutTimer, &QTimer::timeout, this, &NTRIPClient::_onTimeout);
+
+    (void) connect(&_ggaTimer, &QTimer::timeout, this, &NTRIPClient::_sendGGA);
+}
+
+NTRIPClient::~NTRIPClient()
+{
+    stop();
+
+    // qCDebug(NTRIPClientLog) << Q_FUNC_INFO << this;
+}
+
+void NTRIPClient::start(const Config &config)
+{
+    stop();
+
+    _config = config;
+    _parser.setMessageFilter(config.messageFilter);
+    _reconnectDelay = kMinReconnectDelay;
+    _connect();
+}
+
+void NTRIPClient::stop()
+{
+    _setState(State::Disconnected);
+
+    _reconnectTimer.stop();
+    _timeoutTimer.stop();
+    _ggaTimer.stop();
+    _socket->abort();
+}
+
+void NTRIPClient::setPosition(const QGeoCoordinate &position)
+{
+    const bool first = !_position.isValid();
+    _position = position;
+
+    // A VRS caster sends nothing until it knows where the rover is
+    if (first && (_state == State::Streaming)) {
+        _sendGGA();
+    }
+}
+
+void NTRIPClient::_setState(State state)
+{
+    if (state != _state) {
+        _state = state;
+        emit stateChanged(state);
+    }
+}
+
+void NTRIPClient::_connect()
+{
+    qCDebug(NTRIPClientLog) << "Connecting to" << _config.host << _config.port << _config.mountpoint;
+
+    _header.clear();
+    _chunked = false;
+    _chunkBuffer.clear();
+    _chunkRemaining = -1;
+    _parser.reset();
+
+    _setState(State::Connecting);
+    _timeoutTimer.start(kResponseTimeout);
+    _socket->connectToHost(_config.host, _config.port);
+}
+
+void NTRIPClient::_onConnected()
+{
+    if (_state != State::Connecting) {
+        return;
+    }
+
+    _setState(State::WaitingForResponse);
+    (void) _socket->write(makeRequest(_config));
+}
+
+void NTRIPClient::_onDisconnected()
+{
+    switch (_state) {
+    case State::Connecting:
+    case State::WaitingForResponse:
+    case State::Streaming:
+        _fail(tr("Caster closed the connection"));
+        break;
+    default:
+        break;
+    }
+}
+
+void NTRIPClient::_onTimeout()
+{
+    _fail((_state == State::Streaming) ? tr("No data from caster") : tr("No response from caster"));
+}
+
+void NTRIPClient::_fail(const QString &errorString)
+{
+    if ((_state == State::Disconnected) || (_state == State::WaitingToReconnect)) {
+        return;
+    }
+
+    qCWarning(NTRIPClientLog) << errorString << "- reconnecting in" << _reconnectDelay << "ms";
+
+    _setState(State::WaitingToReconnect);
+    _timeoutTimer.stop();
+    _ggaTimer.stop();
+    _socket->abort();
+
+    _reconnectTimer.start(_reconnectDelay);
+    _reconnectDelay = qMin(_reconnectDelay * 2, kMaxReconnectDelay);
+
+    emit errorOccurred(errorString);
+}
+
+void NTRIPClient::_onReadyRead()
+{
+    const QByteArray data = _socket->readAll();
+    _bytesReceived += data.size();
+
+    switch (_state) {
+    case State::WaitingForResponse:
+        _header.append(data);
+        if (_parseHeader()) {
+            // Whatever followed the header is already stream data
+            const QByteArray body = std::exchange(_header, QByteArray());
+            _processBody(body);
+        }
+        break;
+    case State::Streaming:
+        _timeoutTimer.start(kDataTimeout);
+        _processBody(data);
+        break;
+    default:
+        break;
+    }
+}
+
+bool NTRIPClient::_parseHeader()
+{
+    // NTRIP 1.0 casters answer with a bare status line, 2.0 ones with an HTTP header
+    qsizetype bodyStart = -1;
+    if (_header.startsWith("ICY 200")) {
+        const qsizetype lineEnd = _header.indexOf("\r\n");
+        if (lineEnd >= 0) {
+            bodyStart = lineEnd + 2;
+        }
+    } else {
+        const qsizetype headerEnd = _header.indexOf("\r\n\r\n");
+        if (headerEnd >= 0) {
+            const QByteArray statusLine = _header.left(_header.indexOf("\r\n"));
+            if (statusLine.startsWith("SOURCETABLE")) {
+                _fail(tr("Mountpoint %1 not found").arg(_config.mountpoint));
+                return false;
+            }
+            if (!statusLine.startsWith("HTTP/") || (statusLine.split(' ').value(1) != "200")) {
+                _fail(tr("Caster refused the request: %1").arg(QString::fromLatin1(statusLine)));
+                return false;
+            }
+
+            const QList<QByteArray> lines = _header.left(headerEnd).split('\n');
+            for (const QByteArray &line : lines) {
+                if (line.trimmed().toLower() == "transfer-encoding: chunked") {
+                    _chunked = true;
+                }
+            }
+            bodyStart = headerEnd + 4;
+        }
+    }
+
+    if (bodyStart < 0) {
+        if (_header.size() > kMaxHeaderLength) {
+            _fail(tr("Invalid response from caster"));
+        }
+        return false;
+    }
+
+    qCDebug(NTRIPClientLog) << "Streaming" << _config.mountpoint << (_chunked ? "chunked" : "");
+
+    (void) _header.remove(0, bodyStart);
+    _setState(State::Streaming);
+    _timeoutTimer.start(kDataTimeout);
+    _sendGGA();
+    if (_config.ggaInterval > 0) {
+        _ggaTimer.start(_config.ggaInterval);
+    }
+
+    return true;
+}
+
+void NTRIPClient::_processBody(QByteArrayView data)
+{
+    if (!_chunked) {
+        _forward(data);
+        return;
+    }
+
+    _chunkBuffer.append(data);
+
+    qsizetype pos = 0;
+    while ((pos < _chunkBuffer.size()) && (_state == State::Streaming)) {
+        if (_chunkRemaining < 0) {
+            const qsizetype lineEnd = _chunkBuffer.indexOf("\r\n", pos);
+            if (lineEnd < 0) {
+                break;
+            }
+
+            // Chunk extensions after ';' are ignored
+            bool ok = false;
+            const qint64 chunkSize = _chunkBuffer.mid(pos, lineEnd - pos).split(';').constFirst().trimmed().toLongLong(&ok, 16);
+            if (!ok) {
+                _fail(tr("Invalid chunk from caster"));
+                return;
+            }
+            pos = lineEnd + 2;
+            _chunkRemaining = chunkSize;
+            if (chunkSize == 0) {
+                // Last chunk, the caster closes the connection next
+                break;
+            }
+        } else if (_chunkRemaining == 0) {
+            // Line end after the chunk data
+            if ((_chunkBuffer.size() - pos) < 2) {
+                break;
+            }
+            pos += 2;
+            _chunkRemaining = -1;
+        } else {
+            const qsizetype length = qMin<qint64>(_chunkRemaining, _chunkBuffer.size() - pos);
+            _forward(QByteArrayView(_chunkBuffer).sliced(pos, length));
+            pos += length;
+            _chunkRemaining -= length;
+        }
+    }
+
+    (void) _chunkBuffer.remove(0, pos);
+}
+
+void NTRIPClient::_forward(QByteArrayView data)
+{
+    const QList<QByteArray> frames = _parser.addData(data);
+    if (!frames.isEmpty()) {
+        // Corrections are flowing, the next lost connection starts over with a short delay
+        _reconnectDelay = kMinReconnectDelay;
+    }
+
+    for (const QByteArray &frame : frames) {
+        emit RTCMDataUpdate(frame);
+    }
+}
+
+void NTRIPClient::_sendGGA()
+{
+    if ((_state != State::Streaming) || (_config.ggaInterval <= 0) || !_position.isValid()) {
+        return;
+    }
+
+    (void) _socket->write(makeGGA(_position, QDateTime::currentDateTimeUtc().time()));
+}
+
+QByteArray NTRIPClient::makeRequest(const Config &config)
+{
+    const bool version2 = (config.version >= 2);
+
+    QByteArray request = "GET /" + config.mountpoint.toUtf8() + (version2 ? " HTTP/1.1\r\n" : " HTTP/1.0\r\n");
+    request += "Host: " + config.host.toUtf8() + ":" + QByteArray::number(config.port) + "\r\n";
+    if (version2) {
+        request += "Ntrip-Version: Ntrip/2.0\r\n";
+    }
+    request += "User-Agent: NTRIP QGroundControl\r\n";
+    if (!config.username.isEmpty()) {
+        request += "Authorization: Basic " + (config.username + ":" + config.password).toUtf8().toBase64() + "\r\n";
+    }
+    if (version2) {
+        request += "Connection: close\r\n";
+    }
+    request += "\r\n";
+
+    return request;
+}
+
+QByteArray NTRIPClient::makeGGA(const QGeoCoordinate &position, const QTime &utcTime)
+{
+    const double latitude = std::abs(position.latitude());
+    const double longitude = std::abs(position.longitude());
+    const int latitudeDegrees = static_cast<int>(latitude);
+    const int longitudeDegrees = static_cast<int>(longitude);
+    const double altitude = std::isnan(position.altitude()) ? 0.0 : position.altitude();
+
+    const QString sentence = QStringLiteral("GPGGA,%1,%2%3,%4,%5%6,%7,1,12,1.0,%8,M,0.0,M,,")
+        .arg(utcTime.toString(QStringLiteral("hhmmss.zzz")).left(9))
+        .arg(latitudeDegrees, 2, 10, QLatin1Char('0'))
+        .arg((latitude - latitudeDegrees) * 60.0, 8, 'f', 5, QLatin1Char('0'))
+        .arg((position.latitude() < 0) ? QLatin1Char('S') : QLatin1Char('N'))
+        .arg(longitudeDegrees, 3, 10, QLatin1Char('0'))
+        .arg((longitude - longitudeDegrees) * 60.0, 8, 'f', 5, QLatin1Char('0'))
+        .arg((position.longitude() < 0) ? QLatin1Char('W') : QLatin1Char('E'))
+        .arg(altitude, 0, 'f', 1);
+
+    quint8 checksum = 0;
+    const QByteArray bytes = sentence.toLatin1();
+    for (const char byte : bytes) {
+        checksum ^= static_cast<quint8>(byte);
+    }
+
+    return "$" + bytes + "*" + QByteArray::number(checksum, 16).toUpper().rightJustified(2, '0') + "\r\n";
+}
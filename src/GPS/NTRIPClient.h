@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "RTCMParser.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+#include <QtPositioning/QGeoCoordinate>
+
+class QTcpSocket;
+class QTime;
+
+Q_DECLARE_LOGGING_CATEGORY(NTRIPClientLog)
+
+/// Receives RTK corrections from an NTRIP caster.
+///
+/// Speaks NTRIP 1.0 and 2.0, including chunked transfer encoding, and hands the RTCM3 frames of the stream to
+/// RTCMDataUpdate, the same signal GPSProvider uses for a local base station. The position of the ground station
+/// is sent to the caster as GGA, which network RTK (VRS) mountpoints need to compute their corrections. A lost
+/// connection is retried with exponential backoff.
+class NTRIPClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        QString     host;
+        quint16     port            = 2101;
+        QString     mountpoint;
+        QString     username;
+        QString     password;
+        int         version         = 2;        ///< NTRIP protocol version, 1 or 2
+        QSet<int>   messageFilter;              ///< RTCM message types to forward, all if empty
+        int         ggaInterval     = kDefaultGgaInterval; ///< msecs, 0 to not send GGA
+    };
+
+    enum class State {
+        Disconnected,
+        Connecting,
+        WaitingForResponse,
+        Streaming,
+        WaitingToReconnect
+    };
+    Q_ENUM(State)
+
+    explicit NTRIPClient(QObject *parent = nullptr);
+    ~NTRIPClient();
+
+    void start(const Config &config);
+    void stop();
+
+    State state() const { return _state; }
+    const RTCMParser &parser() const { return _parser; }
+    qint64 bytesReceived() const { return _bytesReceived; }
+
+    /// Position sent to the caster as GGA
+    void setPosition(const QGeoCoordinate &position);
+
+    /// @return Delay before the next reconnect attempt
+    int reconnectDelay() const { return _reconnectDelay; }
+
+    /// @return HTTP request for the mountpoint
+    static QByteArray makeRequest(const Config &config);
+
+    /// @return NMEA GGA sentence, including checksum and line end
+    static QByteArray makeGGA(const QGeoCoordinate &position, const QTime &utcTime);
+
+    static constexpr int kDefaultGgaInterval    = 10000;
+    static constexpr int kMinReconnectDelay     = 1000;
+    static constexpr int kMaxReconnectDelay     = 30000;
+    static constexpr int kResponseTimeout       = 10000;    ///< Caster must answer the request within this
+    static constexpr int kDataTimeout           = 30000;    ///< Stream is considered dead without data for this long
+    static constexpr int kMaxHeaderLength       = 16384;
+
+signals:
+    /// A complete RTCM3 frame
+    void RTCMDataUpdate(const QByteArray &message);
+    void stateChanged(State state);
+    void errorOccurred(const QString &errorString);
+
+private slots:
+    void _connect();
+    void _onConnected();
+    void _onDisconnected();
+    void _onReadyRead();
+    void _onTimeout();
+    void _sendGGA();
+
+private:
+    void _setState(State state);
+    void _fail(const QString &errorString);
+    bool _parseHeader();
+    void _processBody(QByteArrayView data);
+    void _forward(QByteArrayView data);
+
+    Config _config;
+    State _state = State::Disconnected;
+    QTcpSocket *_socket = nullptr;
+    RTCMParser _parser;
+    QTimer _reconnectTimer;
+    QTimer _timeoutTimer;
+    QTimer _ggaTimer;
+    QGeoCoordinate _position;
+
+    QByteArray _header;
+    bool _chunked = false;
+    QByteArray _chunkBuffer;
+    qint64 _chunkRemaining = -1;    ///< Bytes left in the current chunk, -1 while reading its size
+
+    int _reconnectDelay = kMinReconnectDelay;
+    qint64 _bytesReceived = 0;
+};
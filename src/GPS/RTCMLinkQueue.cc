@@ -0,0 +1,185 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "RTCMLinkQueue.h"
+
+RTCMLinkQueue::RTCMLinkQueue(qint64 bytesPerSecond)
+{
+    setBudget(bytesPerSecond);
+}
+
+void RTCMLinkQueue::setBudget(qint64 bytesPerSecond)
+{
+    _budget = qMax<qint64>(0, bytesPerSecond);
+    _tokens = 0;
+    _lastRefillMs = -1;
+}
+
+int RTCMLinkQueue::messageType(QByteArrayView rtcm)
+{
+    // Preamble, 6 reserved bits and a 10 bit length, then the 12 bit message number
+    if ((rtcm.size() < 5) || (static_cast<quint8>(rtcm[0]) != 0xD3)) {
+        return 0;
+    }
+    return (static_cast<quint8>(rtcm[3]) << 4) | (static_cast<quint8>(rtcm[4]) >> 4);
+}
+
+int RTCMLinkQueue::stationId(QByteArrayView rtcm)
+{
+    // The 12 bit reference station id follows the message number in every station message
+    const int type = messageType(rtcm);
+    if (!isReplaceable(type) || (rtcm.size() < 6)) {
+        return -1;
+    }
+    return ((static_cast<quint8>(rtcm[4]) & 0x0F) << 8) | static_cast<quint8>(rtcm[5]);
+}
+
+bool RTCMLinkQueue::isReplaceable(int messageType)
+{
+    // Sent once per epoch and station: position, antenna and receiver descriptors, GLONASS code-phase biases
+    switch (messageType) {
+    case 1005:
+    case 1006:
+    case 1007:
+    case 1008:
+    case 1033:
+    case 1230:
+        return true;
+    default:
+        return false;
+    }
+}
+
+int RTCMLinkQueue::priority(int messageType)
+{
+    // Observations, legacy and MSM
+    if (((messageType >= 1001) && (messageType <= 1004)) || ((messageType >= 1009) && (messageType <= 1012)) || ((messageType >= 1071) && (messageType <= 1137))) {
+        return 0;
+    }
+
+    // Reference station position and antenna, GLONASS code-phase biases
+    switch (messageType) {
+    case 1005:
+    case 1006:
+    case 1007:
+    case 1008:
+    case 1033:
+    case 1230:
+        return 1;
+    default:
+        break;
+    }
+
+    // Ephemerides and anything else
+    return 2;
+}
+
+void RTCMLinkQueue::enqueue(const QByteArray &rtcm, qint64 cost, qint64 nowMs)
+{
+    Pending pending;
+    pending.data = rtcm;
+    pending.type = messageType(rtcm);
+    pending.stationId = stationId(rtcm);
+    pending.priority = priority(pending.type);
+    pending.cost = cost;
+    pending.queuedMs = nowMs;
+
+    if (isReplaceable(pending.type)) {
+        for (qsizetype i = 0; i < _queue.count(); i++) {
+            if ((_queue[i].type == pending.type) && (_queue[i].stationId == pending.stationId)) {
+                // Superseded before it got out
+                _queue.removeAt(i);
+                _windowDropped++;
+                break;
+            }
+        }
+    }
+
+    _queue.append(pending);
+}
+
+void RTCMLinkQueue::_refill(qint64 nowMs)
+{
+    const double burst = (_budget * kBurstMs) / 1000.0;
+    if (_lastRefillMs < 0) {
+        _tokens = burst;
+    } else {
+        _tokens = qMin(_tokens + ((_budget * (nowMs - _lastRefillMs)) / 1000.0), burst);
+    }
+    _lastRefillMs = nowMs;
+}
+
+void RTCMLinkQueue::_dropStale(qint64 nowMs)
+{
+    _windowDropped += _queue.removeIf([nowMs](const Pending &pending) {
+        return (nowMs - pending.queuedMs) > kMaxAgeMs;
+    });
+}
+
+QList<QByteArray> RTCMLinkQueue::take(qint64 nowMs)
+{
+    QList<QByteArray> messages;
+
+    _dropStale(nowMs);
+    if (_budget > 0) {
+        _refill(nowMs);
+    }
+
+    while (!_queue.isEmpty()) {
+        // Highest priority first, oldest first within a priority
+        qsizetype next = 0;
+        for (qsizetype i = 1; i < _queue.count(); i++) {
+            if (_queue[i].priority < _queue[next].priority) {
+                next = i;
+            }
+        }
+
+        // The bucket may go into debt, so a message bigger than the burst still gets out eventually
+        if ((_budget > 0) && (_tokens <= 0)) {
+            break;
+        }
+
+        const Pending pending = _queue.takeAt(next);
+        if (_budget > 0) {
+            _tokens -= pending.cost;
+        }
+
+        const double latencyMs = nowMs - pending.queuedMs;
+        _windowBytes += pending.cost;
+        _windowSent++;
+        _windowLatency += latencyMs;
+        _windowMaxLatency = qMax(_windowMaxLatency, latencyMs);
+
+        messages.append(pending.data);
+    }
+
+    return messages;
+}
+
+RTCMLinkQueue::WindowStats RTCMLinkQueue::takeWindowStats(qint64 nowMs)
+{
+    WindowStats stats;
+    if (_windowStartMs >= 0) {
+        const qint64 elapsedMs = nowMs - _windowStartMs;
+        stats.bytesPerSecond = (elapsedMs > 0) ? ((_windowBytes * 1000) / elapsedMs) : 0;
+    }
+    stats.messagesSent = _windowSent;
+    stats.messagesDropped = _windowDropped;
+    stats.latencyMs = (_windowSent > 0) ? (_windowLatency / _windowSent) : 0;
+    stats.maxLatencyMs = _windowMaxLatency;
+
+    _windowStartMs = nowMs;
+    _windowBytes = 0;
+    _windowSent = 0;
+    _windowDropped = 0;
+    _windowLatency = 0;
+    _windowMaxLatency = 0;
+
+    return stats;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+
+/// RTCM messages waiting to go out on one link.
+///
+/// Without a budget everything is passed straight through. With one, a token bucket decides what can be sent and
+/// the rest waits. While a station message waits, a newer one of the same type from the same station replaces it,
+/// since a receiver only wants the latest. Observations and ephemerides are never replaced: an MSM epoch spans one
+/// message per constellation with the same type, and every satellite has its own ephemeris message of the same type.
+/// Messages which waited too long are dropped. Observations go out before station information, which goes out
+/// before everything else.
+class RTCMLinkQueue
+{
+public:
+    struct WindowStats {
+        qint64  bytesPerSecond  = 0;    ///< Sent, including MAVLink overhead
+        int     messagesSent    = 0;
+        int     messagesDropped = 0;
+        double  latencyMs       = 0;    ///< Mean time from enqueue to send
+        double  maxLatencyMs    = 0;
+    };
+
+    /// @param bytesPerSecond Budget, 0 for none
+    explicit RTCMLinkQueue(qint64 bytesPerSecond = 0);
+
+    void setBudget(qint64 bytesPerSecond);
+    qint64 budget() const { return _budget; }
+
+    /// @param cost Bytes the message takes on the link
+    void enqueue(const QByteArray &rtcm, qint64 cost, qint64 nowMs);
+
+    /// @return Messages to send now, in order
+    QList<QByteArray> take(qint64 nowMs);
+
+    bool isEmpty() const { return _queue.isEmpty(); }
+    qsizetype pendingCount() const { return _queue.count(); }
+
+    /// Statistics since the previous call
+    WindowStats takeWindowStats(qint64 nowMs);
+
+    /// @return RTCM3 message number, 0 if rtcm is not an RTCM3 frame
+    static int messageType(QByteArrayView rtcm);
+
+    /// @return Reference station id of a station message, -1 for any other message
+    static int stationId(QByteArrayView rtcm);
+
+    /// @return 0 for the highest priority
+    static int priority(int messageType);
+
+    /// @return true if a newer message of this type from the same station makes a waiting one useless
+    static bool isReplaceable(int messageType);
+
+    static constexpr qint64 kMaxAgeMs = 3000;       ///< Corrections older than this are of no use to a receiver
+    static constexpr qint64 kBurstMs = 500;         ///< Budget which can be saved up while the link is idle
+
+private:
+    struct Pending {
+        QByteArray  data;
+        int         type        = 0;
+        int         stationId   = -1;
+        int         priority    = 0;
+        qint64      cost        = 0;
+        qint64      queuedMs    = 0;
+    };
+
+    void _refill(qint64 nowMs);
+    void _dropStale(qint64 nowMs);
+
+    QList<Pending>  _queue;
+    qint64          _budget         = 0;
+    double          _tokens         = 0;
+    qint64          _lastRefillMs   = -1;
+
+    qint64          _windowStartMs  = -1;
+    qint64          _windowBytes    = 0;
+    int             _windowSent     = 0;
+    int             _windowDropped  = 0;
+    double          _windowLatency  = 0;
+    double          _windowMaxLatency = 0;
+};
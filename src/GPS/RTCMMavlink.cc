@@ -11,6 +11,7 @@
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
 #include "QGCLoggingCategory.h"
+#include "SerialLink.h"
 #include "Vehicle.h"
 
 QGC_LOGGING_CATEGORY(RTCMMavlinkLog, "qgc.gps.rtcmmavlink")
@@ -20,7 +21,13 @@ RTCMMavlink::RTCMMavlink(QObject *parent)
 {
     // qCDebug(RTCMMavlinkLog) << Q_FUNC_INFO << this;
 
-    _bandwidthTimer.start();
+    _clock.start();
+
+    _drainTimer.setInterval(kDrainInterval);
+    (void) connect(&_drainTimer, &QTimer::timeout, this, &RTCMMavlink::_drain);
+
+    _statsTimer.setInterval(kStatsInterval);
+    (void) connect(&_statsTimer, &QTimer::timeout, this, &RTCMMavlink::_updateStats);
 }
 
 RTCMMavlink::~RTCMMavlink()
@@ -28,73 +35,215 @@ RTCMMavlink::~RTCMMavlink()
     // qCDebug(RTCMMavlinkLog) << Q_FUNC_INFO << this;
 }
 
-void RTCMMavlink::RTCMDataUpdate(QByteArrayView data)
+qint64 RTCMMavlink::defaultLinkBudget(const LinkInterface *link)
+{
+    const SharedLinkConfigurationPtr config = link->linkConfiguration();
+    const SerialConfiguration *const serialConfig = qobject_cast<const SerialConfiguration*>(config.get());
+    if (serialConfig && (serialConfig->baud() > 0)) {
+        // 10 bits per byte on the wire, and telemetry needs the other half
+        return serialConfig->baud() / 10 / 2;
+    }
+
+    return 0;
+}
+
+void RTCMMavlink::setLinkBudget(LinkInterface *link, qint64 bytesPerSecond)
+{
+    if (bytesPerSecond < 0) {
+        (void) _budgetOverrides.remove(link);
+    } else {
+        if (!_budgetOverrides.contains(link)) {
+            // The override outlives the link's vehicles coming and going, but not the link itself
+            (void) connect(link, &QObject::destroyed, this, [this, link]() {
+                (void) _budgetOverrides.remove(link);
+            });
+        }
+        _budgetOverrides[link] = bytesPerSecond;
+    }
+
+    auto it = _links.find(link);
+    if (it != _links.end()) {
+        it->budgetOverride = _budgetOverrides.contains(link);
+        it->queue.setBudget(it->budgetOverride ? _budgetOverrides[link] : defaultLinkBudget(link));
+    }
+}
+
+void RTCMMavlink::_updateLinks()
+{
+    for (LinkState &state : _links) {
+        state.sender.clear();
+        state.vehicleCount = 0;
+    }
+
+    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
+    for (qsizetype i = 0; i < vehicles->count(); i++) {
+        Vehicle* const vehicle = qobject_cast<Vehicle*>(vehicles->get(i));
+        const SharedLinkInterfacePtr sharedLink = vehicle->vehicleLinkManager()->primaryLink().lock();
+        if (!sharedLink) {
+            continue;
+        }
+
+        auto it = _links.find(sharedLink.get());
+        if ((it != _links.end()) && it->link.expired()) {
+            // A new link which happens to have the address of one which went away
+            (void) _links.erase(it);
+            it = _links.end();
+        }
+        if (it == _links.end()) {
+            LinkState state;
+            state.link = sharedLink;
+            state.budgetOverride = _budgetOverrides.contains(sharedLink.get());
+            state.queue.setBudget(state.budgetOverride ? _budgetOverrides[sharedLink.get()] : defaultLinkBudget(sharedLink.get()));
+            it = _links.insert(sharedLink.get(), state);
+            qCDebug(RTCMMavlinkLog) << "Link added" << sharedLink->linkConfiguration()->name() << "budget" << it->queue.budget();
+        }
+        if (!it->sender) {
+            it->sender = vehicle;
+        }
+        it->vehicleCount++;
+    }
+
+    // Links which no vehicle uses any more are dropped
+    for (auto it = _links.begin(); it != _links.end(); ) {
+        if ((it->vehicleCount == 0) || it->link.expired()) {
+            it = _links.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RTCMMavlink::RTCMDataUpdate(const QByteArray &message)
 {
-#ifdef QT_DEBUG
-    _calculateBandwith(data.size());
-#endif
+    _updateLinks();
+    if (_links.isEmpty()) {
+        return;
+    }
+
+    // What one message takes on a link, with the MAVLink framing of each fragment
+    static constexpr qsizetype maxMessageLength = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
+    const qsizetype fragments = qMax<qsizetype>(1, (message.size() + maxMessageLength - 1) / maxMessageLength);
+    const qint64 cost = message.size() + (fragments * (MAVLINK_NUM_NON_PAYLOAD_BYTES + 2));
+
+    const qint64 now = _clock.elapsed();
+    for (LinkState &state : _links) {
+        state.queue.enqueue(message, cost, now);
+    }
+
+    _drain();
+
+    if (!_statsTimer.isActive()) {
+        _statsTimer.start();
+    }
+}
+
+void RTCMMavlink::_drain()
+{
+    const qint64 now = _clock.elapsed();
+
+    bool pending = false;
+    for (LinkState &state : _links) {
+        const QList<QByteArray> messages = state.queue.take(now);
+        for (const QByteArray &rtcm : messages) {
+            _sendToLink(state, rtcm);
+        }
+        pending |= !state.queue.isEmpty();
+    }
+
+    if (pending && !_drainTimer.isActive()) {
+        _drainTimer.start();
+    } else if (!pending) {
+        _drainTimer.stop();
+    }
+}
+
+void RTCMMavlink::_sendToLink(LinkState &state, const QByteArray &rtcm)
+{
+    const SharedLinkInterfacePtr sharedLink = state.link.lock();
+    if (!sharedLink || !state.sender) {
+        return;
+    }
 
     mavlink_gps_rtcm_data_t gpsRtcmData{};
+    mavlink_message_t message;
+
+    const auto send = [&]() {
+        (void) mavlink_msg_gps_rtcm_data_encode_chan(
+            MAVLinkProtocol::instance()->getSystemId(),
+            MAVLinkProtocol::getComponentId(),
+            sharedLink->mavlinkChannel(),
+            &message,
+            &gpsRtcmData
+        );
+        (void) state.sender->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    };
 
     static constexpr qsizetype maxMessageLength = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
-    if (data.size() < maxMessageLength) {
-        gpsRtcmData.len = data.size();
-        gpsRtcmData.flags = (_sequenceId & 0x1FU) << 3;
-        (void) memcpy(&gpsRtcmData.data, data.data(), data.size());
-        _sendMessageToVehicle(gpsRtcmData);
+    if (rtcm.size() < maxMessageLength) {
+        gpsRtcmData.len = rtcm.size();
+        gpsRtcmData.flags = (state.sequenceId & 0x1FU) << 3;
+        (void) memcpy(&gpsRtcmData.data, rtcm.constData(), rtcm.size());
+        send();
     } else {
         uint8_t fragmentId = 0;
         qsizetype start = 0;
-        while (start < data.size()) {
+        while (start < rtcm.size()) {
             gpsRtcmData.flags = 0x01U; // LSB set indicates message is fragmented
             gpsRtcmData.flags |= fragmentId++ << 1; // Next 2 bits are fragment id
-            gpsRtcmData.flags |= (_sequenceId & 0x1FU) << 3; // Next 5 bits are sequence id
+            gpsRtcmData.flags |= (state.sequenceId & 0x1FU) << 3; // Next 5 bits are sequence id
 
-            const qsizetype length = std::min(data.size() - start, maxMessageLength);
+            const qsizetype length = std::min(rtcm.size() - start, maxMessageLength);
             gpsRtcmData.len = length;
 
-            (void) memcpy(gpsRtcmData.data, data.constData() + start, length);
-            _sendMessageToVehicle(gpsRtcmData);
+            (void) memcpy(gpsRtcmData.data, rtcm.constData() + start, length);
+            send();
 
             start += length;
         }
     }
 
-    ++_sequenceId;
+    ++state.sequenceId;
 }
 
-void RTCMMavlink::_sendMessageToVehicle(const mavlink_gps_rtcm_data_t &data)
+void RTCMMavlink::_updateStats()
 {
-    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
-    for (qsizetype i = 0; i < vehicles->count(); i++) {
-        Vehicle* const vehicle = qobject_cast<Vehicle*>(vehicles->get(i));
-        const SharedLinkInterfacePtr sharedLink = vehicle->vehicleLinkManager()->primaryLink().lock();
-        if (sharedLink) {
-            mavlink_message_t message;
-            (void) mavlink_msg_gps_rtcm_data_encode_chan(
-                MAVLinkProtocol::instance()->getSystemId(),
-                MAVLinkProtocol::getComponentId(),
-                sharedLink->mavlinkChannel(),
-                &message,
-                &data
-            );
-            (void) vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
-        }
+    const qint64 now = _clock.elapsed();
+
+    for (auto it = _links.begin(); it != _links.end(); ++it) {
+        it->window = it->queue.takeWindowStats(now);
+
+        const SharedLinkInterfacePtr sharedLink = it->link.lock();
+        qCDebug(RTCMMavlinkLog) << (sharedLink ? sharedLink->linkConfiguration()->name() : QString())
+                                << "vehicles" << it->vehicleCount
+                                << QStringLiteral("%1 kB/s").arg(it->window.bytesPerSecond / 1024.)
+                                << "sent" << it->window.messagesSent
+                                << "dropped" << it->window.messagesDropped
+                                << QStringLiteral("latency %1/%2 ms").arg(it->window.latencyMs, 0, 'f', 1).arg(it->window.maxLatencyMs, 0, 'f', 1);
+    }
+
+    if (_links.isEmpty()) {
+        _statsTimer.stop();
     }
 }
 
-void RTCMMavlink::_calculateBandwith(qsizetype bytes)
+QList<RTCMMavlink::LinkStats> RTCMMavlink::linkStats() const
 {
-    if (!_bandwidthTimer.isValid()) {
-        return;
-    }
+    QList<LinkStats> stats;
 
-    _bandwidthByteCounter += bytes;
+    for (auto it = _links.cbegin(); it != _links.cend(); ++it) {
+        const SharedLinkInterfacePtr sharedLink = it->link.lock();
+        if (!sharedLink) {
+            continue;
+        }
 
-    const qint64 elapsed = _bandwidthTimer.elapsed();
-    if (elapsed > 1000) {
-        qCDebug(RTCMMavlinkLog) << QStringLiteral("RTCM bandwidth: %1 kB/s").arg(((_bandwidthByteCounter / elapsed) * 1000.f) / 1024.f);
-        (void) _bandwidthTimer.restart();
-        _bandwidthByteCounter = 0;
+        LinkStats linkStats;
+        linkStats.linkName = sharedLink->linkConfiguration()->name();
+        linkStats.vehicleCount = it->vehicleCount;
+        linkStats.budget = it->queue.budget();
+        linkStats.pending = it->queue.pendingCount();
+        linkStats.window = it->window;
+        stats.append(linkStats);
     }
+
+    return stats;
 }
@@ -10,30 +10,79 @@
 
 #pragma once
 
+#include "RTCMLinkQueue.h"
+
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+#include <memory>
 
-typedef struct __mavlink_gps_rtcm_data_t mavlink_gps_rtcm_data_t;
+class LinkInterface;
+class Vehicle;
 
 Q_DECLARE_LOGGING_CATEGORY(RTCMMavlinkLog)
 
+/// Forwards RTCM corrections to all vehicles as GPS_RTCM_DATA.
+///
+/// Vehicles are grouped by their primary link and each link gets one copy, addressed to all vehicles on it. Every
+/// link has its own RTCMLinkQueue, so a slow telemetry radio only delays the corrections of the vehicles behind it.
 class RTCMMavlink : public QObject
 {
     Q_OBJECT
 
 public:
+    struct LinkStats {
+        QString     linkName;
+        int         vehicleCount    = 0;
+        qint64      budget          = 0;    ///< Bytes per second, 0 for none
+        qsizetype   pending         = 0;    ///< Messages waiting to be sent
+        RTCMLinkQueue::WindowStats window;  ///< Last completed statistics window
+    };
+
     RTCMMavlink(QObject *parent = nullptr);
     ~RTCMMavlink();
 
+    /// Overrides the default budget of a link
+    ///     @param bytesPerSecond 0 for none, -1 to go back to the default
+    void setLinkBudget(LinkInterface *link, qint64 bytesPerSecond);
+
+    QList<LinkStats> linkStats() const;
+
+    /// @return Default budget for a link: half of a serial link's bandwidth, none for anything else
+    static qint64 defaultLinkBudget(const LinkInterface *link);
+
+    static constexpr int kDrainInterval = 20;
+    static constexpr int kStatsInterval = 1000;
+
 public slots:
-    void RTCMDataUpdate(QByteArrayView data);
+    /// One RTCM message. It is queued without copying, all links share it.
+    void RTCMDataUpdate(const QByteArray &message);
+
+private slots:
+    void _drain();
+    void _updateStats();
 
 private:
-    void _calculateBandwith(qsizetype bytes);
-    static void _sendMessageToVehicle(const mavlink_gps_rtcm_data_t &data);
+    struct LinkState {
+        std::weak_ptr<LinkInterface> link;
+        QPointer<Vehicle>   sender;             ///< Any vehicle on the link, the message goes to all of them
+        int                 vehicleCount    = 0;
+        bool                budgetOverride  = false;
+        uint8_t             sequenceId      = 0;
+        RTCMLinkQueue       queue;
+        RTCMLinkQueue::WindowStats window;
+    };
+
+    void _updateLinks();
+    void _sendToLink(LinkState &state, const QByteArray &rtcm);
 
-    uint8_t _sequenceId = 0;
-    qsizetype _bandwidthByteCounter = 0;
-    QElapsedTimer _bandwidthTimer;
+    QHash<LinkInterface*, LinkState> _links;
+    QHash<LinkInterface*, qint64> _budgetOverrides;
+    QTimer _drainTimer;
+    QTimer _statsTimer;
+    QElapsedTimer _clock;
 };
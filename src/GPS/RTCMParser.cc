@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "RTCMParser.h"
+#include "RTCMLinkQueue.h"
+
+#include <array>
+
+namespace {
+
+constexpr std::array<quint32, 256> makeCrc24qTable()
+{
+    constexpr quint32 polynomial = 0x1864CFB;
+
+    std::array<quint32, 256> table{};
+    for (quint32 i = 0; i < 256; i++) {
+        quint32 crc = i << 16;
+        for (int bit = 0; bit < 8; bit++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= polynomial;
+            }
+        }
+        table[i] = crc & 0xFFFFFF;
+    }
+    return table;
+}
+
+constexpr std::array<quint32, 256> kCrc24qTable = makeCrc24qTable();
+
+}
+
+quint32 RTCMParser::crc24q(QByteArrayView data)
+{
+    quint32 crc = 0;
+    for (const char byte : data) {
+        crc = ((crc << 8) & 0xFFFFFF) ^ kCrc24qTable[((crc >> 16) ^ static_cast<quint8>(byte)) & 0xFF];
+    }
+    return crc;
+}
+
+void RTCMParser::reset()
+{
+    _buffer.clear();
+}
+
+QList<QByteArray> RTCMParser::addData(QByteArrayView data)
+{
+    QList<QByteArray> frames;
+
+    _buffer.append(data);
+
+    qsizetype pos = 0;
+    while (pos < _buffer.size()) {
+        const qsizetype preamble = _buffer.indexOf(static_cast<char>(kPreamble), pos);
+        if (preamble < 0) {
+            _bytesDiscarded += _buffer.size() - pos;
+            pos = _buffer.size();
+            break;
+        }
+        _bytesDiscarded += preamble - pos;
+        pos = preamble;
+
+        if ((_buffer.size() - pos) < kHeaderLength) {
+            break;
+        }
+
+        const quint8 *const header = reinterpret_cast<const quint8*>(_buffer.constData() + pos);
+        if (header[1] & 0xFC) {
+            // Reserved bits are always zero, this is not a frame
+            _bytesDiscarded++;
+            pos++;
+            continue;
+        }
+
+        const qsizetype payloadLength = ((header[1] & 0x03) << 8) | header[2];
+        const qsizetype frameLength = kHeaderLength + payloadLength + kCrcLength;
+        if ((_buffer.size() - pos) < frameLength) {
+            break;
+        }
+
+        const QByteArrayView frame(_buffer.constData() + pos, frameLength);
+        const quint8 *const crcBytes = reinterpret_cast<const quint8*>(frame.constData() + kHeaderLength + payloadLength);
+        const quint32 crc = (crcBytes[0] << 16) | (crcBytes[1] << 8) | crcBytes[2];
+        if (crc24q(frame.first(kHeaderLength + payloadLength)) != crc) {
+            _crcErrors++;
+            _bytesDiscarded++;
+            pos++;
+            continue;
+        }
+
+        _framesParsed++;
+        if (_messageFilter.isEmpty() || _messageFilter.contains(RTCMLinkQueue::messageType(frame))) {
+            frames.append(frame.toByteArray());
+        } else {
+            _framesFiltered++;
+        }
+        pos += frameLength;
+    }
+
+    (void) _buffer.remove(0, pos);
+
+    return frames;
+}
@@ -0,0 +1,55 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+
+/// Splits a byte stream into RTCM3 frames.
+///
+/// Data can arrive in any pieces. Frames whose CRC-24Q does not match are thrown away and the search for the next
+/// preamble starts one byte later, so the parser finds its way back into the stream after garbage.
+class RTCMParser
+{
+public:
+    /// Appends data to the stream
+    ///     @return Complete frames with a valid CRC which pass the filter
+    QList<QByteArray> addData(QByteArrayView data);
+
+    void reset();
+
+    /// Only frames of these message types are returned, all of them if empty
+    void setMessageFilter(const QSet<int> &messageTypes) { _messageFilter = messageTypes; }
+    QSet<int> messageFilter() const { return _messageFilter; }
+
+    int framesParsed() const { return _framesParsed; }      ///< Valid frames, including filtered ones
+    int framesFiltered() const { return _framesFiltered; }
+    int crcErrors() const { return _crcErrors; }
+    qint64 bytesDiscarded() const { return _bytesDiscarded; }    ///< Bytes skipped while looking for a frame
+
+    /// CRC-24Q as used by RTCM3, over the header and payload
+    static quint32 crc24q(QByteArrayView data);
+
+    static constexpr int kHeaderLength = 3;
+    static constexpr int kCrcLength = 3;
+    static constexpr int kMaxPayloadLength = 1023;
+    static constexpr quint8 kPreamble = 0xD3;
+
+private:
+    QByteArray _buffer;
+    QSet<int> _messageFilter;
+
+    int _framesParsed = 0;
+    int _framesFiltered = 0;
+    int _crcErrors = 0;
+    qint64 _bytesDiscarded = 0;
+};
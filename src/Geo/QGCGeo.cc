@@ -25,6 +25,75 @@ QGC_LOGGING_CATEGORY(QGCGeoLog, "qgc.geo.qgcgeo")
 
 static constexpr double epsilon = std::numeric_limits<double>::epsilon();
 
+namespace {
+
+/// Origin dependent terms of the tangent plane projection, computed once per batch
+struct TangentPlane
+{
+    explicit TangentPlane(const QGeoCoordinate &origin)
+        : ref_lat_rad(qDegreesToRadians(origin.latitude()))
+        , ref_lon_rad(qDegreesToRadians(origin.longitude()))
+        , ref_sin_lat(sin(ref_lat_rad))
+        , ref_cos_lat(cos(ref_lat_rad))
+        , ref_alt(origin.altitude())
+    {}
+
+    const double ref_lat_rad;
+    const double ref_lon_rad;
+    const double ref_sin_lat;
+    const double ref_cos_lat;
+    const double ref_alt;
+};
+
+// The loops below only save the per point origin trigonometry. They call the scalar libm sin, cos and atan2 for
+// every point, which keeps the compiler from vectorizing them.
+
+void geoToNedKernel(const TangentPlane &plane, const double *lat, const double *lon, qsizetype count, double *x, double *y)
+{
+    const double a = GeographicLib::Constants::WGS84_a();
+
+    for (qsizetype i = 0; i < count; i++) {
+        const double lat_rad = qDegreesToRadians(lat[i]);
+        const double d_lon = qDegreesToRadians(lon[i]) - plane.ref_lon_rad;
+
+        const double sin_lat = sin(lat_rad);
+        const double cos_lat = cos(lat_rad);
+        const double cos_d_lon = cos(d_lon);
+
+        // Clamp protects acos from rounding just past 1.0 for points on top of the origin
+        const double cos_c = qBound(-1.0, plane.ref_sin_lat * sin_lat + plane.ref_cos_lat * cos_lat * cos_d_lon, 1.0);
+        const double c = acos(cos_c);
+        const double k = (c < epsilon) ? 1.0 : (c / sin(c));
+
+        x[i] = k * (plane.ref_cos_lat * sin_lat - plane.ref_sin_lat * cos_lat * cos_d_lon) * a;
+        y[i] = k * cos_lat * sin(d_lon) * a;
+    }
+}
+
+void nedToGeoKernel(const TangentPlane &plane, const double *x, const double *y, qsizetype count, double *lat, double *lon)
+{
+    const double a = GeographicLib::Constants::WGS84_a();
+
+    for (qsizetype i = 0; i < count; i++) {
+        const double x_rad = x[i] / a;
+        const double y_rad = y[i] / a;
+        const double c = sqrt(x_rad * x_rad + y_rad * y_rad);
+        const double sin_c = sin(c);
+        const double cos_c = cos(c);
+
+        const bool atOrigin = c <= epsilon;
+        const double safe_c = atOrigin ? 1.0 : c;
+
+        const double lat_rad = asin(cos_c * plane.ref_sin_lat + (x_rad * sin_c * plane.ref_cos_lat) / safe_c);
+        const double lon_rad = plane.ref_lon_rad + atan2(y_rad * sin_c, safe_c * plane.ref_cos_lat * cos_c - x_rad * plane.ref_sin_lat * sin_c);
+
+        lat[i] = qRadiansToDegrees(atOrigin ? plane.ref_lat_rad : lat_rad);
+        lon[i] = qRadiansToDegrees(atOrigin ? plane.ref_lon_rad : lon_rad);
+    }
+}
+
+} // namespace
+
 namespace QGCGeo {
 
 void convertGeoToNed(const QGeoCoordinate &coord, const QGeoCoordinate &origin, double &x, double &y, double &z)
@@ -35,55 +104,100 @@ void convertGeoToNed(const QGeoCoordinate &coord, const QGeoCoordinate &origin,
         return;
     }
 
-    const double lat_rad = qDegreesToRadians(coord.latitude());
-    const double lon_rad = qDegreesToRadians(coord.longitude());
+    const double lat = coord.latitude();
+    const double lon = coord.longitude();
+    geoToNedKernel(TangentPlane(origin), &lat, &lon, 1, &x, &y);
+    z = -(coord.altitude() - origin.altitude());
+}
 
-    const double ref_lon_rad = qDegreesToRadians(origin.longitude());
-    const double ref_lat_rad = qDegreesToRadians(origin.latitude());
+void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin, QGeoCoordinate &coord)
+{
+    double lat;
+    double lon;
+    nedToGeoKernel(TangentPlane(origin), &x, &y, 1, &lat, &lon);
 
-    const double sin_lat = sin(lat_rad);
-    const double cos_lat = cos(lat_rad);
-    const double cos_d_lon = cos(lon_rad - ref_lon_rad);
+    coord.setLatitude(lat);
+    coord.setLongitude(lon);
+    coord.setAltitude(-z + origin.altitude());
+}
 
-    const double ref_sin_lat = sin(ref_lat_rad);
-    const double ref_cos_lat = cos(ref_lat_rad);
+void convertGeoToNed(const double *lat, const double *lon, const double *alt, qsizetype count, const QGeoCoordinate &origin, double *x, double *y, double *z)
+{
+    const TangentPlane plane(origin);
 
-    const double c = acos(ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon);
-    const double k = (fabs(c) < epsilon) ? 1.0 : (c / sin(c));
+    geoToNedKernel(plane, lat, lon, count, x, y);
 
-    x = k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * GeographicLib::Constants::WGS84_a();
-    y = k * cos_lat * sin(lon_rad - ref_lon_rad) * GeographicLib::Constants::WGS84_a();
-    z = -(coord.altitude() - origin.altitude());
+    if (z) {
+        for (qsizetype i = 0; i < count; i++) {
+            z[i] = alt ? -(alt[i] - plane.ref_alt) : 0.0;
+        }
+    }
 }
 
-void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin, QGeoCoordinate &coord)
+void convertNedToGeo(const double *x, const double *y, const double *z, qsizetype count, const QGeoCoordinate &origin, double *lat, double *lon, double *alt)
 {
-    const double x_rad = x / GeographicLib::Constants::WGS84_a();
-    const double y_rad = y / GeographicLib::Constants::WGS84_a();
-    const double c = sqrt(x_rad * x_rad + y_rad * y_rad);
-    const double sin_c = sin(c);
-    const double cos_c = cos(c);
-
-    const double ref_lon_rad = qDegreesToRadians(origin.longitude());
-    const double ref_lat_rad = qDegreesToRadians(origin.latitude());
-
-    const double ref_sin_lat = sin(ref_lat_rad);
-    const double ref_cos_lat = cos(ref_lat_rad);
-
-    double lat_rad;
-    double lon_rad;
-
-    if (fabs(c) > epsilon) {
-        lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
-        lon_rad = (ref_lon_rad + atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c));
-    } else {
-        lat_rad = ref_lat_rad;
-        lon_rad = ref_lon_rad;
+    const TangentPlane plane(origin);
+
+    nedToGeoKernel(plane, x, y, count, lat, lon);
+
+    if (alt) {
+        for (qsizetype i = 0; i < count; i++) {
+            alt[i] = (z ? -z[i] : 0.0) + plane.ref_alt;
+        }
     }
+}
 
-    coord.setLatitude(qRadiansToDegrees(lat_rad));
-    coord.setLongitude(qRadiansToDegrees(lon_rad));
-    coord.setAltitude(-z + origin.altitude());
+QList<QPointF> convertGeoToNed(const QList<QGeoCoordinate> &coords, const QGeoCoordinate &origin)
+{
+    const qsizetype count = coords.count();
+
+    // Single allocation for all four structure-of-arrays buffers
+    QList<double> buffer(count * 4);
+    double *const lat = buffer.data();
+    double *const lon = lat + count;
+    double *const north = lon + count;
+    double *const east = north + count;
+
+    for (qsizetype i = 0; i < count; i++) {
+        lat[i] = coords[i].latitude();
+        lon[i] = coords[i].longitude();
+    }
+
+    convertGeoToNed(lat, lon, nullptr, count, origin, north, east, nullptr);
+
+    QList<QPointF> points;
+    points.reserve(count);
+    for (qsizetype i = 0; i < count; i++) {
+        points.append(QPointF(east[i], north[i]));
+    }
+
+    return points;
+}
+
+QList<QGeoCoordinate> convertNedToGeo(const QList<QPointF> &points, const QGeoCoordinate &origin)
+{
+    const qsizetype count = points.count();
+
+    QList<double> buffer(count * 4);
+    double *const north = buffer.data();
+    double *const east = north + count;
+    double *const lat = east + count;
+    double *const lon = lat + count;
+
+    for (qsizetype i = 0; i < count; i++) {
+        north[i] = points[i].y();
+        east[i] = points[i].x();
+    }
+
+    convertNedToGeo(north, east, nullptr, count, origin, lat, lon, nullptr);
+
+    QList<QGeoCoordinate> coords;
+    coords.reserve(count);
+    for (qsizetype i = 0; i < count; i++) {
+        coords.append(QGeoCoordinate(lat[i], lon[i], origin.altitude()));
+    }
+
+    return coords;
 }
 
 int convertGeoToUTM(const QGeoCoordinate& coord, double &easting, double &northing)
@@ -99,6 +213,25 @@ int convertGeoToUTM(const QGeoCoordinate& coord, double &easting, double &northi
     }
 }
 
+qsizetype convertGeoToUTM(const double *lat, const double *lon, qsizetype count, double *easting, double *northing, int *zone)
+{
+    qsizetype failures = 0;
+
+    for (qsizetype i = 0; i < count; i++) {
+        try {
+            bool northp;
+            GeographicLib::UTMUPS::Forward(lat[i], lon[i], zone[i], northp, easting[i], northing[i]);
+        } catch(const GeographicLib::GeographicErr& e) {
+            qCDebug(QGCGeoLog) << Q_FUNC_INFO << e.what();
+            zone[i] = 0;
+            easting[i] = northing[i] = std::numeric_limits<double>::quiet_NaN();
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
 bool convertUTMToGeo(double easting, double northing, int zone, bool southhemi, QGeoCoordinate &coord)
 {
     double lat, lon;
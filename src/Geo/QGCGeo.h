@@ -18,7 +18,9 @@
 #pragma once
 
 #include <QtPositioning/QGeoCoordinate>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QPointF>
 
 Q_DECLARE_LOGGING_CATEGORY(QGCGeoLog)
 
@@ -45,6 +47,47 @@ void convertGeoToNed(const QGeoCoordinate &coord, const QGeoCoordinate &origin,
  */
 void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin, QGeoCoordinate &coord);
 
+/**
+ * @brief Batched convertGeoToNed over structure-of-arrays buffers.
+ * Trigonometry for the origin is computed once instead of per point. Each point still calls the scalar sin, cos and
+ * atan2, so the loop does not vectorize. Results are identical to calling convertGeoToNed once per point.
+ * @param[in] lat Latitudes in degrees, count elements.
+ * @param[in] lon Longitudes in degrees, count elements.
+ * @param[in] alt Altitudes in meters, count elements. May be nullptr in which case the origin altitude is used.
+ * @param[in] count Number of points.
+ * @param[in] origin Geoedetic origin for LTP projection.
+ * @param[out] x North components, count elements.
+ * @param[out] y East components, count elements.
+ * @param[out] z Down components, count elements. May be nullptr if not needed.
+ */
+void convertGeoToNed(const double *lat, const double *lon, const double *alt, qsizetype count, const QGeoCoordinate &origin, double *x, double *y, double *z);
+
+/**
+ * @brief Batched convertNedToGeo over structure-of-arrays buffers.
+ * @param[in] x North components in meters, count elements.
+ * @param[in] y East components in meters, count elements.
+ * @param[in] z Down components in meters, count elements. May be nullptr in which case 0 is used.
+ * @param[in] count Number of points.
+ * @param[in] origin Geoedetic origin for LTP.
+ * @param[out] lat Latitudes in degrees, count elements.
+ * @param[out] lon Longitudes in degrees, count elements.
+ * @param[out] alt Altitudes in meters, count elements. May be nullptr if not needed.
+ */
+void convertNedToGeo(const double *x, const double *y, const double *z, qsizetype count, const QGeoCoordinate &origin, double *lat, double *lon, double *alt);
+
+/**
+ * @brief Projects a list of coordinates onto the local tangent plane in a single batch.
+ * This is the form used by the polygon and transect code: the returned points have x East and y North.
+ * Altitude is ignored.
+ */
+QList<QPointF> convertGeoToNed(const QList<QGeoCoordinate> &coords, const QGeoCoordinate &origin);
+
+/**
+ * @brief Inverse of the list form of convertGeoToNed: points have x East and y North. Returned coordinates
+ * take the altitude of the origin, as convertNedToGeo does for a zero down component.
+ */
+QList<QGeoCoordinate> convertNedToGeo(const QList<QPointF> &points, const QGeoCoordinate &origin);
+
 // LatLonToUTMXY
 // Converts a latitude/longitude pair to x and y coordinates in the
 // Universal Transverse Mercator projection.
@@ -65,6 +108,19 @@ void convertNedToGeo(double x, double y, double z, const QGeoCoordinate &origin,
 //   If conversion failed the function returns 0
 int convertGeoToUTM(const QGeoCoordinate& coord, double &easting, double &northing);
 
+// Batched convertGeoToUTM over structure-of-arrays buffers.
+//
+// Inputs:
+//   lat, lon - Latitudes and longitudes in degrees, count elements each.
+//
+// Outputs:
+//   easting, northing - UTM coordinates in meters, count elements each.
+//   zone - UTM zone per point, 0 if conversion of that point failed.
+//
+// Returns:
+//   The number of points which failed to convert
+qsizetype convertGeoToUTM(const double *lat, const double *lon, qsizetype count, double *easting, double *northing, int *zone);
+
 // UTMXYToLatLon
 //
 // Converts x and y coordinates in the Universal Transverse Mercator//   The UTM zone parameter should be in the range [1,60].
@@ -14,6 +14,7 @@
 
 #include "QGCMAVLink.h"
 #include "CustomActionManager.h"
+#include "JoystickSendStats.h"
 #include "QmlObjectListModel.h"
 
 #include <QtCore/QObject>
@@ -22,6 +23,8 @@
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <chrono>
+
 // JoystickLog Category declaration moved to QGCLoggingCategory.cc to allow access in Vehicle
 Q_DECLARE_LOGGING_CATEGORY(JoystickValuesLog)
 Q_DECLARE_METATYPE(GRIPPER_ACTIONS)
@@ -122,6 +125,12 @@ public:
     Q_PROPERTY(bool     accumulator             READ accumulator            WRITE setAccumulator        NOTIFY accumulatorChanged)
     Q_PROPERTY(bool     circleCorrection        READ circleCorrection       WRITE setCircleCorrection   NOTIFY circleCorrectionChanged)
 
+    //-- MANUAL_CONTROL timing over the last few seconds, updated once a second while polling
+    Q_PROPERTY(float    sendRateHz              READ sendRateHz             NOTIFY sendStatsChanged)
+    Q_PROPERTY(float    sendJitterMs            READ sendJitterMs           NOTIFY sendStatsChanged)
+    Q_PROPERTY(float    sendMaxJitterMs         READ sendMaxJitterMs        NOTIFY sendStatsChanged)
+    Q_PROPERTY(float    sendLatencyMs           READ sendLatencyMs          NOTIFY sendStatsChanged)
+
     Q_INVOKABLE void    setButtonRepeat     (int button, bool repeat);
     Q_INVOKABLE bool    getButtonRepeat     (int button);
     Q_INVOKABLE void    setButtonAction     (int button, const QString& action);
@@ -192,6 +201,14 @@ public:
     /// Set joystick button repeat rate (in Hz)
     void  setButtonFrequency(float val);
 
+    float sendRateHz        () const { return static_cast<float>(_publishedSendStats.rateHz); }
+    float sendJitterMs      () const { return static_cast<float>(_publishedSendStats.jitterMs); }
+    float sendMaxJitterMs   () const { return static_cast<float>(_publishedSendStats.maxJitterMs); }
+    float sendLatencyMs     () const { return static_cast<float>(_publishedSendStats.latencyMs); }
+
+    /// Current send statistics, thread safe
+    JoystickSendStats::Snapshot sendStats() const { return _sendStats.snapshot(); }
+
 signals:
     // The raw signals are only meant for use by calibration
     void rawAxisValueChanged        (int index, int value);
@@ -208,6 +225,7 @@ signals:
     void axisValues                 (float roll, float pitch, float yaw, float throttle);
 
     void axisFrequencyHzChanged     ();
+    void sendStatsChanged           ();
     void buttonFrequencyHzChanged   ();
     void startContinuousZoom        (int direction);
     void stopContinuousZoom         ();
@@ -242,7 +260,7 @@ protected:
     int     _findAssignableButtonAction(const QString& action);
     bool    _validAxis              (int axis) const;
     bool    _validButton            (int button) const;
-    void    _handleAxis             ();
+    void    _handleAxis             (std::chrono::steady_clock::time_point sampleTime);
     void    _handleButtons          ();
     void    _buildActionList        (Vehicle* activeVehicle);
 
@@ -301,7 +319,9 @@ protected:
 
     static int          _transmitterMode;
     int                 _rgFunctionAxis[maxFunction] = {};
-    QElapsedTimer       _axisTime;
+
+    JoystickSendStats           _sendStats;
+    JoystickSendStats::Snapshot _publishedSendStats;    ///< GUI thread copy behind the send properties
 
     QmlObjectListModel              _assignableButtonActions;
     QList<AssignedButtonAction*>    _buttonActionArray;
@@ -314,6 +334,9 @@ protected:
     static constexpr const float _minButtonFrequencyHz     = 0.25f;
     static constexpr const float _maxButtonFrequencyHz     = 50.0f;
 
+    static constexpr std::chrono::milliseconds _buttonPollInterval{5};
+    static constexpr std::chrono::milliseconds _sendStatsInterval{1000};
+
 private:
     const char* _txModeSettingsKey = nullptr;
 
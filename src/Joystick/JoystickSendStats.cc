@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "JoystickSendStats.h"
+
+#include <cmath>
+
+JoystickSendStats::JoystickSendStats(int windowSize)
+    : _sendNs(static_cast<size_t>(qMax(2, windowSize)), 0)
+    , _latencyNs(static_cast<size_t>(qMax(2, windowSize)), 0)
+{
+}
+
+void JoystickSendStats::reset(double targetPeriodMs)
+{
+    QMutexLocker locker(&_mutex);
+    _next = 0;
+    _count = 0;
+    _targetPeriodMs = targetPeriodMs;
+}
+
+void JoystickSendStats::record(qint64 sendNs, qint64 latencyNs)
+{
+    QMutexLocker locker(&_mutex);
+    const int size = static_cast<int>(_sendNs.size());
+    _sendNs[_next] = sendNs;
+    _latencyNs[_next] = latencyNs;
+    _next = (_next + 1) % size;
+    _count = qMin(_count + 1, size);
+}
+
+JoystickSendStats::Snapshot JoystickSendStats::snapshot() const
+{
+    QMutexLocker locker(&_mutex);
+
+    Snapshot stats;
+    stats.sendCount = _count;
+    if (_count == 0) {
+        return stats;
+    }
+
+    const int size = static_cast<int>(_sendNs.size());
+    const int first = (_next - _count + size) % size;
+
+    double latencySum = 0;
+    for (int i = 0; i < _count; i++) {
+        const double latencyMs = _latencyNs[(first + i) % size] / 1e6;
+        latencySum += latencyMs;
+        stats.maxLatencyMs = qMax(stats.maxLatencyMs, latencyMs);
+    }
+    stats.latencyMs = latencySum / _count;
+
+    if (_count < 2) {
+        return stats;
+    }
+
+    // Welford's running variance
+    double mean = 0;
+    double m2 = 0;
+    int intervals = 0;
+    qint64 previous = _sendNs[first];
+    for (int i = 1; i < _count; i++) {
+        const qint64 current = _sendNs[(first + i) % size];
+        const double intervalMs = (current - previous) / 1e6;
+        previous = current;
+
+        intervals++;
+        const double delta = intervalMs - mean;
+        mean += delta / intervals;
+        m2 += delta * (intervalMs - mean);
+
+        if (_targetPeriodMs > 0) {
+            stats.maxJitterMs = qMax(stats.maxJitterMs, std::fabs(intervalMs - _targetPeriodMs));
+        }
+    }
+
+    stats.meanIntervalMs = mean;
+    stats.jitterMs = std::sqrt(m2 / intervals);
+    stats.rateHz = (mean > 0) ? (1000.0 / mean) : 0;
+    return stats;
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QMutex>
+
+#include <vector>
+
+/// Timing of the MANUAL_CONTROL messages sent for a joystick.
+///
+/// Keeps the send times and input latencies of the last windowSize messages in a preallocated ring. The joystick
+/// thread records, the GUI takes snapshots, so both are locked.
+class JoystickSendStats
+{
+public:
+    struct Snapshot {
+        int     sendCount       = 0;    ///< Messages in the window
+        double  rateHz          = 0;
+        double  meanIntervalMs  = 0;
+        double  jitterMs        = 0;    ///< Standard deviation of the interval between sends
+        double  maxJitterMs     = 0;    ///< Largest deviation of an interval from the target period
+        double  latencyMs       = 0;    ///< Mean time from reading the input to handing the message to the link
+        double  maxLatencyMs    = 0;
+    };
+
+    explicit JoystickSendStats(int windowSize = kDefaultWindowSize);
+
+    /// Drops all samples
+    ///     @param targetPeriodMs Send period the joystick is aiming for, maxJitterMs is relative to it
+    void reset(double targetPeriodMs);
+
+    /// @param sendNs Monotonic time the message was sent
+    /// @param latencyNs Time since the input was read
+    void record(qint64 sendNs, qint64 latencyNs);
+
+    Snapshot snapshot() const;
+
+    static constexpr int kDefaultWindowSize = 400;  ///< Two seconds at the highest axis rate
+
+private:
+    mutable QMutex          _mutex;
+    std::vector<qint64>     _sendNs;
+    std::vector<qint64>     _latencyNs;
+    int                     _next           = 0;
+    int                     _count          = 0;
+    double                  _targetPeriodMs = 0;
+};
@@ -36,6 +36,17 @@ const ComplexMissionItem& ComplexMissionItem::operator=(const ComplexMissionItem
     return *this;
 }
 
+void ComplexMissionItem::setAsyncRebuild(bool asyncRebuild)
+{
+    if (asyncRebuild != _asyncRebuild) {
+        _asyncRebuild = asyncRebuild;
+        if (!_asyncRebuild) {
+            waitForRebuild();
+        }
+        emit asyncRebuildChanged(_asyncRebuild);
+    }
+}
+
 QStringList ComplexMissionItem::presetNames(void)
 {
     QStringList names;
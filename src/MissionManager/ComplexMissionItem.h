@@ -36,6 +36,7 @@ public:
     Q_PROPERTY(bool                 isSingleItem        READ isSingleItem           CONSTANT)
     Q_PROPERTY(QmlObjectListModel*  flightPathSegments  READ flightPathSegments     CONSTANT)
     Q_PROPERTY(bool                 terrainCollision    READ terrainCollision       NOTIFY terrainCollisionChanged)
+    Q_PROPERTY(bool                 asyncRebuild        READ asyncRebuild           WRITE setAsyncRebuild   NOTIFY asyncRebuildChanged) ///< true: Geometry is rebuilt on a background thread
 
     QmlObjectListModel* flightPathSegments  (void) { return &_flightPathSegments; }
 
@@ -93,6 +94,15 @@ public:
 
     bool presetsSupported   (void) { return !presetsSettingsGroup().isEmpty(); }
     bool isIncomplete       (void) const { return _isIncomplete; }
+    bool asyncRebuild       (void) const { return _asyncRebuild; }
+
+    /// Editors turn this on while they are open so that slider and vertex drags do not block the ui while the
+    /// geometry is recalculated. When off (the default) all recalculation is synchronous. Turning it off waits for
+    /// any background rebuild to complete.
+    void setAsyncRebuild(bool asyncRebuild);
+
+    /// Blocks until any background geometry rebuild has completed and its results have been applied
+    virtual void waitForRebuild(void) { }
 
     /// This mission item attribute specifies the type of the complex item.
     static constexpr const char* jsonComplexItemTypeKey = "complexItemType";
@@ -106,6 +116,7 @@ signals:
     void minAMSLAltitudeChanged     (void);
     void maxAMSLAltitudeChanged     (void);
     void terrainCollisionChanged    (bool terrainCollision);
+    void asyncRebuildChanged        (bool asyncRebuild);
 
 protected slots:
     virtual void _segmentTerrainCollisionChanged (bool terrainCollision);
@@ -116,6 +127,7 @@ protected:
     void        _appendFlightPathSegment(FlightPathSegment::SegmentType segmentType, const QGeoCoordinate& coord1, double coord1AMSLAlt, const QGeoCoordinate& coord2, double coord2AMSLAlt);
 
     bool                _isIncomplete =                 true;
+    bool                _asyncRebuild =                 false;
     int                 _cTerrainCollisionSegments =    0;
     QmlObjectListModel  _flightPathSegments;                // Contains FlightPathSegment items
 
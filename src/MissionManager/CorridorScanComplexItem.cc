@@ -15,8 +15,11 @@
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QJsonArray>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(CorridorScanComplexItemLog, "CorridorScanComplexItemLog")
 
 const QString CorridorScanComplexItem::name(CorridorScanComplexItem::tr("Corridor Scan"));
@@ -26,6 +29,7 @@ CorridorScanComplexItem::CorridorScanComplexItem(PlanMasterController* masterCon
     , _entryPoint               (0)
     , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json"), this))
     , _corridorWidthFact        (settingsGroup, _metaDataMap[corridorWidthName])
+    , _transectRunner           ([this](const TransectResult& result) { _transectsBuilt(result); })
 {
     _editorQml = "qrc:/qml/CorridorScanEditor.qml";
 
@@ -46,14 +50,22 @@ CorridorScanComplexItem::CorridorScanComplexItem(PlanMasterController* masterCon
     connect(&_corridorPolyline,     &QGCMapPolyline::traceModeChanged,              this, &CorridorScanComplexItem::_updateWizardMode);
 
     if (!kmlFile.isEmpty()) {
-        _corridorPolyline.loadKMLFile(kmlFile);
-        _corridorPolyline.setDirty(false);
+        // Parsed on a worker thread, the item starts out clean once the polyline arrives
+        (void) connect(&_corridorPolyline, &QGCMapPolyline::loadKMLFileComplete, this, [this]() {
+            _corridorPolyline.clearLoadedPolylines();
+            _corridorPolyline.setDirty(false);
+            setDirty(false);
+        }, Qt::SingleShotConnection);
+        _corridorPolyline.loadKMLFileAsync(kmlFile);
     }
     setDirty(false);
 }
 
 void CorridorScanComplexItem::save(QJsonArray&  planItems)
 {
+    // Save what the user sees, not the geometry from before the last edit
+    waitForRebuild();
+
     QJsonObject saveObject;
 
     _saveCommon(saveObject);
@@ -210,149 +222,165 @@ void CorridorScanComplexItem::_rebuildCorridorPolygon(void)
     _surveyAreaPolygon.appendVertices(rgCoord);
 }
 
-void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
+void CorridorScanComplexItem::_clearLoadedMissionItems(void)
 {
-    if (_ignoreRecalc) {
-        return;
-    }
-
     // If the transects are getting rebuilt then any previsouly loaded mission items are now invalid
     if (_loadedMissionItemsParent) {
         _loadedMissionItems.clear();
         _loadedMissionItemsParent->deleteLater();
         _loadedMissionItemsParent = nullptr;
     }
+}
 
-    double transectSpacing = _calcTransectSpacing();
-    double fullWidth = _corridorWidthFact.rawValue().toDouble();
-    double halfWidth = fullWidth / 2.0;
-    int transectCount = _calcTransectCount();
-    double normalizedTransectPosition = transectSpacing / 2.0;
-
-    if (_corridorPolyline.count() >= 2) {
-        // First build up the transects all going the same direction
-        //qDebug() << "_rebuildTransectsPhase1";
-        for (int i=0; i<transectCount; i++) {
-            //qDebug() << "start transect";
-            double offsetDistance;
-            if (transectCount == 1) {
-                // Single transect is flown over scan line
-                offsetDistance = 0;
-            } else {
-                // Convert from normalized to absolute transect offset distance
-                offsetDistance = halfWidth - normalizedTransectPosition;
-            }
+CorridorScanComplexItem::TransectParams CorridorScanComplexItem::_transectParams(void) const
+{
+    TransectParams params;
 
-            // Turn transect into CoordInfo transect
-            QList<TransectStyleComplexItem::CoordInfo_t> transect;
-            QList<QGeoCoordinate> transectCoords = _corridorPolyline.offsetPolyline(offsetDistance);
-            for (int j=1; j<transectCoords.count() - 1; j++) {
-                TransectStyleComplexItem::CoordInfo_t coordInfo = { transectCoords[j], CoordTypeInterior };
-                transect.append(coordInfo);
-            }
-            TransectStyleComplexItem::CoordInfo_t coordInfo = { transectCoords.first(), CoordTypeSurveyEntry };
-            transect.prepend(coordInfo);
-            coordInfo = { transectCoords.last(), CoordTypeSurveyExit };
-            transect.append(coordInfo);
-
-            // Extend the transect ends for turnaround
-            if (_hasTurnaround()) {
-                QGeoCoordinate turnaroundCoord;
-                double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
-
-                double azimuth = transectCoords[0].azimuthTo(transectCoords[1]);
-                turnaroundCoord = transectCoords[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
-                turnaroundCoord.setAltitude(qQNaN());
-                TransectStyleComplexItem::CoordInfo_t coordInfo = { turnaroundCoord, CoordTypeTurnaround };
-                transect.prepend(coordInfo);
-
-                azimuth = transectCoords.last().azimuthTo(transectCoords[transectCoords.count() - 2]);
-                turnaroundCoord = transectCoords.last().atDistanceAndAzimuth(-turnAroundDistance, azimuth);
-                turnaroundCoord.setAltitude(qQNaN());
-                coordInfo = { turnaroundCoord, CoordTypeTurnaround };
-                transect.append(coordInfo);
-            }
+    params.polyline             = _corridorPolyline.coordinateList();
+    params.transectSpacing      = _calcTransectSpacing();
+    params.halfWidth            = _corridorWidthFact.rawValue().toDouble() / 2.0;
+    params.transectCount        = _calcTransectCount();
+    params.turnAroundDistance   = _turnAroundDistance();
+    params.entryPoint           = _entryPoint;
 
-#if 0
-            qDebug() << "transect debug";
-            for (const TransectStyleComplexItem::CoordInfo_t& coordInfo: transect) {
-                qDebug() << coordInfo.coordType;
-            }
-#endif
+    return params;
+}
 
-            _transects.append(transect);
-            normalizedTransectPosition += transectSpacing;
+void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
+{
+    if (_ignoreRecalc) {
+        return;
+    }
+
+    _clearLoadedMissionItems();
+
+    // Invalidate any background rebuild which is still in flight
+    _transectGeneration++;
+
+    _transects = _buildTransects(_transectParams());
+}
+
+bool CorridorScanComplexItem::_rebuildTransectsAsync(void)
+{
+    _clearLoadedMissionItems();
+
+    const TransectParams    params      = _transectParams();
+    const quint64           generation  = ++_transectGeneration;
+    _transectRunner.submit([params, generation]() {
+        return TransectResult{ _buildTransects(params), generation };
+    });
+
+    return true;
+}
+
+void CorridorScanComplexItem::_transectsBuilt(const TransectResult& result)
+{
+    if (_ignoreRecalc || result.generation != _transectGeneration) {
+        // Superseded by a synchronous rebuild or a load
+        return;
+    }
+
+    _applyTransects(result.transects);
+}
+
+void CorridorScanComplexItem::waitForRebuild(void)
+{
+    _transectRunner.waitForFinished();
+}
+
+QList<QList<TransectStyleComplexItem::CoordInfo_t>> CorridorScanComplexItem::_buildTransects(const TransectParams& params)
+{
+    QList<QList<CoordInfo_t>> transects;
+
+    if (params.polyline.count() < 2) {
+        return transects;
+    }
+
+    // First build up the transects all going the same direction. Each transect is an independent offset of the
+    // corridor polyline so they are built in parallel.
+    QList<double>   offsetDistances;
+    double          normalizedTransectPosition = params.transectSpacing / 2.0;
+    for (int i=0; i<params.transectCount; i++) {
+        if (params.transectCount == 1) {
+            // Single transect is flown over scan line
+            offsetDistances.append(0);
+        } else {
+            // Convert from normalized to absolute transect offset distance
+            offsetDistances.append(params.halfWidth - normalizedTransectPosition);
         }
+        normalizedTransectPosition += params.transectSpacing;
+    }
 
-        // Now deal with fixing up the entry point:
-        //  0: Leave alone
-        //  1: Start at same end, opposite side of center
-        //  2: Start at opposite end, same side
-        //  3: Start at opposite end, opposite side
-
-        bool reverseTransects = false;
-        bool reverseVertices = false;
-        switch (_entryPoint) {
-        case 0:
-            reverseTransects = false;
-            reverseVertices = false;
-            break;
-        case 1:
-            reverseTransects = true;
-            reverseVertices = false;
-            break;
-        case 2:
-            reverseTransects = false;
-            reverseVertices = true;
-            break;
-        case 3:
-            reverseTransects = true;
-            reverseVertices = true;
-            break;
+    auto buildTransect = [&params](double offsetDistance) {
+        // Turn transect into CoordInfo transect
+        QList<CoordInfo_t> transect;
+        QList<QGeoCoordinate> transectCoords = QGCMapPolyline::offsetPolyline(params.polyline, offsetDistance);
+        for (int j=1; j<transectCoords.count() - 1; j++) {
+            transect.append(CoordInfo_t{ transectCoords[j], CoordTypeInterior });
         }
-        if (reverseTransects) {
-            QList<QList<TransectStyleComplexItem::CoordInfo_t>> reversedTransects;
-            for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect: _transects) {
-                reversedTransects.prepend(transect);
-            }
-            _transects = reversedTransects;
+        transect.prepend(CoordInfo_t{ transectCoords.first(), CoordTypeSurveyEntry });
+        transect.append(CoordInfo_t{ transectCoords.last(), CoordTypeSurveyExit });
+
+        // Extend the transect ends for turnaround
+        if (params.turnAroundDistance > 0) {
+            QGeoCoordinate turnaroundCoord;
+
+            double azimuth = transectCoords[0].azimuthTo(transectCoords[1]);
+            turnaroundCoord = transectCoords[0].atDistanceAndAzimuth(-params.turnAroundDistance, azimuth);
+            turnaroundCoord.setAltitude(qQNaN());
+            transect.prepend(CoordInfo_t{ turnaroundCoord, CoordTypeTurnaround });
+
+            azimuth = transectCoords.last().azimuthTo(transectCoords[transectCoords.count() - 2]);
+            turnaroundCoord = transectCoords.last().atDistanceAndAzimuth(-params.turnAroundDistance, azimuth);
+            turnaroundCoord.setAltitude(qQNaN());
+            transect.append(CoordInfo_t{ turnaroundCoord, CoordTypeTurnaround });
         }
-        if (reverseVertices) {
-            for (int i=0; i<_transects.count(); i++) {
-                QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
-                for (const TransectStyleComplexItem::CoordInfo_t& vertex: _transects[i]) {
-                    reversedVertices.prepend(vertex);
-                }
-                _transects[i] = reversedVertices;
-            }
+
+        return transect;
+    };
+
+    if (offsetDistances.count() > 1) {
+        transects = QtConcurrent::blockingMapped<QList<QList<CoordInfo_t>>>(offsetDistances, buildTransect);
+    } else {
+        for (double offsetDistance: offsetDistances) {
+            transects.append(buildTransect(offsetDistance));
         }
+    }
+
+    // Now deal with fixing up the entry point:
+    //  0: Leave alone
+    //  1: Start at same end, opposite side of center
+    //  2: Start at opposite end, same side
+    //  3: Start at opposite end, opposite side
 
-        // Adjust to lawnmower pattern
-        reverseVertices = false;
-        for (int i=0; i<_transects.count(); i++) {
-            // We must reverse the vertices for every other transect in order to make a lawnmower pattern
-            QList<TransectStyleComplexItem::CoordInfo_t> transectVertices = _transects[i];
-            if (reverseVertices) {
-                reverseVertices = false;
-                QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
-                for (int j=transectVertices.count()-1; j>=0; j--) {
-                    reversedVertices.append(transectVertices[j]);
-
-                    // as we are flying the transect reversed, we also need to swap entry and exit coordinate types
-                    if (reversedVertices.last().coordType == CoordTypeSurveyEntry) {
-                        reversedVertices.last().coordType = CoordTypeSurveyExit;
-                    } else if (reversedVertices.last().coordType == CoordTypeSurveyExit) {
-                        reversedVertices.last().coordType = CoordTypeSurveyEntry;
-                    }
-                }
-
-                transectVertices = reversedVertices;
-            } else {
-                reverseVertices = true;
+    const bool reverseTransects = params.entryPoint == 1 || params.entryPoint == 3;
+    const bool reverseVertices  = params.entryPoint == 2 || params.entryPoint == 3;
+    if (reverseTransects) {
+        std::reverse(transects.begin(), transects.end());
+    }
+    if (reverseVertices) {
+        for (QList<CoordInfo_t>& transect: transects) {
+            std::reverse(transect.begin(), transect.end());
+        }
+    }
+
+    // Adjust to lawnmower pattern
+    // We must reverse the vertices for every other transect in order to make a lawnmower pattern
+    for (int i=1; i<transects.count(); i+=2) {
+        QList<CoordInfo_t>& transect = transects[i];
+        std::reverse(transect.begin(), transect.end());
+
+        // as we are flying the transect reversed, we also need to swap entry and exit coordinate types
+        for (CoordInfo_t& coordInfo: transect) {
+            if (coordInfo.coordType == CoordTypeSurveyEntry) {
+                coordInfo.coordType = CoordTypeSurveyExit;
+            } else if (coordInfo.coordType == CoordTypeSurveyExit) {
+                coordInfo.coordType = CoordTypeSurveyEntry;
             }
-            _transects[i] = transectVertices;
         }
     }
+
+    return transects;
 }
 
 void CorridorScanComplexItem::_recalcCameraShots(void)
@@ -14,6 +14,7 @@
 #include "TransectStyleComplexItem.h"
 #include "SettingsFact.h"
 #include "QGCMapPolyline.h"
+#include "CoalescingJobRunner.h"
 
 Q_DECLARE_LOGGING_CATEGORY(CorridorScanComplexItemLog)
 
@@ -46,6 +47,7 @@ public:
     QString presetsSettingsGroup(void) { return settingsGroup; }
     void    savePreset          (const QString& name);
     void    loadPreset          (const QString& name);
+    void    waitForRebuild      (void) final;
 
     // Overrides from VisualMissionionItem
     QString             commandDescription  (void) const final { return tr("Corridor Scan"); }
@@ -71,6 +73,30 @@ private slots:
     void _recalcCameraShots         (void) final;
 
 private:
+    /// Snapshot of everything needed to build the transects, so they can be built on a worker thread
+    struct TransectParams {
+        QList<QGeoCoordinate>   polyline;
+        double                  transectSpacing =       0;
+        double                  halfWidth =             0;
+        int                     transectCount =         0;
+        double                  turnAroundDistance =    0;
+        int                     entryPoint =            0;
+    };
+
+    struct TransectResult {
+        QList<QList<CoordInfo_t>>   transects;
+        quint64                     generation = 0;
+    };
+
+    // Overrides from TransectStyleComplexItem
+    bool _rebuildTransectsAsync     (void) final;
+
+    void            _transectsBuilt         (const TransectResult& result);
+    void            _clearLoadedMissionItems(void);
+    TransectParams  _transectParams         (void) const;
+
+    static QList<QList<CoordInfo_t>> _buildTransects(const TransectParams& params);
+
     double  _calcTransectSpacing    (void) const;
     int     _calcTransectCount      (void) const;
     void    _saveCommon             (QJsonObject& complexObject);
@@ -84,5 +110,8 @@ private:
     QMap<QString, FactMetaData*>    _metaDataMap;
     SettingsFact                    _corridorWidthFact;
 
+    CoalescingJobRunner<TransectResult> _transectRunner;
+    quint64                             _transectGeneration = 0;
+
     static constexpr const char* _jsonEntryPointKey =       "EntryPoint";
 };
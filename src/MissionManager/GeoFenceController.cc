@@ -22,6 +22,8 @@
 #include "QGCFenceCircle.h"
 #include "QGCFencePolygon.h"
 #include "QGCLoggingCategory.h"
+#include "QGC.h"
+#include "FactGroup.h"
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
@@ -46,6 +48,8 @@ GeoFenceController::GeoFenceController(PlanMasterController* masterController, Q
 
     connect(&_polygons, &QmlObjectListModel::countChanged, this, &GeoFenceController::_updateContainsItems);
     connect(&_circles,  &QmlObjectListModel::countChanged, this, &GeoFenceController::_updateContainsItems);
+    connect(&_polygons, &QmlObjectListModel::countChanged, this, &GeoFenceController::_updateFenceItemConnections);
+    connect(&_circles,  &QmlObjectListModel::countChanged, this, &GeoFenceController::_updateFenceItemConnections);
 
     connect(this,                       &GeoFenceController::breachReturnPointChanged,  this, &GeoFenceController::_setDirty);
     connect(&_breachReturnAltitudeFact, &Fact::rawValueChanged,                         this, &GeoFenceController::_setDirty);
@@ -112,6 +116,10 @@ void GeoFenceController::_managerVehicleChanged(Vehicle* managerVehicle)
     connect(_managerVehicle->parameterManager(), &ParameterManager::parametersReadyChanged, this, &GeoFenceController::_parametersReady);
     _parametersReady();
 
+    if (_flyView) {
+        connect(_managerVehicle, &Vehicle::coordinateChanged, this, &GeoFenceController::_updateBreachStatus);
+    }
+
     emit supportedChanged(supported());
 }
 
@@ -470,6 +478,92 @@ void GeoFenceController::deleteCircle(int index)
     circle->deleteLater();
 }
 
+void GeoFenceController::_updateFenceItemConnections(void)
+{
+    for (int i=0; i<_polygons.count(); i++) {
+        QGCFencePolygon* polygon = _polygons.value<QGCFencePolygon*>(i);
+        connect(polygon, &QGCFencePolygon::pathChanged,         this, &GeoFenceController::_fenceGeometryChanged, Qt::UniqueConnection);
+        connect(polygon, &QGCFencePolygon::inclusionChanged,    this, &GeoFenceController::_fenceGeometryChanged, Qt::UniqueConnection);
+    }
+    for (int i=0; i<_circles.count(); i++) {
+        QGCFenceCircle* circle = _circles.value<QGCFenceCircle*>(i);
+        connect(circle,             &QGCFenceCircle::centerChanged,     this, &GeoFenceController::_fenceGeometryChanged, Qt::UniqueConnection);
+        connect(circle,             &QGCFenceCircle::inclusionChanged,  this, &GeoFenceController::_fenceGeometryChanged, Qt::UniqueConnection);
+        connect(circle->radius(),   &Fact::rawValueChanged,             this, &GeoFenceController::_fenceGeometryChanged, Qt::UniqueConnection);
+    }
+
+    _fenceGeometryChanged();
+}
+
+void GeoFenceController::_fenceGeometryChanged(void)
+{
+    _fenceIndexDirty = true;
+}
+
+const GeoFenceIndex& GeoFenceController::fenceIndex(void)
+{
+    if (_fenceIndexDirty) {
+        _fenceIndexDirty = false;
+
+        _fenceIndex.clear();
+        for (int i=0; i<_polygons.count(); i++) {
+            QGCFencePolygon* polygon = _polygons.value<QGCFencePolygon*>(i);
+            _fenceIndex.addPolygon(polygon->coordinateList(), polygon->inclusion());
+        }
+        for (int i=0; i<_circles.count(); i++) {
+            QGCFenceCircle* circle = _circles.value<QGCFenceCircle*>(i);
+            _fenceIndex.addCircle(circle->center(), circle->radius()->rawValue().toDouble(), circle->inclusion());
+        }
+        _fenceIndex.build();
+    }
+
+    return _fenceIndex;
+}
+
+bool GeoFenceController::coordinateInsideFence(const QGeoCoordinate& coordinate)
+{
+    return !fenceIndex().isBreached(coordinate);
+}
+
+double GeoFenceController::predictedBreachTimeForVehicle(Vehicle* vehicle)
+{
+    if (!vehicle || !vehicle->coordinate().isValid()) {
+        return qQNaN();
+    }
+
+    FactGroup* localPosition = vehicle->localPositionFactGroup();
+    const double velocityNorth = localPosition->getFact(QStringLiteral("vx"))->rawValue().toDouble();
+    const double velocityEast =  localPosition->getFact(QStringLiteral("vy"))->rawValue().toDouble();
+    if (qIsNaN(velocityNorth) || qIsNaN(velocityEast)) {
+        return qQNaN();
+    }
+
+    return fenceIndex().predictedBreachTime(vehicle->coordinate(), velocityNorth, velocityEast, _breachPredictionHorizonSecs);
+}
+
+void GeoFenceController::_updateBreachStatus(void)
+{
+    bool    breached =              false;
+    double  distanceToBoundary =    qQNaN();
+    double  predictedBreachTime =   qQNaN();
+
+    const GeoFenceIndex& index = fenceIndex();
+    if (_managerVehicle && !index.isEmpty() && _managerVehicle->coordinate().isValid()) {
+        const QGeoCoordinate coordinate = _managerVehicle->coordinate();
+        breached =              index.isBreached(coordinate);
+        distanceToBoundary =    index.distanceToBoundary(coordinate);
+        predictedBreachTime =   predictedBreachTimeForVehicle(_managerVehicle);
+    }
+
+    // NaN != NaN so compare with fuzzy helpers which treat NaN == NaN
+    if (breached != _breached || !QGC::fuzzyCompare(distanceToBoundary, _distanceToBoundary) || !QGC::fuzzyCompare(predictedBreachTime, _predictedBreachTime)) {
+        _breached =             breached;
+        _distanceToBoundary =   distanceToBoundary;
+        _predictedBreachTime =  predictedBreachTime;
+        emit breachStatusChanged();
+    }
+}
+
 void GeoFenceController::clearAllInteractive(void)
 {
     for (int i=0; i<_polygons.count(); i++) {
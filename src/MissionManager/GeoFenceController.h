@@ -15,6 +15,7 @@
 #include "PlanElementController.h"
 #include "QmlObjectListModel.h"
 #include "Fact.h"
+#include "GeoFenceIndex.h"
 
 Q_DECLARE_LOGGING_CATEGORY(GeoFenceControllerLog)
 
@@ -41,6 +42,11 @@ public:
     // Radius of the "paramCircularFence" which is called the "Geofence Failsafe" in PX4 and the "Circular Geofence" on ArduPilot
     Q_PROPERTY(double               paramCircularFence      READ paramCircularFence                                 NOTIFY paramCircularFenceChanged)
 
+    // Live fence status for the manager vehicle. Only updated in the fly view.
+    Q_PROPERTY(bool                 breached                READ breached                                           NOTIFY breachStatusChanged)
+    Q_PROPERTY(double               distanceToBoundary      READ distanceToBoundary                                 NOTIFY breachStatusChanged)   ///< meters, NaN if no fence
+    Q_PROPERTY(double               predictedBreachTime     READ predictedBreachTime                                NOTIFY breachStatusChanged)   ///< seconds along current velocity, NaN if none predicted
+
     /// Add a new inclusion polygon to the fence
     ///     @param topLeft: Top left coordinate or map viewport
     ///     @param bottomRight: Bottom right left coordinate or map viewport
@@ -62,6 +68,13 @@ public:
     /// Clears the interactive bit from all fence items
     Q_INVOKABLE void clearAllInteractive(void);
 
+    /// @return true: coordinate is inside the fence (also true if there is no fence)
+    Q_INVOKABLE bool coordinateInsideFence(const QGeoCoordinate& coordinate);
+
+    /// Predicts the time until the specified vehicle breaches the fence if it continues along its current velocity vector
+    /// @return Seconds until breach, 0 if already breached, NaN if no breach within the prediction horizon
+    Q_INVOKABLE double predictedBreachTimeForVehicle(Vehicle* vehicle);
+
 #ifdef QGC_UTM_ADAPTER
     Q_INVOKABLE void loadFlightPlanData(void);
 #endif
@@ -84,6 +97,13 @@ public:
     bool containsItems              (void) const final;
     bool showPlanFromManagerVehicle (void) final;
 
+    bool    breached            (void) const { return _breached; }
+    double  distanceToBoundary  (void) const { return _distanceToBoundary; }
+    double  predictedBreachTime (void) const { return _predictedBreachTime; }
+
+    /// @return Spatial index of the current fence, rebuilt if the fence changed since the last call
+    const GeoFenceIndex& fenceIndex(void);
+
     QmlObjectListModel* polygons                (void) { return &_polygons; }
     QmlObjectListModel* circles                 (void) { return &_circles; }
     QGeoCoordinate      breachReturnPoint       (void) const { return _breachReturnPoint; }
@@ -96,6 +116,7 @@ signals:
     void editorQmlChanged               (QString editorQml);
     void loadComplete                   (void);
     void paramCircularFenceChanged      (void);
+    void breachStatusChanged            (void);
 
 #ifdef QGC_UTM_ADAPTER
     void uploadFlagSent         (bool flag);
@@ -113,6 +134,9 @@ private slots:
     void _managerRemoveAllComplete  (bool error);
     void _parametersReady           (void);
     void _managerVehicleChanged      (Vehicle* managerVehicle);
+    void _fenceGeometryChanged      (void);
+    void _updateFenceItemConnections(void);
+    void _updateBreachStatus        (void);
 
 private:
     void _init(void);
@@ -126,6 +150,11 @@ private:
     Fact                _breachReturnAltitudeFact;
     double              _breachReturnDefaultAltitude =  qQNaN();
     bool                _itemsRequested =               false;
+    GeoFenceIndex       _fenceIndex;
+    bool                _fenceIndexDirty =              true;
+    bool                _breached =                     false;
+    double              _distanceToBoundary =           qQNaN();
+    double              _predictedBreachTime =          qQNaN();
 
     Fact*               _px4ParamCircularFenceFact =        nullptr;
     Fact*               _apmParamCircularFenceRadiusFact =  nullptr;
@@ -143,6 +172,8 @@ private:
 
     static constexpr const char* _breachReturnAltitudeFactName = "Altitude";
 
+    static constexpr double _breachPredictionHorizonSecs = 30.0;
+
     static constexpr const char* _px4ParamCircularFence =    "GF_MAX_HOR_DIST";
     static constexpr const char* _apmParamCircularFenceRadius =    "FENCE_RADIUS";
     static constexpr const char* _apmParamCircularFenceEnabled =    "FENCE_ENABLE";
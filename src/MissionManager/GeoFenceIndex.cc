@@ -0,0 +1,415 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndex.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(GeoFenceIndexLog, "GeoFenceIndexLog")
+
+void GeoFenceIndex::clear(void)
+{
+    _polygons.clear();
+    _circles.clear();
+    _edges.clear();
+    _nodes.clear();
+    _rootNode = -1;
+    _hasInclusion = false;
+}
+
+void GeoFenceIndex::addPolygon(const QList<QGeoCoordinate>& vertices, bool inclusion)
+{
+    if (vertices.count() < 3) {
+        return;
+    }
+
+    _polygons.append({ vertices, inclusion });
+}
+
+void GeoFenceIndex::addCircle(const QGeoCoordinate& center, double radius, bool inclusion)
+{
+    if (!center.isValid() || !(radius > 0)) {
+        return;
+    }
+
+    _circles.append({ center, QPointF(), radius, inclusion });
+}
+
+void GeoFenceIndex::build(void)
+{
+    _edges.clear();
+    _nodes.clear();
+    _rootNode = -1;
+    _hasInclusion = false;
+
+    if (isEmpty()) {
+        return;
+    }
+
+    // Tangent plane origin is the mean of all vertices and circle centers
+    double latSum = 0;
+    double lonSum = 0;
+    int count = 0;
+    for (const Polygon& polygon: _polygons) {
+        for (const QGeoCoordinate& vertex: polygon.vertices) {
+            latSum += vertex.latitude();
+            lonSum += vertex.longitude();
+            count++;
+        }
+    }
+    for (const Circle& circle: _circles) {
+        latSum += circle.center.latitude();
+        lonSum += circle.center.longitude();
+        count++;
+    }
+    _origin = QGeoCoordinate(latSum / count, lonSum / count);
+    _cosOriginLat = qCos(qDegreesToRadians(_origin.latitude()));
+
+    for (int polygonIndex=0; polygonIndex<_polygons.count(); polygonIndex++) {
+        const Polygon& polygon = _polygons[polygonIndex];
+        _hasInclusion |= polygon.inclusion;
+
+        QPointF first = _project(polygon.vertices.first());
+        QPointF previous = first;
+        for (int i=1; i<polygon.vertices.count(); i++) {
+            const QPointF current = _project(polygon.vertices[i]);
+            _edges.append({ previous, current, polygonIndex });
+            previous = current;
+        }
+        _edges.append({ previous, first, polygonIndex });
+    }
+
+    for (Circle& circle: _circles) {
+        _hasInclusion |= circle.inclusion;
+        circle.projectedCenter = _project(circle.center);
+    }
+
+    _buildTree();
+
+    qCDebug(GeoFenceIndexLog) << "build polygons:circles:edges:nodes" << _polygons.count() << _circles.count() << _edges.count() << _nodes.count();
+}
+
+QPointF GeoFenceIndex::_project(const QGeoCoordinate& coordinate) const
+{
+    // Equirectangular projection about the fence centroid. x: east, y: north, both in meters.
+    const double x = qDegreesToRadians(coordinate.longitude() - _origin.longitude()) * _cosOriginLat * _metersPerRadian;
+    const double y = qDegreesToRadians(coordinate.latitude() - _origin.latitude()) * _metersPerRadian;
+
+    return QPointF(x, y);
+}
+
+GeoFenceIndex::Box GeoFenceIndex::_edgeBox(const Edge& edge)
+{
+    return { qMin(edge.a.x(), edge.b.x()), qMin(edge.a.y(), edge.b.y()), qMax(edge.a.x(), edge.b.x()), qMax(edge.a.y(), edge.b.y()) };
+}
+
+GeoFenceIndex::Box GeoFenceIndex::_unite(const Box& box1, const Box& box2)
+{
+    return { qMin(box1.minX, box2.minX), qMin(box1.minY, box2.minY), qMax(box1.maxX, box2.maxX), qMax(box1.maxY, box2.maxY) };
+}
+
+bool GeoFenceIndex::_intersects(const Box& box1, const Box& box2)
+{
+    return box1.minX <= box2.maxX && box2.minX <= box1.maxX && box1.minY <= box2.maxY && box2.minY <= box1.maxY;
+}
+
+double GeoFenceIndex::_boxDistance2(const Box& box, const QPointF& point)
+{
+    const double dx = qMax(qMax(box.minX - point.x(), 0.0), point.x() - box.maxX);
+    const double dy = qMax(qMax(box.minY - point.y(), 0.0), point.y() - box.maxY);
+
+    return (dx * dx) + (dy * dy);
+}
+
+double GeoFenceIndex::_edgeDistance2(const Edge& edge, const QPointF& point)
+{
+    const QPointF ab = edge.b - edge.a;
+    const QPointF ap = point - edge.a;
+    const double lengthSquared = QPointF::dotProduct(ab, ab);
+
+    double t = 0;
+    if (lengthSquared > 0) {
+        t = qBound(0.0, QPointF::dotProduct(ap, ab) / lengthSquared, 1.0);
+    }
+    const QPointF delta = ap - (ab * t);
+
+    return QPointF::dotProduct(delta, delta);
+}
+
+/// Sort-Tile-Recursive ordering: sort by x, cut into vertical slices and sort each slice by y so that
+/// consecutive runs of _nodeCapacity items are spatially compact.
+template<typename T, typename BoxFn>
+static void _strSort(T* items, int count, int nodeCapacity, BoxFn boxFn)
+{
+    const int nodeCount = (count + nodeCapacity - 1) / nodeCapacity;
+    const int sliceSize = qCeil(qSqrt(static_cast<double>(nodeCount))) * nodeCapacity;
+
+    std::sort(items, items + count, [&boxFn](const T& item1, const T& item2) {
+        const auto box1 = boxFn(item1);
+        const auto box2 = boxFn(item2);
+        return (box1.minX + box1.maxX) < (box2.minX + box2.maxX);
+    });
+    for (int i=0; i<count; i+=sliceSize) {
+        std::sort(items + i, items + qMin(i + sliceSize, count), [&boxFn](const T& item1, const T& item2) {
+            const auto box1 = boxFn(item1);
+            const auto box2 = boxFn(item2);
+            return (box1.minY + box1.maxY) < (box2.minY + box2.maxY);
+        });
+    }
+}
+
+void GeoFenceIndex::_buildTree(void)
+{
+    if (_edges.isEmpty()) {
+        return;
+    }
+
+    // Leaf level
+    _strSort(_edges.data(), _edges.count(), _nodeCapacity, _edgeBox);
+    for (int i=0; i<_edges.count(); i+=_nodeCapacity) {
+        Node node { _edgeBox(_edges[i]), i, qMin(_nodeCapacity, static_cast<int>(_edges.count()) - i), true };
+        for (int j=1; j<node.count; j++) {
+            node.box = _unite(node.box, _edgeBox(_edges[i + j]));
+        }
+        _nodes.append(node);
+    }
+
+    // Pack each level into parents until a single root remains. Nodes of the level being packed are not referenced
+    // by anything yet, so they can be reordered in place.
+    int levelStart = 0;
+    int levelEnd = _nodes.count();
+    while (levelEnd - levelStart > 1) {
+        _strSort(_nodes.data() + levelStart, levelEnd - levelStart, _nodeCapacity, [](const Node& node) { return node.box; });
+        for (int i=levelStart; i<levelEnd; i+=_nodeCapacity) {
+            Node node { _nodes[i].box, i, qMin(_nodeCapacity, levelEnd - i), false };
+            for (int j=1; j<node.count; j++) {
+                node.box = _unite(node.box, _nodes[i + j].box);
+            }
+            _nodes.append(node);
+        }
+        levelStart = levelEnd;
+        levelEnd = _nodes.count();
+    }
+
+    _rootNode = _nodes.count() - 1;
+}
+
+template<typename Visitor>
+void GeoFenceIndex::_queryBox(const Box& box, Visitor visitor) const
+{
+    if (_rootNode < 0) {
+        return;
+    }
+
+    QVarLengthArray<int, 64> stack;
+    stack.append(_rootNode);
+    while (!stack.isEmpty()) {
+        const Node& node = _nodes[stack.takeLast()];
+        if (!_intersects(node.box, box)) {
+            continue;
+        }
+        for (int i=node.first; i<node.first + node.count; i++) {
+            if (node.leaf) {
+                if (_intersects(_edgeBox(_edges[i]), box)) {
+                    visitor(_edges[i]);
+                }
+            } else {
+                stack.append(i);
+            }
+        }
+    }
+}
+
+bool GeoFenceIndex::_isBreached(const QPointF& point) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    // Ray cast towards +x. Only edges whose box overlaps the ray can cross it.
+    QVarLengthArray<bool, 256> insidePolygon(_polygons.count());
+    std::fill(insidePolygon.begin(), insidePolygon.end(), false);
+
+    const Box ray { point.x(), point.y(), std::numeric_limits<double>::max(), point.y() };
+    _queryBox(ray, [&point, &insidePolygon](const Edge& edge) {
+        if ((edge.a.y() > point.y()) != (edge.b.y() > point.y())) {
+            const double crossX = edge.a.x() + ((point.y() - edge.a.y()) * (edge.b.x() - edge.a.x()) / (edge.b.y() - edge.a.y()));
+            if (point.x() < crossX) {
+                insidePolygon[edge.polygonIndex] = !insidePolygon[edge.polygonIndex];
+            }
+        }
+    });
+
+    bool insideInclusion = false;
+    for (int i=0; i<_polygons.count(); i++) {
+        if (insidePolygon[i]) {
+            if (!_polygons[i].inclusion) {
+                return true;
+            }
+            insideInclusion = true;
+        }
+    }
+    for (const Circle& circle: _circles) {
+        const QPointF delta = point - circle.projectedCenter;
+        if (QPointF::dotProduct(delta, delta) <= circle.radius * circle.radius) {
+            if (!circle.inclusion) {
+                return true;
+            }
+            insideInclusion = true;
+        }
+    }
+
+    return _hasInclusion && !insideInclusion;
+}
+
+double GeoFenceIndex::_distanceToBoundary(const QPointF& point) const
+{
+    double bestDistance2 = std::numeric_limits<double>::max();
+
+    for (const Circle& circle: _circles) {
+        const QPointF delta = point - circle.projectedCenter;
+        const double distance = qAbs(qSqrt(QPointF::dotProduct(delta, delta)) - circle.radius);
+        bestDistance2 = qMin(bestDistance2, distance * distance);
+    }
+
+    if (_rootNode >= 0) {
+        // Branch and bound, visiting closer children first
+        QVarLengthArray<int, 64> stack;
+        stack.append(_rootNode);
+        while (!stack.isEmpty()) {
+            const Node& node = _nodes[stack.takeLast()];
+            if (_boxDistance2(node.box, point) >= bestDistance2) {
+                continue;
+            }
+            if (node.leaf) {
+                for (int i=node.first; i<node.first + node.count; i++) {
+                    bestDistance2 = qMin(bestDistance2, _edgeDistance2(_edges[i], point));
+                }
+            } else {
+                QVarLengthArray<QPair<double, int>, _nodeCapacity> children;
+                for (int i=node.first; i<node.first + node.count; i++) {
+                    children.append(qMakePair(_boxDistance2(_nodes[i].box, point), i));
+                }
+                // Farthest pushed first so the closest is popped first
+                std::sort(children.begin(), children.end(), [](const QPair<double, int>& c1, const QPair<double, int>& c2) { return c1.first > c2.first; });
+                for (const QPair<double, int>& child: children) {
+                    if (child.first < bestDistance2) {
+                        stack.append(child.second);
+                    }
+                }
+            }
+        }
+    }
+
+    return bestDistance2 == std::numeric_limits<double>::max() ? qQNaN() : qSqrt(bestDistance2);
+}
+
+bool GeoFenceIndex::isBreached(const QGeoCoordinate& coordinate) const
+{
+    return _isBreached(_project(coordinate));
+}
+
+double GeoFenceIndex::distanceToBoundary(const QGeoCoordinate& coordinate) const
+{
+    return _distanceToBoundary(_project(coordinate));
+}
+
+QList<bool> GeoFenceIndex::isBreached(const QList<QGeoCoordinate>& coordinates) const
+{
+    QList<bool> results;
+    results.reserve(coordinates.count());
+    for (const QGeoCoordinate& coordinate: coordinates) {
+        results.append(_isBreached(_project(coordinate)));
+    }
+
+    return results;
+}
+
+QList<double> GeoFenceIndex::distanceToBoundary(const QList<QGeoCoordinate>& coordinates) const
+{
+    QList<double> results;
+    results.reserve(coordinates.count());
+    for (const QGeoCoordinate& coordinate: coordinates) {
+        results.append(_distanceToBoundary(_project(coordinate)));
+    }
+
+    return results;
+}
+
+double GeoFenceIndex::predictedBreachTime(const QGeoCoordinate& coordinate, double velocityNorth, double velocityEast, double horizonSecs) const
+{
+    if (isEmpty()) {
+        return qQNaN();
+    }
+
+    const QPointF start = _project(coordinate);
+    if (_isBreached(start)) {
+        return 0;
+    }
+
+    const QPointF travel(velocityEast * horizonSecs, velocityNorth * horizonSecs);
+    if (qFuzzyIsNull(travel.x()) && qFuzzyIsNull(travel.y())) {
+        return qQNaN();
+    }
+    const QPointF end = start + travel;
+
+    // Collect all boundary crossings along the path as fractions of the horizon
+    QList<double> crossings;
+
+    const Box pathBox { qMin(start.x(), end.x()), qMin(start.y(), end.y()), qMax(start.x(), end.x()), qMax(start.y(), end.y()) };
+    _queryBox(pathBox, [&start, &travel, &crossings](const Edge& edge) {
+        const QPointF edgeVector = edge.b - edge.a;
+        const double denominator = (travel.x() * edgeVector.y()) - (travel.y() * edgeVector.x());
+        if (qFuzzyIsNull(denominator)) {
+            return;
+        }
+        const QPointF startToEdge = edge.a - start;
+        const double t = ((startToEdge.x() * edgeVector.y()) - (startToEdge.y() * edgeVector.x())) / denominator;
+        const double u = ((startToEdge.x() * travel.y()) - (startToEdge.y() * travel.x())) / denominator;
+        if (t >= 0 && t <= 1 && u >= 0 && u <= 1) {
+            crossings.append(t);
+        }
+    });
+
+    for (const Circle& circle: _circles) {
+        // |start + t*travel - center| = radius
+        const QPointF centerToStart = start - circle.projectedCenter;
+        const double a = QPointF::dotProduct(travel, travel);
+        const double b = 2 * QPointF::dotProduct(centerToStart, travel);
+        const double c = QPointF::dotProduct(centerToStart, centerToStart) - (circle.radius * circle.radius);
+        const double discriminant = (b * b) - (4 * a * c);
+        if (discriminant >= 0) {
+            const double root = qSqrt(discriminant);
+            for (const double t: { (-b - root) / (2 * a), (-b + root) / (2 * a) }) {
+                if (t >= 0 && t <= 1) {
+                    crossings.append(t);
+                }
+            }
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+
+    // Crossing a boundary does not necessarily breach (e.g. moving between overlapping inclusion zones). Test the
+    // path between each crossing and the next one.
+    for (int i=0; i<crossings.count(); i++) {
+        const double next = (i + 1 < crossings.count()) ? crossings[i + 1] : 1.0;
+        const QPointF testPoint = start + (travel * ((crossings[i] + next) / 2.0));
+        if (_isBreached(testPoint)) {
+            return crossings[i] * horizonSecs;
+        }
+    }
+
+    return qQNaN();
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QPointF>
+#include <QtPositioning/QGeoCoordinate>
+
+Q_DECLARE_LOGGING_CATEGORY(GeoFenceIndexLog)
+
+/// Projected, spatially indexed copy of a set of fence polygons and circles.
+///
+/// The index is built once whenever the fence changes and can then be queried at telemetry rate. Vertices are
+/// projected onto a local tangent plane around the fence centroid and all polygon edges are bulk loaded into a
+/// static R-tree. Point-in-fence is done by ray casting against only the edges the R-tree returns, distance to
+/// boundary by a branch and bound nearest edge search.
+///
+/// Fence semantics: a position is inside the fence if it is inside at least one inclusion zone (when any inclusion
+/// zones exist) and outside all exclusion zones.
+class GeoFenceIndex
+{
+public:
+    GeoFenceIndex(void) = default;
+
+    void clear(void);
+
+    /// Adds a polygon to the fence. Polygons with less than 3 vertices are ignored.
+    void addPolygon(const QList<QGeoCoordinate>& vertices, bool inclusion);
+
+    /// Adds a circle to the fence
+    ///     @param radius Radius in meters
+    void addCircle(const QGeoCoordinate& center, double radius, bool inclusion);
+
+    /// Projects all shapes and builds the R-tree. Must be called after adding shapes and before querying.
+    void build(void);
+
+    bool isEmpty    (void) const { return _polygons.isEmpty() && _circles.isEmpty(); }
+    int  edgeCount  (void) const { return _edges.count(); }
+
+    /// @return true: coordinate is outside the fence
+    bool isBreached(const QGeoCoordinate& coordinate) const;
+
+    /// @return Distance in meters from the coordinate to the nearest fence boundary, NaN if fence is empty
+    double distanceToBoundary(const QGeoCoordinate& coordinate) const;
+
+    /// Batched version of isBreached
+    QList<bool> isBreached(const QList<QGeoCoordinate>& coordinates) const;
+
+    /// Batched version of distanceToBoundary
+    QList<double> distanceToBoundary(const QList<QGeoCoordinate>& coordinates) const;
+
+    /// Predicts when a vehicle moving in a straight line will breach the fence.
+    ///     @param coordinate Current position
+    ///     @param velocityNorth North velocity in m/s
+    ///     @param velocityEast East velocity in m/s
+    ///     @param horizonSecs How far ahead to look
+    /// @return Seconds until breach, 0 if already breached, NaN if no breach within horizonSecs
+    double predictedBreachTime(const QGeoCoordinate& coordinate, double velocityNorth, double velocityEast, double horizonSecs) const;
+
+private:
+    struct Box {
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    struct Edge {
+        QPointF a;
+        QPointF b;
+        int     polygonIndex;
+    };
+
+    struct Node {
+        Box  box;
+        int  first;     ///< Index of first child node, or first edge for a leaf
+        int  count;
+        bool leaf;
+    };
+
+    struct Polygon {
+        QList<QGeoCoordinate>   vertices;
+        bool                    inclusion;
+    };
+
+    struct Circle {
+        QGeoCoordinate  center;
+        QPointF         projectedCenter;
+        double          radius;
+        bool            inclusion;
+    };
+
+    QPointF _project        (const QGeoCoordinate& coordinate) const;
+    bool    _isBreached     (const QPointF& point) const;
+    double  _distanceToBoundary(const QPointF& point) const;
+    void    _buildTree      (void);
+
+    template<typename Visitor>
+    void    _queryBox       (const Box& box, Visitor visitor) const;
+
+    static Box      _edgeBox        (const Edge& edge);
+    static Box      _unite          (const Box& box1, const Box& box2);
+    static bool     _intersects     (const Box& box1, const Box& box2);
+    static double   _boxDistance2   (const Box& box, const QPointF& point);
+    static double   _edgeDistance2  (const Edge& edge, const QPointF& point);
+
+    QList<Polygon>  _polygons;
+    QList<Circle>   _circles;
+    QList<Edge>     _edges;
+    QList<Node>     _nodes;
+    int             _rootNode =         -1;
+    bool            _hasInclusion =     false;
+    QGeoCoordinate  _origin;
+    double          _cosOriginLat =     1.0;
+
+    static constexpr int    _nodeCapacity =     16;
+    static constexpr double _metersPerRadian =  6371000.0;
+};
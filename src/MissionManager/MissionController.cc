@@ -219,6 +219,7 @@ void MissionController::sendToVehicle(void)
         qCWarning(MissionControllerLog) << "MissionControllerLog::sendToVehicle called while syncInProgress";
     } else {
         qCDebug(MissionControllerLog) << "MissionControllerLog::sendToVehicle";
+        _waitForComplexItemRebuilds(_visualItems);
         if (_visualItems->count() == 1) {
             // This prevents us from sending a possibly bogus home position to the vehicle
             QmlObjectListModel emptyModel;
@@ -230,6 +231,18 @@ void MissionController::sendToVehicle(void)
     }
 }
 
+/// Applies any background geometry rebuilds still running for complex items. Must be called before sequence numbers
+/// or geometry are read for save or upload, since applying a rebuild can change the item count of a complex item.
+void MissionController::_waitForComplexItemRebuilds(QmlObjectListModel* visualMissionItems)
+{
+    for (int i=0; i<visualMissionItems->count(); i++) {
+        ComplexMissionItem* complexItem = visualMissionItems->value<ComplexMissionItem*>(i);
+        if (complexItem) {
+            complexItem->waitForRebuild();
+        }
+    }
+}
+
 /// Converts from visual items to MissionItems
 ///     @param missionItemParent QObject parent for newly allocated MissionItems
 /// @return true: Mission end action was added to end of list
@@ -239,6 +252,8 @@ bool MissionController::_convertToMissionItems(QmlObjectListModel* visualMission
         return false;
     }
 
+    _waitForComplexItemRebuilds(visualMissionItems);
+
     bool endActionSet = false;
     int lastSeqNum = 0;
 
@@ -781,10 +796,10 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
 
         // Load item based on type
 
-        QList<JsonHelper::KeyValidateInfo> itemKeyInfoList = {
+        static const JsonHelper::KeyValidator itemKeyValidator({
             { VisualMissionItem::jsonTypeKey,  QJsonValue::String, true },
-        };
-        if (!JsonHelper::validateKeys(itemObject, itemKeyInfoList, errorString)) {
+        });
+        if (!itemKeyValidator.validate(itemObject, errorString)) {
             return false;
         }
         QString itemType = itemObject[VisualMissionItem::jsonTypeKey].toString();
@@ -806,10 +821,10 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
                 return false;
             }
         } else if (itemType == VisualMissionItem::jsonTypeComplexItemValue) {
-            QList<JsonHelper::KeyValidateInfo> complexItemKeyInfoList = {
+            static const JsonHelper::KeyValidator complexItemKeyValidator({
                 { ComplexMissionItem::jsonComplexItemTypeKey,  QJsonValue::String, true },
-            };
-            if (!JsonHelper::validateKeys(itemObject, complexItemKeyInfoList, errorString)) {
+            });
+            if (!complexItemKeyValidator.validate(itemObject, errorString)) {
                 return false;
             }
             QString complexItemType = itemObject[ComplexMissionItem::jsonComplexItemTypeKey].toString();
@@ -1082,6 +1097,8 @@ int MissionController::readyForSaveState(void) const
 
 void MissionController::save(QJsonObject& json)
 {
+    _waitForComplexItemRebuilds(_visualItems);
+
     json[JsonHelper::jsonVersionKey] = _missionFileVersion;
 
     // Mission settings
@@ -1953,7 +1970,7 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
         // We need to track commandChanged on simple item since recalc has special handling for takeoff command
         SimpleMissionItem* simpleItem = qobject_cast<SimpleMissionItem*>(visualItem);
         if (simpleItem) {
-            connect(&simpleItem->missionItem()._commandFact, &Fact::valueChanged, this, &MissionController::_itemCommandChanged);
+            connect(&simpleItem->missionItem(), &MissionItem::commandChanged, this, &MissionController::_itemCommandChanged);
         } else {
             qWarning() << "isSimpleItem == true, yet not SimpleMissionItem";
         }
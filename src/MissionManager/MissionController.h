@@ -363,6 +363,7 @@ private:
     static double           _normalizeLat                       (double lat);
     static double           _normalizeLon                       (double lon);
     static bool             _convertToMissionItems              (QmlObjectListModel* visualMissionItems, QList<MissionItem*>& rgMissionItems, QObject* missionItemParent);
+    static void             _waitForComplexItemRebuilds         (QmlObjectListModel* visualMissionItems);
 
 private:
     Vehicle*                    _controllerVehicle =            nullptr;
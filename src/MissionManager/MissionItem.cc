@@ -15,31 +15,39 @@
 #include "JsonHelper.h"
 #include "VisualMissionItem.h"
 
+struct MissionItem::Facts
+{
+    /// @param coordinateNames true: param5-7 are named Latitude/Longitude/Altitude, false: Lat/X, Lon/Y, Alt/Z
+    explicit Facts(bool coordinateNames)
+        : autoContinueFact  (0, coordinateNames ? "AutoContinue" : "", FactMetaData::valueTypeUint32)
+        , commandFact       (0, "",             FactMetaData::valueTypeUint32)
+        , frameFact         (0, "",             FactMetaData::valueTypeUint32)
+        , paramFacts        {
+                                { 0, "Param1:",                                     FactMetaData::valueTypeDouble },
+                                { 0, "Param2:",                                     FactMetaData::valueTypeDouble },
+                                { 0, "Param3:",                                     FactMetaData::valueTypeDouble },
+                                { 0, "Param4:",                                     FactMetaData::valueTypeDouble },
+                                { 0, coordinateNames ? "Latitude:"  : "Lat/X:",     FactMetaData::valueTypeDouble },
+                                { 0, coordinateNames ? "Longitude:" : "Lon/Y:",     FactMetaData::valueTypeDouble },
+                                { 0, coordinateNames ? "Altitude:"  : "Alt/Z:",     FactMetaData::valueTypeDouble },
+                            }
+    {
+    }
+
+    Fact autoContinueFact;
+    Fact commandFact;
+    Fact frameFact;
+    Fact paramFacts[7];
+};
+
 MissionItem::MissionItem(QObject* parent)
     : QObject(parent)
     , _sequenceNumber(0)
     , _doJumpId(-1)
     , _isCurrentItem(false)
-    , _autoContinueFact             (0, "AutoContinue",                 FactMetaData::valueTypeUint32)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Latitude:",                    FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Longitude:",                   FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Altitude:",                    FactMetaData::valueTypeDouble)
+    , _coordinateFactNames(true)
 {
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
-
-    setAutoContinue(true);
 
-    connect(&_param1Fact, &Fact::rawValueChanged, this, &MissionItem::_param1Changed);
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
 }
 
 MissionItem::MissionItem(int             sequenceNumber,
@@ -59,34 +67,17 @@ MissionItem::MissionItem(int             sequenceNumber,
     , _sequenceNumber(sequenceNumber)
     , _doJumpId(-1)
     , _isCurrentItem(isCurrentItem)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Lat/X:",                       FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Lon/Y:",                       FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Alt/Z:",                       FactMetaData::valueTypeDouble)
-{
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
-
-    setCommand(command);
-    setFrame(frame);
-    setAutoContinue(autoContinue);
-
-    _param1Fact.setRawValue(param1);
-    _param2Fact.setRawValue(param2);
-    _param3Fact.setRawValue(param3);
-    _param4Fact.setRawValue(param4);
-    _param5Fact.setRawValue(param5);
-    _param6Fact.setRawValue(param6);
-    _param7Fact.setRawValue(param7);
-
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
+{
+    _params.command         = command;
+    _params.frame           = frame;
+    _params.autoContinue    = autoContinue;
+    _params.params[0]       = param1;
+    _params.params[1]       = param2;
+    _params.params[2]       = param3;
+    _params.params[3]       = param4;
+    _params.params[4]       = param5;
+    _params.params[5]       = param6;
+    _params.params[6]       = param7;
 }
 
 MissionItem::MissionItem(const MissionItem& other, QObject* parent)
@@ -94,24 +85,8 @@ MissionItem::MissionItem(const MissionItem& other, QObject* parent)
     , _sequenceNumber(0)
     , _doJumpId(-1)
     , _isCurrentItem(false)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Lat/X:",                       FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Lon/Y:",                       FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Alt/Z:",                       FactMetaData::valueTypeDouble)
-{
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
-
+{
     *this = other;
-
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
 }
 
 const MissionItem& MissionItem::operator=(const MissionItem& other)
@@ -124,13 +99,9 @@ const MissionItem& MissionItem::operator=(const MissionItem& other)
     setAutoContinue(other.autoContinue());
     setIsCurrentItem(other._isCurrentItem);
 
-    _param1Fact.setRawValue(other._param1Fact.rawValue());
-    _param2Fact.setRawValue(other._param2Fact.rawValue());
-    _param3Fact.setRawValue(other._param3Fact.rawValue());
-    _param4Fact.setRawValue(other._param4Fact.rawValue());
-    _param5Fact.setRawValue(other._param5Fact.rawValue());
-    _param6Fact.setRawValue(other._param6Fact.rawValue());
-    _param7Fact.setRawValue(other._param7Fact.rawValue());
+    for (int i=1; i<=7; i++) {
+        setParam(i, other.param(i));
+    }
 
     return *this;
 }
@@ -140,6 +111,76 @@ MissionItem::~MissionItem()
 
 }
 
+MissionItem::Facts* MissionItem::_factsForEdit(void) const
+{
+    if (!_facts) {
+        MissionItem* self = const_cast<MissionItem*>(this);
+
+        _facts = std::make_unique<Facts>(_coordinateFactNames);
+
+        // Initialize values before connecting, nobody can be listening to these Facts yet
+        _facts->commandFact.setRawValue(_params.command);
+        _facts->frameFact.setRawValue(_params.frame);
+        _facts->autoContinueFact.setRawValue(_params.autoContinue);
+        for (int i=0; i<7; i++) {
+            _facts->paramFacts[i].setRawValue(_params.params[i]);
+        }
+
+        connect(&_facts->commandFact,       &Fact::rawValueChanged, self, [self](QVariant value) { self->_factValueChanged(-1, value); });
+        connect(&_facts->frameFact,         &Fact::rawValueChanged, self, [self](QVariant value) { self->_factValueChanged(-2, value); });
+        connect(&_facts->autoContinueFact,  &Fact::rawValueChanged, self, [self](QVariant value) { self->_factValueChanged(-3, value); });
+        for (int i=1; i<=7; i++) {
+            connect(&_facts->paramFacts[i-1], &Fact::rawValueChanged, self, [self, i](QVariant value) { self->_factValueChanged(i, value); });
+        }
+    }
+
+    return _facts.get();
+}
+
+Fact& MissionItem::_autoContinueFact(void) const
+{
+    return _factsForEdit()->autoContinueFact;
+}
+
+Fact& MissionItem::_commandFact(void) const
+{
+    return _factsForEdit()->commandFact;
+}
+
+Fact& MissionItem::_frameFact(void) const
+{
+    return _factsForEdit()->frameFact;
+}
+
+Fact& MissionItem::_paramFact(int paramIndex) const
+{
+    return _factsForEdit()->paramFacts[paramIndex - 1];
+}
+
+/// Called when a value is changed through the Fact (for example from the editing ui)
+///     @param paramIndex 1-7 for params, -1 command, -2 frame, -3 autoContinue
+void MissionItem::_factValueChanged(int paramIndex, const QVariant& value)
+{
+    if (_updatingFacts) {
+        return;
+    }
+
+    switch (paramIndex) {
+    case -1:
+        setCommand(static_cast<MAV_CMD>(value.toInt()));
+        break;
+    case -2:
+        setFrame(static_cast<MAV_FRAME>(value.toInt()));
+        break;
+    case -3:
+        setAutoContinue(value.toBool());
+        break;
+    default:
+        setParam(paramIndex, value.toDouble());
+        break;
+    }
+}
+
 void MissionItem::save(QJsonObject& json) const
 {
     json[VisualMissionItem::jsonTypeKey] = VisualMissionItem::jsonTypeSimpleItemValue;
@@ -186,14 +227,14 @@ bool MissionItem::_convertJsonV1ToV2(const QJsonObject& json, QJsonObject& v2Jso
         return true;
     }        
 
-    QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+    static const JsonHelper::KeyValidator keyValidator({
         { VisualMissionItem::jsonTypeKey,   QJsonValue::String, true },
         { _jsonParam1Key,                   QJsonValue::Double, true },
         { _jsonParam2Key,                   QJsonValue::Double, true },
         { _jsonParam3Key,                   QJsonValue::Double, true },
         { _jsonParam4Key,                   QJsonValue::Double, true },
-    };
-    if (!JsonHelper::validateKeys(json, keyInfoList, errorString)) {
+    });
+    if (!keyValidator.validate(json, errorString)) {
         return false;
     }
 
@@ -221,10 +262,10 @@ bool MissionItem::_convertJsonV2ToV3(QJsonObject& json, QString& errorString)
         return true;
     }
 
-    QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+    static const JsonHelper::KeyValidator keyValidator({
         { _jsonCoordinateKey, QJsonValue::Array, true },
-    };
-    if (!JsonHelper::validateKeys(json, keyInfoList, errorString)) {
+    });
+    if (!keyValidator.validate(json, errorString)) {
         return false;
     }
 
@@ -254,15 +295,16 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
         return false;
     }
 
-    QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+    // Validated once per item of a plan, so the key table is built only once
+    static const JsonHelper::KeyValidator keyValidator({
         { VisualMissionItem::jsonTypeKey,   QJsonValue::String, true },
         { _jsonFrameKey,                    QJsonValue::Double, true },
         { _jsonCommandKey,                  QJsonValue::Double, true },
         { _jsonParamsKey,                   QJsonValue::Array,  true },
         { _jsonAutoContinueKey,             QJsonValue::Bool,   true },
         { _jsonDoJumpIdKey,                 QJsonValue::Double, false },
-    };
-    if (!JsonHelper::validateKeys(convertedJson, keyInfoList, errorString)) {
+    });
+    if (!keyValidator.validate(convertedJson, errorString)) {
         return false;
     }
 
@@ -318,22 +360,40 @@ void MissionItem::setSequenceNumber(int sequenceNumber)
 
 void MissionItem::setCommand(MAV_CMD command)
 {
-    if ((MAV_CMD)this->command() != command) {
-        _commandFact.setRawValue(command);
+    if (_params.command != command) {
+        _params.command = command;
+        if (_facts) {
+            _updatingFacts = true;
+            _facts->commandFact.setRawValue(command);
+            _updatingFacts = false;
+        }
+        emit commandChanged(command);
     }
 }
 
 void MissionItem::setFrame(MAV_FRAME frame)
 {
-    if (this->frame() != frame) {
-        _frameFact.setRawValue(frame);
+    if (_params.frame != frame) {
+        _params.frame = frame;
+        if (_facts) {
+            _updatingFacts = true;
+            _facts->frameFact.setRawValue(frame);
+            _updatingFacts = false;
+        }
+        emit frameChanged(frame);
     }
 }
 
 void MissionItem::setAutoContinue(bool autoContinue)
 {
-    if (this->autoContinue() != autoContinue) {
-        _autoContinueFact.setRawValue(autoContinue);
+    if (_params.autoContinue != autoContinue) {
+        _params.autoContinue = autoContinue;
+        if (_facts) {
+            _updatingFacts = true;
+            _facts->autoContinueFact.setRawValue(autoContinue);
+            _updatingFacts = false;
+        }
+        emit autoContinueChanged(autoContinue);
     }
 }
 
@@ -345,52 +405,93 @@ void MissionItem::setIsCurrentItem(bool isCurrentItem)
     }
 }
 
-void MissionItem::setParam1(double param)
+void MissionItem::setParam(int paramIndex, double value)
 {
-    if (param1() != param) {
-        _param1Fact.setRawValue(param);
+    double& currentValue = _params.params[paramIndex - 1];
+
+    if (currentValue == value || (qIsNaN(currentValue) && qIsNaN(value))) {
+        return;
+    }
+
+    currentValue = value;
+    if (_facts) {
+        _updatingFacts = true;
+        _facts->paramFacts[paramIndex - 1].setRawValue(value);
+        _updatingFacts = false;
     }
+    _emitParamChanged(paramIndex);
+}
+
+void MissionItem::setParam1(double param)
+{
+    setParam(1, param);
 }
 
 void MissionItem::setParam2(double param)
 {
-    if (param2() != param) {
-        _param2Fact.setRawValue(param);
-    }
+    setParam(2, param);
 }
 
 void MissionItem::setParam3(double param)
 {
-    if (param3() != param) {
-        _param3Fact.setRawValue(param);
-    }
+    setParam(3, param);
 }
 
 void MissionItem::setParam4(double param)
 {
-    if (param4() != param) {
-        _param4Fact.setRawValue(param);
-    }
+    setParam(4, param);
 }
 
 void MissionItem::setParam5(double param)
 {
-    if (param5() != param) {
-        _param5Fact.setRawValue(param);
-    }
+    setParam(5, param);
 }
 
 void MissionItem::setParam6(double param)
 {
-    if (param6() != param) {
-        _param6Fact.setRawValue(param);
-    }
+    setParam(6, param);
 }
 
 void MissionItem::setParam7(double param)
 {
-    if (param7() != param) {
-        _param7Fact.setRawValue(param);
+    setParam(7, param);
+}
+
+void MissionItem::_emitParamChanged(int paramIndex)
+{
+    const double value = param(paramIndex);
+
+    switch (paramIndex) {
+    case 1:
+        emit param1Changed(value);
+        if (!qIsNaN(specifiedGimbalPitch())) {
+            emit specifiedGimbalPitchChanged(specifiedGimbalPitch());
+        }
+        break;
+    case 2:
+        emit param2Changed(value);
+        if (!qIsNaN(specifiedFlightSpeed())) {
+            emit specifiedFlightSpeedChanged(specifiedFlightSpeed());
+        }
+        break;
+    case 3:
+        emit param3Changed(value);
+        if (!qIsNaN(specifiedGimbalYaw())) {
+            emit specifiedGimbalYawChanged(specifiedGimbalYaw());
+        }
+        break;
+    case 4:
+        emit param4Changed(value);
+        break;
+    case 5:
+        emit param5Changed(value);
+        break;
+    case 6:
+        emit param6Changed(value);
+        break;
+    case 7:
+        emit param7Changed(value);
+        break;
     }
 }
 
@@ -407,8 +508,8 @@ double MissionItem::specifiedFlightSpeed(void) const
 {
     double flightSpeed = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_CHANGE_SPEED && _param2Fact.rawValue().toDouble() > 0) {
-        flightSpeed = _param2Fact.rawValue().toDouble();
+    if (_params.command == MAV_CMD_DO_CHANGE_SPEED && param2() > 0) {
+        flightSpeed = param2();
     }
 
     return flightSpeed;
@@ -418,8 +519,8 @@ double MissionItem::specifiedGimbalYaw(void) const
 {
     double gimbalYaw = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_MOUNT_CONTROL && _param7Fact.rawValue().toInt() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
-        gimbalYaw = _param3Fact.rawValue().toDouble();
+    if (_params.command == MAV_CMD_DO_MOUNT_CONTROL && static_cast<int>(param7()) == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
+        gimbalYaw = param3();
     }
 
     return gimbalYaw;
@@ -429,39 +530,9 @@ double MissionItem::specifiedGimbalPitch(void) const
 {
     double gimbalPitch = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_MOUNT_CONTROL && _param7Fact.rawValue().toInt() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
-        gimbalPitch = _param1Fact.rawValue().toDouble();
+    if (_params.command == MAV_CMD_DO_MOUNT_CONTROL && static_cast<int>(param7()) == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
+        gimbalPitch = param1();
     }
 
     return gimbalPitch;
 }
-
-void MissionItem::_param1Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double gimbalPitch = specifiedGimbalPitch();
-    if (!qIsNaN(gimbalPitch)) {
-        emit specifiedGimbalPitchChanged(gimbalPitch);
-    }
-}
-
-void MissionItem::_param2Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double flightSpeed = specifiedFlightSpeed();
-    if (!qIsNaN(flightSpeed)) {
-        emit specifiedFlightSpeedChanged(flightSpeed);
-    }
-}
-
-void MissionItem::_param3Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double gimbalYaw = specifiedGimbalYaw();
-    if (!qIsNaN(gimbalYaw)) {
-        emit specifiedGimbalYawChanged(gimbalYaw);
-    }
-}
@@ -12,6 +12,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <memory>
 #include <QtCore/QTextStream>
 #include <QtCore/QJsonObject>
 #include <QtPositioning/QGeoCoordinate>
@@ -26,7 +27,21 @@ class MissionController;
     class MissionItemTest;
 #endif
 
+/// Plain storage for the values of a mission command. This is the source of truth for a MissionItem, the
+/// Fact objects used for editing are only created on top of it when needed.
+struct MissionItemParams
+{
+    MAV_CMD     command         = MAV_CMD_NAV_WAYPOINT;
+    MAV_FRAME   frame           = MAV_FRAME_GLOBAL_RELATIVE_ALT;
+    bool        autoContinue    = true;
+    double      params[7]       = { 0, 0, 0, 0, 0, 0, 0 };
+};
+
 // Represents a Mavlink mission command.
+//
+// Values are held in a MissionItemParams struct. The command/frame/param Facts are only allocated the first time
+// they are accessed (normally when the item is shown in an editor). Items used only for transport or plan
+// generation never pay for the Fact/FactMetaData objects.
 class MissionItem : public QObject
 {
     Q_OBJECT
@@ -54,21 +69,28 @@ public:
 
     const MissionItem& operator=(const MissionItem& other);
     
-    MAV_CMD         command         (void) const { return (MAV_CMD)_commandFact.rawValue().toInt(); }
+    MAV_CMD         command         (void) const { return _params.command; }
     bool            isCurrentItem   (void) const { return _isCurrentItem; }
     int             sequenceNumber  (void) const { return _sequenceNumber; }
-    MAV_FRAME       frame           (void) const { return (MAV_FRAME)_frameFact.rawValue().toInt(); }
-    bool            autoContinue    (void) const { return _autoContinueFact.rawValue().toBool(); }
-    double          param1          (void) const { return _param1Fact.rawValue().toDouble(); }
-    double          param2          (void) const { return _param2Fact.rawValue().toDouble(); }
-    double          param3          (void) const { return _param3Fact.rawValue().toDouble(); }
-    double          param4          (void) const { return _param4Fact.rawValue().toDouble(); }
-    double          param5          (void) const { return _param5Fact.rawValue().toDouble(); }
-    double          param6          (void) const { return _param6Fact.rawValue().toDouble(); }
-    double          param7          (void) const { return _param7Fact.rawValue().toDouble(); }
+    MAV_FRAME       frame           (void) const { return _params.frame; }
+    bool            autoContinue    (void) const { return _params.autoContinue; }
+    double          param1          (void) const { return _params.params[0]; }
+    double          param2          (void) const { return _params.params[1]; }
+    double          param3          (void) const { return _params.params[2]; }
+    double          param4          (void) const { return _params.params[3]; }
+    double          param5          (void) const { return _params.params[4]; }
+    double          param6          (void) const { return _params.params[5]; }
+    double          param7          (void) const { return _params.params[6]; }
     QGeoCoordinate  coordinate      (void) const;
     int             doJumpId        (void) const { return _doJumpId; }
 
+    /// @param paramIndex 1-7
+    double          param           (int paramIndex) const { return _params.params[paramIndex - 1]; }
+    const MissionItemParams& params (void) const { return _params; }
+
+    /// @return true: The command/frame/param Facts have been allocated for this item
+    bool factsCreated(void) const { return _facts != nullptr; }
+
     /// @return Flight speed change value if this item supports it. If not it returns NaN.
     double specifiedFlightSpeed(void) const;
 
@@ -90,6 +112,9 @@ public:
     void setParam5          (double param5);
     void setParam6          (double param6);
     void setParam7          (double param7);
+
+    /// @param paramIndex 1-7
+    void setParam           (int paramIndex, double value);
     
     void save(QJsonObject& json) const;
     bool load(QTextStream &loadStream);
@@ -104,29 +129,50 @@ signals:
     void specifiedGimbalYawChanged  (double gimbalYaw);
     void specifiedGimbalPitchChanged(double gimbalPitch);
 
-private slots:
-    void _param1Changed(QVariant value);
-    void _param2Changed(QVariant value);
-    void _param3Changed(QVariant value);
+    // Value change signals. These are signalled regardless of whether the Facts have been created or not.
+    void commandChanged             (int command);
+    void frameChanged               (int frame);
+    void autoContinueChanged        (bool autoContinue);
+    void param1Changed              (double param1);
+    void param2Changed              (double param2);
+    void param3Changed              (double param3);
+    void param4Changed              (double param4);
+    void param5Changed              (double param5);
+    void param6Changed              (double param6);
+    void param7Changed              (double param7);
 
 private:
+    struct Facts;
+
     bool _convertJsonV1ToV2(const QJsonObject& json, QJsonObject& v2Json, QString& errorString);
     bool _convertJsonV2ToV3(QJsonObject& json, QString& errorString);
 
-    int     _sequenceNumber;
-    int     _doJumpId;
-    bool    _isCurrentItem;
-
-    Fact    _autoContinueFact;
-    Fact    _commandFact;
-    Fact    _frameFact;
-    Fact    _param1Fact;
-    Fact    _param2Fact;
-    Fact    _param3Fact;
-    Fact    _param4Fact;
-    Fact    _param5Fact;
-    Fact    _param6Fact;
-    Fact    _param7Fact;
+    /// Allocates the Facts on first use, initialized from the current values
+    Facts* _factsForEdit        (void) const;
+    void   _factValueChanged    (int paramIndex, const QVariant& value);
+    void   _emitParamChanged    (int paramIndex);
+
+    // Fact accessors for the editing ui. Calling these allocates the Facts if needed.
+    Fact& _autoContinueFact (void) const;
+    Fact& _commandFact      (void) const;
+    Fact& _frameFact        (void) const;
+    Fact& _param1Fact       (void) const { return _paramFact(1); }
+    Fact& _param2Fact       (void) const { return _paramFact(2); }
+    Fact& _param3Fact       (void) const { return _paramFact(3); }
+    Fact& _param4Fact       (void) const { return _paramFact(4); }
+    Fact& _param5Fact       (void) const { return _paramFact(5); }
+    Fact& _param6Fact       (void) const { return _paramFact(6); }
+    Fact& _param7Fact       (void) const { return _paramFact(7); }
+    Fact& _paramFact        (int paramIndex) const;
+
+    int                 _sequenceNumber;
+    int                 _doJumpId;
+    bool                _isCurrentItem;
+    MissionItemParams   _params;
+    bool                _coordinateFactNames = false;   ///< Default constructed items name param5-7 Latitude/Longitude/Altitude
+
+    mutable std::unique_ptr<Facts>  _facts;
+    bool                            _updatingFacts = false;  ///< true: pushing a value into the Facts, ignore the echo
 
     // Keys for Json save
     static constexpr const char*  _jsonFrameKey =           "frame";
@@ -94,7 +94,7 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
     }
 
     _isCurrentItem = missionItem.isCurrentItem();
-    _altitudeFact.setRawValue(specifiesAltitude() ? _missionItem._param7Fact.rawValue() : qQNaN());
+    _altitudeFact.setRawValue(specifiesAltitude() ? _missionItem.param7() : qQNaN());
     _amslAltAboveTerrainFact.setRawValue(qQNaN());
 
     // In flyView we skip some of the intialization to save memory
@@ -116,15 +116,15 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
 void SimpleMissionItem::_connectSignals(void)
 {
     // Connect to change signals to track dirty state
-    connect(&_missionItem._param1Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param2Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param3Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param4Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param5Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param6Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._param7Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._frameFact,           &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param1Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param2Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param3Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param4Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param5Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param6Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::param7Changed,                this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::frameChanged,                 this, &SimpleMissionItem::_setDirty);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::_setDirty);
     connect(&_missionItem,                      &MissionItem::sequenceNumberChanged,        this, &SimpleMissionItem::_setDirty);
     connect(this,                               &SimpleMissionItem::altitudeModeChanged,    this, &SimpleMissionItem::_setDirty);
 
@@ -136,7 +136,7 @@ void SimpleMissionItem::_connectSignals(void)
     connect(this,                               &SimpleMissionItem::cameraSectionChanged,   this, &SimpleMissionItem::_setDirty);
     connect(this,                               &SimpleMissionItem::cameraSectionChanged,   this, &SimpleMissionItem::_updateLastSequenceNumber);
 
-    connect(&_missionItem._param7Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_amslEntryAltChanged);
+    connect(&_missionItem,                      &MissionItem::param7Changed,                this, &SimpleMissionItem::_amslEntryAltChanged);
     connect(this,                               &SimpleMissionItem::altitudeModeChanged,    this, &SimpleMissionItem::_amslEntryAltChanged);
     connect(this,                               &SimpleMissionItem::terrainAltitudeChanged, this, &SimpleMissionItem::_amslEntryAltChanged);
     connect(this,                               &SimpleMissionItem::amslEntryAltChanged,    this, &SimpleMissionItem::amslExitAltChanged);
@@ -144,35 +144,35 @@ void SimpleMissionItem::_connectSignals(void)
     connect(this, &SimpleMissionItem::wizardModeChanged,                                    this, &SimpleMissionItem::readyForSaveStateChanged);
 
     // These are coordinate lat/lon values, they must emit coordinateChanged signal
-    connect(&_missionItem._param5Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_sendCoordinateChanged);
-    connect(&_missionItem._param6Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_sendCoordinateChanged);
+    connect(&_missionItem,                      &MissionItem::param5Changed,                this, &SimpleMissionItem::_sendCoordinateChanged);
+    connect(&_missionItem,                      &MissionItem::param6Changed,                this, &SimpleMissionItem::_sendCoordinateChanged);
 
-    connect(&_missionItem._param1Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_possibleAdditionalTimeDelayChanged);
-    connect(&_missionItem._param4Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_possibleVehicleYawChanged);
+    connect(&_missionItem,                      &MissionItem::param1Changed,                this, &SimpleMissionItem::_possibleAdditionalTimeDelayChanged);
+    connect(&_missionItem,                      &MissionItem::param4Changed,                this, &SimpleMissionItem::_possibleVehicleYawChanged);
 
     // For NAV_LOITER_X commands, they must emit a radiusChanged signal
-    connect(&_missionItem._param2Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_possibleRadiusChanged);
-    connect(&_missionItem._param3Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_possibleRadiusChanged);
+    connect(&_missionItem,                      &MissionItem::param2Changed,                this, &SimpleMissionItem::_possibleRadiusChanged);
+    connect(&_missionItem,                      &MissionItem::param3Changed,                this, &SimpleMissionItem::_possibleRadiusChanged);
     
     // Exit coordinate is the same as entrance coordinate
     connect(this,                               &SimpleMissionItem::coordinateChanged,      this, &SimpleMissionItem::exitCoordinateChanged);
 
     // The following changes may also change friendlyEditAllowed
-    connect(&_missionItem._autoContinueFact,    &Fact::valueChanged,                        this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
-    connect(&_missionItem._frameFact,           &Fact::valueChanged,                        this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem,                      &MissionItem::autoContinueChanged,          this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem,                      &MissionItem::frameChanged,                 this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
 
     // A command change triggers a number of other changes as well.
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::_setDefaultsForCommand);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::commandNameChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::commandDescriptionChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::abbreviationChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::specifiesCoordinateChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::specifiesAltitudeOnlyChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::isStandaloneCoordinateChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::isLandCommandChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::isLoiterItemChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::showLoiterRadiusChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::_setDefaultsForCommand);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::commandNameChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::commandDescriptionChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::abbreviationChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::specifiesCoordinateChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::specifiesAltitudeOnlyChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::isStandaloneCoordinateChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::isLandCommandChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::isLoiterItemChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::showLoiterRadiusChanged);
 
     // Whenever these properties change the ui model changes as well
     connect(this,                               &SimpleMissionItem::commandChanged,         this, &SimpleMissionItem::_rebuildFacts);
@@ -181,10 +181,10 @@ void SimpleMissionItem::_connectSignals(void)
 
     // The following changes must signal currentVTOLModeChanged to cause a MissionController recalc
     connect(this,                               &SimpleMissionItem::commandChanged,         this, &SimpleMissionItem::_signalIfVTOLTransitionCommand);
-    connect(&_missionItem._param1Fact,          &Fact::valueChanged,                        this, &SimpleMissionItem::_signalIfVTOLTransitionCommand);
+    connect(&_missionItem,                      &MissionItem::param1Changed,                this, &SimpleMissionItem::_signalIfVTOLTransitionCommand);
 
     // These fact signals must alway signal out through SimpleMissionItem signals
-    connect(&_missionItem._commandFact,         &Fact::valueChanged,                        this, &SimpleMissionItem::_sendCommandChanged);
+    connect(&_missionItem,                      &MissionItem::commandChanged,               this, &SimpleMissionItem::_sendCommandChanged);
 
     // Propogate signals from MissionItem up to SimpleMissionItem
     connect(&_missionItem,                      &MissionItem::sequenceNumberChanged,        this, &SimpleMissionItem::sequenceNumberChanged);
@@ -238,8 +238,6 @@ void SimpleMissionItem::_setupMetaData(void)
 
     }
 
-    _missionItem._commandFact.setMetaData(_commandMetaData);
-    _missionItem._frameFact.setMetaData(_frameMetaData);
     _altitudeFact.setMetaData(_altitudeMetaData);
     _amslAltAboveTerrainFact.setMetaData(_altitudeMetaData);
 }
@@ -277,7 +275,7 @@ bool SimpleMissionItem::load(QTextStream &loadStream)
     if ((success = _missionItem.load(loadStream))) {
         if (specifiesAltitude()) {
             _altitudeMode = _missionItem.relativeAltitude() ? QGroundControlQmlGlobal::AltitudeModeRelative : QGroundControlQmlGlobal::AltitudeModeAbsolute;
-            _altitudeFact.setRawValue(_missionItem._param7Fact.rawValue());
+            _altitudeFact.setRawValue(_missionItem.param7());
             _amslAltAboveTerrainFact.setRawValue(qQNaN());
         }
         _connectSignals();
@@ -297,12 +295,12 @@ bool SimpleMissionItem::load(const QJsonObject& json, int sequenceNumber, QStrin
 
     if (specifiesAltitude()) {
         if (json.contains(_jsonAltitudeModeKey) || json.contains(_jsonAltitudeKey) || json.contains(_jsonAMSLAltAboveTerrainKey)) {
-            QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+            static const JsonHelper::KeyValidator keyValidator({
                 { _jsonAltitudeModeKey,         QJsonValue::Double, true },
                 { _jsonAltitudeKey,             QJsonValue::Double, true },
                 { _jsonAMSLAltAboveTerrainKey,  QJsonValue::Double, true },
-            };
-            if (!JsonHelper::validateKeys(json, keyInfoList, errorString)) {
+            });
+            if (!keyValidator.validate(json, errorString)) {
                 return false;
             }
 
@@ -311,7 +309,7 @@ bool SimpleMissionItem::load(const QJsonObject& json, int sequenceNumber, QStrin
             _amslAltAboveTerrainFact.setRawValue(JsonHelper::possibleNaNJsonValue(json[_jsonAltitudeKey]));
         } else {
             _altitudeMode = _missionItem.relativeAltitude() ? QGroundControlQmlGlobal::AltitudeModeRelative : QGroundControlQmlGlobal::AltitudeModeAbsolute;
-            _altitudeFact.setRawValue(_missionItem._param7Fact.rawValue());
+            _altitudeFact.setRawValue(_missionItem.param7());
             _amslAltAboveTerrainFact.setRawValue(qQNaN());
         }
     }
@@ -408,27 +406,27 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
     _textFieldFacts.clear();
     
     if (rawEdit()) {
-        _missionItem._param1Fact._setName("Param1");
-        _missionItem._param1Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param1Fact);
-        _missionItem._param2Fact._setName("Param2");
-        _missionItem._param2Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param2Fact);
-        _missionItem._param3Fact._setName("Param3");
-        _missionItem._param3Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param3Fact);
-        _missionItem._param4Fact._setName("Param4");
-        _missionItem._param4Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param4Fact);
-        _missionItem._param5Fact._setName("Lat/X");
-        _missionItem._param5Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param5Fact);
-        _missionItem._param6Fact._setName("Lon/Y");
-        _missionItem._param6Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param6Fact);
-        _missionItem._param7Fact._setName("Alt/Z");
-        _missionItem._param7Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param7Fact);
+        _missionItem._param1Fact()._setName("Param1");
+        _missionItem._param1Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param1Fact());
+        _missionItem._param2Fact()._setName("Param2");
+        _missionItem._param2Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param2Fact());
+        _missionItem._param3Fact()._setName("Param3");
+        _missionItem._param3Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param3Fact());
+        _missionItem._param4Fact()._setName("Param4");
+        _missionItem._param4Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param4Fact());
+        _missionItem._param5Fact()._setName("Lat/X");
+        _missionItem._param5Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param5Fact());
+        _missionItem._param6Fact()._setName("Lon/Y");
+        _missionItem._param6Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param6Fact());
+        _missionItem._param7Fact()._setName("Alt/Z");
+        _missionItem._param7Fact().setMetaData(_defaultParamMetaData);
+        _textFieldFacts.append(&_missionItem._param7Fact());
     } else {
         _ignoreDirtyChangeSignals = true;
 
@@ -439,7 +437,7 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
             command = _missionItem.command();
         }
 
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
+        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact(), &_missionItem._param2Fact(), &_missionItem._param3Fact(), &_missionItem._param4Fact(), &_missionItem._param5Fact(), &_missionItem._param6Fact(), &_missionItem._param7Fact() };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
@@ -483,7 +481,7 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
             command = _missionItem.command();
         }
 
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
+        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact(), &_missionItem._param2Fact(), &_missionItem._param3Fact(), &_missionItem._param4Fact(), &_missionItem._param5Fact(), &_missionItem._param6Fact(), &_missionItem._param7Fact() };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
@@ -554,10 +552,10 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
     _comboboxFacts.clear();
 
     if (rawEdit()) {
-        _comboboxFacts.append(&_missionItem._commandFact);
-        _comboboxFacts.append(&_missionItem._frameFact);
+        _comboboxFacts.append(&_missionItem._commandFact());
+        _comboboxFacts.append(&_missionItem._frameFact());
     } else {
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
+        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact(), &_missionItem._param2Fact(), &_missionItem._param3Fact(), &_missionItem._param4Fact(), &_missionItem._param5Fact(), &_missionItem._param6Fact(), &_missionItem._param7Fact() };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         MAV_CMD command;
@@ -589,8 +587,27 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
     }
 }
 
+void SimpleMissionItem::_createEditFacts(void)
+{
+    // In flyView we never show the editor so the fact lists are left empty
+    if (_editFactsCreated || _flyView) {
+        return;
+    }
+    _editFactsCreated = true;
+
+    _missionItem._commandFact().setMetaData(_commandMetaData);
+    _missionItem._frameFact().setMetaData(_frameMetaData);
+
+    _rebuildFacts();
+}
+
 void SimpleMissionItem::_rebuildFacts(void)
 {
+    if (!_editFactsCreated) {
+        // Nothing is editing this item yet. The lists are built the first time they are requested.
+        return;
+    }
+
     _rebuildTextFieldFacts();
     _rebuildNaNFacts();
     _rebuildComboBoxFacts();
@@ -639,7 +656,7 @@ void SimpleMissionItem::setDirty(bool dirty)
 {
     if (!_homePositionSpecialCase || (_dirty != dirty)) {
         _dirty = dirty;
-        if (!dirty) {
+        if (!dirty && _cameraSection) {
             _cameraSection->setDirty(false);
             _speedSection->setDirty(false);
         }
@@ -669,7 +686,7 @@ void SimpleMissionItem::_altitudeModeChanged(void)
         // Terrain altitudes are Absolute
         _missionItem.setFrame(MAV_FRAME_GLOBAL);
         // Clear any old calculated values
-        _missionItem._param7Fact.setRawValue(qQNaN());
+        _missionItem.setParam7(qQNaN());
         _amslAltAboveTerrainFact.setRawValue(qQNaN());
         break;
     case QGroundControlQmlGlobal::AltitudeModeAbsolute:
@@ -702,7 +719,7 @@ void SimpleMissionItem::_altitudeChanged(void)
     }
 
     if (_altitudeMode != QGroundControlQmlGlobal::AltitudeModeCalcAboveTerrain) {
-        _missionItem._param7Fact.setRawValue(_altitudeFact.rawValue());
+        _missionItem.setParam7(_altitudeFact.rawValue().toDouble());
     }
 }
 
@@ -717,7 +734,7 @@ void SimpleMissionItem::_terrainAltChanged(void)
         if (qIsNaN(terrainAltitude())) {
             // Set NaNs to signal we are waiting on terrain data
             if (_altitudeMode == QGroundControlQmlGlobal::AltitudeModeCalcAboveTerrain) {
-                _missionItem._param7Fact.setRawValue(qQNaN());
+                _missionItem.setParam7(qQNaN());
             }
             _amslAltAboveTerrainFact.setRawValue(qQNaN());
         } else {
@@ -725,7 +742,7 @@ void SimpleMissionItem::_terrainAltChanged(void)
             double oldAboveTerrain = _amslAltAboveTerrainFact.rawValue().toDouble();
             if (!QGC::fuzzyCompare(newAboveTerrain, oldAboveTerrain)) {
                 if (_altitudeMode == QGroundControlQmlGlobal::AltitudeModeCalcAboveTerrain) {
-                    _missionItem._param7Fact.setRawValue(newAboveTerrain);
+                    _missionItem.setParam7(newAboveTerrain);
                 }
                 _amslAltAboveTerrainFact.setRawValue(newAboveTerrain);
             }
@@ -740,26 +757,26 @@ SimpleMissionItem::ReadyForSaveState SimpleMissionItem::readyForSaveState(void)
         return NotReadyForSaveData;
     }
 
-    bool terrainReady =  !specifiesAltitude() || !qIsNaN(_missionItem._param7Fact.rawValue().toDouble());
+    bool terrainReady =  !specifiesAltitude() || !qIsNaN(_missionItem.param7());
     return terrainReady ? ReadyForSave : NotReadyForSaveTerrain;
 }
 
 void SimpleMissionItem::_setDefaultsForCommand(void)
 {
     // First reset params 1-4 to 0, we leave 5-7 alone to preserve any previous location information on command change
-    _missionItem._param1Fact.setRawValue(0);
-    _missionItem._param2Fact.setRawValue(0);
-    _missionItem._param3Fact.setRawValue(0);
-    _missionItem._param4Fact.setRawValue(0);
+    _missionItem.setParam1(0);
+    _missionItem.setParam2(0);
+    _missionItem.setParam3(0);
+    _missionItem.setParam4(0);
 
     if (!specifiesCoordinate() && !isStandaloneCoordinate()) {
         // No need to carry across previous lat/lon
-        _missionItem._param5Fact.setRawValue(0);
-        _missionItem._param6Fact.setRawValue(0);
-    } else if ((specifiesCoordinate() || isStandaloneCoordinate()) && _missionItem._param5Fact.rawValue().toDouble() == 0 && _missionItem._param6Fact.rawValue().toDouble() == 0) {
+        _missionItem.setParam5(0);
+        _missionItem.setParam6(0);
+    } else if ((specifiesCoordinate() || isStandaloneCoordinate()) && _missionItem.param5() == 0 && _missionItem.param6() == 0) {
         // We switched from a command without a coordinate to a command with a coordinate. Use the hint.
-        _missionItem._param5Fact.setRawValue(_mapCenterHint.latitude());
-        _missionItem._param6Fact.setRawValue(_mapCenterHint.longitude());
+        _missionItem.setParam5(_mapCenterHint.latitude());
+        _missionItem.setParam6(_mapCenterHint.longitude());
     }
 
     // Set global defaults first, then if there are param defaults they will get reset
@@ -769,13 +786,13 @@ void SimpleMissionItem::_setDefaultsForCommand(void)
     if (specifiesAltitude()) {
         double defaultAlt = SettingsManager::instance()->appSettings()->defaultMissionItemAltitude()->rawValue().toDouble();
         _altitudeFact.setRawValue(defaultAlt);
-        _missionItem._param7Fact.setRawValue(defaultAlt);
+        _missionItem.setParam7(defaultAlt);
         // Note that setAltitudeMode will also set MAV_FRAME correctly through signalling
         // Takeoff items always use relative alt since that is the highest quality data to base altitude from
         setAltitudeMode(isTakeoffItem() ? QGroundControlQmlGlobal::AltitudeModeRelative : _missionController->globalAltitudeModeDefault());
     } else {
         _altitudeFact.setRawValue(0);
-        _missionItem._param7Fact.setRawValue(0);
+        _missionItem.setParam7(0);
         _missionItem.setFrame(MAV_FRAME_MISSION);
     }
 
@@ -786,8 +803,7 @@ void SimpleMissionItem::_setDefaultsForCommand(void)
             bool showUI;
             const MissionCmdParamInfo* paramInfo = uiInfo->getParamInfo(i, showUI);
             if (paramInfo) {
-                Fact* rgParamFacts[7] = { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-                rgParamFacts[paramInfo->param()-1]->setRawValue(paramInfo->defaultValue());
+                _missionItem.setParam(paramInfo->param(), paramInfo->defaultValue());
             }
         }
     }
@@ -861,7 +877,7 @@ void SimpleMissionItem::setSequenceNumber(int sequenceNumber)
 
 double SimpleMissionItem::specifiedFlightSpeed(void)
 {
-    if (_speedSection->specifyFlightSpeed()) {
+    if (_speedSection && _speedSection->specifyFlightSpeed()) {
         return _speedSection->flightSpeed()->rawValue().toDouble();
     } else {
         return missionItem().specifiedFlightSpeed();
@@ -870,12 +886,12 @@ double SimpleMissionItem::specifiedFlightSpeed(void)
 
 double SimpleMissionItem::specifiedGimbalYaw(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
+    return (_cameraSection && _cameraSection->available()) ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
 }
 
 double SimpleMissionItem::specifiedGimbalPitch(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
+    return (_cameraSection && _cameraSection->available()) ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
 }
 
 double SimpleMissionItem::specifiedVehicleYaw(void)
@@ -894,6 +910,12 @@ bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int sca
 {
     bool sectionFound = false;
 
+    // Sections are only available on waypoints, and only need to exist if there are items left to scan into them
+    if ((static_cast<MAV_CMD>(command()) != MAV_CMD_NAV_WAYPOINT) || (scanIndex >= visualItems->count())) {
+        return false;
+    }
+    _createOptionalSections();
+
     if (_cameraSection->available()) {
         sectionFound |= _cameraSection->scanForSection(visualItems, scanIndex);
     }
@@ -906,7 +928,8 @@ bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int sca
 
 void SimpleMissionItem::_updateOptionalSections(void)
 {
-    // Remove previous sections
+    // Remove previous sections, new ones are created on first use
+    const bool sectionsCreated = _cameraSection != nullptr;
     if (_cameraSection) {
         _cameraSection->deleteLater();
         _cameraSection = nullptr;
@@ -916,7 +939,18 @@ void SimpleMissionItem::_updateOptionalSections(void)
         _speedSection = nullptr;
     }
 
-    // Add new sections
+    if (sectionsCreated) {
+        emit cameraSectionChanged(cameraSection());
+        emit speedSectionChanged(speedSection());
+    }
+    emit lastSequenceNumberChanged(lastSequenceNumber());
+}
+
+void SimpleMissionItem::_createOptionalSections(void)
+{
+    if (_cameraSection) {
+        return;
+    }
 
     _cameraSection = new CameraSection(_masterController, this);
     _speedSection = new SpeedSection(_masterController, this);
@@ -924,6 +958,7 @@ void SimpleMissionItem::_updateOptionalSections(void)
         _cameraSection->setAvailable(true);
         _speedSection->setAvailable(true);
     }
+    _applyFlightStatusToSections();
 
     connect(_cameraSection, &CameraSection::dirtyChanged,                   this, &SimpleMissionItem::_sectionDirtyChanged);
     connect(_cameraSection, &CameraSection::itemCountChanged,               this, &SimpleMissionItem::_updateLastSequenceNumber);
@@ -935,10 +970,6 @@ void SimpleMissionItem::_updateOptionalSections(void)
     connect(_speedSection,  &SpeedSection::dirtyChanged,                this, &SimpleMissionItem::_sectionDirtyChanged);
     connect(_speedSection,  &SpeedSection::itemCountChanged,            this, &SimpleMissionItem::_updateLastSequenceNumber);
     connect(_speedSection,  &SpeedSection::specifiedFlightSpeedChanged, this, &SimpleMissionItem::specifiedFlightSpeedChanged);
-
-    emit cameraSectionChanged(_cameraSection);
-    emit speedSectionChanged(_speedSection);
-    emit lastSequenceNumberChanged(lastSequenceNumber());
 }
 
 int SimpleMissionItem::lastSequenceNumber(void) const
@@ -965,8 +996,10 @@ void SimpleMissionItem::appendMissionItems(QList<MissionItem*>& items, QObject*
     items.append(new MissionItem(missionItem(), missionItemParent));
     seqNum++;
 
-    _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
-    _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    if (_cameraSection) {
+        _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
+        _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    }
 }
 
 void SimpleMissionItem::applyNewAltitude(double newAltitude)
@@ -992,15 +1025,28 @@ void SimpleMissionItem::setMissionFlightStatus(MissionController::MissionFlightS
     VisualMissionItem::setMissionFlightStatus(missionFlightStatus);
 
     // If speed and/or gimbal are not specifically set on this item. Then use the flight status values as initial defaults should a user turn them on.
-    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !QGC::fuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), missionFlightStatus.vehicleSpeed)) {
-        _speedSection->flightSpeed()->setRawValue(missionFlightStatus.vehicleSpeed);
+    // Sections which have not been created yet pick these up when they are.
+    _sectionFlightSpeed = missionFlightStatus.vehicleSpeed;
+    _sectionGimbalYaw = missionFlightStatus.gimbalYaw;
+    _sectionGimbalPitch = missionFlightStatus.gimbalPitch;
+    _applyFlightStatusToSections();
+}
+
+void SimpleMissionItem::_applyFlightStatusToSections(void)
+{
+    if (!_cameraSection) {
+        return;
+    }
+
+    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !qIsNaN(_sectionFlightSpeed) && !QGC::fuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), _sectionFlightSpeed)) {
+        _speedSection->flightSpeed()->setRawValue(_sectionFlightSpeed);
     }
     if (_cameraSection->available() && !_cameraSection->specifyGimbal()) {
-        if (!qIsNaN(missionFlightStatus.gimbalYaw) && !QGC::fuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), missionFlightStatus.gimbalYaw)) {
-            _cameraSection->gimbalYaw()->setRawValue(missionFlightStatus.gimbalYaw);
+        if (!qIsNaN(_sectionGimbalYaw) && !QGC::fuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), _sectionGimbalYaw)) {
+            _cameraSection->gimbalYaw()->setRawValue(_sectionGimbalYaw);
         }
-        if (!qIsNaN(missionFlightStatus.gimbalPitch) && !QGC::fuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), missionFlightStatus.gimbalPitch)) {
-            _cameraSection->gimbalPitch()->setRawValue(missionFlightStatus.gimbalPitch);
+        if (!qIsNaN(_sectionGimbalPitch) && !QGC::fuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), _sectionGimbalPitch)) {
+            _cameraSection->gimbalPitch()->setRawValue(_sectionGimbalPitch);
         }
     }
 }
@@ -66,7 +66,7 @@ public:
     // Property accesors
     
     QString         category            (void) const;
-    int             command             (void) const { return _missionItem._commandFact.cookedValue().toInt(); }
+    int             command             (void) const { return _missionItem.command(); }
     MAV_CMD         mavCommand          (void) const { return static_cast<MAV_CMD>(command()); }
     bool            friendlyEditAllowed (void) const;
     bool            rawEdit             (void) const;
@@ -78,12 +78,17 @@ public:
     bool            showLoiterRadius    (void) const;
     double          loiterRadius        (void) const;
 
-    CameraSection*  cameraSection       (void) { return _cameraSection; }
-    SpeedSection*   speedSection        (void) { return _speedSection; }
+    // The optional sections are only created the first time one of these is requested
+    CameraSection*  cameraSection       (void) { _createOptionalSections(); return _cameraSection; }
+    SpeedSection*   speedSection        (void) { _createOptionalSections(); return _speedSection; }
 
-    QmlObjectListModel* textFieldFacts  (void) { return &_textFieldFacts; }
-    QmlObjectListModel* nanFacts        (void) { return &_nanFacts; }
-    QmlObjectListModel* comboboxFacts   (void) { return &_comboboxFacts; }
+    /// @return true: The camera and speed sections have been allocated for this item
+    bool            sectionsCreated     (void) const { return _cameraSection != nullptr; }
+
+    // The editing Facts are only created the first time one of these is requested
+    QmlObjectListModel* textFieldFacts  (void) { _createEditFacts(); return &_textFieldFacts; }
+    QmlObjectListModel* nanFacts        (void) { _createEditFacts(); return &_nanFacts; }
+    QmlObjectListModel* comboboxFacts   (void) { _createEditFacts(); return &_comboboxFacts; }
 
     void setRawEdit(bool rawEdit);
     void setAltitudeMode(QGroundControlQmlGlobal::AltMode altitudeMode);
@@ -170,7 +175,10 @@ private slots:
 private:
     void _connectSignals        (void);
     void _setupMetaData         (void);
+    void _createEditFacts       (void);
     void _updateOptionalSections(void);
+    void _createOptionalSections(void);
+    void _applyFlightStatusToSections(void);
     void _rebuildNaNFacts       (void);
     void _rebuildComboBoxFacts  (void);
 
@@ -178,9 +186,13 @@ private:
     bool            _rawEdit =                  false;
     bool            _dirty =                    false;
     bool            _ignoreDirtyChangeSignals = false;
+    bool            _editFactsCreated =         false;
     QGeoCoordinate  _mapCenterHint;
     SpeedSection*   _speedSection =             nullptr;
-    CameraSection*  _cameraSection =             nullptr;
+    CameraSection*  _cameraSection =            nullptr;
+    double          _sectionFlightSpeed =       qQNaN();    ///< Flight status defaults for sections which have not been created yet
+    double          _sectionGimbalYaw =         qQNaN();
+    double          _sectionGimbalPitch =       qQNaN();
 
     bool _syncingHeadingDegreesAndParam4 = false;   ///< true: already in a sync signal, prevents signal loop
 
@@ -39,6 +39,7 @@ StructureScanComplexItem::StructureScanComplexItem(PlanMasterController* masterC
     , _gimbalPitchFact          (settingsGroup, _metaDataMap[gimbalPitchName])
     , _startFromTopFact         (settingsGroup, _metaDataMap[startFromTopName])
     , _entranceAltFact          (settingsGroup, _metaDataMap[_entranceAltName])
+    , _flightPolygonRunner      ([this](const FlightPolygonResult& result) { _flightPolygonBuilt(result); })
 {
     _editorQml = "qrc:/qml/StructureScanEditor.qml";
 
@@ -68,6 +69,8 @@ StructureScanComplexItem::StructureScanComplexItem(PlanMasterController* masterC
     connect(&_structurePolygon, &QGCMapPolygon::countChanged,   this, &StructureScanComplexItem::_updateLastSequenceNumber);
     connect(&_layersFact,       &Fact::valueChanged,            this, &StructureScanComplexItem::_updateLastSequenceNumber);
 
+    // Must be connected ahead of the camera shot and scan distance recalcs which use the perimeter
+    connect(&_flightPolygon,    &QGCMapPolygon::pathChanged,    this, &StructureScanComplexItem::_recalcFlightPolygonPerimeter);
     connect(&_flightPolygon,    &QGCMapPolygon::pathChanged,    this, &StructureScanComplexItem::_flightPathChanged);
 
     connect(_cameraCalc.distanceToSurface(),    &Fact::valueChanged,                this, &StructureScanComplexItem::_rebuildFlightPolygon);
@@ -109,8 +112,13 @@ StructureScanComplexItem::StructureScanComplexItem(PlanMasterController* masterC
     _recalcLayerInfo();
 
     if (!kmlOrShpFile.isEmpty()) {
-        _structurePolygon.loadKMLOrSHPFile(kmlOrShpFile);
-        _structurePolygon.setDirty(false);
+        // Parsed on a worker thread, the item starts out clean once the polygon arrives
+        (void) connect(&_structurePolygon, &QGCMapPolygon::loadKMLOrSHPFileComplete, this, [this]() {
+            _structurePolygon.clearLoadedPolygons();
+            _structurePolygon.setDirty(false);
+            setDirty(false);
+        }, Qt::SingleShotConnection);
+        _structurePolygon.loadKMLOrSHPFileAsync(kmlOrShpFile);
     }
 
     setDirty(false);
@@ -164,6 +172,9 @@ void StructureScanComplexItem::setDirty(bool dirty)
 
 void StructureScanComplexItem::save(QJsonArray&  missionItems)
 {
+    // Save what the user sees, not the geometry from before the last edit
+    waitForRebuild();
+
     QJsonObject saveObject;
 
     // Header
@@ -306,6 +317,8 @@ double StructureScanComplexItem::greatestDistanceTo(const QGeoCoordinate &other)
 
 void StructureScanComplexItem::appendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent)
 {
+    waitForRebuild();
+
     int     seqNum =        _sequenceNumber;
     bool    startFromTop =  _startFromTopFact.rawValue().toBool();
     double  startAltitude = (startFromTop ? _structureHeightFact.rawValue().toDouble() : _scanBottomAltFact.rawValue().toDouble());
@@ -515,6 +528,28 @@ void StructureScanComplexItem::rotateEntryPoint(void)
 
 void StructureScanComplexItem::_rebuildFlightPolygon(void)
 {
+    if (asyncRebuild()) {
+        // Offset the polygon on a worker thread. Everything downstream of the flight polygon (layers, camera shots,
+        // scan distance, flight path segments) hangs off its pathChanged signal and so follows once it is applied.
+        const QList<QGeoCoordinate> vertices    = _structurePolygon.coordinateList();
+        const double                distance    = _cameraCalc.distanceToSurface()->rawValue().toDouble();
+        const quint64               generation  = ++_flightPolygonGeneration;
+        _flightPolygonRunner.submit([vertices, distance, generation]() {
+            FlightPolygonResult result;
+            result.generation = generation;
+            if (!QGCMapPolygon::offsetPolygon(vertices, distance, result.vertices)) {
+                // Same as QGCMapPolygon::offset, which leaves the polygon as is if the offset fails
+                result.vertices = vertices;
+            }
+            result.perimeter = _polygonPerimeter(result.vertices);
+            return result;
+        });
+        return;
+    }
+
+    // Invalidate any background rebuild which is still in flight
+    _flightPolygonGeneration++;
+
     // While this is happening all hell breaks loose signal-wise which can cause a bad vertex reference.
     // So we reset to a safe value first and then double check validity when putting it back
     int savedEntryVertex = _entryVertex;
@@ -533,6 +568,57 @@ void StructureScanComplexItem::_rebuildFlightPolygon(void)
     emit exitCoordinateChanged(exitCoordinate());
 }
 
+void StructureScanComplexItem::_flightPolygonBuilt(const FlightPolygonResult& result)
+{
+    if (result.generation != _flightPolygonGeneration) {
+        // Superseded by a synchronous rebuild
+        return;
+    }
+
+    int savedEntryVertex = _entryVertex;
+    _entryVertex = 0;
+
+    _builtFlightPolygonPerimeter = result.perimeter;
+    _flightPolygon.beginReset();
+    _flightPolygon.clear();
+    _flightPolygon.appendVertices(result.vertices);
+    _flightPolygon.endReset();
+    _builtFlightPolygonPerimeter = -1;
+
+    if (savedEntryVertex >= _flightPolygon.count()) {
+        _entryVertex = 0;
+    } else {
+        _entryVertex = savedEntryVertex;
+    }
+
+    emit coordinateChanged(coordinate());
+    emit exitCoordinateChanged(exitCoordinate());
+}
+
+void StructureScanComplexItem::waitForRebuild(void)
+{
+    _flightPolygonRunner.waitForFinished();
+}
+
+double StructureScanComplexItem::_polygonPerimeter(const QList<QGeoCoordinate>& vertices)
+{
+    double perimeter = 0;
+    for (int i=0; i<vertices.count(); i++) {
+        perimeter += vertices[i].distanceTo(vertices[i + 1 == vertices.count() ? 0 : i + 1]);
+    }
+    return perimeter;
+}
+
+void StructureScanComplexItem::_recalcFlightPolygonPerimeter(void)
+{
+    if (_builtFlightPolygonPerimeter >= 0) {
+        // Already calculated by the background rebuild
+        _flightPolygonPerimeter = _builtFlightPolygonPerimeter;
+    } else {
+        _flightPolygonPerimeter = _polygonPerimeter(_flightPolygon.coordinateList());
+    }
+}
+
 void StructureScanComplexItem::_recalcCameraShots(void)
 {
     double triggerDistance = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
@@ -547,12 +633,7 @@ void StructureScanComplexItem::_recalcCameraShots(void)
     }
 
     // Determine the distance for each polygon traverse
-    double distance = 0;
-    for (int i=0; i<_flightPolygon.count(); i++) {
-        QGeoCoordinate coord1 = _flightPolygon.vertexCoordinate(i);
-        QGeoCoordinate coord2 = _flightPolygon.vertexCoordinate(i + 1 == _flightPolygon.count() ? 0 : i + 1);
-        distance += coord1.distanceTo(coord2);
-    }
+    double distance = _flightPolygonPerimeter;
     if (distance == 0.0) {
         _setCameraShots(0);
         return;
@@ -614,13 +695,7 @@ void StructureScanComplexItem::_recalcScanDistance()
     double scanDistance = 0;
 
     if (_flightPolygon.count() > 2) {
-        QList<QGeoCoordinate> vertices = _flightPolygon.coordinateList();
-        for (int i=0; i<vertices.count() - 1; i++) {
-            scanDistance += vertices[i].distanceTo(vertices[i+1]);
-        }
-        scanDistance += vertices.last().distanceTo(vertices.first());
-
-        scanDistance *= _layersFact.rawValue().toInt();
+        scanDistance = _flightPolygonPerimeter * _layersFact.rawValue().toInt();
 
         double surfaceHeight = qMax(_structureHeightFact.rawValue().toDouble() - _scanBottomAltFact.rawValue().toDouble(), 0.0);
         scanDistance += surfaceHeight;
@@ -15,6 +15,7 @@
 #include "SettingsFact.h"
 #include "QGCMapPolygon.h"
 #include "CameraCalc.h"
+#include "CoalescingJobRunner.h"
 
 #include <QtCore/QLoggingCategory>
 
@@ -69,6 +70,7 @@ public:
     bool    load                (const QJsonObject& complexObject, int sequenceNumber, QString& errorString) final;
     double  greatestDistanceTo  (const QGeoCoordinate &other) const final;
     QString mapVisualQML        (void) const final { return QStringLiteral("StructureScanMapVisual.qml"); }
+    void    waitForRebuild      (void) final;
 
     // Overrides from VisualMissionItem
     bool                dirty                       (void) const final { return _dirty; }
@@ -126,6 +128,7 @@ private slots:
     void _clearInternal                             (void);
     void _updateCoordinateAltitudes                 (void);
     void _rebuildFlightPolygon                      (void);
+    void _recalcFlightPolygonPerimeter              (void);
     void _recalcCameraShots                         (void);
     void _recalcLayerInfo                           (void);
     void _updateLastSequenceNumber                  (void);
@@ -136,8 +139,17 @@ private slots:
     void _updateFlightPathSegmentsDontCallDirectly  (void);
 
 private:
+    struct FlightPolygonResult {
+        QList<QGeoCoordinate>   vertices;
+        double                  perimeter = 0;
+        quint64                 generation = 0;
+    };
+
+    static double _polygonPerimeter(const QList<QGeoCoordinate>& vertices);
+
     void    _setCameraShots                 (int cameraShots);
     double  _triggerDistance                (void) const;
+    void    _flightPolygonBuilt             (const FlightPolygonResult& result);
 
     QMap<QString, FactMetaData*> _metaDataMap;
 
@@ -160,6 +172,11 @@ private:
     SettingsFact    _startFromTopFact;
     SettingsFact    _entranceAltFact;
 
+    CoalescingJobRunner<FlightPolygonResult>    _flightPolygonRunner;
+    quint64                                     _flightPolygonGeneration = 0;
+    double                                      _flightPolygonPerimeter = 0;
+    double                                      _builtFlightPolygonPerimeter = -1;  ///< Worker computed perimeter while a background result is applied
+
     static constexpr const char* _jsonCameraCalcKey =          "CameraCalc";
 
     static constexpr const char* _entranceAltName = "EntranceAltitude"; // This value cannot be overriden
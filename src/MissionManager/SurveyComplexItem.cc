@@ -62,8 +62,13 @@ SurveyComplexItem::SurveyComplexItem(PlanMasterController* masterController, boo
     connect(&_surveyAreaPolygon,        &QGCMapPolygon::traceModeChanged,           this, &SurveyComplexItem::_updateWizardMode);
 
     if (!kmlOrShpFile.isEmpty()) {
-        _surveyAreaPolygon.loadKMLOrSHPFile(kmlOrShpFile);
-        _surveyAreaPolygon.setDirty(false);
+        // Parsed on a worker thread, the item starts out clean once the polygon arrives
+        (void) connect(&_surveyAreaPolygon, &QGCMapPolygon::loadKMLOrSHPFileComplete, this, [this]() {
+            _surveyAreaPolygon.clearLoadedPolygons();
+            _surveyAreaPolygon.setDirty(false);
+            setDirty(false);
+        }, Qt::SingleShotConnection);
+        _surveyAreaPolygon.loadKMLOrSHPFileAsync(kmlOrShpFile);
     }
     setDirty(false);
 }
@@ -595,6 +600,18 @@ void SurveyComplexItem::_adjustLineDirection(const QList<QLineF>& lineList, QLis
     }
 }
 
+/// Flattens the line end points into a single list (p1, p2, p1, p2, ...) so they can be converted to geo in one batch
+QList<QPointF> SurveyComplexItem::_linePoints(const QList<QLineF>& lineList)
+{
+    QList<QPointF> points;
+    points.reserve(lineList.count() * 2);
+    for (const QLineF& line : lineList) {
+        points.append(line.p1());
+        points.append(line.p2());
+    }
+    return points;
+}
+
 double SurveyComplexItem::_clampGridAngle90(double gridAngle)
 {
     // Clamp grid angle to -90<->90. This prevents transects from being rotated to a reversed order.
@@ -654,20 +671,12 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
 
     // Convert polygon to NED
 
-    QList<QPointF> polygonPoints;
     QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
     qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
-        double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
-        if (i == 0) {
-            // This avoids a nan calculation that comes out of convertGeoToNed
-            x = y = 0;
-        } else {
-            QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
-        }
-        polygonPoints += QPointF(x, y);
-        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
+    const QList<QGeoCoordinate> polygonCoords = _surveyAreaPolygon.coordinateList();
+    const QList<QPointF> polygonPoints = QGCGeo::convertGeoToNed(polygonCoords, tangentOrigin);
+    for (int i=0; i<polygonPoints.count(); i++) {
+        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << polygonCoords[i] << polygonPoints[i].x() << polygonPoints[i].y();
     }
 
     // Generate transects
@@ -751,16 +760,9 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
 
     // Convert from NED to Geo
     QList<QList<QGeoCoordinate>> transects;
-    for (const QLineF& line : resultLines) {
-        QGeoCoordinate          coord;
-        QList<QGeoCoordinate>   transect;
-
-        QGCGeo::convertNedToGeo(line.p1().y(), line.p1().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-        QGCGeo::convertNedToGeo(line.p2().y(), line.p2().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-
-        transects.append(transect);
+    const QList<QGeoCoordinate> transectCoords = QGCGeo::convertNedToGeo(_linePoints(resultLines), tangentOrigin);
+    for (int i=0; i<transectCoords.count(); i+=2) {
+        transects.append(QList<QGeoCoordinate>({ transectCoords[i], transectCoords[i + 1] }));
     }
 
     _adjustTransectsToEntryPointLocation(transects);
@@ -873,20 +875,12 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSplitPolygons(bool refly)
 
     // Convert polygon to NED
 
-    QList<QPointF> polygonPoints;
     QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
     qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
-        double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
-        if (i == 0) {
-            // This avoids a nan calculation that comes out of convertGeoToNed
-            x = y = 0;
-        } else {
-            convertGeoToNed(vertex, tangentOrigin, y, x, down);
-        }
-        polygonPoints += QPointF(x, y);
-        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
+    const QList<QGeoCoordinate> polygonCoords = _surveyAreaPolygon.coordinateList();
+    const QList<QPointF> polygonPoints = QGCGeo::convertGeoToNed(polygonCoords, tangentOrigin);
+    for (int i=0; i<polygonPoints.count(); i++) {
+        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << polygonCoords[i] << polygonPoints[i].x() << polygonPoints[i].y();
     }
 
     // convert into QPolygonF
@@ -1158,16 +1152,9 @@ void SurveyComplexItem::_rebuildTransectsFromPolygon(bool refly, const QPolygonF
         transects.append(transect);
     }
 
-    for (const QLineF& line: resultLines) {
-        QList<QGeoCoordinate>   transect;
-        QGeoCoordinate          coord;
-
-        QGCGeo::convertNedToGeo(line.p1().y(), line.p1().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-        QGCGeo::convertNedToGeo(line.p2().y(), line.p2().x(), 0, tangentOrigin, coord);
-        transect.append(coord);
-
-        transects.append(transect);
+    const QList<QGeoCoordinate> transectCoords = QGCGeo::convertNedToGeo(_linePoints(resultLines), tangentOrigin);
+    for (int i=0; i<transectCoords.count(); i+=2) {
+        transects.append(QList<QGeoCoordinate>({ transectCoords[i], transectCoords[i + 1] }));
     }
 
     _adjustTransectsToEntryPointLocation(transects);
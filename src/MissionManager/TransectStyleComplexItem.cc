@@ -388,12 +388,30 @@ void TransectStyleComplexItem::_rebuildTransects(void)
         return;
     }
 
+    if (asyncRebuild() && _rebuildTransectsAsync()) {
+        // _applyTransects will complete the rebuild
+        return;
+    }
+
     _transects.clear();
     _rgPathHeightInfo.clear();
     _rgFlightPathCoordInfo.clear();
 
     _rebuildTransectsPhase1();
+    _rebuildTransectsPhase2();
+}
+
+void TransectStyleComplexItem::_applyTransects(const QList<QList<CoordInfo_t>>& transects)
+{
+    _transects = transects;
+    _rgPathHeightInfo.clear();
+    _rgFlightPathCoordInfo.clear();
+
+    _rebuildTransectsPhase2();
+}
 
+void TransectStyleComplexItem::_rebuildTransectsPhase2(void)
+{
     _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
 
     switch (_cameraCalc.distanceMode()) {
@@ -1108,6 +1126,8 @@ void TransectStyleComplexItem::_handleHoverAndCaptureEnabled(QVariant enabled)
 
 void TransectStyleComplexItem::appendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent)
 {
+    waitForRebuild();
+
     if (_loadedMissionItems.count()) {
         // We have mission items from the loaded plan, use those
         _appendLoadedMissionItems(items, missionItemParent);
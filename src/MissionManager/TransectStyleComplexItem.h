@@ -136,6 +136,14 @@ protected slots:
 
 protected:
     virtual void _rebuildTransectsPhase1    (void) = 0; ///< Rebuilds the _transects array
+
+    /// Called instead of _rebuildTransectsPhase1 when asyncRebuild is on. Derived classes which support background
+    /// rebuilds start the work here and call _applyTransects once the new transects are available.
+    /// @return false: Background rebuild not supported, _rebuildTransectsPhase1 is called instead
+    virtual bool _rebuildTransectsAsync     (void) { return false; }
+
+    /// Replaces _transects with the results of a background rebuild and completes the rebuild
+    void    _applyTransects                 (const QList<QList<CoordInfo_t>>& transects);
     virtual void _recalcCameraShots         (void) = 0;
 
     void    _save                           (QJsonObject& saveObject);
@@ -227,6 +235,7 @@ private:
         bool useConditionGate;
     } BuildMissionItemsState_t;
 
+    void    _rebuildTransectsPhase2                                         (void);
     void    _queryTransectsPathHeightInfo                                   (void);
     void    _queryMissionItemCoordHeights                                   (void);
     void    _adjustForAvailableTerrainData                                  (void);
@@ -29,6 +29,10 @@ Rectangle {
     property var    _vehicle:                   QGroundControl.multiVehicleManager.activeVehicle ? QGroundControl.multiVehicleManager.activeVehicle : QGroundControl.multiVehicleManager.offlineEditingVehicle
     property real   _cameraMinTriggerInterval:  missionItem.cameraCalc.minTriggerInterval.rawValue
 
+    // Rebuild the flight polygon in the background while the editor is open so slider drags stay responsive
+    Component.onCompleted:      missionItem.asyncRebuild = true
+    Component.onDestruction:    missionItem.asyncRebuild = false
+
     function polygonCaptureStarted() {
         missionItem.clearPolygon()
     }
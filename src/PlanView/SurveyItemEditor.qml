@@ -25,6 +25,7 @@ TransectStyleComplexItemEditor {
 
     property real   _margin:        ScreenTools.defaultFontPixelWidth / 2
     property var    _missionItem:   missionItem
+    property string _shapeFile                      ///< File the user may still pick another polygon from
 
     Component {
         id: _transectValuesComponent
@@ -101,12 +102,45 @@ TransectStyleComplexItemEditor {
         }
     }
 
+    Connections {
+        target: missionItem.surveyAreaPolygon
+
+        function onLoadKMLOrSHPFileComplete(success, polygonCount) {
+            if (success && polygonCount > 1 && _shapeFile !== "") {
+                shapeSelectDialogComponent.createObject(mainWindow, { shapeCount: polygonCount }).open()
+                return
+            }
+            _shapeFile = ""
+            missionItem.surveyAreaPolygon.clearLoadedPolygons()
+        }
+    }
+
+    Component {
+        id: shapeSelectDialogComponent
+
+        ShapeFileSelectDialog {
+            onShapeSelected: (shapeIndex) => {
+                _shapeFile = ""
+                if (shapeIndex !== 0) {
+                    missionItem.surveyAreaPolygon.selectLoadedPolygon(shapeIndex)
+                } else {
+                    missionItem.surveyAreaPolygon.clearLoadedPolygons()
+                }
+            }
+            onRejected: {
+                _shapeFile = ""
+                missionItem.surveyAreaPolygon.clearLoadedPolygons()
+            }
+        }
+    }
+
     KMLOrSHPFileDialog {
         id:             kmlOrSHPLoadDialog
         title:          qsTr("Select Polygon File")
 
         onAcceptedForLoad: (file) => {
-            missionItem.surveyAreaPolygon.loadKMLOrSHPFile(file)
+            _shapeFile = file
+            missionItem.surveyAreaPolygon.loadKMLOrSHPFileAsync(file, 0)
             missionItem.resetState = false
             //editorMap.mapFitFunctions.fitMapViewportTomissionItems()
             close()
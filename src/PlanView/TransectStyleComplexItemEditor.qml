@@ -35,6 +35,10 @@ Rectangle {
     property string _doneAdjusting:             qsTr("Done")
     property bool   _presetsAvailable:          _missionItem.presetNames.length !== 0
 
+    // Rebuild the transects in the background while the editor is open so slider drags stay responsive
+    Component.onCompleted:      _missionItem.asyncRebuild = true
+    Component.onDestruction:    _missionItem.asyncRebuild = false
+
     function polygonCaptureStarted() {
         _missionItem.clearPolygon()
     }
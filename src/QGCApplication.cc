@@ -646,8 +646,9 @@ void QGCApplication::CompressedSignalList::add(const QMetaMethod & method)
     const QMetaObject*  metaObject  = method.enclosingMetaObject();
     int                 signalIndex = _signalIndex(method);
 
-    if (signalIndex != -1 && !contains(metaObject, signalIndex)) {
-        _signalMap[method.enclosingMetaObject()].insert(signalIndex);
+    if (signalIndex != -1) {
+        QWriteLocker locker(&_lock);
+        _signalMap[metaObject].insert(signalIndex);
     }
 }
 
@@ -656,17 +657,30 @@ void QGCApplication::CompressedSignalList::remove(const QMetaMethod & method)
     const int signalIndex = _signalIndex(method);
     const QMetaObject*  metaObject  = method.enclosingMetaObject();
 
-    if (signalIndex != -1 && _signalMap.contains(metaObject) && _signalMap[metaObject].contains(signalIndex)) {
-        _signalMap[metaObject].remove(signalIndex);
-        if (_signalMap[metaObject].count() == 0) {
-            _signalMap.remove(metaObject);
+    QWriteLocker locker(&_lock);
+    auto it = _signalMap.find(metaObject);
+    if (signalIndex != -1 && it != _signalMap.end() && it->remove(signalIndex)) {
+        if (it->isEmpty()) {
+            _signalMap.erase(it);
         }
     }
 }
 
-bool QGCApplication::CompressedSignalList::contains(const QMetaObject* metaObject, int signalIndex)
+bool QGCApplication::CompressedSignalList::contains(const QMetaObject* metaObject, int signalIndex) const
 {
-    return _signalMap.contains(metaObject) && _signalMap[metaObject].contains(signalIndex);
+    QReadLocker locker(&_lock);
+    if (_signalMap.isEmpty()) {
+        return false;
+    }
+
+    // Signal indices count the signals of the base classes as well, so a signal has the same index in every subclass
+    for (; metaObject; metaObject = metaObject->superClass()) {
+        const auto it = _signalMap.constFind(metaObject);
+        if (it != _signalMap.constEnd() && it->contains(signalIndex)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void QGCApplication::addCompressedSignal(const QMetaMethod & method)
@@ -677,6 +691,21 @@ void QGCApplication::addCompressedSignal(const QMetaMethod & method)
 void QGCApplication::removeCompressedSignal(const QMetaMethod & method)
 {
     _compressedSignals.remove(method);
+
+    QMutexLocker locker(&_pendingCallMutex);
+    _pendingCallIndex.clear();
+}
+
+QGCApplication::CompressedSignalStats QGCApplication::compressedSignalStats(void) const
+{
+    QMutexLocker locker(&_pendingCallMutex);
+    return _compressedSignalStats;
+}
+
+void QGCApplication::resetCompressedSignalStats(void)
+{
+    QMutexLocker locker(&_pendingCallMutex);
+    _compressedSignalStats = CompressedSignalStats();
 }
 
 bool QGCApplication::compressEvent(QEvent*event, QObject* receiver, QPostEventList* postedEvents)
@@ -690,32 +719,67 @@ bool QGCApplication::compressEvent(QEvent*event, QObject* receiver, QPostEventLi
         return QApplication::compressEvent(event, receiver, postedEvents);
     }
 
-    for (QPostEventList::iterator it = postedEvents->begin(); it != postedEvents->end(); ++it) {
-        QPostEvent &cur = *it;
-        if (cur.receiver != receiver || cur.event == 0 || cur.event->type() != event->type()) {
-            continue;
+    const PendingCallKey key = { receiver, mce->sender(), mce->signalId(), mce->id() };
+    const auto isPendingCall = [&key](const QPostEvent &cur) {
+        if (cur.receiver != key.receiver || cur.event == 0 || cur.event->type() != QEvent::MetaCall) {
+            return false;
         }
         const QMetaCallEvent *cur_mce = static_cast<QMetaCallEvent*>(cur.event);
-        if (cur_mce->sender() != mce->sender() || cur_mce->signalId() != mce->signalId() || cur_mce->id() != mce->id()) {
-            continue;
-        }
-        /* Keep The Newest Call */
-        // We can't merely qSwap the existing posted event with the new one, since QEvent
-        // keeps track of whether it has been posted. Deletion of a formerly posted event
-        // takes the posted event list mutex and does a useless search of the posted event
-        // list upon deletion. We thus clear the QEvent::posted flag before deletion.
-        struct EventHelper : private QEvent {
-            static void clearPostedFlag(QEvent * ev) {
-                (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+        return cur_mce->sender() == key.sender && cur_mce->signalId() == key.signalId && cur_mce->id() == key.slotId;
+    };
+
+    // Called with the posted events of the receiver's thread locked, but events for other threads are posted concurrently
+    QMutexLocker locker(&_pendingCallMutex);
+    _compressedSignalStats.queued++;
+
+    qsizetype index = -1;
+    const auto hint = _pendingCallIndex.constFind(key);
+    if (hint == _pendingCallIndex.constEnd()) {
+        // Not seen since the index was cleared, the call may be anywhere in the posted events
+        _compressedSignalStats.scans++;
+        for (qsizetype i = 0; i < postedEvents->size(); i++) {
+            if (isPendingCall(postedEvents->at(i))) {
+                index = i;
+                break;
             }
-        };
-        EventHelper::clearPostedFlag(cur.event);
-        delete cur.event;
-        cur.event = event;
-        return true;
+        }
+    } else if (hint.value() < postedEvents->size() && isPendingCall(postedEvents->at(hint.value()))) {
+        index = hint.value();
+        _compressedSignalStats.indexHits++;
+    } else {
+        // The call the hint pointed at was delivered, or moved when delivered events were removed. It is dropped
+        // without scanning: at worst one call goes through uncompressed and the new entry is used from then on.
+        (void) _pendingCallIndex.erase(hint);
     }
 
-    return false;
+    if (index < 0) {
+        // Nothing to replace, the call is appended to the posted events. Keys of receivers which are long gone pile
+        // up, hence the occasional clear.
+        if (_pendingCallIndex.size() >= _maxPendingCallIndex) {
+            _pendingCallIndex.clear();
+        }
+        _pendingCallIndex.insert(key, postedEvents->size());
+        return false;
+    }
+    _pendingCallIndex.insert(key, index);
+
+    /* Keep The Newest Call */
+    // We can't merely qSwap the existing posted event with the new one, since QEvent
+    // keeps track of whether it has been posted. Deletion of a formerly posted event
+    // takes the posted event list mutex and does a useless search of the posted event
+    // list upon deletion. We thus clear the QEvent::posted flag before deletion.
+    struct EventHelper : private QEvent {
+        static void clearPostedFlag(QEvent * ev) {
+            (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+        }
+    };
+    QPostEvent &cur = (*postedEvents)[index];
+    EventHelper::clearPostedFlag(cur.event);
+    delete cur.event;
+    cur.event = event;
+    _compressedSignalStats.coalesced++;
+
+    return true;
 }
 
 bool QGCApplication::event(QEvent *e)
@@ -12,7 +12,10 @@
 #include <QtWidgets/QApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
 #include <QtCore/QEvent>
 #include <QtCore/QMetaMethod>
@@ -89,10 +92,22 @@ public:
     QString         bigSizeMBToString(quint64 size_MB);
 
     /// Registers the signal such that only the last duplicate signal added is left in the queue.
+    /// Duplicates are queued calls from the same sender to the same receiver, the latest value wins and is delivered
+    /// in place of the first one. Also applies to the signal emitted by subclasses of the class declaring it.
     void addCompressedSignal(const QMetaMethod & method);
 
     void removeCompressedSignal(const QMetaMethod & method);
 
+    struct CompressedSignalStats {
+        quint64 queued      = 0;    ///< Calls of compressed signals posted while their receiver had events pending
+        quint64 coalesced   = 0;    ///< Calls replaced by a later one, never delivered
+        quint64 indexHits   = 0;    ///< Pending calls found without scanning the posted events
+        quint64 scans       = 0;    ///< Lookups which scanned the posted events, only for calls without an index entry
+    };
+
+    CompressedSignalStats compressedSignalStats(void) const;
+    void resetCompressedSignalStats(void);
+
     bool event(QEvent *e) override;
 
     static QString cachedParameterMetaDataFile(void);
@@ -184,16 +199,35 @@ private:
 
         void add        (const QMetaMethod & method);
         void remove     (const QMetaMethod & method);
-        bool contains   (const QMetaObject * metaObject, int signalIndex);
+        bool contains   (const QMetaObject * metaObject, int signalIndex) const;
 
     private:
         static int _signalIndex(const QMetaMethod & method);
 
-        QMap<const QMetaObject*, QSet<int> > _signalMap;
+        mutable QReadWriteLock                  _lock;  ///< Events are posted from any thread
+        QHash<const QMetaObject*, QSet<int> >   _signalMap;
     };
 
     CompressedSignalList _compressedSignals;
 
+    /// Identifies the queued calls a compressed call replaces
+    struct PendingCallKey {
+        const QObject*  receiver;
+        const QObject*  sender;
+        int             signalId;
+        int             slotId;
+
+        bool operator==(const PendingCallKey& other) const { return (receiver == other.receiver) && (sender == other.sender) && (signalId == other.signalId) && (slotId == other.slotId); }
+        friend size_t qHash(const PendingCallKey& key, size_t seed = 0) { return qHashMulti(seed, key.receiver, key.sender, key.signalId, key.slotId); }
+    };
+
+    /// Where pending compressed calls were last seen in the posted events. Only a hint: the entry is checked before it
+    /// is used and dropped when it no longer matches. The posted events are only scanned for calls without an entry.
+    QHash<PendingCallKey, qsizetype>    _pendingCallIndex;
+    mutable QMutex                      _pendingCallMutex;
+    CompressedSignalStats               _compressedSignalStats;
+    static constexpr int                _maxPendingCallIndex = 4096;
+
     const QString _settingsVersionKey = QStringLiteral("SettingsVersion"); ///< Settings key which hold settings version
     const QString _deleteAllSettingsKey = QStringLiteral("DeleteAllSettingsNextBoot"); ///< If this settings key is set on boot, all settings will be deleted
 
@@ -49,6 +49,8 @@ void QGCMapPolygon::_init(void)
     connect(this, &QGCMapPolygon::pathChanged,  this, &QGCMapPolygon::_updateCenter);
     connect(this, &QGCMapPolygon::countChanged, this, &QGCMapPolygon::isValidChanged);
     connect(this, &QGCMapPolygon::countChanged, this, &QGCMapPolygon::isEmptyChanged);
+
+    connect(&_loadFileWatcher, &QFutureWatcherBase::finished, this, &QGCMapPolygon::_loadFileFinished);
 }
 
 const QGCMapPolygon& QGCMapPolygon::operator=(const QGCMapPolygon& other)
@@ -398,37 +400,39 @@ QGeoCoordinate QGCMapPolygon::vertexCoordinate(int vertex) const
 
 QList<QPointF> QGCMapPolygon::nedPolygon(void) const
 {
-    QList<QPointF>  nedPolygon;
-
-    if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polygonModel.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
-            if (i == 0) {
-                // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
-            } else {
-                QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
-            }
-            nedPolygon += QPointF(x, y);
-        }
+    if (count() == 0) {
+        return QList<QPointF>();
     }
 
-    return nedPolygon;
+    return QGCGeo::convertGeoToNed(coordinateList(), vertexCoordinate(0));
 }
 
 
 void QGCMapPolygon::offset(double distance)
 {
     QList<QGeoCoordinate> rgNewPolygon;
+    if (!offsetPolygon(coordinateList(), distance, rgNewPolygon)) {
+        // FIXME: Better error handling?
+        qWarning("Intersection failed");
+        return;
+    }
+
+    // Update internals
+    _beginResetIfNotActive();
+    clear();
+    appendVertices(rgNewPolygon);
+    _endResetIfNotActive();
+}
+
+bool QGCMapPolygon::offsetPolygon(const QList<QGeoCoordinate>& vertices, double distance, QList<QGeoCoordinate>& offsetVertices)
+{
+    offsetVertices.clear();
 
     // I'm sure there is some beautiful famous algorithm to do this, but here is a brute force method
 
-    if (count() > 2) {
+    if (vertices.count() > 2) {
         // Convert the polygon to NED
-        QList<QPointF> rgNedVertices = nedPolygon();
+        QList<QPointF> rgNedVertices = QGCGeo::convertGeoToNed(vertices, vertices.first());
 
         // Walk the edges, offsetting by the specified distance
         QList<QLineF> rgOffsetEdges;
@@ -452,33 +456,26 @@ void QGCMapPolygon::offset(double distance)
 
         // Intersect the offset edges to generate new vertices
         QPointF         newVertex;
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
+        QList<QPointF>  rgNewNedVertices;
         for (int i=0; i<rgOffsetEdges.count(); i++) {
             int prevIndex = i == 0 ? rgOffsetEdges.count() - 1 : i - 1;
             auto intersect = rgOffsetEdges[prevIndex].intersects(rgOffsetEdges[i], &newVertex);
             if (intersect == QLineF::NoIntersection) {
-                // FIXME: Better error handling?
-                qWarning("Intersection failed");
-                return;
+                return false;
             }
-            QGeoCoordinate coord;
-            QGCGeo::convertNedToGeo(newVertex.y(), newVertex.x(), 0, tangentOrigin, coord);
-            rgNewPolygon.append(coord);
+            rgNewNedVertices.append(newVertex);
         }
+        offsetVertices = QGCGeo::convertNedToGeo(rgNewNedVertices, vertices.first());
     }
 
-    // Update internals
-    _beginResetIfNotActive();
-    clear();
-    appendVertices(rgNewPolygon);
-    _endResetIfNotActive();
+    return true;
 }
 
-bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
+bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file, int polygonIndex)
 {
     QString errorString;
     QList<QGeoCoordinate> rgCoords;
-    if (!ShapeFileHelper::loadPolygonFromFile(file, rgCoords, errorString)) {
+    if (!ShapeFileHelper::loadPolygonFromFile(file, rgCoords, errorString, polygonIndex, ShapeFileHelper::simplifyToleranceSetting())) {
         qgcApp()->showAppMessage(errorString);
         return false;
     }
@@ -491,6 +488,59 @@ bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
     return true;
 }
 
+void QGCMapPolygon::loadKMLOrSHPFileAsync(const QString& file, int polygonIndex)
+{
+    // Setting a new future drops any load which is still in progress
+    _loadPolygonIndex = polygonIndex;
+    _loadedPolygons.clear();
+    _loadFileWatcher.setFuture(ShapeFileHelper::loadShapesFromFileAsync(file, ShapeFileHelper::Polygon, ShapeFileHelper::simplifyToleranceSetting()));
+}
+
+bool QGCMapPolygon::selectLoadedPolygon(int polygonIndex)
+{
+    if (polygonIndex < 0 || polygonIndex >= _loadedPolygons.count()) {
+        return false;
+    }
+
+    const QList<QGeoCoordinate> vertices = _loadedPolygons[polygonIndex];
+    _loadedPolygons.clear();
+
+    _beginResetIfNotActive();
+    clear();
+    appendVertices(vertices);
+    _endResetIfNotActive();
+
+    return true;
+}
+
+void QGCMapPolygon::_loadFileFinished(void)
+{
+    const ShapeFileHelper::LoadResult result = _loadFileWatcher.result();
+
+    if (!result.errorString.isEmpty()) {
+        qgcApp()->showAppMessage(result.errorString);
+        emit loadKMLOrSHPFileComplete(false, 0);
+        return;
+    }
+    if (_loadPolygonIndex < 0 || _loadPolygonIndex >= result.shapes.count()) {
+        qgcApp()->showAppMessage(tr("Polygon %1 not found. File contains %2 polygons.").arg(_loadPolygonIndex + 1).arg(result.shapes.count()));
+        emit loadKMLOrSHPFileComplete(false, result.shapes.count());
+        return;
+    }
+
+    _beginResetIfNotActive();
+    clear();
+    appendVertices(result.shapes[_loadPolygonIndex]);
+    _endResetIfNotActive();
+
+    // Kept for selectLoadedPolygon, so picking another polygon does not parse the file again
+    if (result.shapes.count() > 1) {
+        _loadedPolygons = result.shapes;
+    }
+
+    emit loadKMLOrSHPFileComplete(true, result.shapes.count());
+}
+
 double QGCMapPolygon::area(void) const
 {
     // https://www.mathopenref.com/coordpolygonarea2.html
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QObject>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtCore/QVariantList>
@@ -16,6 +17,7 @@
 #include <QtXml/QDomElement>
 
 #include "QmlObjectListModel.h"
+#include "ShapeFileHelper.h"
 
 class KMLDomDocument;
 
@@ -66,9 +68,29 @@ public:
     /// Offsets the current polygon edges by the specified distance in meters
     Q_INVOKABLE void offset(double distance);
 
-    /// Loads a polygon from a KML/SH{ file
+    /// Offsets the edges of the specified polygon by the specified distance in meters. Does not touch any object
+    /// state so it is safe to call from a worker thread.
+    ///     @param[out] offsetVertices Offset set of vertices, empty if there are less than 3 vertices
+    /// @return false: Offset edges failed to intersect
+    static bool offsetPolygon(const QList<QGeoCoordinate>& vertices, double distance, QList<QGeoCoordinate>& offsetVertices);
+
+    /// Loads a polygon from a KML/SHP file
+    ///     @param polygonIndex Polygon to use if the file contains more than one
     /// @return true: success
-    Q_INVOKABLE bool loadKMLOrSHPFile(const QString& file);
+    Q_INVOKABLE bool loadKMLOrSHPFile(const QString& file, int polygonIndex = 0);
+
+    /// Loads a polygon from a KML/SHP file on a background thread so large files do not block the ui.
+    /// loadKMLOrSHPFileComplete is signalled when the polygon has been updated.
+    ///     @param polygonIndex Polygon to use if the file contains more than one
+    Q_INVOKABLE void loadKMLOrSHPFileAsync(const QString& file, int polygonIndex = 0);
+
+    /// Switches to another polygon of the file last loaded by loadKMLOrSHPFileAsync without reading it again. The
+    /// polygons of a file holding more than one are kept for this until a polygon is selected or they are cleared.
+    /// @return false: No polygon with that index was kept
+    Q_INVOKABLE bool selectLoadedPolygon(int polygonIndex);
+
+    /// Drops the polygons kept from the last loadKMLOrSHPFileAsync
+    Q_INVOKABLE void clearLoadedPolygons(void) { _loadedPolygons.clear(); }
 
     /// Returns the path in a list of QGeoCoordinate's format
     QList<QGeoCoordinate> coordinateList(void) const;
@@ -144,10 +166,14 @@ signals:
     void showAltColorChanged(bool showAltColor);
     void selectedVertexChanged(int index);
 
+    /// @param polygonCount Number of polygons found in the file
+    void loadKMLOrSHPFileComplete(bool success, int polygonCount);
+
 private slots:
     void _polygonModelCountChanged(int count);
     void _polygonModelDirtyChanged(bool dirty);
     void _updateCenter(void);
+    void _loadFileFinished(void);
 
 private:
     void            _init                   (void);
@@ -168,4 +194,8 @@ private:
     bool                _traceMode =            false;
     bool                _showAltColor =         false;
     int                 _selectedVertexIndex =  -1;
+    int                 _loadPolygonIndex =     0;
+
+    QFutureWatcher<ShapeFileHelper::LoadResult> _loadFileWatcher;
+    QList<QList<QGeoCoordinate>>                _loadedPolygons;
 };
@@ -12,7 +12,6 @@
 #include "JsonHelper.h"
 #include "QGCQGeoCoordinate.h"
 #include "QGCApplication.h"
-#include "KMLHelper.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QLineF>
@@ -58,6 +57,8 @@ void QGCMapPolyline::_init(void)
 
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isValidChanged);
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isEmptyChanged);
+
+    connect(&_loadFileWatcher, &QFutureWatcherBase::finished, this, &QGCMapPolyline::_loadFileFinished);
 }
 
 void QGCMapPolyline::clear(void)
@@ -267,37 +268,28 @@ QGeoCoordinate QGCMapPolyline::vertexCoordinate(int vertex) const
 
 QList<QPointF> QGCMapPolyline::nedPolyline(void)
 {
-    QList<QPointF>  nedPolyline;
-
-    if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polylinePath.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
-            if (i == 0) {
-                // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
-            } else {
-                QGCGeo::convertGeoToNed(vertex, tangentOrigin, y, x, down);
-            }
-            nedPolyline += QPointF(x, y);
-        }
+    if (count() == 0) {
+        return QList<QPointF>();
     }
 
-    return nedPolyline;
+    return QGCGeo::convertGeoToNed(coordinateList(), vertexCoordinate(0));
 }
 
 
 QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
+{
+    return offsetPolyline(coordinateList(), distance);
+}
+
+QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(const QList<QGeoCoordinate>& vertices, double distance)
 {
     QList<QGeoCoordinate> rgNewPolyline;
 
     // I'm sure there is some beautiful famous algorithm to do this, but here is a brute force method
 
-    if (count() > 1) {
+    if (vertices.count() > 1) {
         // Convert the polygon to NED
-        QList<QPointF> rgNedVertices = nedPolyline();
+        QList<QPointF> rgNedVertices = QGCGeo::convertGeoToNed(vertices, vertices.first());
 
         // Walk the edges, offsetting by the specified distance
         QList<QLineF> rgOffsetEdges;
@@ -318,12 +310,9 @@ QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
             rgOffsetEdges.append(offsetEdge);
         }
 
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
         // Add first vertex
-        QGeoCoordinate coord;
-        QGCGeo::convertNedToGeo(rgOffsetEdges[0].p1().y(), rgOffsetEdges[0].p1().x(), 0, tangentOrigin, coord);
-        rgNewPolyline.append(coord);
+        QList<QPointF> rgNewNedVertices;
+        rgNewNedVertices.append(rgOffsetEdges[0].p1());
 
         // Intersect the offset edges to generate new central vertices
         QPointF  newVertex;
@@ -333,38 +322,88 @@ QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
                 // Two lines are colinear
                 newVertex = rgOffsetEdges[i].p2();
             }
-            QGCGeo::convertNedToGeo(newVertex.y(), newVertex.x(), 0, tangentOrigin, coord);
-            rgNewPolyline.append(coord);
+            rgNewNedVertices.append(newVertex);
         }
 
         // Add last vertex
-        int lastIndex = rgOffsetEdges.count() - 1;
-        QGCGeo::convertNedToGeo(rgOffsetEdges[lastIndex].p2().y(), rgOffsetEdges[lastIndex].p2().x(), 0, tangentOrigin, coord);
-        rgNewPolyline.append(coord);
+        rgNewNedVertices.append(rgOffsetEdges.last().p2());
+
+        rgNewPolyline = QGCGeo::convertNedToGeo(rgNewNedVertices, vertices.first());
     }
 
     return rgNewPolyline;
 }
 
-bool QGCMapPolyline::loadKMLFile(const QString& kmlFile)
+bool QGCMapPolyline::loadKMLFile(const QString& kmlFile, int polylineIndex)
 {
-    _beginResetIfNotActive();
-
     QString errorString;
     QList<QGeoCoordinate> rgCoords;
-    if (!KMLHelper::loadPolylineFromFile(kmlFile, rgCoords, errorString)) {
+    if (!ShapeFileHelper::loadPolylineFromFile(kmlFile, rgCoords, errorString, polylineIndex, ShapeFileHelper::simplifyToleranceSetting())) {
         qgcApp()->showAppMessage(errorString);
         return false;
     }
 
+    _beginResetIfNotActive();
     clear();
     appendVertices(rgCoords);
+    _endResetIfNotActive();
+
+    return true;
+}
+
+void QGCMapPolyline::loadKMLFileAsync(const QString& kmlFile, int polylineIndex)
+{
+    // Setting a new future drops any load which is still in progress
+    _loadPolylineIndex = polylineIndex;
+    _loadedPolylines.clear();
+    _loadFileWatcher.setFuture(ShapeFileHelper::loadShapesFromFileAsync(kmlFile, ShapeFileHelper::Polyline, ShapeFileHelper::simplifyToleranceSetting()));
+}
+
+bool QGCMapPolyline::selectLoadedPolyline(int polylineIndex)
+{
+    if (polylineIndex < 0 || polylineIndex >= _loadedPolylines.count()) {
+        return false;
+    }
 
+    const QList<QGeoCoordinate> vertices = _loadedPolylines[polylineIndex];
+    _loadedPolylines.clear();
+
+    _beginResetIfNotActive();
+    clear();
+    appendVertices(vertices);
     _endResetIfNotActive();
 
     return true;
 }
 
+void QGCMapPolyline::_loadFileFinished(void)
+{
+    const ShapeFileHelper::LoadResult result = _loadFileWatcher.result();
+
+    if (!result.errorString.isEmpty()) {
+        qgcApp()->showAppMessage(result.errorString);
+        emit loadKMLFileComplete(false, 0);
+        return;
+    }
+    if (_loadPolylineIndex < 0 || _loadPolylineIndex >= result.shapes.count()) {
+        qgcApp()->showAppMessage(tr("Polyline %1 not found. File contains %2 polylines.").arg(_loadPolylineIndex + 1).arg(result.shapes.count()));
+        emit loadKMLFileComplete(false, result.shapes.count());
+        return;
+    }
+
+    _beginResetIfNotActive();
+    clear();
+    appendVertices(result.shapes[_loadPolylineIndex]);
+    _endResetIfNotActive();
+
+    // Kept for selectLoadedPolyline, so picking another polyline does not parse the file again
+    if (result.shapes.count() > 1) {
+        _loadedPolylines = result.shapes;
+    }
+
+    emit loadKMLFileComplete(true, result.shapes.count());
+}
+
 void QGCMapPolyline::_polylineModelDirtyChanged(bool dirty)
 {
     if (dirty) {
@@ -9,11 +9,13 @@
 
 #pragma once
 
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 #include <QtPositioning/QGeoCoordinate>
 
 #include "QmlObjectListModel.h"
+#include "ShapeFileHelper.h"
 
 class QGCMapPolyline : public QObject
 {
@@ -52,9 +54,28 @@ public:
     /// @return Offset set of vertices
     QList<QGeoCoordinate> offsetPolyline(double distance);
 
+    /// Offsets the edges of the specified polyline by the specified distance in meters. Does not touch any object
+    /// state so it is safe to call from a worker thread.
+    /// @return Offset set of vertices
+    static QList<QGeoCoordinate> offsetPolyline(const QList<QGeoCoordinate>& vertices, double distance);
+
     /// Loads a polyline from a KML file
+    ///     @param polylineIndex Polyline to use if the file contains more than one
     /// @return true: success
-    Q_INVOKABLE bool loadKMLFile(const QString& kmlFile);
+    Q_INVOKABLE bool loadKMLFile(const QString& kmlFile, int polylineIndex = 0);
+
+    /// Loads a polyline from a KML file on a background thread so large files do not block the ui.
+    /// loadKMLFileComplete is signalled when the polyline has been updated.
+    ///     @param polylineIndex Polyline to use if the file contains more than one
+    Q_INVOKABLE void loadKMLFileAsync(const QString& kmlFile, int polylineIndex = 0);
+
+    /// Switches to another polyline of the file last loaded by loadKMLFileAsync without reading it again. The
+    /// polylines of a file holding more than one are kept for this until a polyline is selected or they are cleared.
+    /// @return false: No polyline with that index was kept
+    Q_INVOKABLE bool selectLoadedPolyline(int polylineIndex);
+
+    /// Drops the polylines kept from the last loadKMLFileAsync
+    Q_INVOKABLE void clearLoadedPolylines(void) { _loadedPolylines.clear(); }
 
     Q_INVOKABLE void beginReset (void);
     Q_INVOKABLE void endReset   (void);
@@ -115,9 +136,13 @@ signals:
     void traceModeChanged   (bool traceMode);
     void selectedVertexChanged(int index);
 
+    /// @param polylineCount Number of polylines found in the file
+    void loadKMLFileComplete(bool success, int polylineCount);
+
 private slots:
     void _polylineModelCountChanged(int count);
     void _polylineModelDirtyChanged(bool dirty);
+    void _loadFileFinished(void);
 
 private:
     void            _init                   (void);
@@ -133,4 +158,8 @@ private:
     bool                _resetActive;
     bool                _traceMode = false;
     int                 _selectedVertexIndex = -1;
+    int                 _loadPolylineIndex = 0;
+
+    QFutureWatcher<ShapeFileHelper::LoadResult> _loadFileWatcher;
+    QList<QList<QGeoCoordinate>>                _loadedPolylines;
 };
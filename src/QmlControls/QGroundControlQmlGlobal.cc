@@ -36,6 +36,7 @@
 #include "ScreenToolsController.h"
 #include "QGCMapPalette.h"
 #include "QGCPalette.h"
+#include "QGCProfiler.h"
 #include "QmlObjectListModel.h"
 #include "RCToParamDialogController.h"
 #include "TerrainProfile.h"
@@ -82,6 +83,7 @@ void QGroundControlQmlGlobal::registerQmlTypes()
     qmlRegisterUncreatableType<InstrumentValueData>     ("QGroundControl",                       1, 0, "InstrumentValueData", "Reference only");
     qmlRegisterUncreatableType<QGCGeoBoundingCube>      ("QGroundControl.FlightMap",             1, 0, "QGCGeoBoundingCube",  "Reference only");
     qmlRegisterUncreatableType<QGCMapPolygon>           ("QGroundControl.FlightMap",             1, 0, "QGCMapPolygon",       "Reference only");
+    qmlRegisterUncreatableType<QGCProfiler>             ("QGroundControl",                       1, 0, "QGCProfiler",         "Reference only");
     qmlRegisterUncreatableType<QmlObjectListModel>      ("QGroundControl",                       1, 0, "QmlObjectListModel",  "Reference only");
 
     qmlRegisterType<CustomAction>                       ("QGroundControl.Controllers",           1, 0, "CustomAction");
@@ -116,6 +118,7 @@ QGroundControlQmlGlobal::QGroundControlQmlGlobal(QObject *parent)
     , _settingsManager(SettingsManager::instance())
     , _corePlugin(QGCCorePlugin::instance())
     , _globalPalette(new QGCPalette(this))
+    , _profiler(QGCProfiler::instance())
 #ifndef NO_SERIAL_LINK
     , _gpsRtkFactGroup(GPSManager::instance()->gpsRtk()->gpsRtkFactGroup())
 #endif
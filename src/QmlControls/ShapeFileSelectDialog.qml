@@ -0,0 +1,53 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Dialogs
+import QtQuick.Layouts
+
+import QGroundControl
+import QGroundControl.Controls
+import QGroundControl.ScreenTools
+
+/// Lets the user pick which shape to use when a KML/SHP file contains more than one
+QGCPopupDialog {
+    title:      qsTr("Select Shape")
+    buttons:    Dialog.Ok | Dialog.Cancel
+
+    property int    shapeCount:     0
+    property string shapeName:      qsTr("Polygon")
+
+    signal shapeSelected(int shapeIndex)
+
+    onAccepted: shapeSelected(shapeCombo.currentIndex)
+
+    ColumnLayout {
+        spacing: ScreenTools.defaultFontPixelHeight / 2
+
+        QGCLabel {
+            Layout.preferredWidth:  ScreenTools.defaultFontPixelWidth * 40
+            wrapMode:               Text.WordWrap
+            text:                   qsTr("The file contains %1 shapes. Select the one to use.").arg(shapeCount)
+        }
+
+        QGCComboBox {
+            id:                 shapeCombo
+            Layout.fillWidth:   true
+            sizeToContents:     true
+            model: {
+                var names = []
+                for (var i = 0; i < shapeCount; i++) {
+                    names.push(qsTr("%1 %2").arg(shapeName).arg(i + 1))
+                }
+                return names
+            }
+        }
+    }
+}
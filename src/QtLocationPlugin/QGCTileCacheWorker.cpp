@@ -21,6 +21,7 @@
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
 #include "QGCLoggingCategory.h"
+#include "QGCProfiler.h"
 
 #include <QtCore/QDateTime>
 #include <QtCore/QCoreApplication>
@@ -132,6 +133,8 @@ QGCCacheWorker::run()
 
 void QGCCacheWorker::_runTask(QGCMapTask *task)
 {
+    QGC_PROFILE_SCOPE("QGCCacheWorker::_runTask");
+
     switch (task->type()) {
     case QGCMapTask::taskInit:
         break;
@@ -103,6 +103,12 @@ DECLARE_SETTINGSFACT(VideoSettings, showRecControl)
 DECLARE_SETTINGSFACT(VideoSettings, recordingFormat)
 DECLARE_SETTINGSFACT(VideoSettings, maxVideoSize)
 DECLARE_SETTINGSFACT(VideoSettings, enableStorageLimit)
+DECLARE_SETTINGSFACT(VideoSettings, minFreeStorage)
+DECLARE_SETTINGSFACT(VideoSettings, recordingSegmentDuration)
+DECLARE_SETTINGSFACT(VideoSettings, recordingSegmentSize)
+DECLARE_SETTINGSFACT(VideoSettings, telemetryTrackFormat)
+DECLARE_SETTINGSFACT(VideoSettings, telemetrySubtitleFormat)
+DECLARE_SETTINGSFACT(VideoSettings, telemetryTrackRate)
 DECLARE_SETTINGSFACT(VideoSettings, rtspTimeout)
 DECLARE_SETTINGSFACT(VideoSettings, streamEnabled)
 DECLARE_SETTINGSFACT(VideoSettings, disableWhenDisarmed)
@@ -30,6 +30,12 @@ public:
     DEFINE_SETTINGFACT(recordingFormat)
     DEFINE_SETTINGFACT(maxVideoSize)
     DEFINE_SETTINGFACT(enableStorageLimit)
+    DEFINE_SETTINGFACT(minFreeStorage)
+    DEFINE_SETTINGFACT(recordingSegmentDuration)
+    DEFINE_SETTINGFACT(recordingSegmentSize)
+    DEFINE_SETTINGFACT(telemetryTrackFormat)
+    DEFINE_SETTINGFACT(telemetrySubtitleFormat)
+    DEFINE_SETTINGFACT(telemetryTrackRate)
     DEFINE_SETTINGFACT(rtspTimeout)
     DEFINE_SETTINGFACT(streamEnabled)
     DEFINE_SETTINGFACT(disableWhenDisarmed)
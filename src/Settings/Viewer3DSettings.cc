@@ -19,6 +19,8 @@ DECLARE_SETTINGGROUP(Viewer3D, "Viewer3D")
 DECLARE_SETTINGSFACT(Viewer3DSettings, enabled)
 DECLARE_SETTINGSFACT(Viewer3DSettings, osmFilePath)
 DECLARE_SETTINGSFACT(Viewer3DSettings, buildingLevelHeight)
+DECLARE_SETTINGSFACT(Viewer3DSettings, buildingViewRadius)
+DECLARE_SETTINGSFACT(Viewer3DSettings, terrainElevation)
 DECLARE_SETTINGSFACT(Viewer3DSettings, altitudeBias)
 
 
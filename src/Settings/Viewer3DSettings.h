@@ -24,5 +24,7 @@ public:
     DEFINE_SETTINGFACT(enabled)
     DEFINE_SETTINGFACT(osmFilePath)
     DEFINE_SETTINGFACT(buildingLevelHeight)
+    DEFINE_SETTINGFACT(buildingViewRadius)
+    DEFINE_SETTINGFACT(terrainElevation)
     DEFINE_SETTINGFACT(altitudeBias)
 };
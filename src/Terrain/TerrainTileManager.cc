@@ -17,6 +17,7 @@
 #include "SettingsManager.h"
 #include "FlightMapSettings.h"
 #include "QGCLoggingCategory.h"
+#include "QGCProfiler.h"
 
 #include <QtLocation/private/qgeotilespec_p.h>
 #include <QtNetwork/QNetworkAccessManager>
@@ -54,6 +55,8 @@ TerrainTileManager::~TerrainTileManager()
 
 bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate> &coordinates, QList<double> &altitudes, bool &error)
 {
+    QGC_PROFILE_SCOPE("TerrainTileManager::getAltitudesForCoordinates");
+
     error = false;
 
     const QString elevationProviderName = SettingsManager::instance()->flightMapSettings()->elevationMapProvider()->rawValue().toString();
@@ -216,6 +219,8 @@ void TerrainTileManager::_tileFailed()
 
 void TerrainTileManager::_terrainDone()
 {
+    QGC_PROFILE_SCOPE("TerrainTileManager::_terrainDone");
+
     _state = TerrainQuery::State::Idle;
 
     QGeoTiledMapReplyQGC* const reply = qobject_cast<QGeoTiledMapReplyQGC*>(QObject::sender());
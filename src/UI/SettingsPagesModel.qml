@@ -95,6 +95,13 @@ ListModel {
         pageVisible: function() { return true }
     }
 
+    ListElement {
+        name: qsTr("Profiler")
+        url: "/qml/ProfilerSettings.qml"
+        iconUrl: "qrc:/InstrumentValueIcons/timer.svg"
+        pageVisible: function() { return true }
+    }
+
     ListElement {
         name: qsTr("Help")
         url: "/qml/HelpSettings.qml"
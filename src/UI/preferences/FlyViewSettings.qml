@@ -37,6 +37,8 @@ SettingsPage {
     property Fact   _viewer3DEnabled:                   _viewer3DSettings.enabled
     property Fact   _viewer3DOsmFilePath:               _viewer3DSettings.osmFilePath
     property Fact   _viewer3DBuildingLevelHeight:       _viewer3DSettings.buildingLevelHeight
+    property Fact   _viewer3DBuildingViewRadius:        _viewer3DSettings.buildingViewRadius
+    property Fact   _viewer3DTerrainElevation:          _viewer3DSettings.terrainElevation
     property Fact   _viewer3DAltitudeBias:              _viewer3DSettings.altitudeBias
 
     QGCFileDialogController { id: fileController }
@@ -290,6 +292,22 @@ SettingsPage {
             visible:            _viewer3DBuildingLevelHeight.visible
         }
 
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Buildings View Radius")
+            fact:               _viewer3DBuildingViewRadius
+            enabled:            _viewer3DEnabled.rawValue
+            visible:            _viewer3DBuildingViewRadius.visible
+        }
+
+        FactCheckBoxSlider {
+            Layout.fillWidth:   true
+            text:               qsTr("Terrain Elevation")
+            fact:               _viewer3DTerrainElevation
+            enabled:            _viewer3DEnabled.rawValue
+            visible:            _viewer3DTerrainElevation.visible
+        }
+
         LabelledFactTextField {
             Layout.fillWidth:   true
             label:              qsTr("Vehicles Altitude Bias")
@@ -38,6 +38,13 @@ SettingsPage {
             visible:            fact.visible
         }
 
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("KML/SHP Simplification Tolerance")
+            fact:               _planViewSettings.shapeSimplifyTolerance
+            visible:            fact.visible
+        }
+
         FactCheckBoxSlider {
             Layout.fillWidth:   true
             text:               qsTr("Use MAV_CMD_CONDITION_GATE for pattern generation")
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import QGroundControl
+import QGroundControl.Controls
+import QGroundControl.Palette
+import QGroundControl.ScreenTools
+
+Rectangle {
+    color:          qgcPal.window
+    anchors.fill:   parent
+
+    readonly property real  _margins:   ScreenTools.defaultFontPixelHeight
+    readonly property var   _profiler:  QGroundControl.profiler
+
+    QGCPalette { id: qgcPal; colorGroupEnabled: true }
+
+    Timer {
+        interval:           1000
+        running:            _profiler.enabled
+        repeat:             true
+        triggeredOnStart:   true
+        onTriggered:        _profiler.refresh()
+    }
+
+    QGCFileDialog {
+        id:             exportDialog
+        folder:         QGroundControl.settingsManager.appSettings.logSavePath
+        nameFilters:    [qsTr("Trace files (*.json)"), qsTr("All Files (*)")]
+        defaultSuffix:  "json"
+        title:          qsTr("Select trace save file")
+        onAcceptedForSave: (file) => {
+            if (!_profiler.exportTrace(file)) {
+                mainWindow.showMessageDialog(qsTr("Export Trace"), qsTr("Unable to write %1").arg(file))
+            }
+            close()
+        }
+    }
+
+    ColumnLayout {
+        id:                 header
+        anchors.margins:    _margins
+        anchors.top:        parent.top
+        anchors.left:       parent.left
+        anchors.right:      parent.right
+        spacing:            ScreenTools.defaultFontPixelHeight / 2
+
+        RowLayout {
+            spacing: ScreenTools.defaultFontPixelWidth
+
+            QGCCheckBox {
+                text:       qsTr("Enable profiling")
+                checked:    _profiler.enabled
+                onClicked:  _profiler.enabled = checked
+            }
+
+            QGCButton {
+                text:       qsTr("Reset")
+                onClicked:  _profiler.reset()
+            }
+
+            QGCButton {
+                text:       qsTr("Export Trace")
+                onClicked:  exportDialog.openForSave()
+            }
+        }
+
+        QGCLabel {
+            Layout.fillWidth:   true
+            wrapMode:           Text.WordWrap
+            text:               qsTr("Time spent in instrumented code, per thread. Percentiles are bucket upper bounds. Exported traces open in chrome://tracing or ui.perfetto.dev.")
+        }
+    }
+
+    QGCFlickable {
+        anchors.margins:    _margins
+        anchors.top:        header.bottom
+        anchors.left:       parent.left
+        anchors.right:      parent.right
+        anchors.bottom:     parent.bottom
+        contentWidth:       grid.width
+        contentHeight:      grid.height
+        clip:               true
+
+        GridLayout {
+            id:             grid
+            columns:        8
+            columnSpacing:  ScreenTools.defaultFontPixelWidth * 2
+
+            QGCLabel { text: qsTr("Name") }
+            QGCLabel { text: qsTr("Thread") }
+            QGCLabel { text: qsTr("Count");         Layout.alignment: Qt.AlignRight }
+            QGCLabel { text: qsTr("Total (ms)");    Layout.alignment: Qt.AlignRight }
+            QGCLabel { text: qsTr("Avg (us)");      Layout.alignment: Qt.AlignRight }
+            QGCLabel { text: qsTr("p50 (us)");      Layout.alignment: Qt.AlignRight }
+            QGCLabel { text: qsTr("p95 (us)");      Layout.alignment: Qt.AlignRight }
+            QGCLabel { text: qsTr("Max (us)");      Layout.alignment: Qt.AlignRight }
+
+            Repeater {
+                model: _profiler.summary
+
+                delegate: Repeater {
+                    property var _row: modelData
+
+                    model: [
+                        _row.name,
+                        _row.thread,
+                        _row.count,
+                        _row.totalMsecs.toFixed(1),
+                        _row.avgUsecs.toFixed(1),
+                        _row.p50Usecs.toFixed(1),
+                        _row.p95Usecs.toFixed(1),
+                        _row.maxUsecs.toFixed(1)
+                    ]
+
+                    QGCLabel {
+                        text:               modelData
+                        Layout.alignment:   index > 1 ? Qt.AlignRight : Qt.AlignLeft
+                    }
+                }
+            }
+        }
+    }
+}
@@ -123,6 +123,43 @@ SettingsPage {
             visible:            _videoSettings.recordingFormat.visible
         }
 
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Segment Duration")
+            fact:               _videoSettings.recordingSegmentDuration
+            visible:            fact.visible
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Segment Size")
+            fact:               _videoSettings.recordingSegmentSize
+            visible:            fact.visible
+        }
+
+        LabelledFactComboBox {
+            Layout.fillWidth:   true
+            label:              qsTr("Telemetry Subtitles")
+            fact:               _videoSettings.telemetrySubtitleFormat
+            visible:            fact.visible
+            indexModel:         false
+        }
+
+        LabelledFactComboBox {
+            Layout.fillWidth:   true
+            label:              qsTr("Telemetry Track")
+            fact:               _videoSettings.telemetryTrackFormat
+            visible:            fact.visible
+            indexModel:         false
+        }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Telemetry Track Rate")
+            fact:               _videoSettings.telemetryTrackRate
+            visible:            fact.visible && _videoSettings.telemetryTrackFormat.rawValue !== 0
+        }
+
         FactCheckBoxSlider {
             Layout.fillWidth:   true
             text:               qsTr("Auto-Delete Saved Recordings")
@@ -137,5 +174,13 @@ SettingsPage {
             visible:            fact.visible
             enabled:            _videoSettings.enableStorageLimit.rawValue
         }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Min Free Storage")
+            fact:               _videoSettings.minFreeStorage
+            visible:            fact.visible
+            enabled:            _videoSettings.enableStorageLimit.rawValue
+        }
     }
 }
@@ -91,101 +91,167 @@ ToolIndicatorPage {
     }
 
     expandedComponent: Component {
-        SettingsGroupLayout {
-            heading:        qsTr("RTK GPS Settings")
+        ColumnLayout {
+            spacing: ScreenTools.defaultFontPixelHeight / 2
 
             property real sliderWidth: ScreenTools.defaultFontPixelWidth * 32 // Size is tuned so expanded page fits Herelink screen without horiz scrolling
 
-            FactCheckBoxSlider {
-                Layout.fillWidth:   true
-                text:               qsTr("AutoConnect")
-                fact:               QGroundControl.settingsManager.autoConnectSettings.autoConnectRTKGPS
-                visible:            fact.visible
-            }
+            SettingsGroupLayout {
+                heading:        qsTr("RTK GPS Settings")
 
-            FactCheckBoxSlider {
-                Layout.fillWidth:   true
-                text:               qsTr("Perform Survey-In")
-                fact:               rtkSettings.useFixedBasePosition
-                checkedValue:       false
-                uncheckedValue:     true
-                visible:            rtkSettings.useFixedBasePosition.visible
-            }
+                FactCheckBoxSlider {
+                    Layout.fillWidth:   true
+                    text:               qsTr("AutoConnect")
+                    fact:               QGroundControl.settingsManager.autoConnectSettings.autoConnectRTKGPS
+                    visible:            fact.visible
+                }
 
-            LabelledFactSlider {
-                sliderPreferredWidth:   sliderWidth
-                label:                  rtkSettings.surveyInAccuracyLimit.shortDescription
-                fact:                   QGroundControl.settingsManager.rtkSettings.surveyInAccuracyLimit
-                visible:                rtkSettings.surveyInAccuracyLimit.visible
-                enabled:                !useFixedPosition
+                FactCheckBoxSlider {
+                    Layout.fillWidth:   true
+                    text:               qsTr("Perform Survey-In")
+                    fact:               rtkSettings.useFixedBasePosition
+                    checkedValue:       false
+                    uncheckedValue:     true
+                    visible:            rtkSettings.useFixedBasePosition.visible
+                }
 
-                Component.onCompleted: console.log("increment", fact.increment)
-            }
+                LabelledFactSlider {
+                    sliderPreferredWidth:   sliderWidth
+                    label:                  rtkSettings.surveyInAccuracyLimit.shortDescription
+                    fact:                   QGroundControl.settingsManager.rtkSettings.surveyInAccuracyLimit
+                    visible:                rtkSettings.surveyInAccuracyLimit.visible
+                    enabled:                !useFixedPosition
 
-            LabelledFactSlider {
-                sliderPreferredWidth:   sliderWidth
-                label:                  rtkSettings.surveyInMinObservationDuration.shortDescription
-                fact:                   rtkSettings.surveyInMinObservationDuration
-                visible:                rtkSettings.surveyInMinObservationDuration.visible
-                enabled:                !useFixedPosition
-            }
+                    Component.onCompleted: console.log("increment", fact.increment)
+                }
 
-            FactCheckBoxSlider {
-                Layout.columnSpan:  3
-                Layout.fillWidth:   true
-                text:               qsTr("Use Specified Base Position")
-                fact:               rtkSettings.useFixedBasePosition
-                visible:            rtkSettings.useFixedBasePosition.visible
-            }
+                LabelledFactSlider {
+                    sliderPreferredWidth:   sliderWidth
+                    label:                  rtkSettings.surveyInMinObservationDuration.shortDescription
+                    fact:                   rtkSettings.surveyInMinObservationDuration
+                    visible:                rtkSettings.surveyInMinObservationDuration.visible
+                    enabled:                !useFixedPosition
+                }
 
-            LabelledFactTextField {
-                label:                  rtkSettings.fixedBasePositionLatitude.shortDescription
-                fact:                   rtkSettings.fixedBasePositionLatitude
-                visible:                rtkSettings.fixedBasePositionLatitude.visible
-                enabled:                useFixedPosition
-            }
+                FactCheckBoxSlider {
+                    Layout.columnSpan:  3
+                    Layout.fillWidth:   true
+                    text:               qsTr("Use Specified Base Position")
+                    fact:               rtkSettings.useFixedBasePosition
+                    visible:            rtkSettings.useFixedBasePosition.visible
+                }
 
-            LabelledFactTextField {
-                label:              rtkSettings.fixedBasePositionLongitude.shortDescription
-                fact:               rtkSettings.fixedBasePositionLongitude
-                visible:            rtkSettings.fixedBasePositionLongitude.visible
-                enabled:            useFixedPosition
-            }
+                LabelledFactTextField {
+                    label:                  rtkSettings.fixedBasePositionLatitude.shortDescription
+                    fact:                   rtkSettings.fixedBasePositionLatitude
+                    visible:                rtkSettings.fixedBasePositionLatitude.visible
+                    enabled:                useFixedPosition
+                }
 
-            LabelledFactTextField {
-                label:              rtkSettings.fixedBasePositionAltitude.shortDescription
-                fact:               rtkSettings.fixedBasePositionAltitude
-                visible:            rtkSettings.fixedBasePositionAltitude.visible
-                enabled:            useFixedPosition
-            }
+                LabelledFactTextField {
+                    label:              rtkSettings.fixedBasePositionLongitude.shortDescription
+                    fact:               rtkSettings.fixedBasePositionLongitude
+                    visible:            rtkSettings.fixedBasePositionLongitude.visible
+                    enabled:            useFixedPosition
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.fixedBasePositionAltitude.shortDescription
+                    fact:               rtkSettings.fixedBasePositionAltitude
+                    visible:            rtkSettings.fixedBasePositionAltitude.visible
+                    enabled:            useFixedPosition
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.fixedBasePositionAccuracy.shortDescription
+                    fact:               rtkSettings.fixedBasePositionAccuracy
+                    visible:            rtkSettings.fixedBasePositionAccuracy.visible
+                    enabled:            useFixedPosition
+                }
 
-            LabelledFactTextField {
-                label:              rtkSettings.fixedBasePositionAccuracy.shortDescription
-                fact:               rtkSettings.fixedBasePositionAccuracy
-                visible:            rtkSettings.fixedBasePositionAccuracy.visible
-                enabled:            useFixedPosition
+                RowLayout {
+                    spacing: ScreenTools.defaultFontPixelWidth
+
+                    QGCLabel {
+                        Layout.fillWidth:   true;
+                        text:               qsTr("Current Base Position")
+                        enabled:            saveBasePositionButton.enabled
+                    }
+
+                    QGCButton {
+                        id:         saveBasePositionButton
+                        text:       enabled ? qsTr("Save") : qsTr("Not Yet Valid")
+                        enabled:    QGroundControl.gpsRtk.valid.value
+
+                        onClicked: {
+                            rtkSettings.fixedBasePositionLatitude.rawValue  = QGroundControl.gpsRtk.currentLatitude.rawValue
+                            rtkSettings.fixedBasePositionLongitude.rawValue = QGroundControl.gpsRtk.currentLongitude.rawValue
+                            rtkSettings.fixedBasePositionAltitude.rawValue  = QGroundControl.gpsRtk.currentAltitude.rawValue
+                            rtkSettings.fixedBasePositionAccuracy.rawValue  = QGroundControl.gpsRtk.currentAccuracy.rawValue
+                        }
+                    }
+                }
             }
 
-            RowLayout {
-                spacing: ScreenTools.defaultFontPixelWidth
+            SettingsGroupLayout {
+                heading:    qsTr("NTRIP Corrections")
 
-                QGCLabel {
-                    Layout.fillWidth:   true;
-                    text:               qsTr("Current Base Position")
-                    enabled:            saveBasePositionButton.enabled
+                FactCheckBoxSlider {
+                    Layout.fillWidth:   true
+                    text:               rtkSettings.ntripServerConnectEnabled.shortDescription
+                    fact:               rtkSettings.ntripServerConnectEnabled
+                    visible:            fact.visible
                 }
 
-                QGCButton {
-                    id:         saveBasePositionButton
-                    text:       enabled ? qsTr("Save") : qsTr("Not Yet Valid")
-                    enabled:    QGroundControl.gpsRtk.valid.value
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripServerHostAddress.shortDescription
+                    fact:               rtkSettings.ntripServerHostAddress
+                    visible:            fact.visible
+                }
 
-                    onClicked: {
-                        rtkSettings.fixedBasePositionLatitude.rawValue  = QGroundControl.gpsRtk.currentLatitude.rawValue
-                        rtkSettings.fixedBasePositionLongitude.rawValue = QGroundControl.gpsRtk.currentLongitude.rawValue
-                        rtkSettings.fixedBasePositionAltitude.rawValue  = QGroundControl.gpsRtk.currentAltitude.rawValue
-                        rtkSettings.fixedBasePositionAccuracy.rawValue  = QGroundControl.gpsRtk.currentAccuracy.rawValue
-                    }
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripServerPort.shortDescription
+                    fact:               rtkSettings.ntripServerPort
+                    visible:            fact.visible
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripMountpoint.shortDescription
+                    fact:               rtkSettings.ntripMountpoint
+                    visible:            fact.visible
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripUsername.shortDescription
+                    fact:               rtkSettings.ntripUsername
+                    visible:            fact.visible
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripPassword.shortDescription
+                    fact:               rtkSettings.ntripPassword
+                    visible:            fact.visible
+                    textField.echoMode: TextInput.Password
+                }
+
+                LabelledFactComboBox {
+                    label:              rtkSettings.ntripVersion.shortDescription
+                    fact:               rtkSettings.ntripVersion
+                    indexModel:         false
+                    visible:            fact.visible
+                }
+
+                LabelledFactTextField {
+                    label:              rtkSettings.ntripWhitelist.shortDescription
+                    fact:               rtkSettings.ntripWhitelist
+                    visible:            fact.visible
+                }
+
+                FactCheckBoxSlider {
+                    Layout.fillWidth:   true
+                    text:               rtkSettings.ntripSendGGA.shortDescription
+                    fact:               rtkSettings.ntripSendGGA
+                    visible:            fact.visible
                 }
             }
         }
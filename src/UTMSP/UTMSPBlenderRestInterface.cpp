@@ -24,13 +24,13 @@ QPair<int, std::string> UTMSPBlenderRestInterface::setFlightPlan(const std::stri
     return executeRequest();
 }
 
-QPair<int, std::string> UTMSPBlenderRestInterface::requestTelemetry(const std::string& body)
+bool UTMSPBlenderRestInterface::requestTelemetry(const QByteArray& body, ReplyHandler handler)
 {
-    // Post RID data
+    // Post RID data, without waiting for the reply
     QString target = "/flight_stream/set_telemetry";
-    modifyRequest(target, QNetworkAccessManager::PutOperation, QString::fromStdString(body));
+    modifyRequest(target, QNetworkAccessManager::PutOperation, body);
 
-    return executeRequest();
+    return sendRequest(std::move(handler));
 }
 
 QPair<int, std::string> UTMSPBlenderRestInterface::updateFlightState(const std::string& body, const std::string &flightID)
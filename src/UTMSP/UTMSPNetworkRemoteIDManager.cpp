@@ -10,6 +10,25 @@
 #include "UTMSPNetworkRemoteIDManager.h"
 #include "UTMSPLogger.h"
 
+#include <QtCore/QDateTime>
+#include <QtCore/QLocale>
+
+#include <cmath>
+#include <utility>
+
+namespace {
+
+void appendNumber(QByteArray &out, double value)
+{
+    if (std::isfinite(value)) {
+        out += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    } else {
+        out += "null";
+    }
+}
+
+}
+
 UTMSPNetworkRemoteIDManager::UTMSPNetworkRemoteIDManager(std::shared_ptr<Dispatcher> dispatcher):
     _dispatcher(dispatcher)
 {
@@ -24,6 +43,77 @@ UTMSPNetworkRemoteIDManager::~UTMSPNetworkRemoteIDManager()
 void UTMSPNetworkRemoteIDManager::getCapabilty(const std::string &token)
 {
     setBearerToken(token.c_str());
+
+    // Telemetry starts shortly, have the connection ready by then
+    connectToHost();
+}
+
+void UTMSPNetworkRemoteIDManager::prepareFlight(const std::string &aircraftSerialNumber,
+                                                const std::string &operatorID,
+                                                const std::string &flightID,
+                                                double operatorLatitude,
+                                                double operatorLongitude)
+{
+    json flightDetailsJson;
+    flightDetailsJson["rid_details"]["id"]                      = flightID;
+    flightDetailsJson["rid_details"]["operator_id"]             = operatorID;
+    flightDetailsJson["rid_details"]["operation_description"]   = "Delivery operation, see more details at https://deliveryops.com/operation";
+    flightDetailsJson["eu_classification"]["category"]          = "EUCategoryUndefined";
+    flightDetailsJson["eu_classification"]["class"]             = "EUClassUndefined";
+    flightDetailsJson["uas_id"]["serial_number"]                = aircraftSerialNumber;
+    flightDetailsJson["uas_id"]["registration_number"]          = operatorID;
+    flightDetailsJson["uas_id"]["utm_id"]                       = aircraftSerialNumber; //TODO->Will be taken care as part of registration service integration
+    flightDetailsJson["uas_id"]["specific_session_id"]          = "Unknown";
+    flightDetailsJson["operator_location"]["position"]          = {
+                                                                    {"lng", operatorLongitude},
+                                                                    {"lat", operatorLatitude},
+                                                                    {"accuracy_h", "HAUnknown"},
+                                                                    {"accuracy_v", "VAUnknown"}};
+    flightDetailsJson["operator_location"]["altitude"]          = 0; //TODO-> Will get the operator location
+    flightDetailsJson["operator_location"]["altitude_type"]     = "Takeoff";
+    flightDetailsJson["auth_data"]                              = {
+        {"format", "string"},
+        {"data", 0} //TODO->Needs to be updated
+    };
+    flightDetailsJson["serial_number"]                          = aircraftSerialNumber;
+    flightDetailsJson["registration_number"]                    = operatorID;
+
+    _observationSuffix = "}],\"flight_details\":" + QByteArray::fromStdString(flightDetailsJson.dump()) + "}";
+    _aircraftSerialNumber = aircraftSerialNumber;
+    _operatorID = operatorID;
+    _flightID = flightID;
+    _flightPrepared = true;
+}
+
+QByteArray UTMSPNetworkRemoteIDManager::observation(const TelemetrySample &sample, const QByteArray &timestamp) const
+{
+    // Same members and order as Blender's RIDAircraftState
+    QByteArray state;
+    state.reserve(640 + _observationSuffix.size());
+    state += "{\"current_states\":[{\"timestamp\":{\"value\":\"";
+    state += timestamp;
+    state += "\",\"format\":\"RFC3339\"},\"timestamp_accuracy\":0.0,\"operational_status\":\"Undeclared\",\"position\":{\"lat\":";
+    appendNumber(state, sample.latitude);
+    state += ",\"lng\":";
+    appendNumber(state, sample.longitude);
+    state += ",\"alt\":";
+    appendNumber(state, sample.altitude / 1000);
+    state += ",\"accuracy_h\":\"HAUnknown\",\"accuracy_v\":\"VAUnknown\",\"extrapolated\":true,\"pressure_altitude\":0.0},\"track\":";
+    appendNumber(state, sample.heading);
+    state += ",\"speed\":";
+    appendNumber(state, std::sqrt(sample.velocityX*sample.velocityX + sample.velocityY*sample.velocityY));
+    state += ",\"speed_accuracy\":\"SAUnknown\",\"vertical_speed\":";
+    appendNumber(state, sample.velocityZ);
+    state += ",\"height\":{\"distance\":";
+    appendNumber(state, sample.relativeAltitude);
+    state += ",\"reference\":\"TakeoffLocation\"},\"group_radius\":0.0,\"group_ceiling\":0.0,\"group_floor\":0.0,\"group_count\":1,\"group_time_start\":\"";
+    state += timestamp;
+    state += "\",\"group_time_end\":\"";
+    state += timestamp;
+    state += "\"";
+    state += _observationSuffix;
+
+    return state;
 }
 
 void UTMSPNetworkRemoteIDManager::startTelemetry(const double &latitude,
@@ -38,141 +128,69 @@ void UTMSPNetworkRemoteIDManager::startTelemetry(const double &latitude,
                                                  const std::string &operatorID,
                                                  const std::string &flightID)
 {
-    // Generate RID JSON
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream oss;
-
-    if(_j==0){
-        _initLatitude = latitude;
-        _initLongitude = longitude;
-        _j++;
+    if (!_flightPrepared || (flightID != _flightID) || (operatorID != _operatorID) || (aircraftSerialNumber != _aircraftSerialNumber)) {
+        prepareFlight(aircraftSerialNumber, operatorID, flightID, latitude, longitude);
     }
-    _ridData = {};
-    _ridData.timestamp_accuracy = 0.0;
-    _ridData.position.accuracy_h = "HAUnknown";
-    _ridData.position.accuracy_v = "VAUnknown";
-    _ridData.position.extrpolated = true;
-    _ridData.speed_accuracy = "SAUnknown";
-    _ridData.height.reference = "TakeoffLocation";
-    _ridData.operational_status = "Undeclared";
-    oss << std::put_time(std::gmtime(&now_c), "%FT%T") << "Z";
-    _ridData.timestamp.value     = oss.str();
-    _ridData.timestamp.format    = "RFC3339";
-    _ridData.position.lat        = latitude;
-    _ridData.position.lng        = longitude;
-    _ridData.position.alt        = altitude / 1000;
-    _ridData.track               = heading;
-    _ridData.speed               = std::sqrt(velocityX*velocityX + velocityY*velocityY);
-    _ridData.vertical_speed      = velocityZ;
-    _ridData.height.distance     = relativeAltitude;
-
-    this->_flightDetails.rid_details.id        = flightID;
-    this->_flightDetails.rid_details.operator_id = operatorID;
-    this->_flightDetails.rid_details.operation_description = "Delivery operation, see more details at https://deliveryops.com/operation";
-    this->_flightDetails.eu_classification.category = "EUCategoryUndefined";
-    this->_flightDetails.eu_classification.clasS = "EUClassUndefined";
-    this->_flightDetails.uas_id.serial_number = aircraftSerialNumber;
-    this->_flightDetails.uas_id.registration_number =operatorID;
-    this->_flightDetails.uas_id.utm_id = aircraftSerialNumber; //TODO->Will be taken care as part of registration service integration
-    this->_flightDetails.uas_id.specific_session_id = "Unknown";
-    this->_flightDetails.operator_location_lng = _initLongitude;
-    this->_flightDetails.operator_location_lat = _initLatitude;
-    this->_flightDetails.operator_location_accuracyH ="HAUnknown";
-    this->_flightDetails.operator_location_accuracyV ="VAUnknown";
-    this->_flightDetails.auth_data_format      = "string";
-    this->_flightDetails.auth_data_data        = 0; //TODO->Needs to be updated
-    this->_flightDetails.serial_number         = aircraftSerialNumber;
-    this->_flightDetails.registration_number   = operatorID;
-
-    _flightDetailsJson["rid_details"]["id"]                      = this->_flightDetails.rid_details.id;
-    _flightDetailsJson["rid_details"]["operator_id"]             = this->_flightDetails.rid_details.operator_id;
-    _flightDetailsJson["rid_details"]["operation_description"]   = this->_flightDetails.rid_details.operation_description;
-    _flightDetailsJson["eu_classification"]["category"]          = this->_flightDetails.eu_classification.category;
-    _flightDetailsJson["eu_classification"]["class"]             = this->_flightDetails.eu_classification.clasS;
-    _flightDetailsJson["uas_id"]["serial_number"]                = this->_flightDetails.uas_id.serial_number;
-    _flightDetailsJson["uas_id"]["registration_number"]          = this->_flightDetails.uas_id.registration_number;
-    _flightDetailsJson["uas_id"]["utm_id"]                       = this->_flightDetails.uas_id.utm_id;
-    _flightDetailsJson["uas_id"]["specific_session_id"]          = this->_flightDetails.uas_id.specific_session_id ;
-    _flightDetailsJson["operator_location"]["position"]          = {
-                                                           {"lng",this->_flightDetails.operator_location_lng},
-                                                           {"lat",this->_flightDetails.operator_location_lat},
-                                                           {"accuracy_h",this->_flightDetails.operator_location_accuracyH},
-                                                           {"accuracy_v",this->_flightDetails.operator_location_accuracyV}};
-    _flightDetailsJson["operator_location"]["altitude"]          = 0; //TODO-> Will get the operator location
-    _flightDetailsJson["operator_location"]["altitude_type"]     = "Takeoff";
-    _flightDetailsJson["auth_data"]                              = {
-        {"format",  this->_flightDetails.auth_data_format},
-        {"data", this->_flightDetails.auth_data_data}
-    };
-    _flightDetailsJson["serial_number"]                          = this->_flightDetails.uas_id.serial_number;;
-    _flightDetailsJson["registration_number"]                    = this->_flightDetails.uas_id.registration_number;
-
-    _ridDataJson.clear();
-    _ridDataJson["timestamp"]["value"]            = _ridData.timestamp.value;
-    _ridDataJson["timestamp"]["format"]           = _ridData.timestamp.format;
-    _ridDataJson["timestamp_accuracy"]            = _ridData.timestamp_accuracy;
-    _ridDataJson["operational_status"]            = _ridData.operational_status;
-    _ridDataJson["position"]["lat"]               = _ridData.position.lat;
-    _ridDataJson["position"]["lng"]               = _ridData.position.lng;
-    _ridDataJson["position"]["alt"]               = _ridData.position.alt;
-    _ridDataJson["position"]["accuracy_h"]        = _ridData.position.accuracy_h;
-    _ridDataJson["position"]["accuracy_v"]        = _ridData.position.accuracy_v;
-    _ridDataJson["position"]["extrapolated"]      = _ridData.position.extrpolated;
-    _ridDataJson["position"]["pressure_altitude"] = _ridData.position.pressure_altitude;
-    _ridDataJson["track"]                         = _ridData.track;
-    _ridDataJson["speed"]                         = _ridData.speed;
-    _ridDataJson["speed_accuracy"]                = _ridData.speed_accuracy;
-    _ridDataJson["vertical_speed"]                = _ridData.vertical_speed;
-    _ridDataJson["height"]["distance"]            = _ridData.height.distance;
-    _ridDataJson["height"]["reference"]           = _ridData.height.reference ;
-    _ridDataJson["group_radius"]                  = _ridData.group_radius;
-    _ridDataJson["group_ceiling"]                 = _ridData.group_ceiling;
-    _ridDataJson["group_floor"]                   = _ridData.group_floor;
-    _ridDataJson["group_count"]                   = 1;
-    _ridDataJson["group_time_start"]              = _ridData.timestamp.value;
-    _ridDataJson["group_time_end"]                = _ridData.timestamp.value;
-
-    json current_states = json::array();
-    current_states.push_back(_ridDataJson);
-    json mix;
-    mix["current_states"] = current_states;
-    mix["flight_details"] = _flightDetailsJson;
-    json final_array = json::array();
-    final_array.push_back(mix);
-    json final_format;
-    final_format["observations"] = final_array;
-    json data = final_format;
-
-    auto [statusCode, response] = requestTelemetry(data.dump(4));
-    _statusCode = statusCode;
-    _response = response;
-    UTMSP_LOG_DEBUG()<< "Response " << _response;
-    UTMSP_LOG_DEBUG()<< "Status Code: " << _statusCode;
-
-    if(_statusCode == 201)
-    {
-        try {
-            auto now = std::chrono::system_clock::now();
-            std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-            char buffer[20];
-            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&now_c));
-            UTMSP_LOG_DEBUG() <<"The Telemetry RID data submitted at " << buffer;
-            UTMSP_LOG_DEBUG() << "--------------Telemetry Submitted Successfully---------------";
-        }
-        catch (const json::parse_error& e) {
-            UTMSP_LOG_ERROR() << "UTMSPNetworkRemoteManager: Error parsing the Telemetry response: " << e.what();
-        }
+
+    TelemetrySample sample;
+    sample.latitude         = latitude;
+    sample.longitude        = longitude;
+    sample.altitude         = altitude;
+    sample.heading          = heading;
+    sample.velocityX        = velocityX;
+    sample.velocityY        = velocityY;
+    sample.velocityZ        = velocityZ;
+    sample.relativeAltitude = relativeAltitude;
+
+    // Generate RID JSON
+    const QByteArray timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toLatin1();
+    _pendingObservations.append(observation(sample, timestamp));
+    if (_pendingObservations.count() > kMaxBatchObservations) {
+        _pendingObservations.removeFirst();
+        _droppedObservations++;
+        UTMSP_LOG_WARNING() << "UTMSPNetworkRemoteManager: Server is falling behind, oldest observation dropped";
     }
-    else
-    {
-        UTMSP_LOG_ERROR() << "UTMSPNetworkRemoteManager: Invalid Status Code";
+
+    _sendTelemetry();
+}
+
+void UTMSPNetworkRemoteIDManager::_sendTelemetry()
+{
+    if (_telemetryInFlight || _pendingObservations.isEmpty()) {
+        return;
     }
 
+    const QList<QByteArray> batch = std::exchange(_pendingObservations, QList<QByteArray>());
+    const QByteArray body = "{\"observations\":[" + batch.join(',') + "]}";
+    const qsizetype observationCount = batch.count();
+    _telemetryInFlight = true;
+    const bool queued = requestTelemetry(body, [this, observationCount](int statusCode, const QByteArray &response) {
+        _telemetryInFlight = false;
+        UTMSP_LOG_DEBUG() << "Response " << response;
+        UTMSP_LOG_DEBUG() << "Status Code: " << statusCode;
+
+        if (statusCode == 201) {
+            UTMSP_LOG_DEBUG() << "The Telemetry RID data submitted at " << QDateTime::currentDateTime().toString(QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+            UTMSP_LOG_DEBUG() << "--------------Telemetry Submitted Successfully---------------" << observationCount << "observations";
+        } else {
+            UTMSP_LOG_ERROR() << "UTMSPNetworkRemoteManager: Invalid Status Code" << statusCode;
+        }
+
+        // Observations made while this batch was in flight
+        _sendTelemetry();
+    });
+
+    // Left pending on a full send queue, to go out with the next observation
+    if (!queued) {
+        _telemetryInFlight = false;
+        _pendingObservations = batch + _pendingObservations;
+    }
 }
 
 bool UTMSPNetworkRemoteIDManager::stopTelemetry()
 {
+    // Observations still pending go out, the next flight starts with its own flight details
+    _flightPrepared = false;
     UTMSP_LOG_INFO() << "--------------Telemetry Stopped Successfully---------------";
 
     return true;
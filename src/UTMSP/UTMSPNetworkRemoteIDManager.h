@@ -19,6 +19,11 @@ class Dispatcher;
 
 using json = nlohmann::ordered_json;
 
+/// Network Remote ID: streams the vehicle position to the Blender flight stream.
+///
+/// The flight details are the same for every observation of a flight, they are serialized once when the flight
+/// starts. Observations are sent without waiting for the reply. Only one telemetry request is in flight at a time;
+/// observations made meanwhile are batched into the next request, the oldest dropped past kMaxBatchObservations.
 class UTMSPNetworkRemoteIDManager:public UTMSPBlenderRestInterface
 {
 public:
@@ -39,86 +44,44 @@ public:
                         const std::string& flightID);
     bool stopTelemetry();
 
-    struct Rid_details{
-        std::string   id;
-        std::string   operator_id;
-        std::string   operation_description;
+    struct TelemetrySample {
+        double latitude         = 0;
+        double longitude        = 0;
+        double altitude         = 0;
+        double heading          = 0;
+        double velocityX        = 0;
+        double velocityY        = 0;
+        double velocityZ        = 0;
+        double relativeAltitude = 0;
     };
 
-    struct Eu_classification{
-        std::string category;
-        std::string clasS;
-    };
-
-    struct Uas_id{
-        std::string   serial_number;
-        std::string   registration_number;
-        std::string   utm_id;
-        std::string   specific_session_id;
-    };
+    /// Serializes the flight details of a flight, the operator location is where the flight started
+    void prepareFlight(const std::string& aircraftSerialNumber,
+                       const std::string& operatorID,
+                       const std::string& flightID,
+                       double operatorLatitude,
+                       double operatorLongitude);
 
-    struct FlightDetails
-    {
-        Rid_details       rid_details;
-        Eu_classification eu_classification;
-        Uas_id            uas_id;
-        double            operator_location_lng;
-        double            operator_location_lat;
-        std::string       operator_location_accuracyH;
-        std::string       operator_location_accuracyV;
-        std::string       auth_data_format;
-        int               auth_data_data;
-        std::string       serial_number;
-        std::string       registration_number;
-    };
+    /// Observation of a sample for the prepared flight
+    ///     @param timestamp RFC 3339
+    QByteArray observation(const TelemetrySample& sample, const QByteArray& timestamp) const;
 
-    struct Position {
-        double lat;                   ///< The latitude of the position [°].
-        double lng;                   ///< The longitude of the position in [°].
-        double alt;                   ///< The altitude above mean sea level of the position in [m].
-        std::string accuracy_h;            ///< The horizontal accuracy of the position in [m].
-        std::string accuracy_v;
-        bool extrpolated;
-        double pressure_altitude;
-    };
+    int pendingObservations() const { return _pendingObservations.count(); }
+    int droppedObservations() const { return _droppedObservations; }
+    bool telemetryInFlight() const { return _telemetryInFlight; }
 
-    struct Height{
-        double distance;
-        std::string reference;
-    };
-
-    struct Timestamp{
-        std::string value;
-        std::string format;
-    };
-
-    struct RidData {
-        Timestamp timestamp;
-        double timestamp_accuracy;
-        std::string operational_status;
-        Position position;
-        double track;
-        double speed;
-        std::string speed_accuracy;
-        double vertical_speed;
-        Height height;
-        double group_radius;
-        double group_ceiling;
-        double group_floor;
-        int group_count;
-        std::string group_time_start;
-        std::string group_time_end;
-    };
+    static constexpr int kMaxBatchObservations = 10;
 
 private:
-    FlightDetails                _flightDetails;
-    json                         _flightDetailsJson;
-    RidData                      _ridData;
-    json                         _ridDataJson;
-    int                          _statusCode;
-    std::string                  _response;
+    void _sendTelemetry();
+
     std::shared_ptr<Dispatcher>  _dispatcher;
-    double                       _initLatitude;
-    double                       _initLongitude;
-    int                          _j=0;
+    bool                         _flightPrepared = false;
+    std::string                  _aircraftSerialNumber;
+    std::string                  _operatorID;
+    std::string                  _flightID;
+    QByteArray                   _observationSuffix;        ///< Flight details closing every observation
+    QList<QByteArray>            _pendingObservations;
+    int                          _droppedObservations = 0;
+    bool                         _telemetryInFlight = false;
 };
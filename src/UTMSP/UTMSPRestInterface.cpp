@@ -18,10 +18,18 @@ UTMSPRestInterface::UTMSPRestInterface(QObject *parent):
     QObject(parent)
 {
     _networkManager = new QNetworkAccessManager(this);
+    _networkManager->setTransferTimeout(kTransferTimeoutMsecs);
 }
 
 UTMSPRestInterface::~UTMSPRestInterface()
 {
+    // Reply handlers may belong to a derived class which is already gone
+    _sendQueue.clear();
+    const QList<QNetworkReply*> replies = _networkManager->findChildren<QNetworkReply*>();
+    for (QNetworkReply *reply : replies) {
+        (void) reply->disconnect(this);
+    }
+
     delete _networkManager;
     _networkManager = nullptr;
 }
@@ -41,7 +49,7 @@ void UTMSPRestInterface::setHost(const HostTarget &hostTarget)
     }
     _currentRequest.setRawHeader("User-Agent", QString("Qt/%1").arg(QT_VERSION_STR).toUtf8());
     _currentRequest.setRawHeader("Accept", "*/*");
-    _currentRequest.setRawHeader("Accept-Encoding", "gzip, deflate, br");
+    // Accept-Encoding is left to the network access manager, which only decompresses replies to requests it set it on
     _currentRequest.setRawHeader("Connection", "keep-alive");
 
     QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
@@ -56,7 +64,12 @@ void UTMSPRestInterface::setBasicToken(const QString &basicToken){
 
 void UTMSPRestInterface::modifyRequest(const QString &target, QNetworkAccessManager::Operation method, const QString &body)
 {
-    QUrl url(_currentURL+target);
+    modifyRequest(target, method, body.toUtf8());
+}
+
+void UTMSPRestInterface::modifyRequest(const QString &target, QNetworkAccessManager::Operation method, const QByteArray &body)
+{
+    QUrl url((_hostOverride.isEmpty() ? _currentURL : _hostOverride) + target);
     _currentRequest.setUrl(url);
     _currentMethod = method;
     _currentBody = body;
@@ -69,40 +82,93 @@ QPair<int, std::string> UTMSPRestInterface::executeRequest()
         return qMakePair(0, "Network manager is not initialized");
     }
 
-    QNetworkReply *reply = nullptr;
-    switch(_currentMethod) {
+    int statusCode = 0;
+    QByteArray response;
+    bool finished = false;
+    QEventLoop loop;
+    const bool queued = sendRequest([&statusCode, &response, &finished, &loop](int replyStatusCode, const QByteArray &replyData) {
+        statusCode = replyStatusCode;
+        response = replyData;
+        finished = true;
+        loop.quit();
+    });
+    if (!queued) {
+        return qMakePair(0, "Send queue is full");
+    }
+    if (!finished) {
+        loop.exec();
+    }
+
+    return qMakePair(statusCode, response.toStdString());
+}
+
+bool UTMSPRestInterface::sendRequest(ReplyHandler handler)
+{
+    if (_sendQueue.count() >= _maxQueuedRequests) {
+        UTMSP_LOG_WARNING() << "UTMSPRestInterface: Send queue full, request dropped" << _currentRequest.url().toString();
+        return false;
+    }
+
+    _sendQueue.enqueue({ _currentRequest, _currentMethod, _currentBody, std::move(handler) });
+    _sendNext();
+
+    return true;
+}
+
+void UTMSPRestInterface::connectToHost()
+{
+    const QUrl url(_hostOverride.isEmpty() ? _currentURL : _hostOverride);
+    if (url.scheme() == QStringLiteral("https")) {
+        _networkManager->connectToHostEncrypted(url.host(), static_cast<quint16>(url.port(443)), _currentRequest.sslConfiguration());
+    } else {
+        _networkManager->connectToHost(url.host(), static_cast<quint16>(url.port(80)));
+    }
+}
+
+void UTMSPRestInterface::_sendNext()
+{
+    while ((_inFlight < kMaxInFlight) && !_sendQueue.isEmpty()) {
+        PendingRequest pending = _sendQueue.dequeue();
+        QNetworkReply *reply = _send(pending);
+        if (!reply) {
+            if (pending.handler) {
+                pending.handler(0, QByteArray());
+            }
+            continue;
+        }
+
+        _inFlight++;
+        (void) connect(reply, &QNetworkReply::finished, this, [this, reply, handler = std::move(pending.handler)]() {
+            _inFlight--;
+            const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QByteArray response = reply->readAll();
+            reply->deleteLater();
+
+            if (handler) {
+                handler(statusCode, response);
+            }
+            _sendNext();
+        });
+    }
+}
+
+QNetworkReply *UTMSPRestInterface::_send(const PendingRequest &pending)
+{
+    switch(pending.method) {
     case QNetworkAccessManager::GetOperation:
-        reply = _networkManager->get(_currentRequest);
-        break;
+        return _networkManager->get(pending.request);
     case QNetworkAccessManager::PostOperation:
-        reply = _networkManager->post(_currentRequest, _currentBody.toUtf8());
-        break;
+        return _networkManager->post(pending.request, pending.body);
     case QNetworkAccessManager::PutOperation:
-        reply = _networkManager->put(_currentRequest, _currentBody.toUtf8());
-        break;
+        return _networkManager->put(pending.request, pending.body);
     case QNetworkAccessManager::DeleteOperation:
-        reply = _networkManager->deleteResource(_currentRequest);
-        break;
+        return _networkManager->deleteResource(pending.request);
     case QNetworkAccessManager::HeadOperation:
-        reply = _networkManager->head(_currentRequest);
-        break;
+        return _networkManager->head(pending.request);
     default:
-        qDebug() << "Unsupported HTTP method: " << _currentMethod;
-        return qMakePair(0, "Unsupported HTTP method");
+        qDebug() << "Unsupported HTTP method: " << pending.method;
+        return nullptr;
     }
-
-    if (!reply) return qMakePair(0, "Failed to create network reply");
-
-    QEventLoop loop;
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
-
-    auto response = reply->readAll();
-    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-    reply->deleteLater();
-
-    return qMakePair(statusCode, (QString::fromUtf8(response)).toStdString());
 }
 
 void UTMSPRestInterface::setBearerToken(const std::string& token)
@@ -16,7 +16,18 @@
 #include <QString>
 #include <QUrl>
 #include <QPair>
+#include <QQueue>
 
+#include <functional>
+
+/// REST client of the UTM service provider.
+///
+/// Requests are queued and sent without blocking, at most kMaxInFlight at a time over the connections the network
+/// access manager keeps alive to the host. The queue is bounded: sendRequest() refuses a request once it is full, so
+/// a caller producing requests faster than the server answers has to hold back or merge them.
+///
+/// executeRequest() waits for the reply and is only meant for the steps before a flight which need the answer
+/// right away (authorization, registration, activation).
 class UTMSPRestInterface : public QObject {
     Q_OBJECT
 
@@ -29,17 +40,53 @@ public:
         BlenderClient
     };
 
+    /// Called once the reply finished, statusCode is 0 if no HTTP response was received
+    typedef std::function<void(int statusCode, const QByteArray &response)> ReplyHandler;
+
     void setBearerToken(const std::string &token);
     QPair<int, std::string> executeRequest();
     void modifyRequest(const QString &target, QNetworkAccessManager::Operation method, const QString &body = "");
+    void modifyRequest(const QString &target, QNetworkAccessManager::Operation method, const QByteArray &body);
     void setHost(const HostTarget &hostTarget);
     void setBasicToken(const QString &basicToken);
 
+    /// Queues the current request without waiting for the reply
+    ///     @return false if the send queue is full
+    bool sendRequest(ReplyHandler handler = nullptr);
+
+    /// Opens a connection to the current host ahead of the first request
+    void connectToHost();
+
+    /// Replaces the URL of the host targets, for a test server
+    void setHostOverride(const QString &url) { _hostOverride = url; }
+
+    void setMaxQueuedRequests(int maxQueuedRequests) { _maxQueuedRequests = qMax(1, maxQueuedRequests); }
+    int queuedRequests() const { return _sendQueue.count(); }
+    int inFlightRequests() const { return _inFlight; }
+
+    static constexpr int kMaxInFlight           = 6;        ///< Connections per host the network access manager opens
+    static constexpr int kMaxQueuedRequests     = 32;
+    static constexpr int kTransferTimeoutMsecs  = 10000;
+
 private:
+    struct PendingRequest {
+        QNetworkRequest                     request;
+        QNetworkAccessManager::Operation    method;
+        QByteArray                          body;
+        ReplyHandler                        handler;
+    };
+
+    void _sendNext();
+    QNetworkReply *_send(const PendingRequest &pending);
+
     QNetworkAccessManager *             _networkManager = nullptr;
     QNetworkRequest                     _currentRequest;
-    QString                             _currentBody;
+    QByteArray                          _currentBody;
     QNetworkAccessManager::Operation    _currentMethod;
     QString                             _currentURL;
     QString                             _basicToken;
+    QString                             _hostOverride;
+    QQueue<PendingRequest>              _sendQueue;
+    int                                 _inFlight = 0;
+    int                                 _maxQueuedRequests = kMaxQueuedRequests;
 };
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFutureWatcher>
+
+#include <functional>
+
+/// Runs jobs on the global thread pool, one at a time, delivering only the result of the most recent submission.
+///
+/// Intended for geometry which is recalculated every time the user drags a slider or a vertex. While a job is
+/// running, newer submissions replace each other in a single pending slot, so a burst of edits results in at most
+/// one extra job instead of one job per edit. When a job finishes and a newer one is pending its result is thrown
+/// away and the pending job is started instead.
+///
+/// Jobs run on a worker thread and so must only touch the data they capture by value. The result handler is always
+/// called on the thread which owns the runner.
+template<typename Result>
+class CoalescingJobRunner
+{
+public:
+    using Job       = std::function<Result(void)>;
+    using Handler   = std::function<void(const Result&)>;
+
+    explicit CoalescingJobRunner(Handler handler)
+        : _handler(std::move(handler))
+    {
+        QObject::connect(&_watcher, &QFutureWatcherBase::finished, &_watcher, [this]() { _jobFinished(); });
+    }
+
+    ~CoalescingJobRunner()
+    {
+        _pendingJob = nullptr;
+        _watcher.waitForFinished();
+    }
+
+    CoalescingJobRunner(const CoalescingJobRunner&) = delete;
+    CoalescingJobRunner& operator=(const CoalescingJobRunner&) = delete;
+
+    /// Queues a job. Replaces any job which has been submitted but not yet started.
+    void submit(Job job)
+    {
+        if (busy()) {
+            if (_pendingJob) {
+                _skippedCount++;
+            }
+            _pendingJob = std::move(job);
+        } else {
+            _start(std::move(job));
+        }
+    }
+
+    /// @return true: A job is running or its result has not been delivered yet
+    bool busy(void) const { return !_delivered; }
+
+    /// Blocks until the latest submitted job has completed and its result has been handed to the handler.
+    void waitForFinished(void)
+    {
+        while (true) {
+            _watcher.waitForFinished();
+            if (!_pendingJob) {
+                break;
+            }
+            _skippedCount++;
+            _start(std::move(_pendingJob));
+            _pendingJob = nullptr;
+        }
+        _deliver();
+    }
+
+    /// @return Number of submitted jobs whose results were never delivered because a newer job superseded them
+    quint64 skippedCount(void) const { return _skippedCount; }
+
+private:
+    void _start(Job job)
+    {
+        _delivered = false;
+        _watcher.setFuture(QtConcurrent::run(std::move(job)));
+    }
+
+    void _jobFinished(void)
+    {
+        if (_delivered) {
+            // Already delivered through waitForFinished
+            return;
+        }
+        if (_pendingJob) {
+            _skippedCount++;
+            Job job = std::move(_pendingJob);
+            _pendingJob = nullptr;
+            _start(std::move(job));
+            return;
+        }
+        _deliver();
+    }
+
+    void _deliver(void)
+    {
+        if (!_delivered) {
+            _delivered = true;
+            _handler(_watcher.result());
+        }
+    }
+
+    Handler                 _handler;
+    Job                     _pendingJob;
+    QFutureWatcher<Result>  _watcher;
+    bool                    _delivered =    true;
+    quint64                 _skippedCount = 0;
+};
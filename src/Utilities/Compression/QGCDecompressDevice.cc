@@ -0,0 +1,306 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCDecompressDevice.h"
+#include "QGCLoggingCategory.h"
+
+#include <climits>
+#include <mutex>
+
+#include <xz.h>
+#include <zlib.h>
+
+QGC_LOGGING_CATEGORY(QGCDecompressDeviceLog, "qgc.compression.qgcdecompressdevice")
+
+static std::once_flag s_xzCrcInit;
+
+QGCDecompressDevice::QGCDecompressDevice(QIODevice *source, QObject *parent)
+    : QGCDecompressDevice(source, Unknown, parent)
+{
+
+}
+
+QGCDecompressDevice::QGCDecompressDevice(QIODevice *source, Format format, QObject *parent)
+    : QIODevice(parent)
+    , _source(source)
+    , _format(format)
+{
+    if (_source) {
+        (void) connect(_source, &QIODevice::readyRead, this, &QIODevice::readyRead);
+    }
+}
+
+QGCDecompressDevice::~QGCDecompressDevice()
+{
+    _endDecoder();
+}
+
+QGCDecompressDevice::Format QGCDecompressDevice::detectFormat(QByteArrayView data)
+{
+    if (data.startsWith(QByteArrayView("\x1F\x8B", 2))) {
+        return Gzip;
+    }
+    if (data.startsWith(QByteArrayView("\xFD" "7zXZ\x00", 6))) {
+        return Xz;
+    }
+    if (data.size() >= 2) {
+        // Deflate method with a valid header check
+        const uint cmf = static_cast<uchar>(data[0]);
+        const uint flg = static_cast<uchar>(data[1]);
+        if (((cmf & 0x0F) == 8) && ((cmf >> 4) <= 7) && ((((cmf << 8) | flg) % 31) == 0)) {
+            return Zlib;
+        }
+    }
+
+    return Unknown;
+}
+
+bool QGCDecompressDevice::open(OpenMode mode)
+{
+    if ((mode & QIODevice::ReadWrite) != QIODevice::ReadOnly) {
+        setErrorString(tr("Decompression is read only"));
+        return false;
+    }
+    if (!_source || !_source->isReadable()) {
+        setErrorString(tr("Source device is not open for reading"));
+        return false;
+    }
+
+    _endDecoder();
+    _inputPos = 0;
+    _inputSize = 0;
+    _sourceEnd = false;
+    _streamEnd = false;
+    _failed = false;
+    _compressedBytesRead = 0;
+    _decompressedBytesRead = 0;
+
+    if (_format == Unknown) {
+        _format = detectFormat(_source->peek(6));
+        if (_format == Unknown) {
+            setErrorString(tr("Unknown compression format"));
+            return false;
+        }
+    }
+
+    if (_format == Xz) {
+        std::call_once(s_xzCrcInit, []() {
+            xz_crc32_init();
+            xz_crc64_init();
+        });
+        _xz = xz_dec_init(XZ_DYNALLOC, kXzDictMax);
+        if (!_xz) {
+            setErrorString(tr("Memory allocation failed"));
+            return false;
+        }
+    } else {
+        _zstream = new z_stream{};
+        const int ret = inflateInit2(_zstream, (_format == Gzip) ? (16 + MAX_WBITS) : MAX_WBITS);
+        if (ret != Z_OK) {
+            qCWarning(QGCDecompressDeviceLog) << "inflateInit2 failed:" << ret;
+            delete _zstream;
+            _zstream = nullptr;
+            setErrorString(tr("Decompressor initialization failed"));
+            return false;
+        }
+    }
+
+    _input.resize(kChunkSize);
+
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+void QGCDecompressDevice::close()
+{
+    QIODevice::close();
+    _endDecoder();
+    _input.clear();
+    _input.squeeze();
+}
+
+bool QGCDecompressDevice::atEnd() const
+{
+    return !isOpen() || ((_streamEnd || _failed) && (QIODevice::bytesAvailable() == 0));
+}
+
+void QGCDecompressDevice::_endDecoder()
+{
+    if (_zstream) {
+        (void) inflateEnd(_zstream);
+        delete _zstream;
+        _zstream = nullptr;
+    }
+    if (_xz) {
+        xz_dec_end(_xz);
+        _xz = nullptr;
+    }
+}
+
+void QGCDecompressDevice::_setError(const QString &errorString)
+{
+    qCWarning(QGCDecompressDeviceLog) << errorString;
+    setErrorString(errorString);
+    _failed = true;
+}
+
+bool QGCDecompressDevice::_fillInput()
+{
+    const qint64 bytesRead = _source->read(_input.data(), _input.size());
+    if (bytesRead < 0) {
+        _setError(tr("Read of source failed: %1").arg(_source->errorString()));
+        return false;
+    }
+
+    _inputPos = 0;
+    _inputSize = static_cast<qsizetype>(bytesRead);
+    _compressedBytesRead += bytesRead;
+    if ((bytesRead == 0) && _source->atEnd()) {
+        _sourceEnd = true;
+    }
+
+    return true;
+}
+
+bool QGCDecompressDevice::_hasMoreInput()
+{
+    if (_inputPos < _inputSize) {
+        return true;
+    }
+    if (_sourceEnd || !_fillInput()) {
+        return false;
+    }
+    return _inputSize > 0;
+}
+
+qint64 QGCDecompressDevice::readData(char *data, qint64 maxSize)
+{
+    if (_failed) {
+        return -1;
+    }
+
+    // Blocks until some output is available, a decoder produces nothing only while it is consuming headers
+    qint64 produced = 0;
+    while ((produced == 0) && !_streamEnd && (maxSize > 0)) {
+        if ((_inputPos == _inputSize) && !_sourceEnd) {
+            if (!_fillInput()) {
+                return -1;
+            }
+            if ((_inputSize == 0) && !_sourceEnd) {
+                // Nothing available from the source right now
+                break;
+            }
+        }
+
+        produced = (_format == Xz) ? _decodeXz(data, maxSize) : _decodeZlib(data, maxSize);
+        if (produced < 0) {
+            return -1;
+        }
+    }
+
+    _decompressedBytesRead += produced;
+    return produced;
+}
+
+qint64 QGCDecompressDevice::_decodeZlib(char *data, qint64 maxSize)
+{
+    _zstream->next_in = reinterpret_cast<Bytef*>(_input.data() + _inputPos);
+    _zstream->avail_in = static_cast<uInt>(_inputSize - _inputPos);
+    _zstream->next_out = reinterpret_cast<Bytef*>(data);
+    _zstream->avail_out = static_cast<uInt>(qMin<qint64>(maxSize, UINT_MAX));
+    const uInt availOut = _zstream->avail_out;
+
+    const int ret = inflate(_zstream, Z_NO_FLUSH);
+
+    _inputPos = _inputSize - static_cast<qsizetype>(_zstream->avail_in);
+    const qint64 produced = availOut - _zstream->avail_out;
+
+    switch (ret) {
+    case Z_OK:
+        break;
+    case Z_STREAM_END:
+        // Concatenated gzip members make up a single stream
+        if ((_format == Gzip) && _hasMoreInput()) {
+            (void) inflateReset(_zstream);
+        } else if (!_failed) {
+            _streamEnd = true;
+        }
+        break;
+    case Z_BUF_ERROR:
+        if (_sourceEnd && (_inputPos == _inputSize) && (produced == 0)) {
+            _setError(tr("Compressed stream is truncated"));
+            return -1;
+        }
+        break;
+    default:
+        qCWarning(QGCDecompressDeviceLog) << "inflate failed:" << ret;
+        _setError(tr("Compressed stream is corrupt"));
+        return -1;
+    }
+
+    return _failed ? -1 : produced;
+}
+
+qint64 QGCDecompressDevice::_decodeXz(char *data, qint64 maxSize)
+{
+    xz_buf buffer;
+    buffer.in = reinterpret_cast<const uint8_t*>(_input.constData());
+    buffer.in_pos = static_cast<size_t>(_inputPos);
+    buffer.in_size = static_cast<size_t>(_inputSize);
+    buffer.out = reinterpret_cast<uint8_t*>(data);
+    buffer.out_pos = 0;
+    buffer.out_size = static_cast<size_t>(maxSize);
+
+    const xz_ret ret = xz_dec_run(_xz, &buffer);
+
+    _inputPos = static_cast<qsizetype>(buffer.in_pos);
+    const qint64 produced = static_cast<qint64>(buffer.out_pos);
+
+    switch (ret) {
+    case XZ_OK:
+        break;
+    case XZ_UNSUPPORTED_CHECK:
+        qCWarning(QGCDecompressDeviceLog) << "Unsupported check; not verifying file integrity";
+        break;
+    case XZ_STREAM_END:
+        _streamEnd = true;
+        break;
+    case XZ_BUF_ERROR:
+        // No progress was possible on two calls in a row
+        if (_sourceEnd) {
+            _setError(tr("Compressed stream is truncated"));
+            return -1;
+        }
+        break;
+    case XZ_MEM_ERROR:
+        _setError(tr("Memory allocation failed"));
+        return -1;
+    case XZ_MEMLIMIT_ERROR:
+        _setError(tr("Memory usage limit reached"));
+        return -1;
+    case XZ_FORMAT_ERROR:
+        _setError(tr("Not a .xz stream"));
+        return -1;
+    case XZ_OPTIONS_ERROR:
+        _setError(tr("Unsupported options in the .xz headers"));
+        return -1;
+    default:
+        _setError(tr("Compressed stream is corrupt"));
+        return -1;
+    }
+
+    return produced;
+}
+
+qint64 QGCDecompressDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
+#include <QtCore/QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCDecompressDeviceLog)
+
+struct z_stream_s;
+struct xz_dec;
+
+/// Read only device which decompresses a gzip, zlib or xz stream from a source device as it is read.
+///
+/// The source is read in chunks of kChunkSize and decoded straight into the buffer of the reader, so memory use
+/// stays bounded by the chunk size and the decoder state however large the stream is. A QXmlStreamReader, a
+/// QDataStream or a plain read loop can consume the decompressed data without it ever being fully in memory.
+///
+/// The source is not owned. It must be open for reading and deliver its data synchronously, as files and buffers do.
+class QGCDecompressDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        Unknown,    ///< Detect from the stream header when opened
+        Gzip,
+        Zlib,
+        Xz,
+    };
+    Q_ENUM(Format)
+
+    explicit QGCDecompressDevice(QIODevice *source, QObject *parent = nullptr);
+    QGCDecompressDevice(QIODevice *source, Format format, QObject *parent = nullptr);
+    ~QGCDecompressDevice() override;
+
+    /// @return Format of the stream, Unknown until opened with detection
+    Format format() const { return _format; }
+
+    /// @return true once the end of the compressed stream has been decoded, false while reading or after an error
+    bool isFinished() const { return _streamEnd; }
+
+    /// @return Compressed bytes consumed from the source so far
+    qint64 compressedBytesRead() const { return _compressedBytesRead; }
+
+    /// @return Decompressed bytes produced so far
+    qint64 decompressedBytesRead() const { return _decompressedBytesRead; }
+
+    /// @return Format identified by the magic bytes at the start of data, Unknown if none matches
+    static Format detectFormat(QByteArrayView data);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+
+    static constexpr qint64 kChunkSize = 64 * 1024;
+    static constexpr quint32 kXzDictMax = 64 * 1024 * 1024;   ///< Largest xz dictionary accepted, xz -9 uses 64 MiB
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    bool _fillInput();
+    bool _hasMoreInput();
+    qint64 _decodeZlib(char *data, qint64 maxSize);
+    qint64 _decodeXz(char *data, qint64 maxSize);
+    void _setError(const QString &errorString);
+    void _endDecoder();
+
+    QIODevice *_source = nullptr;
+    Format _format = Unknown;
+    z_stream_s *_zstream = nullptr;
+    xz_dec *_xz = nullptr;
+    QByteArray _input;
+    qsizetype _inputPos = 0;
+    qsizetype _inputSize = 0;
+    bool _sourceEnd = false;
+    bool _streamEnd = false;
+    bool _failed = false;
+    qint64 _compressedBytesRead = 0;
+    qint64 _decompressedBytesRead = 0;
+};
@@ -12,6 +12,8 @@
 
 #include <QtCore/QFile>
 
+#include <cstring>
+#include <functional>
 #include <mutex>
 
 #include <xz.h>
@@ -22,20 +24,11 @@ static std::once_flag crc_init;
 
 namespace QGCLZMA {
 
-bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFilename)
+/// Runs the decoder over the input provided by read, handing the output to write
+///     @param read Fills the buffer, returns the number of bytes read
+///     @param write Consumes the output, returns false on failure
+static bool _inflate(const std::function<qint64(uint8_t *buffer, qint64 maxSize)> &read, const std::function<bool(const uint8_t *data, size_t size)> &write)
 {
-    QFile inputFile(lzmaFilename);
-    if (!inputFile.open(QIODevice::ReadOnly)) {
-        qCWarning(QGCLZMALog) << "open input file failed" << lzmaFilename << inputFile.errorString();
-        return false;
-    }
-
-    QFile outputFile(decompressedFilename);
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        qCWarning(QGCLZMALog) << "open input file failed" << outputFile.fileName() << outputFile.errorString();
-        return false;
-    }
-
     std::call_once(crc_init, []() {
         xz_crc32_init();
         xz_crc64_init();
@@ -61,16 +54,14 @@ bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFil
 
     while (true) {
         if (b.in_pos == b.in_size) {
-            b.in_size = static_cast<size_t>(inputFile.read((char*)in, sizeof(in)));
+            b.in_size = static_cast<size_t>(qMax<qint64>(0, read(in, sizeof(in))));
             b.in_pos = 0;
         }
 
         xz_ret ret = xz_dec_run(s, &b);
 
         if (b.out_pos == sizeof(out)) {
-            const size_t cBytesWritten = static_cast<size_t>(outputFile.write((char*)out, static_cast<int>(b.out_pos)));
-            if (cBytesWritten != b.out_pos) {
-                qCWarning(QGCLZMALog) << "output file write failed:" << outputFile.fileName() << outputFile.errorString();
+            if (!write(out, b.out_pos)) {
                 goto error;
             }
 
@@ -86,9 +77,7 @@ bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFil
             continue;
         }
 
-        const size_t cBytesWritten = static_cast<size_t>(outputFile.write((char*)out, static_cast<int>(b.out_pos)));
-        if (cBytesWritten != b.out_pos) {
-            qCWarning(QGCLZMALog) << "output file write failed:" << outputFile.fileName() << outputFile.errorString();
+        if (!write(out, b.out_pos)) {
             goto error;
         }
 
@@ -124,7 +113,61 @@ bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFil
 error:
     xz_dec_end(s);
     return false;
+}
 
+bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFilename)
+{
+    QFile inputFile(lzmaFilename);
+    if (!inputFile.open(QIODevice::ReadOnly)) {
+        qCWarning(QGCLZMALog) << "open input file failed" << lzmaFilename << inputFile.errorString();
+        return false;
+    }
+
+    QFile outputFile(decompressedFilename);
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(QGCLZMALog) << "open input file failed" << outputFile.fileName() << outputFile.errorString();
+        return false;
+    }
+
+    return _inflate(
+        [&inputFile](uint8_t *buffer, qint64 maxSize) {
+            return inputFile.read(reinterpret_cast<char*>(buffer), maxSize);
+        },
+        [&outputFile](const uint8_t *data, size_t size) {
+            const size_t cBytesWritten = static_cast<size_t>(outputFile.write(reinterpret_cast<const char*>(data), static_cast<qint64>(size)));
+            if (cBytesWritten != size) {
+                qCWarning(QGCLZMALog) << "output file write failed:" << outputFile.fileName() << outputFile.errorString();
+                return false;
+            }
+            return true;
+        });
+}
+
+bool inflateLZMAData(const QByteArray &lzmaData, QByteArray &decompressedData)
+{
+    decompressedData.clear();
+    qsizetype inputPos = 0;
+
+    // .xz does not record the decompressed size up front, json usually compresses around 10:1
+    decompressedData.reserve(lzmaData.size() * 8);
+
+    return _inflate(
+        [&lzmaData, &inputPos](uint8_t *buffer, qint64 maxSize) {
+            const qint64 count = qMin<qint64>(maxSize, lzmaData.size() - inputPos);
+            memcpy(buffer, lzmaData.constData() + inputPos, static_cast<size_t>(count));
+            inputPos += count;
+            return count;
+        },
+        [&decompressedData](const uint8_t *data, size_t size) {
+            decompressedData.append(reinterpret_cast<const char*>(data), static_cast<qsizetype>(size));
+            return true;
+        });
+}
+
+bool isLZMAData(const QByteArray &data)
+{
+    static constexpr char kMagic[] = { '\xFD', '7', 'z', 'X', 'Z', '\x00' };
+    return data.startsWith(QByteArrayView(kMagic, sizeof(kMagic)));
 }
 
 } // namespace QGCLZMA
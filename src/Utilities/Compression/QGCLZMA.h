@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QByteArray>
 #include <QtCore/QString>
 #include <QtCore/QLoggingCategory>
 
@@ -19,4 +20,12 @@ namespace QGCLZMA {
     ///     @param lzmaFilename         Fully qualified path to lzma file
     ///     @param decompressedFilename Fully qualified path to for file to decompress to
     bool inflateLZMAFile(const QString &lzmaFilename, const QString &decompressedFilename);
+
+    /// Decompresses .xz data in memory
+    ///     @param lzmaData             Compressed data
+    ///     @param decompressedData     Returned decompressed data
+    bool inflateLZMAData(const QByteArray &lzmaData, QByteArray &decompressedData);
+
+    /// @return true if the data starts with the .xz stream header magic
+    bool isLZMAData(const QByteArray &data);
 } // namespace QGCLZMA
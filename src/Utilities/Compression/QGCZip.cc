@@ -2,8 +2,12 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QThread>
 #include <QtCore/private/qzipreader_p.h>
 #include <QtCore/private/qzipwriter_p.h>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <atomic>
 
 QGC_LOGGING_CATEGORY(QGCZipLog, "qgc.utilities.compression.qgczip")
 
@@ -49,7 +53,37 @@ bool zipDirectory(const QString &directoryPath, const QString &zipFilePath)
     return true;
 }
 
-bool unzipFile(const QString &zipFilePath, const QString &outputDirectoryPath)
+/// Extracts a range of entries with its own reader, QZipReader is not thread safe
+static bool _extractFiles(const QString &zipFilePath, const QString &outputDirectoryPath, const QList<QZipReader::FileInfo> &files, qsizetype first, qsizetype last)
+{
+    QFile zipFile(zipFilePath);
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCDebug(QGCZipLog) << "Could not open zip file:" << zipFilePath;
+        return false;
+    }
+
+    QZipReader zipReader(&zipFile);
+    for (qsizetype i = first; i < last; i++) {
+        const QString filePath = outputDirectoryPath + "/" + files[i].filePath;
+
+        QFile outFile(filePath);
+        if (!outFile.open(QIODevice::WriteOnly)) {
+            qCDebug(QGCZipLog) << "Could not open file for writing:" << filePath;
+            return false;
+        }
+        const QByteArray fileData = zipReader.fileData(files[i].filePath);
+        if (outFile.write(fileData) != fileData.size()) {
+            qCDebug(QGCZipLog) << "Could not write file:" << filePath << outFile.errorString();
+            return false;
+        }
+        outFile.close();
+    }
+
+    zipReader.close();
+    return true;
+}
+
+bool unzipFile(const QString &zipFilePath, const QString &outputDirectoryPath, int maxThreads)
 {
     QDir outputDir(outputDirectoryPath);
     if (!outputDir.exists()) {
@@ -72,26 +106,39 @@ bool unzipFile(const QString &zipFilePath, const QString &outputDirectoryPath)
     }
 
     const QList<QZipReader::FileInfo> allFiles = zipReader.fileInfoList();
+    zipReader.close();
 
+    // Directories first, so the files can be written in any order
+    QList<QZipReader::FileInfo> files;
     for (const QZipReader::FileInfo &fileInfo : allFiles) {
-        QString filePath = outputDirectoryPath + "/" + fileInfo.filePath;
-
+        const QString filePath = outputDirectoryPath + "/" + fileInfo.filePath;
         if (fileInfo.isDir) {
             QDir().mkpath(filePath);
         } else if (fileInfo.isFile) {
-            QFile outFile(filePath);
-            if (outFile.open(QIODevice::WriteOnly)) {
-                outFile.write(zipReader.fileData(fileInfo.filePath));
-                outFile.close();
-            } else {
-                qDebug() << "Could not open file for writing:" << filePath;
-                return false;
-            }
+            QDir().mkpath(QFileInfo(filePath).absolutePath());
+            files.append(fileInfo);
         }
     }
 
-    zipReader.close();
-    return true;
+    const int threadCount = qBound(1, (maxThreads > 0) ? maxThreads : QThread::idealThreadCount(), static_cast<int>(qMax<qsizetype>(1, files.count())));
+    if (threadCount == 1) {
+        return _extractFiles(zipFilePath, outputDirectoryPath, files, 0, files.count());
+    }
+
+    // One contiguous range of entries per thread, each range opens the archive once
+    QList<QPair<qsizetype, qsizetype>> ranges;
+    for (int i = 0; i < threadCount; i++) {
+        ranges.append({ (files.count() * i) / threadCount, (files.count() * (i + 1)) / threadCount });
+    }
+
+    std::atomic<bool> success = true;
+    QtConcurrent::blockingMap(ranges, [&](const QPair<qsizetype, qsizetype> &range) {
+        if (!_extractFiles(zipFilePath, outputDirectoryPath, files, range.first, range.second)) {
+            success = false;
+        }
+    });
+
+    return success;
 }
 
 } // namespace QGCZip
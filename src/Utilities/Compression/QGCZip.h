@@ -9,5 +9,6 @@ namespace QGCZip {
     bool zipDirectory(const QString &directoryPath, const QString &zipFilePath);
 
     /// Method to unzip files to a given directory
-    bool unzipFile(const QString &zipFilePath, const QString &outputDirectoryPath);
+    ///     @param maxThreads Entries are extracted in parallel on up to this many threads, 0 for one per core
+    bool unzipFile(const QString &zipFilePath, const QString &outputDirectoryPath, int maxThreads = 0);
 } // namespace QGCZip
@@ -12,14 +12,18 @@
 #include "QmlObjectListModel.h"
 #include "MissionCommandList.h"
 #include "FactMetaData.h"
+#include "QGCDecompressDevice.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonParseError>
 #include <QtCore/QObject>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QTranslator>
+#include <QtCore/QVarLengthArray>
 #include <QtCore/qapplicationstatic.h>
+#include <QtConcurrent/QtConcurrentRun>
 
 Q_APPLICATION_STATIC(QTranslator, s_jsonTranslator);
 
@@ -28,6 +32,61 @@ QTranslator* JsonHelper::translator()
     return s_jsonTranslator();
 }
 
+/// Null type signals a NaN on a double value
+static bool _typeMatches(QJsonValue::Type type, QJsonValue::Type expectedType)
+{
+    return (type == expectedType) || ((type == QJsonValue::Null) && (expectedType == QJsonValue::Double));
+}
+
+JsonHelper::JsonFile JsonHelper::loadJsonFile(const QString& fileName)
+{
+    JsonFile jsonFile;
+    jsonFile.fileName = fileName;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        jsonFile.errorString = tr("Unable to open file: '%1', error: %2").arg(fileName).arg(file.errorString());
+        return jsonFile;
+    }
+
+    // Parse straight out of the mapped file where possible, which saves a copy of large files
+    QByteArray bytes;
+    uchar* const mapped = (file.size() > 0) ? file.map(0, file.size()) : nullptr;
+    if (mapped) {
+        bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(file.size()));
+    } else {
+        bytes = file.readAll();
+    }
+
+    if (QGCDecompressDevice::detectFormat(bytes) != QGCDecompressDevice::Unknown) {
+        QBuffer compressedBuffer(&bytes);
+        (void) compressedBuffer.open(QIODevice::ReadOnly);
+        QGCDecompressDevice decompressor(&compressedBuffer);
+        const QByteArray decompressedBytes = decompressor.open(QIODevice::ReadOnly) ? decompressor.readAll() : QByteArray();
+        if (!decompressor.isFinished()) {
+            jsonFile.errorString = tr("Unable to decompress file: '%1'").arg(fileName);
+            return jsonFile;
+        }
+        bytes = decompressedBytes;
+    }
+
+    QJsonParseError parseError;
+    jsonFile.jsonDoc = QJsonDocument::fromJson(bytes, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        jsonFile.jsonDoc = QJsonDocument();
+        jsonFile.errorString = tr("Unable to parse json file: %1 error: %2 offset: %3").arg(fileName).arg(parseError.errorString()).arg(parseError.offset);
+    }
+
+    return jsonFile;
+}
+
+QFuture<JsonHelper::JsonFile> JsonHelper::loadJsonFileAsync(const QString& fileName)
+{
+    return QtConcurrent::run([fileName]() {
+        return loadJsonFile(fileName);
+    });
+}
+
 bool JsonHelper::validateRequiredKeys(const QJsonObject& jsonObject, const QStringList& keys, QString& errorString)
 {
     QString missingKeys;
@@ -142,11 +201,7 @@ bool JsonHelper::validateKeyTypes(const QJsonObject& jsonObject, const QStringLi
         QString valueKey = keys[i];
         if (jsonObject.contains(valueKey)) {
             const QJsonValue& jsonValue = jsonObject[valueKey];
-            if (jsonValue.type() == QJsonValue::Null &&  types[i] == QJsonValue::Double) {
-                // Null type signals a NaN on a double value
-                continue;
-            }
-            if (jsonValue.type() != types[i]) {
+            if (!_typeMatches(jsonValue.type(), types[i])) {
                 errorString  = QObject::tr("Incorrect value type - key:type:expected %1:%2:%3").arg(valueKey).arg(_jsonValueTypeToString(jsonValue.type())).arg(_jsonValueTypeToString(types[i]));
                 return false;
             }
@@ -175,15 +230,14 @@ bool JsonHelper::isJsonFile(const QByteArray& bytes, QJsonDocument& jsonDoc, QSt
 
 bool JsonHelper::isJsonFile(const QString& fileName, QJsonDocument& jsonDoc, QString& errorString)
 {
-    QFile jsonFile(fileName);
-    if (!jsonFile.open(QFile::ReadOnly)) {
-        errorString = tr("File open failed: file:error %1 %2").arg(jsonFile.fileName()).arg(jsonFile.errorString());
+    const JsonFile jsonFile = loadJsonFile(fileName);
+    if (!jsonFile.isValid()) {
+        errorString = jsonFile.errorString;
         return false;
     }
-    QByteArray jsonBytes = jsonFile.readAll();
-    jsonFile.close();
 
-    return isJsonFile(jsonBytes, jsonDoc, errorString);
+    jsonDoc = jsonFile.jsonDoc;
+    return true;
 }
 
 bool JsonHelper::validateInternalQGCJsonFile(const QJsonObject& jsonObject,
@@ -328,35 +382,39 @@ QJsonObject JsonHelper::openInternalQGCJsonFile(const QString&  jsonFilename,
                                                 int             &version,
                                                 QString&        errorString)
 {
-    QFile jsonFile(jsonFilename);
-    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        errorString = tr("Unable to open file: '%1', error: %2").arg(jsonFilename).arg(jsonFile.errorString());
-        return QJsonObject();
-    }
+    return openInternalQGCJsonFile(loadJsonFile(jsonFilename), expectedFileType, minSupportedVersion, maxSupportedVersion, version, errorString);
+}
 
-    QByteArray bytes = jsonFile.readAll();
-    jsonFile.close();
-    QJsonParseError jsonParseError;
-    QJsonDocument doc = QJsonDocument::fromJson(bytes, &jsonParseError);
-    if (jsonParseError.error != QJsonParseError::NoError) {
-        errorString = tr("Unable to parse json file: %1 error: %2 offset: %3").arg(jsonFilename).arg(jsonParseError.errorString()).arg(jsonParseError.offset);
+QJsonObject JsonHelper::openInternalQGCJsonFile(const JsonFile& jsonFile,
+                                                const QString&  expectedFileType,
+                                                int             minSupportedVersion,
+                                                int             maxSupportedVersion,
+                                                int             &version,
+                                                QString&        errorString)
+{
+    if (!jsonFile.isValid()) {
+        errorString = jsonFile.errorString;
         return QJsonObject();
     }
 
-    if (!doc.isObject()) {
-        errorString = tr("Root of json file is not object: %1").arg(jsonFilename);
+    if (!jsonFile.jsonDoc.isObject()) {
+        errorString = tr("Root of json file is not object: %1").arg(jsonFile.fileName);
         return QJsonObject();
     }
 
-    QJsonObject jsonObject = doc.object();
+    QJsonObject jsonObject = jsonFile.jsonDoc.object();
     bool success = validateInternalQGCJsonFile(jsonObject, expectedFileType, minSupportedVersion, maxSupportedVersion, version, errorString);
     if (!success) {
-        errorString = tr("Json file: '%1'. %2").arg(jsonFilename).arg(errorString);
+        errorString = tr("Json file: '%1'. %2").arg(jsonFile.fileName).arg(errorString);
         return QJsonObject();
     }
 
+    // Translations of compressed files are found under the name of the uncompressed file
     QStringList translateKeys = _addDefaultLocKeys(jsonObject);
-    QString context = QFileInfo(jsonFile).fileName();
+    QString context = QFileInfo(jsonFile.fileName).fileName();
+    if (context.endsWith(QStringLiteral(".xz"), Qt::CaseInsensitive) || context.endsWith(QStringLiteral(".gz"), Qt::CaseInsensitive)) {
+        context.chop(3);
+    }
     return _translateRoot(jsonObject, context, translateKeys);
 }
 
@@ -443,24 +501,88 @@ void JsonHelper::saveGeoCoordinateArray(const QList<QGeoCoordinate>&    rgPoints
 
 bool JsonHelper::validateKeys(const QJsonObject& jsonObject, const QList<JsonHelper::KeyValidateInfo>& keyInfo, QString& errorString)
 {
-    QStringList             keyList;
-    QList<QJsonValue::Type> typeList;
+    // Same result as validateRequiredKeys followed by validateKeyTypes, with one lookup per key
+    QString missingKeys;
+    int     typeErrorIndex  = -1;
+    auto    typeErrorType   = QJsonValue::Undefined;
 
     for (int i=0; i<keyInfo.count(); i++) {
-        if (keyInfo[i].required) {
-            keyList.append(keyInfo[i].key);
+        const QJsonObject::const_iterator it = jsonObject.constFind(QLatin1String(keyInfo[i].key));
+        if (it == jsonObject.constEnd()) {
+            if (keyInfo[i].required) {
+                if (!missingKeys.isEmpty()) {
+                    missingKeys += QStringLiteral(", ");
+                }
+                missingKeys += QLatin1String(keyInfo[i].key);
+            }
+        } else if ((typeErrorIndex < 0) && !_typeMatches(it.value().type(), keyInfo[i].type)) {
+            typeErrorIndex = i;
+            typeErrorType = it.value().type();
         }
     }
-    if (!validateRequiredKeys(jsonObject, keyList, errorString)) {
+
+    if (!missingKeys.isEmpty()) {
+        errorString = QObject::tr("The following required keys are missing: %1").arg(missingKeys);
+        return false;
+    }
+    if (typeErrorIndex >= 0) {
+        errorString = QObject::tr("Incorrect value type - key:type:expected %1:%2:%3").arg(keyInfo[typeErrorIndex].key).arg(_jsonValueTypeToString(typeErrorType)).arg(_jsonValueTypeToString(keyInfo[typeErrorIndex].type));
         return false;
     }
 
-    keyList.clear();
-    for (int i=0; i<keyInfo.count(); i++) {
-        keyList.append(keyInfo[i].key);
-        typeList.append(keyInfo[i].type);
+    return true;
+}
+
+JsonHelper::KeyValidator::KeyValidator(const QList<KeyValidateInfo>& keyInfo)
+{
+    _keys.reserve(keyInfo.count());
+    for (const KeyValidateInfo& info : keyInfo) {
+        _keyIndex[QString::fromLatin1(info.key)] = static_cast<int>(_keys.count());
+        _keys.append({ QString::fromLatin1(info.key), info.type, info.required });
+        if (info.required) {
+            _requiredCount++;
+        }
+    }
+}
+
+bool JsonHelper::KeyValidator::validate(const QJsonObject& jsonObject, QString& errorString) const
+{
+    QVarLengthArray<QJsonValue::Type, 32> foundTypes(_keys.count());
+    std::fill(foundTypes.begin(), foundTypes.end(), QJsonValue::Undefined);
+
+    int requiredFound = 0;
+    for (QJsonObject::const_iterator it = jsonObject.constBegin(); it != jsonObject.constEnd(); ++it) {
+        const auto index = _keyIndex.constFind(it.key());
+        if (index != _keyIndex.constEnd()) {
+            foundTypes[*index] = it.value().type();
+            if (_keys[*index].required) {
+                requiredFound++;
+            }
+        }
+    }
+
+    if (requiredFound != _requiredCount) {
+        QString missingKeys;
+        for (int i=0; i<_keys.count(); i++) {
+            if (_keys[i].required && (foundTypes[i] == QJsonValue::Undefined)) {
+                if (!missingKeys.isEmpty()) {
+                    missingKeys += QStringLiteral(", ");
+                }
+                missingKeys += _keys[i].key;
+            }
+        }
+        errorString = QObject::tr("The following required keys are missing: %1").arg(missingKeys);
+        return false;
+    }
+
+    for (int i=0; i<_keys.count(); i++) {
+        if ((foundTypes[i] != QJsonValue::Undefined) && !_typeMatches(foundTypes[i], _keys[i].type)) {
+            errorString = QObject::tr("Incorrect value type - key:type:expected %1:%2:%3").arg(_keys[i].key).arg(_jsonValueTypeToString(foundTypes[i])).arg(_jsonValueTypeToString(_keys[i].type));
+            return false;
+        }
     }
-    return validateKeyTypes(jsonObject, keyList, typeList, errorString);
+
+    return true;
 }
 
 QString JsonHelper::_jsonValueTypeToString(QJsonValue::Type type)
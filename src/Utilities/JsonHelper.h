@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QVariantList>
 #include <QtCore/QCoreApplication>
@@ -29,7 +32,22 @@ class JsonHelper
 public:
     static QTranslator* translator();
 
-    /// Determines is the specified file is a json file
+    /// Result of loading a json file
+    struct JsonFile {
+        QString         fileName;
+        QJsonDocument   jsonDoc;
+        QString         errorString;    ///< Empty if the file was loaded
+
+        bool isValid() const { return errorString.isEmpty(); }
+    };
+
+    /// Reads and parses a json file. Files compressed with xz or gzip (.json.xz, .json.gz) are decompressed in memory first.
+    static JsonFile loadJsonFile(const QString& fileName);
+
+    /// Runs loadJsonFile on the global thread pool, so large files do not stall the calling thread
+    static QFuture<JsonFile> loadJsonFileAsync(const QString& fileName);
+
+    /// Determines is the specified file is a json file, the file may be xz or gzip compressed
     /// @return true: file is json, false: file is not json
     static bool isJsonFile(const QString&       fileName,       ///< filename
                            QJsonDocument&       jsonDoc,        ///< returned json document
@@ -79,6 +97,16 @@ public:
                                                int                 &version,            ///< returned file version
                                                QString&            errorString);        ///< returned error string if validation fails
 
+    // Validates and translates an internal QGC json file which was loaded with loadJsonFile or loadJsonFileAsync.
+    // Translation happens on the calling thread.
+    // @return Json root object for file. Empty QJsonObject if error.
+    static QJsonObject openInternalQGCJsonFile(const JsonFile&     jsonFile,            ///< Loaded json file
+                                               const QString&      expectedFileType,    ///< correct file type for file
+                                               int                 minSupportedVersion, ///< minimum supported version
+                                               int                 maxSupportedVersion, ///< maximum supported major version
+                                               int                 &version,            ///< returned file version
+                                               QString&            errorString);        ///< returned error string if validation fails
+
     /// Validates that the specified keys are in the object
     /// @return false: validation failed, errorString set
     static bool validateRequiredKeys(const QJsonObject& jsonObject, ///< json object to validate
@@ -100,6 +128,28 @@ public:
 
     static bool validateKeys(const QJsonObject& jsonObject, const QList<KeyValidateInfo>& keyInfo, QString& errorString);
 
+    /// Key validation compiled once into a lookup table, for objects of the same kind validated over and over
+    /// such as mission items or metadata entries. Same checks and errors as validateKeys, in a single pass over
+    /// the object.
+    class KeyValidator
+    {
+    public:
+        KeyValidator(const QList<KeyValidateInfo>& keyInfo);
+
+        bool validate(const QJsonObject& jsonObject, QString& errorString) const;
+
+    private:
+        struct Key {
+            QString             key;
+            QJsonValue::Type    type;
+            bool                required;
+        };
+
+        QList<Key>          _keys;
+        QHash<QString, int> _keyIndex;
+        int                 _requiredCount = 0;
+    };
+
     /// Loads a QGeoCoordinate
     ///     Stored as array [ lat, lon, alt ]
     /// @return false: validation failed
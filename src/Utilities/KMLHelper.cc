@@ -10,48 +10,53 @@
 #include "KMLHelper.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QXmlStreamReader>
 
-QDomDocument KMLHelper::_loadFile(const QString& kmlFile, QString& errorString)
-{
-    QFile file(kmlFile);
+#include <algorithm>
 
+bool KMLHelper::_openFile(QFile& file, QString& errorString)
+{
     errorString.clear();
 
     if (!file.exists()) {
-        errorString = QString(_errorPrefix).arg(tr("File not found: %1").arg(kmlFile));
-        return QDomDocument();
+        errorString = QString(_errorPrefix).arg(tr("File not found: %1").arg(file.fileName()));
+        return false;
     }
 
     if (!file.open(QIODevice::ReadOnly)) {
-        errorString = QString(_errorPrefix).arg(tr("Unable to open file: %1 error: $%2").arg(kmlFile).arg(file.errorString()));
-        return QDomDocument();
-    }
-
-    QDomDocument doc;
-    QString errorMessage;
-    int errorLine;
-    if (!doc.setContent(&file, &errorMessage, &errorLine)) {
-        errorString = QString(_errorPrefix).arg(tr("Unable to parse KML file: %1 error: %2 line: %3").arg(kmlFile).arg(errorMessage).arg(errorLine));
-        return QDomDocument();
+        errorString = QString(_errorPrefix).arg(tr("Unable to open file: %1 error: $%2").arg(file.fileName()).arg(file.errorString()));
+        return false;
     }
 
-    return doc;
+    return true;
 }
 
 ShapeFileHelper::ShapeType KMLHelper::determineShapeType(const QString& kmlFile, QString& errorString)
 {
-    QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    QFile file(kmlFile);
+    if (!_openFile(file, errorString)) {
         return ShapeFileHelper::Error;
     }
 
-    QDomNodeList rgNodes = domDocument.elementsByTagName("Polygon");
-    if (rgNodes.count()) {
-        return ShapeFileHelper::Polygon;
+    // Polygons take precedence over polylines, so we can only stop early when a Polygon is found
+    bool foundLineString = false;
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd()) {
+        if (xml.readNext() == QXmlStreamReader::StartElement) {
+            if (xml.name() == QLatin1String("Polygon")) {
+                return ShapeFileHelper::Polygon;
+            } else if (xml.name() == QLatin1String("LineString")) {
+                foundLineString = true;
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to parse KML file: %1 error: %2 line: %3").arg(kmlFile).arg(xml.errorString()).arg(xml.lineNumber()));
+        return ShapeFileHelper::Error;
     }
 
-    rgNodes = domDocument.elementsByTagName("LineString");
-    if (rgNodes.count()) {
+    if (foundLineString) {
         return ShapeFileHelper::Polyline;
     }
 
@@ -59,106 +64,175 @@ ShapeFileHelper::ShapeType KMLHelper::determineShapeType(const QString& kmlFile,
     return ShapeFileHelper::Error;
 }
 
-bool KMLHelper::loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordinate>& vertices, QString& errorString)
+/// Parses whitespace separated "lon,lat[,alt]" tuples. Altitude is ignored.
+void KMLHelper::_parseCoordinates(QStringView text, QList<QGeoCoordinate>& coords)
 {
-    errorString.clear();
-    vertices.clear();
+    qsizetype i = 0;
+    const qsizetype length = text.length();
 
-    QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
-        return false;
-    }
-
-    QDomNodeList rgNodes = domDocument.elementsByTagName("Polygon");
-    if (rgNodes.count() == 0) {
-        errorString = QString(_errorPrefix).arg(tr("Unable to find Polygon node in KML"));
-        return false;
-    }
-
-    QDomNode coordinatesNode = rgNodes.item(0).namedItem("outerBoundaryIs").namedItem("LinearRing").namedItem("coordinates");
-    if (coordinatesNode.isNull()) {
-        errorString = QString(_errorPrefix).arg(tr("Internal error: Unable to find coordinates node in KML"));
-        return false;
-    }
-
-    QString coordinatesString = coordinatesNode.toElement().text().simplified();
-    QStringList rgCoordinateStrings = coordinatesString.split(" ");
-
-    QList<QGeoCoordinate> rgCoords;
-    for (int i=0; i<rgCoordinateStrings.count()-1; i++) {
-        QString coordinateString = rgCoordinateStrings[i];
-
-        QStringList rgValueStrings = coordinateString.split(",");
+    while (i < length) {
+        while (i < length && text[i].isSpace()) {
+            i++;
+        }
+        const qsizetype tupleStart = i;
+        while (i < length && !text[i].isSpace()) {
+            i++;
+        }
+        if (i == tupleStart) {
+            break;
+        }
 
-        QGeoCoordinate coord;
-        coord.setLongitude(rgValueStrings[0].toDouble());
-        coord.setLatitude(rgValueStrings[1].toDouble());
+        const QStringView tuple = text.mid(tupleStart, i - tupleStart);
+        const qsizetype lonEnd = tuple.indexOf(QLatin1Char(','));
+        if (lonEnd < 0) {
+            continue;
+        }
+        qsizetype latEnd = tuple.indexOf(QLatin1Char(','), lonEnd + 1);
+        if (latEnd < 0) {
+            latEnd = tuple.length();
+        }
 
-        rgCoords.append(coord);
+        coords.append(QGeoCoordinate(tuple.mid(lonEnd + 1, latEnd - lonEnd - 1).toDouble(), tuple.left(lonEnd).toDouble()));
     }
+}
 
-    // Determine winding, reverse if needed. QGC wants clockwise winding
+/// QGC wants clockwise winding, reverse if needed
+void KMLHelper::_adjustWinding(QList<QGeoCoordinate>& vertices)
+{
     double sum = 0;
-    for (int i=0; i<rgCoords.count(); i++) {
-        QGeoCoordinate coord1 = rgCoords[i];
-        QGeoCoordinate coord2 = (i == rgCoords.count() - 1) ? rgCoords[0] : rgCoords[i+1];
+    for (int i=0; i<vertices.count(); i++) {
+        const QGeoCoordinate& coord1 = vertices[i];
+        const QGeoCoordinate& coord2 = (i == vertices.count() - 1) ? vertices[0] : vertices[i+1];
 
         sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
     }
-    bool reverse = sum < 0.0;
-    if (reverse) {
-        QList<QGeoCoordinate> rgReversed;
-
-        for (int i=0; i<rgCoords.count(); i++) {
-            rgReversed.prepend(rgCoords[i]);
-        }
-        rgCoords = rgReversed;
+    if (sum < 0.0) {
+        std::reverse(vertices.begin(), vertices.end());
     }
-
-    vertices = rgCoords;
-
-    return true;
 }
 
-bool KMLHelper::loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinate>& coords, QString& errorString)
+bool KMLHelper::_loadShapes(const QString& kmlFile, ShapeFileHelper::ShapeType shapeType, QList<QList<QGeoCoordinate>>& shapes, QString& errorString)
 {
-    errorString.clear();
-    coords.clear();
+    shapes.clear();
 
-    QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    QFile file(kmlFile);
+    if (!_openFile(file, errorString)) {
         return false;
     }
 
-    QDomNodeList rgNodes = domDocument.elementsByTagName("LineString");
-    if (rgNodes.count() == 0) {
-        errorString = QString(_errorPrefix).arg(tr("Unable to find LineString node in KML"));
+    const bool polygon = shapeType == ShapeFileHelper::Polygon;
+    const QLatin1String geometryName(polygon ? "Polygon" : "LineString");
+
+    // Coordinates are parsed as the character data streams in. Only complete tuples are parsed from each chunk,
+    // a partial tuple at the end of a chunk is carried over to the next one.
+    bool                    inGeometry = false;
+    bool                    inOuterBoundary = false;
+    bool                    inCoordinates = false;
+    QString                 pendingText;
+    QList<QGeoCoordinate>   coords;
+
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd()) {
+        switch (xml.readNext()) {
+        case QXmlStreamReader::StartElement:
+            if (xml.name() == geometryName) {
+                inGeometry = true;
+                coords.clear();
+            } else if (inGeometry && xml.name() == QLatin1String("outerBoundaryIs")) {
+                inOuterBoundary = true;
+            } else if (inGeometry && (inOuterBoundary || !polygon) && xml.name() == QLatin1String("coordinates")) {
+                inCoordinates = true;
+                pendingText.clear();
+            }
+            break;
+        case QXmlStreamReader::Characters:
+            if (inCoordinates) {
+                pendingText += xml.text();
+                qsizetype lastSpace = pendingText.length() - 1;
+                while (lastSpace >= 0 && !pendingText[lastSpace].isSpace()) {
+                    lastSpace--;
+                }
+                if (lastSpace >= 0) {
+                    _parseCoordinates(QStringView(pendingText).left(lastSpace), coords);
+                    pendingText.remove(0, lastSpace + 1);
+                }
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (inCoordinates && xml.name() == QLatin1String("coordinates")) {
+                _parseCoordinates(pendingText, coords);
+                pendingText.clear();
+                inCoordinates = false;
+            } else if (xml.name() == QLatin1String("outerBoundaryIs")) {
+                inOuterBoundary = false;
+            } else if (inGeometry && xml.name() == geometryName) {
+                inGeometry = false;
+                if (polygon) {
+                    // KML rings repeat the first vertex at the end
+                    if (coords.count() > 1 && coords.first() == coords.last()) {
+                        coords.removeLast();
+                    }
+                    if (coords.count() >= 3) {
+                        _adjustWinding(coords);
+                        shapes.append(coords);
+                    }
+                } else if (coords.count() >= 2) {
+                    shapes.append(coords);
+                }
+                coords.clear();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (xml.hasError()) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to parse KML file: %1 error: %2 line: %3").arg(kmlFile).arg(xml.errorString()).arg(xml.lineNumber()));
+        shapes.clear();
         return false;
     }
 
-    QDomNode coordinatesNode = rgNodes.item(0).namedItem("coordinates");
-    if (coordinatesNode.isNull()) {
-        errorString = QString(_errorPrefix).arg(tr("Internal error: Unable to find coordinates node in KML"));
+    if (shapes.isEmpty()) {
+        errorString = QString(_errorPrefix).arg(polygon ? tr("Unable to find Polygon node in KML") : tr("Unable to find LineString node in KML"));
         return false;
     }
 
-    QString coordinatesString = coordinatesNode.toElement().text().simplified();
-    QStringList rgCoordinateStrings = coordinatesString.split(" ");
+    return true;
+}
 
-    QList<QGeoCoordinate> rgCoords;
-    for (int i=0; i<rgCoordinateStrings.count()-1; i++) {
-        QString coordinateString = rgCoordinateStrings[i];
+bool KMLHelper::loadPolygonsFromFile(const QString& kmlFile, QList<QList<QGeoCoordinate>>& polygons, QString& errorString)
+{
+    return _loadShapes(kmlFile, ShapeFileHelper::Polygon, polygons, errorString);
+}
 
-        QStringList rgValueStrings = coordinateString.split(",");
+bool KMLHelper::loadPolylinesFromFile(const QString& kmlFile, QList<QList<QGeoCoordinate>>& polylines, QString& errorString)
+{
+    return _loadShapes(kmlFile, ShapeFileHelper::Polyline, polylines, errorString);
+}
 
-        QGeoCoordinate coord;
-        coord.setLongitude(rgValueStrings[0].toDouble());
-        coord.setLatitude(rgValueStrings[1].toDouble());
+bool KMLHelper::loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordinate>& vertices, QString& errorString)
+{
+    QList<QList<QGeoCoordinate>> polygons;
 
-        rgCoords.append(coord);
+    vertices.clear();
+    if (!loadPolygonsFromFile(kmlFile, polygons, errorString)) {
+        return false;
     }
 
-    coords = rgCoords;
+    vertices = polygons.first();
+    return true;
+}
+
+bool KMLHelper::loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinate>& coords, QString& errorString)
+{
+    QList<QList<QGeoCoordinate>> polylines;
+
+    coords.clear();
+    if (!loadPolylinesFromFile(kmlFile, polylines, errorString)) {
+        return false;
+    }
 
+    coords = polylines.first();
     return true;
 }
@@ -10,12 +10,16 @@
 #pragma once
 
 #include <QtCore/QObject>
-#include <QtXml/QDomDocument>
 #include <QtCore/QList>
+#include <QtCore/QStringView>
 #include <QtPositioning/QGeoCoordinate>
 
 #include "ShapeFileHelper.h"
 
+class QFile;
+
+/// Loads polygons and polylines from KML files. Files are read with a streaming parser so memory use does not
+/// depend on document size and parsing stops as soon as the requested information is found.
 class KMLHelper : public QObject
 {
     Q_OBJECT
@@ -25,8 +29,18 @@ public:
     static bool loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordinate>& vertices, QString& errorString);
     static bool loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinate>& coords, QString& errorString);
 
+    /// Loads the outer boundary of every Polygon in the file, including those inside MultiGeometry. Inner
+    /// boundaries (holes) are skipped. Vertices are returned with clockwise winding.
+    static bool loadPolygonsFromFile(const QString& kmlFile, QList<QList<QGeoCoordinate>>& polygons, QString& errorString);
+
+    /// Loads every LineString in the file
+    static bool loadPolylinesFromFile(const QString& kmlFile, QList<QList<QGeoCoordinate>>& polylines, QString& errorString);
+
 private:
-    static QDomDocument _loadFile(const QString& kmlFile, QString& errorString);
+    static bool _openFile           (QFile& file, QString& errorString);
+    static bool _loadShapes         (const QString& kmlFile, ShapeFileHelper::ShapeType shapeType, QList<QList<QGeoCoordinate>>& shapes, QString& errorString);
+    static void _parseCoordinates   (QStringView text, QList<QGeoCoordinate>& coords);
+    static void _adjustWinding      (QList<QGeoCoordinate>& vertices);
 
     static constexpr const char* _errorPrefix = QT_TR_NOOP("KML file load failed. %1");
 };
@@ -0,0 +1,450 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCProfiler.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+QGC_LOGGING_CATEGORY(QGCProfilerLog, "qgc.utilities.qgcprofiler")
+
+std::atomic<bool> QGCProfiler::_enabled{false};
+
+namespace {
+
+struct TraceEvent
+{
+    std::atomic<int>    siteId;
+    std::atomic<qint64> startNsecs;
+    std::atomic<qint64> durationNsecs;
+};
+
+/// Everything recorded by one thread. Only that thread writes to it, other threads read it.
+struct ThreadRecord
+{
+    QString name;
+    int     ordinal = 0;
+    bool    named   = false;    ///< From the object name of the thread, not made up from its id
+    bool    exited  = false;    ///< Retained after the thread exited, holds the statistics of its exited namesakes
+
+    std::atomic<quint64> count[QGCProfiler::kMaxSites];
+    std::atomic<quint64> totalNsecs[QGCProfiler::kMaxSites];
+    std::atomic<quint64> maxNsecs[QGCProfiler::kMaxSites];
+    std::atomic<quint64> buckets[QGCProfiler::kMaxSites][QGCProfiler::kHistogramBuckets];
+
+    TraceEvent              events[QGCProfiler::kTraceEvents];
+    std::atomic<quint64>    eventsWritten;
+    std::atomic<quint64>    eventsResetAt;  ///< Events written before the last reset are not exported
+};
+
+struct Registry
+{
+    Registry()
+    {
+        for (std::atomic<const char*> &siteName : siteNames) {
+            siteName.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    QMutex                                      mutex;      ///< Guards the list of threads, never taken while recording
+    std::vector<std::unique_ptr<ThreadRecord>>  threads;
+    std::atomic<const char*>                    siteNames[QGCProfiler::kMaxSites];
+    std::atomic<int>                            siteCount{0};
+    int                                         lastOrdinal = 0;    ///< Trace thread id of the last record created
+};
+
+} // namespace
+
+Q_GLOBAL_STATIC(Registry, _registry)
+Q_GLOBAL_STATIC(QGCProfiler, _profilerInstance)
+
+namespace {
+
+thread_local ThreadRecord *t_threadRecord = nullptr;
+
+/// Adds the statistics of from to into, neither thread may be recording
+void fold(ThreadRecord &into, const ThreadRecord &from)
+{
+    for (int id = 0; id < QGCProfiler::kMaxSites; id++) {
+        into.count[id].store(into.count[id].load(std::memory_order_relaxed) + from.count[id].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        into.totalNsecs[id].store(into.totalNsecs[id].load(std::memory_order_relaxed) + from.totalNsecs[id].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        into.maxNsecs[id].store(qMax(into.maxNsecs[id].load(std::memory_order_relaxed), from.maxNsecs[id].load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        for (int bucket = 0; bucket < QGCProfiler::kHistogramBuckets; bucket++) {
+            into.buckets[id][bucket].store(into.buckets[id][bucket].load(std::memory_order_relaxed) + from.buckets[id][bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Called as a thread which recorded exits. Its statistics are kept under its name, or together with all the other
+/// unnamed threads, and only the first record of each name is retained. Trace events of a folded record are dropped.
+void retireThreadRecord(ThreadRecord *record)
+{
+    if (_registry.isDestroyed()) {
+        return;
+    }
+
+    Registry *const registry = _registry();
+    QMutexLocker lock(&registry->mutex);
+
+    const QString retiredName = record->named ? record->name : QStringLiteral("Exited threads");
+    const auto retained = std::find_if(registry->threads.begin(), registry->threads.end(), [&retiredName](const std::unique_ptr<ThreadRecord> &other) {
+        return other->exited && (other->name == retiredName);
+    });
+    if (retained == registry->threads.end()) {
+        record->name = retiredName;
+        record->exited = true;
+        return;
+    }
+
+    fold(**retained, *record);
+    (void) registry->threads.erase(std::find_if(registry->threads.begin(), registry->threads.end(), [record](const std::unique_ptr<ThreadRecord> &other) {
+        return other.get() == record;
+    }));
+}
+
+/// Retires the record of the thread when the thread exits
+struct ThreadRecordOwner
+{
+    ~ThreadRecordOwner()
+    {
+        if (t_threadRecord) {
+            retireThreadRecord(t_threadRecord);
+            t_threadRecord = nullptr;
+        }
+    }
+};
+
+ThreadRecord *threadRecord()
+{
+    if (Q_LIKELY(t_threadRecord)) {
+        return t_threadRecord;
+    }
+
+    // Only touched once per thread, so the fast path above stays a plain thread local load
+    static thread_local ThreadRecordOwner owner;
+    Q_UNUSED(owner);
+
+    // Value initialized, which zeroes the counters
+    std::unique_ptr<ThreadRecord> record = std::make_unique<ThreadRecord>();
+
+    const QThread *const thread = QThread::currentThread();
+    if (QCoreApplication::instance() && (thread == QCoreApplication::instance()->thread())) {
+        record->name = QStringLiteral("Main");
+        record->named = true;
+    } else if (!thread->objectName().isEmpty()) {
+        record->name = thread->objectName();
+        record->named = true;
+    } else {
+        record->name = QStringLiteral("Thread 0x%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()), 0, 16);
+    }
+
+    Registry *const registry = _registry();
+    QMutexLocker lock(&registry->mutex);
+    record->ordinal = ++registry->lastOrdinal;
+    t_threadRecord = record.get();
+    registry->threads.push_back(std::move(record));
+
+    return t_threadRecord;
+}
+
+/// Only the owning thread writes, so a plain load and store is enough
+void addTo(std::atomic<quint64> &value, quint64 amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+int bucketFor(quint64 nsecs)
+{
+    return qMin(QGCProfiler::kHistogramBuckets - 1, 64 - static_cast<int>(qCountLeadingZeroBits(nsecs)));
+}
+
+/// Upper bound of the bucket holding the specified fraction of the calls
+quint64 percentile(const quint64 (&buckets)[QGCProfiler::kHistogramBuckets], quint64 count, double fraction)
+{
+    const quint64 target = qMax<quint64>(1, static_cast<quint64>(std::ceil(count * fraction)));
+    quint64 cumulative = 0;
+    for (int bucket = 0; bucket < QGCProfiler::kHistogramBuckets; bucket++) {
+        cumulative += buckets[bucket];
+        if (cumulative >= target) {
+            return Q_UINT64_C(1) << bucket;
+        }
+    }
+    return Q_UINT64_C(1) << (QGCProfiler::kHistogramBuckets - 1);
+}
+
+QString categoryOf(const char *name)
+{
+    const QString siteName = QString::fromLatin1(name);
+    const qsizetype separator = siteName.indexOf(QStringLiteral("::"));
+    return (separator > 0) ? siteName.left(separator) : siteName;
+}
+
+} // namespace
+
+QGCProfiler::Site::Site(const char *name_)
+    : name(name_)
+    , id(_registry()->siteCount.fetch_add(1, std::memory_order_relaxed))
+{
+    if (id >= kMaxSites) {
+        qCWarning(QGCProfilerLog) << "Site table full, not recording" << name;
+        id = -1;
+        return;
+    }
+
+    _registry()->siteNames[id].store(name, std::memory_order_release);
+}
+
+QGCProfiler::QGCProfiler(QObject *parent)
+    : QObject(parent)
+{
+    // qCDebug(QGCProfilerLog) << Q_FUNC_INFO << this;
+}
+
+QGCProfiler::~QGCProfiler()
+{
+    // qCDebug(QGCProfilerLog) << Q_FUNC_INFO << this;
+}
+
+QGCProfiler *QGCProfiler::instance()
+{
+    return _profilerInstance();
+}
+
+qint64 QGCProfiler::nsecsSinceStart()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+
+    return timer.nsecsElapsed();
+}
+
+void QGCProfiler::record(const Site &site, qint64 startNsecs, qint64 durationNsecs)
+{
+    if (site.id < 0) {
+        return;
+    }
+
+    ThreadRecord *const record = threadRecord();
+    const int id = site.id;
+    const quint64 duration = static_cast<quint64>(qMax<qint64>(0, durationNsecs));
+
+    addTo(record->count[id], 1);
+    addTo(record->totalNsecs[id], duration);
+    if (duration > record->maxNsecs[id].load(std::memory_order_relaxed)) {
+        record->maxNsecs[id].store(duration, std::memory_order_relaxed);
+    }
+    addTo(record->buckets[id][bucketFor(duration)], 1);
+
+    const quint64 index = record->eventsWritten.load(std::memory_order_relaxed);
+    TraceEvent &event = record->events[index % kTraceEvents];
+    event.siteId.store(id, std::memory_order_relaxed);
+    event.startNsecs.store(startNsecs, std::memory_order_relaxed);
+    event.durationNsecs.store(durationNsecs, std::memory_order_relaxed);
+    record->eventsWritten.store(index + 1, std::memory_order_release);
+}
+
+void QGCProfiler::count(const Site &site, quint64 count)
+{
+    if (site.id < 0) {
+        return;
+    }
+
+    addTo(threadRecord()->count[site.id], count);
+}
+
+void QGCProfiler::setEnabled(bool enabled)
+{
+    if (enabled != isEnabled()) {
+        _enabled.store(enabled, std::memory_order_relaxed);
+        qCDebug(QGCProfilerLog) << "Profiling" << (enabled ? "on" : "off");
+        emit enabledChanged(enabled);
+    }
+}
+
+QList<QGCProfiler::SiteStats> QGCProfiler::stats() const
+{
+    QList<SiteStats> result;
+
+    Registry *const registry = _registry();
+    const int siteCount = qMin(registry->siteCount.load(std::memory_order_relaxed), kMaxSites);
+
+    QMutexLocker lock(&registry->mutex);
+    for (const std::unique_ptr<ThreadRecord> &record : registry->threads) {
+        for (int id = 0; id < siteCount; id++) {
+            const quint64 count = record->count[id].load(std::memory_order_relaxed);
+            const char *const name = registry->siteNames[id].load(std::memory_order_acquire);
+            if ((count == 0) || !name) {
+                continue;
+            }
+
+            quint64 buckets[kHistogramBuckets];
+            quint64 timedCount = 0;
+            for (int bucket = 0; bucket < kHistogramBuckets; bucket++) {
+                buckets[bucket] = record->buckets[id][bucket].load(std::memory_order_relaxed);
+                timedCount += buckets[bucket];
+            }
+
+            SiteStats stats;
+            stats.name          = QString::fromLatin1(name);
+            stats.thread        = record->name;
+            stats.count         = count;
+            stats.totalNsecs    = record->totalNsecs[id].load(std::memory_order_relaxed);
+            stats.maxNsecs      = record->maxNsecs[id].load(std::memory_order_relaxed);
+            if (timedCount > 0) {
+                stats.p50Nsecs  = qMin(percentile(buckets, timedCount, 0.50), stats.maxNsecs);
+                stats.p95Nsecs  = qMin(percentile(buckets, timedCount, 0.95), stats.maxNsecs);
+            }
+            result.append(stats);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const SiteStats &a, const SiteStats &b) {
+        return (a.totalNsecs != b.totalNsecs) ? (a.totalNsecs > b.totalNsecs) : (a.count > b.count);
+    });
+
+    return result;
+}
+
+void QGCProfiler::refresh()
+{
+    _summary.clear();
+
+    const QList<SiteStats> allStats = stats();
+    for (const SiteStats &stats : allStats) {
+        QVariantMap row;
+        row[QStringLiteral("name")]         = stats.name;
+        row[QStringLiteral("thread")]       = stats.thread;
+        row[QStringLiteral("count")]        = stats.count;
+        row[QStringLiteral("totalMsecs")]   = stats.totalNsecs / 1e6;
+        row[QStringLiteral("avgUsecs")]     = (stats.totalNsecs / 1e3) / stats.count;
+        row[QStringLiteral("p50Usecs")]     = stats.p50Nsecs / 1e3;
+        row[QStringLiteral("p95Usecs")]     = stats.p95Nsecs / 1e3;
+        row[QStringLiteral("maxUsecs")]     = stats.maxNsecs / 1e3;
+        _summary.append(row);
+    }
+
+    emit summaryChanged();
+}
+
+void QGCProfiler::reset()
+{
+    Registry *const registry = _registry();
+
+    // A thread recording right now may keep a count from before the reset, which only skews the statistics
+    QMutexLocker lock(&registry->mutex);
+    for (const std::unique_ptr<ThreadRecord> &record : registry->threads) {
+        for (int id = 0; id < kMaxSites; id++) {
+            record->count[id].store(0, std::memory_order_relaxed);
+            record->totalNsecs[id].store(0, std::memory_order_relaxed);
+            record->maxNsecs[id].store(0, std::memory_order_relaxed);
+            for (std::atomic<quint64> &bucket : record->buckets[id]) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+        record->eventsResetAt.store(record->eventsWritten.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    lock.unlock();
+
+    refresh();
+}
+
+QByteArray QGCProfiler::traceJson() const
+{
+    Registry *const registry = _registry();
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+
+    QMutexLocker lock(&registry->mutex);
+    for (const std::unique_ptr<ThreadRecord> &record : registry->threads) {
+        traceEvents.append(QJsonObject {
+            { "name",   "thread_name" },
+            { "ph",     "M" },
+            { "pid",    pid },
+            { "tid",    record->ordinal },
+            { "args",   QJsonObject { { "name", record->name } } },
+        });
+
+        const quint64 written = record->eventsWritten.load(std::memory_order_acquire);
+        const quint64 first = qMax(record->eventsResetAt.load(std::memory_order_relaxed), (written > kTraceEvents) ? (written - kTraceEvents) : 0);
+
+        struct Event { int siteId; qint64 startNsecs; qint64 durationNsecs; };
+        std::vector<Event> events;
+        events.reserve(written - first);
+        for (quint64 index = first; index < written; index++) {
+            const TraceEvent &event = record->events[index % kTraceEvents];
+            events.push_back({ event.siteId.load(std::memory_order_relaxed), event.startNsecs.load(std::memory_order_relaxed), event.durationNsecs.load(std::memory_order_relaxed) });
+        }
+
+        // The thread kept recording while we read. Drop the events it may have overwritten, including the slot
+        // it could be writing right now.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const quint64 writtenAfter = record->eventsWritten.load(std::memory_order_relaxed);
+        const quint64 firstValid = (writtenAfter + 1 > kTraceEvents) ? (writtenAfter + 1 - kTraceEvents) : 0;
+
+        for (quint64 index = qMax(first, firstValid); index < written; index++) {
+            const Event &event = events[index - first];
+            const char *const name = ((event.siteId >= 0) && (event.siteId < kMaxSites)) ? registry->siteNames[event.siteId].load(std::memory_order_acquire) : nullptr;
+            if (!name) {
+                continue;
+            }
+
+            traceEvents.append(QJsonObject {
+                { "name",   QString::fromLatin1(name) },
+                { "cat",    categoryOf(name) },
+                { "ph",     "X" },
+                { "ts",     event.startNsecs / 1e3 },
+                { "dur",    event.durationNsecs / 1e3 },
+                { "pid",    pid },
+                { "tid",    record->ordinal },
+            });
+        }
+    }
+    lock.unlock();
+
+    const QJsonObject root {
+        { "traceEvents",        traceEvents },
+        { "displayTimeUnit",    "ms" },
+    };
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool QGCProfiler::exportTrace(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(QGCProfilerLog) << "Export trace failed" << fileName << file.errorString();
+        return false;
+    }
+
+    const QByteArray json = traceJson();
+    if (file.write(json) != json.size()) {
+        qCWarning(QGCProfilerLog) << "Export trace failed" << fileName << file.errorString();
+        return false;
+    }
+
+    qCDebug(QGCProfilerLog) << "Exported trace" << fileName << json.size() << "bytes";
+    return true;
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QVariantList>
+
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCProfilerLog)
+
+/// Scoped timers and counters for the hot paths of QGC.
+///
+/// A call site is marked with QGC_PROFILE_SCOPE("Class::method") or QGC_PROFILE_COUNT("Name", count). While profiling
+/// is off a site costs a single relaxed atomic load. While it is on, each thread records into its own histograms and
+/// its own ring of trace events, so recording never takes a lock. Readers only take a snapshot. Once a thread exits
+/// its statistics are merged into those kept for earlier threads of the same name, unnamed threads share one entry.
+///
+/// The results are shown on the Profiler settings page and can be exported as Chrome trace json, which opens in
+/// chrome://tracing and in Perfetto.
+class QGCProfiler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool         enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QVariantList summary READ summary NOTIFY summaryChanged)
+
+public:
+    QGCProfiler(QObject *parent = nullptr);
+    ~QGCProfiler();
+
+    static QGCProfiler *instance();
+
+    /// Call site, created once as a function local static by the QGC_PROFILE_* macros
+    class Site
+    {
+    public:
+        Site(const char *name);
+
+        const char *name;
+        int         id;     ///< -1 once the site table is full, the site then records nothing
+    };
+
+    struct SiteStats {
+        QString name;
+        QString thread;
+        quint64 count       = 0;
+        quint64 totalNsecs  = 0;
+        quint64 maxNsecs    = 0;
+        quint64 p50Nsecs    = 0;    ///< Upper bound of the histogram bucket
+        quint64 p95Nsecs    = 0;    ///< Upper bound of the histogram bucket
+    };
+
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    /// Monotonic clock shared by all threads
+    static qint64 nsecsSinceStart();
+
+    /// Records a timed call of the site on the calling thread
+    static void record(const Site &site, qint64 startNsecs, qint64 durationNsecs);
+
+    /// Adds to the count of the site on the calling thread, without timing or a trace event
+    static void count(const Site &site, quint64 count);
+
+    bool enabled() const { return isEnabled(); }
+    void setEnabled(bool enabled);
+
+    /// Statistics per site and thread, sorted by total time
+    QList<SiteStats> stats() const;
+
+    /// Statistics as of the last refresh(), for qml
+    QVariantList summary() const { return _summary; }
+
+    /// Chrome trace json of the recorded events and thread names
+    QByteArray traceJson() const;
+
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE void reset();
+    Q_INVOKABLE bool exportTrace(const QString &fileName) const;
+
+    static constexpr int kMaxSites          = 256;
+    static constexpr int kHistogramBuckets  = 40;       ///< Power of two buckets of nanoseconds, the last one is open
+    static constexpr int kTraceEvents       = 8192;     ///< Most recent events kept per thread
+
+signals:
+    void enabledChanged(bool enabled);
+    void summaryChanged();
+
+private:
+    static std::atomic<bool> _enabled;
+
+    QVariantList _summary;
+};
+
+/// Times the enclosing scope against a site
+class QGCProfileScope
+{
+public:
+    explicit QGCProfileScope(const QGCProfiler::Site &site)
+        : _site(site)
+        , _startNsecs(QGCProfiler::isEnabled() ? QGCProfiler::nsecsSinceStart() : -1)
+    {}
+
+    ~QGCProfileScope()
+    {
+        if (_startNsecs >= 0) {
+            QGCProfiler::record(_site, _startNsecs, QGCProfiler::nsecsSinceStart() - _startNsecs);
+        }
+    }
+
+    QGCProfileScope(const QGCProfileScope&) = delete;
+    QGCProfileScope& operator=(const QGCProfileScope&) = delete;
+
+private:
+    const QGCProfiler::Site &_site;
+    const qint64 _startNsecs;
+};
+
+#define QGC_PROFILE_CONCAT_(a, b) a ## b
+#define QGC_PROFILE_CONCAT(a, b) QGC_PROFILE_CONCAT_(a, b)
+
+/// @def QGC_PROFILE_SCOPE
+/// Times the rest of the enclosing scope under the specified name, a string literal.
+#define QGC_PROFILE_SCOPE(name) \
+    static const QGCProfiler::Site QGC_PROFILE_CONCAT(_qgcProfileSite, __LINE__)(name); \
+    const QGCProfileScope QGC_PROFILE_CONCAT(_qgcProfileScope, __LINE__)(QGC_PROFILE_CONCAT(_qgcProfileSite, __LINE__))
+
+/// @def QGC_PROFILE_COUNT
+/// Adds count to the counter with the specified name, a string literal.
+#define QGC_PROFILE_COUNT(name, count) \
+    do { \
+        static const QGCProfiler::Site _qgcProfileSite(name); \
+        if (QGCProfiler::isEnabled()) { \
+            QGCProfiler::count(_qgcProfileSite, count); \
+        } \
+    } while (false)
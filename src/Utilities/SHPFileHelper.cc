@@ -9,6 +9,7 @@
 
 #include "SHPFileHelper.h"
 #include "QGCGeo.h"
+#include "QGCLoggingCategory.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QDebug>
@@ -94,85 +95,158 @@ ShapeFileHelper::ShapeType SHPFileHelper::determineShapeType(const QString& shpF
 
         SHPGetInfo(shpHandle, &cEntities /* pnEntities */, &type, Q_NULLPTR /* padfMinBound */, Q_NULLPTR /* padfMaxBound */);
         qDebug() << "SHPGetInfo" << shpHandle << cEntities << type;
-        if (cEntities != 1) {
-            errorString = QString(_errorPrefix).arg(tr("More than one entity found."));
-        } else if (type == SHPT_POLYGON) {
+        if (cEntities < 1) {
+            errorString = QString(_errorPrefix).arg(tr("No entities found."));
+        } else if (_isPolygonType(type)) {
             shapeType = ShapeFileHelper::Polygon;
         } else {
             errorString = QString(_errorPrefix).arg(tr("No supported types found."));
         }
     }
 
-    SHPClose(shpHandle);
+    if (shpHandle) {
+        SHPClose(shpHandle);
+    }
 
     return shapeType;
 }
 
-bool SHPFileHelper::loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordinate>& vertices, QString& errorString)
+bool SHPFileHelper::_isPolygonType(int shapeType)
+{
+    return (shapeType == SHPT_POLYGON) || (shapeType == SHPT_POLYGONZ) || (shapeType == SHPT_POLYGONM);
+}
+
+/// Even-odd point in polygon test against the ring formed by vertices [firstVertex, lastVertex) of the object
+bool SHPFileHelper::_ringContains(const SHPObject* shpObject, int firstVertex, int lastVertex, double x, double y)
+{
+    bool inside = false;
+
+    for (int i=firstVertex, j=lastVertex-1; i<lastVertex; j=i++) {
+        const double xi = shpObject->padfX[i];
+        const double yi = shpObject->padfY[i];
+        const double xj = shpObject->padfX[j];
+        const double yj = shpObject->padfY[j];
+        if (((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi) + xi)) {
+            inside = !inside;
+        }
+    }
+
+    return inside;
+}
+
+bool SHPFileHelper::loadPolygonsFromFile(const QString& shpFile, QList<QList<QGeoCoordinate>>& polygons, QString& errorString)
 {
     int         utmZone = 0;
-    bool        utmSouthernHemisphere;
+    bool        utmSouthernHemisphere = false;
     double      vertexFilterMeters = 5;
-    SHPHandle   shpHandle = Q_NULLPTR;
-    SHPObject*  shpObject = Q_NULLPTR;
 
     errorString.clear();
-    vertices.clear();
+    polygons.clear();
 
-    shpHandle = SHPFileHelper::_loadShape(shpFile, &utmZone, &utmSouthernHemisphere, errorString);
+    SHPHandle shpHandle = SHPFileHelper::_loadShape(shpFile, &utmZone, &utmSouthernHemisphere, errorString);
     if (!errorString.isEmpty()) {
-        goto Error;
+        return false;
     }
 
     int cEntities, shapeType;
     SHPGetInfo(shpHandle, &cEntities, &shapeType, Q_NULLPTR /* padfMinBound */, Q_NULLPTR /* padfMaxBound */);
-    if (shapeType != SHPT_POLYGON) {
+    if (!_isPolygonType(shapeType)) {
         errorString = QString(_errorPrefix).arg(tr("File does not contain a polygon."));
-        goto Error;
+        SHPClose(shpHandle);
+        return false;
     }
 
-    shpObject = SHPReadObject(shpHandle, 0);
-    if (shpObject->nParts != 1) {
-        errorString = QString(_errorPrefix).arg(tr("Only single part polygons are supported."));
-        goto Error;
-    }
+    // Objects are read and released one at a time so only a single entity is ever held in memory
+    for (int entity=0; entity<cEntities; entity++) {
+        SHPObject* shpObject = SHPReadObject(shpHandle, entity);
+        if (!shpObject) {
+            qCWarning(ShapeFileHelperLog) << "SHPReadObject failed for entity" << entity;
+            continue;
+        }
 
-    for (int i=0; i<shpObject->nVertices; i++) {
-        QGeoCoordinate coord;
-        if (!utmZone || !QGCGeo::convertUTMToGeo(shpObject->padfX[i], shpObject->padfY[i], utmZone, utmSouthernHemisphere, coord)) {
-            coord.setLatitude(shpObject->padfY[i]);
-            coord.setLongitude(shpObject->padfX[i]);
+        // Ring winding is not reliable in the wild, so rings are classified by containment instead: a ring inside an
+        // odd number of the entity's other rings is a hole, anything else (including an island in a hole) is an
+        // outer ring. QGC polygons can't have holes so those are skipped.
+        const int cParts = qMax(shpObject->nParts, 1);
+        QList<QPair<int, int>> rings;
+        rings.reserve(cParts);
+        for (int part=0; part<cParts; part++) {
+            const int firstVertex = shpObject->nParts ? shpObject->panPartStart[part] : 0;
+            const int lastVertex = (part + 1 < shpObject->nParts) ? shpObject->panPartStart[part + 1] : shpObject->nVertices;
+            if (lastVertex - firstVertex >= 3) {
+                rings.append(qMakePair(firstVertex, lastVertex));
+            }
         }
-        vertices.append(coord);
-    }
 
-    // Filter last vertex such that it differs from first
-    {
-        QGeoCoordinate firstVertex = vertices[0];
+        for (int ring=0; ring<rings.count(); ring++) {
+            const int firstVertex = rings[ring].first;
+            const int lastVertex = rings[ring].second;
 
-        while (vertices.count() > 3 && vertices.last().distanceTo(firstVertex) < vertexFilterMeters) {
-            vertices.removeLast();
-        }
-    }
+            int containingRings = 0;
+            for (int other=0; other<rings.count(); other++) {
+                if ((other != ring) && _ringContains(shpObject, rings[other].first, rings[other].second, shpObject->padfX[firstVertex], shpObject->padfY[firstVertex])) {
+                    containingRings++;
+                }
+            }
+            if (containingRings % 2) {
+                continue;
+            }
 
-    // Filter vertex distances to be larger than 1 meter apart
-    {
-        int i = 0;
-        while (i < vertices.count() - 2) {
-            if (vertices[i].distanceTo(vertices[i+1]) < vertexFilterMeters) {
-                vertices.removeAt(i+1);
-            } else {
-                i++;
+            QList<QGeoCoordinate> vertices;
+            vertices.reserve(lastVertex - firstVertex);
+            for (int i=firstVertex; i<lastVertex; i++) {
+                QGeoCoordinate coord;
+                if (!utmZone || !QGCGeo::convertUTMToGeo(shpObject->padfX[i], shpObject->padfY[i], utmZone, utmSouthernHemisphere, coord)) {
+                    coord.setLatitude(shpObject->padfY[i]);
+                    coord.setLongitude(shpObject->padfX[i]);
+                }
+                vertices.append(coord);
+            }
+
+            // Filter last vertex such that it differs from first
+            while (vertices.count() > 3 && vertices.last().distanceTo(vertices.first()) < vertexFilterMeters) {
+                vertices.removeLast();
+            }
+
+            // Filter vertex distances to be larger than vertexFilterMeters apart. Runs whatever the simplification
+            // tolerance, which is applied on top of this by the caller.
+            {
+                int i = 0;
+                while (i < vertices.count() - 2) {
+                    if (vertices[i].distanceTo(vertices[i+1]) < vertexFilterMeters) {
+                        vertices.removeAt(i+1);
+                    } else {
+                        i++;
+                    }
+                }
+            }
+
+            if (vertices.count() >= 3) {
+                polygons.append(vertices);
             }
         }
-    }
 
-Error:
-    if (shpObject) {
         SHPDestroyObject(shpObject);
     }
-    if (shpHandle) {
-        SHPClose(shpHandle);
+
+    SHPClose(shpHandle);
+
+    if (polygons.isEmpty()) {
+        errorString = QString(_errorPrefix).arg(tr("File does not contain a polygon."));
     }
+
     return errorString.isEmpty();
 }
+
+bool SHPFileHelper::loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordinate>& vertices, QString& errorString)
+{
+    QList<QList<QGeoCoordinate>> polygons;
+
+    vertices.clear();
+    if (!loadPolygonsFromFile(shpFile, polygons, errorString)) {
+        return false;
+    }
+
+    vertices = polygons.first();
+    return true;
+}
@@ -27,7 +27,12 @@ public:
     static ShapeFileHelper::ShapeType determineShapeType(const QString& shpFile, QString& errorString);
     static bool loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordinate>& vertices, QString& errorString);
 
+    /// Loads the outer rings of every entity in the file. Holes, rings inside an odd number of the entity's other rings, are skipped.
+    static bool loadPolygonsFromFile(const QString& shpFile, QList<QList<QGeoCoordinate>>& polygons, QString& errorString);
+
 private:
+    static bool         _isPolygonType(int shapeType);
+    static bool         _ringContains(const SHPObject* shpObject, int firstVertex, int lastVertex, double x, double y);
     static bool         _validateSHPFiles(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
     static SHPHandle    _loadShape(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
 
@@ -10,8 +10,18 @@
 #include "ShapeFileHelper.h"
 #include "AppSettings.h"
 #include "KMLHelper.h"
+#include "PlanViewSettings.h"
+#include "QGCGeo.h"
+#include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
 #include "SHPFileHelper.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(ShapeFileHelperLog, "qgc.utilities.shapefilehelper")
+
 QVariantList ShapeFileHelper::determineShapeType(const QString& file)
 {
     QString errorString;
@@ -57,42 +67,298 @@ ShapeFileHelper::ShapeType ShapeFileHelper::determineShapeType(const QString& fi
     return shapeType;
 }
 
-bool ShapeFileHelper::loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString)
+bool ShapeFileHelper::loadPolygonsFromFile(const QString& file, double toleranceMeters, QList<QList<QGeoCoordinate>>& polygons, QString& errorString)
 {
     bool success = false;
 
     errorString.clear();
-    vertices.clear();
+    polygons.clear();
 
     bool fileIsKML = _fileIsKML(file, errorString);
     if (errorString.isEmpty()) {
         if (fileIsKML) {
-            success = KMLHelper::loadPolygonFromFile(file, vertices, errorString);
+            success = KMLHelper::loadPolygonsFromFile(file, polygons, errorString);
         } else {
-            success = SHPFileHelper::loadPolygonFromFile(file, vertices, errorString);
+            success = SHPFileHelper::loadPolygonsFromFile(file, polygons, errorString);
+        }
+    }
+
+    if (success) {
+        for (QList<QGeoCoordinate>& polygon : polygons) {
+            polygon = simplify(polygon, toleranceMeters, true /* closed */);
         }
     }
 
     return success;
 }
 
-bool ShapeFileHelper::loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString)
+bool ShapeFileHelper::loadPolylinesFromFile(const QString& file, double toleranceMeters, QList<QList<QGeoCoordinate>>& polylines, QString& errorString)
 {
     errorString.clear();
-    coords.clear();
+    polylines.clear();
 
     bool fileIsKML = _fileIsKML(file, errorString);
     if (errorString.isEmpty()) {
         if (fileIsKML) {
-            KMLHelper::loadPolylineFromFile(file, coords, errorString);
+            KMLHelper::loadPolylinesFromFile(file, polylines, errorString);
         } else {
             errorString = QString(_errorPrefix).arg(tr("Polyline not support from SHP files."));
         }
     }
 
+    if (errorString.isEmpty()) {
+        for (QList<QGeoCoordinate>& polyline : polylines) {
+            polyline = simplify(polyline, toleranceMeters, false /* closed */);
+        }
+    }
+
     return errorString.isEmpty();
 }
 
+bool ShapeFileHelper::loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString, int polygonIndex, double toleranceMeters)
+{
+    QList<QList<QGeoCoordinate>> polygons;
+
+    vertices.clear();
+
+    if (!loadPolygonsFromFile(file, toleranceMeters, polygons, errorString)) {
+        return false;
+    }
+    if (polygonIndex < 0 || polygonIndex >= polygons.count()) {
+        errorString = QString(_errorPrefix).arg(tr("Polygon %1 not found. File contains %2 polygons.").arg(polygonIndex + 1).arg(polygons.count()));
+        return false;
+    }
+
+    vertices = polygons[polygonIndex];
+
+    return true;
+}
+
+bool ShapeFileHelper::loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString, int polylineIndex, double toleranceMeters)
+{
+    QList<QList<QGeoCoordinate>> polylines;
+
+    coords.clear();
+
+    if (!loadPolylinesFromFile(file, toleranceMeters, polylines, errorString)) {
+        return false;
+    }
+    if (polylineIndex < 0 || polylineIndex >= polylines.count()) {
+        errorString = QString(_errorPrefix).arg(tr("Polyline %1 not found. File contains %2 polylines.").arg(polylineIndex + 1).arg(polylines.count()));
+        return false;
+    }
+
+    coords = polylines[polylineIndex];
+
+    return true;
+}
+
+QFuture<ShapeFileHelper::LoadResult> ShapeFileHelper::loadShapesFromFileAsync(const QString& file, ShapeType shapeType, double toleranceMeters)
+{
+    return QtConcurrent::run([file, shapeType, toleranceMeters]() {
+        LoadResult result;
+        if (shapeType == Polygon) {
+            (void) loadPolygonsFromFile(file, toleranceMeters, result.shapes, result.errorString);
+        } else {
+            (void) loadPolylinesFromFile(file, toleranceMeters, result.shapes, result.errorString);
+        }
+        return result;
+    });
+}
+
+double ShapeFileHelper::simplifyToleranceSetting(void)
+{
+    return SettingsManager::instance()->planViewSettings()->shapeSimplifyTolerance()->rawValue().toDouble();
+}
+
+QList<QGeoCoordinate> ShapeFileHelper::simplify(const QList<QGeoCoordinate>& coords, double toleranceMeters, bool closed)
+{
+    const int minVertices = closed ? 3 : 2;
+    if (toleranceMeters <= 0 || coords.count() <= minVertices) {
+        return coords;
+    }
+
+    // Work in a local tangent plane. For closed rings the first point is repeated at the end so the ring can be
+    // handled as two open ranges anchored at the first point and the point farthest from it.
+    QList<QPointF> points = QGCGeo::convertGeoToNed(coords, coords[0]);
+    if (closed) {
+        points.append(points[0]);
+    }
+    const int lastIndex = points.count() - 1;
+    const double tolerance2 = toleranceMeters * toleranceMeters;
+
+    QList<bool> keep(points.count(), false);
+    keep[0] = true;
+    keep[lastIndex] = true;
+    if (closed) {
+        int farthestIndex = 1;
+        double farthestDistance2 = 0;
+        for (int i=1; i<lastIndex; i++) {
+            const QPointF delta = points[i] - points[0];
+            const double distance2 = QPointF::dotProduct(delta, delta);
+            if (distance2 > farthestDistance2) {
+                farthestDistance2 = distance2;
+                farthestIndex = i;
+            }
+        }
+        keep[farthestIndex] = true;
+        _simplifyRange(points, 0, farthestIndex, tolerance2, keep);
+        _simplifyRange(points, farthestIndex, lastIndex, tolerance2, keep);
+    } else {
+        _simplifyRange(points, 0, lastIndex, tolerance2, keep);
+    }
+
+    // Plain Douglas-Peucker can introduce self intersections. Re-add the farthest source vertex to every simplified
+    // segment involved in an intersection until none are left. This terminates since fully refined segments
+    // match the source shape.
+    while (true) {
+        QList<int> kept;
+        for (int i=0; i<keep.count(); i++) {
+            if (keep[i]) {
+                kept.append(i);
+            }
+        }
+
+        bool refined = false;
+        for (int segment : _intersectingSegments(points, kept, closed)) {
+            const int first = kept[segment];
+            const int last = kept[segment + 1];
+            if (last - first > 1) {
+                _simplifyRange(points, first, last, -1 /* refine a single level */, keep);
+                refined = true;
+            }
+        }
+        if (!refined) {
+            break;
+        }
+    }
+
+    QList<QGeoCoordinate> result;
+    for (int i=0; i<coords.count(); i++) {
+        if (keep[i]) {
+            result.append(coords[i]);
+        }
+    }
+
+    if (result.count() < minVertices) {
+        // Whole shape is within tolerance of a single line, simplification would make it degenerate
+        return coords;
+    }
+
+    qCDebug(ShapeFileHelperLog) << "simplify" << coords.count() << "->" << result.count() << "tolerance" << toleranceMeters;
+
+    return result;
+}
+
+/// Marks the points to keep between first and last (exclusive) using Douglas-Peucker.
+///     @param tolerance2 Squared tolerance. Negative values only mark the single farthest point without recursing.
+void ShapeFileHelper::_simplifyRange(const QList<QPointF>& points, int first, int last, double tolerance2, QList<bool>& keep)
+{
+    // Iterative to keep stack usage flat on very large inputs
+    QList<std::pair<int, int>> ranges;
+    ranges.append({ first, last });
+
+    while (!ranges.isEmpty()) {
+        const auto [rangeFirst, rangeLast] = ranges.takeLast();
+        if (rangeLast - rangeFirst < 2) {
+            continue;
+        }
+
+        const QPointF& a = points[rangeFirst];
+        const QPointF ab = points[rangeLast] - a;
+        const double abLength2 = QPointF::dotProduct(ab, ab);
+
+        int farthestIndex = -1;
+        double farthestDistance2 = -1;
+        for (int i=rangeFirst+1; i<rangeLast; i++) {
+            const QPointF ap = points[i] - a;
+            const double t = (abLength2 > 0) ? qBound(0.0, QPointF::dotProduct(ap, ab) / abLength2, 1.0) : 0.0;
+            const QPointF delta = ap - (ab * t);
+            const double distance2 = QPointF::dotProduct(delta, delta);
+            if (distance2 > farthestDistance2) {
+                farthestDistance2 = distance2;
+                farthestIndex = i;
+            }
+        }
+
+        if (tolerance2 < 0) {
+            keep[farthestIndex] = true;
+        } else if (farthestDistance2 > tolerance2) {
+            keep[farthestIndex] = true;
+            ranges.append({ rangeFirst, farthestIndex });
+            ranges.append({ farthestIndex, rangeLast });
+        }
+    }
+}
+
+bool ShapeFileHelper::_segmentsIntersect(const QPointF& p1, const QPointF& p2, const QPointF& p3, const QPointF& p4)
+{
+    auto orientation = [](const QPointF& a, const QPointF& b, const QPointF& c) {
+        const double cross = ((b.x() - a.x()) * (c.y() - a.y())) - ((b.y() - a.y()) * (c.x() - a.x()));
+        return (cross > 0) - (cross < 0);
+    };
+    auto onSegment = [](const QPointF& a, const QPointF& b, const QPointF& p) {
+        return (p.x() >= qMin(a.x(), b.x())) && (p.x() <= qMax(a.x(), b.x())) && (p.y() >= qMin(a.y(), b.y())) && (p.y() <= qMax(a.y(), b.y()));
+    };
+
+    const int o1 = orientation(p1, p2, p3);
+    const int o2 = orientation(p1, p2, p4);
+    const int o3 = orientation(p3, p4, p1);
+    const int o4 = orientation(p3, p4, p2);
+
+    if ((o1 != o2) && (o3 != o4)) {
+        return true;
+    }
+
+    // Collinear touching cases
+    return ((o1 == 0) && onSegment(p1, p2, p3)) ||
+           ((o2 == 0) && onSegment(p1, p2, p4)) ||
+           ((o3 == 0) && onSegment(p3, p4, p1)) ||
+           ((o4 == 0) && onSegment(p3, p4, p2));
+}
+
+/// @return Indices into kept of the simplified segments (kept[i], kept[i+1]) which intersect a non-adjacent segment
+QList<int> ShapeFileHelper::_intersectingSegments(const QList<QPointF>& points, const QList<int>& kept, bool closed)
+{
+    const int segmentCount = kept.count() - 1;
+
+    // Sweep along x so only segments with overlapping x extents are tested against each other
+    QList<int> order(segmentCount);
+    for (int i=0; i<segmentCount; i++) {
+        order[i] = i;
+    }
+    auto minX = [&](int segment) { return qMin(points[kept[segment]].x(), points[kept[segment + 1]].x()); };
+    auto maxX = [&](int segment) { return qMax(points[kept[segment]].x(), points[kept[segment + 1]].x()); };
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return minX(a) < minX(b); });
+
+    QList<bool> intersecting(segmentCount, false);
+    QList<int> active;
+    for (int segment : order) {
+        const double segmentMinX = minX(segment);
+        active.removeIf([&](int other) { return maxX(other) < segmentMinX; });
+
+        const QPointF& p1 = points[kept[segment]];
+        const QPointF& p2 = points[kept[segment + 1]];
+        for (int other : active) {
+            const int distance = qAbs(segment - other);
+            const bool adjacent = (distance == 1) || (closed && (distance == segmentCount - 1));
+            if (!adjacent && _segmentsIntersect(p1, p2, points[kept[other]], points[kept[other + 1]])) {
+                intersecting[segment] = true;
+                intersecting[other] = true;
+            }
+        }
+        active.append(segment);
+    }
+
+    QList<int> result;
+    for (int i=0; i<segmentCount; i++) {
+        if (intersecting[i]) {
+            result.append(i);
+        }
+    }
+    return result;
+}
+
 QStringList ShapeFileHelper::fileDialogKMLFilters(void) const
 {
     return QStringList(tr("KML Files (*.%1)").arg(AppSettings::kmlFileExtension));
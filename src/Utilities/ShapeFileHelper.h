@@ -9,11 +9,16 @@
 
 #pragma once
 
-#include <QtCore/QObject>
+#include <QtCore/QFuture>
 #include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QPointF>
 #include <QtCore/QVariant>
 #include <QtPositioning/QGeoCoordinate>
 
+Q_DECLARE_LOGGING_CATEGORY(ShapeFileHelperLog)
+
 /// Routines for loading polygons or polylines from KML or SHP files.
 class ShapeFileHelper : public QObject
 {
@@ -37,12 +42,41 @@ public:
     QStringList fileDialogKMLFilters        (void) const;
     QStringList fileDialogKMLOrSHPFilters   (void) const;
 
+    /// Result of a background shape load
+    struct LoadResult {
+        QList<QList<QGeoCoordinate>>    shapes;
+        QString                         errorString;
+    };
+
     static ShapeType determineShapeType(const QString& file, QString& errorString);
-    static bool loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString);
-    static bool loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString);
+
+    /// Loads a single polygon from the file.
+    ///     @param polygonIndex Polygon to load if the file contains more than one
+    ///     @param toleranceMeters Simplification tolerance, 0 for no simplification
+    static bool loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString, int polygonIndex = 0, double toleranceMeters = 0);
+    static bool loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString, int polylineIndex = 0, double toleranceMeters = 0);
+
+    /// Loads all polygons/polylines from the file, each simplified to toleranceMeters. Safe to call from any thread.
+    static bool loadPolygonsFromFile(const QString& file, double toleranceMeters, QList<QList<QGeoCoordinate>>& polygons, QString& errorString);
+    static bool loadPolylinesFromFile(const QString& file, double toleranceMeters, QList<QList<QGeoCoordinate>>& polylines, QString& errorString);
+
+    /// Runs loadPolygonsFromFile or loadPolylinesFromFile on the global thread pool
+    ///     @param shapeType Polygon or Polyline
+    static QFuture<LoadResult> loadShapesFromFileAsync(const QString& file, ShapeType shapeType, double toleranceMeters);
+
+    /// Douglas-Peucker simplification which preserves topology: the result never self intersects where the source
+    /// did not. Vertices are removed only if they are within toleranceMeters of the simplified shape.
+    ///     @param closed true: coords are a polygon ring, false: coords are a polyline
+    static QList<QGeoCoordinate> simplify(const QList<QGeoCoordinate>& coords, double toleranceMeters, bool closed);
+
+    /// Simplification tolerance from the plan view settings
+    static double simplifyToleranceSetting(void);
 
 private:
     static bool _fileIsKML(const QString& file, QString& errorString);
+    static void _simplifyRange(const QList<QPointF>& points, int first, int last, double tolerance2, QList<bool>& keep);
+    static bool _segmentsIntersect(const QPointF& p1, const QPointF& p2, const QPointF& p3, const QPointF& p4);
+    static QList<int> _intersectingSegments(const QList<QPointF>& points, const QList<int>& kept, bool closed);
 
     static constexpr const char* _errorPrefix = QT_TR_NOOP("Shape file load failed. %1");
 };
@@ -8,7 +8,7 @@
  ****************************************************************************/
 
 #include "CompInfoParam.h"
-#include "JsonHelper.h"
+#include "ComponentInformationCache.h"
 #include "FactMetaData.h"
 #include "FirmwarePlugin.h"
 #include "FirmwarePluginManager.h"
@@ -16,8 +16,6 @@
 #include "QGCLoggingCategory.h"
 #include "Vehicle.h"
 
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonArray>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QRegularExpressionMatch>
 #include <QtCore/QDir>
@@ -40,49 +38,14 @@ void CompInfoParam::setJson(const QString& metadataJsonFileName)
         return;
     }
 
-    QString         errorString;
-    QJsonDocument   jsonDoc;
-
     _noJsonMetadata = false;
 
-    if (!JsonHelper::isJsonFile(metadataJsonFileName, jsonDoc, errorString)) {
-        qCWarning(CompInfoParamLog) << "Metadata json file open failed: compid:" << compId << errorString;
-        return;
-    }
-    QJsonObject jsonObj = jsonDoc.object();
-
-    QList<JsonHelper::KeyValidateInfo> keyInfoList = {
-        { JsonHelper::jsonVersionKey,   QJsonValue::Double, true },
-        { _jsonParametersKey,           QJsonValue::Array,  true },
-    };
-    if (!JsonHelper::validateKeys(jsonObj, keyInfoList, errorString)) {
-        qCWarning(CompInfoParamLog) << "Metadata json validation failed: compid:" << compId << errorString;
-        return;
-    }
-
-    int version = jsonObj[JsonHelper::jsonVersionKey].toInt();
-    if (version != 1) {
-        qCWarning(CompInfoParamLog) << "Metadata json unsupported version" << version;
+    QString errorString;
+    if (!_index.load(metadataJsonFileName, ComponentInformationCache::defaultInstance(), errorString)) {
+        qCWarning(CompInfoParamLog) << "Metadata json load failed: compid:" << compId << errorString;
         return;
     }
-
-    QJsonArray rgParameters = jsonObj[_jsonParametersKey].toArray();
-    for (QJsonValue parameterValue: rgParameters) {
-        QMap<QString, QString> emptyDefineMap;
-
-        if (!parameterValue.isObject()) {
-            qCWarning(CompInfoParamLog) << "Metadata json read failed: compid:" << compId << "parameters array contains non-object";
-            return;
-        }
-
-        FactMetaData* newMetaData = FactMetaData::createFromJsonObject(parameterValue.toObject(), emptyDefineMap, this);
-
-        if (newMetaData->name().contains(_indexedNameTag)) {
-            _indexedNameMetaDataList.append(RegexFactMetaDataPair_t(newMetaData->name(), newMetaData));
-        } else {
-            _nameToMetaDataMap[newMetaData->name()] = newMetaData;
-        }
-    }
+    qCDebug(CompInfoParamLog) << "Metadata for" << _index.count() << "params and" << _index.indexedCount() << "indexed params";
 }
 
 FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaData::ValueType_t type)
@@ -100,27 +63,27 @@ FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaDa
         if (_nameToMetaDataMap.contains(name)) {
             factMetaData = _nameToMetaDataMap[name];
         } else {
-            // We didn't get any direct matches. Try an indexed name.
-            for (int i=0; i<_indexedNameMetaDataList.count(); i++) {
-                const RegexFactMetaDataPair_t& pair = _indexedNameMetaDataList[i];
+            QMap<QString, QString> emptyDefineMap;
+            const QByteArray utf8Name = name.toUtf8();
 
-                QString indexedName = pair.first;
-                const QString indexedRegex("(\\d+)");
-                indexedName.replace(_indexedNameTag, indexedRegex);
-
-                const QRegularExpression      regex(indexedName);
-                const QRegularExpressionMatch match = regex.match(name);
+            const int entry = _index.find(utf8Name);
+            if (entry >= 0) {
+                factMetaData = FactMetaData::createFromJsonObject(_index.jsonObject(entry), emptyDefineMap, this);
+            } else {
+                // We didn't get any direct matches. Try an indexed name.
+                QByteArrayView index;
+                const int indexedEntry = _index.matchIndexed(utf8Name, &index);
+                if (indexedEntry >= 0) {
+                    const QString indexString = QString::fromUtf8(index);
 
-                const QStringList captured = match.capturedTexts();
-                if (captured.count() == 2) {
-                    factMetaData = new FactMetaData(*pair.second, this);
+                    factMetaData = FactMetaData::createFromJsonObject(_index.indexedJsonObject(indexedEntry), emptyDefineMap, this);
                     factMetaData->setName(name);
 
                     QString shortDescription = factMetaData->shortDescription();
-                    shortDescription.replace(_indexedNameTag, captured[1]);
+                    shortDescription.replace(CompInfoParamIndex::kIndexedNameTag, indexString);
                     factMetaData->setShortDescription(shortDescription);
-                    QString longDescription = factMetaData->shortDescription();
-                    longDescription.replace(_indexedNameTag, captured[1]);
+                    QString longDescription = factMetaData->longDescription();
+                    longDescription.replace(CompInfoParamIndex::kIndexedNameTag, indexString);
                     factMetaData->setLongDescription(longDescription);
                 }
             }
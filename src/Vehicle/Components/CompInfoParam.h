@@ -10,6 +10,7 @@
 #pragma once
 
 #include "CompInfo.h"
+#include "CompInfoParamIndex.h"
 #include "QGCMAVLink.h"
 #include "FactMetaData.h"
 
@@ -41,14 +42,10 @@ private:
     static FirmwarePlugin*  _anyVehicleTypeFirmwarePlugin   (MAV_AUTOPILOT firmwareType);
     static QString          _parameterMetaDataFile          (Vehicle* vehicle, MAV_AUTOPILOT firmwareType, int& majorVersion, int& minorVersion);
 
-    typedef QPair<QString /* indexed name */, FactMetaData*> RegexFactMetaDataPair_t;
-
     bool                                _noJsonMetadata             = true;
-    FactMetaData::NameToMetaDataMap_t   _nameToMetaDataMap;
-    QList<RegexFactMetaDataPair_t>      _indexedNameMetaDataList;
+    CompInfoParamIndex                  _index;                     ///< Json metadata, decoded as parameters are asked for
+    FactMetaData::NameToMetaDataMap_t   _nameToMetaDataMap;         ///< Metadata handed out so far
     QObject*                            _opaqueParameterMetaData    = nullptr;
 
-    static constexpr const char* _jsonParametersKey           = "parameters";
     static constexpr const char* _cachedMetaDataFilePrefix    = "ParameterFactMetaData";
-    static constexpr const char* _indexedNameTag              = "{n}";
 };
@@ -0,0 +1,443 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CompInfoParamIndex.h"
+#include "ComponentInformationCache.h"
+#include "JsonHelper.h"
+#include "MAVLinkLib.h"
+#include "QGC.h"
+#include "QGCLoggingCategory.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QCborValue>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(CompInfoParamIndexLog, "CompInfoParamIndexLog")
+
+namespace {
+
+constexpr const char* kJsonParametersKey = "parameters";
+constexpr const char* kJsonNameKey = "name";
+
+void appendWord(QByteArray& bytes, quint32 value)
+{
+    char word[sizeof(quint32)];
+    qToLittleEndian(value, word);
+    bytes.append(word, sizeof(word));
+}
+
+/// Byte wise ordering, the same for compile and lookup
+bool nameLess(QByteArrayView a, QByteArrayView b)
+{
+    const int result = std::memcmp(a.data(), b.data(), static_cast<size_t>(qMin(a.size(), b.size())));
+    return (result < 0) || ((result == 0) && (a.size() < b.size()));
+}
+
+} // namespace
+
+CompInfoParamIndex::~CompInfoParamIndex()
+{
+    close();
+}
+
+QString CompInfoParamIndex::cacheTag(QByteArrayView json)
+{
+    const quint32 crc = QGC::crc32(reinterpret_cast<const quint8*>(json.data()), static_cast<unsigned>(json.size()), 0);
+    return QString::asprintf("%08x_%02i_index", crc, COMP_METADATA_TYPE_PARAMETER);
+}
+
+bool CompInfoParamIndex::compile(QByteArrayView json, QByteArray& index, QString& errorString)
+{
+    QJsonParseError parseError;
+    const QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray::fromRawData(json.data(), json.size()), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        errorString = parseError.errorString();
+        return false;
+    }
+    const QJsonObject jsonObj = jsonDoc.object();
+
+    const QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+        { JsonHelper::jsonVersionKey,   QJsonValue::Double, true },
+        { kJsonParametersKey,           QJsonValue::Array,  true },
+    };
+    if (!JsonHelper::validateKeys(jsonObj, keyInfoList, errorString)) {
+        return false;
+    }
+
+    const int version = jsonObj[JsonHelper::jsonVersionKey].toInt();
+    if (version != 1) {
+        errorString = QStringLiteral("Unsupported version %1").arg(version);
+        return false;
+    }
+
+    struct Indexed {
+        QByteArray prefix;
+        QByteArray suffix;
+        QByteArray data;
+    };
+
+    // Later definitions of the same name replace earlier ones
+    QMap<QByteArray, QByteArray> entries;
+    QList<Indexed> indexed;
+
+    const QJsonArray rgParameters = jsonObj[kJsonParametersKey].toArray();
+    for (const QJsonValue& parameterValue : rgParameters) {
+        if (!parameterValue.isObject()) {
+            errorString = QStringLiteral("parameters array contains non-object");
+            return false;
+        }
+
+        const QJsonObject parameterObj = parameterValue.toObject();
+        const QByteArray name = parameterObj[kJsonNameKey].toString().toUtf8();
+        const QByteArray data = QCborValue::fromJsonValue(parameterObj).toCbor();
+
+        const qsizetype tagIndex = name.indexOf(kIndexedNameTag);
+        if (tagIndex < 0) {
+            entries[name] = data;
+            continue;
+        }
+
+        const QByteArray suffix = name.mid(tagIndex + qstrlen(kIndexedNameTag));
+        if (suffix.contains(kIndexedNameTag)) {
+            qCWarning(CompInfoParamIndexLog) << "Ignoring name with more than one index" << name;
+            continue;
+        }
+        indexed.append({ name.left(tagIndex), suffix, data });
+    }
+
+    QByteArray blob;
+    QByteArray entryTable;
+    QByteArray indexedTable;
+    const auto appendBlob = [&blob](QByteArray& table, const QByteArray& bytes) {
+        appendWord(table, static_cast<quint32>(blob.size()));
+        appendWord(table, static_cast<quint32>(bytes.size()));
+        blob.append(bytes);
+    };
+
+    // QMap keeps the names in byte order already, which is what find() expects
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        appendBlob(entryTable, it.key());
+        appendBlob(entryTable, it.value());
+    }
+    for (const Indexed& entry : std::as_const(indexed)) {
+        appendBlob(indexedTable, entry.prefix);
+        appendBlob(indexedTable, entry.suffix);
+        appendBlob(indexedTable, entry.data);
+    }
+
+    const quint32 entryTableOffset = kHeaderWords * sizeof(quint32);
+    const quint32 indexedTableOffset = entryTableOffset + static_cast<quint32>(entryTable.size());
+    const quint32 blobOffset = indexedTableOffset + static_cast<quint32>(indexedTable.size());
+
+    index.clear();
+    index.reserve(blobOffset + blob.size());
+    appendWord(index, kMagic);
+    appendWord(index, kVersion);
+    appendWord(index, static_cast<quint32>(entries.count()));
+    appendWord(index, static_cast<quint32>(indexed.count()));
+    appendWord(index, entryTableOffset);
+    appendWord(index, indexedTableOffset);
+    appendWord(index, blobOffset);
+    appendWord(index, static_cast<quint32>(blob.size()));
+    index.append(entryTable);
+    index.append(indexedTable);
+    index.append(blob);
+
+    return true;
+}
+
+bool CompInfoParamIndex::load(const QString& jsonFileName, ComponentInformationCache& cache, QString& errorString)
+{
+    close();
+
+    QFile jsonFile(jsonFileName);
+    if (!jsonFile.open(QIODevice::ReadOnly)) {
+        errorString = jsonFile.errorString();
+        return false;
+    }
+
+    QByteArray jsonBytes;
+    QByteArrayView json;
+    const qint64 jsonSize = jsonFile.size();
+    const uchar* const jsonMap = (jsonSize > 0) ? jsonFile.map(0, jsonSize) : nullptr;
+    if (jsonMap) {
+        json = QByteArrayView(jsonMap, jsonSize);
+    } else {
+        jsonBytes = jsonFile.readAll();
+        json = jsonBytes;
+    }
+
+    const QString tag = cacheTag(json);
+    const QString cachedFile = cache.access(tag);
+    if (!cachedFile.isEmpty()) {
+        if (open(cachedFile)) {
+            qCDebug(CompInfoParamIndexLog) << "Using cached index" << cachedFile;
+            return true;
+        }
+        qCWarning(CompInfoParamIndexLog) << "Cached index unusable" << cachedFile;
+    }
+
+    QByteArray index;
+    if (!compile(json, index, errorString)) {
+        return false;
+    }
+
+    if (cachedFile.isEmpty()) {
+        // The cache moves the file into place. Other vehicles, or another instance, may be compiling the same
+        // metadata at the same time, so the temp file must not be shared with them.
+        QGCTemporaryFile tempFile(QStringLiteral("%1.%2.XXXXXX").arg(tag).arg(QCoreApplication::applicationPid()));
+        if (tempFile.open(QIODevice::WriteOnly | QIODevice::NewOnly) && (tempFile.write(index) == index.size())) {
+            tempFile.close();
+            const QString indexFileName = cache.insert(tag, tempFile.fileName());
+            if (!indexFileName.isEmpty() && open(indexFileName)) {
+                qCDebug(CompInfoParamIndexLog) << "Compiled and cached index" << indexFileName;
+                return true;
+            }
+        } else {
+            qCWarning(CompInfoParamIndexLog) << "Index write failed" << tempFile.fileName() << tempFile.errorString();
+            tempFile.remove();
+        }
+    } else {
+        // Replace the damaged entry so that the next connect does not have to compile again
+        QSaveFile cacheFile(cachedFile);
+        if (cacheFile.open(QIODevice::WriteOnly) && (cacheFile.write(index) == index.size()) && cacheFile.commit()) {
+            if (open(cachedFile)) {
+                qCDebug(CompInfoParamIndexLog) << "Rewrote cached index" << cachedFile;
+                return true;
+            }
+        } else {
+            qCWarning(CompInfoParamIndexLog) << "Cached index rewrite failed" << cachedFile << cacheFile.errorString();
+            // Better recompiled on the next connect than mapped while damaged
+            (void) QFile::remove(cachedFile);
+        }
+    }
+
+    return setData(index);
+}
+
+bool CompInfoParamIndex::open(const QString& indexFileName)
+{
+    close();
+
+    _file.setFileName(indexFileName);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(CompInfoParamIndexLog) << "Open failed" << indexFileName << _file.errorString();
+        return false;
+    }
+
+    const qint64 size = _file.size();
+    const uchar* const map = (size > 0) ? _file.map(0, size) : nullptr;
+    if (map) {
+        if (_attach(map, size)) {
+            return true;
+        }
+        close();
+        return false;
+    }
+
+    // Not mappable, read it instead
+    const QByteArray bytes = _file.readAll();
+    _file.close();
+    return setData(bytes);
+}
+
+bool CompInfoParamIndex::setData(const QByteArray& index)
+{
+    close();
+
+    _data = index;
+    if (_attach(reinterpret_cast<const uchar*>(_data.constData()), _data.size())) {
+        return true;
+    }
+    close();
+    return false;
+}
+
+void CompInfoParamIndex::close()
+{
+    _base = nullptr;
+    _size = 0;
+    _header = Header();
+    _data.clear();
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
+
+bool CompInfoParamIndex::_attach(const uchar* base, qint64 size)
+{
+    if (size < static_cast<qint64>(kHeaderWords * sizeof(quint32))) {
+        qCWarning(CompInfoParamIndexLog) << "Index too small" << size;
+        return false;
+    }
+
+    _base = base;
+    _size = size;
+
+    _header.magic               = _word(0);
+    _header.version             = _word(4);
+    _header.entryCount          = _word(8);
+    _header.indexedCount        = _word(12);
+    _header.entryTableOffset    = _word(16);
+    _header.indexedTableOffset  = _word(20);
+    _header.blobOffset          = _word(24);
+    _header.blobSize            = _word(28);
+
+    const auto fits = [size](quint64 offset, quint64 length) {
+        return (offset + length) <= static_cast<quint64>(size);
+    };
+
+    bool valid = (_header.magic == kMagic) && (_header.version == kVersion)
+            && fits(_header.entryTableOffset, static_cast<quint64>(_header.entryCount) * kEntryWords * sizeof(quint32))
+            && fits(_header.indexedTableOffset, static_cast<quint64>(_header.indexedCount) * kIndexedWords * sizeof(quint32))
+            && fits(_header.blobOffset, _header.blobSize);
+
+    // Every range must lie within the blob, so lookups need not check again
+    const auto blobRangesValid = [this](quint32 tableOffset, quint32 count, int words) {
+        for (quint32 i = 0; i < count; i++) {
+            for (int pair = 0; pair < (words / 2); pair++) {
+                const quint32 offset = _word(tableOffset + ((i * words) + (pair * 2)) * sizeof(quint32));
+                const quint32 length = _word(tableOffset + ((i * words) + (pair * 2) + 1) * sizeof(quint32));
+                if ((static_cast<quint64>(offset) + length) > _header.blobSize) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    valid = valid && blobRangesValid(_header.entryTableOffset, _header.entryCount, kEntryWords)
+            && blobRangesValid(_header.indexedTableOffset, _header.indexedCount, kIndexedWords);
+
+    if (!valid) {
+        qCWarning(CompInfoParamIndexLog) << "Index invalid, magic:version" << Qt::hex << _header.magic << _header.version;
+        _base = nullptr;
+        _size = 0;
+        _header = Header();
+        return false;
+    }
+
+    return true;
+}
+
+quint32 CompInfoParamIndex::_word(quint32 offset) const
+{
+    return qFromLittleEndian<quint32>(_base + offset);
+}
+
+QByteArrayView CompInfoParamIndex::_blob(quint32 offset, quint32 size) const
+{
+    return QByteArrayView(_base + _header.blobOffset + offset, size);
+}
+
+QByteArrayView CompInfoParamIndex::_entryName(int entry) const
+{
+    const quint32 row = _header.entryTableOffset + (entry * kEntryWords * sizeof(quint32));
+    return _blob(_word(row), _word(row + 4));
+}
+
+int CompInfoParamIndex::find(QByteArrayView name) const
+{
+    if (!isValid()) {
+        return -1;
+    }
+
+    int low = 0;
+    int high = static_cast<int>(_header.entryCount) - 1;
+    while (low <= high) {
+        const int mid = low + ((high - low) / 2);
+        const QByteArrayView midName = _entryName(mid);
+        if (nameLess(midName, name)) {
+            low = mid + 1;
+        } else if (nameLess(name, midName)) {
+            high = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+
+    return -1;
+}
+
+int CompInfoParamIndex::matchIndexed(QByteArrayView name, QByteArrayView* index) const
+{
+    int match = -1;
+    if (!isValid()) {
+        return match;
+    }
+
+    for (quint32 i = 0; i < _header.indexedCount; i++) {
+        const quint32 row = _header.indexedTableOffset + (i * kIndexedWords * sizeof(quint32));
+        const QByteArrayView prefix = _blob(_word(row), _word(row + 4));
+        const QByteArrayView suffix = _blob(_word(row + 8), _word(row + 12));
+
+        const qsizetype digitCount = name.size() - prefix.size() - suffix.size();
+        if ((digitCount <= 0) || !name.startsWith(prefix) || !name.endsWith(suffix)) {
+            continue;
+        }
+        const QByteArrayView digits = name.sliced(prefix.size(), digitCount);
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return (c >= '0') && (c <= '9'); })) {
+            continue;
+        }
+
+        match = static_cast<int>(i);
+        if (index) {
+            *index = digits;
+        }
+    }
+
+    return match;
+}
+
+QString CompInfoParamIndex::name(int entry) const
+{
+    if (!isValid() || (entry < 0) || (entry >= count())) {
+        return QString();
+    }
+    return QString::fromUtf8(_entryName(entry));
+}
+
+QString CompInfoParamIndex::indexedName(int indexedEntry) const
+{
+    if (!isValid() || (indexedEntry < 0) || (indexedEntry >= indexedCount())) {
+        return QString();
+    }
+    const quint32 row = _header.indexedTableOffset + (indexedEntry * kIndexedWords * sizeof(quint32));
+    return QString::fromUtf8(_blob(_word(row), _word(row + 4))) + QLatin1String(kIndexedNameTag) + QString::fromUtf8(_blob(_word(row + 8), _word(row + 12)));
+}
+
+QJsonObject CompInfoParamIndex::jsonObject(int entry) const
+{
+    if (!isValid() || (entry < 0) || (entry >= count())) {
+        return QJsonObject();
+    }
+    const quint32 row = _header.entryTableOffset + (entry * kEntryWords * sizeof(quint32));
+    return _decode(_blob(_word(row + 8), _word(row + 12)));
+}
+
+QJsonObject CompInfoParamIndex::indexedJsonObject(int indexedEntry) const
+{
+    if (!isValid() || (indexedEntry < 0) || (indexedEntry >= indexedCount())) {
+        return QJsonObject();
+    }
+    const quint32 row = _header.indexedTableOffset + (indexedEntry * kIndexedWords * sizeof(quint32));
+    return _decode(_blob(_word(row + 16), _word(row + 20)));
+}
+
+QJsonObject CompInfoParamIndex::_decode(QByteArrayView data)
+{
+    return QCborValue::fromCbor(QByteArray::fromRawData(data.data(), data.size())).toJsonValue().toObject();
+}
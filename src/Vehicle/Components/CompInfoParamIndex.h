@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+class ComponentInformationCache;
+
+Q_DECLARE_LOGGING_CATEGORY(CompInfoParamIndexLog)
+
+/// Parameter metadata json compiled into a binary index.
+///
+/// The index is built once per metadata file and kept in the ComponentInformationCache, keyed by the CRC of the
+/// json. Later connects map the cached file instead of parsing the json again. Lookups binary search a sorted name
+/// table and only decode the metadata of the parameters actually asked for.
+///
+/// Indexed names such as "PWM_MAIN_FUNC{n}" are kept apart from the plain names and are matched by their prefix and
+/// suffix around the digits, in place of a regular expression per name.
+///
+/// Layout, all values little endian quint32:
+///     Header          magic, version, entry count, indexed count, entry table offset, indexed table offset,
+///                     blob offset, blob size
+///     Entry table     name offset, name size, data offset, data size; sorted by UTF-8 name
+///     Indexed table   prefix offset, prefix size, suffix offset, suffix size, data offset, data size; in file order
+///     Blob            UTF-8 names and the CBOR encoded json object of every parameter
+class CompInfoParamIndex
+{
+public:
+    CompInfoParamIndex() = default;
+    ~CompInfoParamIndex();
+
+    CompInfoParamIndex(const CompInfoParamIndex&) = delete;
+    CompInfoParamIndex& operator=(const CompInfoParamIndex&) = delete;
+
+    /// Compiles parameter metadata json
+    ///     @param[out] errorString Set when false is returned
+    static bool compile(QByteArrayView json, QByteArray& index, QString& errorString);
+
+    /// Opens the index of a parameter metadata json file, compiling it into the cache on a miss
+    ///     @param[out] errorString Set when false is returned
+    bool load(const QString& jsonFileName, ComponentInformationCache& cache, QString& errorString);
+
+    /// Opens a compiled index file, mapping it into memory where possible
+    bool open(const QString& indexFileName);
+
+    /// Uses a compiled index held in memory
+    bool setData(const QByteArray& index);
+
+    void close();
+
+    bool isValid() const { return _base != nullptr; }
+
+    /// Plain, non-indexed names
+    int count() const { return _header.entryCount; }
+
+    /// Indexed names
+    int indexedCount() const { return _header.indexedCount; }
+
+    /// @return Entry of a plain name, -1 if not found
+    int find(QByteArrayView name) const;
+
+    /// @return Entry of the last indexed name matching, -1 if none
+    ///     @param[out] index Digits standing in for {n}
+    int matchIndexed(QByteArrayView name, QByteArrayView* index = nullptr) const;
+
+    QString name(int entry) const;
+    QString indexedName(int indexedEntry) const;
+
+    /// Metadata json object of a plain name
+    QJsonObject jsonObject(int entry) const;
+
+    /// Metadata json object of an indexed name
+    QJsonObject indexedJsonObject(int indexedEntry) const;
+
+    /// Cache tag for the index of a metadata json file
+    static QString cacheTag(QByteArrayView json);
+
+    static constexpr quint32    kMagic          = 0x49504351;   ///< "QCPI"
+    static constexpr quint32    kVersion        = 1;
+    static constexpr const char kIndexedNameTag[] = "{n}";
+
+private:
+    struct Header {
+        quint32 magic               = 0;
+        quint32 version             = 0;
+        quint32 entryCount          = 0;
+        quint32 indexedCount        = 0;
+        quint32 entryTableOffset    = 0;
+        quint32 indexedTableOffset  = 0;
+        quint32 blobOffset          = 0;
+        quint32 blobSize            = 0;
+    };
+
+    static constexpr int kHeaderWords   = 8;
+    static constexpr int kEntryWords    = 4;
+    static constexpr int kIndexedWords  = 6;
+
+    bool _attach(const uchar* base, qint64 size);
+    quint32 _word(quint32 offset) const;
+    QByteArrayView _blob(quint32 offset, quint32 size) const;
+    QByteArrayView _entryName(int entry) const;
+    static QJsonObject _decode(QByteArrayView data);
+
+    QFile           _file;
+    QByteArray      _data;
+    const uchar*    _base = nullptr;
+    qint64          _size = 0;
+    Header          _header;
+};
@@ -25,64 +25,160 @@ QGC_LOGGING_CATEGORY(InitialConnectStateMachineLog, "InitialConnectStateMachineL
 InitialConnectStateMachine::InitialConnectStateMachine(Vehicle* vehicle)
     : _vehicle(vehicle)
 {
-    static_assert(sizeof(_rgStates)/sizeof(_rgStates[0]) == sizeof(_rgProgressWeights)/sizeof(_rgProgressWeights[0]),
-            "array size mismatch");
-
-    _progressWeightTotal = 0;
-    for (int i = 0; i < _cStates; ++i) {
-        _progressWeightTotal += _rgProgressWeights[i];
+    for (int i = 0; i < StageCount; ++i) {
+        _progressWeightTotal += _rgStages[i].progressWeight;
     }
 }
 
-int InitialConnectStateMachine::stateCount(void) const
+const char* InitialConnectStateMachine::stageName(Stage stage)
+{
+    return (stage >= 0 && stage < StageCount) ? _rgStages[stage].name : "Unknown";
+}
+
+void InitialConnectStateMachine::start()
 {
-    return _cStates;
+    for (int i = 0; i < StageCount; ++i) {
+        _stageState[i]      = StatePending;
+        _stageProgress[i]   = 0.f;
+        _stageStartMsecs[i] = -1;
+        _stageEndMsecs[i]   = -1;
+    }
+    _active = true;
+    _elapsed.start();
+    _startReadyStages();
 }
 
-const InitialConnectStateMachine::StateFn* InitialConnectStateMachine::rgStates(void) const
+void InitialConnectStateMachine::_startReadyStages()
 {
-    return &_rgStates[0];
+    // Stages may complete from within their own state function, in which case the loop below picks up the stages
+    // waiting on them instead of recursing
+    if (_startingStages) {
+        _rescanStages = true;
+        return;
+    }
+
+    _startingStages = true;
+    do {
+        _rescanStages = false;
+        for (int i = 0; i < StageCount && _active; ++i) {
+            if (_stageState[i] != StatePending) {
+                continue;
+            }
+            bool ready = true;
+            for (int j = 0; j < StageCount; ++j) {
+                if ((_rgStages[i].dependsOn & (1u << j)) && (_stageState[j] != StateComplete)) {
+                    ready = false;
+                    break;
+                }
+            }
+            if (ready) {
+                qCDebug(InitialConnectStateMachineLog) << "Starting stage" << _rgStages[i].name << "at" << _elapsed.elapsed() << "msecs";
+                _stageState[i] = StateRunning;
+                _stageStartMsecs[i] = _elapsed.elapsed();
+                (*_rgStages[i].fn)(this);
+            }
+        }
+    } while (_rescanStages && _active);
+    _startingStages = false;
+
+    if (!_active) {
+        return;
+    }
+    for (int i = 0; i < StageCount; ++i) {
+        if (_stageState[i] != StateComplete) {
+            return;
+        }
+    }
+    _finish();
 }
 
-void InitialConnectStateMachine::statesCompleted(void) const
+void InitialConnectStateMachine::stageComplete(Stage stage)
 {
+    if (!_active || stage < 0 || stage >= StageCount) {
+        return;
+    }
+    if (_stageState[stage] == StateComplete) {
+        qCDebug(InitialConnectStateMachineLog) << "Stage" << _rgStages[stage].name << "completed twice";
+        return;
+    }
+
+    const qint64 now = _elapsed.elapsed();
+    if (_stageState[stage] == StatePending) {
+        qCDebug(InitialConnectStateMachineLog) << "Stage" << _rgStages[stage].name << "completed before it started";
+        _stageStartMsecs[stage] = now;
+    }
+    _stageState[stage] = StateComplete;
+    _stageEndMsecs[stage] = now;
+    _stageProgress[stage] = 1.f;
+    disconnect(_progressConnection[stage]);
+    qCDebug(InitialConnectStateMachineLog) << "Stage" << _rgStages[stage].name << "complete at" << now << "msecs, took" << (now - _stageStartMsecs[stage]) << "msecs";
 
+    emit progressUpdate(_progress());
+    _startReadyStages();
 }
 
-void InitialConnectStateMachine::advance()
+void InitialConnectStateMachine::_finish()
 {
-    StateMachine::advance();
+    _totalMsecs = _elapsed.elapsed();
+
+    qint64 stageTotal = 0;
+    for (int i = 0; i < StageCount; ++i) {
+        stageTotal += _stageEndMsecs[i] - _stageStartMsecs[i];
+    }
+    qCDebug(InitialConnectStateMachineLog) << "Initial connect took" << _totalMsecs << "msecs, stages added up to" << stageTotal << "msecs";
+
+    _active = false;
     emit progressUpdate(_progress());
+
+    qCDebug(InitialConnectStateMachineLog) << "Signalling initialConnectComplete";
+    emit _vehicle->initialConnectComplete();
+}
+
+QList<InitialConnectStateMachine::StageTiming> InitialConnectStateMachine::stageTimings() const
+{
+    QList<StageTiming> timings;
+    for (int i = 0; i < StageCount; ++i) {
+        StageTiming timing;
+        timing.name         = _rgStages[i].name;
+        timing.startMsecs   = _stageStartMsecs[i];
+        timing.endMsecs     = _stageEndMsecs[i];
+        timings.append(timing);
+    }
+    return timings;
 }
 
-void InitialConnectStateMachine::gotProgressUpdate(float progressValue)
+void InitialConnectStateMachine::_setStageProgress(Stage stage, float progress)
 {
-    emit progressUpdate(_progress(progressValue));
+    if (_stageState[stage] == StateRunning) {
+        _stageProgress[stage] = progress;
+        emit progressUpdate(_progress());
+    }
 }
 
-float InitialConnectStateMachine::_progress(float subProgress)
+float InitialConnectStateMachine::_progress() const
 {
-    int progressWeight = 0;
-    for (int i = 0; i < _stateIndex && i < _cStates; ++i) {
-        progressWeight += _rgProgressWeights[i];
+    if (!_active) {
+        return 1.f;
     }
-    int currentWeight = _stateIndex < _cStates ? _rgProgressWeights[_stateIndex] : 1;
-    return (progressWeight + currentWeight * subProgress) / (float)_progressWeightTotal;
+    float progressWeight = 0;
+    for (int i = 0; i < StageCount; ++i) {
+        progressWeight += _rgStages[i].progressWeight * _stageProgress[i];
+    }
+    return progressWeight / (float)_progressWeightTotal;
 }
 
-void InitialConnectStateMachine::_stateRequestAutopilotVersion(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestAutopilotVersion(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:AUTOPILOT_VERSION request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageComplete(StageAutopilotVersion);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:AUTOPILOT_VERSION request due to link type";
-            connectMachine->advance();
+            connectMachine->stageComplete(StageAutopilotVersion);
         } else {
             qCDebug(InitialConnectStateMachineLog) << "Sending REQUEST_MESSAGE:AUTOPILOT_VERSION";
             vehicle->requestMessage(_autopilotVersionRequestMessageHandler,
@@ -179,25 +275,24 @@ void InitialConnectStateMachine::_autopilotVersionRequestMessageHandler(void* re
         vehicle->_setCapabilities(assumedCapabilities);
     }
 
-    connectMachine->advance();
+    connectMachine->stageComplete(StageAutopilotVersion);
 }
 
-void InitialConnectStateMachine::_stateRequestProtocolVersion(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestProtocolVersion(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageComplete(StageProtocolVersion);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to link type";
-            connectMachine->advance();
+            connectMachine->stageComplete(StageProtocolVersion);
         } else if (vehicle->apmFirmware()) {
             qCDebug(InitialConnectStateMachineLog) << "Skipping REQUEST_MESSAGE:PROTOCOL_VERSION request due to Ardupilot firmware";
-            connectMachine->advance();
+            connectMachine->stageComplete(StageProtocolVersion);
         } else {
             qCDebug(InitialConnectStateMachineLog) << "Sending REQUEST_MESSAGE:PROTOCOL_VERSION";
             vehicle->requestMessage(_protocolVersionRequestMessageHandler,
@@ -248,94 +343,77 @@ void InitialConnectStateMachine::_protocolVersionRequestMessageHandler(void* res
         vehicle->_setMaxProtoVersionFromBothSources();
     }
 
-    connectMachine->advance();
+    connectMachine->stageComplete(StageProtocolVersion);
 }
-void InitialConnectStateMachine::_stateRequestCompInfo(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestCompInfo(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestCompInfo";
-    connect(vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
+    connectMachine->_progressConnection[StageCompInfo] = connect(vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate, connectMachine,
+            [connectMachine](float progress) { connectMachine->_setStageProgress(StageCompInfo, progress); });
     vehicle->_componentInformationManager->requestAllComponentInformation(_stateRequestCompInfoComplete, connectMachine);
 }
 
-void InitialConnectStateMachine::_stateRequestStandardModes(StateMachine *stateMachine)
+void InitialConnectStateMachine::_stateRequestStandardModes(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestStandardModes";
-    connect(vehicle->_standardModes, &StandardModes::requestCompleted, connectMachine,
-            &InitialConnectStateMachine::standardModesRequestCompleted);
+    connectMachine->_progressConnection[StageStandardModes] = connect(vehicle->_standardModes, &StandardModes::requestCompleted, connectMachine,
+            [connectMachine]() { connectMachine->stageComplete(StageStandardModes); });
     vehicle->_standardModes->request();
 }
 
-void InitialConnectStateMachine::standardModesRequestCompleted()
-{
-    disconnect(_vehicle->_standardModes, &StandardModes::requestCompleted, this,
-               &InitialConnectStateMachine::standardModesRequestCompleted);
-    advance();
-}
-
 void InitialConnectStateMachine::_stateRequestCompInfoComplete(void* requestAllCompleteFnData)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(requestAllCompleteFnData);
-    disconnect(connectMachine->_vehicle->_componentInformationManager, &ComponentInformationManager::progressUpdate,
-            connectMachine, &InitialConnectStateMachine::gotProgressUpdate);
+    InitialConnectStateMachine* connectMachine = static_cast<InitialConnectStateMachine*>(requestAllCompleteFnData);
 
-    connectMachine->advance();
+    connectMachine->stageComplete(StageCompInfo);
 }
 
-void InitialConnectStateMachine::_stateRequestParameters(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestParameters(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
+    Vehicle* vehicle = connectMachine->_vehicle;
 
+    // Completed by Vehicle::_parametersReady
     qCDebug(InitialConnectStateMachineLog) << "_stateRequestParameters";
-    connect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
+    connectMachine->_progressConnection[StageParameters] = connect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
+            [connectMachine](float progress) { connectMachine->_setStageProgress(StageParameters, progress); });
     vehicle->_parameterManager->refreshAllParameters();
 }
 
-void InitialConnectStateMachine::_stateRequestMission(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestMission(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_parameterManager, &ParameterManager::loadProgressChanged, connectMachine,
-            &InitialConnectStateMachine::gotProgressUpdate);
-
+    // Completed by Vehicle::_firstMissionLoadComplete
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission: Skipping first mission load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageComplete(StageMission);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission: Skipping first mission load request due to link type";
             vehicle->_firstMissionLoadComplete();
         } else {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestMission";
+            connectMachine->_progressConnection[StageMission] = connect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
+                    [connectMachine](double progress) { connectMachine->_setStageProgress(StageMission, progress); });
             vehicle->_missionManager->loadFromVehicle();
-            connect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
-                    &InitialConnectStateMachine::gotProgressUpdate);
         }
     }
 }
 
-void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestGeoFence(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_missionManager, &MissionManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
+    // Completed by Vehicle::_firstGeoFenceLoadComplete
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: Skipping first geofence load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageComplete(StageGeoFence);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: Skipping first geofence load request due to link type";
@@ -343,9 +421,9 @@ void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachin
         } else {
             if (vehicle->_geoFenceManager->supported()) {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence";
+                connectMachine->_progressConnection[StageGeoFence] = connect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
+                        [connectMachine](double progress) { connectMachine->_setStageProgress(StageGeoFence, progress); });
                 vehicle->_geoFenceManager->loadFromVehicle();
-                connect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
-                        &InitialConnectStateMachine::gotProgressUpdate);
             } else {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestGeoFence: skipped due to no support";
                 vehicle->_firstGeoFenceLoadComplete();
@@ -354,27 +432,24 @@ void InitialConnectStateMachine::_stateRequestGeoFence(StateMachine* stateMachin
     }
 }
 
-void InitialConnectStateMachine::_stateRequestRallyPoints(StateMachine* stateMachine)
+void InitialConnectStateMachine::_stateRequestRallyPoints(InitialConnectStateMachine* connectMachine)
 {
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
     Vehicle*                    vehicle         = connectMachine->_vehicle;
     SharedLinkInterfacePtr      sharedLink      = vehicle->vehicleLinkManager()->primaryLink().lock();
 
-    disconnect(vehicle->_geoFenceManager, &GeoFenceManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
+    // Completed by Vehicle::_firstRallyPointLoadComplete
     if (!sharedLink) {
         qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: Skipping first rally point load request due to no primary link";
-        connectMachine->advance();
+        connectMachine->stageComplete(StageRallyPoints);
     } else {
         if (sharedLink->linkConfiguration()->isHighLatency() || sharedLink->isLogReplay()) {
             qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: Skipping first rally point load request due to link type";
             vehicle->_firstRallyPointLoadComplete();
         } else {
             if (vehicle->_rallyPointManager->supported()) {
+                connectMachine->_progressConnection[StageRallyPoints] = connect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
+                        [connectMachine](double progress) { connectMachine->_setStageProgress(StageRallyPoints, progress); });
                 vehicle->_rallyPointManager->loadFromVehicle();
-                connect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
-                        &InitialConnectStateMachine::gotProgressUpdate);
             } else {
                 qCDebug(InitialConnectStateMachineLog) << "_stateRequestRallyPoints: skipping due to no support";
                 vehicle->_firstRallyPointLoadComplete();
@@ -382,17 +457,3 @@ void InitialConnectStateMachine::_stateRequestRallyPoints(StateMachine* stateMac
         }
     }
 }
-
-void InitialConnectStateMachine::_stateSignalInitialConnectComplete(StateMachine* stateMachine)
-{
-    InitialConnectStateMachine* connectMachine  = static_cast<InitialConnectStateMachine*>(stateMachine);
-    Vehicle*                    vehicle         = connectMachine->_vehicle;
-
-    disconnect(vehicle->_rallyPointManager, &RallyPointManager::progressPctChanged, connectMachine,
-               &InitialConnectStateMachine::gotProgressUpdate);
-
-    connectMachine->advance();
-    qCDebug(InitialConnectStateMachineLog) << "Signalling initialConnectComplete";
-    emit vehicle->initialConnectComplete();
-}
-
@@ -9,81 +9,126 @@
 
 #pragma once
 
-#include "StateMachine.h"
 #include "MAVLinkLib.h"
 #include "Vehicle.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
 
 Q_DECLARE_LOGGING_CATEGORY(InitialConnectStateMachineLog)
 
 class Vehicle;
 
-class InitialConnectStateMachine : public StateMachine
+/// Runs the requests made when a vehicle first connects.
+///
+/// The requests are stages of a dependency graph rather than a fixed sequence: a stage starts as soon as all the
+/// stages it depends on are complete. Stages sending MAV_CMD_REQUEST_MESSAGE still run one after the other, since
+/// Vehicle refuses a command which is already pending for the same component. The plan downloads share the mission
+/// protocol with each other but not with the parameter download, so mission, geofence and rally points load while
+/// component information and parameters do.
+class InitialConnectStateMachine : public QObject
 {
     Q_OBJECT
 
 public:
     InitialConnectStateMachine(Vehicle* vehicle);
 
-    // Overrides from StateMachine
-    int             stateCount      (void) const final;
-    const StateFn*  rgStates        (void) const final;
-    void            statesCompleted (void) const final;
+    enum Stage {
+        StageAutopilotVersion,
+        StageProtocolVersion,
+        StageStandardModes,
+        StageCompInfo,
+        StageParameters,
+        StageMission,
+        StageGeoFence,
+        StageRallyPoints,
+        StageCount
+    };
 
-    void advance() override;
+    struct StageTiming {
+        const char* name        = nullptr;
+        qint64      startMsecs  = -1;   ///< Since start(), -1 if the stage never started
+        qint64      endMsecs    = -1;   ///< Since start(), -1 if the stage has not completed
+    };
 
-signals:
-    void progressUpdate(float progress);
+    /// Starts the stages which do not depend on any other
+    void start();
 
-private slots:
-    void gotProgressUpdate(float progressValue);
-    void standardModesRequestCompleted();
+    /// @return true until all stages have completed
+    bool active() const { return _active; }
 
-private:
-    static void _stateRequestAutopilotVersion           (StateMachine* stateMachine);
-    static void _stateRequestProtocolVersion            (StateMachine* stateMachine);
-    static void _stateRequestCompInfo                   (StateMachine* stateMachine);
-    static void _stateRequestStandardModes              (StateMachine* stateMachine);
-    static void _stateRequestCompInfoComplete           (void* requestAllCompleteFnData);
-    static void _stateRequestParameters                 (StateMachine* stateMachine);
-    static void _stateRequestMission                    (StateMachine* stateMachine);
-    static void _stateRequestGeoFence                   (StateMachine* stateMachine);
-    static void _stateRequestRallyPoints                (StateMachine* stateMachine);
-    static void _stateSignalInitialConnectComplete      (StateMachine* stateMachine);
+    /// Marks a stage complete and starts the stages waiting on it. Completing a stage which has not started yet
+    /// completes it without running it.
+    void stageComplete(Stage stage);
 
-    static void _autopilotVersionRequestMessageHandler  (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
-    static void _protocolVersionRequestMessageHandler   (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
+    /// Start and end of every stage, valid once it has run
+    QList<StageTiming> stageTimings() const;
+
+    /// Time from start() until all stages completed, or until now while still active
+    qint64 elapsedMsecs() const { return _active ? _elapsed.elapsed() : _totalMsecs; }
 
-    float _progress(float subProgress = 0.f);
+    static const char* stageName(Stage stage);
 
-    Vehicle* _vehicle;
+signals:
+    void progressUpdate(float progress);
 
-    int _progressWeightTotal;
+private:
+    typedef void (*StageFn)(InitialConnectStateMachine* connectMachine);
 
-    static constexpr const StateMachine::StateFn _rgStates[] = {
-        _stateRequestAutopilotVersion,
-        _stateRequestProtocolVersion,
-        _stateRequestStandardModes,
-        _stateRequestCompInfo,
-        _stateRequestParameters,
-        _stateRequestMission,
-        _stateRequestGeoFence,
-        _stateRequestRallyPoints,
-        _stateSignalInitialConnectComplete
+    struct StageInfo {
+        const char* name;
+        StageFn     fn;
+        int         progressWeight;
+        quint32     dependsOn;      ///< Bit per Stage
     };
 
-    static constexpr const int _rgProgressWeights[] = {
-        1, //_stateRequestCapabilities
-        1, //_stateRequestProtocolVersion
-        1, //_stateRequestStandardModes
-        5, //_stateRequestCompInfo
-        5, //_stateRequestParameters
-        2, //_stateRequestMission
-        1, //_stateRequestGeoFence
-        1, //_stateRequestRallyPoints
-        1, //_stateSignalInitialConnectComplete
+    enum StageState {
+        StatePending,
+        StateRunning,
+        StateComplete
     };
 
-    static constexpr int _cStates = sizeof(_rgStates) / sizeof(_rgStates[0]);
+    static void _stateRequestAutopilotVersion           (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestProtocolVersion            (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestCompInfo                   (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestStandardModes              (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestCompInfoComplete           (void* requestAllCompleteFnData);
+    static void _stateRequestParameters                 (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestMission                    (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestGeoFence                   (InitialConnectStateMachine* connectMachine);
+    static void _stateRequestRallyPoints                (InitialConnectStateMachine* connectMachine);
+
+    static void _autopilotVersionRequestMessageHandler  (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
+    static void _protocolVersionRequestMessageHandler   (void* resultHandlerData, MAV_RESULT commandResult, Vehicle::RequestMessageResultHandlerFailureCode_t failureCode, const mavlink_message_t& message);
+
+    void _startReadyStages      ();
+    void _finish                ();
+    void _setStageProgress      (Stage stage, float progress);
+    float _progress             () const;
+
+    Vehicle*                _vehicle;
+    bool                    _active             = false;
+    bool                    _startingStages     = false;
+    bool                    _rescanStages       = false;
+    QElapsedTimer           _elapsed;
+    qint64                  _totalMsecs         = 0;
+    StageState              _stageState         [StageCount] = {};
+    float                   _stageProgress      [StageCount] = {};
+    qint64                  _stageStartMsecs    [StageCount] = {};
+    qint64                  _stageEndMsecs      [StageCount] = {};
+    QMetaObject::Connection _progressConnection [StageCount];
+    int                     _progressWeightTotal = 0;
+
+    static constexpr const StageInfo _rgStages[StageCount] = {
+        { "AutopilotVersion",   _stateRequestAutopilotVersion,  1, 0 },
+        { "ProtocolVersion",    _stateRequestProtocolVersion,   1, (1u << StageAutopilotVersion) },
+        { "StandardModes",      _stateRequestStandardModes,     1, (1u << StageProtocolVersion) },
+        { "CompInfo",           _stateRequestCompInfo,          5, (1u << StageStandardModes) },
+        { "Parameters",         _stateRequestParameters,        5, (1u << StageCompInfo) },
+        { "Mission",            _stateRequestMission,           2, (1u << StageProtocolVersion) },
+        { "GeoFence",           _stateRequestGeoFence,          1, (1u << StageMission) },
+        { "RallyPoints",        _stateRequestRallyPoints,       1, (1u << StageGeoFence) },
+    };
 };
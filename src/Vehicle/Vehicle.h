@@ -413,6 +413,10 @@ public:
     Q_INVOKABLE void sendSetupSigning();
 
     bool    isInitialConnectComplete() const;
+
+    /// Stage timings of the initial connect sequence
+    const InitialConnectStateMachine* initialConnectStateMachine() const { return _initialConnectStateMachine; }
+
     bool    guidedModeSupported     () const;
     bool    pauseVehicleSupported   () const;
     bool    orbitModeSupported      () const;
@@ -438,7 +442,7 @@ public:
 
     bool joystickEnabled            () const;
     void setJoystickEnabled         (bool enabled);
-    void sendJoystickDataThreadSafe (float roll, float pitch, float yaw, float thrust, quint16 buttons);
+    bool sendJoystickDataThreadSafe (float roll, float pitch, float yaw, float thrust, quint16 buttons);
 
     // Property accesors
     int id() const{ return _id; }
@@ -16,7 +16,6 @@
 #include "QGCCorePlugin.h"
 #include "FirmwareUpgradeSettings.h"
 #include "SettingsManager.h"
-#include "QGCZlib.h"
 #include "JsonHelper.h"
 #include "LinkManager.h"
 #include "MultiVehicleManager.h"
@@ -24,8 +23,7 @@
 #include "Fact.h"
 #include "QGCLoggingCategory.h"
 
-#include <QtCore/QDir>
-#include <QtCore/QStandardPaths>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -658,75 +656,78 @@ void FirmwareUpgradeController::_ardupilotManifestDownloadComplete(QString remot
 
         qCDebug(FirmwareUpgradeLog) << "_ardupilotManifestDownloadFinished" << remoteFile << localFile;
 
-        QString jsonFileName(QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation)).absoluteFilePath("ArduPilot.Manifest.json"));
-        if (!QGCZlib::inflateGzipFile(localFile, jsonFileName)) {
-            qCWarning(FirmwareUpgradeLog) << "Inflate of compressed manifest failed" << localFile;
-            return;
-        }
-
-        QString         errorString;
-        QJsonDocument   doc;
-        if (!JsonHelper::isJsonFile(jsonFileName, doc, errorString)) {
-            qCWarning(FirmwareUpgradeLog) << "Json file read failed" << errorString;
-            return;
-        }
-
-        QJsonObject json =          doc.object();
-        QJsonArray  rgFirmware =    json[_manifestFirmwareJsonKey].toArray();
+        // The manifest is tens of megabytes of json, it is inflated in memory and parsed on the thread pool
+        QFutureWatcher<JsonHelper::JsonFile>* watcher = new QFutureWatcher<JsonHelper::JsonFile>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+            const JsonHelper::JsonFile jsonFile = watcher->result();
+            watcher->deleteLater();
+            if (!jsonFile.isValid()) {
+                qCWarning(FirmwareUpgradeLog) << "Json file read failed" << jsonFile.errorString;
+                return;
+            }
+            _ardupilotManifestLoaded(jsonFile.jsonDoc);
+        });
+        watcher->setFuture(JsonHelper::loadJsonFileAsync(localFile));
+    } else {
+        qCWarning(FirmwareUpgradeLog) << "ArduPilot Manifest download failed" << errorMsg;
+    }
+}
 
-        for (int i=0; i<rgFirmware.count(); i++) {
-            const QJsonObject& firmwareJson = rgFirmware[i].toObject();
+void FirmwareUpgradeController::_ardupilotManifestLoaded(const QJsonDocument& doc)
+{
+    QJsonObject json =          doc.object();
+    QJsonArray  rgFirmware =    json[_manifestFirmwareJsonKey].toArray();
 
-            FirmwareVehicleType_t   firmwareVehicleType =   _manifestMavTypeToFirmwareVehicleType(firmwareJson[_manifestMavTypeJsonKey].toString());
-            FirmwareBuildType_t     firmwareBuildType =     _manifestMavFirmwareVersionTypeToFirmwareBuildType(firmwareJson[_manifestMavFirmwareVersionTypeJsonKey].toString());
-            QString                 format =                firmwareJson[_manifestFormatJsonKey].toString();
-            QString                 platform =              firmwareJson[_manifestPlatformKey].toString();
+    for (int i=0; i<rgFirmware.count(); i++) {
+        const QJsonObject& firmwareJson = rgFirmware[i].toObject();
 
-            if (firmwareVehicleType != DefaultVehicleFirmware && firmwareBuildType != CustomFirmware && (format == QStringLiteral("apj") || format == QStringLiteral("px4"))) {
-                if (platform.contains("-heli") && firmwareVehicleType != HeliFirmware) {
-                    continue;
-                }
+        FirmwareVehicleType_t   firmwareVehicleType =   _manifestMavTypeToFirmwareVehicleType(firmwareJson[_manifestMavTypeJsonKey].toString());
+        FirmwareBuildType_t     firmwareBuildType =     _manifestMavFirmwareVersionTypeToFirmwareBuildType(firmwareJson[_manifestMavFirmwareVersionTypeJsonKey].toString());
+        QString                 format =                firmwareJson[_manifestFormatJsonKey].toString();
+        QString                 platform =              firmwareJson[_manifestPlatformKey].toString();
 
-                _rgManifestFirmwareInfo.append(ManifestFirmwareInfo_t());
-                ManifestFirmwareInfo_t& firmwareInfo = _rgManifestFirmwareInfo.last();
+        if (firmwareVehicleType != DefaultVehicleFirmware && firmwareBuildType != CustomFirmware && (format == QStringLiteral("apj") || format == QStringLiteral("px4"))) {
+            if (platform.contains("-heli") && firmwareVehicleType != HeliFirmware) {
+                continue;
+            }
 
-                firmwareInfo.boardId =              static_cast<uint32_t>(firmwareJson[_manifestBoardIdJsonKey].toInt());
-                firmwareInfo.firmwareBuildType =    firmwareBuildType;
-                firmwareInfo.vehicleType =          firmwareVehicleType;
-                firmwareInfo.url =                  firmwareJson[_manifestUrlJsonKey].toString();
-                firmwareInfo.version =              firmwareJson[_manifestMavFirmwareVersionJsonKey].toString();
-                firmwareInfo.chibios =              format == QStringLiteral("apj");                firmwareInfo.fmuv2 =                platform.contains(QStringLiteral("fmuv2"));
+            _rgManifestFirmwareInfo.append(ManifestFirmwareInfo_t());
+            ManifestFirmwareInfo_t& firmwareInfo = _rgManifestFirmwareInfo.last();
 
-                QJsonArray bootloaderArray = firmwareJson[_manifestBootloaderStrJsonKey].toArray();
-                for (int j=0; j<bootloaderArray.count(); j++) {
-                    firmwareInfo.rgBootloaderPortString.append(bootloaderArray[j].toString());
-                }
+            firmwareInfo.boardId =              static_cast<uint32_t>(firmwareJson[_manifestBoardIdJsonKey].toInt());
+            firmwareInfo.firmwareBuildType =    firmwareBuildType;
+            firmwareInfo.vehicleType =          firmwareVehicleType;
+            firmwareInfo.url =                  firmwareJson[_manifestUrlJsonKey].toString();
+            firmwareInfo.version =              firmwareJson[_manifestMavFirmwareVersionJsonKey].toString();
+            firmwareInfo.chibios =              format == QStringLiteral("apj");                firmwareInfo.fmuv2 =                platform.contains(QStringLiteral("fmuv2"));
 
-                QJsonArray usbidArray = firmwareJson[_manifestUSBIDJsonKey].toArray();
-                for (int j=0; j<usbidArray.count(); j++) {
-                    QStringList vidpid = usbidArray[j].toString().split('/');
-                    QString vid = vidpid[0];
-                    QString pid = vidpid[1];
+            QJsonArray bootloaderArray = firmwareJson[_manifestBootloaderStrJsonKey].toArray();
+            for (int j=0; j<bootloaderArray.count(); j++) {
+                firmwareInfo.rgBootloaderPortString.append(bootloaderArray[j].toString());
+            }
 
-                    bool ok;
-                    firmwareInfo.rgVID.append(vid.right(vid.length() - 2).toInt(&ok, 16));
-                    firmwareInfo.rgPID.append(pid.right(pid.length() - 2).toInt(&ok, 16));
-                }
+            QJsonArray usbidArray = firmwareJson[_manifestUSBIDJsonKey].toArray();
+            for (int j=0; j<usbidArray.count(); j++) {
+                QStringList vidpid = usbidArray[j].toString().split('/');
+                QString vid = vidpid[0];
+                QString pid = vidpid[1];
 
-                QString brandName = firmwareJson[_manifestBrandNameKey].toString();
-                firmwareInfo.friendlyName = QStringLiteral("%1 - %2").arg(brandName.isEmpty() ? platform : brandName).arg(firmwareInfo.version);
+                bool ok;
+                firmwareInfo.rgVID.append(vid.right(vid.length() - 2).toInt(&ok, 16));
+                firmwareInfo.rgPID.append(pid.right(pid.length() - 2).toInt(&ok, 16));
             }
-        }
 
-        if (_bootloaderFound) {
-            _buildAPMFirmwareNames();
+            QString brandName = firmwareJson[_manifestBrandNameKey].toString();
+            firmwareInfo.friendlyName = QStringLiteral("%1 - %2").arg(brandName.isEmpty() ? platform : brandName).arg(firmwareInfo.version);
         }
+    }
 
-        _downloadingFirmwareList = false;
-        emit downloadingFirmwareListChanged(false);
-    } else {
-        qCWarning(FirmwareUpgradeLog) << "ArduPilot Manifest download failed" << errorMsg;
+    if (_bootloaderFound) {
+        _buildAPMFirmwareNames();
     }
+
+    _downloadingFirmwareList = false;
+    emit downloadingFirmwareListChanged(false);
 }
 
 FirmwareUpgradeController::FirmwareBuildType_t FirmwareUpgradeController::_manifestMavFirmwareVersionTypeToFirmwareBuildType(const QString& manifestMavFirmwareVersionType)
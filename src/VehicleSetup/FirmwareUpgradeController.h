@@ -11,6 +11,7 @@
 
 #include "QGCSerialPortInfo.h"
 
+#include <QtCore/QJsonDocument>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtGui/QPixmap>
@@ -192,6 +193,7 @@ private:
     void _errorCancel               (const QString& msg);
     void _determinePX4StableVersion (void);
     void _downloadArduPilotManifest (void);
+    void _ardupilotManifestLoaded   (const QJsonDocument& doc);
 
     QString _singleFirmwareURL;
     bool    _singleFirmwareMode;
@@ -122,6 +122,21 @@ Item {
             visible:            advancedSettings.checked
         }
         //-----------------------------------------------------------------
+        //-- Measured Axis Message Timing
+        QGCLabel {
+            text:               qsTr("Measured rate / jitter / latency:")
+            Layout.alignment:   Qt.AlignVCenter
+            visible:            advancedSettings.checked
+        }
+        QGCLabel {
+            text:               qsTr("%1 Hz / %2 ms (max %3 ms) / %4 ms").arg(_activeJoystick.sendRateHz.toFixed(1))
+                                                                     .arg(_activeJoystick.sendJitterMs.toFixed(2))
+                                                                     .arg(_activeJoystick.sendMaxJitterMs.toFixed(2))
+                                                                     .arg(_activeJoystick.sendLatencyMs.toFixed(2))
+            Layout.alignment:   Qt.AlignVCenter
+            visible:            advancedSettings.checked
+        }
+        //-----------------------------------------------------------------
         //-- Button Repeat Frequency
         QGCLabel {
             text:               qsTr("Button repeat frequency (Hz):")
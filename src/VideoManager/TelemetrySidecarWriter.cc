@@ -0,0 +1,508 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetrySidecarWriter.h"
+#include "Fact.h"
+#include "FactValueGrid.h"
+#include "HorizontalFactValueGrid.h"
+#include "InstrumentValueData.h"
+#include "MultiVehicleManager.h"
+#include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
+#include "VideoSettings.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtCore/QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(TelemetrySidecarWriterLog, "qgc.videomanager.telemetrysidecarwriter")
+
+static constexpr char kBinaryMagic[8] = { 'Q', 'G', 'C', 'T', 'L', 'M', '\0', 1 };
+static constexpr int kAssColumns = 3;
+
+TelemetrySidecarWriter::TelemetrySidecarWriter(QObject *parent)
+    : QObject(parent)
+    , _timer(new QTimer(this))
+{
+    // qCDebug(TelemetrySidecarWriterLog) << Q_FUNC_INFO << this;
+
+    _timer->setTimerType(Qt::PreciseTimer);
+    (void) connect(_timer, &QTimer::timeout, this, &TelemetrySidecarWriter::_captureTelemetry);
+}
+
+TelemetrySidecarWriter::~TelemetrySidecarWriter()
+{
+    close();
+
+    // qCDebug(TelemetrySidecarWriterLog) << Q_FUNC_INFO << this;
+}
+
+void TelemetrySidecarWriter::startCapturingTelemetry(const QString &videoFile, qint64 epochMsecs, QSize videoSize)
+{
+    stopCapturingTelemetry();
+
+    const VideoSettings *const videoSettings = SettingsManager::instance()->videoSettings();
+    const TrackFormat trackFormat = static_cast<TrackFormat>(videoSettings->telemetryTrackFormat()->rawValue().toInt());
+    const SubtitleFormat subtitleFormat = static_cast<SubtitleFormat>(videoSettings->telemetrySubtitleFormat()->rawValue().toInt());
+    const int rateHz = qMax(1, videoSettings->telemetryTrackRate()->rawValue().toInt());
+
+    if ((trackFormat == TrackNone) && (subtitleFormat == SubtitleNone)) {
+        return;
+    }
+
+    // Gather the facts currently displayed
+    _facts.clear();
+    QList<Channel> channels;
+
+    FactValueGrid *const grid = new FactValueGrid();
+    grid->setProperty("userSettingsGroup", HorizontalFactValueGrid::telemetryBarUserSettingsGroup);
+    grid->setProperty("defaultSettingsGroup", HorizontalFactValueGrid::telemetryBarDefaultSettingsGroup);
+    grid->_loadSettings();
+    for (int colIndex = 0; colIndex < grid->columns()->count(); colIndex++) {
+        const QmlObjectListModel *const list = grid->columns()->value<QmlObjectListModel*>(colIndex);
+        for (int rowIndex = 0; rowIndex < list->count(); rowIndex++) {
+            Fact *const fact = list->value<InstrumentValueData*>(rowIndex)->fact();
+            if (!fact) {
+                continue;
+            }
+
+            Channel channel;
+            channel.name = fact->name();
+            channel.label = fact->shortDescription();
+            channel.units = fact->cookedUnits();
+            channel.decimals = fact->decimalPlaces();
+            channel.enumStrings = fact->enumStrings();
+            for (const QVariant &enumValue : fact->enumValues()) {
+                channel.enumValues.append(enumValue.toDouble());
+            }
+            channels.append(channel);
+            _facts.append(fact);
+        }
+    }
+    grid->deleteLater();
+
+    const QFileInfo videoFileInfo(videoFile);
+    const QString baseName = QStringLiteral("%1/%2").arg(videoFileInfo.path(), videoFileInfo.completeBaseName());
+    if (!open(baseName, channels, trackFormat, subtitleFormat, videoSize)) {
+        return;
+    }
+
+    _sampleValues.assign(_facts.count(), std::nan(""));
+    _elapsedOffsetUsecs = (QDateTime::currentMSecsSinceEpoch() - epochMsecs) * 1000;
+    _elapsed.start();
+
+    _timer->start(1000 / rateHz);
+}
+
+void TelemetrySidecarWriter::stopCapturingTelemetry()
+{
+    if (_timer->isActive()) {
+        qCDebug(TelemetrySidecarWriterLog) << "Stopping writing";
+        _timer->stop();
+    }
+
+    close();
+    _facts.clear();
+}
+
+QStringList TelemetrySidecarWriter::openFiles() const
+{
+    QStringList files;
+    if (_trackFile.isOpen()) {
+        files << _trackFile.fileName();
+    }
+    if (_subtitleFile.isOpen()) {
+        files << _subtitleFile.fileName();
+    }
+    return files;
+}
+
+QStringList TelemetrySidecarWriter::nameFilters()
+{
+    return { QStringLiteral("*.csv"), QStringLiteral("*.tlm"), QStringLiteral("*.ass"), QStringLiteral("*.srt") };
+}
+
+void TelemetrySidecarWriter::_captureTelemetry()
+{
+    if (!MultiVehicleManager::instance()->activeVehicle()) {
+        return;
+    }
+
+    for (qsizetype i = 0; i < _facts.count(); i++) {
+        const Fact *const fact = _facts[i].data();
+        bool ok = false;
+        const double value = fact ? fact->cookedValue().toDouble(&ok) : 0;
+        _sampleValues[i] = ok ? value : std::nan("");
+    }
+
+    write(_elapsedOffsetUsecs + (_elapsed.nsecsElapsed() / 1000), _sampleValues.data());
+}
+
+bool TelemetrySidecarWriter::open(const QString &baseName, const QList<Channel> &channels, TrackFormat trackFormat, SubtitleFormat subtitleFormat, QSize videoSize)
+{
+    close();
+
+    _channels = channels;
+    _trackFormat = trackFormat;
+    _subtitleFormat = subtitleFormat;
+    _videoSize = videoSize.isValid() && !videoSize.isEmpty() ? videoSize : QSize(1920, 1080);
+    _dateText = QDateTime::currentDateTime().toString(QLocale::system().dateFormat(QLocale::ShortFormat)).toUtf8();
+
+    if (_trackFormat != TrackNone) {
+        _trackFile.setFileName(baseName + (_trackFormat == TrackCsv ? QStringLiteral(".csv") : QStringLiteral(".tlm")));
+        if (!_trackFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCWarning(TelemetrySidecarWriterLog) << "Unable to open" << _trackFile.fileName() << _trackFile.errorString();
+            return false;
+        }
+        qCDebug(TelemetrySidecarWriterLog) << "Writing telemetry track to file:" << _trackFile.fileName();
+    }
+
+    if (_subtitleFormat != SubtitleNone) {
+        _subtitleFile.setFileName(baseName + (_subtitleFormat == SubtitleAss ? QStringLiteral(".ass") : QStringLiteral(".srt")));
+        if (!_subtitleFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCWarning(TelemetrySidecarWriterLog) << "Unable to open" << _subtitleFile.fileName() << _subtitleFile.errorString();
+            _trackFile.close();
+            return false;
+        }
+        qCDebug(TelemetrySidecarWriterLog) << "Writing overlay to file:" << _subtitleFile.fileName();
+    }
+
+    _nextSubtitleUsecs = 0;
+    _subtitleIndex = 0;
+    _closing = false;
+    _pendingTimes.clear();
+    _pendingValues.clear();
+
+    _thread = QThread::create([this]() { _run(); });
+    _thread->setObjectName(QStringLiteral("TelemetrySidecarWriter"));
+    _thread->start(QThread::LowPriority);
+
+    return true;
+}
+
+void TelemetrySidecarWriter::write(qint64 timeUsecs, const double *values)
+{
+    if (!_thread) {
+        return;
+    }
+
+    QMutexLocker lock(&_mutex);
+    _pendingTimes.push_back(timeUsecs);
+    (void) _pendingValues.insert(_pendingValues.end(), values, values + _channels.count());
+    _wake.wakeOne();
+}
+
+void TelemetrySidecarWriter::close()
+{
+    if (!_thread) {
+        return;
+    }
+
+    _mutex.lock();
+    _closing = true;
+    _wake.wakeOne();
+    _mutex.unlock();
+
+    (void) _thread->wait();
+    delete _thread;
+    _thread = nullptr;
+
+    _trackFile.close();
+    _subtitleFile.close();
+}
+
+void TelemetrySidecarWriter::_run()
+{
+    std::vector<qint64> times;
+    std::vector<double> values;
+
+    _writeHeaders();
+
+    QMutexLocker lock(&_mutex);
+    while (true) {
+        while (_pendingTimes.empty() && !_closing) {
+            (void) _wake.wait(&_mutex);
+        }
+
+        const bool closing = _closing;
+        times.swap(_pendingTimes);
+        values.swap(_pendingValues);
+        lock.unlock();
+
+        _writeBatch(times, values);
+        times.clear();
+        values.clear();
+
+        lock.relock();
+        if (closing && _pendingTimes.empty()) {
+            break;
+        }
+    }
+}
+
+void TelemetrySidecarWriter::_writeHeaders()
+{
+    _trackBuffer.clear();
+    _subtitleBuffer.clear();
+
+    if (_trackFormat == TrackCsv) {
+        _trackBuffer.append("time_ms");
+        for (const Channel &channel : _channels) {
+            _trackBuffer.append(',').append(channel.name.toUtf8());
+            if (!channel.units.isEmpty()) {
+                _trackBuffer.append(" (").append(channel.units.toUtf8()).append(')');
+            }
+        }
+        _trackBuffer.append('\n');
+    } else if (_trackFormat == TrackBinary) {
+        _trackBuffer.append(kBinaryMagic, sizeof(kBinaryMagic));
+        const quint32 channelCount = qToLittleEndian<quint32>(static_cast<quint32>(_channels.count()));
+        _trackBuffer.append(reinterpret_cast<const char*>(&channelCount), sizeof(channelCount));
+        for (const Channel &channel : _channels) {
+            for (const QString &text : { channel.name, channel.units }) {
+                const QByteArray utf8 = text.toUtf8().left(std::numeric_limits<quint16>::max());
+                const quint16 length = qToLittleEndian<quint16>(static_cast<quint16>(utf8.size()));
+                _trackBuffer.append(reinterpret_cast<const char*>(&length), sizeof(length)).append(utf8);
+            }
+        }
+    }
+
+    if (_subtitleFormat == SubtitleAss) {
+        // The layout was designed for 1920x1080, scale it to the video
+        const double scaleX = _videoSize.width() / 1920.0;
+        const double scaleY = _videoSize.height() / 1080.0;
+        const int offset = qRound(700 * scaleX);   // Simulates a larger resolution to reduce the borders in the layout
+        const int columnWidth = (_videoSize.width() + offset) / (kAssColumns + 1);
+        const int bottom = _videoSize.height() - qRound(5 * scaleY);
+
+        _subtitleBuffer.append(QStringLiteral(
+            "[Script Info]\n"
+            "Title: QGroundControl Subtitle Telemetry file\n"
+            "ScriptType: v4.00+\n"
+            "WrapStyle: 0\n"
+            "ScaledBorderAndShadow: yes\n"
+            "YCbCr Matrix: TV.601\n"
+            "PlayResX: %1\n"
+            "PlayResY: %2\n"
+            "\n"
+            "[V4+ Styles]\n"
+            "Format: Name, Fontname, Fontsize, PrimaryColour, SecondaryColour, OutlineColour, BackColour, Bold, Italic, Underline, StrikeOut, ScaleX, ScaleY, Spacing, Angle, BorderStyle, Outline, Shadow, Alignment, MarginL, MarginR, MarginV, Encoding\n"
+            "Style: Default,Monospace,%3,&H00FFFFFF,&H000000FF,&H00000000,&H00000000,0,0,0,0,100,100,0,0,1,2,2,1,10,10,10,1\n"
+            "\n"
+            "[Events]\n"
+            "Format: Layer, Start, End, Style, Name, MarginL, MarginR, MarginV, Effect, Text\n")
+            .arg(_videoSize.width()).arg(_videoSize.height()).arg(qMax(8, qRound(30 * scaleY))).toUtf8());
+
+        // Names are right aligned against their values, both fixed for the whole recording
+        const int perColumn = (_channels.count() + kAssColumns - 1) / kAssColumns;
+        _assNameEvents.clear();
+        _assValuePositions.clear();
+        for (int column = 0; column < kAssColumns; column++) {
+            const int x = (-offset / 2) + (columnWidth * (column + 1));
+            QByteArray names = QStringLiteral(",Default,,0,0,0,,{\\an3\\pos(%1,%2)}").arg(x - 10).arg(bottom).toUtf8();
+            for (int i = column * perColumn; (i < (column + 1) * perColumn) && (i < _channels.count()); i++) {
+                if (i > column * perColumn) {
+                    names.append("\\N");
+                }
+                names.append(_channels[i].label.toUtf8()).append(':');
+            }
+            _assNameEvents.append(names);
+            _assValuePositions.append(QStringLiteral(",Default,,0,0,0,,{\\pos(%1,%2)}").arg(x).arg(bottom).toUtf8());
+        }
+    }
+
+    if (!_trackBuffer.isEmpty()) {
+        (void) _trackFile.write(_trackBuffer);
+    }
+    if (!_subtitleBuffer.isEmpty()) {
+        (void) _subtitleFile.write(_subtitleBuffer);
+    }
+}
+
+void TelemetrySidecarWriter::_writeBatch(const std::vector<qint64> &times, const std::vector<double> &values)
+{
+    const qsizetype channelCount = _channels.count();
+
+    _trackBuffer.clear();
+    _subtitleBuffer.clear();
+
+    for (size_t sample = 0; sample < times.size(); sample++) {
+        const qint64 timeUsecs = times[sample];
+        const double *const sampleValues = values.data() + (sample * channelCount);
+
+        if (_trackFormat == TrackCsv) {
+            _appendFixed(_trackBuffer, timeUsecs / 1000.0, 3);
+            for (qsizetype i = 0; i < channelCount; i++) {
+                _trackBuffer.append(',');
+                if (!std::isnan(sampleValues[i])) {
+                    _appendFixed(_trackBuffer, sampleValues[i], _channels[i].decimals);
+                }
+            }
+            _trackBuffer.append('\n');
+        } else if (_trackFormat == TrackBinary) {
+            const qint64 time = qToLittleEndian<qint64>(timeUsecs);
+            _trackBuffer.append(reinterpret_cast<const char*>(&time), sizeof(time));
+            for (qsizetype i = 0; i < channelCount; i++) {
+                const float value = static_cast<float>(sampleValues[i]);
+                quint32 bits;
+                (void) memcpy(&bits, &value, sizeof(bits));
+                bits = qToLittleEndian<quint32>(bits);
+                _trackBuffer.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+            }
+        }
+
+        // Subtitles show the first sample of every interval for the whole interval
+        if ((_subtitleFormat != SubtitleNone) && (timeUsecs >= _nextSubtitleUsecs)) {
+            const qint64 intervalUsecs = kSubtitleIntervalMsecs * 1000;
+            const qint64 startUsecs = (timeUsecs / intervalUsecs) * intervalUsecs;
+            _writeSubtitle(startUsecs, startUsecs + intervalUsecs, sampleValues);
+            _nextSubtitleUsecs = startUsecs + intervalUsecs;
+        }
+    }
+
+    if (!_trackBuffer.isEmpty()) {
+        (void) _trackFile.write(_trackBuffer);
+    }
+    if (!_subtitleBuffer.isEmpty()) {
+        (void) _subtitleFile.write(_subtitleBuffer);
+    }
+}
+
+void TelemetrySidecarWriter::_writeSubtitle(qint64 startUsecs, qint64 endUsecs, const double *values)
+{
+    QByteArray &out = _subtitleBuffer;
+
+    if (_subtitleFormat == SubtitleAss) {
+        const int perColumn = (_channels.count() + kAssColumns - 1) / kAssColumns;
+        for (int column = 0; column < kAssColumns; column++) {
+            for (int pass = 0; pass < 2; pass++) {
+                out.append("Dialogue: 0,");
+                _appendAssTime(out, startUsecs);
+                out.append(',');
+                _appendAssTime(out, endUsecs);
+                if (pass == 0) {
+                    out.append(_assNameEvents[column]);
+                } else {
+                    out.append(_assValuePositions[column]);
+                    for (int i = column * perColumn; (i < (column + 1) * perColumn) && (i < _channels.count()); i++) {
+                        if (i > column * perColumn) {
+                            out.append("\\N");
+                        }
+                        _appendValueText(out, i, values[i]);
+                    }
+                }
+                out.append('\n');
+            }
+        }
+
+        // Date in the corner
+        out.append("Dialogue: 0,");
+        _appendAssTime(out, startUsecs);
+        out.append(',');
+        _appendAssTime(out, endUsecs);
+        out.append(",Default,,0,0,0,,{\\pos(10,35)}").append(_dateText).append('\n');
+    } else if (_subtitleFormat == SubtitleSrt) {
+        out.append(QByteArray::number(++_subtitleIndex)).append('\n');
+        _appendSrtTime(out, startUsecs);
+        out.append(" --> ");
+        _appendSrtTime(out, endUsecs);
+        out.append('\n');
+        for (qsizetype i = 0; i < _channels.count(); i++) {
+            out.append(_channels[i].label.toUtf8()).append(": ");
+            _appendValueText(out, i, values[i]);
+            out.append('\n');
+        }
+        out.append('\n');
+    }
+}
+
+void TelemetrySidecarWriter::_appendValueText(QByteArray &out, int channel, double value) const
+{
+    const Channel &info = _channels[channel];
+
+    if (std::isnan(value)) {
+        out.append("--");
+        return;
+    }
+
+    const qsizetype enumIndex = info.enumValues.indexOf(value);
+    if ((enumIndex >= 0) && (enumIndex < info.enumStrings.count())) {
+        out.append(info.enumStrings[enumIndex].toUtf8());
+        return;
+    }
+
+    _appendFixed(out, value, info.decimals);
+    if (!info.units.isEmpty()) {
+        out.append(' ').append(info.units.toUtf8());
+    }
+}
+
+void TelemetrySidecarWriter::_appendFixed(QByteArray &out, double value, int decimals)
+{
+    // Locale independent and allocation free for everything telemetry can reasonably hold
+    decimals = qBound(0, decimals, 9);
+    double scale = 1;
+    for (int i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+
+    const double scaled = std::round(std::fabs(value) * scale);
+    if (!std::isfinite(value) || (scaled >= 9e18)) {
+        out.append(QByteArray::number(value, 'g', 17));
+        return;
+    }
+
+    qint64 fixed = static_cast<qint64>(scaled);
+    if ((value < 0) && (fixed != 0)) {
+        out.append('-');
+    }
+
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + (fixed % 10));
+        fixed /= 10;
+    } while ((fixed > 0) || (count <= decimals));
+
+    while (count > 0) {
+        out.append(digits[--count]);
+        if ((count == decimals) && (decimals > 0)) {
+            out.append('.');
+        }
+    }
+}
+
+void TelemetrySidecarWriter::_appendAssTime(QByteArray &out, qint64 usecs)
+{
+    // H:MM:SS.cc
+    const qint64 centis = qMax<qint64>(0, usecs) / 10000;
+    const qint64 seconds = centis / 100;
+    char text[32];
+    const int length = qsnprintf(text, sizeof(text), "%lld:%02lld:%02lld.%02lld",
+                                 seconds / 3600, (seconds / 60) % 60, seconds % 60, centis % 100);
+    out.append(text, length);
+}
+
+void TelemetrySidecarWriter::_appendSrtTime(QByteArray &out, qint64 usecs)
+{
+    // HH:MM:SS,mmm
+    const qint64 millis = qMax<qint64>(0, usecs) / 1000;
+    const qint64 seconds = millis / 1000;
+    char text[32];
+    const int length = qsnprintf(text, sizeof(text), "%02lld:%02lld:%02lld,%03lld",
+                                 seconds / 3600, (seconds / 60) % 60, seconds % 60, millis % 1000);
+    out.append(text, length);
+}
@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSize>
+#include <QtCore/QWaitCondition>
+
+#include <vector>
+
+class Fact;
+class QThread;
+class QTimer;
+
+Q_DECLARE_LOGGING_CATEGORY(TelemetrySidecarWriterLog)
+
+/// Records telemetry next to a video recording.
+///
+/// Samples are timestamped on the recording timeline, in microseconds from the recording epoch, so they line up
+/// with the video PTS. The caller only copies numbers into a queue, all formatting and file io happens on a writer
+/// thread. Any combination of these sidecars can be written:
+///
+///     Track       name.csv    One row per sample: time_ms followed by one column per channel
+///                 name.tlm    Binary, little endian:
+///                                 char[8] "QGCTLM\0" followed by version byte 1
+///                                 quint32 channel count, then per channel name and units as quint16 length + UTF-8
+///                                 records of qint64 time_us followed by one float32 per channel
+///     Subtitles   name.ass    Telemetry overlay sized to the video, one event per second
+///                 name.srt    Plain subtitles, one event per second
+class TelemetrySidecarWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetrySidecarWriter(QObject *parent = nullptr);
+    ~TelemetrySidecarWriter();
+
+    enum TrackFormat {
+        TrackNone = 0,
+        TrackCsv,
+        TrackBinary
+    };
+
+    enum SubtitleFormat {
+        SubtitleNone = 0,
+        SubtitleAss,
+        SubtitleSrt
+    };
+
+    struct Channel {
+        QString name;
+        QString label;
+        QString units;
+        int decimals = 1;
+        QStringList enumStrings;    ///< Shown in subtitles instead of the value when it matches enumValues
+        QList<double> enumValues;
+    };
+
+    /// Starts sampling the Facts shown in the telemetry bar
+    ///     @param videoFile Sidecars are written next to it with the same base name
+    ///     @param epochMsecs Wall clock time of time zero in the recording, ms since the Unix epoch
+    ///     @param videoSize Used to lay out ASS subtitles, invalid for 1920x1080
+    void startCapturingTelemetry(const QString &videoFile, qint64 epochMsecs, QSize videoSize = QSize());
+    void stopCapturingTelemetry();
+
+    /// Opens the sidecar files and starts the writer thread
+    ///     @param baseName Path without extension
+    bool open(const QString &baseName, const QList<Channel> &channels, TrackFormat trackFormat, SubtitleFormat subtitleFormat, QSize videoSize = QSize());
+
+    /// Queues one sample. Cheap enough to call at video frame rate.
+    ///     @param values One value per channel, NaN if unknown
+    void write(qint64 timeUsecs, const double *values);
+
+    /// Writes out everything queued and closes the files
+    void close();
+
+    bool isOpen() const { return _thread != nullptr; }
+
+    /// @return Sidecar files currently being written
+    QStringList openFiles() const;
+
+    /// @return Wildcards matching every sidecar format, for example to count them against a storage quota
+    static QStringList nameFilters();
+
+    static constexpr int kSubtitleIntervalMsecs = 1000; ///< Most players do weird stuff with shorter subtitles
+
+private slots:
+    void _captureTelemetry();
+
+private:
+    void _run();
+    void _writeBatch(const std::vector<qint64> &times, const std::vector<double> &values);
+    void _writeHeaders();
+    void _writeSubtitle(qint64 startUsecs, qint64 endUsecs, const double *values);
+    void _appendValueText(QByteArray &out, int channel, double value) const;
+
+    static void _appendFixed(QByteArray &out, double value, int decimals);
+    static void _appendAssTime(QByteArray &out, qint64 usecs);
+    static void _appendSrtTime(QByteArray &out, qint64 usecs);
+
+    // Capture, owner thread only
+    QTimer *_timer = nullptr;
+    QList<QPointer<Fact>> _facts;
+    std::vector<double> _sampleValues;
+    QElapsedTimer _elapsed;
+    qint64 _elapsedOffsetUsecs = 0;
+
+    // Set up by open(), read only while the writer thread runs
+    QList<Channel> _channels;
+    TrackFormat _trackFormat = TrackNone;
+    SubtitleFormat _subtitleFormat = SubtitleNone;
+    QSize _videoSize;
+    QByteArray _dateText;
+    QFile _trackFile;
+    QFile _subtitleFile;
+
+    // Writer thread only
+    QByteArray _trackBuffer;
+    QByteArray _subtitleBuffer;
+    QList<QByteArray> _assNameEvents;       ///< Position and names of each overlay column
+    QList<QByteArray> _assValuePositions;
+    qint64 _nextSubtitleUsecs = 0;
+    int _subtitleIndex = 0;
+
+    // Hand over between the two threads. Both sides keep their buffers so that no allocation happens once warm.
+    QThread *_thread = nullptr;
+    QMutex _mutex;
+    QWaitCondition _wake;
+    std::vector<qint64> _pendingTimes;
+    std::vector<double> _pendingValues;
+    bool _closing = false;
+};
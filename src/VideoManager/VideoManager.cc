@@ -15,10 +15,11 @@
 #include "QGCLoggingCategory.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
-#include "SubtitleWriter.h"
+#include "TelemetrySidecarWriter.h"
 #include "Vehicle.h"
 #include "VideoReceiver.h"
 #include "VideoSettings.h"
+#include "VideoStorageQuota.h"
 #ifdef QGC_GST_STREAMING
 #include "GStreamer.h"
 #else
@@ -53,7 +54,8 @@ Q_APPLICATION_STATIC(VideoManager, _videoManagerInstance);
 
 VideoManager::VideoManager(QObject *parent)
     : QObject(parent)
-    , _subtitleWriter(new SubtitleWriter(this))
+    , _telemetryWriter(new TelemetrySidecarWriter(this))
+    , _storageQuota(std::make_unique<VideoStorageQuota>())
     , _videoSettings(SettingsManager::instance()->videoSettings())
 {
     // qCDebug(VideoManagerLog) << Q_FUNC_INFO << this;
@@ -182,7 +184,11 @@ void VideoManager::init()
             if (videoReceiver.index == 0) {
                 _recording = active;
                 if (!active) {
-                    _subtitleWriter->stopCapturingTelemetry();
+                    _telemetryWriter->stopCapturingTelemetry();
+                    for (const QString &file : std::as_const(_telemetryFiles)) {
+                        _storageQuota->unprotect(file);
+                    }
+                    _telemetryFiles.clear();
                 }
                 emit recordingChanged();
             }
@@ -191,7 +197,26 @@ void VideoManager::init()
         (void) connect(videoReceiver.receiver, &VideoReceiver::recordingStarted, this, [this, &videoReceiver]() {
             qCDebug(VideoManagerLog) << "Video" << videoReceiver.index << "recording started";
             if (videoReceiver.index == 0) {
-                _subtitleWriter->startCapturingTelemetry(_videoFile);
+                const quint32 packedSize = _videoSize;
+                const QSize size(static_cast<int>(packedSize >> 16), static_cast<int>(packedSize & 0xFFFF));
+                _telemetryWriter->startCapturingTelemetry(_videoFile, _recordingEpochMsecs, size);
+                // Sidecars count against the quota, so keep them safe while they are written
+                _telemetryFiles = _telemetryWriter->openFiles();
+                for (const QString &file : std::as_const(_telemetryFiles)) {
+                    _storageQuota->protect(file);
+                }
+            }
+        });
+
+        (void) connect(videoReceiver.receiver, &VideoReceiver::recordingFileOpened, this, [this](const QString &file) {
+            _storageQuota->protect(file);
+        });
+
+        (void) connect(videoReceiver.receiver, &VideoReceiver::recordingFileClosed, this, [this](const QString &file) {
+            _storageQuota->unprotect(file);
+            // Segmented recordings keep the quota while they run
+            if (_recording) {
+                _enforceStorageQuota();
             }
         });
 
@@ -212,6 +237,9 @@ void VideoManager::init()
         });
     }
 
+    (void) connect(&_videoStatsTimer, &QTimer::timeout, this, &VideoManager::_updateVideoStats);
+    _videoStatsTimer.start(1000);
+
     _videoSourceChanged();
 
     startVideo();
@@ -251,14 +279,14 @@ void VideoManager::startRecording(const QString &videoFile)
         return;
     }
 
-    _cleanupOldVideos();
-
     const QString savePath = SettingsManager::instance()->appSettings()->videoSavePath();
     if (savePath.isEmpty()) {
         qgcApp()->showAppMessage(tr("Unabled to record video. Video save path must be specified in Settings."));
         return;
     }
 
+    _enforceStorageQuota();
+
     const QString videoFileUrl = videoFile.isEmpty() ? QDateTime::currentDateTime().toString("yyyy-MM-dd_hh.mm.ss") : videoFile;
     const QString ext = kFileExtension[fileFormat - VideoReceiver::FILE_FORMAT_MIN];
 
@@ -267,9 +295,17 @@ void VideoManager::startRecording(const QString &videoFile)
 
     _videoFile = videoFile1;
 
+    const unsigned segmentSeconds = _videoSettings->recordingSegmentDuration()->rawValue().toUInt();
+    const quint64 segmentBytes = static_cast<quint64>(_videoSettings->recordingSegmentSize()->rawValue().toUInt()) * 1024 * 1024;
+
+    // All streams and the telemetry sidecars are recorded against the same epoch so that their files line up
+    _recordingEpochMsecs = QDateTime::currentMSecsSinceEpoch();
+
     const QStringList videoFiles = {videoFile1, videoFile2};
     for (VideoReceiverData &videoReceiver : _videoReceiverData) {
         if (videoReceiver.receiver && videoReceiver.started) {
+            videoReceiver.receiver->setRecordingSegmentation(segmentSeconds, segmentBytes);
+            videoReceiver.receiver->setRecordingEpoch(_recordingEpochMsecs);
             videoReceiver.receiver->startRecording(videoFiles.at(videoReceiver.index), fileFormat);
         } else {
             qCDebug(VideoManagerLog) << "Video receiver is not ready.";
@@ -284,6 +320,69 @@ void VideoManager::stopRecording()
     }
 }
 
+bool VideoManager::startVideoStatsCsv(const QString &fileName)
+{
+    VideoReceiver *const receiver = _videoReceiverData[0].receiver;
+    if (!receiver) {
+        return false;
+    }
+
+    QString statsFile = fileName;
+    if (statsFile.isEmpty()) {
+        const QString savePath = SettingsManager::instance()->appSettings()->videoSavePath();
+        if (savePath.isEmpty()) {
+            qgcApp()->showAppMessage(tr("Unable to save video stats. Video save path must be specified in Settings."));
+            return false;
+        }
+        statsFile = savePath + "/" + QDateTime::currentDateTime().toString("yyyy-MM-dd_hh.mm.ss") + ".videostats.csv";
+    }
+
+    const bool started = receiver->stats()->startCsv(statsFile);
+    if (started) {
+        if (!_videoStatsFile.isEmpty()) {
+            _storageQuota->unprotect(_videoStatsFile);
+        }
+        _videoStatsFile = statsFile;
+        _storageQuota->protect(_videoStatsFile);
+    }
+    emit videoStatsChanged();
+    return started;
+}
+
+void VideoManager::stopVideoStatsCsv()
+{
+    if (_videoReceiverData[0].receiver) {
+        _videoReceiverData[0].receiver->stats()->stopCsv();
+        if (!_videoStatsFile.isEmpty()) {
+            _storageQuota->unprotect(_videoStatsFile);
+            _videoStatsFile.clear();
+        }
+        emit videoStatsChanged();
+    }
+}
+
+bool VideoManager::videoStatsCsvActive() const
+{
+    return _videoReceiverData[0].receiver && _videoReceiverData[0].receiver->stats()->csvActive();
+}
+
+void VideoManager::_updateVideoStats()
+{
+    if (!_videoReceiverData[0].receiver) {
+        return;
+    }
+
+    // Samples are queued by the streaming threads, the file is written from here
+    _videoReceiverData[0].receiver->stats()->flushCsv();
+
+    if (!_streaming) {
+        return;
+    }
+
+    _videoStats = VideoReceiverStats::toVariantMap(_videoReceiverData[0].receiver->stats()->snapshot());
+    emit videoStatsChanged();
+}
+
 void VideoManager::grabImage(const QString &imageFile)
 {
     if (imageFile.isEmpty()) {
@@ -468,38 +567,27 @@ void VideoManager::_initVideo()
     }
 }
 
-void VideoManager::_cleanupOldVideos()
+void VideoManager::_enforceStorageQuota()
 {
-    if (!SettingsManager::instance()->videoSettings()->enableStorageLimit()->rawValue().toBool()) {
+    if (!_videoSettings->enableStorageLimit()->rawValue().toBool()) {
         return;
     }
 
-    const QString savePath = SettingsManager::instance()->appSettings()->videoSavePath();
-    QDir videoDir = QDir(savePath);
-    videoDir.setFilter(QDir::Files | QDir::Readable | QDir::NoSymLinks | QDir::Writable);
-    videoDir.setSorting(QDir::Time);
-
     QStringList nameFilters;
     for (size_t i = 0; i < std::size(kFileExtension); i++) {
         nameFilters << QStringLiteral("*.") + kFileExtension[i];
     }
+    // Telemetry sidecars and video stats go with the recordings, so they are deleted oldest first along with them
+    nameFilters << TelemetrySidecarWriter::nameFilters();
 
-    videoDir.setNameFilters(nameFilters);
-    QFileInfoList vidList = videoDir.entryInfoList();
-    if (!vidList.isEmpty()) {
-        uint64_t total = 0;
-        for (int i = 0; i < vidList.size(); i++) {
-            total += vidList[i].size();
-        }
+    _storageQuota->setPath(SettingsManager::instance()->appSettings()->videoSavePath());
+    _storageQuota->setNameFilters(nameFilters);
+    _storageQuota->setMaxBytes(static_cast<quint64>(_videoSettings->maxVideoSize()->rawValue().toUInt()) * 1024 * 1024);
+    _storageQuota->setMinFreeBytes(static_cast<quint64>(_videoSettings->minFreeStorage()->rawValue().toUInt()) * 1024 * 1024);
 
-        const uint64_t maxSize = SettingsManager::instance()->videoSettings()->maxVideoSize()->rawValue().toUInt() * qPow(1024, 2);
-        while ((total >= maxSize) && !vidList.isEmpty()) {
-            total -= vidList.last().size();
-            qCDebug(VideoManagerLog) << "Removing old video file:" << vidList.last().filePath();
-            QFile file(vidList.last().filePath());
-            (void) file.remove();
-            vidList.removeLast();
-        }
+    const QStringList removed = _storageQuota->enforce();
+    for (const QString &file : removed) {
+        qCDebug(VideoManagerLog) << "Removed old video file:" << file;
     }
 }
 
@@ -760,7 +848,9 @@ void VideoManager::_startReceiver(unsigned id)
        So we should allow for some negotiation time for rtsp */
     const unsigned timeout = (source == VideoSettings::videoSourceRTSP ? rtsptimeout : 2);
 
-    _videoReceiverData[id].receiver->start(_videoReceiverData[id].uri, timeout, _videoReceiverData[id].lowLatencyStreaming ? -1 : 0);
+    const bool lowLatency = _videoReceiverData[id].lowLatencyStreaming;
+    _videoReceiverData[id].receiver->setLatencyProfile(lowLatency ? VideoReceiver::LATENCY_PROFILE_LOW : VideoReceiver::LATENCY_PROFILE_DEFAULT);
+    _videoReceiverData[id].receiver->start(_videoReceiverData[id].uri, timeout, 0);
 }
 
 void VideoManager::_stopReceiver(unsigned id)
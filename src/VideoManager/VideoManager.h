@@ -13,17 +13,22 @@
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSize>
+#include <QtCore/QTimer>
+#include <QtCore/QVariantMap>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <memory>
+
 Q_DECLARE_LOGGING_CATEGORY(VideoManagerLog)
 
 #define MAX_VIDEO_RECEIVERS 2
 
 class FinishVideoInitialization;
-class SubtitleWriter;
+class TelemetrySidecarWriter;
 class Vehicle;
 class VideoReceiver;
 class VideoSettings;
+class VideoStorageQuota;
 
 class VideoManager : public QObject
 {
@@ -50,6 +55,8 @@ class VideoManager : public QObject
     Q_PROPERTY(QSize    videoSize               READ videoSize                                  NOTIFY videoSizeChanged)
     Q_PROPERTY(QString  imageFile               READ imageFile                                  NOTIFY imageFileChanged)
     Q_PROPERTY(QString  uvcVideoSourceID        READ uvcVideoSourceID                           NOTIFY uvcVideoSourceIDChanged)
+    Q_PROPERTY(QVariantMap videoStats           READ videoStats                                 NOTIFY videoStatsChanged)
+    Q_PROPERTY(bool     videoStatsCsvActive     READ videoStatsCsvActive                        NOTIFY videoStatsChanged)
 
     friend class FinishVideoInitialization;
 
@@ -68,6 +75,12 @@ public:
     Q_INVOKABLE void stopRecording();
     Q_INVOKABLE void stopVideo();
 
+    /// Starts dumping per-frame stage latencies of the primary stream to a csv file
+    ///     @param fileName Empty for a time stamped file in the video save path
+    /// @return true: dump started
+    Q_INVOKABLE bool startVideoStatsCsv(const QString &fileName = QString());
+    Q_INVOKABLE void stopVideoStatsCsv();
+
     void init();
     bool autoStreamConfigured() const;
     bool decoding() const { return _decoding; }
@@ -88,6 +101,8 @@ public:
     QSize videoSize() const { return QSize((_videoSize >> 16) & 0xFFFF, _videoSize & 0xFFFF); }
     QString imageFile() const { return _imageFile; }
     QString uvcVideoSourceID() const { return _uvcVideoSourceID; }
+    QVariantMap videoStats() const { return _videoStats; }
+    bool videoStatsCsvActive() const;
     void setfullScreen(bool on);
 
 signals:
@@ -105,6 +120,7 @@ signals:
     void streamingChanged();
     void uvcVideoSourceIDChanged();
     void videoSizeChanged();
+    void videoStatsChanged();
 
 private slots:
     bool _updateUVC();
@@ -112,6 +128,7 @@ private slots:
     void _lowLatencyModeChanged() { _restartAllVideos(); }
     void _setActiveVehicle(Vehicle *vehicle);
     void _videoSourceChanged();
+    void _updateVideoStats();
 
 private:
     bool _updateAutoStream(unsigned id);
@@ -122,7 +139,7 @@ private:
     void _restartVideo(unsigned id);
     void _startReceiver(unsigned id);
     void _stopReceiver(unsigned id);
-    static void _cleanupOldVideos();
+    void _enforceStorageQuota();
 
     struct VideoReceiverData {
         VideoReceiver *receiver = nullptr;
@@ -134,7 +151,10 @@ private:
     };
     QList<VideoReceiverData> _videoReceiverData = QList<VideoReceiverData>(MAX_VIDEO_RECEIVERS);
 
-    SubtitleWriter *_subtitleWriter = nullptr;
+    TelemetrySidecarWriter *_telemetryWriter = nullptr;
+    std::unique_ptr<VideoStorageQuota> _storageQuota;
+    QStringList _telemetryFiles;
+    QString _videoStatsFile;
 
     bool _initialized = false;
     bool _fullScreen = false;
@@ -145,6 +165,9 @@ private:
     QString _imageFile;
     QString _uvcVideoSourceID;
     QString _videoFile;
+    qint64 _recordingEpochMsecs = 0;
+    QVariantMap _videoStats;
+    QTimer _videoStatsTimer;
     Vehicle *_activeVehicle = nullptr;
     VideoSettings *_videoSettings = nullptr;
 };
@@ -19,10 +19,19 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QUrl>
+#include <QtCore/QUrlQuery>
 #include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
 
 QGC_LOGGING_CATEGORY(VideoReceiverLog, "VideoReceiverLog")
 
+//-- Low latency profile tuning
+//   In order packets leave the jitter buffer immediately, its latency only bounds how long a gap is waited for
+static constexpr guint kLowLatencyJitterBufferMs   = 20;
+//   Decoder queue depth after which the oldest frames are dropped
+static constexpr guint kLowLatencyQueueBuffers     = 3;
+
 //-----------------------------------------------------------------------------
 // Our pipeline look like this:
 //
@@ -97,11 +106,15 @@ GstVideoReceiver::start(const QString& uri, unsigned timeout, int buffer)
     _uri = uri;
     _timeout = timeout;
     _buffer = buffer;
+    _lowLatency = _latencyProfile == LATENCY_PROFILE_LOW;
 
-    qCDebug(VideoReceiverLog) << "Starting" << _uri << ", buffer" << _buffer;
+    qCDebug(VideoReceiverLog) << "Starting" << _uri << ", buffer" << _buffer << ", low latency" << _lowLatency;
 
     _endOfStream = false;
 
+    _stats.reset();
+    _pipelineLatency = 0;
+
     bool running    = false;
     bool pipelineUp = false;
 
@@ -132,6 +145,17 @@ GstVideoReceiver::start(const QString& uri, unsigned timeout, int buffer)
             break;
         }
 
+        if (_lowLatency) {
+            // Rather drop frames than let them pile up in front of a decoder which cannot keep up. The recorder
+            // branch keeps its default queue so that recordings stay complete.
+            g_object_set(decoderQueue,
+                         "max-size-buffers", kLowLatencyQueueBuffers,
+                         "max-size-bytes", 0,
+                         "max-size-time", static_cast<guint64>(0),
+                         nullptr);
+            gst_util_set_object_arg(G_OBJECT(decoderQueue), "leaky", "downstream");
+        }
+
         if((_decoderValve = gst_element_factory_make("valve", nullptr)) == nullptr)  {
             qCCritical(VideoReceiverLog) << "gst_element_factory_make('valve') failed";
             break;
@@ -523,6 +547,9 @@ GstVideoReceiver::startRecording(const QString& videoFile, FILE_FORMAT format)
 
     qCDebug(VideoReceiverLog) << "New video file:" << videoFile <<  "" << _uri;
 
+    _recordingSegmented = _segmentMaxSeconds > 0 || _segmentMaxBytes > 0;
+    _recordingOriginValid = _recordingEpochMsecs > 0 && _wallClockToRunningTime(_recordingEpochMsecs, _recordingOrigin);
+
     if ((_fileSink = _makeFileSink(videoFile, format)) == nullptr) {
         qCCritical(VideoReceiverLog) << "_makeFileSink() failed" << _uri;
         _dispatchSignal([this](){
@@ -574,6 +601,14 @@ GstVideoReceiver::startRecording(const QString& videoFile, FILE_FORMAT format)
         emit onStartRecordingComplete(STATUS_OK);
         emit recordingChanged(_recording);
     });
+
+    // Segments announce themselves through splitmuxsink messages
+    if (!_recordingSegmented) {
+        _recordingFile = videoFile;
+        _dispatchSignal([this, videoFile](){
+            emit recordingFileOpened(videoFile);
+        });
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -748,6 +783,44 @@ GstVideoReceiver::_filterParserCaps(GstElement* bin, GstPad* pad, GstElement* el
     return TRUE;
 }
 
+void
+GstVideoReceiver::_onDecoderElementAdded(GstBin* bin, GstBin* subBin, GstElement* element, gpointer data)
+{
+    Q_UNUSED(bin)
+    Q_UNUSED(subBin)
+    Q_UNUSED(data)
+
+    GstElementFactory* factory = gst_element_get_factory(element);
+
+    if (factory == nullptr) {
+        return;
+    }
+
+    const gchar* klass = gst_element_factory_get_metadata(factory, GST_ELEMENT_METADATA_KLASS);
+
+    if (klass == nullptr || g_strstr_len(klass, -1, "Decoder") == nullptr) {
+        return;
+    }
+
+    // Tune by property rather than by element name so that software and hardware decoders are treated alike
+    GObjectClass* objectClass = G_OBJECT_GET_CLASS(element);
+
+    // Frame threading delays output by one frame per thread, slice threading does not
+    if (g_object_class_find_property(objectClass, "thread-type") != nullptr) {
+        gst_util_set_object_arg(G_OBJECT(element), "thread-type", "slice");
+    }
+
+    if (g_object_class_find_property(objectClass, "max-threads") != nullptr) {
+        g_object_set(element, "max-threads", QThread::idealThreadCount(), nullptr);
+    }
+
+    if (g_object_class_find_property(objectClass, "low-latency") != nullptr) {
+        g_object_set(element, "low-latency", TRUE, nullptr);
+    }
+
+    qCDebug(VideoReceiverLog) << "Low latency decoder" << GST_OBJECT_NAME(factory);
+}
+
 GstElement*
 GstVideoReceiver::_makeSource(const QString& uri)
 {
@@ -761,6 +834,7 @@ GstVideoReceiver::_makeSource(const QString& uri)
     bool isUdp265   = uri.contains("udp265://", Qt::CaseInsensitive);
     bool isTcpMPEGTS= uri.contains("tcp://",    Qt::CaseInsensitive);
     bool isUdpMPEGTS= uri.contains("mpegts://", Qt::CaseInsensitive);
+    bool isTestSrc  = uri.contains("videotestsrc://", Qt::CaseInsensitive);
 
     GstElement* source  = nullptr;
     GstElement* buffer  = nullptr;
@@ -772,6 +846,95 @@ GstVideoReceiver::_makeSource(const QString& uri)
     do {
         QUrl url(uri);
 
+        if (isTestSrc) {
+            // Test pattern, used to exercise the pipeline without a network source or a display. Raw unless an
+            // encoder is requested, in which case it behaves like an H.264 camera
+            //  videotestsrc://?width=320&height=240&fps=30&pattern=ball&encoder=x264&keyint=30
+            const QUrlQuery query(url);
+            const int width     = query.hasQueryItem("width")   ? query.queryItemValue("width").toInt()     : 320;
+            const int height    = query.hasQueryItem("height")  ? query.queryItemValue("height").toInt()    : 240;
+            const int fps       = query.hasQueryItem("fps")     ? query.queryItemValue("fps").toInt()       : 30;
+
+            if ((source = gst_element_factory_make("videotestsrc", "source")) == nullptr) {
+                qCCritical(VideoReceiverLog) << "gst_element_factory_make('videotestsrc') failed";
+                break;
+            }
+
+            g_object_set(static_cast<gpointer>(source), "is-live", TRUE, nullptr);
+            if (query.hasQueryItem("pattern")) {
+                gst_util_set_object_arg(G_OBJECT(source), "pattern", qPrintable(query.queryItemValue("pattern")));
+            }
+
+            if ((buffer = gst_element_factory_make("capsfilter", nullptr)) == nullptr) {
+                qCCritical(VideoReceiverLog) << "gst_element_factory_make('capsfilter') failed";
+                break;
+            }
+
+            GstCaps* caps = gst_caps_new_simple("video/x-raw", "width", G_TYPE_INT, width, "height", G_TYPE_INT, height, "framerate", GST_TYPE_FRACTION, fps, 1, nullptr);
+            g_object_set(static_cast<gpointer>(buffer), "caps", caps, nullptr);
+            gst_caps_unref(caps);
+            caps = nullptr;
+
+            if ((bin = gst_bin_new("sourcebin")) == nullptr) {
+                qCCritical(VideoReceiverLog) << "gst_bin_new('sourcebin') failed";
+                break;
+            }
+
+            gst_bin_add_many(GST_BIN(bin), source, buffer, nullptr);
+
+            // Both are owned by the bin from here on
+            GstElement* testSrc = source;
+            GstElement* filter  = buffer;
+            source = buffer = nullptr;
+
+            if (!gst_element_link(testSrc, filter)) {
+                qCCritical(VideoReceiverLog) << "gst_element_link() failed";
+                break;
+            }
+
+            GstElement* last = filter;
+
+            if (query.queryItemValue("encoder") == QStringLiteral("x264")) {
+                GstElement* encoder = gst_element_factory_make("x264enc", nullptr);
+                GstElement* h264parse = gst_element_factory_make("h264parse", nullptr);
+
+                if (encoder == nullptr || h264parse == nullptr) {
+                    qCCritical(VideoReceiverLog) << "gst_element_factory_make('x264enc', 'h264parse') failed";
+                    if (encoder != nullptr) {
+                        gst_object_unref(encoder);
+                    }
+                    if (h264parse != nullptr) {
+                        gst_object_unref(h264parse);
+                    }
+                    break;
+                }
+
+                const int keyint = query.hasQueryItem("keyint") ? query.queryItemValue("keyint").toInt() : fps;
+                gst_util_set_object_arg(G_OBJECT(encoder), "tune", "zerolatency");
+                gst_util_set_object_arg(G_OBJECT(encoder), "speed-preset", "ultrafast");
+                g_object_set(static_cast<gpointer>(encoder), "key-int-max", static_cast<guint>(keyint), nullptr);
+                g_object_set(static_cast<gpointer>(h264parse), "config-interval", -1, nullptr);
+
+                gst_bin_add_many(GST_BIN(bin), encoder, h264parse, nullptr);
+
+                if (!gst_element_link_many(filter, encoder, h264parse, nullptr)) {
+                    qCCritical(VideoReceiverLog) << "gst_element_link() failed";
+                    break;
+                }
+
+                last = h264parse;
+            }
+
+            GstPad* lastPad = gst_element_get_static_pad(last, "src");
+            _wrapWithGhostPad(last, lastPad, nullptr);
+            gst_object_unref(lastPad);
+            lastPad = nullptr;
+
+            srcbin = bin;
+            bin = nullptr;
+            break;
+        }
+
         if(isTcpMPEGTS) {
             if ((source = gst_element_factory_make("tcpclientsrc", "source")) != nullptr) {
                 g_object_set(static_cast<gpointer>(source), "host", qPrintable(url.host()), "port", url.port(), nullptr);
@@ -779,6 +942,10 @@ GstVideoReceiver::_makeSource(const QString& uri)
         } else if (isRtsp) {
             if ((source = gst_element_factory_make("rtspsrc", "source")) != nullptr) {
                 g_object_set(static_cast<gpointer>(source), "location", qPrintable(uri), "latency", 17, "udp-reconnect", 1, "timeout", _udpReconnect_us, NULL);
+                if (_lowLatency) {
+                    g_object_set(static_cast<gpointer>(source), "latency", _jitterBufferLatencyMs(), "drop-on-latency", TRUE, nullptr);
+                    gst_util_set_object_arg(G_OBJECT(source), "buffer-mode", "none");
+                }
             }
         } else if(isUdp264 || isUdp265 || isUdpMPEGTS) {
             if ((source = gst_element_factory_make("udpsrc", "source")) != nullptr) {
@@ -857,6 +1024,14 @@ GstVideoReceiver::_makeSource(const QString& uri)
                     break;
                 }
 
+                if (_lowLatency) {
+                    // Timestamp on arrival instead of smoothing the sender clock and drop whatever arrives too late
+                    g_object_set(static_cast<gpointer>(buffer), "latency", _jitterBufferLatencyMs(), "drop-on-latency", TRUE, nullptr);
+                    gst_util_set_object_arg(G_OBJECT(buffer), "mode", "none");
+                } else if (_buffer > 0) {
+                    g_object_set(static_cast<gpointer>(buffer), "latency", static_cast<guint>(_buffer), nullptr);
+                }
+
                 gst_bin_add(GST_BIN(bin), buffer);
 
                 if (!gst_element_link_many(source, buffer, parser, nullptr)) {
@@ -921,6 +1096,10 @@ GstVideoReceiver::_makeDecoder(GstCaps* caps, GstElement* videoSink)
             qCCritical(VideoReceiverLog) << "gst_element_factory_make('decodebin3') failed";
             break;
         }
+
+        if (_lowLatency) {
+            g_signal_connect(decoder, "deep-element-added", G_CALLBACK(_onDecoderElementAdded), this);
+        }
     } while(0);
 
     return decoder;
@@ -946,21 +1125,41 @@ GstVideoReceiver::_makeFileSink(const QString& videoFile, FILE_FORMAT format)
             break;
         }
 
-        if ((sink = gst_element_factory_make("filesink", nullptr)) == nullptr) {
-            qCCritical(VideoReceiverLog) << "gst_element_factory_make('filesink') failed";
-            break;
-        }
+        if (_recordingSegmented) {
+            // splitmuxsink cuts at keyframes and finalizes every segment with its own muxer instance
+            if ((sink = gst_element_factory_make("splitmuxsink", nullptr)) == nullptr) {
+                qCCritical(VideoReceiverLog) << "gst_element_factory_make('splitmuxsink') failed";
+                break;
+            }
 
-        g_object_set(static_cast<gpointer>(sink), "location", qPrintable(videoFile), nullptr);
+            g_object_set(static_cast<gpointer>(sink),
+                         "location", _segmentLocation(videoFile).toUtf8().constData(),
+                         "max-size-time", static_cast<guint64>(_segmentMaxSeconds) * GST_SECOND,
+                         "max-size-bytes", static_cast<guint64>(_segmentMaxBytes),
+                         "muxer", mux,
+                         nullptr);
+
+            // Owned by splitmuxsink from here on
+            mux = nullptr;
+        } else {
+            if ((sink = gst_element_factory_make("filesink", nullptr)) == nullptr) {
+                qCCritical(VideoReceiverLog) << "gst_element_factory_make('filesink') failed";
+                break;
+            }
+
+            g_object_set(static_cast<gpointer>(sink), "location", qPrintable(videoFile), nullptr);
+        }
 
         if ((bin = gst_bin_new("sinkbin")) == nullptr) {
             qCCritical(VideoReceiverLog) << "gst_bin_new('sinkbin') failed";
             break;
         }
 
+        GstElement* padOwner = _recordingSegmented ? sink : mux;
+
         GstPadTemplate* padTemplate;
 
-        if ((padTemplate = gst_element_class_get_pad_template(GST_ELEMENT_GET_CLASS(mux), "video_%u")) == nullptr) {
+        if ((padTemplate = gst_element_class_get_pad_template(GST_ELEMENT_GET_CLASS(padOwner), _recordingSegmented ? "video" : "video_%u")) == nullptr) {
             qCCritical(VideoReceiverLog) << "gst_element_class_get_pad_template(mux) failed";
             break;
         }
@@ -968,12 +1167,16 @@ GstVideoReceiver::_makeFileSink(const QString& videoFile, FILE_FORMAT format)
         // FIXME: AV: pad handling is potentially leaking (and other similar places too!)
         GstPad* pad;
 
-        if ((pad = gst_element_request_pad(mux, padTemplate, nullptr, nullptr)) == nullptr) {
+        if ((pad = gst_element_request_pad(padOwner, padTemplate, nullptr, nullptr)) == nullptr) {
             qCCritical(VideoReceiverLog) << "gst_element_request_pad(mux) failed";
             break;
         }
 
-        gst_bin_add_many(GST_BIN(bin), mux, sink, nullptr);
+        if (mux != nullptr) {
+            gst_bin_add_many(GST_BIN(bin), mux, sink, nullptr);
+        } else {
+            gst_bin_add(GST_BIN(bin), sink);
+        }
 
         releaseElements = false;
 
@@ -984,7 +1187,7 @@ GstVideoReceiver::_makeFileSink(const QString& videoFile, FILE_FORMAT format)
         gst_object_unref(pad);
         pad = nullptr;
 
-        if (!gst_element_link(mux, sink)) {
+        if (mux != nullptr && !gst_element_link(mux, sink)) {
             qCCritical(VideoReceiverLog) << "gst_element_link() failed";
             break;
         }
@@ -1154,7 +1357,7 @@ GstVideoReceiver::_addVideoSink(GstPad* pad)
 
     gst_element_sync_state_with_parent(_videoSink);
 
-    g_object_set(_videoSink, "sync", _buffer >= 0, NULL);
+    g_object_set(_videoSink, "sync", _syncVideoSink(), NULL);
 
     GST_DEBUG_BIN_TO_DOT_FILE(GST_BIN(_pipeline), GST_DEBUG_GRAPH_SHOW_ALL, "pipeline-with-videosink");
 
@@ -1184,6 +1387,79 @@ GstVideoReceiver::_addVideoSink(GstPad* pad)
     return true;
 }
 
+void
+GstVideoReceiver::_updatePipelineLatency(void)
+{
+    if (_pipeline == nullptr) {
+        return;
+    }
+
+    GstQuery* query = gst_query_new_latency();
+
+    if (gst_element_query(_pipeline, query)) {
+        gboolean live;
+        GstClockTime minLatency;
+
+        gst_query_parse_latency(query, &live, &minLatency, nullptr);
+
+        if (GST_CLOCK_TIME_IS_VALID(minLatency)) {
+            _pipelineLatency = static_cast<qint64>(minLatency);
+            qCDebug(VideoReceiverLog) << "Pipeline latency" << minLatency / GST_MSECOND << "ms" << _uri;
+        }
+    }
+
+    gst_query_unref(query);
+    query = nullptr;
+}
+
+bool
+GstVideoReceiver::_wallClockToRunningTime(qint64 msecsSinceEpoch, qint64& runningTime)
+{
+    GstClock* clock = gst_element_get_clock(_pipeline);
+
+    if (clock == nullptr) {
+        return false;
+    }
+
+    // Sample both clocks back to back, the pipeline clock need not be related to the wall clock at all
+    const qint64 clockNow = static_cast<qint64>(gst_clock_get_time(clock));
+    const qint64 wallNow = g_get_real_time() * GST_USECOND;
+
+    gst_object_unref(clock);
+    clock = nullptr;
+
+    const qint64 runningNow = clockNow - static_cast<qint64>(gst_element_get_base_time(_pipeline));
+    runningTime = runningNow - (wallNow - (msecsSinceEpoch * GST_MSECOND));
+
+    return true;
+}
+
+QString
+GstVideoReceiver::_segmentLocation(const QString& videoFile)
+{
+    // splitmuxsink expands the location with printf
+    const QFileInfo fileInfo(videoFile);
+    QString baseName = fileInfo.completeBaseName();
+    (void) baseName.replace(QLatin1Char('%'), QStringLiteral("%%"));
+    QString path = fileInfo.path();
+    (void) path.replace(QLatin1Char('%'), QStringLiteral("%%"));
+
+    return path + QLatin1Char('/') + baseName + QStringLiteral(".%03d.") + fileInfo.suffix();
+}
+
+bool
+GstVideoReceiver::_syncVideoSink(void) const
+{
+    // Without clock sync frames are shown as soon as they are decoded
+    return _buffer >= 0 && !_lowLatency;
+}
+
+guint
+GstVideoReceiver::_jitterBufferLatencyMs(void) const
+{
+    return _buffer > 0 ? static_cast<guint>(_buffer) : kLowLatencyJitterBufferMs;
+}
+
 void
 GstVideoReceiver::_noteTeeFrame(void)
 {
@@ -1322,6 +1598,14 @@ GstVideoReceiver::_shutdownRecordingBranch(void)
 
     _removingRecorder = false;
 
+    if (!_recordingFile.isEmpty()) {
+        const QString closedFile = _recordingFile;
+        _recordingFile.clear();
+        _dispatchSignal([this, closedFile](){
+            emit recordingFileClosed(closedFile);
+        });
+    }
+
     if (_recording) {
         _recording = false;
         qCDebug(VideoReceiverLog) << "Recording stopped";
@@ -1386,10 +1670,47 @@ GstVideoReceiver::_onBusMessage(GstBus* bus, GstMessage* msg, gpointer data)
             pThis->_handleEOS();
         });
         break;
+    case GST_MESSAGE_QOS:
+        do {
+            GstFormat format;
+            guint64 processed;
+            guint64 dropped;
+            gint64 jitter;
+
+            gst_message_parse_qos_stats(msg, &format, &processed, &dropped);
+            gst_message_parse_qos_values(msg, &jitter, nullptr, nullptr);
+
+            pThis->_stats.noteQos(format == GST_FORMAT_BUFFERS ? dropped : 0, jitter);
+        } while(0);
+        break;
+    case GST_MESSAGE_LATENCY:
+        pThis->_slotHandler.dispatch([pThis](){
+            pThis->_updatePipelineLatency();
+        });
+        break;
     case GST_MESSAGE_ELEMENT:
         do {
             const GstStructure* s = gst_message_get_structure (msg);
 
+            const bool fragmentOpened = gst_structure_has_name(s, "splitmuxsink-fragment-opened");
+            if (fragmentOpened || gst_structure_has_name(s, "splitmuxsink-fragment-closed")) {
+                const gchar* location = gst_structure_get_string(s, "location");
+                if (location != nullptr) {
+                    const QString file = QString::fromUtf8(location);
+                    pThis->_slotHandler.dispatch([pThis, file, fragmentOpened](){
+                        qCDebug(VideoReceiverLog) << (fragmentOpened ? "Segment opened" : "Segment closed") << file;
+                        pThis->_dispatchSignal([pThis, file, fragmentOpened](){
+                            if (fragmentOpened) {
+                                emit pThis->recordingFileOpened(file);
+                            } else {
+                                emit pThis->recordingFileClosed(file);
+                            }
+                        });
+                    });
+                }
+                break;
+            }
+
             if (!gst_structure_has_name (s, "GstBinForwarded")) {
                 break;
             }
@@ -1512,15 +1833,41 @@ GstVideoReceiver::_padProbe(GstElement* element, GstPad* pad, gpointer user_data
     return TRUE;
 }
 
+qint64
+GstVideoReceiver::_runningTime(GstPad* pad)
+{
+    qint64 runningTime = -1;
+
+    GstElement* element = gst_pad_get_parent_element(pad);
+
+    if (element != nullptr) {
+        GstClock* clock = gst_element_get_clock(element);
+
+        if (clock != nullptr) {
+            runningTime = static_cast<qint64>(gst_clock_get_time(clock) - gst_element_get_base_time(element));
+            gst_object_unref(clock);
+            clock = nullptr;
+        }
+
+        gst_object_unref(element);
+        element = nullptr;
+    }
+
+    return runningTime;
+}
+
 GstPadProbeReturn
 GstVideoReceiver::_teeProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
 {
-    Q_UNUSED(pad)
-    Q_UNUSED(info)
-
     if(user_data != nullptr) {
         GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
         pThis->_noteTeeFrame();
+
+        // Live sources timestamp buffers with the running time at which they arrived, so the difference to the
+        // current running time is the time spent in the jitter buffer, depayloader and parser
+        GstBuffer* buf = gst_pad_probe_info_get_buffer(info);
+        const qint64 pts = (buf != nullptr && GST_BUFFER_PTS_IS_VALID(buf)) ? static_cast<qint64>(GST_BUFFER_PTS(buf)) : -1;
+        pThis->_stats.noteFrameParsed(pts, _runningTime(pad));
     }
 
     return GST_PAD_PROBE_OK;
@@ -1529,9 +1876,6 @@ GstVideoReceiver::_teeProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_da
 GstPadProbeReturn
 GstVideoReceiver::_videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
 {
-    Q_UNUSED(pad)
-    Q_UNUSED(info)
-
     if(user_data != nullptr) {
         GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
 
@@ -1563,6 +1907,18 @@ GstVideoReceiver::_videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer u
         }
 
         pThis->_noteVideoSinkFrame();
+
+        GstBuffer* buf = gst_pad_probe_info_get_buffer(info);
+        const qint64 pts = (buf != nullptr && GST_BUFFER_PTS_IS_VALID(buf)) ? static_cast<qint64>(GST_BUFFER_PTS(buf)) : -1;
+        const qint64 runningTime = _runningTime(pad);
+
+        // A synchronised sink holds each frame until its running time plus the pipeline latency
+        qint64 sinkWait = -1;
+        if (pts >= 0 && runningTime >= 0) {
+            sinkWait = pThis->_syncVideoSink() ? qMax<qint64>(0, pts + pThis->_pipelineLatency - runningTime) : 0;
+        }
+
+        pThis->_stats.noteFrameDecoded(pts, runningTime, sinkWait);
     }
 
     return GST_PAD_PROBE_OK;
@@ -1600,11 +1956,25 @@ GstVideoReceiver::_keyframeWatch(GstPad* pad, GstPadProbeInfo* info, gpointer us
         return GST_PAD_PROBE_DROP;
     }
 
-    // set media file '0' offset to current timeline position - we don't want to touch other elements in the graph, except these which are downstream!
-    gst_pad_set_offset(pad, -static_cast<gint64>(buf->pts));
-
     GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
 
+    // set media file '0' offset to current timeline position - we don't want to touch other elements in the graph, except these which are downstream!
+    // Recordings which share an epoch are offset to it instead, so that frames captured at the same moment carry the
+    // same timestamp in every file. The epoch origin is a running time, so the keyframe is compared in running time too.
+    gint64 keyframeTime = static_cast<gint64>(buf->pts);
+    GstEvent* segmentEvent = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+    if (segmentEvent != nullptr) {
+        const GstSegment* segment = nullptr;
+        gst_event_parse_segment(segmentEvent, &segment);
+        const guint64 runningTime = gst_segment_to_running_time(segment, GST_FORMAT_TIME, buf->pts);
+        if (GST_CLOCK_TIME_IS_VALID(runningTime)) {
+            keyframeTime = static_cast<gint64>(runningTime);
+        }
+        gst_event_unref(segmentEvent);
+    }
+    const gint64 origin = (pThis->_recordingOriginValid && pThis->_recordingOrigin <= keyframeTime) ? pThis->_recordingOrigin : keyframeTime;
+    gst_pad_set_offset(pad, -origin);
+
     qCDebug(VideoReceiverLog) << "Got keyframe, stop dropping buffers";
 
     pThis->_dispatchSignal([pThis]() {
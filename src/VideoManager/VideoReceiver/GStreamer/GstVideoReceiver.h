@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <QtCore/QAtomicInteger>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QTimer>
 #include <QtCore/QThread>
@@ -112,6 +113,10 @@ protected:
     virtual void _noteTeeFrame(void);
     virtual void _noteVideoSinkFrame(void);
     virtual void _noteEndOfStream(void);
+    virtual void _updatePipelineLatency(void);
+    bool _syncVideoSink(void) const;
+    bool _wallClockToRunningTime(qint64 msecsSinceEpoch, qint64& runningTime);
+    guint _jitterBufferLatencyMs(void) const;
     virtual bool _unlinkBranch(GstElement* from);
     virtual void _shutdownDecodingBranch (void);
     virtual void _shutdownRecordingBranch(void);
@@ -125,10 +130,13 @@ protected:
     static void _linkPad(GstElement* element, GstPad* pad, gpointer data);
     static gboolean _padProbe(GstElement* element, GstPad* pad, gpointer user_data);
     static gboolean _filterParserCaps(GstElement* bin, GstPad* pad, GstElement* element, GstQuery* query, gpointer data);
+    static void _onDecoderElementAdded(GstBin* bin, GstBin* subBin, GstElement* element, gpointer data);
     static GstPadProbeReturn _teeProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
     static GstPadProbeReturn _videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
     static GstPadProbeReturn _eosProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
     static GstPadProbeReturn _keyframeWatch(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+    static qint64 _runningTime(GstPad* pad);
+    static QString _segmentLocation(const QString& videoFile);
 
     bool                _streaming;
     bool                _decoding;
@@ -142,6 +150,10 @@ protected:
     GstElement*         _decoder;
     GstElement*         _videoSink;
     GstElement*         _fileSink;
+    bool                _recordingSegmented = false;
+    QString             _recordingFile;         ///< Single file recording in progress, empty when segmented
+    qint64              _recordingOrigin = 0;   ///< Running time which becomes time zero of the recording
+    bool                _recordingOriginValid = false;
     GstElement*         _pipeline;
 
     qint64              _lastSourceFrameTime;
@@ -151,6 +163,9 @@ protected:
 
     gulong              _teeProbeId = 0;
 
+    //-- Pipeline latency in ns, used to work out how long decoded frames wait in the sink
+    QAtomicInteger<qint64> _pipelineLatency = 0;
+
     QTimer              _watchdogTimer;
 
     //-- RTSP UDP reconnect timeout
@@ -159,6 +174,7 @@ protected:
     QString             _uri;
     unsigned            _timeout;
     int                 _buffer;
+    bool                _lowLatency = false;
 
     Worker              _slotHandler;
     uint32_t            _signalDepth;
@@ -18,6 +18,8 @@
 #include <QtCore/QObject>
 #include <QtCore/QSize>
 
+#include "VideoReceiverStats.h"
+
 class VideoReceiver : public QObject
 {
     Q_OBJECT
@@ -47,12 +49,38 @@ public:
 
     Q_ENUM(STATUS)
 
+    typedef enum {
+        LATENCY_PROFILE_DEFAULT = 0,    // Jitter buffer sized by the start() buffer argument, clock synchronised sink
+        LATENCY_PROFILE_LOW,            // Drop-on-latency jitter buffer, leaky decoder queue, low delay decoding, unsynchronised sink
+    } LATENCY_PROFILE;
+
+    Q_ENUM(LATENCY_PROFILE)
+
+    /// Selects how the next start() trades smoothness for latency. Has no effect on a running stream.
+    void setLatencyProfile(LATENCY_PROFILE profile) { _latencyProfile = profile; }
+    LATENCY_PROFILE latencyProfile(void) const { return _latencyProfile; }
+
+    /// Splits the next recording into segments which are finalized independently, so that a recording which is
+    /// cut short only loses its last segment. Both 0 records a single file.
+    ///     @param maxSeconds Segment duration, 0 for no limit
+    ///     @param maxBytes Segment size, 0 for no limit
+    void setRecordingSegmentation(unsigned maxSeconds, quint64 maxBytes) { _segmentMaxSeconds = maxSeconds; _segmentMaxBytes = maxBytes; }
+
+    /// Wall clock time, in ms since the Unix epoch, which becomes time zero in the next recording. Streams which
+    /// start recording with the same epoch share one timebase. 0 starts the recording at its first keyframe.
+    void setRecordingEpoch(qint64 epochMsecs) { _recordingEpochMsecs = epochMsecs; }
+
+    /// Per-stage frame timing. Stays empty for receivers which are not instrumented.
+    VideoReceiverStats* stats(void) { return &_stats; }
+
 signals:
     void timeout(void);
     void streamingChanged(bool active);
     void decodingChanged(bool active);
     void recordingChanged(bool active);
     void recordingStarted(void);
+    void recordingFileOpened(const QString& file);
+    void recordingFileClosed(const QString& file);
     void videoSizeChanged(QSize size);
 
     void onStartComplete(STATUS status);
@@ -72,7 +100,16 @@ public slots:
     virtual void stop(void) = 0;
     virtual void startDecoding(void* sink) = 0;
     virtual void stopDecoding(void) = 0;
+    // videoFile:
+    //      Segmented recordings insert a segment number before the extension: name.000.mkv, name.001.mkv, ...
     virtual void startRecording(const QString& videoFile, FILE_FORMAT format) = 0;
     virtual void stopRecording(void) = 0;
     virtual void takeScreenshot(const QString& imageFile) = 0;
+
+protected:
+    VideoReceiverStats _stats;
+    LATENCY_PROFILE _latencyProfile = LATENCY_PROFILE_DEFAULT;
+    unsigned _segmentMaxSeconds = 0;
+    quint64 _segmentMaxBytes = 0;
+    qint64 _recordingEpochMsecs = 0;
 };
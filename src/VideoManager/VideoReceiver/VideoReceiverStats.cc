@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoReceiverStats.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(VideoReceiverStatsLog, "qgc.videomanager.videoreceiver.stats")
+
+static constexpr qint64 kNsecsPerSec    = 1000000000;
+static constexpr double kNsecsPerMsec   = 1000000.0;
+
+void VideoReceiverStats::Histogram::add(double ms)
+{
+    size_t bucket = 0;
+    while (bucket < bucketLimitsMs.size() && ms >= bucketLimitsMs[bucket]) {
+        bucket++;
+    }
+    _buckets[bucket]++;
+
+    if (_count == 0) {
+        _minMs = _maxMs = ms;
+    } else {
+        _minMs = qMin(_minMs, ms);
+        _maxMs = qMax(_maxMs, ms);
+    }
+    _sumMs += ms;
+    _count++;
+}
+
+double VideoReceiverStats::Histogram::percentileMs(double percentile) const
+{
+    if (_count == 0) {
+        return 0;
+    }
+
+    const double target = qBound(0.0, percentile, 100.0) / 100.0 * _count;
+    double cumulative = 0;
+    for (size_t bucket = 0; bucket < _buckets.size(); bucket++) {
+        if (_buckets[bucket] == 0) {
+            continue;
+        }
+        if (cumulative + _buckets[bucket] >= target) {
+            // The outer edges of the histogram are bounded by the observed extremes
+            const double lower = bucket == 0 ? _minMs : qMax(_minMs, bucketLimitsMs[bucket - 1]);
+            const double upper = bucket == bucketLimitsMs.size() ? _maxMs : qMin(_maxMs, bucketLimitsMs[bucket]);
+            const double fraction = (target - cumulative) / _buckets[bucket];
+            return lower + ((upper - lower) * fraction);
+        }
+        cumulative += _buckets[bucket];
+    }
+
+    return _maxMs;
+}
+
+VideoReceiverStats::~VideoReceiverStats()
+{
+    stopCsv();
+}
+
+void VideoReceiverStats::reset(void)
+{
+    QMutexLocker lock(&_mutex);
+
+    _snapshot = Snapshot();
+    _parsedFrames.fill(ParsedFrame());
+    _nextParsedFrame = 0;
+    _fpsWindowStart = -1;
+    _fpsWindowFrames = 0;
+}
+
+void VideoReceiverStats::noteFrameParsed(qint64 pts, qint64 runningTime)
+{
+    QMutexLocker lock(&_mutex);
+
+    _snapshot.framesReceived++;
+
+    if (pts < 0 || runningTime < 0) {
+        return;
+    }
+
+    _parsedFrames[_nextParsedFrame] = { pts, runningTime };
+    _nextParsedFrame = (_nextParsedFrame + 1) % _parsedFrames.size();
+
+    // Buffers which are timestamped ahead of the clock (for example by a source which adds its own latency) carry
+    // no useful receive time
+    if (runningTime >= pts) {
+        _addSample(StageReceiveToParse, runningTime, runningTime - pts);
+    }
+}
+
+void VideoReceiverStats::noteFrameDecoded(qint64 pts, qint64 runningTime, qint64 sinkWait)
+{
+    QMutexLocker lock(&_mutex);
+
+    _snapshot.framesDecoded++;
+
+    if (runningTime < 0) {
+        return;
+    }
+
+    // The frame which opens a window only marks its start, the rate is frames after it over the time elapsed
+    if (_fpsWindowStart < 0) {
+        _fpsWindowStart = runningTime;
+        _fpsWindowFrames = 0;
+    } else {
+        _fpsWindowFrames++;
+        const qint64 windowElapsed = runningTime - _fpsWindowStart;
+        if (windowElapsed >= kNsecsPerSec) {
+            _snapshot.fps = static_cast<double>(_fpsWindowFrames) * kNsecsPerSec / windowElapsed;
+            _fpsWindowStart = runningTime;
+            _fpsWindowFrames = 0;
+        }
+    }
+
+    if (pts >= 0) {
+        // Search newest to oldest, decoded frames are almost always among the most recently parsed
+        for (size_t i = 1; i <= _parsedFrames.size(); i++) {
+            const ParsedFrame& parsedFrame = _parsedFrames[(_nextParsedFrame + _parsedFrames.size() - i) % _parsedFrames.size()];
+            if (parsedFrame.pts == pts) {
+                if (runningTime >= parsedFrame.runningTime) {
+                    _addSample(StageDecode, runningTime, runningTime - parsedFrame.runningTime);
+                }
+                break;
+            }
+        }
+    }
+
+    if (sinkWait >= 0) {
+        _addSample(StageSinkRender, runningTime, sinkWait);
+    }
+}
+
+void VideoReceiverStats::noteQos(quint64 dropped, qint64 jitter)
+{
+    QMutexLocker lock(&_mutex);
+
+    _snapshot.framesDropped = qMax(_snapshot.framesDropped, dropped);
+    if (jitter > 0) {
+        _snapshot.framesLate++;
+    }
+}
+
+VideoReceiverStats::Snapshot VideoReceiverStats::snapshot(void) const
+{
+    QMutexLocker lock(&_mutex);
+
+    return _snapshot;
+}
+
+void VideoReceiverStats::_addSample(Stage stage, qint64 runningTime, qint64 latency)
+{
+    const double latencyMs = latency / kNsecsPerMsec;
+
+    _snapshot.stages[stage].add(latencyMs);
+
+    if (_csvActive) {
+        if (_csvQueue.count() < kMaxQueuedCsvSamples) {
+            _csvQueue.append({ runningTime, latency, stage });
+        } else {
+            _csvSamplesDropped++;
+        }
+    }
+}
+
+bool VideoReceiverStats::startCsv(const QString& fileName)
+{
+    stopCsv();
+
+    QMutexLocker fileLock(&_csvFileMutex);
+
+    _csvFile.setFileName(fileName);
+    if (!_csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCWarning(VideoReceiverStatsLog) << "Unable to open stats file" << fileName << _csvFile.errorString();
+        return false;
+    }
+
+    _csvFile.write("running_time_ms,stage,latency_ms\n");
+
+    QMutexLocker lock(&_mutex);
+    _csvQueue.clear();
+    _csvSamplesDropped = 0;
+    _csvActive = true;
+
+    return true;
+}
+
+void VideoReceiverStats::stopCsv(void)
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _csvActive = false;
+    }
+
+    flushCsv();
+
+    QMutexLocker fileLock(&_csvFileMutex);
+    if (_csvFile.isOpen()) {
+        _csvFile.close();
+    }
+}
+
+bool VideoReceiverStats::csvActive(void) const
+{
+    QMutexLocker lock(&_mutex);
+
+    return _csvActive;
+}
+
+void VideoReceiverStats::flushCsv(void)
+{
+    QMutexLocker fileLock(&_csvFileMutex);
+
+    // Only the swap happens under the stats lock, formatting and file io do not hold up the streaming threads
+    QList<CsvSample> samples;
+    quint64 samplesDropped;
+    {
+        QMutexLocker lock(&_mutex);
+        samples.swap(_csvQueue);
+        samplesDropped = _csvSamplesDropped;
+        _csvSamplesDropped = 0;
+    }
+
+    if (samplesDropped) {
+        qCWarning(VideoReceiverStatsLog) << "Stats file fell behind, samples dropped:" << samplesDropped;
+    }
+    if (!_csvFile.isOpen() || samples.isEmpty()) {
+        return;
+    }
+
+    QByteArray lines;
+    lines.reserve(samples.count() * 32);
+    for (const CsvSample& sample : samples) {
+        lines += QStringLiteral("%1,%2,%3\n").arg(sample.runningTime / kNsecsPerMsec, 0, 'f', 3).arg(QLatin1String(stageName(sample.stage))).arg(sample.latency / kNsecsPerMsec, 0, 'f', 3).toLatin1();
+    }
+    _csvFile.write(lines);
+    _csvFile.flush();
+}
+
+const char* VideoReceiverStats::stageName(Stage stage)
+{
+    switch (stage) {
+    case StageReceiveToParse:
+        return "receiveToParse";
+    case StageDecode:
+        return "decode";
+    case StageSinkRender:
+        return "sinkRender";
+    default:
+        return "unknown";
+    }
+}
+
+QVariantMap VideoReceiverStats::toVariantMap(const Snapshot& snapshot)
+{
+    QVariantMap map;
+
+    map[QStringLiteral("fps")]              = snapshot.fps;
+    map[QStringLiteral("framesReceived")]   = snapshot.framesReceived;
+    map[QStringLiteral("framesDecoded")]    = snapshot.framesDecoded;
+    map[QStringLiteral("framesDropped")]    = snapshot.framesDropped;
+    map[QStringLiteral("framesLate")]       = snapshot.framesLate;
+
+    for (int stage = 0; stage < StageCount; stage++) {
+        const Histogram& histogram = snapshot.stages[stage];
+
+        QVariantMap stageMap;
+        stageMap[QStringLiteral("count")]   = histogram.count();
+        stageMap[QStringLiteral("minMs")]   = histogram.minMs();
+        stageMap[QStringLiteral("meanMs")]  = histogram.meanMs();
+        stageMap[QStringLiteral("p50Ms")]   = histogram.percentileMs(50);
+        stageMap[QStringLiteral("p95Ms")]   = histogram.percentileMs(95);
+        stageMap[QStringLiteral("maxMs")]   = histogram.maxMs();
+
+        map[QLatin1String(stageName(static_cast<Stage>(stage)))] = stageMap;
+    }
+
+    return map;
+}
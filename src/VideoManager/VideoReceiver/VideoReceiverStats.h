@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QVariantMap>
+
+#include <array>
+
+Q_DECLARE_LOGGING_CATEGORY(VideoReceiverStatsLog)
+
+/// Per-stage frame timing for a video receiver.
+///
+/// Receivers feed it from their streaming threads, the ui reads snapshots of it. Times are pipeline running times
+/// in nanoseconds so that they can be compared directly against buffer timestamps.
+///
+///     ReceiveToParse  Buffer timestamp (time of arrival at the source) to the parsed frame leaving the source bin.
+///                     Includes the network jitter buffer.
+///     Decode          Parsed frame leaving the source bin to decoded frame arriving at the video sink.
+///     SinkRender      Decoded frame arriving at the video sink to its presentation deadline.
+class VideoReceiverStats
+{
+public:
+    enum Stage {
+        StageReceiveToParse = 0,
+        StageDecode,
+        StageSinkRender,
+        StageCount
+    };
+
+    /// Latency histogram with fixed, roughly logarithmic millisecond buckets
+    class Histogram
+    {
+    public:
+        void    add             (double ms);
+        quint64 count           (void) const { return _count; }
+        double  minMs           (void) const { return _count ? _minMs : 0; }
+        double  maxMs           (void) const { return _count ? _maxMs : 0; }
+        double  meanMs          (void) const { return _count ? _sumMs / _count : 0; }
+
+        /// Estimates a percentile by interpolating within the bucket which contains it
+        ///     @param percentile 0-100
+        double  percentileMs    (double percentile) const;
+
+        static constexpr std::array<double, 10> bucketLimitsMs = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+
+    private:
+        std::array<quint64, bucketLimitsMs.size() + 1> _buckets = {};
+        quint64 _count = 0;
+        double  _minMs = 0;
+        double  _maxMs = 0;
+        double  _sumMs = 0;
+    };
+
+    struct Snapshot {
+        std::array<Histogram, StageCount> stages;
+        quint64 framesReceived =    0;
+        quint64 framesDecoded =     0;
+        quint64 framesDropped =     0;  ///< Reported by the sink through QoS
+        quint64 framesLate =        0;  ///< Rendered after their deadline, reported by the sink through QoS
+        double  fps =               0;  ///< Decoded frames per second over the last full second
+    };
+
+    VideoReceiverStats(void) = default;
+    ~VideoReceiverStats();
+
+    void reset(void);
+
+    /// A parsed frame has left the source
+    ///     @param pts Buffer timestamp, running time in nanoseconds, negative if unknown
+    ///     @param runningTime Current pipeline running time in nanoseconds
+    void noteFrameParsed(qint64 pts, qint64 runningTime);
+
+    /// A decoded frame has arrived at the video sink
+    ///     @param sinkWait Time until the frame's presentation deadline in nanoseconds, negative if unknown
+    void noteFrameDecoded(qint64 pts, qint64 runningTime, qint64 sinkWait);
+
+    /// The sink posted a QoS message
+    ///     @param dropped Total number of frames dropped by the sink so far
+    ///     @param jitter How late the last frame was in nanoseconds, positive means late
+    void noteQos(quint64 dropped, qint64 jitter);
+
+    Snapshot snapshot(void) const;
+
+    /// Starts writing every stage sample to a csv file as "running_time_ms,stage,latency_ms"
+    ///
+    /// The streaming threads only queue samples, they are written out by flushCsv. Call it periodically from a
+    /// thread which is allowed to block on file io.
+    bool startCsv   (const QString& fileName);
+    void stopCsv    (void);
+    bool csvActive  (void) const;
+
+    /// Writes the samples queued since the last flush to the csv file
+    void flushCsv   (void);
+
+    /// Samples queued for the csv file are capped at this, older samples are kept and newer ones dropped
+    static constexpr qsizetype kMaxQueuedCsvSamples = 100000;
+
+    static QVariantMap  toVariantMap    (const Snapshot& snapshot);
+    static const char*  stageName       (Stage stage);
+
+private:
+    void _addSample(Stage stage, qint64 runningTime, qint64 latency);
+
+    struct CsvSample {
+        qint64  runningTime;
+        qint64  latency;
+        Stage   stage;
+    };
+
+    struct ParsedFrame {
+        qint64 pts =            -1;
+        qint64 runningTime =    -1;
+    };
+
+    mutable QMutex  _mutex;
+    Snapshot        _snapshot;
+
+    /// Recently parsed frames, used to match decoded frames back to their parse time
+    std::array<ParsedFrame, 64> _parsedFrames;
+    size_t          _nextParsedFrame = 0;
+
+    qint64          _fpsWindowStart =   -1;
+    quint64         _fpsWindowFrames =  0;
+
+    bool                _csvActive = false;
+    QList<CsvSample>    _csvQueue;
+    quint64             _csvSamplesDropped = 0;
+
+    QMutex              _csvFileMutex;          ///< Held while writing, never taken by the streaming threads
+    QFile               _csvFile;
+};
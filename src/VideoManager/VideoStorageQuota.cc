@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoStorageQuota.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStorageInfo>
+
+QGC_LOGGING_CATEGORY(VideoStorageQuotaLog, "qgc.videomanager.videostoragequota")
+
+QString VideoStorageQuota::_canonical(const QString &file)
+{
+    // The file may not exist yet, so normalize the path rather than resolving it
+    return QDir::cleanPath(QFileInfo(file).absoluteFilePath());
+}
+
+void VideoStorageQuota::protect(const QString &file)
+{
+    (void) _protected.insert(_canonical(file));
+}
+
+void VideoStorageQuota::unprotect(const QString &file)
+{
+    (void) _protected.remove(_canonical(file));
+}
+
+bool VideoStorageQuota::isProtected(const QString &file) const
+{
+    return _protected.contains(_canonical(file));
+}
+
+QStringList VideoStorageQuota::enforce(void)
+{
+    QStringList removed;
+
+    if (_path.isEmpty()) {
+        return removed;
+    }
+
+    QDir videoDir(_path);
+    videoDir.setFilter(QDir::Files | QDir::Readable | QDir::NoSymLinks | QDir::Writable);
+    videoDir.setSorting(QDir::Time | QDir::Reversed);
+    videoDir.setNameFilters(_nameFilters);
+
+    // Oldest first
+    const QFileInfoList files = videoDir.entryInfoList();
+
+    quint64 used = 0;
+    for (const QFileInfo &fileInfo : files) {
+        used += static_cast<quint64>(fileInfo.size());
+    }
+
+    qint64 available = -1;
+    if (_minFreeBytes > 0) {
+        const QStorageInfo storage(_path);
+        if (storage.isValid() && storage.isReady()) {
+            available = storage.bytesAvailable();
+        }
+    }
+
+    const auto overQuota = [this, &used, &available]() {
+        return ((_maxBytes > 0) && (used > _maxBytes)) ||
+               ((available >= 0) && (static_cast<quint64>(available) < _minFreeBytes));
+    };
+
+    for (const QFileInfo &fileInfo : files) {
+        if (!overQuota()) {
+            break;
+        }
+
+        const QString filePath = fileInfo.absoluteFilePath();
+        if (isProtected(filePath)) {
+            continue;
+        }
+
+        const quint64 size = static_cast<quint64>(fileInfo.size());
+        if (!QFile::remove(filePath)) {
+            qCWarning(VideoStorageQuotaLog) << "Unable to remove" << filePath;
+            continue;
+        }
+
+        qCDebug(VideoStorageQuotaLog) << "Removed old video file" << filePath << size;
+        removed.append(filePath);
+        used -= size;
+        if (available >= 0) {
+            available += static_cast<qint64>(size);
+        }
+    }
+
+    _usedBytes = used;
+
+    if (overQuota()) {
+        qCWarning(VideoStorageQuotaLog) << "Video storage is still over quota, used" << used << "available" << available;
+    }
+
+    return removed;
+}
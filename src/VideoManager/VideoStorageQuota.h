@@ -0,0 +1,60 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+Q_DECLARE_LOGGING_CATEGORY(VideoStorageQuotaLog)
+
+/// Keeps recorded video within a storage budget by deleting the oldest recordings first.
+///
+/// Two limits apply: the total size of the matching files in the directory, and the free space left on the volume.
+/// Files which are still being written are protected and never deleted, which matters for segmented recordings
+/// where the quota is enforced while the recording goes on.
+class VideoStorageQuota
+{
+public:
+    VideoStorageQuota(void) = default;
+
+    void setPath(const QString &path) { _path = path; }
+    const QString &path(void) const { return _path; }
+
+    /// @param nameFilters Wildcards of the files which count against the quota, for example "*.mkv"
+    void setNameFilters(const QStringList &nameFilters) { _nameFilters = nameFilters; }
+
+    /// @param maxBytes Total size of matching files, 0 for no limit
+    void setMaxBytes(quint64 maxBytes) { _maxBytes = maxBytes; }
+
+    /// @param minFreeBytes Free space to keep on the volume, 0 for no limit
+    void setMinFreeBytes(quint64 minFreeBytes) { _minFreeBytes = minFreeBytes; }
+
+    void protect(const QString &file);
+    void unprotect(const QString &file);
+    bool isProtected(const QString &file) const;
+
+    /// Deletes the oldest unprotected files until both limits are met or nothing deletable is left
+    ///     @return Files which were deleted
+    QStringList enforce(void);
+
+    /// @return Total size of the matching files as of the last enforce()
+    quint64 usedBytes(void) const { return _usedBytes; }
+
+private:
+    static QString _canonical(const QString &file);
+
+    QString _path;
+    QStringList _nameFilters;
+    quint64 _maxBytes = 0;
+    quint64 _minFreeBytes = 0;
+    quint64 _usedBytes = 0;
+    QSet<QString> _protected;
+};
@@ -24,6 +24,8 @@ CityMapGeometry::CityMapGeometry()
 
     setOsmFilePath(_viewer3DSettings->osmFilePath()->rawValue());
     connect(_viewer3DSettings->osmFilePath(), &Fact::rawValueChanged, this, &CityMapGeometry::setOsmFilePath);
+    setViewRadius(_viewer3DSettings->buildingViewRadius()->rawValue());
+    connect(_viewer3DSettings->buildingViewRadius(), &Fact::rawValueChanged, this, &CityMapGeometry::setViewRadius);
 }
 
 void CityMapGeometry::setModelName(QString modelName)
@@ -43,6 +45,30 @@ void CityMapGeometry::setOsmFilePath(QVariant value)
     loadOsmMap();
 }
 
+void CityMapGeometry::setViewRadius(QVariant value)
+{
+    _viewRadius = value.toFloat();
+    updateViewer();
+}
+
+void CityMapGeometry::setViewCenter(const QVector3D &viewCenter)
+{
+    // No position yet, stay at the map reference
+    const QVector3D center = (qIsFinite(viewCenter.x()) && qIsFinite(viewCenter.y()))?(viewCenter):(QVector3D());
+    if(_viewCenter == center){
+        return;
+    }
+    _viewCenter = center;
+    emit viewCenterChanged();
+
+    // The mesh only changes once the center moves far enough for other tiles to come into range
+    if(_viewRadius > 0 && _osmParser && _osmParser->mapLoaded()){
+        if(_osmParser->tilesInRange(QVector2D(_viewCenter.x(), _viewCenter.y()), _viewRadius) != _visibleTiles){
+            updateViewer();
+        }
+    }
+}
+
 void CityMapGeometry::setOsmParser(OsmParser *newOsmParser)
 {
     _osmParser = newOsmParser;
@@ -74,7 +100,14 @@ void CityMapGeometry::updateViewer()
     }
 
     if(_osmParser->mapLoaded()){
-        _vertexData = _osmParser->buildingToMesh();
+        if(_viewRadius > 0){
+            const QVector2D center(_viewCenter.x(), _viewCenter.y());
+            _visibleTiles = _osmParser->tilesInRange(center, _viewRadius);
+            _vertexData = _osmParser->buildingToMesh(center, _viewRadius);
+        }else{
+            _visibleTiles.clear();
+            _vertexData = _osmParser->buildingToMesh();
+        }
 
         int stride = 3 * sizeof(float);
         if(!_vertexData.isEmpty()){
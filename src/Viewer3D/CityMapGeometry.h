@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QString>
+#include <QtGui/QVector3D>
 #include <QtQuick3D/QQuick3DGeometry>
 
 ///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
@@ -24,6 +26,7 @@ class CityMapGeometry : public QQuick3DGeometry
 
     Q_PROPERTY(QString modelName READ modelName WRITE setModelName NOTIFY modelNameChanged)
     Q_PROPERTY(OsmParser* osmParser READ osmParser WRITE setOsmParser NOTIFY osmParserChanged)
+    Q_PROPERTY(QVector3D viewCenter READ viewCenter WRITE setViewCenter NOTIFY viewCenterChanged)
 
 public:
 
@@ -39,10 +42,15 @@ public:
 
     bool loadOsmMap();
 
+    /// Local position the buildings within the view radius setting are shown around, usually the active vehicle
+    QVector3D viewCenter() const { return _viewCenter; }
+    void setViewCenter(const QVector3D& viewCenter);
+
 signals:
     void modelNameChanged();
     void osmFilePathChanged();
     void osmParserChanged();
+    void viewCenterChanged();
 
 private:
     void updateViewer();
@@ -54,7 +62,11 @@ private:
     OsmParser *_osmParser;
     bool _mapLoadedFlag;
     Viewer3DSettings* _viewer3DSettings = nullptr;
+    QVector3D _viewCenter;
+    float _viewRadius = 0;
+    QList<quint64> _visibleTiles;
 
 private slots:
     void setOsmFilePath(QVariant value);
+    void setViewRadius(QVariant value);
 };
@@ -10,31 +10,136 @@
 #include "OsmParser.h"
 #include "SettingsManager.h"
 #include "Viewer3DSettings.h"
-#include "OsmParserThread.h"
 #include "earcut.hpp"
 
-typedef union {
-    uint array[3];
+#include <QtConcurrent/QtConcurrentMap>
 
-    struct {
-        uint x;
-        uint y;
-        uint z;
-    } axis;
-} vec3i;
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct BuildingMesh_t {
+    const OsmParserThread::BuildingType_t* building = nullptr;
+    float height = 0;
+    std::vector<uint32_t> indices;  // Roof triangulation
+    qsizetype offset = 0;           // First vertex in the shared buffer
+    qsizetype vertexCount = 0;
+};
+
+qsizetype wallVertexCount(size_t ringSize)
+{
+    // Two triangles per wall, plus the last wall once more facing the other way
+    return (ringSize > 0)?(static_cast<qsizetype>(ringSize + 1) * 6):(0);
+}
+
+float* writeVertex(float* p, float x, float y, float z)
+{
+    *p++ = x; *p++ = y; *p++ = z;
+    return p;
+}
+
+float* writeRectangle(float* p, const QVector3D (&verticesCcw)[4], bool invertNormal)
+{
+    static constexpr int normalOrder[6] = {0, 1, 3, 1, 2, 3};
+    static constexpr int invertedOrder[6] = {3, 1, 0, 3, 2, 1};
+    const int* order = (invertNormal)?(invertedOrder):(normalOrder);
+
+    for(int i_v=0; i_v<6; i_v++) {
+        const QVector3D& v = verticesCcw[order[i_v]];
+        p = writeVertex(p, v.x(), v.y(), v.z());
+    }
+    return p;
+}
+
+float* writeWallsExtrudedPolygon(float* p, const std::vector<QVector2D>& verticesCcw, float h, bool inverseOrder)
+{
+    const size_t vertices_size = verticesCcw.size();
+    if(vertices_size == 0) {
+        return p;
+    }
+
+    QVector3D rec_ccw[4];
+    for(size_t i_p=0; i_p<vertices_size; i_p++) {
+        const size_t i_p_p = (i_p < vertices_size-1)?(i_p+1):(0);
+        const QVector2D& a = (inverseOrder)?(verticesCcw[i_p_p]):(verticesCcw[i_p]);
+        const QVector2D& b = (inverseOrder)?(verticesCcw[i_p]):(verticesCcw[i_p_p]);
+        rec_ccw[0] = QVector3D(a.x(), a.y(), 0);
+        rec_ccw[1] = QVector3D(b.x(), b.y(), 0);
+        rec_ccw[2] = QVector3D(b.x(), b.y(), h);
+        rec_ccw[3] = QVector3D(a.x(), a.y(), h);
+        p = writeRectangle(p, rec_ccw, false);
+    }
+    return writeRectangle(p, rec_ccw, true);
+}
+
+void triangulateRoof(BuildingMesh_t& mesh)
+{
+    const OsmParserThread::BuildingType_t& bld = *mesh.building;
+
+    std::vector<std::vector<std::array<float, 2> > > polygon(1);
+    polygon[0].reserve(bld.points_local.size());
+    for(const QVector2D& point: bld.points_local) {
+        polygon[0].push_back({point.x(), point.y()});
+    }
+    if(!bld.points_local_inner.empty()) {
+        polygon.emplace_back();
+        polygon[1].reserve(bld.points_local_inner.size());
+        for(const QVector2D& point: bld.points_local_inner) {
+            polygon[1].push_back({point.x(), point.y()});
+        }
+    }
+
+    mesh.indices = mapbox::earcut<uint32_t>(polygon);
+    mesh.vertexCount = static_cast<qsizetype>(mesh.indices.size()) * 2;
+    if(mesh.height > 0) {
+        mesh.vertexCount += 2 * (wallVertexCount(bld.points_local.size()) + wallVertexCount(bld.points_local_inner.size()));
+    }
+}
+
+void writeBuilding(float* vertexBase, BuildingMesh_t& mesh)
+{
+    const OsmParserThread::BuildingType_t& bld = *mesh.building;
+    const size_t outerSize = bld.points_local.size();
+    const auto point = [&bld, outerSize](uint32_t idx) -> const QVector2D& {
+        return (idx < outerSize)?(bld.points_local[idx]):(bld.points_local_inner[idx - outerSize]);
+    };
+
+    float* p = vertexBase + mesh.offset * 3;
+    for(size_t i_i=0; i_i<mesh.indices.size(); i_i+=3) {
+        const QVector2D& p0 = point(mesh.indices[i_i]);
+        const QVector2D& p1 = point(mesh.indices[i_i+1]);
+        const QVector2D& p2 = point(mesh.indices[i_i+2]);
+
+        // mesh for roof
+        p = writeVertex(p, p0.x(), p0.y(), mesh.height);
+        p = writeVertex(p, p1.x(), p1.y(), mesh.height);
+        p = writeVertex(p, p2.x(), p2.y(), mesh.height);
+
+        // mesh for floor
+        p = writeVertex(p, p2.x(), p2.y(), 0);
+        p = writeVertex(p, p1.x(), p1.y(), 0);
+        p = writeVertex(p, p0.x(), p0.y(), 0);
+    }
+
+    if(mesh.height > 0) {
+        p = writeWallsExtrudedPolygon(p, bld.points_local, mesh.height, false); // mesh for wall outside
+        p = writeWallsExtrudedPolygon(p, bld.points_local, mesh.height, true); // mesh for wall inside
+
+        p = writeWallsExtrudedPolygon(p, bld.points_local_inner, mesh.height, false); // mesh for wall outside
+        p = writeWallsExtrudedPolygon(p, bld.points_local_inner, mesh.height, true); // mesh for wall inside
+    }
+
+    Q_ASSERT(p == vertexBase + (mesh.offset + mesh.vertexCount) * 3);
+    std::vector<uint32_t>().swap(mesh.indices);
+}
+
+} // namespace
 
 OsmParser::OsmParser(QObject *parent)
     : QObject{parent}
 {
     _osmParserWorker = new OsmParserThread();
-    _singleStoreyBuildings.append("bungalow");
-    _singleStoreyBuildings.append("shed");
-    _singleStoreyBuildings.append("kiosk");
-    _singleStoreyBuildings.append("cabin");
-
-    _doubleStoreyLeisure.append("stadium");
-    _doubleStoreyLeisure.append("sports_hall");
-    _doubleStoreyLeisure.append("sauna");
 
     _viewer3DSettings = SettingsManager::instance()->viewer3DSettings();
 
@@ -63,6 +168,7 @@ void OsmParser::resetGpsRef()
 void OsmParser::setBuildingLevelHeight(QVariant value)
 {
     _buildingLevelHeight = value.toFloat();
+    _tileMeshes.clear();
     emit buildingLevelHeightChanged();
 }
 
@@ -75,6 +181,7 @@ void OsmParser::osmParserFinished(bool isValid)
             _coordinateMin = _osmParserWorker->coordinateMin;
             _coordinateMax = _osmParserWorker->coordinateMax;
         }
+        _buildTileIndex();
         _mapLoadedFlag = true;
         emit mapChanged();
         qDebug() << _osmParserWorker->mapBuildings.size() << " Buildings loaded!!!";
@@ -83,7 +190,8 @@ void OsmParser::osmParserFinished(bool isValid)
 
 void OsmParser::parseOsmFile(QString filePath)
 {
-    _osmParserWorker->mapNodes.clear();
+    _tileBuildings.clear();
+    _tileMeshes.clear();
     _osmParserWorker->mapBuildings.clear();
     _gpsRefSet = false;
     _mapLoadedFlag = false;
@@ -92,134 +200,104 @@ void OsmParser::parseOsmFile(QString filePath)
     _osmParserWorker->start(filePath);
 }
 
-QByteArray OsmParser::buildingToMesh()
+void OsmParser::_buildTileIndex()
 {
-    QByteArray vertexData;
-    QMapIterator<uint64_t, OsmParserThread::BuildingType_t> ii(_osmParserWorker->mapBuildings);
-
-    for (auto ii = _osmParserWorker->mapBuildings.begin(), end = _osmParserWorker->mapBuildings.end(); ii != end; ++ii) {
-        float bld_height = 0;
-        // std::vector<std::array<float, 2> > bld_points;
-        // std::vector<std::vector<std::array<float, 2> > > polygon;
-
-        std::vector<std::array<float, 2> > all_bld_points;
-        std::vector<std::array<float, 2> > bld_points;
-        std::vector<std::vector<std::array<float, 2> > > polygon;
-        std::vector<QVector3D> triangulated_mesh;
-
-        //        bld_height = (ii.value().height >= ii.value().levels * _buildingLevelHeight)?(ii.value().height):(ii.value().levels * _buildingLevelHeight);
-
-        if(ii.value().height > 0){
-            bld_height = ii.value().height;
-        }else if(ii.value().levels > 0){
-            bld_height = (float)(ii.value().levels) * _buildingLevelHeight;
-        }else{
-            continue;
-        }
-
-        for(unsigned int jj=0; jj<ii.value().points_local.size(); jj++) {
-            bld_points.push_back({ii.value().points_local[jj].x(), ii.value().points_local[jj].y()});
-            all_bld_points.push_back({ii.value().points_local[jj].x(), ii.value().points_local[jj].y()});
-        }
-        polygon.push_back(bld_points);
-
-        bld_points.clear();
-        for(unsigned int jj=0; jj<ii.value().points_local_inner.size(); jj++) {
-            bld_points.push_back({ii.value().points_local_inner[jj].x(), ii.value().points_local_inner[jj].y()});
-            all_bld_points.push_back({ii.value().points_local_inner[jj].x(), ii.value().points_local_inner[jj].y()});
-        }
-        if(bld_points.size() > 0){
-            polygon.push_back(bld_points);
-        }
+    _tileBuildings.clear();
+    _tileMeshes.clear();
+
+    for (auto ii = _osmParserWorker->mapBuildings.cbegin(), end = _osmParserWorker->mapBuildings.cend(); ii != end; ++ii) {
+        const QVector2D center = 0.5f * (ii.value().bb_min + ii.value().bb_max);
+        const int tile_x = static_cast<int>(std::floor(center.x() / kTileSize));
+        const int tile_y = static_cast<int>(std::floor(center.y() / kTileSize));
+        _tileBuildings[_tileKey(tile_x, tile_y)].append(&ii.value());
+    }
+}
 
-        std::vector<uint32_t> indices = mapbox::earcut<uint32_t>(polygon);
-
-        for(uint i_i=0; i_i<indices.size(); i_i+=3) {
-            // mesh for roof
-            uint n_idx = indices[i_i];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], bld_height));
-            n_idx = indices[i_i+1];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], bld_height));
-            n_idx = indices[i_i+2];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], bld_height));
-
-            // mesh for floor
-            n_idx = indices[i_i+2];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], 0));
-            n_idx = indices[i_i+1];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], 0));
-            n_idx = indices[i_i];
-            triangulated_mesh.push_back(QVector3D(all_bld_points[n_idx][0], all_bld_points[n_idx][1], 0));
+QList<quint64> OsmParser::tilesInRange(const QVector2D &center, float radius) const
+{
+    QList<quint64> tiles;
+    const int x_min = static_cast<int>(std::floor((center.x() - radius) / kTileSize));
+    const int x_max = static_cast<int>(std::floor((center.x() + radius) / kTileSize));
+    const int y_min = static_cast<int>(std::floor((center.y() - radius) / kTileSize));
+    const int y_max = static_cast<int>(std::floor((center.y() + radius) / kTileSize));
+
+    for(int tile_x=x_min; tile_x<=x_max; tile_x++) {
+        for(int tile_y=y_min; tile_y<=y_max; tile_y++) {
+            // Closest point of the tile to the center
+            const float dx = center.x() - std::clamp(center.x(), tile_x * kTileSize, (tile_x + 1) * kTileSize);
+            const float dy = center.y() - std::clamp(center.y(), tile_y * kTileSize, (tile_y + 1) * kTileSize);
+            const quint64 key = _tileKey(tile_x, tile_y);
+            if((dx * dx + dy * dy) <= (radius * radius) && _tileBuildings.contains(key)) {
+                tiles.append(key);
+            }
         }
+    }
+    return tiles;
+}
 
-        if(bld_height > 0) {
-            trianglateWallsExtrudedPolygon(triangulated_mesh, ii.value().points_local, bld_height, 0, 0); // mesh for wall outside
-            trianglateWallsExtrudedPolygon(triangulated_mesh, ii.value().points_local, bld_height, 1, 0);// mesh for wall inside
-
-            trianglateWallsExtrudedPolygon(triangulated_mesh, ii.value().points_local_inner, bld_height, 0, 0); // mesh for wall outside
-            trianglateWallsExtrudedPolygon(triangulated_mesh, ii.value().points_local_inner, bld_height, 1, 0);// mesh for wall inside
-        }
+QByteArray OsmParser::buildingToMesh()
+{
+    QList<const OsmParserThread::BuildingType_t*> buildings;
+    buildings.reserve(_osmParserWorker->mapBuildings.size());
+    for (auto ii = _osmParserWorker->mapBuildings.cbegin(), end = _osmParserWorker->mapBuildings.cend(); ii != end; ++ii) {
+        buildings.append(&ii.value());
+    }
+    return meshBuildings(buildings, _buildingLevelHeight);
+}
 
-        QByteArray vertexData_tmp(triangulated_mesh.size() * 3 * sizeof(float), Qt::Initialization::Uninitialized);
-        float *p = reinterpret_cast<float *>(vertexData_tmp.data());
+QByteArray OsmParser::buildingToMesh(const QVector2D &center, float radius)
+{
+    const QList<quint64> tiles = tilesInRange(center, radius);
 
-        for(uint i_m=0; i_m<triangulated_mesh.size(); i_m++) {
-            *p++ =  (float)triangulated_mesh[i_m].x(); *p++ =  (float)triangulated_mesh[i_m].y(); *p++ =  (float)triangulated_mesh[i_m].z();
+    qsizetype totalSize = 0;
+    for(quint64 key: tiles) {
+        auto tileMesh = _tileMeshes.find(key);
+        if(tileMesh == _tileMeshes.end()) {
+            tileMesh = _tileMeshes.insert(key, meshBuildings(_tileBuildings.value(key), _buildingLevelHeight));
         }
+        totalSize += tileMesh.value().size();
+    }
 
-        ii.value().triangulated_mesh.insert(ii.value().triangulated_mesh.begin(), triangulated_mesh.begin(), triangulated_mesh.end());
-        vertexData.append(vertexData_tmp);
+    QByteArray vertexData;
+    vertexData.reserve(totalSize);
+    for(quint64 key: tiles) {
+        vertexData.append(_tileMeshes.value(key));
     }
     return vertexData;
 }
 
-void OsmParser::trianglateWallsExtrudedPolygon(std::vector<QVector3D>& triangulatedMesh, std::vector<QVector2D> verticesCcw, float h, bool inverseOrder, bool duplicateStartEndPoint)
+QByteArray OsmParser::meshBuildings(const QList<const OsmParserThread::BuildingType_t *> &buildings, float buildingLevelHeight)
 {
-    std::vector<QVector3D> tmp_rec_ccw(4);
-    uint vertices_size = verticesCcw.size() - (uint)(duplicateStartEndPoint);
-
-    if(inverseOrder) {
-        for(uint i_p=0; i_p<vertices_size; i_p++) {
-            int i_p_p = (i_p < vertices_size-1)?(i_p+1):(0);
-            tmp_rec_ccw[0] = QVector3D(verticesCcw[i_p_p].x(), verticesCcw[i_p_p].y(), 0);
-            tmp_rec_ccw[1] = QVector3D(verticesCcw[i_p].x(), verticesCcw[i_p].y(), 0);
-            tmp_rec_ccw[2] = QVector3D(verticesCcw[i_p].x(), verticesCcw[i_p].y(), h);
-            tmp_rec_ccw[3] = QVector3D(verticesCcw[i_p_p].x(), verticesCcw[i_p_p].y(), h);
-            trianglateRectangle(triangulatedMesh, tmp_rec_ccw, 0);
-        }
-        trianglateRectangle(triangulatedMesh, tmp_rec_ccw, 1);
-    } else {
-        for(uint i_p=0; i_p<vertices_size; i_p++) {
-            int i_p_p = (i_p < vertices_size-1)?(i_p+1):(0);
-            tmp_rec_ccw[0] = QVector3D(verticesCcw[i_p].x(), verticesCcw[i_p].y(), 0);
-            tmp_rec_ccw[1] = QVector3D(verticesCcw[i_p_p].x(), verticesCcw[i_p_p].y(), 0);
-            tmp_rec_ccw[2] = QVector3D(verticesCcw[i_p_p].x(), verticesCcw[i_p_p].y(), h);
-            tmp_rec_ccw[3] = QVector3D(verticesCcw[i_p].x(), verticesCcw[i_p].y(), h);
-            trianglateRectangle(triangulatedMesh, tmp_rec_ccw, 0);
+    std::vector<BuildingMesh_t> meshes;
+    meshes.reserve(buildings.size());
+    for(const OsmParserThread::BuildingType_t* bld: buildings) {
+        BuildingMesh_t mesh;
+        mesh.building = bld;
+        if(bld->height > 0){
+            mesh.height = bld->height;
+        }else if(bld->levels > 0){
+            mesh.height = bld->levels * buildingLevelHeight;
+        }else{
+            continue;
         }
-        trianglateRectangle(triangulatedMesh, tmp_rec_ccw, 1);
+        meshes.push_back(std::move(mesh));
     }
-}
 
-void OsmParser::trianglateRectangle(std::vector<QVector3D>& triangulatedMesh, std::vector<QVector3D> verticesCcw, bool invertNormal)
-{
-    std::vector<vec3i> mesh_set_idx;
-    mesh_set_idx.resize(2);
+    // Triangulating the roofs is the expensive part, it also tells how many vertices each building needs
+    QtConcurrent::blockingMap(meshes, triangulateRoof);
 
-    if(invertNormal) {
-        mesh_set_idx[0] = {{3, 1, 0}};
-        mesh_set_idx[1] = {{3, 2, 1}};
-    } else {
-        mesh_set_idx[0] = {{0, 1, 3}};
-        mesh_set_idx[1] = {{1, 2, 3}};
+    qsizetype vertexCount = 0;
+    for(BuildingMesh_t& mesh: meshes) {
+        mesh.offset = vertexCount;
+        vertexCount += mesh.vertexCount;
     }
 
-    uint idx_tmp;
+    // Every building then writes its own slice of the buffer
+    QByteArray vertexData(vertexCount * 3 * sizeof(float), Qt::Initialization::Uninitialized);
+    float* vertexBase = reinterpret_cast<float *>(vertexData.data());
+    QtConcurrent::blockingMap(meshes, [vertexBase](BuildingMesh_t& mesh) {
+        writeBuilding(vertexBase, mesh);
+    });
 
-    for(uint i_m=0; i_m<mesh_set_idx.size(); i_m++) {
-        for(uint i_v=0; i_v<3; i_v++) {
-            idx_tmp = mesh_set_idx[i_m].array[i_v];
-            triangulatedMesh.push_back(QVector3D(verticesCcw[idx_tmp].x(), verticesCcw[idx_tmp].y(), verticesCcw[idx_tmp].z()));
-        }
-    }
+    return vertexData;
 }
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtGui/QVector3D>
 #include <QtGui/QVector2D>
@@ -18,7 +19,7 @@
 ///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
 
 class Viewer3DSettings;
-class OsmParserThread;
+#include "OsmParserThread.h"
 
 class OsmParser : public QObject
 {
@@ -37,12 +38,22 @@ public:
     float buildingLevelHeight(void){return _buildingLevelHeight;}
     void parseOsmFile(QString filePath);
 
+    /// Mesh of all buildings, 3 floats per vertex
     QByteArray buildingToMesh();
 
-    void trianglateWallsExtrudedPolygon(std::vector<QVector3D>& triangulatedMesh, std::vector<QVector2D> verticesCcw, float h, bool inverseOrder=0, bool duplicateStartEndPoint=0);
-    void trianglateRectangle(std::vector<QVector3D>& triangulatedMesh, std::vector<QVector3D> verticesCcw, bool invertNormal);
+    /// Mesh of the buildings in the tiles within radius of center (local coordinates)
+    QByteArray buildingToMesh(const QVector2D& center, float radius);
+
+    /// Tiles within radius of center, the mesh only needs rebuilding when these change
+    QList<quint64> tilesInRange(const QVector2D& center, float radius) const;
+
+    /// Triangulates the buildings in parallel into one pre-sized vertex buffer, 3 floats per vertex
+    static QByteArray meshBuildings(const QList<const OsmParserThread::BuildingType_t*>& buildings, float buildingLevelHeight);
+
     std::pair<QGeoCoordinate, QGeoCoordinate> getMapBoundingBoxCoordinate(){ return std::pair(_coordinateMin, _coordinateMax);}
 
+    static constexpr float kTileSize = 500.0f; ///< Side of the square tiles buildings are grouped in, meters
+
 private:
     OsmParserThread* _osmParserWorker;
     QGeoCoordinate _gpsRefPoint;
@@ -53,8 +64,11 @@ private:
     float _buildingLevelHeight;
     bool _mapLoadedFlag;
     Viewer3DSettings* _viewer3DSettings = nullptr;
-    QList<QString> _singleStoreyBuildings;
-    QList<QString> _doubleStoreyLeisure;
+    QHash<quint64, QList<const OsmParserThread::BuildingType_t*>> _tileBuildings;
+    QHash<quint64, QByteArray> _tileMeshes; ///< Built on first use, cleared when the map or the level height changes
+
+    void _buildTileIndex();
+    static quint64 _tileKey(int x, int y) { return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y); }
 
 
 signals:
@@ -11,19 +11,15 @@
 #include "Viewer3DUtils.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QXmlStreamReader>
+
+static const QStringList _singleStoreyBuildings = {"bungalow", "shed", "kiosk", "cabin"};
+static const QStringList _doubleStoreyLeisure = {"stadium", "sports_hall", "sauna"};
 
 OsmParserThread::OsmParserThread(QObject *parent)
     : QThread{parent}
 {
     _mainThread = new QThread();
-    _singleStoreyBuildings.append("bungalow");
-    _singleStoreyBuildings.append("shed");
-    _singleStoreyBuildings.append("kiosk");
-    _singleStoreyBuildings.append("cabin");
-
-    _doubleStoreyLeisure.append("stadium");
-    _doubleStoreyLeisure.append("sports_hall");
-    _doubleStoreyLeisure.append("sauna");
 
     connect(this, &OsmParserThread::startThread, this, &OsmParserThread::startThreadEvent);
 
@@ -38,7 +34,6 @@ void OsmParserThread::start(QString filePath)
 
 void OsmParserThread::parseOsmFile(QString filePath)
 {
-    mapNodes.clear();
     mapBuildings.clear();
     _mapLoadedFlag = false;
 
@@ -52,8 +47,6 @@ void OsmParserThread::parseOsmFile(QString filePath)
         return;
     }
 
-    //The QDomDocument class represents an XML document.
-    QDomDocument xml_content;
 // Load xml file as raw data
 #ifdef __unix__
     filePath = QString("/") + filePath;
@@ -65,11 +58,11 @@ void OsmParserThread::parseOsmFile(QString filePath)
         return;
     }
     qDebug("Loading the OSM file!!!");
-    // Set data into the QDomDocument before processing
-    xml_content.setContent(&f);
+    // The file is decoded as it is read, it is never held in memory as a whole
+    const bool isValid = decodeOsm(&f, mapBuildings, coordinateMin, coordinateMax, gpsRefPoint);
     f.close();
 
-    if(decodeFile(xml_content, mapBuildings, mapNodes, coordinateMin, coordinateMax, gpsRefPoint)){
+    if(isValid){
         _mapLoadedFlag = true;
         emit fileParsed(true);
         return;
@@ -78,79 +71,89 @@ void OsmParserThread::parseOsmFile(QString filePath)
     emit fileParsed(false);
 }
 
-bool OsmParserThread::decodeFile(QDomDocument &xml_content, QMap<uint64_t, OsmParserThread::BuildingType_t> &buildingMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate &coordinateMin, QGeoCoordinate &coordinateMax, QGeoCoordinate &gpsRef)
+bool OsmParserThread::decodeOsm(QIODevice *device, QHash<uint64_t, OsmParserThread::BuildingType_t> &buildingMap, QGeoCoordinate &coordinateMin, QGeoCoordinate &coordinateMax, QGeoCoordinate &gpsRef)
 {
-    QDomElement root = xml_content.documentElement();
-    QDomElement xmlComponent = root.firstChild().toElement();
-    QGeoCoordinate tmpGpsRef;
+    QXmlStreamReader xml(device);
+    QHash<uint64_t, NodeType_t> nodeMap;
+    LocalPointProjector projector(gpsRef);
     bool gpsRefIsSet = false;
-    while(!xmlComponent.isNull()) {
-        if(decodeNodeTags(xmlComponent, nodeMap, coordinateMin, coordinateMax, tmpGpsRef)){
-            gpsRefIsSet = true;
-            gpsRef = tmpGpsRef;
-        }
-        decodeBuildings(xmlComponent, buildingMap, nodeMap, coordinateMin, coordinateMax, gpsRef);
-        decodeRelations(xmlComponent, buildingMap, nodeMap, gpsRef);
 
-        xmlComponent = xmlComponent.nextSibling().toElement();
+    // <osm>
+    if(!xml.readNextStartElement()){
+        qDebug() << "Invalid OSM file:" << xml.errorString();
+        return false;
     }
-    return gpsRefIsSet;
-}
-
-bool OsmParserThread::decodeNodeTags(QDomElement &xmlComponent, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate &coordMin, QGeoCoordinate &coordMax, QGeoCoordinate &gpsRef)
-{
-    int64_t id_tmp=0;
-    QGeoCoordinate gps_tmp;
-    QString attribute;
-    bool gpsRefIsSet = false;
 
-    if (xmlComponent.tagName()=="node") {
+    while(xml.readNextStartElement()) {
+        const QStringView tagName = xml.name();
+        if(tagName == QLatin1String("node")){
+            decodeNode(xml, nodeMap);
+        }else if(tagName == QLatin1String("way")){
+            decodeBuildings(xml, buildingMap, nodeMap, coordinateMin, coordinateMax, projector);
+        }else if(tagName == QLatin1String("relation")){
+            decodeRelations(xml, buildingMap);
+        }else if(tagName == QLatin1String("bounds")){
+            if(decodeBounds(xml, coordinateMin, coordinateMax, gpsRef)){
+                gpsRefIsSet = true;
+                projector = LocalPointProjector(gpsRef);
+            }
+        }else{
+            xml.skipCurrentElement();
+        }
+    }
+    if(xml.hasError()){
+        qDebug() << "Error while reading OSM file, line" << xml.lineNumber() << xml.errorString();
+    }
 
-        attribute = xmlComponent.attribute("id","-1");
-        id_tmp = attribute.toLongLong();
+    // Plain ways were only kept in case a relation made buildings out of them
+    buildingMap.removeIf([](const QHash<uint64_t, BuildingType_t>::iterator it) {
+        return it.value().levels == 0 && it.value().height == 0;
+    });
+    buildingMap.squeeze();
 
-        attribute = xmlComponent.attribute("lat","0");
-        gps_tmp.setLatitude(attribute.toDouble());
+    return gpsRefIsSet;
+}
 
-        attribute = xmlComponent.attribute("lon","0");
-        gps_tmp.setLongitude(attribute.toDouble());
+bool OsmParserThread::decodeBounds(QXmlStreamReader &xml, QGeoCoordinate &coordMin, QGeoCoordinate &coordMax, QGeoCoordinate &gpsRef)
+{
+    const QXmlStreamAttributes attributes = xml.attributes();
+    coordMin.setLatitude(attributes.value("minlat").toFloat());
+    coordMin.setLongitude(attributes.value("minlon").toFloat());
+    coordMin.setAltitude(0);
+    coordMax.setLatitude(attributes.value("maxlat").toFloat());
+    coordMax.setLongitude(attributes.value("maxlon").toFloat());
+    coordMax.setAltitude(0);
+
+    gpsRef.setLatitude(0.5 * (coordMin.latitude() + coordMax.latitude()));
+    gpsRef.setLongitude(0.5 * (coordMin.longitude() + coordMax.longitude()));
+    gpsRef.setAltitude(0);
+
+    xml.skipCurrentElement();
+    return true;
+}
 
-        gps_tmp.setAltitude(0);
+void OsmParserThread::decodeNode(QXmlStreamReader &xml, QHash<uint64_t, NodeType_t> &nodeMap)
+{
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const int64_t id_tmp = attributes.value("id").toLongLong();
 
-        if(id_tmp > 0) {
-            nodeMap.insert((uint64_t)id_tmp, gps_tmp);
-        }
-    }else if(xmlComponent.tagName() == "bounds") {
-        coordMin.setLatitude(xmlComponent.attribute("minlat","0").toFloat());
-        coordMin.setLongitude(xmlComponent.attribute("minlon","0").toFloat());
-        coordMin.setAltitude(0);
-        coordMax.setLatitude(xmlComponent.attribute("maxlat","0").toFloat());
-        coordMax.setLongitude(xmlComponent.attribute("maxlon","0").toFloat());
-        coordMax.setAltitude(0);
-
-        gpsRefIsSet = true;
-        gps_tmp.setLatitude(0.5 * (coordMin.latitude() + coordMax.latitude()));
-        gps_tmp.setLongitude(0.5 * (coordMin.longitude() + coordMax.longitude()));
-        gps_tmp.setAltitude(0);
-        gpsRef = gps_tmp;
+    if(id_tmp > 0) {
+        nodeMap.insert((uint64_t)id_tmp, NodeType_t{attributes.value("lat").toDouble(), attributes.value("lon").toDouble()});
     }
-    return gpsRefIsSet;
+
+    // Node tags are of no interest
+    xml.skipCurrentElement();
 }
 
-void OsmParserThread::decodeBuildings(QDomElement &xmlComponent, QMap<uint64_t, OsmParserThread::BuildingType_t> &bldMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate &coordMin, QGeoCoordinate &coordMax, QGeoCoordinate gpsRef)
+void OsmParserThread::decodeBuildings(QXmlStreamReader &xml, QHash<uint64_t, OsmParserThread::BuildingType_t> &bldMap, const QHash<uint64_t, NodeType_t> &nodeMap, QGeoCoordinate &coordMin, QGeoCoordinate &coordMax, const LocalPointProjector &projector)
 {
-    if (xmlComponent.tagName()!="way"){
-        return;
-    }
-
-    int64_t id_tmp = xmlComponent.attribute("id","0").toLongLong();
+    const int64_t id_tmp = xml.attributes().value("id").toLongLong();
     if(id_tmp == 0) {
+        xml.skipCurrentElement();
         return;
     }
     OsmParserThread::BuildingType_t bld_tmp;
-    QGeoCoordinate gps_pt_tmp;
     QVector3D local_pt_tmp;
-    std::vector<QGeoCoordinate> bld_points;
     std::vector<QVector2D> bld_points_local;
     double bld_lon_max, bld_lon_min, bld_lat_max, bld_lat_min;
     double bld_x_max, bld_x_min, bld_y_max, bld_y_min;
@@ -159,21 +162,18 @@ void OsmParserThread::decodeBuildings(QDomElement &xmlComponent, QMap<uint64_t,
     bld_lon_max = bld_lat_max = -1e10;
     bld_lon_min = bld_lat_min = 1e10;
 
-    int64_t ref_id;
-    QDomElement Child = xmlComponent.firstChild().toElement();
-    QString attribute;
-
     bld_tmp.height = 0;
     bld_tmp.levels = 0;
 
-    while (!Child.isNull()) {
-        if (Child.tagName()=="nd") {
-            ref_id = Child.attribute("ref","0").toLongLong();
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("nd")) {
+            const int64_t ref_id = attributes.value("ref").toLongLong();
+            const auto node = nodeMap.constFind((uint64_t)ref_id);
 
-            if(ref_id > 0) {
-                gps_pt_tmp = nodeMap[ref_id];
-                bld_points.push_back(gps_pt_tmp);
-                local_pt_tmp = mapGpsToLocalPoint(gps_pt_tmp, gpsRef);
+            // Nodes outside of an extract are left out
+            if(ref_id > 0 && node != nodeMap.constEnd()) {
+                local_pt_tmp = projector.map(node->lat, node->lon);
                 bld_points_local.push_back(QVector2D(local_pt_tmp.x(), local_pt_tmp.y()));
 
                 bld_x_max = (bld_x_max < local_pt_tmp.x())?(local_pt_tmp.x()):(bld_x_max);
@@ -181,68 +181,56 @@ void OsmParserThread::decodeBuildings(QDomElement &xmlComponent, QMap<uint64_t,
                 bld_x_min = (bld_x_min > local_pt_tmp.x())?(local_pt_tmp.x()):(bld_x_min);
                 bld_y_min = (bld_y_min > local_pt_tmp.y())?(local_pt_tmp.y()):(bld_y_min);
 
-                bld_lon_max = fmax(bld_lon_max, gps_pt_tmp.longitude());
-                bld_lat_max = fmax(bld_lat_max, gps_pt_tmp.latitude());
-                bld_lon_min = fmin(bld_lon_min, gps_pt_tmp.longitude());
-                bld_lat_min = fmin(bld_lat_min, gps_pt_tmp.latitude());
+                bld_lon_max = fmax(bld_lon_max, node->lon);
+                bld_lat_max = fmax(bld_lat_max, node->lat);
+                bld_lon_min = fmin(bld_lon_min, node->lon);
+                bld_lat_min = fmin(bld_lat_min, node->lat);
             }
-        }else if (Child.tagName()=="tag") {
-            attribute = Child.attribute("k","0");
-            if(attribute == "building:levels") {
-                bld_tmp.levels = Child.attribute("v","0").toFloat();
-            }else if(attribute == "height") {
-                bld_tmp.height = Child.attribute("v","0").toFloat();
-            }else if(attribute == "building" && bld_tmp.levels == 0 && bld_tmp.height == 0){
-                QString attribute_2 = Child.attribute("v","0");
-                if(_singleStoreyBuildings.contains(attribute_2)){
+        }else if (xml.name() == QLatin1String("tag")) {
+            const QStringView attribute = attributes.value("k");
+            if(attribute == QLatin1String("building:levels")) {
+                bld_tmp.levels = attributes.value("v").toFloat();
+            }else if(attribute == QLatin1String("height")) {
+                bld_tmp.height = attributes.value("v").toFloat();
+            }else if(attribute == QLatin1String("building") && bld_tmp.levels == 0 && bld_tmp.height == 0){
+                if(_singleStoreyBuildings.contains(attributes.value("v"))){
                     bld_tmp.levels = 1;
                 }else{
                     bld_tmp.levels = 2;
                 }
-            }else if(attribute == "leisure" && bld_tmp.levels == 0 && bld_tmp.height == 0){
-                QString attribute_2 = Child.attribute("v","0");
-                if(_doubleStoreyLeisure.contains(attribute_2)){
+            }else if(attribute == QLatin1String("leisure") && bld_tmp.levels == 0 && bld_tmp.height == 0){
+                if(_doubleStoreyLeisure.contains(attributes.value("v"))){
                     bld_tmp.levels = 2;
                 }
             }
         }
 
-        Child = Child.nextSibling().toElement();
+        xml.skipCurrentElement();
     }
 
-    if(bld_points.size() > 2) {
-        //        float bld_height = (bld_tmp.height >= bld_tmp.levels * _buildingLevelHeight)?(bld_tmp.height):(bld_tmp.levels * _buildingLevelHeight);
-        //        bld_tmp.height = bld_height;
+    if(bld_points_local.size() > 2) {
         if(bld_tmp.levels > 0 || bld_tmp.height > 0){
             coordMin.setLatitude(fmin(coordMin.latitude(), bld_lat_min));
             coordMin.setLongitude(fmin(coordMin.longitude(), bld_lon_min));
             coordMax.setLatitude(fmax(coordMax.latitude(), bld_lat_max));
             coordMax.setLongitude(fmax(coordMax.longitude(), bld_lon_max));
         }
-        bld_tmp.points_gps = bld_points;
-        bld_tmp.points_local = bld_points_local;
+        bld_tmp.points_local = std::move(bld_points_local);
         bld_tmp.bb_max = QVector2D(bld_x_max, bld_y_max);
         bld_tmp.bb_min = QVector2D(bld_x_min, bld_y_min);
-        bldMap.insert(id_tmp, bld_tmp);
+        bldMap.insert(id_tmp, std::move(bld_tmp));
     }
 }
 
-void OsmParserThread::decodeRelations(QDomElement &xmlComponent, QMap<uint64_t, OsmParserThread::BuildingType_t> &bldMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate gpsRef)
+void OsmParserThread::decodeRelations(QXmlStreamReader &xml, QHash<uint64_t, OsmParserThread::BuildingType_t> &bldMap)
 {
-    if (xmlComponent.tagName()!="relation"){
-        return;
-    }
-
-    int64_t id_tmp = xmlComponent.attribute("id","0").toLongLong();
+    const int64_t id_tmp = xml.attributes().value("id").toLongLong();
     if(id_tmp == 0) {
+        xml.skipCurrentElement();
         return;
     }
 
     OsmParserThread::BuildingType_t bld_tmp;
-    int64_t ref_id;
-    QDomElement Child = xmlComponent.firstChild().toElement();
-    QString attribute;
-    QString role;
 
     bld_tmp.height = 0;
     bld_tmp.levels = 0;
@@ -250,14 +238,14 @@ void OsmParserThread::decodeRelations(QDomElement &xmlComponent, QMap<uint64_t,
     bool isBuilding = false;
     bool isMultipolygon = false;
 
-    while (!Child.isNull()) {
-        if (Child.tagName()=="member") {
-            ref_id = Child.attribute("ref","0").toLongLong();
-            role = Child.attribute("role","0");
-            auto bldItem = bldMap.find(ref_id);
-            if(bldItem != bldMap.end()) {
-                bld_tmp.append(bldItem.value().points_local, role == "inner");
-                bld_tmp.append(bldItem.value().points_gps, role == "inner");
+    while (xml.readNextStartElement()) {
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("member")) {
+            const int64_t ref_id = attributes.value("ref").toLongLong();
+            const bool isInner = attributes.value("role") == QLatin1String("inner");
+            auto bldItem = bldMap.constFind(ref_id);
+            if(bldItem != bldMap.constEnd()) {
+                bld_tmp.append(bldItem.value().points_local, isInner);
                 bld_tmp.levels = fmax(bld_tmp.levels, bldItem.value().levels);
                 bld_tmp.height = fmax(bld_tmp.height, bldItem.value().height);
 
@@ -267,17 +255,17 @@ void OsmParserThread::decodeRelations(QDomElement &xmlComponent, QMap<uint64_t,
                 bld_tmp.bb_min[1] = fmin(bld_tmp.bb_min[1], bldItem.value().bb_min[1]);
                 bldToBeRemoved.push_back(ref_id);
             }
-        }else if (Child.tagName()=="tag") {
-            attribute = Child.attribute("k","0");
-            if(attribute == "type") {
-                if(Child.attribute("v","0") == "multipolygon"){
+        }else if (xml.name() == QLatin1String("tag")) {
+            const QStringView attribute = attributes.value("k");
+            if(attribute == QLatin1String("type")) {
+                if(attributes.value("v") == QLatin1String("multipolygon")){
                     isMultipolygon = true;
                 }
-            }else if(attribute == "building"){
+            }else if(attribute == QLatin1String("building")){
                 isBuilding = true;
             }
         }
-        Child = Child.nextSibling().toElement();
+        xml.skipCurrentElement();
     }
 
     if(isBuilding){
@@ -285,11 +273,11 @@ void OsmParserThread::decodeRelations(QDomElement &xmlComponent, QMap<uint64_t,
             bld_tmp.levels = (bld_tmp.levels == 0)?(2):(bld_tmp.levels);
         }
     }
-    if(isMultipolygon){
+    if(isMultipolygon && !bldToBeRemoved.empty()){
         for(uint i_id=0; i_id<bldToBeRemoved.size(); i_id++){
             bldMap.remove(bldToBeRemoved[i_id]);
         }
-        bldMap.insert(bldToBeRemoved[0], bld_tmp);
+        bldMap.insert(bldToBeRemoved[0], std::move(bld_tmp));
     }
 }
 
@@ -11,12 +11,15 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QThread>
-#include <QtXml/QDomDocument>
-#include <QtCore/QMap>
+#include <QtCore/QHash>
 #include <QtGui/QVector3D>
 #include <QtGui/QVector2D>
 #include <QtPositioning/QGeoCoordinate>
 
+class QIODevice;
+class QXmlStreamReader;
+class LocalPointProjector;
+
 ///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
 
 
@@ -26,59 +29,49 @@ class OsmParserThread : public QThread
 public:
     typedef struct BuildingType_s
     {
-        std::vector<QGeoCoordinate> points_gps;
-        std::vector<QGeoCoordinate> points_gps_inner;
         std::vector<QVector2D> points_local;
         std::vector<QVector2D> points_local_inner;
-        std::vector<QVector3D> triangulated_mesh;
         QVector2D bb_max = QVector2D(-1e6, -1e6); //bounding boxes
         QVector2D bb_min = QVector2D(1e6, 1e6); //bounding boxes
         float height;
         float levels;
 
-        void append(std::vector<QGeoCoordinate> newPoints, bool isInner){
-            for(uint i=0; i<newPoints.size(); i++){
-                if(isInner){
-                    points_gps_inner.push_back(newPoints[i]);
-                }else{
-                    points_gps.push_back(newPoints[i]);
-                }
-            }
-        }
-
-        void append(std::vector<QVector2D> newPoints, bool isInner){
-            for(uint i=0; i<newPoints.size(); i++){
-                if(isInner){
-                    points_local_inner.push_back(newPoints[i]);
-                }else{
-                    points_local.push_back(newPoints[i]);
-                }
-            }
+        void append(const std::vector<QVector2D>& newPoints, bool isInner){
+            std::vector<QVector2D>& points = (isInner)?(points_local_inner):(points_local);
+            points.insert(points.end(), newPoints.begin(), newPoints.end());
         }
     }BuildingType_t;
 
+    /// Node positions only, a QGeoCoordinate per node is too heavy for city sized maps
+    typedef struct NodeType_s
+    {
+        double lat;
+        double lon;
+    }NodeType_t;
+
     Q_OBJECT
 public:
     explicit OsmParserThread(QObject *parent = nullptr);
 
     QGeoCoordinate gpsRefPoint;
-    QMap<uint64_t, QGeoCoordinate> mapNodes;
-    QMap<uint64_t, BuildingType_t> mapBuildings;
+    QHash<uint64_t, BuildingType_t> mapBuildings;
     QGeoCoordinate coordinateMin, coordinateMax;
 
     void start(QString filePath);
 
+    /// Decodes an OSM XML stream, nodes are expected before the ways and relations referencing them
+    ///     @return true if the map bounds were found
+    static bool decodeOsm(QIODevice* device, QHash<uint64_t, BuildingType_t>& buildingMap, QGeoCoordinate& coordinateMin, QGeoCoordinate& coordinateMax, QGeoCoordinate& gpsRef);
+
 private:
     QThread* _mainThread;
     bool _mapLoadedFlag;
-    QList<QString> _singleStoreyBuildings;
-    QList<QString> _doubleStoreyLeisure;
 
     void parseOsmFile(QString filePath);
-    bool decodeFile(QDomDocument& xml_content, QMap<uint64_t, BuildingType_t > &buildingMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate& coordinateMin, QGeoCoordinate& coordinateMax, QGeoCoordinate& gpsRef);
-    bool decodeNodeTags(QDomElement& xmlComponent, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate& coordMin, QGeoCoordinate& coordMax, QGeoCoordinate& gpsRef);
-    void decodeBuildings(QDomElement& xmlComponent, QMap<uint64_t, BuildingType_t > &bldMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate& coordMin, QGeoCoordinate& coordMax, QGeoCoordinate gpsRef);
-    void decodeRelations(QDomElement& xmlComponent, QMap<uint64_t, BuildingType_t > &bldMap, QMap<uint64_t, QGeoCoordinate> &nodeMap, QGeoCoordinate gpsRef);
+    static bool decodeBounds(QXmlStreamReader& xml, QGeoCoordinate& coordMin, QGeoCoordinate& coordMax, QGeoCoordinate& gpsRef);
+    static void decodeNode(QXmlStreamReader& xml, QHash<uint64_t, NodeType_t>& nodeMap);
+    static void decodeBuildings(QXmlStreamReader& xml, QHash<uint64_t, BuildingType_t>& bldMap, const QHash<uint64_t, NodeType_t>& nodeMap, QGeoCoordinate& coordMin, QGeoCoordinate& coordMax, const LocalPointProjector& projector);
+    static void decodeRelations(QXmlStreamReader& xml, QHash<uint64_t, BuildingType_t>& bldMap);
 
 
 signals:
@@ -129,6 +129,13 @@ View3D {
 
         Node{
             property real textureDownloadProgress: _terrainTextureManager.textureDownloadProgress
+            property var  _activeVehicle: QGroundControl.multiVehicleManager.activeVehicle
+
+            GeoCoordinateType {
+                id: _viewCenterPosition
+                gpsRef: _gpsRef
+                coordinate: (_activeVehicle)?(_activeVehicle.coordinate):(_gpsRef)
+            }
 
             Model {
                 id: cityMapModel
@@ -138,6 +145,7 @@ View3D {
                     id: cityMapGeometry
                     modelName: "city_map"
                     osmParser: (viewer3DManager)?(viewer3DManager.osmParser):(null)
+                    viewCenter: _viewCenterPosition.localCoordinate
                 }
 
                 materials: [
@@ -160,6 +168,7 @@ View3D {
                 geometry: Viewer3DTerrainGeometry {
                     id: terrainGeometryManager
                     refCoordinate: _gpsRef
+                    viewCenter: _viewCenterPosition.localCoordinate
                 }
 
                 materials: CustomMaterial {
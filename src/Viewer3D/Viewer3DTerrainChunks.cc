@@ -0,0 +1,425 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Viewer3DTerrainChunks.h"
+
+#include <QtCore/QSet>
+#include <QtCore/QtMath>
+
+#include <cmath>
+#include <cstring>
+
+static constexpr double kMaxLatitude = 85.05112878;
+static constexpr double kEarthRadius = 6378137.0;
+
+Viewer3DTerrainChunks::Viewer3DTerrainChunks()
+    : _reference(0, 0, 0)
+    , _projector(QGeoCoordinate(0, 0, 0))
+{
+}
+
+void Viewer3DTerrainChunks::clear()
+{
+    _generation++;
+    _chunks.clear();
+    _heights.clear();
+}
+
+void Viewer3DTerrainChunks::setRegion(const QGeoCoordinate &roiMin, const QGeoCoordinate &roiMax)
+{
+    if (!roiMin.isValid() || !roiMax.isValid()) {
+        _region = Rect();
+        return;
+    }
+
+    _region.minLat = qMin(roiMin.latitude(), roiMax.latitude());
+    _region.maxLat = qMax(roiMin.latitude(), roiMax.latitude());
+    _region.minLon = qMin(roiMin.longitude(), roiMax.longitude());
+    _region.maxLon = qMax(roiMin.longitude(), roiMax.longitude());
+}
+
+void Viewer3DTerrainChunks::setReference(const QGeoCoordinate &reference)
+{
+    if (!reference.isValid() || (reference == _reference)) {
+        return;
+    }
+
+    _reference = reference;
+    _projector = LocalPointProjector(reference);
+    _generation++;
+    _chunks.clear();
+}
+
+void Viewer3DTerrainChunks::setHeightOffset(float heightOffset)
+{
+    if (heightOffset == _heightOffset) {
+        return;
+    }
+
+    _heightOffset = heightOffset;
+    _generation++;
+    _chunks.removeIf([](const QHash<quint64, Chunk>::iterator it) {
+        return it.value().elevated;
+    });
+}
+
+void Viewer3DTerrainChunks::setGridSize(int gridSize)
+{
+    gridSize = qMax(1, gridSize);
+    if (gridSize == _gridSize) {
+        return;
+    }
+
+    // Elevations are sampled on the grid
+    _gridSize = gridSize;
+    clear();
+}
+
+Viewer3DTerrainChunks::Rect Viewer3DTerrainChunks::_cellRect(int level, qint64 x, qint64 y)
+{
+    const double span = kRootSpan / static_cast<double>(1 << level);
+
+    Rect rect;
+    rect.minLon = x * span - 180.0;
+    rect.minLat = y * span - 90.0;
+    rect.maxLon = rect.minLon + span;
+    rect.maxLat = rect.minLat + span;
+    return rect;
+}
+
+Viewer3DTerrainChunks::Rect Viewer3DTerrainChunks::_clipped(const Rect &rect) const
+{
+    Rect clipped;
+    clipped.minLat = qMax(rect.minLat, _region.minLat);
+    clipped.minLon = qMax(rect.minLon, _region.minLon);
+    clipped.maxLat = qMin(rect.maxLat, _region.maxLat);
+    clipped.maxLon = qMin(rect.maxLon, _region.maxLon);
+    return clipped;
+}
+
+Viewer3DTerrainChunks::Rect Viewer3DTerrainChunks::chunkRect(quint64 key) const
+{
+    return _clipped(_cellRect(_keyLevel(key), _keyX(key), _keyY(key)));
+}
+
+QList<quint64> Viewer3DTerrainChunks::selectChunks(const QVector3D &viewPoint) const
+{
+    QList<quint64> keys;
+    if (_region.isEmpty()) {
+        return keys;
+    }
+
+    const qint64 xMin = static_cast<qint64>(std::floor((_region.minLon + 180.0) / kRootSpan));
+    const qint64 xMax = static_cast<qint64>(std::floor((_region.maxLon + 180.0) / kRootSpan));
+    const qint64 yMin = static_cast<qint64>(std::floor((_region.minLat + 90.0) / kRootSpan));
+    const qint64 yMax = static_cast<qint64>(std::floor((_region.maxLat + 90.0) / kRootSpan));
+    for (qint64 y = yMin; y <= yMax; y++) {
+        for (qint64 x = xMin; x <= xMax; x++) {
+            _select(0, x, y, viewPoint, keys);
+        }
+    }
+
+    return keys;
+}
+
+void Viewer3DTerrainChunks::_select(int level, qint64 x, qint64 y, const QVector3D &viewPoint, QList<quint64> &keys) const
+{
+    const Rect rect = _clipped(_cellRect(level, x, y));
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    if (level < _maxLevel) {
+        const QVector3D southWest = _projector.map(rect.minLat, rect.minLon);
+        const QVector3D northEast = _projector.map(rect.maxLat, rect.maxLon);
+        const float dx = qMax(0.0f, qMax(southWest.x() - viewPoint.x(), viewPoint.x() - northEast.x()));
+        const float dy = qMax(0.0f, qMax(southWest.y() - viewPoint.y(), viewPoint.y() - northEast.y()));
+        const double distance = std::sqrt(dx * dx + dy * dy + viewPoint.z() * viewPoint.z());
+        const double size = qMax(northEast.x() - southWest.x(), northEast.y() - southWest.y());
+
+        if (distance < size * _lodFactor) {
+            for (int childY = 0; childY < 2; childY++) {
+                for (int childX = 0; childX < 2; childX++) {
+                    _select(level + 1, 2 * x + childX, 2 * y + childY, viewPoint, keys);
+                }
+            }
+            return;
+        }
+    }
+
+    keys.append(_key(level, x, y));
+}
+
+QList<QGeoCoordinate> Viewer3DTerrainChunks::sampleCoordinates(const Rect &rect, int gridSize)
+{
+    const double latStep = (rect.maxLat - rect.minLat) / gridSize;
+    const double lonStep = (rect.maxLon - rect.minLon) / gridSize;
+
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve((gridSize + 3) * (gridSize + 3));
+    for (int i = -1; i <= gridSize + 1; i++) {
+        const double latitude = rect.maxLat - i * latStep;
+        for (int j = -1; j <= gridSize + 1; j++) {
+            coordinates.append(QGeoCoordinate(latitude, rect.minLon + j * lonStep));
+        }
+    }
+
+    return coordinates;
+}
+
+void Viewer3DTerrainChunks::setHeights(quint64 key, const Rect &rect, std::vector<float> heights)
+{
+    _heights.insert(key, Heights{ rect, std::move(heights) });
+}
+
+bool Viewer3DTerrainChunks::hasHeights(quint64 key, const Rect &rect) const
+{
+    const auto it = _heights.constFind(key);
+    return (it != _heights.constEnd()) && (it->rect == rect);
+}
+
+QList<Viewer3DTerrainChunks::BuildJob> Viewer3DTerrainChunks::staleChunks(const QList<quint64> &keys, bool useHeights) const
+{
+    QList<BuildJob> jobs;
+    for (const quint64 key : keys) {
+        const Rect rect = chunkRect(key);
+        const auto heights = _heights.constFind(key);
+        const bool elevated = useHeights && (heights != _heights.constEnd()) && (heights->rect == rect) && !heights->values.empty();
+
+        const auto chunk = _chunks.constFind(key);
+        if ((chunk != _chunks.constEnd()) && (chunk->rect == rect) && (chunk->elevated == elevated)) {
+            continue;
+        }
+
+        BuildJob job;
+        job.key = key;
+        job.rect = rect;
+        if (elevated) {
+            job.heights = heights->values;
+        }
+        job.heightOffset = _heightOffset;
+        job.gridSize = _gridSize;
+        job.reference = _reference;
+        job.generation = _generation;
+        jobs.append(std::move(job));
+    }
+
+    return jobs;
+}
+
+double Viewer3DTerrainChunks::_mercatorT(double latitude)
+{
+    const double sinLatitude = std::sin(qDegreesToRadians(qBound(-kMaxLatitude, latitude, kMaxLatitude)));
+    return 0.5 - std::log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+void Viewer3DTerrainChunks::computeNormals(const float *heights, int gridSize, float dx, float dy, float *normals)
+{
+    const int stride = gridSize + 3;
+    const int count = gridSize + 1;
+    const float scaleX = -1.0f / (2.0f * dx);
+    const float scaleY = -1.0f / (2.0f * dy);
+
+    // Central differences over a row at a time into separate component arrays, plain loops the compiler vectorizes
+    std::vector<float> nx(count), ny(count), nz(count);
+    for (int i = 0; i < count; i++) {
+        const float *north = heights + i * stride + 1;
+        const float *row = heights + (i + 1) * stride + 1;
+        const float *south = heights + (i + 2) * stride + 1;
+
+        for (int j = 0; j < count; j++) {
+            const float gx = (row[j + 1] - row[j - 1]) * scaleX;
+            const float gy = (north[j] - south[j]) * scaleY;
+            const float invLength = 1.0f / std::sqrt(gx * gx + gy * gy + 1.0f);
+            nx[j] = gx * invLength;
+            ny[j] = gy * invLength;
+            nz[j] = invLength;
+        }
+
+        float *out = normals + i * count * 3;
+        for (int j = 0; j < count; j++) {
+            out[j * 3] = nx[j];
+            out[j * 3 + 1] = ny[j];
+            out[j * 3 + 2] = nz[j];
+        }
+    }
+}
+
+Viewer3DTerrainChunks::Chunk Viewer3DTerrainChunks::buildChunk(const BuildJob &job)
+{
+    Chunk chunk;
+    chunk.key = job.key;
+    chunk.rect = job.rect;
+    chunk.elevated = !job.heights.empty();
+    chunk.generation = job.generation;
+    chunk.originS = job.rect.minLon;
+    chunk.originT = _mercatorT(job.rect.maxLat);
+
+    const int n = job.gridSize;
+    const int stride = n + 3;
+    const int count = n + 1;
+    const Rect &rect = job.rect;
+    const double latStep = (rect.maxLat - rect.minLat) / n;
+    const double lonStep = (rect.maxLon - rect.minLon) / n;
+    const double centerLatitude = 0.5 * (rect.minLat + rect.maxLat);
+    const float dx = static_cast<float>(qDegreesToRadians(lonStep) * kEarthRadius * std::cos(qDegreesToRadians(centerLatitude)));
+    const float dy = static_cast<float>(qDegreesToRadians(latStep) * kEarthRadius);
+    const float skirtDepth = qMax(dx, dy);
+
+    std::vector<float> flat;
+    const float *heights = job.heights.data();
+    if (!chunk.elevated) {
+        flat.assign(stride * stride, 0.0f);
+        heights = flat.data();
+    }
+    const float heightOffset = chunk.elevated ? job.heightOffset : 0.0f;
+
+    const LocalPointProjector projector(job.reference);
+    std::vector<float> positions(count * count * 3);
+    std::vector<float> rowT(count);
+    std::vector<float> columnS(count);
+    for (int j = 0; j < count; j++) {
+        columnS[j] = static_cast<float>(j * lonStep);
+    }
+    for (int i = 0; i < count; i++) {
+        const double latitude = rect.maxLat - i * latStep;
+        rowT[i] = static_cast<float>(_mercatorT(latitude) - chunk.originT);
+        for (int j = 0; j < count; j++) {
+            const QVector3D local = projector.map(latitude, rect.minLon + j * lonStep);
+            float *position = positions.data() + (i * count + j) * 3;
+            position[0] = local.x();
+            position[1] = local.y();
+            position[2] = heights[(i + 1) * stride + j + 1] - heightOffset;
+        }
+    }
+
+    std::vector<float> normals(count * count * 3);
+    computeNormals(heights, n, dx, dy, normals.data());
+
+    chunk.vertexData = QByteArray(vertexCount(n) * kFloatsPerVertex * sizeof(float), Qt::Initialization::Uninitialized);
+    float *p = reinterpret_cast<float *>(chunk.vertexData.data());
+    const auto writeVertex = [&](int i, int j, float drop) {
+        const float *position = positions.data() + (i * count + j) * 3;
+        const float *normal = normals.data() + (i * count + j) * 3;
+        *p++ = position[0];
+        *p++ = position[1];
+        *p++ = position[2] - drop;
+        *p++ = normal[0];
+        *p++ = normal[1];
+        *p++ = normal[2];
+        *p++ = columnS[j];
+        *p++ = rowT[i];
+    };
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            //  v1--v3
+            //  |    |
+            //  v2--v4
+            writeVertex(i, j, 0);
+            writeVertex(i + 1, j, 0);
+            writeVertex(i, j + 1, 0);
+
+            writeVertex(i, j + 1, 0);
+            writeVertex(i + 1, j, 0);
+            writeVertex(i + 1, j + 1, 0);
+        }
+    }
+
+    // Skirts hang down from the edges, walked clockwise seen from above so they face outwards
+    const auto writeSkirt = [&](int ia, int ja, int ib, int jb) {
+        writeVertex(ia, ja, 0);
+        writeVertex(ib, jb, 0);
+        writeVertex(ia, ja, skirtDepth);
+
+        writeVertex(ia, ja, skirtDepth);
+        writeVertex(ib, jb, 0);
+        writeVertex(ib, jb, skirtDepth);
+    };
+    for (int k = 0; k < n; k++) {
+        writeSkirt(0, k, 0, k + 1);
+        writeSkirt(k, n, k + 1, n);
+        writeSkirt(n, n - k, n, n - k - 1);
+        writeSkirt(n - k, 0, n - k - 1, 0);
+    }
+
+    return chunk;
+}
+
+void Viewer3DTerrainChunks::insertChunk(const Chunk &chunk)
+{
+    if (chunk.generation != _generation) {
+        return;
+    }
+
+    _chunks.insert(chunk.key, chunk);
+}
+
+QByteArray Viewer3DTerrainChunks::vertexData(const QList<quint64> &keys) const
+{
+    if (_region.isEmpty()) {
+        return QByteArray();
+    }
+
+    qsizetype size = 0;
+    for (const quint64 key : keys) {
+        const auto chunk = _chunks.constFind(key);
+        if (chunk != _chunks.constEnd()) {
+            size += chunk->vertexData.size();
+        }
+    }
+
+    QByteArray data(size, Qt::Initialization::Uninitialized);
+
+    const double scaleS = 1.0 / (_region.maxLon - _region.minLon);
+    const double minT = _mercatorT(_region.maxLat);
+    const double scaleT = 1.0 / (_mercatorT(_region.minLat) - minT);
+
+    char *out = data.data();
+    for (const quint64 key : keys) {
+        const auto chunk = _chunks.constFind(key);
+        if (chunk == _chunks.constEnd()) {
+            continue;
+        }
+
+        const qsizetype chunkSize = chunk->vertexData.size();
+        (void) memcpy(out, chunk->vertexData.constData(), chunkSize);
+
+        // Texture coordinates relative to the chunk become relative to the region
+        const float offsetS = static_cast<float>((chunk->originS - _region.minLon) * scaleS);
+        const float offsetT = static_cast<float>((chunk->originT - minT) * scaleT);
+        const float chunkScaleS = static_cast<float>(scaleS);
+        const float chunkScaleT = static_cast<float>(scaleT);
+        float *vertex = reinterpret_cast<float *>(out);
+        const qsizetype vertices = chunkSize / (kFloatsPerVertex * sizeof(float));
+        for (qsizetype v = 0; v < vertices; v++, vertex += kFloatsPerVertex) {
+            vertex[6] = offsetS + vertex[6] * chunkScaleS;
+            vertex[7] = offsetT + vertex[7] * chunkScaleT;
+        }
+
+        out += chunkSize;
+    }
+
+    return data;
+}
+
+void Viewer3DTerrainChunks::prune(const QList<quint64> &keep)
+{
+    if ((_chunks.count() <= kMaxCachedChunks) && (_heights.count() <= kMaxCachedChunks)) {
+        return;
+    }
+
+    const QSet<quint64> keepSet(keep.constBegin(), keep.constEnd());
+    _chunks.removeIf([&keepSet](const QHash<quint64, Chunk>::iterator it) {
+        return !keepSet.contains(it.key());
+    });
+    _heights.removeIf([&keepSet](const QHash<quint64, Heights>::iterator it) {
+        return !keepSet.contains(it.key());
+    });
+}
@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "Viewer3DUtils.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtGui/QVector3D>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <vector>
+
+/// Chunked level of detail terrain for Viewer3DTerrainGeometry.
+///
+/// Chunks are the cells of a quadtree laid over a fixed geographic grid: level 0 cells are kRootSpan degrees wide
+/// and every level halves them. A chunk therefore keeps its key when the region of interest changes and stays
+/// cached. Cells close to the view point are split further than the ones far away.
+///
+/// Each chunk is a gridSize x gridSize patch of triangles with a skirt along its edges, which hides the cracks
+/// between neighbouring chunks of different levels. The elevation samples of a chunk extend one sample past its
+/// edges so normals along an edge match the neighbour's.
+///
+/// Vertices are 3 floats position, 3 floats normal and 2 floats texture coordinate, the layout
+/// Viewer3DTerrainGeometry uploads.
+class Viewer3DTerrainChunks
+{
+public:
+    struct Rect {
+        double minLat = 0;
+        double minLon = 0;
+        double maxLat = 0;
+        double maxLon = 0;
+
+        /// Slivers left over from rounding at cell boundaries count as empty
+        bool isEmpty() const { return ((maxLat - minLat) < kMinSpan) || ((maxLon - minLon) < kMinSpan); }
+        bool operator==(const Rect &other) const { return (minLat == other.minLat) && (minLon == other.minLon) && (maxLat == other.maxLat) && (maxLon == other.maxLon); }
+        bool operator!=(const Rect &other) const { return !(*this == other); }
+    };
+
+    /// Everything needed to build one chunk, so chunks can be built on worker threads
+    struct BuildJob {
+        quint64             key = 0;
+        Rect                rect;
+        std::vector<float>  heights;        ///< (gridSize + 3)^2 elevations, empty for flat
+        float               heightOffset = 0;
+        int                 gridSize = kDefaultGridSize;
+        QGeoCoordinate      reference;
+        int                 generation = 0;
+    };
+
+    struct Chunk {
+        quint64     key = 0;
+        Rect        rect;
+        bool        elevated = false;
+        int         generation = 0;         ///< Chunks built before the cache was last invalidated are not inserted
+        double      originS = 0;            ///< Texture coordinates are stored relative to these, in float they
+        double      originT = 0;            ///< would not be precise enough for a small region
+        QByteArray  vertexData;
+    };
+
+    Viewer3DTerrainChunks();
+
+    void clear();
+
+    /// Region the terrain is shown in, the texture covers exactly this region
+    void setRegion(const QGeoCoordinate &roiMin, const QGeoCoordinate &roiMax);
+    Rect region() const { return _region; }
+
+    /// Local coordinates are relative to this, changing it drops all chunks
+    void setReference(const QGeoCoordinate &reference);
+
+    /// Elevation which ends up at height 0, usually the elevation of the reference. Changing it drops the elevated chunks.
+    void setHeightOffset(float heightOffset);
+
+    void setGridSize(int gridSize);
+    void setMaxLevel(int maxLevel) { _maxLevel = qBound(0, maxLevel, kMaxLevel); }
+
+    /// A cell is split while the view point is closer than lodFactor times its size
+    void setLodFactor(double lodFactor) { _lodFactor = lodFactor; }
+
+    int gridSize() const { return _gridSize; }
+
+    /// Walks the quadtree down from the cells covering the region
+    ///     @param viewPoint Local coordinates, the height counts towards the distance as well
+    ///     @return Keys of the chunks to show
+    QList<quint64> selectChunks(const QVector3D &viewPoint) const;
+
+    /// Area of the chunk, clipped to the region
+    Rect chunkRect(quint64 key) const;
+
+    /// Elevation sample coordinates of a chunk, row by row from north to south, one sample past every edge
+    static QList<QGeoCoordinate> sampleCoordinates(const Rect &rect, int gridSize);
+
+    /// Stores the elevations for a chunk, empty if there are none so they are not asked for again
+    void setHeights(quint64 key, const Rect &rect, std::vector<float> heights);
+    bool hasHeights(quint64 key, const Rect &rect) const;
+
+    /// @return Jobs for the chunks which are missing or out of date
+    ///     @param useHeights Build with elevations where they are available
+    QList<BuildJob> staleChunks(const QList<quint64> &keys, bool useHeights) const;
+
+    /// Thread safe
+    static Chunk buildChunk(const BuildJob &job);
+
+    /// Ignores chunks built for a reference, height offset or grid size which has changed since
+    void insertChunk(const Chunk &chunk);
+    bool hasChunk(quint64 key) const { return _chunks.contains(key); }
+    int chunkCount() const { return _chunks.count(); }
+
+    /// Concatenates the chunks with their texture coordinates scaled to the region. Missing chunks are left out.
+    QByteArray vertexData(const QList<quint64> &keys) const;
+
+    /// Drops chunks not in keep once the cache is over kMaxCachedChunks
+    void prune(const QList<quint64> &keep);
+
+    /// Vertex normals of a grid of elevations
+    ///     @param heights (gridSize + 3)^2 elevations, row by row from north to south with one sample past every edge
+    ///     @param dx, dy Sample spacing in meters
+    ///     @param[out] normals (gridSize + 1)^2 normals, 3 floats each
+    static void computeNormals(const float *heights, int gridSize, float dx, float dy, float *normals);
+
+    /// Vertices per chunk
+    static qsizetype vertexCount(int gridSize) { return static_cast<qsizetype>(gridSize) * (gridSize + 4) * 6; }
+
+    static constexpr int    kFloatsPerVertex    = 8;
+    static constexpr int    kDefaultGridSize    = 16;
+    static constexpr int    kDefaultMaxLevel    = 5;
+    static constexpr double kDefaultLodFactor   = 2.0;
+    static constexpr double kRootSpan           = 0.05;     ///< Width and height of level 0 cells, degrees
+    static constexpr double kMinSpan            = 1e-9;     ///< Degrees
+    static constexpr int    kMaxLevel           = 12;
+    static constexpr int    kMaxCachedChunks    = 512;
+
+private:
+    static quint64 _key(int level, qint64 x, qint64 y) { return (static_cast<quint64>(level) << 56) | (static_cast<quint64>(x) << 28) | static_cast<quint64>(y); }
+    static int _keyLevel(quint64 key) { return static_cast<int>(key >> 56); }
+    static qint64 _keyX(quint64 key) { return static_cast<qint64>((key >> 28) & 0xFFFFFFF); }
+    static qint64 _keyY(quint64 key) { return static_cast<qint64>(key & 0xFFFFFFF); }
+
+    static Rect _cellRect(int level, qint64 x, qint64 y);
+    Rect _clipped(const Rect &rect) const;
+    void _select(int level, qint64 x, qint64 y, const QVector3D &viewPoint, QList<quint64> &keys) const;
+
+    /// Mercator texture coordinate of a latitude, as the map tiles of the texture are laid out
+    static double _mercatorT(double latitude);
+
+    struct Heights {
+        Rect                rect;
+        std::vector<float>  values;
+    };
+
+    Rect                    _region;
+    int                     _generation = 0;
+    QGeoCoordinate          _reference;
+    LocalPointProjector     _projector;
+    float                   _heightOffset = 0;
+    int                     _gridSize = kDefaultGridSize;
+    int                     _maxLevel = kDefaultMaxLevel;
+    double                  _lodFactor = kDefaultLodFactor;
+    QHash<quint64, Chunk>   _chunks;
+    QHash<quint64, Heights> _heights;
+};
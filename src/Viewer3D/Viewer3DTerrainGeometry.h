@@ -9,13 +9,20 @@
 
 #pragma once
 
+#include "Viewer3DTerrainChunks.h"
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
 #include <QtQuick3D/QQuick3DGeometry>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtGui/QVector3D>
-#include <QtGui/QVector2D>
 
 class Viewer3DSettings;
 
+Q_DECLARE_LOGGING_CATEGORY(Viewer3DTerrainGeometryLog)
+
 ///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
 
 class Viewer3DTerrainGeometry : public QQuick3DGeometry
@@ -28,6 +35,7 @@ class Viewer3DTerrainGeometry : public QQuick3DGeometry
     Q_PROPERTY(QGeoCoordinate roiMin READ roiMin WRITE setRoiMin NOTIFY roiMinChanged)
     Q_PROPERTY(QGeoCoordinate roiMax READ roiMax WRITE setRoiMax NOTIFY roiMaxChanged)
     Q_PROPERTY(QGeoCoordinate refCoordinate READ refCoordinate WRITE setRefCoordinate NOTIFY refCoordinateChanged)
+    Q_PROPERTY(QVector3D viewCenter READ viewCenter WRITE setViewCenter NOTIFY viewCenterChanged)
 
 public:
     explicit Viewer3DTerrainGeometry();
@@ -53,27 +61,45 @@ public:
     QGeoCoordinate refCoordinate() const;
     void setRefCoordinate(const QGeoCoordinate &newRefCoordinate);
 
+    /// Local position the terrain is most detailed around, usually the active vehicle
+    QVector3D viewCenter() const { return _viewCenter; }
+    void setViewCenter(const QVector3D &viewCenter);
+
 private:
 
     int _sectorCount;
     int _stackCount;
-    std::vector<QVector3D> _vertices;
-    std::vector<QVector2D> _texCoords;
-    std::vector<QVector3D> _normals;
-
-    void buildTerrain(QGeoCoordinate roiMinCoordinate, QGeoCoordinate roiMaxCoordinate, QGeoCoordinate refCoordinate, bool scale);
-    bool buildTerrain_2(QGeoCoordinate roiMinCoordinate, QGeoCoordinate roiMaxCoordinate, QGeoCoordinate refCoordinate, bool scale);
 
-    QVector3D computeFaceNormal(QVector3D x1, QVector3D x2, QVector3D x3);
-    void changeUpAxis(int from, int to);
     void clearScene();
+    void scheduleRefresh();
+    void refresh();
+    void requestHeights(const QList<quint64>& keys);
+    void requestRefElevation();
+    void uploadChunks(const QList<quint64>& keys);
+    bool useElevation() const;
 
     int _radius;
     QGeoCoordinate _roiMin;
     QGeoCoordinate _roiMax;
     QGeoCoordinate _refCoordinate;
+    QVector3D _viewCenter;
     Viewer3DSettings* _viewer3DSettings = nullptr;
 
+    Viewer3DTerrainChunks _chunks;
+    QList<quint64> _uploadedChunks;
+    bool _uploadPending = false;
+    QFutureWatcher<Viewer3DTerrainChunks::Chunk> _buildWatcher;
+    QTimer _refreshTimer;
+    QSet<quint64> _heightRequests;
+    double _refElevation;
+    bool _refElevationRequested = false;
+
+    static constexpr int kRefreshDelay = 100;
+    static constexpr int kMaxHeightRequests = 16;   ///< Chunks with elevation queries outstanding at a time
+
+private slots:
+    void chunksBuilt();
+
 
 signals:
 
@@ -83,4 +109,5 @@ signals:
     void roiMinChanged();
     void roiMaxChanged();
     void refCoordinateChanged();
+    void viewCenterChanged();
 };
@@ -26,6 +26,10 @@ Viewer3DTerrainTexture::Viewer3DTerrainTexture()
     setTextureLoaded(false);
     setTextureDownloadProgress(100.0);
 
+    _textureUploadTimer.setSingleShot(true);
+    _textureUploadTimer.setInterval(500);
+    connect(&_textureUploadTimer, &QTimer::timeout, this, &Viewer3DTerrainTexture::uploadTexture);
+
     // connect(_flightMapSettings->mapProvider(), &Fact::rawValueChanged, this, &Viewer3DTerrainTexture::mapTypeChangedEvent);
     connect(_flightMapSettings->mapType(), &Fact::rawValueChanged, this, &Viewer3DTerrainTexture::mapTypeChangedEvent);
     connect(this, &Viewer3DTerrainTexture::mapProviderIdChanged, this, &Viewer3DTerrainTexture::loadTexture);
@@ -46,11 +50,11 @@ void Viewer3DTerrainTexture::loadTexture()
             _terrainTileLoader = new MapTileQuery(this);
             connect(_terrainTileLoader, &MapTileQuery::loadingMapCompleted, this, &Viewer3DTerrainTexture::updateTexture);
             connect(_terrainTileLoader, &MapTileQuery::textureGeometryReady, this, &Viewer3DTerrainTexture::setTextureGeometry);
+            connect(_terrainTileLoader, &MapTileQuery::mapTileDownloaded, this, &Viewer3DTerrainTexture::tileLoaded);
         }
         _terrainTileLoader->adaptiveMapTilesLoader(_mapType, _mapId,
                                                    _osmParser->getMapBoundingBoxCoordinate().first,
                                                    _osmParser->getMapBoundingBoxCoordinate().second);
-        connect(_terrainTileLoader, &MapTileQuery::mapTileDownloaded, this, &Viewer3DTerrainTexture::setTextureDownloadProgress);
     }
 }
 
@@ -58,20 +62,37 @@ void Viewer3DTerrainTexture::updateTexture()
 {
     MapTileQuery* _extureQuery = qobject_cast<MapTileQuery*>(QObject::sender());
 
-    setSize(_terrainTileLoader->getMapSize());
-    setFormat(QQuick3DTextureData::RGBA32F);
-    setHasTransparency(false);
-
-    setTextureData(_terrainTileLoader->getMapData());
+    _textureUploadTimer.stop();
+    uploadTexture();
     setTextureLoaded(true);
-    setTextureGeometryDone(true);
-    disconnect(_terrainTileLoader, &MapTileQuery::mapTileDownloaded, this, &Viewer3DTerrainTexture::setTextureDownloadProgress);
+    disconnect(_terrainTileLoader, &MapTileQuery::mapTileDownloaded, this, &Viewer3DTerrainTexture::tileLoaded);
     disconnect(_terrainTileLoader, &MapTileQuery::loadingMapCompleted, this, &Viewer3DTerrainTexture::updateTexture);
+    disconnect(_terrainTileLoader, &MapTileQuery::textureGeometryReady, this, &Viewer3DTerrainTexture::setTextureGeometry);
     _terrainTileLoader = nullptr;
     setTextureDownloadProgress(100.0);
     _extureQuery->deleteLater();
 }
 
+void Viewer3DTerrainTexture::uploadTexture()
+{
+    if(!_terrainTileLoader){
+        return;
+    }
+
+    setSize(_terrainTileLoader->getMapSize());
+    setFormat(QQuick3DTextureData::RGBA8);
+    setHasTransparency(false);
+    setTextureData(_terrainTileLoader->getMapData());
+}
+
+void Viewer3DTerrainTexture::tileLoaded(float progress)
+{
+    setTextureDownloadProgress(progress);
+    if(!_textureUploadTimer.isActive()){
+        _textureUploadTimer.start();
+    }
+}
+
 void Viewer3DTerrainTexture::mapTypeChangedEvent(void)
 {
     _mapType.clear();
@@ -187,4 +208,10 @@ void Viewer3DTerrainTexture::setTextureGeometry(MapTileQuery::TileStatistics_t t
     setRoiMinCoordinate(tileInfo.coordinateMin);
     setRoiMaxCoordinate(tileInfo.coordinateMax);
     setTileCount(tileInfo.tileCounts);
+
+    // The terrain is built right away with the empty texture, tiles show up on it as they load
+    _textureUploadTimer.stop();
+    uploadTexture();
+    setTextureGeometryDone(false);
+    setTextureGeometryDone(true);
 }
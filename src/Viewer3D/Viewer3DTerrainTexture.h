@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QTimer>
 #include <QtQuick3D/QQuick3DTextureData>
 
 #include "Viewer3DTileQuery.h"
@@ -70,6 +71,8 @@ private:
     int _mapId;
 
     void updateTexture();
+    void uploadTexture();
+    void tileLoaded(float progress);
     void setTextureLoaded(bool laoded){_textureLoaded = laoded; emit textureLoadedChanged();}
     void mapTypeChangedEvent(void);
 
@@ -87,6 +90,8 @@ private:
 
     float _textureDownloadProgress;
 
+    QTimer _textureUploadTimer; // Limits how often the partially loaded texture is uploaded
+
 signals:
     void roiMinCoordinateChanged();
     void roiMaxCoordinateChanged();
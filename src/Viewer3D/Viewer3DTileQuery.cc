@@ -8,6 +8,15 @@
  ****************************************************************************/
 
 #include "Viewer3DTileQuery.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QThread>
+#include <QtNetwork/QNetworkAccessManager>
+
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(Viewer3DTileQueryLog, "qgc.viewer3d.viewer3dtilequery")
 
 #define PI                  acos(-1.0f)
 #define DEG_TO_RAD          PI/180.0f
@@ -23,33 +32,123 @@ enum RequestStat{
     ERROR,
 };
 
+void MapTileQuery::MapTileContainer_s::init(int zoom, const QPoint &minIndex, const QPoint &maxIndex)
+{
+    QMutexLocker locker(&mutex);
+    generation++;
+    zoomLevel = zoom;
+    tileMinIndex = minIndex;
+    tileMaxIndex = maxIndex;
+    mapWidth = (tileMaxIndex.x() - tileMinIndex.x() + 1) * L;
+    mapHeight = (tileMaxIndex.y() - tileMinIndex.y() + 1) * L;
+    mapTextureImage = QImage(mapWidth, mapHeight, QImage::Format_RGBA8888);
+    mapTextureImage.fill(Qt::gray);
+}
+
+QImage MapTileQuery::MapTileContainer_s::decodeTile(const QByteArray &data, int L)
+{
+    QImage tile = QImage::fromData(data);
+    if(tile.isNull()){
+        return tile;
+    }
+    if(tile.width() != L || tile.height() != L){
+        tile = tile.scaled(L, L, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return tile.convertToFormat(QImage::Format_RGBA8888);
+}
+
+bool MapTileQuery::MapTileContainer_s::setMapTile(const QPoint &tileIndex, const QImage &tile, int tileGeneration)
+{
+    QMutexLocker locker(&mutex);
+    if(tileGeneration != generation || tile.format() != QImage::Format_RGBA8888 || tile.size() != QSize(L, L)){
+        return false;
+    }
+
+    const int idxX = (tileIndex.x() - tileMinIndex.x()) * L;
+    const int idxY = (tileIndex.y() - tileMinIndex.y()) * L;
+    if(idxX < 0 || idxY < 0 || idxX + L > mapWidth || idxY + L > mapHeight){
+        return false;
+    }
+
+    // Same format and no scaling, a plain copy of the rows is all QPainter would do
+    const qsizetype rowBytes = static_cast<qsizetype>(L) * 4;
+    for(int row = 0; row < L; row++){
+        memcpy(mapTextureImage.scanLine(idxY + row) + static_cast<qsizetype>(idxX) * 4, tile.constScanLine(row), rowBytes);
+    }
+    return true;
+}
+
+QByteArray MapTileQuery::MapTileContainer_s::getMapData() const
+{
+    QMutexLocker locker(&mutex);
+    return QByteArray(reinterpret_cast<const char*>(mapTextureImage.constBits()), mapTextureImage.sizeInBytes());
+}
+
 MapTileQuery::MapTileQuery(QObject *parent)
     : QObject{parent}
 {
+    _networkManager = new QNetworkAccessManager(this);
+    _networkManager->setTransferTimeout(9000);
+    _compositePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+MapTileQuery::~MapTileQuery()
+{
+    // Worker threads still reference the texture
+    _compositePool.waitForDone();
 }
 
 void MapTileQuery::loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint tileMaxIndex)
 {
+    cancelTiles();
+
     _mapTilesLoadStat = RequestStat::STARTED;
-    _mapToBeLoaded.clear();
-    _mapToBeLoaded.zoomLevel = zoomLevel;
-    _mapToBeLoaded.tileMinIndex = tileMinIndex;
-    _mapToBeLoaded.tileMaxIndex = tileMaxIndex;
-    _mapToBeLoaded.init();
+    _mapToBeLoaded.init(zoomLevel, tileMinIndex, tileMaxIndex);
 
     for (int x = tileMinIndex.x(); x <= tileMaxIndex.x(); x++) {
         for (int y = tileMinIndex.y(); y <= tileMaxIndex.y(); y++) {
-            QString tileKey = getTileKey(_mapId, x, y, zoomLevel);
-            _mapToBeLoaded.tileList.append(tileKey);
-            Viewer3DTileReply* _reply = new Viewer3DTileReply(zoomLevel, x, y, _mapId, this);
-            connect(_reply, &Viewer3DTileReply::tileDone, this, &MapTileQuery::tileDone);
-            connect(_reply, &Viewer3DTileReply::tileGiveUp, this, &MapTileQuery::tileGiveUp);
-            connect(_reply, &Viewer3DTileReply::tileEmpty, this, &MapTileQuery::tileEmpty);
+            _tileQueue.enqueue(QPoint(x, y));
+            _pendingTiles.insert(tileKey(x, y));
         }
     }
-    totalTilesCount = _mapToBeLoaded.tileList.size();
+    totalTilesCount = _pendingTiles.size();
     downloadedTilesCount = 0;
-    qDebug() << totalTilesCount << "Tiles to be downloaded!!";
+    qCDebug(Viewer3DTileQueryLog) << totalTilesCount << "tiles to be loaded at zoom level" << zoomLevel;
+
+    startTiles();
+}
+
+void MapTileQuery::startTiles()
+{
+    while(!_tileQueue.isEmpty() && _activeReplies.size() < kMaxConcurrentTiles){
+        const QPoint tileIndex = _tileQueue.dequeue();
+        Viewer3DTileReply* _reply = new Viewer3DTileReply(_mapToBeLoaded.zoomLevel, tileIndex.x(), tileIndex.y(), _mapId, _networkManager, this);
+        connect(_reply, &Viewer3DTileReply::tileDone, this, &MapTileQuery::tileDone);
+        connect(_reply, &Viewer3DTileReply::tileGiveUp, this, &MapTileQuery::tileGiveUp);
+        connect(_reply, &Viewer3DTileReply::tileEmpty, this, &MapTileQuery::tileEmpty);
+        _activeReplies.insert(_reply);
+    }
+}
+
+void MapTileQuery::cancelTiles()
+{
+    for(Viewer3DTileReply* reply : std::as_const(_activeReplies)){
+        disconnect(reply, nullptr, this, nullptr);
+        reply->deleteLater();
+    }
+    _activeReplies.clear();
+    _tileQueue.clear();
+    _pendingTiles.clear();
+}
+
+void MapTileQuery::finishReply(Viewer3DTileReply* reply)
+{
+    if(!reply){
+        return;
+    }
+    disconnect(reply, nullptr, this, nullptr);
+    (void) _activeReplies.remove(reply);
+    reply->deleteLater();
 }
 
 MapTileQuery::TileStatistics_t MapTileQuery::findAndLoadMapTiles(int zoomLevel, QGeoCoordinate coordinate_1, QGeoCoordinate coordinate_2)
@@ -176,58 +275,72 @@ QGeoCoordinate MapTileQuery::pixelXYToLatLong(QPoint pixel, int zoomLevel)
 
 void MapTileQuery::tileDone(Viewer3DTileReply::tileInfo_t _tileData)
 {
-    Viewer3DTileReply* reply = qobject_cast<Viewer3DTileReply*>(QObject::sender());
+    finishReply(qobject_cast<Viewer3DTileReply*>(QObject::sender()));
+
+    if(_tileData.zoomLevel == _mapToBeLoaded.zoomLevel && _pendingTiles.contains(tileKey(_tileData.x, _tileData.y))){
+        const QPoint tileIndex(_tileData.x, _tileData.y);
+        const int tileGeneration = _mapToBeLoaded.generation;
+        const int L = _mapToBeLoaded.L;
+        const QByteArray data = _tileData.data;
+        (void) QtConcurrent::run(&_compositePool, [this, tileIndex, tileGeneration, L, data](){
+            const QImage tile = MapTileContainer_t::decodeTile(data, L);
+            if(tile.isNull()){
+                qCWarning(Viewer3DTileQueryLog) << "Failed to decode tile" << tileIndex;
+            }else{
+                (void) _mapToBeLoaded.setMapTile(tileIndex, tile, tileGeneration);
+            }
+            QMetaObject::invokeMethod(this, [this, tileIndex, tileGeneration](){
+                tileComposited(tileIndex, tileGeneration);
+            }, Qt::QueuedConnection);
+        });
+    }
 
-    QString tileKey = getTileKey(_tileData.mapId, _tileData.x, _tileData.y, _tileData.zoomLevel);
-    qsizetype itemRemoved = _mapToBeLoaded.tileList.removeAll(tileKey);
+    startTiles();
+}
 
-    if(itemRemoved > 0){
-        _mapToBeLoaded.currentTileIndex = QPoint(_tileData.x, _tileData.y);
-        _mapToBeLoaded.currentTileData = _tileData.data;
-        _mapToBeLoaded.currentTileStat = RequestStat::FINISHED;
-        _mapToBeLoaded.setMapTile();
-        downloadedTilesCount++;
-        emit mapTileDownloaded(100.0 * ((float) downloadedTilesCount/ (float)totalTilesCount));
+void MapTileQuery::tileComposited(QPoint tileIndex, int tileGeneration)
+{
+    if(tileGeneration == _mapToBeLoaded.generation){
+        tileFinished(tileIndex);
+    }
+}
 
-        // qDebug() << _tileData.x << _tileData.y << _tileData.zoomLevel << "tile downloaded!!!" << _mapToBeLoaded.tileList.size();
+void MapTileQuery::tileFinished(QPoint tileIndex)
+{
+    if(!_pendingTiles.remove(tileKey(tileIndex.x(), tileIndex.y()))){
+        return;
+    }
 
-        if(_mapToBeLoaded.tileList.size() == 0){
-            _mapTilesLoadStat = RequestStat::FINISHED;
-            qDebug() << "All tiles downloaded ";
-            downloadedTilesCount = totalTilesCount;
-            emit loadingMapCompleted();
-        }
+    downloadedTilesCount++;
+    emit mapTileDownloaded(100.0 * ((float) downloadedTilesCount/ (float)totalTilesCount));
 
+    if(_pendingTiles.isEmpty() && _mapTilesLoadStat == RequestStat::STARTED){
+        _mapTilesLoadStat = RequestStat::FINISHED;
+        qCDebug(Viewer3DTileQueryLog) << "All tiles loaded";
+        emit loadingMapCompleted();
     }
-    disconnect(reply, &Viewer3DTileReply::tileDone, this, &MapTileQuery::tileDone);
-    disconnect(reply, &Viewer3DTileReply::tileGiveUp, this, &MapTileQuery::tileGiveUp);
-    disconnect(reply, &Viewer3DTileReply::tileEmpty, this, &MapTileQuery::tileEmpty);
-    reply->deleteLater();
 }
 
 void MapTileQuery::tileGiveUp(Viewer3DTileReply::tileInfo_t _tileData)
 {
-    Viewer3DTileReply* reply = qobject_cast<Viewer3DTileReply*>(QObject::sender());
-    disconnect(reply, &Viewer3DTileReply::tileDone, this, &MapTileQuery::tileDone);
-    disconnect(reply, &Viewer3DTileReply::tileGiveUp, this, &MapTileQuery::tileGiveUp);
-    disconnect(reply, &Viewer3DTileReply::tileEmpty, this, &MapTileQuery::tileEmpty);
-    reply->deleteLater();
+    finishReply(qobject_cast<Viewer3DTileReply*>(QObject::sender()));
+
+    if(_tileData.zoomLevel == _mapToBeLoaded.zoomLevel){
+        // Left gray, the rest of the texture is still worth showing
+        qCWarning(Viewer3DTileQueryLog) << "Giving up on tile" << _tileData.x << _tileData.y << _tileData.zoomLevel;
+        tileFinished(QPoint(_tileData.x, _tileData.y));
+    }
+    startTiles();
 }
 
 void MapTileQuery::tileEmpty(Viewer3DTileReply::tileInfo_t _tileData)
 {
-    Viewer3DTileReply* reply = qobject_cast<Viewer3DTileReply*>(QObject::sender());
-    disconnect(reply, &Viewer3DTileReply::tileDone, this, &MapTileQuery::tileDone);
-    disconnect(reply, &Viewer3DTileReply::tileEmpty, this, &MapTileQuery::tileEmpty);
-    reply->deleteLater();
+    finishReply(qobject_cast<Viewer3DTileReply*>(QObject::sender()));
+
     if(_tileData.zoomLevel > 0 && _tileData.zoomLevel == _zoomLevel){
         _zoomLevel -= 1;
         emit textureGeometryReady(findAndLoadMapTiles(_zoomLevel, _textureCoordinateMin, _textureCoordinateMax));
+        return;
     }
+    startTiles();
 }
-
-QString MapTileQuery::getTileKey(int mapId, int x, int y, int zoomLevel)
-{
-    return QString::asprintf("%010d%08d%08d%03d", mapId, x, y, zoomLevel);
-}
-
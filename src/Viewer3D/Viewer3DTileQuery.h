@@ -9,19 +9,27 @@
 
 #pragma once
 
-#include <QtGui/QPixmap>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
 #include <QtGui/QImage>
-#include <QtGui/QPainter>
-#include <QtCore/QDebug>
 #include <QtPositioning/QGeoCoordinate>
 
 #include "Viewer3DTileReply.h"
 
+Q_DECLARE_LOGGING_CATEGORY(Viewer3DTileQueryLog)
 
-///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
+class QNetworkAccessManager;
 
+///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
 
+/// Loads the map tiles covering a region into one texture.
+///
+/// Only a few tiles are fetched at a time, each from the map tile cache first. Downloaded tiles are decoded and
+/// copied into the texture on worker threads, so the texture fills in while the rest is still loading.
 class MapTileQuery : public QObject
 {
 
@@ -30,71 +38,28 @@ public:
     {
         int L = 256; // length of each square image downloaded tile
 
-        QList<QString> tileList;
         int zoomLevel;
         QPoint tileMinIndex;
         QPoint tileMaxIndex;
-        int currentTileStat;
-
-        QPoint currentTileIndex;
-        QByteArray currentTileData;
+        int generation = 0; // Bumped by init(), tiles decoded for an earlier layout are dropped
 
         QImage mapTextureImage;
-        // QByteArray mapTextureImageData;
         int mapWidth, mapHeight;
-        void init(){
-            mapWidth = (tileMaxIndex.x() - tileMinIndex.x() + 1) * L;
-            mapHeight = (tileMaxIndex.y() - tileMinIndex.y() + 1) * L;
-            mapTextureImage = QImage(mapWidth, mapHeight, QImage::Format_RGBA32FPx4);
-            mapTextureImage.fill(Qt::gray);
-            // mapTextureImageData.resize(mapWidth * mapHeight * 4 * 4); // 4 channnels and each 4 bytes
-            // mapTextureImageData = QByteArray((char*)mapTextureImage.bits(), mapTextureImage.sizeInBytes());
-        }
-
-        void setMapTile(){
-            QPixmap tmpPixmap;
-            tmpPixmap.loadFromData(currentTileData);
-            QImage tmpImage = tmpPixmap.toImage().convertToFormat(QImage::Format_RGBA32FPx4);
-
-            QPainter painter(&mapTextureImage);
-            int idxX = (currentTileIndex.x() - tileMinIndex.x()) * L;
-            int idxY = (currentTileIndex.y() - tileMinIndex.y()) * L;
-            painter.drawImage(idxX,
-                              idxY,
-                              tmpImage);
-
-            // int startByteIdx = idxX * mapHeight + idxY;
-            // startByteIdx = startByteIdx * 4 * 4;
-            // QByteArray tmpImageData =  QByteArray::fromRawData((const char*)tmpImage.bits(), tmpImage.sizeInBytes());
-            // memcpy(mapTextureImageData.data() + startByteIdx, tmpImageData.constData(), tmpImageData.size());
-            // mapTextureImageData.replace(startByteIdx, tmpImageData.size(), tmpImageData);
-
-            // QByteArray tmpImageData =  QByteArray::fromRawData((const char*)tmpImage.bits(), tmpImage.sizeInBytes());
-            // for(int i_x=0; i_x<tmpImageData.size(); i_x+=16){
-            //     mapTextureImageData.replace(startByteIdx, 4, tmpImageData.sliced(i_x, 4));
-            //     startByteIdx+=4;
-            //     mapTextureImageData.replace(startByteIdx, 4, tmpImageData.sliced(i_x+4, 4));
-            //     startByteIdx+=4;
-            //     mapTextureImageData.replace(startByteIdx, 4, tmpImageData.sliced(i_x+8, 4));
-            //     startByteIdx+=4;
-            //     mapTextureImageData.replace(startByteIdx, 4, tmpImageData.sliced(i_x+12, 4));
-            //     startByteIdx+=4;
-            //     // mapTextureImageData.replace(startByteIdx, 4, _alphaCh);
-            //     // startByteIdx+=4;
-            // }
-            // qDebug() << startByteIdx << mapTextureImageData.size();
-        }
-
-        QByteArray getMapData(){
-            QByteArray tmpImageData =  QByteArray::fromRawData((const char*)mapTextureImage.bits(), mapTextureImage.sizeInBytes());
-            tmpImageData.data();
-            return tmpImageData;
-            // return mapTextureImageData;
-        }
-
-        void clear(){
-            tileList.clear();
-        }
+
+        /// Sizes the texture for the tile range, filled with gray
+        void init(int zoom, const QPoint &minIndex, const QPoint &maxIndex);
+
+        /// Decodes a downloaded tile to the texture format, scaled to L x L. Thread safe.
+        static QImage decodeTile(const QByteArray &data, int L);
+
+        /// Copies a decoded tile into its place in the texture. Thread safe.
+        ///     @return false if the tile is outside the range or the texture was laid out again since
+        bool setMapTile(const QPoint &tileIndex, const QImage &tile, int tileGeneration);
+
+        /// Copy of the texture data. Thread safe.
+        QByteArray getMapData() const;
+
+        mutable QMutex mutex;
     }MapTileContainer_t;
 
     typedef struct TileStatistics_s{
@@ -108,11 +73,14 @@ public:
     Q_OBJECT
 public:
     explicit MapTileQuery(QObject *parent = nullptr);
+    ~MapTileQuery();
     void adaptiveMapTilesLoader(QString mapType, int mapId, QGeoCoordinate coordinate_1, QGeoCoordinate coordinate_2);
     int maxTileCount(int zoomLevel, QGeoCoordinate coordinateMin, QGeoCoordinate coordinateMax);
     QByteArray getMapData(){ return _mapToBeLoaded.getMapData();}
     QSize getMapSize(){ return QSize(_mapToBeLoaded.mapWidth, _mapToBeLoaded.mapHeight);}
 
+    static constexpr int kMaxConcurrentTiles = 8;
+
 private:
     int _mapTilesLoadStat;
     MapTileContainer_t _mapToBeLoaded;
@@ -122,6 +90,12 @@ private:
     QString _mapType;
     QGeoCoordinate _textureCoordinateMin, _textureCoordinateMax;
 
+    QNetworkAccessManager* _networkManager;
+    QQueue<QPoint> _tileQueue;                      // Waiting for a free download slot
+    QSet<quint64> _pendingTiles;                    // Not in the texture yet, keyed by tileKey()
+    QSet<Viewer3DTileReply*> _activeReplies;
+    QThreadPool _compositePool;
+
     void loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint tileMaxIndex);
     TileStatistics_t findAndLoadMapTiles(int zoomLevel, QGeoCoordinate coordinate_1, QGeoCoordinate coordinate_2);
     double valueClip(double n, double _minValue, double _maxValue);
@@ -132,8 +106,12 @@ private:
     void tileDone(Viewer3DTileReply::tileInfo_t _tileData);
     void tileGiveUp(Viewer3DTileReply::tileInfo_t _tileData);
     void tileEmpty(Viewer3DTileReply::tileInfo_t _tileData);
-    void httpReadyRead();
-    QString getTileKey(int mapId, int x, int y, int zoomLevel);
+    void startTiles();
+    void cancelTiles();
+    void finishReply(Viewer3DTileReply* reply);
+    void tileComposited(QPoint tileIndex, int tileGeneration);
+    void tileFinished(QPoint tileIndex);
+    static quint64 tileKey(int x, int y) { return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y); }
 
 signals:
     void loadingMapCompleted();
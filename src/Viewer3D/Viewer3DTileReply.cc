@@ -10,7 +10,11 @@
 #include "Viewer3DTileReply.h"
 
 #include <MapProvider.h>
+#include <QGCCacheTile.h>
+#include <QGCMapEngine.h>
+#include <QGCMapTasks.h>
 #include <QGCMapUrlEngine.h>
+#include <QGeoFileTileCacheQGC.h>
 #include <QGeoTileFetcherQGC.h>
 
 #include <QtCore/QFile>
@@ -20,7 +24,7 @@
 
 QByteArray  Viewer3DTileReply::_bingNoTileImage;
 
-Viewer3DTileReply::Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int mapId, QObject *parent)
+Viewer3DTileReply::Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int mapId, QNetworkAccessManager *networkManager, QObject *parent)
     : QObject{parent}
 {
     if (_bingNoTileImage.length() == 0) {
@@ -31,10 +35,9 @@ Viewer3DTileReply::Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int ma
     }
 
     _timeoutCounter = 0;
+    _reply = nullptr;
     _timeoutTimer = new QTimer(this);
-    _networkManager = new QNetworkAccessManager(this);
-    _networkManager->setTransferTimeout(9000);
-    // connect(_networkManager, &QNetworkAccessManager::finished, this, &Viewer3DTileReply::requestFinished);
+    _networkManager = networkManager;
 
     _tile.x = tileX;
     _tile.y = tileY;
@@ -42,22 +45,60 @@ Viewer3DTileReply::Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int ma
     _tile.mapId = mapId;
     _tile.data.clear();
     _mapId = mapId;
-    prepareDownload();
 
-    _timeoutTimer->start(10000);
     connect(_timeoutTimer, &QTimer::timeout, this, &Viewer3DTileReply::timeoutTimerEvent);
+
+    // The download only starts once the cache lookup failed. If the cache is not available the task errors out
+    // right away.
+    QGCFetchTileTask* task = QGeoFileTileCacheQGC::createFetchTileTask(UrlFactory::getProviderTypeFromQtMapId(_mapId), tileX, tileY, zoomLevel);
+    connect(task, &QGCFetchTileTask::tileFetched, this, &Viewer3DTileReply::cacheReply);
+    connect(task, &QGCMapTask::error, this, [this](QGCMapTask::TaskType, const QString &errorString){
+        cacheError(errorString);
+    });
+    (void) getQGCMapEngine()->addTask(task);
 }
 
 Viewer3DTileReply::~Viewer3DTileReply()
 {
-    delete _networkManager;
+    // A reply still in flight is owned by this and aborted when deleted
     delete _timeoutTimer;
 }
 
+void Viewer3DTileReply::cacheReply(QGCCacheTile *tile)
+{
+    if(!tile){
+        cacheError(QString());
+        return;
+    }
+
+    _tile.data = tile->img();
+    _tile.fromCache = true;
+    delete tile;
+    emit tileDone(_tile);
+}
+
+void Viewer3DTileReply::cacheError(const QString &errorString)
+{
+    Q_UNUSED(errorString);
+
+    if(_reply){
+        return;
+    }
+    prepareDownload();
+    _timeoutTimer->start(10000);
+}
+
 void Viewer3DTileReply::prepareDownload()
 {
+    if(_reply){
+        disconnect(_reply, nullptr, this, nullptr);
+        _reply->abort();
+        _reply->deleteLater();
+    }
+
     const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(_mapId, _tile.x, _tile.y, _tile.zoomLevel);
     _reply = _networkManager->get(request);
+    _reply->setParent(this);
     connect(_reply, &QNetworkReply::finished, this, &Viewer3DTileReply::requestFinished);
     connect(_reply, &QNetworkReply::errorOccurred, this, &Viewer3DTileReply::requestError);
 }
@@ -66,7 +107,6 @@ void Viewer3DTileReply::requestFinished()
 {
     _tile.data = _reply->readAll();
     const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromQtMapId(_tile.mapId);
-    // disconnect(_networkManager, &QNetworkAccessManager::finished, this, &Viewer3DTileReply::requestFinished);
     _timeoutTimer->stop();
     disconnect(_reply, &QNetworkReply::finished, this, &Viewer3DTileReply::requestFinished);
     disconnect(_reply, &QNetworkReply::errorOccurred, this, &Viewer3DTileReply::requestError);
@@ -82,6 +122,13 @@ void Viewer3DTileReply::requestFinished()
         emit tileEmpty(_tile);
         return;
     }
+
+    if(mapProvider && !_tile.data.isEmpty()){
+        const QString format = mapProvider->getImageFormat(_tile.data);
+        if(!format.isEmpty()){
+            QGeoFileTileCacheQGC::cacheTile(mapProvider->getMapName(), _tile.x, _tile.y, _tile.zoomLevel, _tile.data, format);
+        }
+    }
     emit tileDone(_tile);
 }
 
@@ -95,10 +142,6 @@ void Viewer3DTileReply::requestError()
 void Viewer3DTileReply::timeoutTimerEvent()
 {
     if(_timeoutCounter > 5){
-        // _timeoutCounter = 0;
-        // _networkManager->setTransferTimeout(14000);
-        // _timeoutTimer->stop();
-        // _timeoutTimer->start(15000);
         disconnect(_reply, &QNetworkReply::finished, this, &Viewer3DTileReply::requestFinished);
         disconnect(_reply, &QNetworkReply::errorOccurred, this, &Viewer3DTileReply::requestError);
         disconnect(_timeoutTimer, &QTimer::timeout, this, &Viewer3DTileReply::timeoutTimerEvent);
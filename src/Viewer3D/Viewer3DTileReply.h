@@ -11,12 +11,15 @@
 
 #include <QtCore/QObject>
 
+class QGCCacheTile;
 class QNetworkReply;
 class QNetworkAccessManager;
 class QTimer;
 
 ///     @author Omid Esrafilian <esrafilian.omid@gmail.com>
 
+/// Fetches one map tile, from the map tile cache if it is there and from the map provider otherwise. Downloaded
+/// tiles are added to the cache, so the next time the same area is shown it comes from disk.
 class Viewer3DTileReply : public QObject
 {
 public:
@@ -25,11 +28,13 @@ public:
         int x, y, zoomLevel;
         QByteArray data;
         int mapId;
+        bool fromCache = false;
     } tileInfo_t;
 
     Q_OBJECT
 public:
-    explicit Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int mapId, QObject *parent = nullptr);
+    /// @param networkManager Shared by all the tiles of a query, the reply does not take ownership
+    explicit Viewer3DTileReply(int zoomLevel, int tileX, int tileY, int mapId, QNetworkAccessManager *networkManager, QObject *parent = nullptr);
     ~Viewer3DTileReply();
 
 private:
@@ -42,6 +47,8 @@ private:
     int _timeoutCounter;
     static QByteArray       _bingNoTileImage;
 
+    void cacheReply(QGCCacheTile *tile);
+    void cacheError(const QString &errorString);
     void prepareDownload();
     void requestFinished();
     void requestError();
@@ -122,3 +122,40 @@ QGeoCoordinate mapLocalToGpsPoint(QVector3D local_point, QGeoCoordinate ref_gps)
 
     return out_point;
 }
+
+LocalPointProjector::LocalPointProjector(const QGeoCoordinate& ref_gps)
+{
+    double lambda = ref_gps.latitude() * DEG_TO_RAD;
+    double phi = ref_gps.longitude() * DEG_TO_RAD;
+
+    _sin_lambda = sin(lambda);
+    _cos_lambda = cos(lambda);
+    _cos_phi = cos(phi);
+    _sin_phi = sin(phi);
+
+    double N = ins_a / sqrt(1 - ins_e_sq * _sin_lambda * _sin_lambda);
+
+    _x0 = (N + ref_gps.altitude()) * _cos_lambda * _cos_phi;
+    _y0 = (N + ref_gps.altitude()) * _cos_lambda * _sin_phi;
+    _z0 = (ref_gps.altitude() + (1 - ins_e_sq) * N) * _sin_lambda;
+}
+
+QVector3D LocalPointProjector::map(double latitude, double longitude, double altitude) const
+{
+    double lat_rad = latitude * DEG_TO_RAD;
+    double lon_rad = longitude * DEG_TO_RAD;
+    double cos_lat = cos(lat_rad);
+    double sin_lat = sin(lat_rad);
+    double N = ins_a / sqrt(1 - ins_e_sq * sin_lat * sin_lat);
+
+    // Same as mapGeodeticToEcef() followed by mapEcefToEnu(), kept in double precision throughout
+    double xd = (N + altitude) * (cos_lat * cos(lon_rad)) - _x0;
+    double yd = (N + altitude) * (cos_lat * sin(lon_rad)) - _y0;
+    double zd = (altitude + (1 - ins_e_sq) * N) * sin_lat - _z0;
+
+    double xEast = -_sin_phi * xd + _cos_phi * yd;
+    double yNorth = -_cos_phi * _sin_lambda * xd - _sin_lambda * _sin_phi * yd + _cos_lambda * zd;
+    double zUp = _cos_lambda * _cos_phi * xd + _cos_lambda * _sin_phi * yd + _sin_lambda * zd;
+
+    return QVector3D(xEast, yNorth, zUp);
+}
@@ -32,3 +32,16 @@ QVector3D mapGpsToLocalPoint(QGeoCoordinate gps_point_, QGeoCoordinate ref_gps);
 QVector3D mapEnuToEcef(const QVector3D &enu_point, QGeoCoordinate& ref_gps);
 QGeoCoordinate mapEcefToGeodetic(const QVector3D &enu_point);
 QGeoCoordinate mapLocalToGpsPoint(QVector3D local_point, QGeoCoordinate ref_gps);
+
+/// mapGpsToLocalPoint() for many points around the same reference, with the reference terms computed once
+class LocalPointProjector
+{
+public:
+    explicit LocalPointProjector(const QGeoCoordinate& ref_gps);
+
+    QVector3D map(double latitude, double longitude, double altitude = 0) const;
+
+private:
+    double _sin_lambda, _cos_lambda, _sin_phi, _cos_phi;
+    double _x0, _y0, _z0;
+};
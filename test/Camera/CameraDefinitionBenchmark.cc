@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraDefinitionBenchmark.h"
+#include "CameraDefinitionTest.h"
+#include "CameraDefinition.h"
+#include "CameraRuleTable.h"
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+QByteArray CameraDefinitionBenchmark::_scaledDefinition(int copies)
+{
+    const QByteArray example = CameraDefinitionTest::exampleDefinition();
+    const qsizetype start = example.indexOf("<parameters>") + qstrlen("<parameters>");
+    const qsizetype end = example.indexOf("</parameters>");
+    const QByteArray parameters = example.mid(start, end - start);
+
+    QByteArray scaled = example.left(start);
+    for (int i = 0; i < copies; i++) {
+        // Renames every parameter, including the ones referenced by exclusions, ranges and conditions
+        scaled += QByteArray(parameters).replace("CAM_", "CAM" + QByteArray::number(i) + "_");
+    }
+    scaled += example.mid(end);
+    return scaled;
+}
+
+void CameraDefinitionBenchmark::_benchmarkParse(void)
+{
+    const QByteArray bytes = _scaledDefinition(kBenchmarkCopies);
+
+    CameraDefinition definition;
+    QString errorString;
+    QBENCHMARK {
+        QVERIFY(CameraDefinition::parse(bytes, QString(), definition, errorString));
+    }
+    QCOMPARE(definition.parameters.count(), 15 * kBenchmarkCopies);
+}
+
+void CameraDefinitionBenchmark::_benchmarkCachedLoad(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QByteArray bytes = _scaledDefinition(kBenchmarkCopies);
+
+    QVERIFY(CameraDefinition::load(bytes, QString(), tempDir.path(), QString()).valid);
+
+    CameraDefinition::LoadResult result;
+    QBENCHMARK {
+        result = CameraDefinition::load(bytes, QString(), tempDir.path(), QString());
+    }
+    QVERIFY(result.fromCache);
+    QCOMPARE(result.definition.parameters.count(), 15 * kBenchmarkCopies);
+}
+
+void CameraDefinitionBenchmark::_benchmarkRules(void)
+{
+    CameraDefinition definition;
+    QString errorString;
+    QVERIFY(CameraDefinition::parse(_scaledDefinition(kBenchmarkCopies), QString(), definition, errorString));
+
+    CameraRuleTable rules;
+    rules.compile(definition);
+
+    QStringList values;
+    for (int i = 0; i < rules.parameters().count(); i++) {
+        values << QStringLiteral("1");
+    }
+    const CameraRuleTable::ValueLookup valueOf = [&values](int param, QString &value) {
+        value = values[param];
+        return true;
+    };
+
+    // What a single parameter change costs: the active list and the ranges depending on the parameter
+    const int param = rules.parameterIndex(QStringLiteral("CAM0_EXPMODE"));
+    QVERIFY(param >= 0);
+    int matches = 0;
+    QBENCHMARK {
+        matches = rules.exclusions(valueOf).count();
+        for (int rangeIndex : rules.rangesFor(param)) {
+            matches += rules.evaluate(rules.ranges()[rangeIndex].condition, valueOf) ? 1 : 0;
+        }
+    }
+    QVERIFY(matches > 0);
+}
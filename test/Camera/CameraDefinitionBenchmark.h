@@ -0,0 +1,29 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Parse, cached load and rule evaluation time of a large camera definition. Only run when requested with --unittest:CameraDefinitionBenchmark.
+class CameraDefinitionBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkParse(void);
+    void _benchmarkCachedLoad(void);
+    void _benchmarkRules(void);
+
+private:
+    /// The example definition with its parameters repeated copies times under new names
+    static QByteArray _scaledDefinition(int copies);
+
+    static constexpr int kBenchmarkCopies = 40;
+};
@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraDefinitionTest.h"
+#include "CameraDefinition.h"
+#include "CameraRuleTable.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+QByteArray CameraDefinitionTest::exampleDefinition(void)
+{
+    QFile file(QStringLiteral(":/unittest/camera_definition_example.xml"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void CameraDefinitionTest::_testParse(void)
+{
+    const QByteArray bytes = exampleDefinition();
+    QVERIFY(!bytes.isEmpty());
+
+    CameraDefinition definition;
+    QString errorString;
+    bool wellFormed = false;
+    QVERIFY2(CameraDefinition::parse(bytes, QString(), definition, errorString, &wellFormed), qPrintable(errorString));
+    QVERIFY(wellFormed);
+
+    QCOMPARE(definition.version, 1);
+    QCOMPARE(definition.model, QStringLiteral("SD II"));
+    QCOMPARE(definition.vendor, QStringLiteral("Super Dupper Industries"));
+    QCOMPARE(definition.parameters.count(), 15);
+
+    const CameraDefinition::Parameter &mode = definition.parameters[0];
+    QCOMPARE(mode.name, QStringLiteral("CAM_MODE"));
+    QCOMPARE(mode.type, QStringLiteral("uint32"));
+    QCOMPARE(mode.description, QStringLiteral("Camera Mode"));
+    QVERIFY(mode.attributes & CameraDefinition::HasDefault);
+    QCOMPARE(mode.defaultValue, QStringLiteral("1"));
+    QVERIFY(!(mode.attributes & CameraDefinition::HasMin));
+    QCOMPARE(mode.options.count(), 2);
+    QCOMPARE(mode.options[0].exclusions, QStringList({ QStringLiteral("CAM_VIDRES"), QStringLiteral("CAM_VIDFMT"), QStringLiteral("CAM_AUDIOREC") }));
+    QCOMPARE(mode.options[1].ranges.count(), 1);
+    QCOMPARE(mode.options[1].ranges[0].targetParam, QStringLiteral("CAM_ISO"));
+    QCOMPARE(mode.options[1].ranges[0].optValues.count(), 6);
+
+    // Not xml at all
+    QVERIFY(!CameraDefinition::parse(QByteArrayLiteral("<mavlinkcamera"), QString(), definition, errorString, &wellFormed));
+    QVERIFY(!wellFormed);
+    QVERIFY(!errorString.isEmpty());
+
+    // Xml but not a camera definition
+    QVERIFY(!CameraDefinition::parse(QByteArrayLiteral("<mavlinkcamera/>"), QString(), definition, errorString, &wellFormed));
+    QVERIFY(wellFormed);
+}
+
+void CameraDefinitionTest::_testLocalization(void)
+{
+    CameraDefinition definition;
+    QString errorString;
+
+    QVERIFY(CameraDefinition::parse(exampleDefinition(), QStringLiteral("pt_BR"), definition, errorString));
+    QCOMPARE(definition.parameters[0].description, QStringLiteral("Modo de Operação"));
+    QCOMPARE(definition.parameters[0].options[0].name, QStringLiteral("Foto"));
+
+    // Falls back to the first locale of the same language
+    QVERIFY(CameraDefinition::parse(exampleDefinition(), QStringLiteral("pt_PT"), definition, errorString));
+    QCOMPARE(definition.parameters[0].description, QStringLiteral("Modo de Operação"));
+
+    QVERIFY(CameraDefinition::parse(exampleDefinition(), QStringLiteral("fr_FR"), definition, errorString));
+    QCOMPARE(definition.parameters[0].description, QStringLiteral("Camera Mode"));
+
+    // The locale is part of the cache key
+    QVERIFY(CameraDefinition::cacheKey(exampleDefinition(), QStringLiteral("pt_br")) != CameraDefinition::cacheKey(exampleDefinition(), QStringLiteral("en_us")));
+}
+
+void CameraDefinitionTest::_testCache(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheDir = tempDir.filePath(QStringLiteral("cache"));
+    const QString xmlCopy = tempDir.filePath(QStringLiteral("copy.xml"));
+    const QByteArray bytes = exampleDefinition();
+
+    const CameraDefinition::LoadResult parsed = CameraDefinition::load(bytes, QString(), cacheDir, QString(), xmlCopy);
+    QVERIFY2(parsed.valid, qPrintable(parsed.errorString));
+    QVERIFY(!parsed.fromCache);
+    QVERIFY(QFile::exists(xmlCopy));
+
+    // The same content comes from the cache, read from the xml copy this time
+    const CameraDefinition::LoadResult cached = CameraDefinition::load(QByteArray(), xmlCopy, cacheDir, QString());
+    QVERIFY(cached.valid);
+    QVERIFY(cached.fromCache);
+    QCOMPARE(cached.definition.parameters.count(), parsed.definition.parameters.count());
+    for (qsizetype i = 0; i < parsed.definition.parameters.count(); i++) {
+        const CameraDefinition::Parameter &a = parsed.definition.parameters[i];
+        const CameraDefinition::Parameter &b = cached.definition.parameters[i];
+        QCOMPARE(b.name, a.name);
+        QCOMPARE(b.attributes, a.attributes);
+        QCOMPARE(b.defaultValue, a.defaultValue);
+        QCOMPARE(b.options.count(), a.options.count());
+        for (qsizetype j = 0; j < a.options.count(); j++) {
+            QCOMPARE(b.options[j].value, a.options[j].value);
+            QCOMPARE(b.options[j].exclusions, a.options[j].exclusions);
+            QCOMPARE(b.options[j].ranges.count(), a.options[j].ranges.count());
+        }
+    }
+
+    // A changed definition is a different cache entry
+    QByteArray changed = bytes;
+    (void) changed.replace("SD II", "SD III");
+    const CameraDefinition::LoadResult changedResult = CameraDefinition::load(changed, QString(), cacheDir, QString());
+    QVERIFY(!changedResult.fromCache);
+    QCOMPARE(changedResult.definition.model, QStringLiteral("SD III"));
+
+    // A damaged entry is discarded and parsed again
+    QFile entry(QDir(cacheDir).filePath(CameraDefinition::cacheKey(bytes, QString()) + QStringLiteral(".camdef")));
+    QVERIFY(entry.open(QIODevice::ReadWrite));
+    QVERIFY(entry.resize(entry.size() / 2));
+    entry.close();
+    const CameraDefinition::LoadResult reparsed = CameraDefinition::load(bytes, QString(), cacheDir, QString());
+    QVERIFY(reparsed.valid);
+    QVERIFY(!reparsed.fromCache);
+    QVERIFY(CameraDefinition::load(bytes, QString(), cacheDir, QString()).fromCache);
+}
+
+void CameraDefinitionTest::_testRuleTable(void)
+{
+    CameraDefinition definition;
+    QString errorString;
+    QVERIFY(CameraDefinition::parse(exampleDefinition(), QString(), definition, errorString));
+
+    CameraRuleTable rules;
+    rules.compile(definition);
+
+    QHash<QString, QString> values = {
+        { QStringLiteral("CAM_MODE"), QStringLiteral("0") },
+        { QStringLiteral("CAM_EXPMODE"), QStringLiteral("0") },
+    };
+    const CameraRuleTable::ValueLookup valueOf = [&rules, &values](int param, QString &value) {
+        const auto it = values.constFind(rules.parameters()[param]);
+        if (it == values.constEnd()) {
+            return false;
+        }
+        value = it.value();
+        return true;
+    };
+
+    // Photo mode, auto exposure
+    QStringList excluded = rules.exclusions(valueOf);
+    QVERIFY(excluded.contains(QStringLiteral("CAM_VIDRES")));
+    QVERIFY(excluded.contains(QStringLiteral("CAM_ISO")));
+    QVERIFY(!excluded.contains(QStringLiteral("CAM_EV")));
+    QVERIFY(!excluded.contains(QStringLiteral("CAM_PHOTOFMT")));
+
+    // Video mode, manual exposure
+    values[QStringLiteral("CAM_MODE")] = QStringLiteral("1");
+    values[QStringLiteral("CAM_EXPMODE")] = QStringLiteral("1");
+    excluded = rules.exclusions(valueOf);
+    QVERIFY(excluded.contains(QStringLiteral("CAM_PHOTOFMT")));
+    QVERIFY(excluded.contains(QStringLiteral("CAM_EV")));
+    QVERIFY(!excluded.contains(QStringLiteral("CAM_ISO")));
+
+    // The video resolution ranges depend on the exposure mode through their condition
+    const QList<int> expModeRanges = rules.rangesFor(rules.parameterIndex(QStringLiteral("CAM_EXPMODE")));
+    QVERIFY(!expModeRanges.isEmpty());
+    for (int rangeIndex : expModeRanges) {
+        const CameraRuleTable::Range &range = rules.ranges()[rangeIndex];
+        QCOMPARE(rules.parameters()[range.target], QStringLiteral("CAM_SHUTTERSPD"));
+        QVERIFY(rules.evaluate(range.condition, valueOf));
+    }
+    values[QStringLiteral("CAM_EXPMODE")] = QStringLiteral("0");
+    QVERIFY(!rules.evaluate(rules.ranges()[expModeRanges[0]].condition, valueOf));
+
+    // Left to right, AND and OR with equal precedence
+    QVERIFY(rules.evaluate(rules.addCondition(QStringLiteral("CAM_MODE=0 OR CAM_MODE=1")), valueOf));
+    QVERIFY(rules.evaluate(rules.addCondition(QStringLiteral("CAM_MODE!=0 AND CAM_EXPMODE<1")), valueOf));
+    QVERIFY(!rules.evaluate(rules.addCondition(QStringLiteral("CAM_MODE=1 AND CAM_EXPMODE>0")), valueOf));
+    QVERIFY(rules.evaluate(rules.addCondition(QString()), valueOf));
+
+    // Unknown parameters and malformed tests fail
+    QVERIFY(!rules.evaluate(rules.addCondition(QStringLiteral("CAM_NOPE=1")), valueOf));
+    QVERIFY(!rules.evaluate(rules.addCondition(QStringLiteral("CAM_MODE")), valueOf));
+}
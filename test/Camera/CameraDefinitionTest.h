@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class CameraDefinitionTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    static QByteArray exampleDefinition(void);
+
+private slots:
+    void _testParse(void);
+    void _testLocalization(void);
+    void _testCache(void);
+    void _testRuleTable(void);
+};
@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraParamSchedulerTest.h"
+#include "CameraParamScheduler.h"
+#include "MAVLinkLib.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QTimer>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+void CameraParamSchedulerTest::init(void)
+{
+    UnitTest::init();
+
+    _camera = FakeCamera();
+
+    CameraParamScheduler::Sender sender;
+    sender.requestList = [this]() {
+        _camera.listRequests++;
+        // Streamed back a little later, like a camera on a real link
+        CameraParamScheduler *scheduler = _scheduler;
+        for (const QString &param : std::as_const(_camera.params)) {
+            if (!_camera.listDrops.contains(param)) {
+                QTimer::singleShot(5, scheduler, [scheduler, param]() { scheduler->valueReceived(param); });
+            }
+        }
+    };
+    sender.requestRead = [this](const QString &param) {
+        _camera.reads << param;
+        if (_camera.answerReads) {
+            CameraParamScheduler *scheduler = _scheduler;
+            QTimer::singleShot(5, scheduler, [scheduler, param]() { scheduler->valueReceived(param); });
+        }
+    };
+    sender.write = [this](const QString &param) {
+        _camera.writes << param;
+        _camera.writeTimes << QDateTime::currentMSecsSinceEpoch();
+    };
+
+    _scheduler = new CameraParamScheduler(sender, this);
+    _scheduler->setReadTimeout(100);
+    _scheduler->setWriteTimeout(100);
+    _scheduler->setListQuietTime(50);
+    _scheduler->setWriteInterval(0);
+}
+
+void CameraParamSchedulerTest::cleanup(void)
+{
+    delete _scheduler;
+    _scheduler = nullptr;
+
+    UnitTest::cleanup();
+}
+
+QStringList CameraParamSchedulerTest::_paramNames(int count) const
+{
+    QStringList names;
+    for (int i = 0; i < count; i++) {
+        names << QStringLiteral("CAM_P%1").arg(i);
+    }
+    return names;
+}
+
+void CameraParamSchedulerTest::_testRequestListGapFill(void)
+{
+    _camera.params = _paramNames(20);
+    _camera.listDrops = { QStringLiteral("CAM_P3"), QStringLiteral("CAM_P11"), QStringLiteral("CAM_P19") };
+
+    QSignalSpy spyRead(_scheduler, &CameraParamScheduler::readComplete);
+    _scheduler->requestAll(_camera.params);
+    QCOMPARE(_camera.listRequests, 1);
+
+    QTRY_VERIFY(!_scheduler->busy());
+    QCOMPARE(spyRead.count(), 20);
+    for (const QList<QVariant> &args : spyRead) {
+        QVERIFY(args[1].toBool());
+    }
+
+    // Only what the list missed was requested individually
+    QCOMPARE(_camera.reads, _camera.listDrops);
+    QCOMPARE(_scheduler->readsSent(), 3);
+
+    // Already outstanding reads are not requested twice
+    _camera.answerReads = false;
+    _scheduler->requestRead(QStringLiteral("CAM_P0"));
+    _scheduler->requestRead(QStringLiteral("CAM_P0"));
+    QCOMPARE(_camera.reads.count(), 4);
+}
+
+void CameraParamSchedulerTest::_testReadWindow(void)
+{
+    // The list delivers only the last one
+    _camera.params = _paramNames(10);
+    _camera.listDrops = _camera.params.mid(0, 9);
+    _camera.answerReads = false;
+    _scheduler->setReadWindow(3);
+    _scheduler->setReadTimeout(5000);
+
+    _scheduler->requestAll(_camera.params);
+    QTRY_COMPARE(_camera.reads.count(), 3);
+    QTest::qWait(50);
+    QCOMPARE(_camera.reads.count(), 3);
+
+    // Each answer lets the next request out
+    _scheduler->valueReceived(_camera.reads[0]);
+    QTRY_COMPARE(_camera.reads.count(), 4);
+    _scheduler->valueReceived(_camera.reads[1]);
+    _scheduler->valueReceived(_camera.reads[2]);
+    QTRY_COMPARE(_camera.reads.count(), 6);
+    QCOMPARE(_camera.reads, _paramNames(6));
+}
+
+void CameraParamSchedulerTest::_testReadRetry(void)
+{
+    _camera.params = _paramNames(2);
+    _camera.listDrops = _camera.params;
+    _camera.answerReads = false;
+    _scheduler->setMaxRetries(2);
+
+    QSignalSpy spyRead(_scheduler, &CameraParamScheduler::readComplete);
+    _scheduler->requestAll(_camera.params);
+
+    QTRY_COMPARE_WITH_TIMEOUT(spyRead.count(), 2, 2000);
+    for (const QList<QVariant> &args : spyRead) {
+        QVERIFY(!args[1].toBool());
+    }
+    // First request plus two retries each
+    QCOMPARE(_camera.reads.count(), 6);
+    QVERIFY(!_scheduler->busy());
+}
+
+void CameraParamSchedulerTest::_testWriteCoalescing(void)
+{
+    _scheduler->setWriteWindow(1);
+    _scheduler->setWriteTimeout(5000);
+
+    const QString a = QStringLiteral("CAM_A");
+    const QString b = QStringLiteral("CAM_B");
+
+    // A slider drag: goes out once, then only the last value once the first write is acknowledged
+    _scheduler->queueWrite(a);
+    QCOMPARE(_camera.writes, QStringList({ a }));
+    _scheduler->queueWrite(a);
+    _scheduler->queueWrite(a);
+    _scheduler->queueWrite(a);
+
+    // Waits for the window, a second change to it is folded in
+    _scheduler->queueWrite(b);
+    _scheduler->queueWrite(b);
+    QCOMPARE(_scheduler->writesCoalesced(), 1);
+    QCOMPARE(_camera.writes.count(), 1);
+
+    QSignalSpy spyWrite(_scheduler, &CameraParamScheduler::writeComplete);
+    QVERIFY(_scheduler->ackReceived(a, PARAM_ACK_ACCEPTED));
+    QCOMPARE(spyWrite.count(), 1);
+    QCOMPARE(_camera.writes, QStringList({ a, b }));
+
+    QVERIFY(_scheduler->ackReceived(b, PARAM_ACK_ACCEPTED));
+    QCOMPARE(_camera.writes, QStringList({ a, b, a }));
+    QVERIFY(_scheduler->ackReceived(a, PARAM_ACK_ACCEPTED));
+    QCOMPARE(spyWrite.count(), 3);
+    QVERIFY(!_scheduler->busy());
+    QCOMPARE(_scheduler->writesSent(), 3);
+}
+
+void CameraParamSchedulerTest::_testWriteRateLimit(void)
+{
+    constexpr int kInterval = 40;
+    _scheduler->setWriteInterval(kInterval);
+    _scheduler->setWriteWindow(10);
+    _scheduler->setWriteTimeout(5000);
+
+    const QStringList params = _paramNames(5);
+    for (const QString &param : params) {
+        _scheduler->queueWrite(param);
+    }
+    QCOMPARE(_camera.writes.count(), 1);
+
+    QTRY_COMPARE(_camera.writes.count(), 5);
+    QCOMPARE(_camera.writes, params);
+    for (qsizetype i = 1; i < _camera.writeTimes.count(); i++) {
+        // Allow for the millisecond granularity of the two clocks
+        QVERIFY(_camera.writeTimes[i] - _camera.writeTimes[i - 1] >= kInterval - 2);
+    }
+}
+
+void CameraParamSchedulerTest::_testWriteRetry(void)
+{
+    _scheduler->setMaxRetries(2);
+    _scheduler->setWriteTimeout(5000);
+
+    const QString param = QStringLiteral("CAM_A");
+    QSignalSpy spyWrite(_scheduler, &CameraParamScheduler::writeComplete);
+
+    // Failures are resent right away
+    _scheduler->queueWrite(param);
+    QVERIFY(!_scheduler->ackReceived(param, PARAM_ACK_FAILED));
+    QCOMPARE(_camera.writes.count(), 2);
+    QVERIFY(!_scheduler->ackReceived(param, PARAM_ACK_FAILED));
+    QCOMPARE(_camera.writes.count(), 3);
+
+    // In progress keeps waiting
+    QVERIFY(!_scheduler->ackReceived(param, PARAM_ACK_IN_PROGRESS));
+    QCOMPARE(_camera.writes.count(), 3);
+
+    QVERIFY(_scheduler->ackReceived(param, PARAM_ACK_FAILED));
+    QCOMPARE(spyWrite.count(), 1);
+    QVERIFY(!spyWrite[0][1].toBool());
+
+    // Unsupported values are not retried
+    _scheduler->queueWrite(param);
+    QVERIFY(_scheduler->ackReceived(param, PARAM_ACK_VALUE_UNSUPPORTED));
+    QCOMPARE(_camera.writes.count(), 4);
+
+    // No answer at all
+    _scheduler->setWriteTimeout(50);
+    _scheduler->queueWrite(param);
+    QTRY_COMPARE_WITH_TIMEOUT(spyWrite.count(), 3, 2000);
+    QVERIFY(!spyWrite[2][1].toBool());
+    QCOMPARE(_camera.writes.count(), 7);
+}
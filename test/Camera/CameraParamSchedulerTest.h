@@ -0,0 +1,47 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class CameraParamScheduler;
+
+class CameraParamSchedulerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init(void) override;
+    void cleanup(void) override;
+
+    void _testRequestListGapFill(void);
+    void _testReadWindow(void);
+    void _testReadRetry(void);
+    void _testWriteCoalescing(void);
+    void _testWriteRateLimit(void);
+    void _testWriteRetry(void);
+
+private:
+    /// Camera side of the protocol, answering only what the test allows through
+    struct FakeCamera {
+        QStringList params;
+        QStringList listDrops;      ///< Not sent in response to the request list
+        bool        answerReads     = true;
+        int         listRequests    = 0;
+        QStringList reads;
+        QStringList writes;
+        QList<qint64> writeTimes;
+    };
+
+    QStringList _paramNames(int count) const;
+
+    FakeCamera              _camera;
+    CameraParamScheduler*   _scheduler = nullptr;
+};
@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarmBenchmark.h"
+#include "MAVLinkProtocol.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "QmlObjectListModel.h"
+
+#include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtTest/QTest>
+
+namespace {
+
+/// Resident memory in bytes, 0 where it can not be read
+qint64 residentBytes()
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith("VmRSS:")) {
+            return line.mid(6).trimmed().split(' ').constFirst().toLongLong() * 1024;
+        }
+    }
+    return 0;
+}
+
+/// Wall time the GUI thread spends processing events instead of waiting for them
+class GuiThreadLoad
+{
+public:
+    GuiThreadLoad()
+    {
+        QAbstractEventDispatcher *const dispatcher = QAbstractEventDispatcher::instance();
+        _connections << QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, dispatcher, [this]() {
+            _busyNs += _awake.nsecsElapsed();
+            _blocked = true;
+        });
+        _connections << QObject::connect(dispatcher, &QAbstractEventDispatcher::awake, dispatcher, [this]() {
+            if (_blocked) {
+                _awake.start();
+                _blocked = false;
+            }
+        });
+        _awake.start();
+    }
+
+    ~GuiThreadLoad()
+    {
+        for (const QMetaObject::Connection &connection : std::as_const(_connections)) {
+            (void) QObject::disconnect(connection);
+        }
+    }
+
+    qint64 busyMs() const { return _busyNs / 1000000; }
+
+private:
+    QList<QMetaObject::Connection> _connections;
+    QElapsedTimer _awake;
+    qint64 _busyNs = 0;
+    bool _blocked = false;
+};
+
+}
+
+void MockLinkSwarmBenchmark::_addSystemCounts()
+{
+    QTest::addColumn<int>("systemCount");
+
+    QTest::newRow("10 systems")     << 10;
+    QTest::newRow("25 systems")     << 25;
+    QTest::newRow("50 systems")     << 50;
+}
+
+bool MockLinkSwarmBenchmark::_measure(int systemCount, Measurement &measurement)
+{
+    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
+
+    MockLinkSwarm::Config config;
+    config.systemCount = systemCount;
+    config.adsbTargets = systemCount * 20;
+    MockLink* const mockLink = MockLink::startSwarmMockLink(config);
+    if (!mockLink) {
+        return false;
+    }
+    if (!QTest::qWaitFor([vehicles, systemCount]() { return vehicles->count() == systemCount + 1; }, 20000)) {
+        mockLink->disconnect();
+        return false;
+    }
+
+    // Let the initial connect traffic settle a little
+    QTest::qWait(1000);
+
+    int messages = 0;
+    const QMetaObject::Connection counter = connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this, [&messages]() {
+        messages++;
+    });
+    {
+        const GuiThreadLoad load;
+        QTest::qWait(kMeasureMs);
+        measurement.guiBusyMs = load.busyMs();
+    }
+    (void) disconnect(counter);
+    measurement.messages = messages;
+    measurement.residentBytes = residentBytes();
+
+    mockLink->disconnect();
+    return QTest::qWaitFor([vehicles]() { return vehicles->count() == 0; }, 20000) && (messages > 0);
+}
+
+void MockLinkSwarmBenchmark::_benchmarkMessages_data()
+{
+    _addSystemCounts();
+}
+
+void MockLinkSwarmBenchmark::_benchmarkMessages()
+{
+    QFETCH(int, systemCount);
+
+    Measurement measurement;
+    QVERIFY(_measure(systemCount, measurement));
+
+    QTest::setBenchmarkResult(measurement.messages, QTest::Events);
+}
+
+void MockLinkSwarmBenchmark::_benchmarkGuiThreadBusy_data()
+{
+    _addSystemCounts();
+}
+
+void MockLinkSwarmBenchmark::_benchmarkGuiThreadBusy()
+{
+    QFETCH(int, systemCount);
+
+    Measurement measurement;
+    QVERIFY(_measure(systemCount, measurement));
+
+    QTest::setBenchmarkResult(measurement.guiBusyMs, QTest::WalltimeMilliseconds);
+}
+
+void MockLinkSwarmBenchmark::_benchmarkResidentMemory_data()
+{
+    _addSystemCounts();
+}
+
+void MockLinkSwarmBenchmark::_benchmarkResidentMemory()
+{
+    QFETCH(int, systemCount);
+
+    Measurement measurement;
+    QVERIFY(_measure(systemCount, measurement));
+    if (measurement.residentBytes == 0) {
+        QSKIP("Resident memory not available");
+    }
+
+    QTest::setBenchmarkResult(measurement.residentBytes, QTest::BytesAllocated);
+}
@@ -0,0 +1,39 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Message rate, GUI thread load and memory with large simulated swarms.
+/// Only run when requested with --unittest:MockLinkSwarmBenchmark.
+class MockLinkSwarmBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkMessages_data();
+    void _benchmarkMessages();
+    void _benchmarkGuiThreadBusy_data();
+    void _benchmarkGuiThreadBusy();
+    void _benchmarkResidentMemory_data();
+    void _benchmarkResidentMemory();
+
+private:
+    struct Measurement {
+        int     messages        = 0;    ///< Received during kMeasureMs
+        qint64  guiBusyMs       = 0;    ///< Time the GUI thread spent processing events during kMeasureMs
+        qint64  residentBytes   = 0;    ///< At the end of the measurement, 0 where it can not be read
+    };
+
+    void _addSystemCounts();
+    bool _measure(int systemCount, Measurement &measurement);
+
+    static constexpr int kMeasureMs = 3000;
+};
@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarmTest.h"
+#include "ADSBVehicleManager.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "QmlObjectListModel.h"
+#include "Vehicle.h"
+
+#include <QtCore/QPointer>
+#include <QtTest/QTest>
+
+namespace {
+
+MockLinkSwarm::Config swarmConfig(int systemCount, int adsbTargets)
+{
+    MockLinkSwarm::Config config;
+    config.systemCount = systemCount;
+    config.adsbTargets = adsbTargets;
+    return config;
+}
+
+}
+
+void MockLinkSwarmTest::_testSwarm()
+{
+    MockLinkSwarm::Config config = swarmConfig(3, 20);
+    config.lossPercent = 20;
+    config.latencyMs = 50;
+    config.latencyJitterMs = 50;
+
+    QPointer<MockLink> mockLink = MockLink::startSwarmMockLink(config);
+    QVERIFY(mockLink);
+    QVERIFY(mockLink->swarm());
+
+    // The vehicle itself and the three simulated ones
+    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
+    QTRY_COMPARE_WITH_TIMEOUT(vehicles->count(), 4, 10000);
+
+    // The simulated systems answer enough for the initial connect sequence to finish
+    for (int i = 0; i < vehicles->count(); i++) {
+        Vehicle* const vehicle = qobject_cast<Vehicle*>(vehicles->get(i));
+        QTRY_VERIFY_WITH_TIMEOUT(vehicle->isInitialConnectComplete(), 30000);
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(ADSBVehicleManager::instance()->adsbVehicles()->count() >= 20, 5000);
+
+    // Roughly a fifth is lost
+    const double sent = mockLink->swarm()->messagesSent();
+    const double dropped = mockLink->swarm()->messagesDropped();
+    QVERIFY(sent > 100);
+    QVERIFY(qAbs((dropped / (sent + dropped)) - 0.2) < 0.1);
+
+    mockLink->disconnect();
+    QTRY_COMPARE_WITH_TIMEOUT(vehicles->count(), 0, 10000);
+    QTRY_VERIFY_WITH_TIMEOUT(!mockLink, 10000);
+}
+
+void MockLinkSwarmTest::_testSystemIdReuse()
+{
+    // Each round takes three swarms worth of ids, more than the 127 below the MockLink vehicles over all rounds
+    constexpr int kSystemCount = 20;
+    constexpr int kRounds = 4;
+
+    for (int round = 0; round < kRounds; round++) {
+        QPointer<MockLink> first = MockLink::startSwarmMockLink(swarmConfig(kSystemCount, 0));
+        QPointer<MockLink> second = MockLink::startSwarmMockLink(swarmConfig(kSystemCount, 0));
+        QVERIFY(first && second);
+        QCOMPARE(first->swarm()->config().systemCount, kSystemCount);
+        QCOMPARE(first->swarm()->config().firstSystemId, 1);
+        QCOMPARE(second->swarm()->config().systemCount, kSystemCount);
+        QCOMPARE(second->swarm()->config().firstSystemId, 1 + kSystemCount);
+
+        // The ids of a torn down swarm go to the next one
+        first->disconnect();
+        QTRY_VERIFY_WITH_TIMEOUT(!first, 10000);
+        QPointer<MockLink> third = MockLink::startSwarmMockLink(swarmConfig(kSystemCount, 0));
+        QVERIFY(third);
+        QCOMPARE(third->swarm()->config().systemCount, kSystemCount);
+        QCOMPARE(third->swarm()->config().firstSystemId, 1);
+
+        second->disconnect();
+        third->disconnect();
+        QTRY_VERIFY_WITH_TIMEOUT(!second && !third, 10000);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->vehicles()->count(), 0, 10000);
+}
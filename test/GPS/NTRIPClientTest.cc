@@ -0,0 +1,275 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "NTRIPClientTest.h"
+#include "NTRIPClient.h"
+#include "RTCMLinkQueue.h"
+#include "RTCMParser.h"
+
+#include <QtCore/QFile>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include <iterator>
+
+namespace {
+
+/// Frames in ntrip_recording.rtcm3: four epochs of 1005, 1077, 1087, 1097, 1127, 1230 and 1019
+constexpr int kRecordedFrames = 28;
+constexpr int kRecordedTypes[] = { 1005, 1077, 1087, 1097, 1127, 1230, 1019 };
+
+/// Stand-in caster which serves a recording to every client and remembers what the clients sent
+class TestCaster : public QTcpServer
+{
+public:
+    enum Mode {
+        Version1,
+        Version2,
+        Version2Chunked
+    };
+
+    TestCaster(Mode mode, const QByteArray &recording)
+        : _mode(mode)
+        , _recording(recording)
+    {
+        (void) connect(this, &QTcpServer::newConnection, this, &TestCaster::_newConnection);
+    }
+
+    bool closeAfterServing = false;
+    int connectionCount = 0;
+    QByteArray request;         ///< Of the latest connection
+    QByteArray received;        ///< Everything sent after the request
+
+private:
+    void _newConnection()
+    {
+        QTcpSocket *const socket = nextPendingConnection();
+        connectionCount++;
+        request.clear();
+        received.clear();
+
+        (void) connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        (void) connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            const bool served = request.endsWith("\r\n\r\n");
+            if (served) {
+                received.append(socket->readAll());
+                return;
+            }
+
+            request.append(socket->readAll());
+            const qsizetype requestEnd = request.indexOf("\r\n\r\n");
+            if (requestEnd < 0) {
+                return;
+            }
+            received = request.mid(requestEnd + 4);
+            request.truncate(requestEnd + 4);
+
+            _serve(socket);
+        });
+    }
+
+    void _serve(QTcpSocket *socket)
+    {
+        switch (_mode) {
+        case Version1:
+            (void) socket->write("ICY 200 OK\r\n");
+            (void) socket->write(_recording);
+            break;
+        case Version2:
+            (void) socket->write("HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nContent-Type: gnss/data\r\n\r\n");
+            (void) socket->write(_recording);
+            break;
+        case Version2Chunked:
+            (void) socket->write("HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nTransfer-Encoding: chunked\r\n\r\n");
+            // Odd chunk sizes so frames and chunk boundaries do not line up
+            for (qsizetype pos = 0; pos < _recording.size(); pos += 97) {
+                const QByteArray chunk = _recording.mid(pos, 97);
+                (void) socket->write(QByteArray::number(chunk.size(), 16) + "\r\n" + chunk + "\r\n");
+            }
+            break;
+        }
+
+        if (closeAfterServing) {
+            socket->disconnectFromHost();
+        }
+    }
+
+    Mode _mode;
+    QByteArray _recording;
+};
+
+NTRIPClient::Config casterConfig(const QTcpServer &caster, int version)
+{
+    NTRIPClient::Config config;
+    config.host = QStringLiteral("127.0.0.1");
+    config.port = caster.serverPort();
+    config.mountpoint = QStringLiteral("TEST");
+    config.username = QStringLiteral("user");
+    config.password = QStringLiteral("secret");
+    config.version = version;
+    return config;
+}
+
+}
+
+QByteArray NTRIPClientTest::_recording(void)
+{
+    QFile file(QStringLiteral(":/unittest/ntrip_recording.rtcm3"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void NTRIPClientTest::_testCrc(void)
+{
+    // CRC-24Q check value
+    QCOMPARE(RTCMParser::crc24q(QByteArrayView("123456789")), 0xCDE703U);
+    QCOMPARE(RTCMParser::crc24q(QByteArrayView()), 0U);
+}
+
+void NTRIPClientTest::_testParser(void)
+{
+    const QByteArray recording = _recording();
+    QVERIFY(!recording.isEmpty());
+
+    // Whole recording at once
+    RTCMParser parser;
+    QList<QByteArray> frames = parser.addData(recording);
+    QCOMPARE(frames.count(), kRecordedFrames);
+    QCOMPARE(frames.join(), recording);
+    for (int i = 0; i < frames.count(); i++) {
+        QCOMPARE(RTCMLinkQueue::messageType(frames[i]), kRecordedTypes[i % std::size(kRecordedTypes)]);
+    }
+
+    // Leading garbage, a corrupted frame and pieces of every size
+    QByteArray stream = QByteArray("\xD3\x00garbage\xD3\xFF", 11) + recording;
+    const qsizetype corrupt = 11 + 3 + 19 + 3 + 10;     // Payload of the first 1077
+    stream[corrupt] = static_cast<char>(stream[corrupt] ^ 0x55);
+
+    parser = RTCMParser();
+    frames.clear();
+    qsizetype pos = 0;
+    for (int pieceSize = 1; pos < stream.size(); pieceSize = (pieceSize % 150) + 1) {
+        frames.append(parser.addData(QByteArrayView(stream).sliced(pos, qMin<qsizetype>(pieceSize, stream.size() - pos))));
+        pos += pieceSize;
+    }
+    QCOMPARE(frames.count(), kRecordedFrames - 1);
+    QCOMPARE(RTCMLinkQueue::messageType(frames[0]), 1005);
+    QCOMPARE(RTCMLinkQueue::messageType(frames[1]), 1087);
+    QVERIFY(parser.crcErrors() >= 1);
+    QVERIFY(parser.bytesDiscarded() >= 11);
+
+    // Filtered by type
+    parser = RTCMParser();
+    parser.setMessageFilter({ 1005, 1077 });
+    frames = parser.addData(recording);
+    QCOMPARE(frames.count(), 8);
+    QCOMPARE(parser.framesParsed(), kRecordedFrames);
+    QCOMPARE(parser.framesFiltered(), kRecordedFrames - 8);
+}
+
+void NTRIPClientTest::_testGGA(void)
+{
+    QCOMPARE(NTRIPClient::makeGGA(QGeoCoordinate(47.5, -122.25, 100), QTime(12, 34, 56)),
+             QByteArray("$GPGGA,123456.00,4730.00000,N,12215.00000,W,1,12,1.0,100.0,M,0.0,M,,*4F\r\n"));
+
+    NTRIPClient::Config config;
+    config.host = QStringLiteral("caster.example.com");
+    config.mountpoint = QStringLiteral("MOUNT");
+    config.username = QStringLiteral("user");
+    config.password = QStringLiteral("secret");
+    const QByteArray request = NTRIPClient::makeRequest(config);
+    QVERIFY(request.startsWith("GET /MOUNT HTTP/1.1\r\n"));
+    QVERIFY(request.contains("Ntrip-Version: Ntrip/2.0\r\n"));
+    QVERIFY(request.contains("Authorization: Basic dXNlcjpzZWNyZXQ=\r\n"));
+    QVERIFY(request.endsWith("\r\n\r\n"));
+
+    config.version = 1;
+    QVERIFY(NTRIPClient::makeRequest(config).startsWith("GET /MOUNT HTTP/1.0\r\n"));
+}
+
+void NTRIPClientTest::_testCasterV1(void)
+{
+    const QByteArray recording = _recording();
+    TestCaster caster(TestCaster::Version1, recording);
+    QVERIFY(caster.listen(QHostAddress::LocalHost));
+
+    NTRIPClient client;
+    QSignalSpy spy(&client, &NTRIPClient::RTCMDataUpdate);
+    client.setPosition(QGeoCoordinate(47.5, -122.25, 100));
+    client.start(casterConfig(caster, 1));
+
+    QTRY_COMPARE(spy.count(), kRecordedFrames);
+    QCOMPARE(client.state(), NTRIPClient::State::Streaming);
+    QVERIFY(caster.request.startsWith("GET /TEST HTTP/1.0\r\n"));
+
+    QByteArray forwarded;
+    for (const QList<QVariant> &arguments : spy) {
+        forwarded.append(arguments[0].toByteArray());
+    }
+    QCOMPARE(forwarded, recording);
+
+    // Position went up as soon as the stream started
+    QTRY_VERIFY(caster.received.startsWith("$GPGGA,"));
+
+    client.stop();
+    QCOMPARE(client.state(), NTRIPClient::State::Disconnected);
+}
+
+void NTRIPClientTest::_testCasterV2Chunked(void)
+{
+    const QByteArray recording = _recording();
+    TestCaster caster(TestCaster::Version2Chunked, recording);
+    QVERIFY(caster.listen(QHostAddress::LocalHost));
+
+    NTRIPClient client;
+    QSignalSpy spy(&client, &NTRIPClient::RTCMDataUpdate);
+    NTRIPClient::Config config = casterConfig(caster, 2);
+    config.messageFilter = { 1077, 1087, 1097, 1127 };
+    client.start(config);
+
+    QTRY_COMPARE(spy.count(), 16);
+    QVERIFY(caster.request.contains("Ntrip-Version: Ntrip/2.0\r\n"));
+    QCOMPARE(client.parser().crcErrors(), 0);
+    QCOMPARE(client.parser().framesFiltered(), kRecordedFrames - 16);
+
+    // No position, so no GGA
+    QVERIFY(caster.received.isEmpty());
+}
+
+void NTRIPClientTest::_testReconnect(void)
+{
+    const QByteArray recording = _recording();
+    TestCaster caster(TestCaster::Version2, recording);
+    caster.closeAfterServing = true;
+    QVERIFY(caster.listen(QHostAddress::LocalHost));
+
+    NTRIPClient client;
+    QSignalSpy dataSpy(&client, &NTRIPClient::RTCMDataUpdate);
+    QSignalSpy errorSpy(&client, &NTRIPClient::errorOccurred);
+    client.start(casterConfig(caster, 2));
+
+    // The caster hangs up after every recording, the client comes back after the minimum delay
+    QTRY_VERIFY_WITH_TIMEOUT(caster.connectionCount >= 2, NTRIPClient::kMinReconnectDelay * 5);
+    QTRY_VERIFY(dataSpy.count() >= 2 * kRecordedFrames);
+    QVERIFY(errorSpy.count() >= 1);
+    QTRY_COMPARE(client.state(), NTRIPClient::State::WaitingToReconnect);
+    QCOMPARE(client.reconnectDelay(), NTRIPClient::kMinReconnectDelay * 2);
+
+    // Nothing listening, the delay keeps growing
+    caster.close();
+    client.stop();
+    client.start(casterConfig(caster, 2));
+    QTRY_COMPARE(client.state(), NTRIPClient::State::WaitingToReconnect);
+    QCOMPARE(client.reconnectDelay(), NTRIPClient::kMinReconnectDelay * 2);
+    client.stop();
+}
@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class NTRIPClientTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCrc(void);
+    void _testParser(void);
+    void _testGGA(void);
+    void _testCasterV1(void);
+    void _testCasterV2Chunked(void);
+    void _testReconnect(void);
+
+private:
+    static QByteArray _recording(void);
+};
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "RTCMMavlinkTest.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "QmlObjectListModel.h"
+#include "RTCMLinkQueue.h"
+#include "RTCMMavlink.h"
+
+#include <QtTest/QTest>
+
+namespace {
+
+/// RTCM3 frame of the given type, the payload is filled with the type so frames can be told apart
+QByteArray rtcmFrame(int type, int payloadLength)
+{
+    QByteArray frame(3 + payloadLength + 3, static_cast<char>(type & 0xFF));
+    frame[0] = static_cast<char>(0xD3);
+    frame[1] = static_cast<char>((payloadLength >> 8) & 0x03);
+    frame[2] = static_cast<char>(payloadLength & 0xFF);
+    frame[3] = static_cast<char>((type >> 4) & 0xFF);
+    frame[4] = static_cast<char>(((type & 0x0F) << 4) | (frame[4] & 0x0F));
+    return frame;
+}
+
+}
+
+void RTCMMavlinkTest::_testMessageType(void)
+{
+    QCOMPARE(RTCMLinkQueue::messageType(rtcmFrame(1005, 19)), 1005);
+    QCOMPARE(RTCMLinkQueue::messageType(rtcmFrame(1077, 100)), 1077);
+    QCOMPARE(RTCMLinkQueue::messageType(rtcmFrame(4095, 10)), 4095);
+    QCOMPARE(RTCMLinkQueue::messageType(QByteArray("\x01\x02\x03\x04\x05")), 0);
+    QCOMPARE(RTCMLinkQueue::messageType(QByteArray("\xD3\x00")), 0);
+
+    QCOMPARE(RTCMLinkQueue::priority(1004), 0);
+    QCOMPARE(RTCMLinkQueue::priority(1127), 0);
+    QCOMPARE(RTCMLinkQueue::priority(1006), 1);
+    QCOMPARE(RTCMLinkQueue::priority(1230), 1);
+    QCOMPARE(RTCMLinkQueue::priority(1019), 2);
+    QCOMPARE(RTCMLinkQueue::priority(0), 2);
+}
+
+void RTCMMavlinkTest::_testQueue(void)
+{
+    // Without a budget everything goes straight out
+    RTCMLinkQueue unlimited;
+    unlimited.enqueue(rtcmFrame(1077, 100), 120, 0);
+    unlimited.enqueue(rtcmFrame(1087, 100), 120, 0);
+    QCOMPARE(unlimited.take(0).count(), 2);
+    QVERIFY(unlimited.isEmpty());
+
+    // 1000 B/s saves up 500 bytes, so two messages fit and the rest waits
+    RTCMLinkQueue queue(1000);
+    queue.takeWindowStats(0);
+    queue.enqueue(rtcmFrame(1019, 60), 300, 0);     // ephemeris
+    queue.enqueue(rtcmFrame(1005, 19), 300, 0);     // station
+    queue.enqueue(rtcmFrame(1077, 100), 300, 0);    // observations
+    queue.enqueue(rtcmFrame(1087, 100), 300, 0);    // observations
+
+    QList<QByteArray> sent = queue.take(0);
+    QCOMPARE(sent.count(), 2);
+    QCOMPARE(RTCMLinkQueue::messageType(sent[0]), 1077);
+    QCOMPARE(RTCMLinkQueue::messageType(sent[1]), 1087);
+    QCOMPARE(queue.pendingCount(), 2);
+
+    // The bucket is in debt now, nothing goes out until it is paid back
+    QVERIFY(queue.take(50).isEmpty());
+
+    // A newer station message replaces the one still waiting
+    queue.enqueue(rtcmFrame(1005, 19), 300, 100);
+    QCOMPARE(queue.pendingCount(), 2);
+
+    sent = queue.take(400);
+    QCOMPARE(sent.count(), 1);
+    QCOMPARE(RTCMLinkQueue::messageType(sent[0]), 1005);
+
+    // The ephemeris waited too long
+    QVERIFY(queue.take(RTCMLinkQueue::kMaxAgeMs + 1).isEmpty());
+    QVERIFY(queue.isEmpty());
+
+    const RTCMLinkQueue::WindowStats stats = queue.takeWindowStats(4000);
+    QCOMPARE(stats.messagesSent, 3);
+    QCOMPARE(stats.messagesDropped, 2);
+    QCOMPARE(stats.bytesPerSecond, static_cast<qint64>(900 * 1000 / 4000));
+    QVERIFY(qAbs(stats.latencyMs - 100.0) < 1e-9);
+    QVERIFY(qAbs(stats.maxLatencyMs - 300.0) < 1e-9);
+
+    QCOMPARE(queue.takeWindowStats(5000).messagesSent, 0);
+}
+
+void RTCMMavlinkTest::_testQueueReplacement(void)
+{
+    QVERIFY(RTCMLinkQueue::isReplaceable(1005));
+    QVERIFY(RTCMLinkQueue::isReplaceable(1033));
+    QVERIFY(!RTCMLinkQueue::isReplaceable(1019));
+    QVERIFY(!RTCMLinkQueue::isReplaceable(1077));
+
+    QByteArray otherStation = rtcmFrame(1005, 19);
+    otherStation[5] = static_cast<char>(0x42);
+    QCOMPARE(RTCMLinkQueue::stationId(otherStation), ((0xED & 0x0F) << 8) | 0x42);
+    QCOMPARE(RTCMLinkQueue::stationId(rtcmFrame(1077, 100)), -1);
+
+    // Put the bucket in debt so that everything after waits
+    RTCMLinkQueue queue(1000);
+    queue.takeWindowStats(0);
+    queue.enqueue(rtcmFrame(1077, 100), 600, 0);
+    QCOMPARE(queue.take(0).count(), 1);
+
+    // Ephemerides of two satellites and the MSM messages of one epoch all have to get out
+    const int neverReplaced[] = { 1019, 1019, 1020, 1042, 1044, 1045, 1045, 1046, 1077, 1077, 1087 };
+    for (const int type : neverReplaced) {
+        queue.enqueue(rtcmFrame(type, 60), 1, 10);
+    }
+    QCOMPARE(queue.pendingCount(), static_cast<qsizetype>(std::size(neverReplaced)));
+
+    // Station messages are only replaced by the same type from the same station
+    queue.enqueue(rtcmFrame(1005, 19), 1, 10);
+    queue.enqueue(rtcmFrame(1005, 19), 1, 20);
+    queue.enqueue(otherStation, 1, 20);
+    queue.enqueue(rtcmFrame(1033, 40), 1, 10);
+    queue.enqueue(rtcmFrame(1033, 40), 1, 20);
+    QCOMPARE(queue.pendingCount(), static_cast<qsizetype>(std::size(neverReplaced) + 3));
+
+    QCOMPARE(queue.take(1000).count(), static_cast<qsizetype>(std::size(neverReplaced) + 3));
+    QCOMPARE(queue.takeWindowStats(1000).messagesDropped, 2);
+}
+
+void RTCMMavlinkTest::_testFanOut(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    MockLink* const secondLink = MockLink::startPX4MockLink(false);
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->vehicles()->count(), 2, 10000);
+
+    // Spans three GPS_RTCM_DATA fragments
+    const QByteArray rtcm = rtcmFrame(1077, 400);
+
+    RTCMMavlink rtcmMavlink;
+    rtcmMavlink.RTCMDataUpdate(rtcm);
+
+    const QList<RTCMMavlink::LinkStats> linkStats = rtcmMavlink.linkStats();
+    QCOMPARE(linkStats.count(), 2);
+    for (const RTCMMavlink::LinkStats &stats : linkStats) {
+        QCOMPARE(stats.vehicleCount, 1);
+        QCOMPARE(stats.budget, 0LL);
+        QCOMPARE(stats.pending, static_cast<qsizetype>(0));
+    }
+
+    QTRY_COMPARE(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 3);
+    QTRY_COMPARE(secondLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 3);
+
+    // A budgeted link holds back what does not fit while the other keeps going
+    rtcmMavlink.setLinkBudget(secondLink, 100);
+    for (int i = 0; i < 5; i++) {
+        rtcmMavlink.RTCMDataUpdate(rtcmFrame(1077 + (i * 10), 400));
+    }
+    QTRY_COMPARE(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 3 + (5 * 3));
+    QVERIFY(secondLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA) < 3 + (5 * 3));
+
+    secondLink->disconnect();
+    QTRY_COMPARE_WITH_TIMEOUT(MultiVehicleManager::instance()->vehicles()->count(), 1, 10000);
+}
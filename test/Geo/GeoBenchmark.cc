@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoBenchmark.h"
+#include "QGCGeo.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+void GeoBenchmark::initTestCase(void)
+{
+    // Points scattered up to ~50km around the origin, which covers the largest survey areas
+    QRandomGenerator random(42);
+
+    _lat.resize(_count);
+    _lon.resize(_count);
+    _alt.resize(_count);
+    _coords.reserve(_count);
+    for (int i=0; i<_count; i++) {
+        const QGeoCoordinate coord = _origin.atDistanceAndAzimuth(random.bounded(50000.0), random.bounded(360.0), random.bounded(500.0));
+        _lat[i] = coord.latitude();
+        _lon[i] = coord.longitude();
+        _alt[i] = coord.altitude();
+        _coords.append(coord);
+    }
+
+    _x.resize(_count);
+    _y.resize(_count);
+    _z.resize(_count);
+    QGCGeo::convertGeoToNed(_lat.constData(), _lon.constData(), _alt.constData(), _count, _origin, _x.data(), _y.data(), _z.data());
+}
+
+void GeoBenchmark::_benchmarkGeoToNedSingle(void)
+{
+    QList<double> x(_count), y(_count), z(_count);
+    QBENCHMARK {
+        for (int i=0; i<_count; i++) {
+            QGCGeo::convertGeoToNed(_coords[i], _origin, x[i], y[i], z[i]);
+        }
+    }
+}
+
+void GeoBenchmark::_benchmarkGeoToNedBatch(void)
+{
+    QList<double> x(_count), y(_count), z(_count);
+    QBENCHMARK {
+        QGCGeo::convertGeoToNed(_lat.constData(), _lon.constData(), _alt.constData(), _count, _origin, x.data(), y.data(), z.data());
+    }
+}
+
+void GeoBenchmark::_benchmarkGeoToNedList(void)
+{
+    QList<QPointF> points;
+    QBENCHMARK {
+        points = QGCGeo::convertGeoToNed(_coords, _origin);
+    }
+    QCOMPARE(points.count(), _count);
+}
+
+void GeoBenchmark::_benchmarkNedToGeoSingle(void)
+{
+    QGeoCoordinate coord;
+    QBENCHMARK {
+        for (int i=0; i<_count; i++) {
+            QGCGeo::convertNedToGeo(_x[i], _y[i], _z[i], _origin, coord);
+        }
+    }
+}
+
+void GeoBenchmark::_benchmarkNedToGeoBatch(void)
+{
+    QList<double> lat(_count), lon(_count), alt(_count);
+    QBENCHMARK {
+        QGCGeo::convertNedToGeo(_x.constData(), _y.constData(), _z.constData(), _count, _origin, lat.data(), lon.data(), alt.data());
+    }
+}
+
+void GeoBenchmark::_benchmarkGeoToUTMBatch(void)
+{
+    QList<double> easting(_count), northing(_count);
+    QList<int> zone(_count);
+    QBENCHMARK {
+        QCOMPARE(QGCGeo::convertGeoToUTM(_lat.constData(), _lon.constData(), _count, easting.data(), northing.data(), zone.data()), 0);
+    }
+}
@@ -0,0 +1,43 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+/// Per point and batched coordinate conversion of a large point set.
+/// Only run when requested with --unittest:GeoBenchmark.
+class GeoBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void _benchmarkGeoToNedSingle(void);
+    void _benchmarkGeoToNedBatch(void);
+    void _benchmarkGeoToNedList(void);
+    void _benchmarkNedToGeoSingle(void);
+    void _benchmarkNedToGeoBatch(void);
+    void _benchmarkGeoToUTMBatch(void);
+
+private:
+    QList<double>           _lat;
+    QList<double>           _lon;
+    QList<double>           _alt;
+    QList<double>           _x;
+    QList<double>           _y;
+    QList<double>           _z;
+    QList<QGeoCoordinate>   _coords;
+
+    static constexpr int    _count = 100000;
+
+    const QGeoCoordinate    _origin{47.3764, 8.5481, 0.0};
+};
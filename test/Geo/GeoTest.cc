@@ -16,6 +16,7 @@
 #include "GeoTest.h"
 #include "QGCGeo.h"
 
+#include <QtCore/QRandomGenerator>
 #include <QtTest/QTest>
 
 static bool compareDoubles(double actual, double expected, double epsilon = 0.00001)
@@ -138,3 +139,124 @@ void GeoTest::_convertMGRSToGeo_test()
     QVERIFY(compareDoubles(coord.longitude(), m_origin.longitude()));
     QVERIFY(compareDoubles(coord.altitude(), m_origin.altitude()));
 }
+
+void GeoTest::_randomCoords(int count, QList<double>& lat, QList<double>& lon, QList<double>& alt) const
+{
+    // Points scattered up to ~50km around the origin, which covers the largest survey areas
+    QRandomGenerator random(42);
+
+    lat.resize(count);
+    lon.resize(count);
+    alt.resize(count);
+    for (int i=0; i<count; i++) {
+        const QGeoCoordinate coord = m_origin.atDistanceAndAzimuth(random.bounded(50000.0), random.bounded(360.0), random.bounded(500.0));
+        lat[i] = coord.latitude();
+        lon[i] = coord.longitude();
+        alt[i] = coord.altitude();
+    }
+}
+
+void GeoTest::_convertGeoToNedBatch_test()
+{
+    constexpr int count = 1000;
+    QList<double> lat, lon, alt;
+    _randomCoords(count, lat, lon, alt);
+
+    // Include the origin itself to exercise the degenerate case
+    lat[0] = m_origin.latitude();
+    lon[0] = m_origin.longitude();
+    alt[0] = m_origin.altitude();
+
+    QList<double> x(count), y(count), z(count);
+    QGCGeo::convertGeoToNed(lat.constData(), lon.constData(), alt.constData(), count, m_origin, x.data(), y.data(), z.data());
+
+    for (int i=0; i<count; i++) {
+        double expectedX, expectedY, expectedZ;
+        QGCGeo::convertGeoToNed(QGeoCoordinate(lat[i], lon[i], alt[i]), m_origin, expectedX, expectedY, expectedZ);
+        QVERIFY(compareDoubles(x[i], expectedX));
+        QVERIFY(compareDoubles(y[i], expectedY));
+        QVERIFY(compareDoubles(z[i], expectedZ));
+    }
+
+    // Known point from _convertGeoToNed_test
+    const double knownLat = 47.364869;
+    const double knownLon = 8.594398;
+    double knownX, knownY;
+    QGCGeo::convertGeoToNed(&knownLat, &knownLon, nullptr, 1, m_origin, &knownX, &knownY, nullptr);
+    QVERIFY(compareDoubles(knownX, -1282.58731618));
+    QVERIFY(compareDoubles(knownY, 3490.85591324));
+}
+
+void GeoTest::_convertNedToGeoBatch_test()
+{
+    constexpr int count = 1000;
+    QList<double> lat, lon, alt;
+    _randomCoords(count, lat, lon, alt);
+
+    QList<double> x(count), y(count), z(count);
+    QGCGeo::convertGeoToNed(lat.constData(), lon.constData(), alt.constData(), count, m_origin, x.data(), y.data(), z.data());
+
+    // Include the origin itself to exercise the degenerate case
+    x[0] = y[0] = z[0] = 0;
+    lat[0] = m_origin.latitude();
+    lon[0] = m_origin.longitude();
+    alt[0] = m_origin.altitude();
+
+    QList<double> resultLat(count), resultLon(count), resultAlt(count);
+    QGCGeo::convertNedToGeo(x.constData(), y.constData(), z.constData(), count, m_origin, resultLat.data(), resultLon.data(), resultAlt.data());
+
+    for (int i=0; i<count; i++) {
+        QGeoCoordinate expected;
+        QGCGeo::convertNedToGeo(x[i], y[i], z[i], m_origin, expected);
+        QVERIFY(compareDoubles(resultLat[i], expected.latitude(), 1e-9));
+        QVERIFY(compareDoubles(resultLon[i], expected.longitude(), 1e-9));
+        QVERIFY(compareDoubles(resultAlt[i], expected.altitude()));
+
+        // Round trip back to the source coordinates
+        QVERIFY(compareDoubles(resultLat[i], lat[i], 1e-9));
+        QVERIFY(compareDoubles(resultLon[i], lon[i], 1e-9));
+        QVERIFY(compareDoubles(resultAlt[i], alt[i]));
+    }
+}
+
+void GeoTest::_convertListRoundTrip_test()
+{
+    QList<QGeoCoordinate> coords;
+    coords.append(m_origin);
+    coords.append(QGeoCoordinate(47.364869, 8.594398, 0.0));
+    coords.append(m_origin.atDistanceAndAzimuth(1000, 45));
+
+    // List form is (East, North)
+    const QList<QPointF> points = QGCGeo::convertGeoToNed(coords, m_origin);
+    QCOMPARE(points.count(), coords.count());
+    QVERIFY(compareDoubles(points[0].x(), 0));
+    QVERIFY(compareDoubles(points[0].y(), 0));
+    QVERIFY(compareDoubles(points[1].x(), 3490.85591324));
+    QVERIFY(compareDoubles(points[1].y(), -1282.58731618));
+
+    const QList<QGeoCoordinate> result = QGCGeo::convertNedToGeo(points, m_origin);
+    QCOMPARE(result.count(), coords.count());
+    for (int i=0; i<coords.count(); i++) {
+        QVERIFY(compareDoubles(result[i].latitude(), coords[i].latitude(), 1e-9));
+        QVERIFY(compareDoubles(result[i].longitude(), coords[i].longitude(), 1e-9));
+        QVERIFY(compareDoubles(result[i].altitude(), m_origin.altitude()));
+    }
+
+    QVERIFY(QGCGeo::convertGeoToNed(QList<QGeoCoordinate>(), m_origin).isEmpty());
+}
+
+void GeoTest::_convertGeoToUTMBatch_test()
+{
+    const double lat[] = { m_origin.latitude(), 91.0 /* invalid */ };
+    const double lon[] = { m_origin.longitude(), 0.0 };
+    double easting[2], northing[2];
+    int zone[2];
+
+    const qsizetype failures = QGCGeo::convertGeoToUTM(lat, lon, 2, easting, northing, zone);
+
+    QCOMPARE(failures, 1);
+    QCOMPARE(zone[0], 32);
+    QVERIFY(compareDoubles(easting[0], 465886.092246));
+    QVERIFY(compareDoubles(northing[0], 5247092.44892));
+    QCOMPARE(zone[1], 0);
+}
@@ -37,7 +37,14 @@ private slots:
     void _convertGeoToMGRS_test(void);
     void _convertMGRSToGeo_test(void);
 
+    void _convertGeoToNedBatch_test(void);
+    void _convertNedToGeoBatch_test(void);
+    void _convertListRoundTrip_test(void);
+    void _convertGeoToUTMBatch_test(void);
+
 private:
+    void _randomCoords(int count, QList<double>& lat, QList<double>& lon, QList<double>& alt) const;
+
      /// Use ETH campus (47.3764° N, 8.5481° E)
     const QGeoCoordinate m_origin{47.3764, 8.5481, 0.0};
 };
@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "JoystickBenchmark.h"
+#include "MockLink.h"
+#include "Vehicle.h"
+#include "VirtualJoystick.h"
+
+#include <QtTest/QTest>
+
+bool JoystickBenchmark::_measure(JoystickSendStats::Snapshot &stats)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    if (!_vehicle) {
+        return false;
+    }
+
+    VirtualJoystick joystick;
+    joystick.setFunctionAxis(Joystick::rollFunction,        0);
+    joystick.setFunctionAxis(Joystick::pitchFunction,       1);
+    joystick.setFunctionAxis(Joystick::yawFunction,         2);
+    joystick.setFunctionAxis(Joystick::throttleFunction,    3);
+    joystick.setAxisFrequency(100.0f);
+
+    _vehicle->setJoystickEnabled(true);
+    joystick.startPolling(_vehicle);
+
+    // Long enough for the statistics to be published once
+    QTest::qWait(1500);
+    stats = joystick.sendStats();
+
+    joystick.stopPolling();
+    joystick.stop();
+    _vehicle->setJoystickEnabled(false);
+
+    return stats.sendCount > 0;
+}
+
+void JoystickBenchmark::_benchmarkSendInterval(void)
+{
+    JoystickSendStats::Snapshot stats;
+    QVERIFY(_measure(stats));
+
+    // The target period is 10 ms
+    QTest::setBenchmarkResult(stats.meanIntervalMs, QTest::WalltimeMilliseconds);
+}
+
+void JoystickBenchmark::_benchmarkJitter(void)
+{
+    JoystickSendStats::Snapshot stats;
+    QVERIFY(_measure(stats));
+
+    QTest::setBenchmarkResult(stats.jitterMs, QTest::WalltimeMilliseconds);
+}
+
+void JoystickBenchmark::_benchmarkMaxJitter(void)
+{
+    JoystickSendStats::Snapshot stats;
+    QVERIFY(_measure(stats));
+
+    QTest::setBenchmarkResult(stats.maxJitterMs, QTest::WalltimeMilliseconds);
+}
+
+void JoystickBenchmark::_benchmarkLatency(void)
+{
+    JoystickSendStats::Snapshot stats;
+    QVERIFY(_measure(stats));
+
+    QTest::setBenchmarkResult(stats.latencyMs, QTest::WalltimeMilliseconds);
+}
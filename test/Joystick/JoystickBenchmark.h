@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "JoystickSendStats.h"
+
+/// Send interval, jitter and latency of the joystick thread at 100 Hz. Only run when requested with --unittest:JoystickBenchmark.
+class JoystickBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkSendInterval(void);
+    void _benchmarkJitter(void);
+    void _benchmarkMaxJitter(void);
+    void _benchmarkLatency(void);
+
+private:
+    bool _measure(JoystickSendStats::Snapshot &stats);
+};
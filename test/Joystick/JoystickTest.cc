@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "JoystickTest.h"
+#include "JoystickSendStats.h"
+#include "MockLink.h"
+#include "Vehicle.h"
+#include "VirtualJoystick.h"
+
+#include <QtTest/QTest>
+
+#include <cmath>
+
+void JoystickTest::_testSendStats(void)
+{
+    JoystickSendStats stats(8);
+    QCOMPARE(stats.snapshot().sendCount, 0);
+
+    // 10 ms apart except for one late send, all 1 ms after the input was read
+    stats.reset(10.0);
+    const qint64 sendNs[] = { 0, 10'000'000, 20'000'000, 33'000'000, 40'000'000 };
+    for (const qint64 ns : sendNs) {
+        stats.record(ns, 1'000'000);
+    }
+
+    JoystickSendStats::Snapshot snapshot = stats.snapshot();
+    QCOMPARE(snapshot.sendCount, 5);
+    QVERIFY(qAbs(snapshot.meanIntervalMs - 10.0) < 1e-9);
+    QVERIFY(qAbs(snapshot.rateHz - 100.0) < 1e-6);
+    QVERIFY(qAbs(snapshot.maxJitterMs - 3.0) < 1e-9);
+    // Intervals 10, 10, 13, 7
+    QVERIFY(qAbs(snapshot.jitterMs - std::sqrt(18.0 / 4.0)) < 1e-9);
+    QVERIFY(qAbs(snapshot.latencyMs - 1.0) < 1e-9);
+    QVERIFY(qAbs(snapshot.maxLatencyMs - 1.0) < 1e-9);
+
+    // The window only keeps the most recent sends
+    for (int i = 1; i <= 8; i++) {
+        stats.record(40'000'000 + i * 5'000'000LL, 2'000'000);
+    }
+    snapshot = stats.snapshot();
+    QCOMPARE(snapshot.sendCount, 8);
+    QVERIFY(qAbs(snapshot.meanIntervalMs - 5.0) < 1e-9);
+    QVERIFY(snapshot.jitterMs < 1e-9);
+    QVERIFY(qAbs(snapshot.latencyMs - 2.0) < 1e-9);
+
+    stats.reset(5.0);
+    QCOMPARE(stats.snapshot().sendCount, 0);
+}
+
+void JoystickTest::_testVirtualJoystick(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QVERIFY(_vehicle);
+
+    VirtualJoystick joystick;
+    joystick.setFunctionAxis(Joystick::rollFunction,        0);
+    joystick.setFunctionAxis(Joystick::pitchFunction,       1);
+    joystick.setFunctionAxis(Joystick::yawFunction,         2);
+    joystick.setFunctionAxis(Joystick::throttleFunction,    3);
+    joystick.setAxisFrequency(100.0f);
+
+    _vehicle->setJoystickEnabled(true);
+    joystick.startPolling(_vehicle);
+
+    // Long enough for the statistics to be published once
+    QTRY_VERIFY_WITH_TIMEOUT(joystick.sendStats().sendCount > 0, 5000);
+    const JoystickSendStats::Snapshot stats = joystick.sendStats();
+
+    joystick.stopPolling();
+    joystick.stop();
+    _vehicle->setJoystickEnabled(false);
+
+    QVERIFY(stats.rateHz > 0);
+    QVERIFY(stats.latencyMs >= 0);
+    QVERIFY(joystick.sendRateHz() > 0);
+
+    QTRY_VERIFY(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_MANUAL_CONTROL) > 0);
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "Joystick.h"
+
+/// Joystick without a device behind it, the sticks slowly move around
+class VirtualJoystick : public Joystick
+{
+public:
+    VirtualJoystick()
+        : Joystick(QStringLiteral("VirtualJoystick"), 4 /* axes */, 2 /* buttons */, 0 /* hats */)
+    {}
+
+private:
+    bool _open      () final { return true; }
+    void _close     () final {}
+    bool _update    () final { _updateCount++; return true; }
+    bool _getButton (int) final { return false; }
+    int  _getAxis   (int i) final { return ((_updateCount * 97 + i * 5000) % 65535) - 32767; }
+    bool _getHat    (int, int) final { return false; }
+
+    int _updateCount = 0;
+};
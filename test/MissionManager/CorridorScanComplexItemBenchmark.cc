@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CorridorScanComplexItemBenchmark.h"
+#include "CorridorScanComplexItem.h"
+
+#include <QtTest/QTest>
+
+void CorridorScanComplexItemBenchmark::init(void)
+{
+    TransectStyleComplexItemTestBase::init();
+
+    // Long winding corridor, wide enough for a large number of transects
+    QList<QGeoCoordinate> vertices;
+    vertices.append(QGeoCoordinate(47.633550640000003, -122.08982199));
+    for (int i=1; i<200; i++) {
+        vertices.append(vertices.last().atDistanceAndAzimuth(50, (i % 2) ? 10 : 350));
+    }
+
+    _corridorItem = new CorridorScanComplexItem(_masterController, false /* flyView */, QString() /* kmlFile */);
+    _corridorItem->corridorPolyline()->appendVertices(vertices);
+    _corridorItem->cameraCalc()->adjustedFootprintSide()->setRawValue(5);
+    _corridorItem->corridorWidth()->setRawValue(100);
+}
+
+void CorridorScanComplexItemBenchmark::cleanup(void)
+{
+    TransectStyleComplexItemTestBase::cleanup();
+
+    // _corridorItem is deleted when _masterController goes away
+    _corridorItem = nullptr;
+}
+
+/// Time the ui thread is blocked per edit when rebuilding synchronously
+void CorridorScanComplexItemBenchmark::_benchmarkSyncEdit(void)
+{
+    int edit = 0;
+    QBENCHMARK {
+        _corridorItem->corridorWidth()->setRawValue(200.0 + (edit++ % _edits));
+    }
+}
+
+/// Time the ui thread is blocked per edit when rebuilding in the background
+void CorridorScanComplexItemBenchmark::_benchmarkAsyncEdit(void)
+{
+    _corridorItem->setAsyncRebuild(true);
+
+    int edit = 0;
+    QBENCHMARK {
+        _corridorItem->corridorWidth()->setRawValue(200.0 + (edit++ % _edits));
+    }
+
+    _corridorItem->setAsyncRebuild(false);
+}
+
+/// Time from the start of a burst of edits until the final geometry has been applied
+void CorridorScanComplexItemBenchmark::_benchmarkAsyncFinalResult(void)
+{
+    _corridorItem->setAsyncRebuild(true);
+
+    QBENCHMARK {
+        for (int i=0; i<_edits; i++) {
+            _corridorItem->corridorWidth()->setRawValue(200.0 + i);
+        }
+        _corridorItem->waitForRebuild();
+        _corridorItem->corridorWidth()->setRawValue(100);
+        _corridorItem->waitForRebuild();
+    }
+
+    _corridorItem->setAsyncRebuild(false);
+}
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "TransectStyleComplexItemTestBase.h"
+
+class CorridorScanComplexItem;
+
+/// Cost of corridor width edits on a long corridor, as made by a slider drag. Only run when requested with
+/// --unittest:CorridorScanComplexItemBenchmark.
+class CorridorScanComplexItemBenchmark : public TransectStyleComplexItemTestBase
+{
+    Q_OBJECT
+
+protected:
+    void init   (void) final;
+    void cleanup(void) final;
+
+private slots:
+    void _benchmarkSyncEdit         (void);
+    void _benchmarkAsyncEdit        (void);
+    void _benchmarkAsyncFinalResult (void);
+
+private:
+    CorridorScanComplexItem* _corridorItem = nullptr;
+
+    static constexpr int _edits = 20;
+};
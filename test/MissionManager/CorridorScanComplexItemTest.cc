@@ -12,6 +12,7 @@
 #include "MultiSignalSpy.h"
 #include "PlanViewSettings.h"
 
+#include <QtCore/QJsonArray>
 #include <QtTest/QTest>
 
 CorridorScanComplexItemTest::CorridorScanComplexItemTest(void)
@@ -256,3 +257,66 @@ void CorridorScanComplexItemTest::_testItemGeneration(void)
     }
 }
 
+
+void CorridorScanComplexItemTest::_testAsyncRebuild(void)
+{
+    // Expected results from a synchronous rebuild
+    const double finalWidth = _corridorWidth * 3;
+    _corridorItem->corridorWidth()->setRawValue(finalWidth);
+    const int           expectedTransectCount = _corridorItem->_transectCount();
+    const QVariantList  expectedPoints = _corridorItem->visualTransectPoints();
+    QVERIFY(expectedTransectCount > _expectedTransectCount);
+
+    _corridorItem->corridorWidth()->setRawValue(_corridorWidth);
+    QCOMPARE(_corridorItem->_transectCount(), static_cast<int>(_expectedTransectCount));
+
+    // A burst of edits such as a slider drag is coalesced, only the final value matters
+    _corridorItem->setAsyncRebuild(true);
+    for (int i=1; i<=10; i++) {
+        _corridorItem->corridorWidth()->setRawValue(_corridorWidth + ((finalWidth - _corridorWidth) * i / 10));
+    }
+    _corridorItem->waitForRebuild();
+
+    QCOMPARE(_corridorItem->_transectCount(), expectedTransectCount);
+    QCOMPARE(_corridorItem->visualTransectPoints(), expectedPoints);
+
+    // Turning async off must leave the item in a consistent synchronous state
+    _corridorItem->corridorWidth()->setRawValue(_corridorWidth);
+    _corridorItem->setAsyncRebuild(false);
+    QCOMPARE(_corridorItem->_transectCount(), static_cast<int>(_expectedTransectCount));
+}
+
+void CorridorScanComplexItemTest::_testSaveAfterAsyncEdit(void)
+{
+    // Expected results from a synchronous edit
+    const double newWidth = _corridorWidth * 3;
+    _corridorItem->corridorWidth()->setRawValue(newWidth);
+    QJsonArray expectedJson;
+    _corridorItem->save(expectedJson);
+    QList<MissionItem*> expectedItems;
+    _corridorItem->appendMissionItems(expectedItems, this);
+
+    _corridorItem->corridorWidth()->setRawValue(_corridorWidth);
+    QCOMPARE(_corridorItem->_transectCount(), static_cast<int>(_expectedTransectCount));
+
+    // Save and upload right after an edit must not pick up the geometry from before the edit
+    _corridorItem->setAsyncRebuild(true);
+    _corridorItem->corridorWidth()->setRawValue(newWidth);
+    QJsonArray savedJson;
+    _corridorItem->save(savedJson);
+    QCOMPARE(savedJson, expectedJson);
+
+    _corridorItem->corridorWidth()->setRawValue(_corridorWidth);
+    _corridorItem->corridorWidth()->setRawValue(newWidth);
+    QList<MissionItem*> items;
+    _corridorItem->appendMissionItems(items, this);
+    QCOMPARE(items.count(), expectedItems.count());
+    for (int i=0; i<items.count(); i++) {
+        QCOMPARE(items[i]->command(), expectedItems[i]->command());
+        QCOMPARE(items[i]->coordinate(), expectedItems[i]->coordinate());
+    }
+
+    _corridorItem->setAsyncRebuild(false);
+    qDeleteAll(expectedItems);
+    qDeleteAll(items);
+}
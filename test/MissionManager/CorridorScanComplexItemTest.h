@@ -34,6 +34,8 @@ private slots:
     void _testPathChanges   (void);
     void _testItemGeneration(void);
     void _testItemCount     (void);
+    void _testAsyncRebuild  (void);
+    void _testSaveAfterAsyncEdit(void);
 #else
     // Used to debug a single test
 private slots:
@@ -43,6 +45,8 @@ private:
     void _testCameraTrigger (void);
     void _testPathChanges   (void);
     void _testItemCount     (void);
+    void _testAsyncRebuild  (void);
+    void _testSaveAfterAsyncEdit(void);
 #endif
 
 private:
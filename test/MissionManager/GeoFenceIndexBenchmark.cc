@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndexBenchmark.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+namespace {
+
+/// Regular polygon with the specified number of vertices
+QList<QGeoCoordinate> regularPolygon(const QGeoCoordinate& center, double radius, int vertexCount)
+{
+    QList<QGeoCoordinate> vertices;
+    for (int i=0; i<vertexCount; i++) {
+        vertices.append(center.atDistanceAndAzimuth(radius, (360.0 * i) / vertexCount));
+    }
+    return vertices;
+}
+
+}
+
+void GeoFenceIndexBenchmark::initTestCase(void)
+{
+    // Hundreds of polygons with thousands of vertices in total
+    _index.addPolygon(regularPolygon(_center, 20000, 4000), true /* inclusion */);
+    for (int i=0; i<300; i++) {
+        _index.addPolygon(regularPolygon(_center.atDistanceAndAzimuth(1000 + (i * 50), i * 7.3), 40, 32), false /* inclusion */);
+    }
+    _index.build();
+
+    QRandomGenerator random(42);
+    for (int i=0; i<10000; i++) {
+        _coords.append(_center.atDistanceAndAzimuth(random.bounded(21000.0), random.bounded(360.0)));
+    }
+}
+
+void GeoFenceIndexBenchmark::_benchmarkBuild(void)
+{
+    QBENCHMARK {
+        _index.build();
+    }
+    QVERIFY(_index.edgeCount() > 0);
+}
+
+void GeoFenceIndexBenchmark::_benchmarkIsBreached(void)
+{
+    QList<bool> breached;
+    QBENCHMARK {
+        breached = _index.isBreached(_coords);
+    }
+    QCOMPARE(breached.count(), _coords.count());
+}
+
+void GeoFenceIndexBenchmark::_benchmarkDistanceToBoundary(void)
+{
+    QList<double> distances;
+    QBENCHMARK {
+        distances = _index.distanceToBoundary(_coords);
+    }
+    QCOMPARE(distances.count(), _coords.count());
+}
+
+void GeoFenceIndexBenchmark::_benchmarkPredictedBreachTime(void)
+{
+    QBENCHMARK {
+        for (const QGeoCoordinate& coord: std::as_const(_coords)) {
+            (void) _index.predictedBreachTime(coord, 15, 15, 30);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "GeoFenceIndex.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+/// Build and query time of a fence of hundreds of polygons. Only run when requested with --unittest:GeoFenceIndexBenchmark.
+class GeoFenceIndexBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void _benchmarkBuild(void);
+    void _benchmarkIsBreached(void);
+    void _benchmarkDistanceToBoundary(void);
+    void _benchmarkPredictedBreachTime(void);
+
+private:
+    GeoFenceIndex           _index;
+    QList<QGeoCoordinate>   _coords;
+
+    const QGeoCoordinate _center = QGeoCoordinate(47.3977, 8.5456);
+};
@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndexTest.h"
+#include "GeoFenceIndex.h"
+#include "QGCMapPolygon.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+QList<QGeoCoordinate> GeoFenceIndexTest::_polygon(const QGeoCoordinate& center, double radius, int vertexCount) const
+{
+    QList<QGeoCoordinate> vertices;
+    for (int i=0; i<vertexCount; i++) {
+        vertices.append(center.atDistanceAndAzimuth(radius, (360.0 * i) / vertexCount));
+    }
+    return vertices;
+}
+
+void GeoFenceIndexTest::_testInclusionExclusion(void)
+{
+    GeoFenceIndex index;
+
+    // Empty fence is never breached
+    index.build();
+    QVERIFY(index.isEmpty());
+    QCOMPARE(index.isBreached(_center), false);
+    QVERIFY(qIsNaN(index.distanceToBoundary(_center)));
+
+    // 1km inclusion with a 100m exclusion hole in the middle
+    index.addPolygon(_polygon(_center, 1000, 64), true /* inclusion */);
+    index.addPolygon(_polygon(_center, 100, 16), false /* inclusion */);
+    index.build();
+    QCOMPARE(index.edgeCount(), 64 + 16);
+
+    QCOMPARE(index.isBreached(_center), true);
+    QCOMPARE(index.isBreached(_center.atDistanceAndAzimuth(500, 45)), false);
+    QCOMPARE(index.isBreached(_center.atDistanceAndAzimuth(1500, 45)), true);
+
+    const QList<bool> results = index.isBreached({ _center, _center.atDistanceAndAzimuth(500, 45), _center.atDistanceAndAzimuth(1500, 45) });
+    QCOMPARE(results, QList<bool>({ true, false, true }));
+
+    // Exclusion only: everything outside the exclusion is allowed
+    index.clear();
+    index.addPolygon(_polygon(_center, 100, 16), false /* inclusion */);
+    index.build();
+    QCOMPARE(index.isBreached(_center), true);
+    QCOMPARE(index.isBreached(_center.atDistanceAndAzimuth(5000, 0)), false);
+}
+
+void GeoFenceIndexTest::_testCircles(void)
+{
+    GeoFenceIndex index;
+
+    index.addCircle(_center, 500, true /* inclusion */);
+    index.addCircle(_center.atDistanceAndAzimuth(200, 90), 50, false /* inclusion */);
+    index.build();
+
+    QCOMPARE(index.isBreached(_center), false);
+    QCOMPARE(index.isBreached(_center.atDistanceAndAzimuth(200, 90)), true);
+    QCOMPARE(index.isBreached(_center.atDistanceAndAzimuth(600, 0)), true);
+    QVERIFY(qAbs(index.distanceToBoundary(_center.atDistanceAndAzimuth(400, 0)) - 100) < 1.0);
+}
+
+void GeoFenceIndexTest::_testDistanceToBoundary(void)
+{
+    GeoFenceIndex index;
+
+    // Large vertex count so the polygon is close to a true circle
+    index.addPolygon(_polygon(_center, 1000, 2048), true /* inclusion */);
+    index.build();
+
+    QVERIFY(qAbs(index.distanceToBoundary(_center) - 1000) < 2.0);
+    QVERIFY(qAbs(index.distanceToBoundary(_center.atDistanceAndAzimuth(800, 123)) - 200) < 2.0);
+    QVERIFY(qAbs(index.distanceToBoundary(_center.atDistanceAndAzimuth(1300, 300)) - 300) < 2.0);
+
+    const QList<double> distances = index.distanceToBoundary({ _center, _center.atDistanceAndAzimuth(800, 123) });
+    QCOMPARE(distances.count(), 2);
+    QVERIFY(qAbs(distances[1] - 200) < 2.0);
+}
+
+void GeoFenceIndexTest::_testPredictedBreachTime(void)
+{
+    GeoFenceIndex index;
+
+    index.addPolygon(_polygon(_center, 1000, 2048), true /* inclusion */);
+    index.addCircle(_center.atDistanceAndAzimuth(500, 0), 100, false /* inclusion */);
+    index.build();
+
+    // 10 m/s north from the center hits the exclusion circle at 400m
+    QVERIFY(qAbs(index.predictedBreachTime(_center, 10, 0, 60) - 40.0) < 0.5);
+
+    // 10 m/s east hits the inclusion boundary at 1000m
+    QVERIFY(qAbs(index.predictedBreachTime(_center, 0, 10, 120) - 100.0) < 0.5);
+
+    // Outside the horizon
+    QVERIFY(qIsNaN(index.predictedBreachTime(_center, 0, 10, 60)));
+
+    // Stationary
+    QVERIFY(qIsNaN(index.predictedBreachTime(_center, 0, 0, 60)));
+
+    // Already breached
+    QCOMPARE(index.predictedBreachTime(_center.atDistanceAndAzimuth(2000, 0), 10, 0, 60), 0.0);
+}
+
+void GeoFenceIndexTest::_testMatchesMapPolygon(void)
+{
+    // Irregular polygon, compared against the existing QGCMapPolygon containment
+    QList<QGeoCoordinate> vertices;
+    QRandomGenerator random(1234);
+    for (int i=0; i<200; i++) {
+        vertices.append(_center.atDistanceAndAzimuth(500 + random.bounded(500.0), (360.0 * i) / 200));
+    }
+
+    QGCMapPolygon mapPolygon(this);
+    mapPolygon.appendVertices(vertices);
+
+    GeoFenceIndex index;
+    index.addPolygon(vertices, true /* inclusion */);
+    index.build();
+
+    for (int i=0; i<1000; i++) {
+        const QGeoCoordinate coord = _center.atDistanceAndAzimuth(random.bounded(1200.0), random.bounded(360.0));
+        if (index.distanceToBoundary(coord) < 1.0) {
+            // Projections differ slightly right at the boundary
+            continue;
+        }
+        QCOMPARE(!index.isBreached(coord), mapPolygon.containsCoordinate(coord));
+    }
+}
@@ -0,0 +1,32 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+class GeoFenceIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testInclusionExclusion(void);
+    void _testCircles(void);
+    void _testDistanceToBoundary(void);
+    void _testPredictedBreachTime(void);
+    void _testMatchesMapPolygon(void);
+
+private:
+    /// @return Regular polygon with the specified number of vertices
+    QList<QGeoCoordinate> _polygon(const QGeoCoordinate& center, double radius, int vertexCount) const;
+
+    const QGeoCoordinate _center = QGeoCoordinate(47.3977, 8.5456);
+};
@@ -0,0 +1,109 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MissionItemBenchmark.h"
+#include "MissionItem.h"
+#include "SimpleMissionItem.h"
+#include "PlanMasterController.h"
+
+#include <QtTest/QTest>
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+#include <malloc.h>
+#define QGC_HAVE_MALLINFO2
+#endif
+
+#ifdef QGC_HAVE_MALLINFO2
+/// @return Bytes currently allocated from the heap by this process
+static qint64 _heapInUse(void)
+{
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<qint64>(info.uordblks + info.hblkhd);
+}
+#endif
+
+void MissionItemBenchmark::init(void)
+{
+    UnitTest::init();
+    _masterController = new PlanMasterController(this);
+}
+
+void MissionItemBenchmark::cleanup(void)
+{
+    delete _masterController;
+    _masterController = nullptr;
+    UnitTest::cleanup();
+}
+
+void MissionItemBenchmark::_addItemCounts(void)
+{
+    QTest::addColumn<int>("itemCount");
+
+    QTest::newRow("1k")  << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("50k") << 50000;
+}
+
+void MissionItemBenchmark::_benchmarkConstruct_data(void)
+{
+    _addItemCounts();
+}
+
+/// Transport items followed by the SimpleMissionItems a plan load creates from them
+void MissionItemBenchmark::_benchmarkConstruct(void)
+{
+    QFETCH(int, itemCount);
+
+    QBENCHMARK {
+        QList<MissionItem*> missionItems;
+        QList<SimpleMissionItem*> simpleItems;
+        missionItems.reserve(itemCount);
+        simpleItems.reserve(itemCount);
+        for (int i=0; i<itemCount; i++) {
+            MissionItem* missionItem = new MissionItem(i, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 0, 0, 0, qQNaN(), 47.0 + (i * 1e-5), 8.0, 50.0, true, false);
+            missionItems.append(missionItem);
+            simpleItems.append(new SimpleMissionItem(_masterController, false /* flyView */, *missionItem));
+        }
+        qDeleteAll(simpleItems);
+        qDeleteAll(missionItems);
+    }
+}
+
+void MissionItemBenchmark::_benchmarkHeapPerItem_data(void)
+{
+    _addItemCounts();
+}
+
+/// Heap growth per loaded item, as seen by the allocator rather than estimated from sizeof
+void MissionItemBenchmark::_benchmarkHeapPerItem(void)
+{
+#ifdef QGC_HAVE_MALLINFO2
+    QFETCH(int, itemCount);
+
+    QList<MissionItem*> missionItems;
+    QList<SimpleMissionItem*> simpleItems;
+    missionItems.reserve(itemCount);
+    simpleItems.reserve(itemCount);
+
+    const qint64 heapBefore = _heapInUse();
+    for (int i=0; i<itemCount; i++) {
+        MissionItem* missionItem = new MissionItem(i, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 0, 0, 0, qQNaN(), 47.0 + (i * 1e-5), 8.0, 50.0, true, false);
+        missionItems.append(missionItem);
+        simpleItems.append(new SimpleMissionItem(_masterController, false /* flyView */, *missionItem));
+    }
+    const qint64 heapAfter = _heapInUse();
+
+    qDeleteAll(simpleItems);
+    qDeleteAll(missionItems);
+
+    QTest::setBenchmarkResult(static_cast<qreal>(heapAfter - heapBefore) / itemCount, QTest::BytesAllocated);
+#else
+    QSKIP("Heap statistics are only available with glibc");
+#endif
+}
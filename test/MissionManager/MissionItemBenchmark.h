@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class PlanMasterController;
+
+/// Construction time and heap use of large missions. Only run when requested with --unittest:MissionItemBenchmark.
+class MissionItemBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    void init(void) override;
+    void cleanup(void) override;
+
+private slots:
+    void _benchmarkConstruct_data(void);
+    void _benchmarkConstruct(void);
+    void _benchmarkHeapPerItem_data(void);
+    void _benchmarkHeapPerItem(void);
+
+private:
+    void _addItemCounts(void);
+
+    PlanMasterController* _masterController = nullptr;
+};
@@ -160,7 +160,7 @@ void MissionItemTest::_testFactSignals(void)
 
 
     // command
-    QSignalSpy commandSpy(&missionItem._commandFact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy commandSpy(&missionItem._commandFact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setCommand(MAV_CMD_NAV_WAYPOINT);
     QCOMPARE(commandSpy.count(), 0);
     missionItem.setCommand(MAV_CMD_NAV_LAND);
@@ -170,7 +170,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE((MAV_CMD)arguments.at(0).toInt(), MAV_CMD_NAV_LAND);
 
     // frame
-    QSignalSpy frameSpy(&missionItem._frameFact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy frameSpy(&missionItem._frameFact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setFrame(MAV_FRAME_GLOBAL_RELATIVE_ALT);
     QCOMPARE(frameSpy.count(), 0);
     missionItem.setFrame(MAV_FRAME_BODY_NED);
@@ -180,7 +180,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE((MAV_FRAME)arguments.at(0).toInt(), MAV_FRAME_BODY_NED);
 
     // param1
-    QSignalSpy param1Spy(&missionItem._param1Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param1Spy(&missionItem._param1Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam1(1.0);
     QCOMPARE(param1Spy.count(), 0);
     missionItem.setParam1(2.0);
@@ -190,7 +190,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 2.0);
 
     // param2
-    QSignalSpy param2Spy(&missionItem._param2Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param2Spy(&missionItem._param2Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam2(2.0);
     QCOMPARE(param2Spy.count(), 0);
     missionItem.setParam2(3.0);
@@ -200,7 +200,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 3.0);
 
     // param3
-    QSignalSpy param3Spy(&missionItem._param3Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param3Spy(&missionItem._param3Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam3(3.0);
     QCOMPARE(param3Spy.count(), 0);
     missionItem.setParam3(4.0);
@@ -210,7 +210,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 4.0);
 
     // param4
-    QSignalSpy param4Spy(&missionItem._param4Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param4Spy(&missionItem._param4Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam4(4.0);
     QCOMPARE(param4Spy.count(), 0);
     missionItem.setParam4(5.0);
@@ -220,7 +220,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 5.0);
 
     // param6
-    QSignalSpy param6Spy(&missionItem._param6Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param6Spy(&missionItem._param6Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam6(6.0);
     QCOMPARE(param6Spy.count(), 0);
     missionItem.setParam6(7.0);
@@ -230,7 +230,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 7.0);
 
     // param7
-    QSignalSpy param7Spy(&missionItem._param7Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param7Spy(&missionItem._param7Fact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam7(7.0);
     QCOMPARE(param7Spy.count(), 0);
     missionItem.setParam7(8.0);
@@ -545,3 +545,82 @@ QJsonObject MissionItemTest::_createV3Json(bool allNaNs)
 
     return jsonObject;
 }
+
+void MissionItemTest::_testLazyFacts(void)
+{
+    MissionItem missionItem(1,                                  // sequenceNumber
+                            MAV_CMD_NAV_WAYPOINT,               // command
+                            MAV_FRAME_GLOBAL_RELATIVE_ALT,      // MAV_FRAME
+                            1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0,  // params
+                            true,                               // autoContinue
+                            false);                             // isCurrentItem
+
+    // Plain value access must not create the Facts
+    missionItem.setParam1(10.0);
+    QCOMPARE(missionItem.param1(), 10.0);
+    QCOMPARE(missionItem.factsCreated(), false);
+
+    // Facts are created from the current values
+    QCOMPARE(missionItem._param1Fact().rawValue().toDouble(), 10.0);
+    QCOMPARE(missionItem._param7Fact().rawValue().toDouble(), 7.0);
+    QCOMPARE((MAV_CMD)missionItem._commandFact().rawValue().toInt(), MAV_CMD_NAV_WAYPOINT);
+    QCOMPARE(missionItem.factsCreated(), true);
+
+    // Changes through the Fact (editing ui) must update the item and signal
+    QSignalSpy param2Spy(&missionItem, &MissionItem::param2Changed);
+    missionItem._param2Fact().setRawValue(20.0);
+    QCOMPARE(missionItem.param2(), 20.0);
+    QCOMPARE(param2Spy.count(), 1);
+
+    // Changes through the item must update the Fact and signal only once
+    QSignalSpy commandSpy(&missionItem, &MissionItem::commandChanged);
+    missionItem.setCommand(MAV_CMD_NAV_LAND);
+    QCOMPARE((MAV_CMD)missionItem._commandFact().rawValue().toInt(), MAV_CMD_NAV_LAND);
+    QCOMPARE(commandSpy.count(), 1);
+
+    // NaN to NaN is not a change
+    missionItem.setParam4(qQNaN());
+    QSignalSpy param4Spy(&missionItem, &MissionItem::param4Changed);
+    missionItem.setParam4(qQNaN());
+    QCOMPARE(param4Spy.count(), 0);
+}
+
+void MissionItemTest::_testLazySimpleItems(void)
+{
+    constexpr int itemCount = 100;
+
+    QList<MissionItem*> missionItems;
+    QList<SimpleMissionItem*> simpleItems;
+    for (int i=0; i<itemCount; i++) {
+        MissionItem* missionItem = new MissionItem(i, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 0, 0, 0, qQNaN(), 47.0 + (i * 1e-5), 8.0, 50.0, true, false, this);
+        missionItems.append(missionItem);
+        simpleItems.append(new SimpleMissionItem(_masterController, false /* flyView */, *missionItem));
+    }
+
+    // Neither transport items nor loaded items allocate editing Facts or sections
+    for (int i=0; i<itemCount; i++) {
+        QCOMPARE(missionItems[i]->factsCreated(), false);
+        QCOMPARE(simpleItems[i]->missionItem().factsCreated(), false);
+        QCOMPARE(simpleItems[i]->sectionsCreated(), false);
+        QCOMPARE(simpleItems[i]->lastSequenceNumber(), i);
+    }
+
+    // Selecting a single item for editing only creates Facts and sections for that item
+    SimpleMissionItem* editItem = simpleItems[itemCount / 2];
+    QVERIFY(editItem->textFieldFacts()->count() > 0);
+    QVERIFY(editItem->cameraSection()->available());
+    QVERIFY(editItem->speedSection()->available());
+    QCOMPARE(editItem->missionItem().factsCreated(), true);
+    QCOMPARE(editItem->sectionsCreated(), true);
+    QCOMPARE(simpleItems[0]->missionItem().factsCreated(), false);
+    QCOMPARE(simpleItems[0]->sectionsCreated(), false);
+
+    // An item without sections saves as a single mission item
+    QList<MissionItem*> savedItems;
+    simpleItems[0]->appendMissionItems(savedItems, this);
+    QCOMPARE(savedItems.count(), 1);
+
+    qDeleteAll(savedItems);
+    qDeleteAll(simpleItems);
+    qDeleteAll(missionItems);
+}
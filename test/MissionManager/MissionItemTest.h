@@ -37,6 +37,8 @@ private slots:
     void _testLoadFromJsonV3NaN(void);
     void _testSimpleLoadFromJson(void);
     void _testSaveToJson(void);
+    void _testLazyFacts(void);
+    void _testLazySimpleItems(void);
 
 private:
     void _checkExpectedMissionItem(const MissionItem& missionItem, bool allNaNs = false) const;
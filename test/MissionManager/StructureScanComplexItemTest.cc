@@ -11,7 +11,7 @@
 #include "PlanMasterController.h"
 #include "MultiSignalSpy.h"
 #include "StructureScanComplexItem.h"
-#include "PlanMasterController.h"
+#include "QGC.h"
 
 #include <QtCore/QJsonArray>
 
@@ -140,3 +140,30 @@ void StructureScanComplexItemTest::_testItemCount(void)
     QCOMPARE(items.count() - 1, _structureScanItem->lastSequenceNumber());
 
 }
+
+void StructureScanComplexItemTest::_testAsyncRebuild(void)
+{
+    _initItem();
+
+    // Expected results from a synchronous rebuild
+    Fact* distanceToSurface = _structureScanItem->cameraCalc()->distanceToSurface();
+    const double originalDistance = distanceToSurface->rawValue().toDouble();
+    const double finalDistance = originalDistance * 2;
+    distanceToSurface->setRawValue(finalDistance);
+    const int       expectedCameraShots = _structureScanItem->cameraShots();
+    const double    expectedScanDistance = _structureScanItem->complexDistance();
+    QVERIFY(expectedScanDistance > 0);
+
+    distanceToSurface->setRawValue(originalDistance);
+    QVERIFY(!QGC::fuzzyCompare(_structureScanItem->complexDistance(), expectedScanDistance));
+
+    // Camera shots and scan distance use the perimeter calculated along with the background flight polygon
+    _structureScanItem->setAsyncRebuild(true);
+    distanceToSurface->setRawValue(finalDistance);
+    _structureScanItem->waitForRebuild();
+
+    QCOMPARE(_structureScanItem->cameraShots(), expectedCameraShots);
+    QVERIFY(QGC::fuzzyCompare(_structureScanItem->complexDistance(), expectedScanDistance));
+
+    _structureScanItem->setAsyncRebuild(false);
+}
@@ -30,6 +30,7 @@ private slots:
     void _testDirty(void);
     void _testSaveLoad(void);
     void _testItemCount(void);
+    void _testAsyncRebuild(void);
 
 private:
     void _initItem(void);
@@ -355,3 +355,16 @@ void SurveyComplexItemTest::_testHoverCaptureItemGeneration(void)
     _testItemGenerationWorker(false /* imagesInTurnaround */, true /* hasTurnaround */, true /* useConditionGate */, expectedCommands);
     _testItemGenerationWorker(false /* imagesInTurnaround */, true /* hasTurnaround */, false /* useConditionGate */, expectedCommands);
 }
+
+void SurveyComplexItemTest::_testLoadKMLAsync(void)
+{
+    SurveyComplexItem* surveyItem = new SurveyComplexItem(_masterController, false /* flyView */, QStringLiteral(":/unittest/PolygonGood.kml"));
+
+    // The polygon is filled in once the background load completes
+    QCOMPARE(surveyItem->surveyAreaPolygon()->count(), 0);
+    QTRY_VERIFY(surveyItem->surveyAreaPolygon()->count() >= 3);
+    QVERIFY(!surveyItem->surveyAreaPolygon()->dirty());
+    QVERIFY(!surveyItem->dirty());
+
+    surveyItem->deleteLater();
+}
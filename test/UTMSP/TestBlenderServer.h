@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+/// Stand-in Blender server: HTTP/1.1 with keep-alive, answers every request after a delay
+class TestBlenderServer : public QTcpServer
+{
+public:
+    struct Request {
+        QByteArray method;
+        QByteArray path;
+        QByteArray headers;
+        QByteArray body;
+    };
+
+    TestBlenderServer()
+    {
+        (void) connect(this, &QTcpServer::newConnection, this, &TestBlenderServer::_newConnection);
+    }
+
+    QString url() const { return QStringLiteral("http://127.0.0.1:%1").arg(serverPort()); }
+
+    int replyDelayMsecs = 0;
+    int connectionCount = 0;
+    QList<Request> requests;
+
+private:
+    void _newConnection()
+    {
+        while (QTcpSocket *const socket = nextPendingConnection()) {
+            connectionCount++;
+            (void) connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+                (void) _buffers.remove(socket);
+                socket->deleteLater();
+            });
+            (void) connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                _read(socket);
+            });
+        }
+    }
+
+    void _read(QTcpSocket *socket)
+    {
+        QByteArray &buffer = _buffers[socket];
+        buffer.append(socket->readAll());
+
+        // Several requests may arrive on one connection
+        forever {
+            const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+            if (headerEnd < 0) {
+                return;
+            }
+
+            Request request;
+            request.headers = buffer.left(headerEnd);
+            const QList<QByteArray> lines = request.headers.split('\n');
+            const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+            request.method = requestLine.value(0);
+            request.path = requestLine.value(1);
+
+            qsizetype contentLength = 0;
+            for (const QByteArray &line : lines) {
+                const qsizetype colon = line.indexOf(':');
+                if ((colon > 0) && (line.left(colon).trimmed().toLower() == "content-length")) {
+                    contentLength = line.mid(colon + 1).trimmed().toLongLong();
+                }
+            }
+            if (buffer.size() < (headerEnd + 4 + contentLength)) {
+                return;
+            }
+            request.body = buffer.mid(headerEnd + 4, contentLength);
+            buffer.remove(0, headerEnd + 4 + contentLength);
+            requests.append(request);
+
+            const QByteArray status = request.path.startsWith("/flight_stream/set_telemetry") ? "201 Created" : "200 OK";
+            const QByteArray reply = "HTTP/1.1 " + status + "\r\nContent-Type: application/json\r\nContent-Length: 2\r\n\r\n{}";
+            if (replyDelayMsecs > 0) {
+                const QPointer<QTcpSocket> guard(socket);
+                QTimer::singleShot(replyDelayMsecs, this, [guard, reply]() {
+                    if (guard) {
+                        (void) guard->write(reply);
+                    }
+                });
+            } else {
+                (void) socket->write(reply);
+            }
+        }
+    }
+
+    QHash<QTcpSocket*, QByteArray> _buffers;
+};
@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "UTMSPRestInterfaceBenchmark.h"
+#include "UTMSPBlenderRestInterface.h"
+#include "UTMSPNetworkRemoteIDManager.h"
+#include "TestBlenderServer.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtTest/QTest>
+
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+UTMSPNetworkRemoteIDManager::TelemetrySample testSample()
+{
+    UTMSPNetworkRemoteIDManager::TelemetrySample sample;
+    sample.latitude         = 47.3977419;
+    sample.longitude        = 8.5455938;
+    sample.altitude         = 488.25;
+    sample.heading          = 90;
+    sample.velocityX        = 3;
+    sample.velocityY        = 4;
+    sample.velocityZ        = -0.5;
+    sample.relativeAltitude = 25.5;
+    return sample;
+}
+
+}
+
+void UTMSPRestInterfaceBenchmark::_addReplyDelays(void)
+{
+    QTest::addColumn<int>("replyDelayMsecs");
+
+    QTest::newRow("no server delay")    << 0;
+    QTest::newRow("50 ms server delay") << 50;
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkBlockingRequests_data(void)
+{
+    _addReplyDelays();
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkBlockingRequests(void)
+{
+    QFETCH(int, replyDelayMsecs);
+
+    TestBlenderServer server;
+    server.replyDelayMsecs = replyDelayMsecs;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPBlenderRestInterface rest;
+    rest.setHostOverride(server.url());
+
+    // Waiting for every reply, as every request used to
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kRequests; i++) {
+        rest.modifyRequest(QStringLiteral("/flight_stream/set_telemetry"), QNetworkAccessManager::PutOperation, QByteArray("{}"));
+        QCOMPARE(rest.executeRequest().first, 201);
+    }
+
+    QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkQueuedRequests_data(void)
+{
+    _addReplyDelays();
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkQueuedRequests(void)
+{
+    QFETCH(int, replyDelayMsecs);
+
+    TestBlenderServer server;
+    server.replyDelayMsecs = replyDelayMsecs;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPBlenderRestInterface rest;
+    rest.setHostOverride(server.url());
+
+    // Queued, over the kept alive connections, until the last reply is in
+    int replies = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kRequests; i++) {
+        rest.modifyRequest(QStringLiteral("/flight_stream/set_telemetry"), QNetworkAccessManager::PutOperation, QByteArray("{}"));
+        QVERIFY(rest.sendRequest([&replies](int, const QByteArray &) { replies++; }));
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(replies, kRequests, 10000);
+
+    QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkQueuedCallerStall_data(void)
+{
+    _addReplyDelays();
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkQueuedCallerStall(void)
+{
+    QFETCH(int, replyDelayMsecs);
+
+    TestBlenderServer server;
+    server.replyDelayMsecs = replyDelayMsecs;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPBlenderRestInterface rest;
+    rest.setHostOverride(server.url());
+
+    // Longest time a single queued send kept the caller busy
+    int replies = 0;
+    qint64 longestSendNsecs = 0;
+    for (int i = 0; i < kRequests; i++) {
+        QElapsedTimer sendTimer;
+        sendTimer.start();
+        rest.modifyRequest(QStringLiteral("/flight_stream/set_telemetry"), QNetworkAccessManager::PutOperation, QByteArray("{}"));
+        QVERIFY(rest.sendRequest([&replies](int, const QByteArray &) { replies++; }));
+        longestSendNsecs = qMax(longestSendNsecs, sendTimer.nsecsElapsed());
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(replies, kRequests, 10000);
+
+    QTest::setBenchmarkResult(longestSendNsecs / 1e6, QTest::WalltimeMilliseconds);
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkObservationPerTick(void)
+{
+    // Everything built and pretty printed per tick, as the observations used to be
+    const UTMSPNetworkRemoteIDManager::TelemetrySample sample = testSample();
+
+    QBENCHMARK {
+        const std::time_t now = std::time(nullptr);
+        std::ostringstream oss;
+        oss << std::put_time(std::gmtime(&now), "%FT%T") << "Z";
+
+        json flightDetails;
+        flightDetails["rid_details"] = { {"id", "flight-1"}, {"operator_id", "OP-1"}, {"operation_description", "Delivery operation, see more details at https://deliveryops.com/operation"} };
+        flightDetails["eu_classification"] = { {"category", "EUCategoryUndefined"}, {"class", "EUClassUndefined"} };
+        flightDetails["uas_id"] = { {"serial_number", "SN-1"}, {"registration_number", "OP-1"}, {"utm_id", "SN-1"}, {"specific_session_id", "Unknown"} };
+        flightDetails["operator_location"]["position"] = { {"lng", 8.5}, {"lat", 47.5}, {"accuracy_h", "HAUnknown"}, {"accuracy_v", "VAUnknown"} };
+        flightDetails["operator_location"]["altitude"] = 0;
+        flightDetails["operator_location"]["altitude_type"] = "Takeoff";
+        flightDetails["auth_data"] = { {"format", "string"}, {"data", 0} };
+        flightDetails["serial_number"] = "SN-1";
+        flightDetails["registration_number"] = "OP-1";
+
+        json state;
+        state["timestamp"] = { {"value", oss.str()}, {"format", "RFC3339"} };
+        state["timestamp_accuracy"] = 0.0;
+        state["operational_status"] = "Undeclared";
+        state["position"] = { {"lat", sample.latitude}, {"lng", sample.longitude}, {"alt", sample.altitude / 1000}, {"accuracy_h", "HAUnknown"}, {"accuracy_v", "VAUnknown"}, {"extrapolated", true}, {"pressure_altitude", 0.0} };
+        state["track"] = sample.heading;
+        state["speed"] = std::sqrt(sample.velocityX*sample.velocityX + sample.velocityY*sample.velocityY);
+        state["speed_accuracy"] = "SAUnknown";
+        state["vertical_speed"] = sample.velocityZ;
+        state["height"] = { {"distance", sample.relativeAltitude}, {"reference", "TakeoffLocation"} };
+        state["group_radius"] = 0.0;
+        state["group_ceiling"] = 0.0;
+        state["group_floor"] = 0.0;
+        state["group_count"] = 1;
+        state["group_time_start"] = oss.str();
+        state["group_time_end"] = oss.str();
+
+        json observation;
+        observation["current_states"] = json::array({ state });
+        observation["flight_details"] = flightDetails;
+        json data;
+        data["observations"] = json::array({ observation });
+        QVERIFY(!data.dump(4).empty());
+    }
+}
+
+void UTMSPRestInterfaceBenchmark::_benchmarkObservationPrecomputed(void)
+{
+    // Flight details serialized once per flight
+    const UTMSPNetworkRemoteIDManager::TelemetrySample sample = testSample();
+    UTMSPNetworkRemoteIDManager manager(std::make_shared<Dispatcher>());
+    manager.prepareFlight("SN-1", "OP-1", "flight-1", 47.5, 8.5);
+
+    QBENCHMARK {
+        const QByteArray timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toLatin1();
+        QVERIFY(!manager.observation(sample, timestamp).isEmpty());
+    }
+}
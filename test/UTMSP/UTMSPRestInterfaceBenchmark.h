@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Request latency of the Blender REST interface and cost of building observations.
+/// Only run when requested with --unittest:UTMSPRestInterfaceBenchmark.
+class UTMSPRestInterfaceBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkBlockingRequests_data(void);
+    void _benchmarkBlockingRequests(void);
+    void _benchmarkQueuedRequests_data(void);
+    void _benchmarkQueuedRequests(void);
+    void _benchmarkQueuedCallerStall_data(void);
+    void _benchmarkQueuedCallerStall(void);
+    void _benchmarkObservationPerTick(void);
+    void _benchmarkObservationPrecomputed(void);
+
+private:
+    void _addReplyDelays(void);
+
+    static constexpr int kRequests = 20;
+};
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "UTMSPRestInterfaceTest.h"
+#include "UTMSPBlenderRestInterface.h"
+#include "UTMSPNetworkRemoteIDManager.h"
+#include "TestBlenderServer.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include <limits>
+
+namespace {
+
+UTMSPNetworkRemoteIDManager::TelemetrySample testSample()
+{
+    UTMSPNetworkRemoteIDManager::TelemetrySample sample;
+    sample.latitude         = 47.3977419;
+    sample.longitude        = 8.5455938;
+    sample.altitude         = 488.25;
+    sample.heading          = 90;
+    sample.velocityX        = 3;
+    sample.velocityY        = 4;
+    sample.velocityZ        = -0.5;
+    sample.relativeAltitude = 25.5;
+    return sample;
+}
+
+QJsonArray observations(const QByteArray &body)
+{
+    return QJsonDocument::fromJson(body).object().value(QStringLiteral("observations")).toArray();
+}
+
+double latitudeOf(const QJsonValue &observation)
+{
+    const QJsonObject state = observation.toObject().value(QStringLiteral("current_states")).toArray().at(0).toObject();
+    return state.value(QStringLiteral("position")).toObject().value(QStringLiteral("lat")).toDouble();
+}
+
+QJsonObject flightDetailsOf(const QJsonValue &observation)
+{
+    return observation.toObject().value(QStringLiteral("flight_details")).toObject();
+}
+
+}
+
+void UTMSPRestInterfaceTest::_testObservation(void)
+{
+    UTMSPNetworkRemoteIDManager manager(std::make_shared<Dispatcher>());
+    manager.prepareFlight("SN-1", "OP-\"1\"", "flight-1", 47.5, 8.5);
+
+    UTMSPNetworkRemoteIDManager::TelemetrySample sample = testSample();
+    const QByteArray observation = manager.observation(sample, "2024-05-01T12:00:00Z");
+    QVERIFY(!observation.contains('\n'));
+
+    QJsonParseError error;
+    const QJsonObject observationObject = QJsonDocument::fromJson(observation, &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const QJsonObject state = observationObject[QStringLiteral("current_states")].toArray().at(0).toObject();
+    QCOMPARE(state[QStringLiteral("timestamp")][QStringLiteral("value")].toString(), QStringLiteral("2024-05-01T12:00:00Z"));
+    QCOMPARE(state[QStringLiteral("timestamp")][QStringLiteral("format")].toString(), QStringLiteral("RFC3339"));
+    QCOMPARE(state[QStringLiteral("position")][QStringLiteral("lat")].toDouble(), sample.latitude);
+    QCOMPARE(state[QStringLiteral("position")][QStringLiteral("lng")].toDouble(), sample.longitude);
+    QCOMPARE(state[QStringLiteral("position")][QStringLiteral("alt")].toDouble(), sample.altitude / 1000);
+    QCOMPARE(state[QStringLiteral("position")][QStringLiteral("extrapolated")].toBool(), true);
+    QCOMPARE(state[QStringLiteral("track")].toDouble(), 90.0);
+    QCOMPARE(state[QStringLiteral("speed")].toDouble(), 5.0);
+    QCOMPARE(state[QStringLiteral("vertical_speed")].toDouble(), -0.5);
+    QCOMPARE(state[QStringLiteral("height")][QStringLiteral("distance")].toDouble(), 25.5);
+    QCOMPARE(state[QStringLiteral("height")][QStringLiteral("reference")].toString(), QStringLiteral("TakeoffLocation"));
+    QCOMPARE(state[QStringLiteral("group_count")].toInt(), 1);
+    QCOMPARE(state[QStringLiteral("group_time_end")].toString(), QStringLiteral("2024-05-01T12:00:00Z"));
+
+    const QJsonObject flightDetails = observationObject[QStringLiteral("flight_details")].toObject();
+    QCOMPARE(flightDetails[QStringLiteral("rid_details")][QStringLiteral("id")].toString(), QStringLiteral("flight-1"));
+    QCOMPARE(flightDetails[QStringLiteral("rid_details")][QStringLiteral("operator_id")].toString(), QStringLiteral("OP-\"1\""));
+    QCOMPARE(flightDetails[QStringLiteral("uas_id")][QStringLiteral("serial_number")].toString(), QStringLiteral("SN-1"));
+    QCOMPARE(flightDetails[QStringLiteral("operator_location")][QStringLiteral("position")][QStringLiteral("lat")].toDouble(), 47.5);
+
+    // Values which are not numbers still give valid json
+    sample.heading = std::numeric_limits<double>::quiet_NaN();
+    const QJsonObject nanObservation = QJsonDocument::fromJson(manager.observation(sample, "2024-05-01T12:00:00Z"), &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(nanObservation[QStringLiteral("current_states")].toArray().at(0).toObject().value(QStringLiteral("track")).isNull());
+}
+
+void UTMSPRestInterfaceTest::_testAsyncRequests(void)
+{
+    TestBlenderServer server;
+    server.replyDelayMsecs = 100;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPBlenderRestInterface rest;
+    rest.setHostOverride(server.url());
+
+    static constexpr int kRequests = 20;
+    QList<int> statusCodes;
+    for (int i = 0; i < kRequests; i++) {
+        rest.modifyRequest(QStringLiteral("/ping"), QNetworkAccessManager::GetOperation);
+        QVERIFY(rest.sendRequest([&statusCodes](int statusCode, const QByteArray &) {
+            statusCodes.append(statusCode);
+        }));
+    }
+
+    // Nothing waited for a reply
+    QVERIFY(statusCodes.isEmpty());
+    QCOMPARE(rest.inFlightRequests(), UTMSPRestInterface::kMaxInFlight);
+    QCOMPARE(rest.queuedRequests(), kRequests - UTMSPRestInterface::kMaxInFlight);
+
+    QTRY_COMPARE_WITH_TIMEOUT(statusCodes.count(), kRequests, 5000);
+    QCOMPARE(static_cast<int>(statusCodes.count(200)), kRequests);
+    QCOMPARE(server.requests.count(), kRequests);
+    QCOMPARE(rest.inFlightRequests(), 0);
+    QCOMPARE(rest.queuedRequests(), 0);
+
+    // Connections are kept alive rather than opened per request
+    const int connectionCount = server.connectionCount;
+    QVERIFY(connectionCount <= UTMSPRestInterface::kMaxInFlight);
+
+    // Waiting for the reply still works, over the same connections
+    rest.modifyRequest(QStringLiteral("/flight_declaration_ops/flight_declaration_state/1"), QNetworkAccessManager::PutOperation, QStringLiteral("{\"state\":2}"));
+    const auto [statusCode, response] = rest.executeRequest();
+    QCOMPARE(statusCode, 200);
+    QCOMPARE(response, std::string("{}"));
+    QCOMPARE(server.requests.last().method, QByteArray("PUT"));
+    QCOMPARE(server.requests.last().body, QByteArray("{\"state\":2}"));
+    QCOMPARE(server.connectionCount, connectionCount);
+}
+
+void UTMSPRestInterfaceTest::_testSendQueueFull(void)
+{
+    TestBlenderServer server;
+    server.replyDelayMsecs = 200;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPBlenderRestInterface rest;
+    rest.setHostOverride(server.url());
+    rest.setMaxQueuedRequests(2);
+
+    int replies = 0;
+    const auto handler = [&replies](int, const QByteArray &) { replies++; };
+    rest.modifyRequest(QStringLiteral("/ping"), QNetworkAccessManager::GetOperation);
+    for (int i = 0; i < UTMSPRestInterface::kMaxInFlight + 2; i++) {
+        QVERIFY(rest.sendRequest(handler));
+    }
+    QVERIFY(!rest.sendRequest(handler));
+    QCOMPARE(rest.queuedRequests(), 2);
+
+    // Room again once the server caught up
+    QTRY_COMPARE_WITH_TIMEOUT(replies, UTMSPRestInterface::kMaxInFlight + 2, 5000);
+    QVERIFY(rest.sendRequest(handler));
+    QTRY_COMPARE_WITH_TIMEOUT(replies, UTMSPRestInterface::kMaxInFlight + 3, 5000);
+}
+
+void UTMSPRestInterfaceTest::_testTelemetryBatching(void)
+{
+    TestBlenderServer server;
+    server.replyDelayMsecs = 200;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    UTMSPNetworkRemoteIDManager manager(std::make_shared<Dispatcher>());
+    manager.setHostOverride(server.url());
+
+    // Activation opens the connection ahead of the first observation
+    manager.getCapabilty("token");
+    QTRY_COMPARE_WITH_TIMEOUT(server.connectionCount, 1, 5000);
+
+    const auto addSample = [&manager](double latitude, const std::string &flightID) {
+        manager.startTelemetry(latitude, 8.5, 488, 90, 3, 4, 0, 25, "SN-1", "OP-1", flightID);
+    };
+
+    // Observations made while a request is in flight go out together in the next one
+    addSample(47.0, "flight-1");
+    QVERIFY(manager.telemetryInFlight());
+    for (int i = 1; i <= 4; i++) {
+        addSample(47.0 + i, "flight-1");
+    }
+    QCOMPARE(manager.pendingObservations(), 4);
+
+    QTRY_COMPARE_WITH_TIMEOUT(server.requests.count(), 2, 5000);
+    QTRY_VERIFY_WITH_TIMEOUT(!manager.telemetryInFlight(), 5000);
+    QCOMPARE(manager.pendingObservations(), 0);
+    QCOMPARE(manager.droppedObservations(), 0);
+
+    QCOMPARE(server.requests[0].method, QByteArray("PUT"));
+    QCOMPARE(server.requests[0].path, QByteArray("/flight_stream/set_telemetry"));
+    QVERIFY(server.requests[0].headers.contains("Authorization: Bearer token"));
+    const QJsonArray first = observations(server.requests[0].body);
+    const QJsonArray batch = observations(server.requests[1].body);
+    QCOMPARE(first.count(), 1);
+    QCOMPARE(batch.count(), 4);
+    QCOMPARE(latitudeOf(batch.at(3)), 51.0);
+
+    // Flight details were serialized once, the operator location is where the flight started
+    const QJsonObject flightDetails = flightDetailsOf(batch.at(3));
+    QVERIFY(flightDetails == flightDetailsOf(first.at(0)));
+    QCOMPARE(flightDetails[QStringLiteral("operator_location")][QStringLiteral("position")][QStringLiteral("lat")].toDouble(), 47.0);
+
+    // A server falling behind drops the oldest observations rather than queueing without bound
+    addSample(60.0, "flight-1");
+    for (int i = 0; i < UTMSPNetworkRemoteIDManager::kMaxBatchObservations + 3; i++) {
+        addSample(61.0 + i, "flight-1");
+    }
+    QCOMPARE(manager.pendingObservations(), UTMSPNetworkRemoteIDManager::kMaxBatchObservations);
+    QCOMPARE(manager.droppedObservations(), 3);
+    QTRY_COMPARE_WITH_TIMEOUT(server.requests.count(), 4, 5000);
+    const QJsonArray trimmed = observations(server.requests[3].body);
+    QCOMPARE(trimmed.count(), UTMSPNetworkRemoteIDManager::kMaxBatchObservations);
+    QCOMPARE(latitudeOf(trimmed.at(0)), 64.0);
+
+    // The next flight has its own flight details
+    QTRY_VERIFY_WITH_TIMEOUT(!manager.telemetryInFlight(), 5000);
+    QVERIFY(manager.stopTelemetry());
+    addSample(10.0, "flight-2");
+    QTRY_COMPARE_WITH_TIMEOUT(server.requests.count(), 5, 5000);
+    const QJsonObject secondFlight = flightDetailsOf(observations(server.requests[4].body).at(0));
+    QCOMPARE(secondFlight[QStringLiteral("rid_details")][QStringLiteral("id")].toString(), QStringLiteral("flight-2"));
+    QCOMPARE(secondFlight[QStringLiteral("operator_location")][QStringLiteral("position")][QStringLiteral("lat")].toDouble(), 10.0);
+
+    // All of it over the connection opened on activation
+    QCOMPARE(server.connectionCount, 1);
+}
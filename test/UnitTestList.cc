@@ -29,9 +29,14 @@
 // #include "RadioConfigTest.h"
 
 // Camera
+#include "CameraDefinitionBenchmark.h"
+#include "CameraDefinitionTest.h"
+#include "CameraParamSchedulerTest.h"
 #include "QGCCameraManagerTest.h"
 
 // Comms
+#include "MockLinkSwarmBenchmark.h"
+#include "MockLinkSwarmTest.h"
 #include "QGCSerialPortInfoTest.h"
 
 // FactSystem
@@ -43,10 +48,17 @@
 #include "FollowMeTest.h"
 
 // Geo
+#include "GeoBenchmark.h"
 #include "GeoTest.h"
 
 // GPS
 #include "GpsTest.h"
+#include "NTRIPClientTest.h"
+#include "RTCMMavlinkTest.h"
+
+// Joystick
+#include "JoystickBenchmark.h"
+#include "JoystickTest.h"
 
 // MAVLink
 #include "StatusTextHandlerTest.h"
@@ -55,13 +67,17 @@
 // MissionManager
 #include "CameraCalcTest.h"
 #include "CameraSectionTest.h"
+#include "CorridorScanComplexItemBenchmark.h"
 #include "CorridorScanComplexItemTest.h"
+#include "GeoFenceIndexBenchmark.h"
+#include "GeoFenceIndexTest.h"
 // #include "FWLandingPatternTest.h"
 // #include "LandingComplexItemTest.h"
 // #include "MissionCommandTreeEditorTest.h"
 #include "MissionCommandTreeTest.h"
 #include "MissionControllerManagerTest.h"
 #include "MissionControllerTest.h"
+#include "MissionItemBenchmark.h"
 #include "MissionItemTest.h"
 #include "MissionManagerTest.h"
 #include "MissionSettingsTest.h"
@@ -93,20 +109,56 @@
 
 // Utilities
 // Compression
+#include "DecompressionBenchmark.h"
 #include "DecompressionTest.h"
+#include "JsonHelperBenchmark.h"
+#include "JsonHelperTest.h"
 #include "QGCFileDownloadTest.h"
+#include "QGCProfilerBenchmark.h"
+#include "QGCProfilerTest.h"
+#include "ShapeFileHelperBenchmark.h"
+#include "ShapeFileHelperTest.h"
+#include "SignalCompressionBenchmark.h"
+#include "SignalCompressionTest.h"
+
+// UTMSP
+#ifdef QGC_UTM_ADAPTER
+#include "UTMSPRestInterfaceBenchmark.h"
+#include "UTMSPRestInterfaceTest.h"
+#endif
 
 // Vehicle
 // Components
+#include "CompInfoParamIndexBenchmark.h"
+#include "CompInfoParamIndexTest.h"
 #include "ComponentInformationCacheTest.h"
 #include "ComponentInformationTranslationTest.h"
 #include "FTPManagerTest.h"
+#include "InitialConnectBenchmark.h"
+#include "InitialConnectStagesTest.h"
 // #include "InitialConnectTest.h"
 #include "MAVLinkLogManagerTest.h"
 // #include "RequestMessageTest.h"
 // #include "SendMavCommandWithHandlerTest.h"
 // #include "SendMavCommandWithSignalingTest.h"
 
+// VideoManager
+#include "TelemetrySidecarWriterTest.h"
+#include "VideoLatencyBenchmark.h"
+#include "VideoLatencyTest.h"
+#include "VideoReceiverStatsTest.h"
+#include "VideoStorageQuotaTest.h"
+
+// Viewer3D
+#ifdef QGC_VIEWER3D
+#include "OsmParserBenchmark.h"
+#include "OsmParserTest.h"
+#include "Viewer3DTerrainChunksBenchmark.h"
+#include "Viewer3DTerrainChunksTest.h"
+#include "Viewer3DTileQueryBenchmark.h"
+#include "Viewer3DTileQueryTest.h"
+#endif
+
 // Missing
 // #include "FlightGearUnitTest.h"
 // #include "LinkManagerTest.h"
@@ -135,9 +187,14 @@ int runTests(bool stress, QStringView unitTestOptions)
     // UT_REGISTER_TEST(RadioConfigTest)
 
     // Camera
+    UT_REGISTER_TEST_STANDALONE(CameraDefinitionBenchmark)
+    UT_REGISTER_TEST(CameraDefinitionTest)
+    UT_REGISTER_TEST(CameraParamSchedulerTest)
     UT_REGISTER_TEST(QGCCameraManagerTest)
 
     // Comms
+    UT_REGISTER_TEST_STANDALONE(MockLinkSwarmBenchmark)
+    UT_REGISTER_TEST(MockLinkSwarmTest)
     UT_REGISTER_TEST(QGCSerialPortInfoTest)
 
     // FactSystem
@@ -149,10 +206,17 @@ int runTests(bool stress, QStringView unitTestOptions)
     UT_REGISTER_TEST(FollowMeTest)
 
     // Geo
+    UT_REGISTER_TEST_STANDALONE(GeoBenchmark)
     UT_REGISTER_TEST(GeoTest)
 
     // GPS
     // UT_REGISTER_TEST(GpsTest)
+    UT_REGISTER_TEST(NTRIPClientTest)
+    UT_REGISTER_TEST(RTCMMavlinkTest)
+
+    // Joystick
+    UT_REGISTER_TEST_STANDALONE(JoystickBenchmark)
+    UT_REGISTER_TEST(JoystickTest)
 
     // MAVLink
     UT_REGISTER_TEST(StatusTextHandlerTest)
@@ -161,13 +225,17 @@ int runTests(bool stress, QStringView unitTestOptions)
     // MissionManager
     UT_REGISTER_TEST(CameraCalcTest)
     UT_REGISTER_TEST(CameraSectionTest)
+    UT_REGISTER_TEST_STANDALONE(CorridorScanComplexItemBenchmark)
     UT_REGISTER_TEST(CorridorScanComplexItemTest)
+    UT_REGISTER_TEST_STANDALONE(GeoFenceIndexBenchmark)
+    UT_REGISTER_TEST(GeoFenceIndexTest)
     // UT_REGISTER_TEST(FWLandingPatternTest)
     // UT_REGISTER_TEST(LandingComplexItemTest)
     // UT_REGISTER_TEST_STANDALONE(MissionCommandTreeEditorTest)
     UT_REGISTER_TEST(MissionCommandTreeTest)
     UT_REGISTER_TEST(MissionControllerManagerTest)
     UT_REGISTER_TEST(MissionControllerTest)
+    UT_REGISTER_TEST_STANDALONE(MissionItemBenchmark)
     UT_REGISTER_TEST(MissionItemTest)
     UT_REGISTER_TEST(MissionManagerTest)
     UT_REGISTER_TEST(MissionSettingsTest)
@@ -197,20 +265,56 @@ int runTests(bool stress, QStringView unitTestOptions)
 
     // Utilities
     // Compression
+    UT_REGISTER_TEST_STANDALONE(DecompressionBenchmark)
     UT_REGISTER_TEST(DecompressionTest)
+    UT_REGISTER_TEST_STANDALONE(JsonHelperBenchmark)
+    UT_REGISTER_TEST(JsonHelperTest)
     UT_REGISTER_TEST(QGCFileDownloadTest)
+    UT_REGISTER_TEST_STANDALONE(QGCProfilerBenchmark)
+    UT_REGISTER_TEST(QGCProfilerTest)
+    UT_REGISTER_TEST_STANDALONE(ShapeFileHelperBenchmark)
+    UT_REGISTER_TEST(ShapeFileHelperTest)
+    UT_REGISTER_TEST_STANDALONE(SignalCompressionBenchmark)
+    UT_REGISTER_TEST(SignalCompressionTest)
+
+    // UTMSP
+#ifdef QGC_UTM_ADAPTER
+    UT_REGISTER_TEST_STANDALONE(UTMSPRestInterfaceBenchmark)
+    UT_REGISTER_TEST(UTMSPRestInterfaceTest)
+#endif
 
     // Vehicle
     // Components
+    UT_REGISTER_TEST_STANDALONE(CompInfoParamIndexBenchmark)
+    UT_REGISTER_TEST(CompInfoParamIndexTest)
     UT_REGISTER_TEST(ComponentInformationCacheTest)
     UT_REGISTER_TEST(ComponentInformationTranslationTest)
     UT_REGISTER_TEST(FTPManagerTest)
+    UT_REGISTER_TEST_STANDALONE(InitialConnectBenchmark)
+    UT_REGISTER_TEST(InitialConnectStagesTest)
     // UT_REGISTER_TEST(InitialConnectTest)
     UT_REGISTER_TEST(MAVLinkLogManagerTest)
     // UT_REGISTER_TEST(RequestMessageTest)
     // UT_REGISTER_TEST(SendMavCommandWithHandlerTest)
     // UT_REGISTER_TEST(SendMavCommandWithSignalingTest)
 
+    // VideoManager
+    UT_REGISTER_TEST(TelemetrySidecarWriterTest)
+    UT_REGISTER_TEST_STANDALONE(VideoLatencyBenchmark)
+    UT_REGISTER_TEST(VideoLatencyTest)
+    UT_REGISTER_TEST(VideoReceiverStatsTest)
+    UT_REGISTER_TEST(VideoStorageQuotaTest)
+
+    // Viewer3D
+#ifdef QGC_VIEWER3D
+    UT_REGISTER_TEST_STANDALONE(OsmParserBenchmark)
+    UT_REGISTER_TEST(OsmParserTest)
+    UT_REGISTER_TEST_STANDALONE(Viewer3DTerrainChunksBenchmark)
+    UT_REGISTER_TEST(Viewer3DTerrainChunksTest)
+    UT_REGISTER_TEST_STANDALONE(Viewer3DTileQueryBenchmark)
+    UT_REGISTER_TEST(Viewer3DTileQueryTest)
+#endif
+
     // Missing
     // UT_REGISTER_TEST(FlightGearUnitTest)
     // UT_REGISTER_TEST(LinkManagerTest)
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "DecompressionBenchmark.h"
+#include "QGCDecompressDevice.h"
+#include "QGCLZMA.h"
+#include "QGCZip.h"
+#include "QGCZlib.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtTest/QTest>
+
+void DecompressionBenchmark::initTestCase(void)
+{
+    QVERIFY(_tempDir.isValid());
+
+    // Archive of many entries, cut from the decompressed manifest
+    QFile lzmaFile(QStringLiteral(":/manifest.json.xz"));
+    QVERIFY(lzmaFile.open(QIODevice::ReadOnly));
+    QByteArray manifest;
+    QVERIFY(QGCLZMA::inflateLZMAData(lzmaFile.readAll(), manifest));
+    _manifestSize = manifest.size();
+
+    const QString sourcePath = _tempDir.filePath(QStringLiteral("parts"));
+    QVERIFY(QDir().mkpath(sourcePath));
+    const qsizetype partSize = manifest.size() / kZipEntries;
+    for (int i = 0; i < kZipEntries; i++) {
+        QFile file(sourcePath + QStringLiteral("/part%1.json").arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        (void) file.write(manifest.mid(i * partSize, partSize));
+    }
+    _zipFileName = _tempDir.filePath(QStringLiteral("parts.zip"));
+    QVERIFY(QGCZip::zipDirectory(sourcePath, _zipFileName));
+}
+
+void DecompressionBenchmark::_benchmarkDecompress_data(void)
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<bool>("streamed");
+
+    QTest::newRow("xz buffered")    << QStringLiteral(":/manifest.json.xz") << false;
+    QTest::newRow("xz streamed")    << QStringLiteral(":/manifest.json.xz") << true;
+    QTest::newRow("gzip buffered")  << QStringLiteral(":/manifest.json.gz") << false;
+    QTest::newRow("gzip streamed")  << QStringLiteral(":/manifest.json.gz") << true;
+}
+
+qint64 DecompressionBenchmark::_decompress(const QString &fileName, bool streamed, qint64 *peakHeld)
+{
+    qint64 held = 0;
+
+    if (streamed) {
+        // Never more than one chunk held
+        QFile file(fileName);
+        QGCDecompressDevice decompressor(&file);
+        if (!file.open(QIODevice::ReadOnly) || !decompressor.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        QByteArray chunk(QGCDecompressDevice::kChunkSize, Qt::Uninitialized);
+        qint64 bytesRead;
+        qint64 size = 0;
+        while ((bytesRead = decompressor.read(chunk.data(), chunk.size())) > 0) {
+            size += bytesRead;
+            held = qMax(held, static_cast<qint64>(chunk.size()));
+        }
+        if (peakHeld) {
+            *peakHeld = held;
+        }
+        return decompressor.isFinished() ? size : -1;
+    }
+
+    // What loading did before streaming: the whole compressed and decompressed data held in memory
+    QByteArray decompressed;
+    if (fileName.endsWith(QStringLiteral(".xz"))) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        const QByteArray compressed = file.readAll();
+        if (!QGCLZMA::inflateLZMAData(compressed, decompressed)) {
+            return -1;
+        }
+        held = compressed.size() + decompressed.size();
+    } else {
+        const QString decompressedFileName = _tempDir.filePath(QStringLiteral("manifest.json"));
+        if (!QGCZlib::inflateGzipFile(fileName, decompressedFileName)) {
+            return -1;
+        }
+        QFile decompressedFile(decompressedFileName);
+        if (!decompressedFile.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        decompressed = decompressedFile.readAll();
+        held = decompressed.size();
+    }
+
+    if (peakHeld) {
+        *peakHeld = held;
+    }
+    return decompressed.size();
+}
+
+void DecompressionBenchmark::_benchmarkDecompress(void)
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, streamed);
+
+    qint64 size = 0;
+    QBENCHMARK {
+        size = _decompress(fileName, streamed);
+    }
+    QCOMPARE(size, _manifestSize);
+}
+
+void DecompressionBenchmark::_benchmarkPeakMemory_data(void)
+{
+    _benchmarkDecompress_data();
+}
+
+void DecompressionBenchmark::_benchmarkPeakMemory(void)
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, streamed);
+
+    qint64 peakHeld = 0;
+    QCOMPARE(_decompress(fileName, streamed, &peakHeld), _manifestSize);
+    QVERIFY(peakHeld > 0);
+    if (streamed) {
+        QVERIFY(peakHeld < _manifestSize);
+    }
+
+    QTest::setBenchmarkResult(peakHeld, QTest::BytesAllocated);
+}
+
+void DecompressionBenchmark::_benchmarkUnzip_data(void)
+{
+    QTest::addColumn<int>("maxThreads");
+
+    QTest::newRow("1 thread")       << 1;
+    QTest::newRow("ideal threads")  << 0;
+}
+
+void DecompressionBenchmark::_benchmarkUnzip(void)
+{
+    QFETCH(int, maxThreads);
+
+    int run = 0;
+    QBENCHMARK {
+        const QString extractPath = _tempDir.filePath(QStringLiteral("extract%1_%2").arg(maxThreads).arg(run++));
+        QVERIFY(QGCZip::unzipFile(_zipFileName, extractPath, maxThreads));
+    }
+}
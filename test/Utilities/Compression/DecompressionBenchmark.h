@@ -0,0 +1,43 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QTemporaryDir>
+
+/// Time and peak memory of buffered and streamed decompression of the manifest, and serial and parallel unzip of a
+/// many entry archive.
+/// Only run when requested with --unittest:DecompressionBenchmark.
+class DecompressionBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void _benchmarkDecompress_data(void);
+    void _benchmarkDecompress(void);
+    void _benchmarkPeakMemory_data(void);
+    void _benchmarkPeakMemory(void);
+    void _benchmarkUnzip_data(void);
+    void _benchmarkUnzip(void);
+
+private:
+    /// Decompresses fileName, buffered the way loading was done before streaming or streamed with QGCDecompressDevice
+    ///     @param peakHeld Largest amount of compressed and decompressed data held at once, decoder state not included
+    /// @return Decompressed size, -1 on failure
+    qint64 _decompress(const QString &fileName, bool streamed, qint64 *peakHeld = nullptr);
+
+    QTemporaryDir   _tempDir;
+    QString         _zipFileName;
+    qint64          _manifestSize = 0;
+
+    static constexpr int kZipEntries = 16;
+};
@@ -1,10 +1,41 @@
 #include "DecompressionTest.h"
+#include "QGCDecompressDevice.h"
 #include "QGCLZMA.h"
 #include "QGCZlib.h"
 #include "QGCZip.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QXmlStreamReader>
 #include <QtTest/QTest>
 
+namespace {
+
+struct StreamResult {
+    QByteArray  hash;
+    qint64      size = 0;
+    bool        finished = false;
+};
+
+/// Reads the whole device in fixed size chunks, never holding more than one chunk
+StreamResult readInChunks(QIODevice *device, qint64 chunkSize)
+{
+    StreamResult result;
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    qint64 bytesRead;
+    while ((bytesRead = device->read(chunk.data(), chunkSize)) > 0) {
+        hash.addData(QByteArrayView(chunk.constData(), bytesRead));
+        result.size += bytesRead;
+    }
+    result.hash = hash.result();
+    return result;
+}
+
+}
+
 void DecompressionTest::_testDecompressGzip()
 {
     const QString gzippedFileName = QStringLiteral(":/manifest.json.gz");
@@ -21,6 +52,21 @@ void DecompressionTest::_testDecompressLZMA()
 	QVERIFY(result);
 }
 
+void DecompressionTest::_testDecompressLZMAData()
+{
+    QFile lzmaFile(QStringLiteral(":/manifest.json.xz"));
+    QVERIFY(lzmaFile.open(QIODevice::ReadOnly));
+    const QByteArray lzmaData = lzmaFile.readAll();
+    QVERIFY(QGCLZMA::isLZMAData(lzmaData));
+
+    QByteArray decompressedData;
+    QVERIFY(QGCLZMA::inflateLZMAData(lzmaData, decompressedData));
+    QVERIFY(decompressedData.startsWith('{'));
+    QVERIFY(!QGCLZMA::isLZMAData(decompressedData));
+
+    QVERIFY(!QGCLZMA::inflateLZMAData(lzmaData.left(lzmaData.size() / 2), decompressedData));
+}
+
 void DecompressionTest::_testUnzip()
 {
     const QString zipFilename = QStringLiteral(":/manifest.json.zip");
@@ -28,3 +74,126 @@ void DecompressionTest::_testUnzip()
     const bool result = QGCZip::unzipFile(zipFilename, decompressedPath);
     QVERIFY(result);
 }
+
+void DecompressionTest::_testDecompressDevice()
+{
+    QFile lzmaFile(QStringLiteral(":/manifest.json.xz"));
+    QVERIFY(lzmaFile.open(QIODevice::ReadOnly));
+    QByteArray expected;
+    QVERIFY(QGCLZMA::inflateLZMAData(lzmaFile.readAll(), expected));
+    const QByteArray expectedHash = QCryptographicHash::hash(expected, QCryptographicHash::Sha256);
+
+    for (const QString &fileName : { QStringLiteral(":/manifest.json.xz"), QStringLiteral(":/manifest.json.gz") }) {
+        // Odd chunk sizes make the output cross decoder buffer boundaries
+        for (const qint64 chunkSize : { 1000, 4096, 1024 * 1024 }) {
+            QFile file(fileName);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QGCDecompressDevice decompressor(&file);
+            QVERIFY2(decompressor.open(QIODevice::ReadOnly), qPrintable(decompressor.errorString()));
+            QCOMPARE(decompressor.format(), fileName.endsWith(QStringLiteral(".xz")) ? QGCDecompressDevice::Xz : QGCDecompressDevice::Gzip);
+            QVERIFY(decompressor.isSequential());
+
+            const StreamResult result = readInChunks(&decompressor, chunkSize);
+            QVERIFY(decompressor.isFinished());
+            QVERIFY(decompressor.atEnd());
+            QCOMPARE(result.size, static_cast<qint64>(expected.size()));
+            QCOMPARE(result.hash, expectedHash);
+            QCOMPARE(decompressor.decompressedBytesRead(), static_cast<qint64>(expected.size()));
+            QCOMPARE(decompressor.compressedBytesRead(), file.size());
+        }
+    }
+}
+
+void DecompressionTest::_testDecompressDeviceXml()
+{
+    // qCompress output is a zlib stream behind a four byte size
+    QByteArray xml = "<?xml version=\"1.0\"?><items>";
+    static constexpr int kItems = 10000;
+    for (int i = 0; i < kItems; i++) {
+        xml += QStringLiteral("<item index=\"%1\"/>").arg(i).toUtf8();
+    }
+    xml += "</items>";
+    QByteArray compressed = qCompress(xml).mid(4);
+    QCOMPARE(QGCDecompressDevice::detectFormat(compressed), QGCDecompressDevice::Zlib);
+
+    QBuffer buffer(&compressed);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QGCDecompressDevice decompressor(&buffer);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+
+    QXmlStreamReader reader(&decompressor);
+    int items = 0;
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement && reader.name() == QStringLiteral("item")) {
+            QCOMPARE(reader.attributes().value(QStringLiteral("index")).toInt(), items);
+            items++;
+        }
+    }
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(items, kItems);
+}
+
+void DecompressionTest::_testDecompressDeviceErrors()
+{
+    // Not compressed
+    QByteArray plain("{ \"a\": 1 }");
+    QBuffer plainBuffer(&plain);
+    QVERIFY(plainBuffer.open(QIODevice::ReadOnly));
+    QGCDecompressDevice plainDecompressor(&plainBuffer);
+    QVERIFY(!plainDecompressor.open(QIODevice::ReadOnly));
+    QCOMPARE(plainDecompressor.format(), QGCDecompressDevice::Unknown);
+
+    // Write is refused
+    QGCDecompressDevice writeDecompressor(&plainBuffer, QGCDecompressDevice::Gzip);
+    QVERIFY(!writeDecompressor.open(QIODevice::ReadWrite));
+
+    // Truncated and corrupt streams fail the read instead of ending quietly
+    for (const QString &fileName : { QStringLiteral(":/manifest.json.xz"), QStringLiteral(":/manifest.json.gz") }) {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const QByteArray bytes = file.readAll();
+
+        QByteArray truncated = bytes.left(bytes.size() / 2);
+        QByteArray corrupt = bytes;
+        for (qsizetype i = corrupt.size() / 2; i < (corrupt.size() / 2) + 64; i++) {
+            corrupt[i] = static_cast<char>(~corrupt[i]);
+        }
+
+        for (QByteArray *data : { &truncated, &corrupt }) {
+            QBuffer buffer(data);
+            QVERIFY(buffer.open(QIODevice::ReadOnly));
+            QGCDecompressDevice decompressor(&buffer);
+            QVERIFY(decompressor.open(QIODevice::ReadOnly));
+            (void) readInChunks(&decompressor, 64 * 1024);
+            QVERIFY(!decompressor.isFinished());
+            QVERIFY(decompressor.atEnd());
+            QCOMPARE(decompressor.read(1), QByteArray());
+        }
+    }
+}
+
+void DecompressionTest::_testUnzipParallel()
+{
+    QTemporaryDir sourceDir;
+    QTemporaryDir outputDir;
+    QVERIFY(sourceDir.isValid() && outputDir.isValid());
+
+    static constexpr int kFiles = 9;
+    for (int i = 0; i < kFiles; i++) {
+        QFile file(sourceDir.filePath(QStringLiteral("file%1.txt").arg(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        (void) file.write(QByteArray(1000 * (i + 1), static_cast<char>('a' + i)));
+    }
+    const QString zipFileName = outputDir.filePath(QStringLiteral("files.zip"));
+    QVERIFY(QGCZip::zipDirectory(sourceDir.path(), zipFileName));
+
+    for (const int maxThreads : { 1, 4, 0 }) {
+        const QString extractPath = outputDir.filePath(QStringLiteral("extract%1").arg(maxThreads));
+        QVERIFY(QGCZip::unzipFile(zipFileName, extractPath, maxThreads));
+        for (int i = 0; i < kFiles; i++) {
+            QFile file(extractPath + QStringLiteral("/file%1.txt").arg(i));
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QCOMPARE(file.readAll(), QByteArray(1000 * (i + 1), static_cast<char>('a' + i)));
+        }
+    }
+}
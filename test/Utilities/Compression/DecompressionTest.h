@@ -9,5 +9,10 @@ class DecompressionTest : public UnitTest
 private slots:
     void _testDecompressGzip();
     void _testDecompressLZMA();
+    void _testDecompressLZMAData();
     void _testUnzip();
+    void _testDecompressDevice();
+    void _testDecompressDeviceXml();
+    void _testDecompressDeviceErrors();
+    void _testUnzipParallel();
 };
@@ -0,0 +1,83 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "JsonHelperBenchmark.h"
+#include "JsonHelperTest.h"
+#include "JsonHelper.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFuture>
+#include <QtCore/QJsonArray>
+#include <QtCore/QTimer>
+#include <QtTest/QTest>
+
+void JsonHelperBenchmark::initTestCase(void)
+{
+    const JsonHelper::JsonFile jsonFile = JsonHelper::loadJsonFile(JsonHelperTest::kCompressedManifest);
+    QVERIFY2(jsonFile.isValid(), qPrintable(jsonFile.errorString));
+
+    const QJsonArray firmwareArray = jsonFile.jsonDoc.object().value("firmware").toArray();
+    _rgFirmware.reserve(firmwareArray.count());
+    for (const QJsonValue& value : firmwareArray) {
+        _rgFirmware.append(value.toObject());
+    }
+    QVERIFY(!_rgFirmware.isEmpty());
+}
+
+void JsonHelperBenchmark::_benchmarkLoad(void)
+{
+    JsonHelper::JsonFile jsonFile;
+    QBENCHMARK {
+        jsonFile = JsonHelper::loadJsonFile(JsonHelperTest::kCompressedManifest);
+    }
+    QVERIFY(jsonFile.isValid());
+}
+
+void JsonHelperBenchmark::_benchmarkLoadAsyncStall(void)
+{
+    // Longest stall of the event loop while the file loads, measured by a timer which should fire continuously
+    QElapsedTimer tickTimer;
+    qint64 maxTickGapMsecs = 0;
+    QTimer ticker;
+    ticker.setInterval(0);
+    (void) connect(&ticker, &QTimer::timeout, this, [&]() {
+        maxTickGapMsecs = qMax(maxTickGapMsecs, tickTimer.restart());
+    });
+
+    tickTimer.start();
+    ticker.start();
+    QFuture<JsonHelper::JsonFile> future = JsonHelper::loadJsonFileAsync(JsonHelperTest::kCompressedManifest);
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 30000);
+    ticker.stop();
+    QVERIFY(future.result().isValid());
+
+    QTest::setBenchmarkResult(maxTickGapMsecs, QTest::WalltimeMilliseconds);
+}
+
+void JsonHelperBenchmark::_benchmarkValidateKeys(void)
+{
+    const QList<JsonHelper::KeyValidateInfo> keyInfoList = JsonHelperTest::manifestKeyInfoList();
+    QString errorString;
+    QBENCHMARK {
+        for (const QJsonObject& firmware : std::as_const(_rgFirmware)) {
+            QVERIFY2(JsonHelper::validateKeys(firmware, keyInfoList, errorString), qPrintable(errorString));
+        }
+    }
+}
+
+void JsonHelperBenchmark::_benchmarkKeyValidator(void)
+{
+    const JsonHelper::KeyValidator keyValidator(JsonHelperTest::manifestKeyInfoList());
+    QString errorString;
+    QBENCHMARK {
+        for (const QJsonObject& firmware : std::as_const(_rgFirmware)) {
+            QVERIFY2(keyValidator.validate(firmware, errorString), qPrintable(errorString));
+        }
+    }
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QJsonObject>
+
+/// Load time of a large compressed json file and key validation of its entries.
+/// Only run when requested with --unittest:JsonHelperBenchmark.
+class JsonHelperBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void _benchmarkLoad(void);
+    void _benchmarkLoadAsyncStall(void);
+    void _benchmarkValidateKeys(void);
+    void _benchmarkKeyValidator(void);
+
+private:
+    QList<QJsonObject> _rgFirmware;
+};
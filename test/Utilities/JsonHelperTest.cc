@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "JsonHelperTest.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QFuture>
+#include <QtCore/QJsonArray>
+#include <QtTest/QTest>
+
+QList<JsonHelper::KeyValidateInfo> JsonHelperTest::manifestKeyInfoList(void)
+{
+    return {
+        { "mav-autopilot",              QJsonValue::String, true },
+        { "vehicletype",                QJsonValue::String, true },
+        { "platform",                   QJsonValue::String, true },
+        { "git-sha",                    QJsonValue::String, true },
+        { "url",                        QJsonValue::String, true },
+        { "mav-type",                   QJsonValue::String, true },
+        { "mav-firmware-version-type",  QJsonValue::String, true },
+        { "latest",                     QJsonValue::Double, true },
+        { "format",                     QJsonValue::String, true },
+        { "board_id",                   QJsonValue::Double, false },
+        { "brand_name",                 QJsonValue::String, false },
+        { "USBID",                      QJsonValue::Array,  false },
+        { "bootloader_str",             QJsonValue::Array,  false },
+    };
+}
+
+QString JsonHelperTest::_writeTempFile(const QString& fileTemplate, const QByteArray& bytes)
+{
+    QGCTemporaryFile file(fileTemplate);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    (void) file.write(bytes);
+    file.close();
+    return file.fileName();
+}
+
+void JsonHelperTest::_testLoadJsonFile(void)
+{
+    const QString fileName = _writeTempFile(QStringLiteral("JsonHelperTest.XXXXXX.json"), QByteArrayLiteral("{ \"a\": 1, \"b\": [ \"c\" ] }"));
+    QVERIFY(!fileName.isEmpty());
+
+    const JsonHelper::JsonFile jsonFile = JsonHelper::loadJsonFile(fileName);
+    QVERIFY2(jsonFile.isValid(), qPrintable(jsonFile.errorString));
+    QCOMPARE(jsonFile.fileName, fileName);
+    QCOMPARE(jsonFile.jsonDoc.object().value("a").toInt(), 1);
+    QCOMPARE(jsonFile.jsonDoc.object().value("b").toArray().first().toString(), QStringLiteral("c"));
+
+    QJsonDocument jsonDoc;
+    QString errorString;
+    QVERIFY(JsonHelper::isJsonFile(fileName, jsonDoc, errorString));
+    QCOMPARE(jsonDoc, jsonFile.jsonDoc);
+
+    QFile::remove(fileName);
+}
+
+void JsonHelperTest::_testLoadCompressedJsonFile(void)
+{
+    const JsonHelper::JsonFile jsonFile = JsonHelper::loadJsonFile(kCompressedManifest);
+    QVERIFY2(jsonFile.isValid(), qPrintable(jsonFile.errorString));
+    QVERIFY(jsonFile.jsonDoc.isObject());
+    QCOMPARE(jsonFile.jsonDoc.object().value("format-version").toString(), QStringLiteral("1.0.0"));
+    QVERIFY(jsonFile.jsonDoc.object().value("firmware").toArray().count() > 0);
+
+    const JsonHelper::KeyValidator keyValidator(manifestKeyInfoList());
+    const QJsonArray firmwareArray = jsonFile.jsonDoc.object().value("firmware").toArray();
+    for (const QJsonValue& value : firmwareArray) {
+        QString validatorErrorString;
+        QVERIFY2(keyValidator.validate(value.toObject(), validatorErrorString), qPrintable(validatorErrorString));
+    }
+
+    const JsonHelper::JsonFile gzipFile = JsonHelper::loadJsonFile(QStringLiteral(":/manifest.json.gz"));
+    QVERIFY2(gzipFile.isValid(), qPrintable(gzipFile.errorString));
+    QCOMPARE(gzipFile.jsonDoc, jsonFile.jsonDoc);
+
+    QJsonDocument jsonDoc;
+    QString errorString;
+    QVERIFY(JsonHelper::isJsonFile(kCompressedManifest, jsonDoc, errorString));
+}
+
+void JsonHelperTest::_testLoadErrors(void)
+{
+    JsonHelper::JsonFile jsonFile = JsonHelper::loadJsonFile(QStringLiteral(":/JsonHelperTest/missing.json"));
+    QVERIFY(!jsonFile.isValid());
+    QVERIFY(jsonFile.jsonDoc.isNull());
+    QVERIFY2(jsonFile.errorString.startsWith(QStringLiteral("Unable to open file")), qPrintable(jsonFile.errorString));
+
+    const QString badJsonFileName = _writeTempFile(QStringLiteral("JsonHelperTest.XXXXXX.json"), QByteArrayLiteral("{ \"a\": "));
+    jsonFile = JsonHelper::loadJsonFile(badJsonFileName);
+    QVERIFY(!jsonFile.isValid());
+    QVERIFY(jsonFile.jsonDoc.isNull());
+    QVERIFY2(jsonFile.errorString.startsWith(QStringLiteral("Unable to parse json file")), qPrintable(jsonFile.errorString));
+    QFile::remove(badJsonFileName);
+
+    // Valid xz header followed by garbage
+    const QString badXZFileName = _writeTempFile(QStringLiteral("JsonHelperTest.XXXXXX.json.xz"), QByteArray::fromHex("fd377a585a00") + QByteArray(64, 'x'));
+    jsonFile = JsonHelper::loadJsonFile(badXZFileName);
+    QVERIFY(!jsonFile.isValid());
+    QVERIFY2(jsonFile.errorString.startsWith(QStringLiteral("Unable to decompress file")), qPrintable(jsonFile.errorString));
+    QFile::remove(badXZFileName);
+
+    // Load errors pass through the internal file checks unchanged
+    int version = 0;
+    QString errorString;
+    const QJsonObject jsonObject = JsonHelper::openInternalQGCJsonFile(jsonFile, QStringLiteral("Test"), 1, 1, version, errorString);
+    QVERIFY(jsonObject.isEmpty());
+    QCOMPARE(errorString, jsonFile.errorString);
+}
+
+void JsonHelperTest::_testLoadAsync(void)
+{
+    QFuture<JsonHelper::JsonFile> future = JsonHelper::loadJsonFileAsync(kCompressedManifest);
+    const JsonHelper::JsonFile syncFile = JsonHelper::loadJsonFile(kCompressedManifest);
+    const JsonHelper::JsonFile asyncFile = future.result();
+
+    QVERIFY2(asyncFile.isValid(), qPrintable(asyncFile.errorString));
+    QCOMPARE(asyncFile.jsonDoc, syncFile.jsonDoc);
+}
+
+void JsonHelperTest::_testKeyValidator(void)
+{
+    const QList<JsonHelper::KeyValidateInfo> keyInfoList = {
+        { "string",     QJsonValue::String, true },
+        { "double",     QJsonValue::Double, true },
+        { "array",      QJsonValue::Array,  true },
+        { "optional",   QJsonValue::Bool,   false },
+    };
+    const JsonHelper::KeyValidator keyValidator(keyInfoList);
+
+    const QList<QJsonObject> rgObjects = {
+        { { "string", "a" }, { "double", 1.0 }, { "array", QJsonArray() } },
+        { { "string", "a" }, { "double", QJsonValue::Null }, { "array", QJsonArray() }, { "optional", true } },
+        { { "string", "a" }, { "double", 1.0 }, { "array", QJsonArray() }, { "unknown", 1 } },
+        { { "double", 1.0 } },
+        { },
+        { { "string", 1 }, { "double", "a" }, { "array", QJsonArray() } },
+        { { "string", "a" }, { "double", 1.0 }, { "array", QJsonArray() }, { "optional", 1 } },
+        { { "double", "a" } },
+    };
+    const QList<bool> rgValid = { true, true, true, false, false, false, false, false };
+
+    for (int i=0; i<rgObjects.count(); i++) {
+        QString errorString;
+        QString validatorErrorString;
+        QCOMPARE(JsonHelper::validateKeys(rgObjects[i], keyInfoList, errorString), rgValid[i]);
+        QCOMPARE(keyValidator.validate(rgObjects[i], validatorErrorString), rgValid[i]);
+        QCOMPARE(validatorErrorString, errorString);
+    }
+
+    // Missing keys are reported before type errors, all of them in key order
+    QString errorString;
+    QVERIFY(!keyValidator.validate(rgObjects[7], errorString));
+    QCOMPARE(errorString, QStringLiteral("The following required keys are missing: string, array"));
+    QVERIFY(!keyValidator.validate(rgObjects[5], errorString));
+    QCOMPARE(errorString, QStringLiteral("Incorrect value type - key:type:expected string:Double:String"));
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "JsonHelper.h"
+
+class JsonHelperTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// Keys of an entry of the ArduPilot firmware manifest
+    static QList<JsonHelper::KeyValidateInfo> manifestKeyInfoList(void);
+
+    static constexpr const char* kCompressedManifest = ":/manifest.json.xz";
+
+private slots:
+    void _testLoadJsonFile(void);
+    void _testLoadCompressedJsonFile(void);
+    void _testLoadErrors(void);
+    void _testLoadAsync(void);
+    void _testKeyValidator(void);
+
+private:
+    QString _writeTempFile(const QString& fileTemplate, const QByteArray& bytes);
+};
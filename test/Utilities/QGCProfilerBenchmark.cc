@@ -0,0 +1,51 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCProfilerBenchmark.h"
+#include "QGCProfiler.h"
+
+#include <QtTest/QTest>
+
+namespace {
+
+int profiledScope()
+{
+    QGC_PROFILE_SCOPE("QGCProfilerBenchmark::profiledScope");
+
+    volatile int value = 0;
+    return value;
+}
+
+} // namespace
+
+void QGCProfilerBenchmark::cleanup(void)
+{
+    QGCProfiler::instance()->setEnabled(false);
+    QGCProfiler::instance()->reset();
+
+    UnitTest::cleanup();
+}
+
+void QGCProfilerBenchmark::_benchmarkScopeEnabled(void)
+{
+    QGCProfiler::instance()->setEnabled(true);
+
+    QBENCHMARK {
+        (void) profiledScope();
+    }
+}
+
+void QGCProfilerBenchmark::_benchmarkScopeDisabled(void)
+{
+    QGCProfiler::instance()->setEnabled(false);
+
+    QBENCHMARK {
+        (void) profiledScope();
+    }
+}
@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Cost of a profiled scope with profiling on and off. Only run when requested with --unittest:QGCProfilerBenchmark.
+class QGCProfilerBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    void cleanup(void) override;
+
+private slots:
+    void _benchmarkScopeEnabled(void);
+    void _benchmarkScopeDisabled(void);
+};
@@ -0,0 +1,268 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCProfilerTest.h"
+#include "QGCProfiler.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr const char* kWorkSite = "QGCProfilerTest::work";
+
+int work(int iterations)
+{
+    QGC_PROFILE_SCOPE("QGCProfilerTest::work");
+
+    volatile int sum = 0;
+    for (int i = 0; i < iterations; i++) {
+        sum = sum + i;
+    }
+    return sum;
+}
+
+void countItems(quint64 items)
+{
+    QGC_PROFILE_COUNT("QGCProfilerTest::items", items);
+}
+
+QList<QGCProfiler::SiteStats> statsFor(const QString &name)
+{
+    QList<QGCProfiler::SiteStats> result;
+    const QList<QGCProfiler::SiteStats> allStats = QGCProfiler::instance()->stats();
+    for (const QGCProfiler::SiteStats &stats : allStats) {
+        if (stats.name == name) {
+            result.append(stats);
+        }
+    }
+    return result;
+}
+
+int traceEventCount(const QJsonArray &traceEvents, const QString &name)
+{
+    int count = 0;
+    for (const QJsonValue &event : traceEvents) {
+        if ((event.toObject().value("ph").toString() == QStringLiteral("X")) && (event.toObject().value("name").toString() == name)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+void QGCProfilerTest::init(void)
+{
+    UnitTest::init();
+
+    QGCProfiler::instance()->setEnabled(true);
+    QGCProfiler::instance()->reset();
+}
+
+void QGCProfilerTest::cleanup(void)
+{
+    QGCProfiler::instance()->setEnabled(false);
+    QGCProfiler::instance()->reset();
+
+    UnitTest::cleanup();
+}
+
+void QGCProfilerTest::_testDisabled(void)
+{
+    QGCProfiler::instance()->setEnabled(false);
+    QVERIFY(!QGCProfiler::isEnabled());
+
+    for (int i = 0; i < 100; i++) {
+        (void) work(10);
+        countItems(1);
+    }
+
+    QVERIFY(statsFor(kWorkSite).isEmpty());
+    QVERIFY(statsFor("QGCProfilerTest::items").isEmpty());
+}
+
+void QGCProfilerTest::_testScopeAndCount(void)
+{
+    static constexpr int kCalls = 100;
+    for (int i = 0; i < kCalls; i++) {
+        (void) work(1000);
+        countItems(3);
+    }
+
+    const QList<QGCProfiler::SiteStats> workStats = statsFor(kWorkSite);
+    QCOMPARE(workStats.count(), 1);
+    const QGCProfiler::SiteStats &stats = workStats.first();
+    QCOMPARE(stats.thread, QStringLiteral("Main"));
+    QCOMPARE(stats.count, static_cast<quint64>(kCalls));
+    QVERIFY(stats.totalNsecs > 0);
+    QVERIFY(stats.maxNsecs * kCalls >= stats.totalNsecs);
+    QVERIFY(stats.p50Nsecs > 0);
+    QVERIFY(stats.p50Nsecs <= stats.p95Nsecs);
+    QVERIFY(stats.p95Nsecs <= stats.maxNsecs);
+
+    const QList<QGCProfiler::SiteStats> itemStats = statsFor("QGCProfilerTest::items");
+    QCOMPARE(itemStats.count(), 1);
+    QCOMPARE(itemStats.first().count, static_cast<quint64>(kCalls * 3));
+    QCOMPARE(itemStats.first().totalNsecs, static_cast<quint64>(0));
+
+    // The qml summary follows a refresh
+    QGCProfiler::instance()->refresh();
+    bool found = false;
+    const QVariantList summary = QGCProfiler::instance()->summary();
+    for (const QVariant &row : summary) {
+        if (row.toMap().value("name").toString() == QLatin1String(kWorkSite)) {
+            QCOMPARE(row.toMap().value("count").toULongLong(), static_cast<quint64>(kCalls));
+            found = true;
+        }
+    }
+    QVERIFY(found);
+
+    QGCProfiler::instance()->reset();
+    QVERIFY(statsFor(kWorkSite).isEmpty());
+}
+
+void QGCProfilerTest::_testThreads(void)
+{
+    static constexpr int kThreads = 4;
+    static constexpr int kCalls = 5000;
+
+    QList<QThread*> threads;
+    for (int i = 0; i < kThreads; i++) {
+        QThread *const thread = QThread::create([]() {
+            for (int call = 0; call < kCalls; call++) {
+                (void) work(10);
+            }
+        });
+        thread->setObjectName(QStringLiteral("QGCProfilerTest %1").arg(i));
+        threads.append(thread);
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait(30000));
+    }
+    qDeleteAll(threads);
+
+    // Each thread records on its own, nothing is lost
+    const QList<QGCProfiler::SiteStats> workStats = statsFor(kWorkSite);
+    QCOMPARE(workStats.count(), kThreads);
+    for (const QGCProfiler::SiteStats &stats : workStats) {
+        QVERIFY2(stats.thread.startsWith(QStringLiteral("QGCProfilerTest ")), qPrintable(stats.thread));
+        QCOMPARE(stats.count, static_cast<quint64>(kCalls));
+    }
+}
+
+void QGCProfilerTest::_testExitedThreads(void)
+{
+    static constexpr int kRounds = 3;
+    static constexpr int kThreads = 4;
+    static constexpr int kCalls = 100;
+
+    // Thread churn, as from thread pools and links coming and going
+    for (int round = 0; round < kRounds; round++) {
+        QList<QThread*> threads;
+        for (int i = 0; i < kThreads; i++) {
+            QThread *const thread = QThread::create([]() {
+                for (int call = 0; call < kCalls; call++) {
+                    (void) work(10);
+                }
+            });
+            if (i == 0) {
+                thread->setObjectName(QStringLiteral("QGCProfilerTest exiting"));
+            }
+            threads.append(thread);
+        }
+        for (QThread *thread : std::as_const(threads)) {
+            thread->start();
+            QVERIFY(thread->wait(30000));
+        }
+        qDeleteAll(threads);
+    }
+
+    // Thread local storage goes away after wait() returns, so the merge may lag behind a little
+    const auto exitedCount = [](const QString &thread) -> quint64 {
+        const QList<QGCProfiler::SiteStats> workStats = statsFor(kWorkSite);
+        for (const QGCProfiler::SiteStats &stats : workStats) {
+            if (stats.thread == thread) {
+                return stats.count;
+            }
+        }
+        return 0;
+    };
+    QTRY_COMPARE(exitedCount(QStringLiteral("QGCProfilerTest exiting")), static_cast<quint64>(kRounds * kCalls));
+    QTRY_COMPARE(exitedCount(QStringLiteral("Exited threads")), static_cast<quint64>(kRounds * (kThreads - 1) * kCalls));
+
+    // One entry per name remains
+    QCOMPARE(statsFor(kWorkSite).count(), 2);
+}
+
+void QGCProfilerTest::_testTraceExport(void)
+{
+    static constexpr int kCalls = 10;
+    for (int i = 0; i < kCalls; i++) {
+        (void) work(100);
+    }
+
+    const QString fileName = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QLatin1String("/QGCProfilerTest.json");
+    QVERIFY(QGCProfiler::instance()->exportTrace(fileName));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
+    QFile::remove(fileName);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const QJsonArray traceEvents = doc.object().value("traceEvents").toArray();
+    QCOMPARE(traceEventCount(traceEvents, kWorkSite), kCalls);
+
+    int mainTid = -1;
+    for (const QJsonValue &value : traceEvents) {
+        const QJsonObject event = value.toObject();
+        if ((event.value("ph").toString() == QStringLiteral("M")) && (event.value("args").toObject().value("name").toString() == QStringLiteral("Main"))) {
+            mainTid = event.value("tid").toInt();
+        }
+    }
+    QVERIFY(mainTid > 0);
+
+    double lastTs = -1;
+    for (const QJsonValue &value : traceEvents) {
+        const QJsonObject event = value.toObject();
+        if (event.value("name").toString() != QLatin1String(kWorkSite)) {
+            continue;
+        }
+        QCOMPARE(event.value("cat").toString(), QStringLiteral("QGCProfilerTest"));
+        QCOMPARE(event.value("tid").toInt(), mainTid);
+        QVERIFY(event.value("dur").toDouble() >= 0);
+        QVERIFY(event.value("ts").toDouble() >= lastTs);
+        lastTs = event.value("ts").toDouble();
+    }
+
+    // Only the most recent events of a thread are kept
+    for (int i = 0; i < QGCProfiler::kTraceEvents + 100; i++) {
+        (void) work(1);
+    }
+    const QJsonArray fullEvents = QJsonDocument::fromJson(QGCProfiler::instance()->traceJson()).object().value("traceEvents").toArray();
+    const int kept = traceEventCount(fullEvents, kWorkSite);
+    QVERIFY(kept >= QGCProfiler::kTraceEvents - 1);
+    QVERIFY(kept <= QGCProfiler::kTraceEvents);
+
+    // Reset drops the recorded events
+    QGCProfiler::instance()->reset();
+    const QJsonArray resetEvents = QJsonDocument::fromJson(QGCProfiler::instance()->traceJson()).object().value("traceEvents").toArray();
+    QCOMPARE(traceEventCount(resetEvents, kWorkSite), 0);
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCProfilerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init(void) final;
+    void cleanup(void) final;
+
+    void _testDisabled(void);
+    void _testScopeAndCount(void);
+    void _testThreads(void);
+    void _testExitedThreads(void);
+    void _testTraceExport(void);
+};
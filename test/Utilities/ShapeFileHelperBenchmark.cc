@@ -0,0 +1,68 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ShapeFileHelperBenchmark.h"
+#include "ShapeFileHelper.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+void ShapeFileHelperBenchmark::initTestCase(void)
+{
+    const QGeoCoordinate center(47.3764, 8.5481);
+    QRandomGenerator random(42);
+
+    _polygon.reserve(_vertexCount);
+    for (int i=0; i<_vertexCount; i++) {
+        _polygon.append(center.atDistanceAndAzimuth(5000 + ((random.generateDouble() - 0.5) * 0.5), (360.0 * i) / _vertexCount));
+    }
+
+    QString coordinates;
+    coordinates.reserve((_vertexCount + 1) * 32);
+    for (const QGeoCoordinate& coord : _polygon + QList<QGeoCoordinate>({ _polygon.first() })) {
+        coordinates += QString::number(coord.longitude(), 'f', 9) + QLatin1Char(',') + QString::number(coord.latitude(), 'f', 9) + QStringLiteral(",0 ");
+    }
+
+    _kmlFile = _tempDir.filePath(QStringLiteral("large.kml"));
+    QFile file(_kmlFile);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    (void) file.write(QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?><kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document><Placemark>"
+                                     "<Polygon><outerBoundaryIs><LinearRing><coordinates>\n").toUtf8());
+    (void) file.write(coordinates.toUtf8());
+    (void) file.write(QStringLiteral("\n</coordinates></LinearRing></outerBoundaryIs></Polygon></Placemark></Document></kml>").toUtf8());
+}
+
+void ShapeFileHelperBenchmark::_benchmarkDetermineShapeType(void)
+{
+    QString errorString;
+    QBENCHMARK {
+        QCOMPARE(ShapeFileHelper::determineShapeType(_kmlFile, errorString), ShapeFileHelper::Polygon);
+    }
+}
+
+void ShapeFileHelperBenchmark::_benchmarkLoad(void)
+{
+    QString errorString;
+    QList<QList<QGeoCoordinate>> polygons;
+    QBENCHMARK {
+        QVERIFY(ShapeFileHelper::loadPolygonsFromFile(_kmlFile, 0 /* toleranceMeters */, polygons, errorString));
+    }
+    QCOMPARE(polygons.count(), 1);
+    QCOMPARE(polygons[0].count(), _vertexCount);
+}
+
+void ShapeFileHelperBenchmark::_benchmarkSimplify(void)
+{
+    QList<QGeoCoordinate> simplified;
+    QBENCHMARK {
+        simplified = ShapeFileHelper::simplify(_polygon, 1.0, true /* closed */);
+    }
+    QVERIFY(simplified.count() < _vertexCount);
+}
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/QGeoCoordinate>
+
+/// Load and simplification time of a large KML polygon. Only run when requested with --unittest:ShapeFileHelperBenchmark.
+class ShapeFileHelperBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void _benchmarkDetermineShapeType(void);
+    void _benchmarkLoad(void);
+    void _benchmarkSimplify(void);
+
+private:
+    QTemporaryDir           _tempDir;
+    QString                 _kmlFile;
+    QList<QGeoCoordinate>   _polygon;
+
+    // Cadastral exports run to hundreds of thousands of vertices
+    static constexpr int    _vertexCount = 200000;
+};
@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ShapeFileHelperTest.h"
+#include "ShapeFileHelper.h"
+#include "KMLHelper.h"
+#include "QGCGeo.h"
+#include "QGCMapPolygon.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QtMath>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include <limits>
+
+QString ShapeFileHelperTest::_writeFile(const QString& name, const QByteArray& contents)
+{
+    const QString path = _tempDir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return QString();
+    }
+    (void) file.write(contents);
+    return path;
+}
+
+QString ShapeFileHelperTest::_kmlCoordinates(const QList<QGeoCoordinate>& coords)
+{
+    QString text;
+    text.reserve(coords.count() * 32);
+    for (const QGeoCoordinate& coord : coords) {
+        text += QString::number(coord.longitude(), 'f', 9) + QLatin1Char(',') + QString::number(coord.latitude(), 'f', 9) + QStringLiteral(",0 ");
+    }
+    return text;
+}
+
+/// KML polygon with the ring closed by repeating the first vertex, as required by the spec
+QString ShapeFileHelperTest::_kmlPolygon(const QList<QGeoCoordinate>& outer, const QList<QGeoCoordinate>& inner)
+{
+    QString kml = QStringLiteral("<Polygon><outerBoundaryIs><LinearRing><coordinates>\n") +
+                  _kmlCoordinates(outer + QList<QGeoCoordinate>({ outer.first() })) +
+                  QStringLiteral("\n</coordinates></LinearRing></outerBoundaryIs>");
+    if (!inner.isEmpty()) {
+        kml += QStringLiteral("<innerBoundaryIs><LinearRing><coordinates>") +
+               _kmlCoordinates(inner + QList<QGeoCoordinate>({ inner.first() })) +
+               QStringLiteral("</coordinates></LinearRing></innerBoundaryIs>");
+    }
+    return kml + QStringLiteral("</Polygon>");
+}
+
+QList<QGeoCoordinate> ShapeFileHelperTest::_noisyCircle(int count, double radius, double noise)
+{
+    QRandomGenerator random(42);
+    QList<QGeoCoordinate> coords;
+    coords.reserve(count);
+    for (int i=0; i<count; i++) {
+        // Clockwise
+        coords.append(_center.atDistanceAndAzimuth(radius + ((random.generateDouble() - 0.5) * noise), (360.0 * i) / count));
+    }
+    return coords;
+}
+
+bool ShapeFileHelperTest::_selfIntersects(const QList<QGeoCoordinate>& polygon)
+{
+    const QList<QPointF> points = QGCGeo::convertGeoToNed(polygon, polygon.first());
+    const int count = points.count();
+
+    auto orientation = [](const QPointF& a, const QPointF& b, const QPointF& c) {
+        const double cross = ((b.x() - a.x()) * (c.y() - a.y())) - ((b.y() - a.y()) * (c.x() - a.x()));
+        return (cross > 0) - (cross < 0);
+    };
+
+    for (int i=0; i<count; i++) {
+        const QPointF& a1 = points[i];
+        const QPointF& a2 = points[(i + 1) % count];
+        for (int j=i+2; j<count; j++) {
+            if (i == 0 && j == count - 1) {
+                continue;   // Adjacent through the closing edge
+            }
+            const QPointF& b1 = points[j];
+            const QPointF& b2 = points[(j + 1) % count];
+            if ((orientation(a1, a2, b1) != orientation(a1, a2, b2)) && (orientation(b1, b2, a1) != orientation(b1, b2, a2))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ShapeFileHelperTest::_testKMLMultiPolygon(void)
+{
+    // First polygon is counter-clockwise and must come back clockwise, second has a hole which must be skipped
+    const QList<QGeoCoordinate> square1({
+        _center,
+        _center.atDistanceAndAzimuth(100, 90),
+        _center.atDistanceAndAzimuth(141.42, 45),
+        _center.atDistanceAndAzimuth(100, 0),
+    });
+    const QGeoCoordinate center2 = _center.atDistanceAndAzimuth(1000, 90);
+    const QList<QGeoCoordinate> square2({
+        center2,
+        center2.atDistanceAndAzimuth(100, 0),
+        center2.atDistanceAndAzimuth(141.42, 45),
+        center2.atDistanceAndAzimuth(100, 90),
+    });
+    const QList<QGeoCoordinate> hole({
+        center2.atDistanceAndAzimuth(14.142, 45),
+        center2.atDistanceAndAzimuth(22.36, 63.43),
+        center2.atDistanceAndAzimuth(28.28, 45),
+    });
+
+    const QString kml = QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?><kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document>") +
+                        QStringLiteral("<Placemark>") + _kmlPolygon(square1) + QStringLiteral("</Placemark>") +
+                        QStringLiteral("<Placemark><LineString><coordinates>") + _kmlCoordinates(square1) + QStringLiteral("</coordinates></LineString></Placemark>") +
+                        QStringLiteral("<Placemark><MultiGeometry>") + _kmlPolygon(square2, hole) + QStringLiteral("</MultiGeometry></Placemark>") +
+                        QStringLiteral("</Document></kml>");
+    const QString file = _writeFile(QStringLiteral("multi.kml"), kml.toUtf8());
+
+    QString errorString;
+    QCOMPARE(ShapeFileHelper::determineShapeType(file, errorString), ShapeFileHelper::Polygon);
+    QVERIFY(errorString.isEmpty());
+
+    QList<QList<QGeoCoordinate>> polygons;
+    QVERIFY(ShapeFileHelper::loadPolygonsFromFile(file, 0 /* toleranceMeters */, polygons, errorString));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(polygons.count(), 2);
+
+    // Closing vertex removed, winding reversed
+    QCOMPARE(polygons[0].count(), 4);
+    QVERIFY(polygons[0][0].distanceTo(square1[3]) < 0.01);
+    QVERIFY(polygons[0][3].distanceTo(square1[0]) < 0.01);
+
+    // Already clockwise
+    QCOMPARE(polygons[1].count(), 4);
+    QVERIFY(polygons[1][0].distanceTo(square2[0]) < 0.01);
+
+    // Selection by index
+    QList<QGeoCoordinate> vertices;
+    QVERIFY(ShapeFileHelper::loadPolygonFromFile(file, vertices, errorString, 1));
+    QCOMPARE(vertices, polygons[1]);
+    QVERIFY(!ShapeFileHelper::loadPolygonFromFile(file, vertices, errorString, 2));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void ShapeFileHelperTest::_testKMLPolyline(void)
+{
+    const QList<QGeoCoordinate> line({
+        _center,
+        _center.atDistanceAndAzimuth(100, 90),
+        _center.atDistanceAndAzimuth(200, 90),
+    });
+    const QString kml = QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?><kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document><Placemark><LineString><coordinates>") +
+                        _kmlCoordinates(line) +
+                        QStringLiteral("</coordinates></LineString></Placemark></Document></kml>");
+    const QString file = _writeFile(QStringLiteral("line.kml"), kml.toUtf8());
+
+    QString errorString;
+    QCOMPARE(ShapeFileHelper::determineShapeType(file, errorString), ShapeFileHelper::Polyline);
+
+    QList<QGeoCoordinate> coords;
+    QVERIFY(KMLHelper::loadPolylineFromFile(file, coords, errorString));
+    QCOMPARE(coords.count(), line.count());
+    QVERIFY(coords.last().distanceTo(line.last()) < 0.01);
+
+    // Middle point is collinear and goes away with simplification
+    QVERIFY(ShapeFileHelper::loadPolylineFromFile(file, coords, errorString, 0, 1.0));
+    QCOMPARE(coords.count(), 2);
+
+    QList<QGeoCoordinate> vertices;
+    QVERIFY(!ShapeFileHelper::loadPolygonFromFile(file, vertices, errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void ShapeFileHelperTest::_testKMLParseError(void)
+{
+    const QString file = _writeFile(QStringLiteral("bad.kml"), QByteArrayLiteral("<kml><Document><Placemark><Polygon></Document>"));
+
+    QString errorString;
+    QList<QList<QGeoCoordinate>> polygons;
+    QVERIFY(!KMLHelper::loadPolygonsFromFile(file, polygons, errorString));
+    QVERIFY(!errorString.isEmpty());
+    QVERIFY(polygons.isEmpty());
+
+    QVERIFY(!KMLHelper::loadPolygonsFromFile(_tempDir.filePath(QStringLiteral("missing.kml")), polygons, errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void ShapeFileHelperTest::_testSimplifyTolerance(void)
+{
+    constexpr double tolerance = 1.0;
+    const QList<QGeoCoordinate> polygon = _noisyCircle(2000, 500, 0.2);
+    const QList<QGeoCoordinate> simplified = ShapeFileHelper::simplify(polygon, tolerance, true /* closed */);
+
+    QVERIFY(simplified.count() >= 3);
+    QVERIFY(simplified.count() < polygon.count() / 4);
+    QVERIFY(!_selfIntersects(simplified));
+
+    // Every source vertex must be within tolerance of the simplified ring
+    const QList<QPointF> sourcePoints = QGCGeo::convertGeoToNed(polygon, polygon.first());
+    const QList<QPointF> simplifiedPoints = QGCGeo::convertGeoToNed(simplified, polygon.first());
+    for (const QPointF& point : sourcePoints) {
+        double minDistance = std::numeric_limits<double>::max();
+        for (int i=0; i<simplifiedPoints.count(); i++) {
+            const QPointF a = simplifiedPoints[i];
+            const QPointF ab = simplifiedPoints[(i + 1) % simplifiedPoints.count()] - a;
+            const double length2 = QPointF::dotProduct(ab, ab);
+            const double t = length2 > 0 ? qBound(0.0, QPointF::dotProduct(point - a, ab) / length2, 1.0) : 0.0;
+            const QPointF delta = point - (a + (ab * t));
+            minDistance = qMin(minDistance, qSqrt(QPointF::dotProduct(delta, delta)));
+        }
+        QVERIFY2(minDistance <= tolerance + 0.001, qPrintable(QString::number(minDistance)));
+    }
+
+    // Zero tolerance is a no-op
+    QCOMPARE(ShapeFileHelper::simplify(polygon, 0, true).count(), polygon.count());
+}
+
+void ShapeFileHelperTest::_testSimplifyPreservesTopology(void)
+{
+    // A shallow dip in the bottom edge with a narrow notch reaching down into it from the top. The dip is within
+    // tolerance, so plain Douglas-Peucker flattens it and the bottom edge then cuts through the notch.
+    const QList<QPointF> ned({
+        QPointF(0, 0), QPointF(50, -2), QPointF(100, 0), QPointF(100, 10),
+        QPointF(90, 10), QPointF(80, 10), QPointF(70, 10), QPointF(60, 10),
+        QPointF(51, 10), QPointF(50, -1), QPointF(49, 10),
+        QPointF(40, 10), QPointF(20, 10), QPointF(0, 10),
+    });
+    const QList<QGeoCoordinate> polygon = QGCGeo::convertNedToGeo(ned, _center);
+    QVERIFY(!_selfIntersects(polygon));
+
+    const QList<QGeoCoordinate> simplified = ShapeFileHelper::simplify(polygon, 3.0, true /* closed */);
+    QVERIFY(!_selfIntersects(simplified));
+
+    // Collinear top edge vertices go away, the dip vertex has to stay
+    QCOMPARE(simplified.count(), 8);
+    QVERIFY(simplified.contains(polygon[1]));
+}
+
+void ShapeFileHelperTest::_testLoadAsync(void)
+{
+    const QString kml = QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?><kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document>") +
+                        QStringLiteral("<Placemark>") + _kmlPolygon(_noisyCircle(1000, 200, 0)) + QStringLiteral("</Placemark>") +
+                        QStringLiteral("<Placemark>") + _kmlPolygon(_noisyCircle(10, 50, 0)) + QStringLiteral("</Placemark>") +
+                        QStringLiteral("</Document></kml>");
+    const QString file = _writeFile(QStringLiteral("async.kml"), kml.toUtf8());
+
+    QGCMapPolygon mapPolygon(this);
+    QSignalSpy spy(&mapPolygon, &QGCMapPolygon::loadKMLOrSHPFileComplete);
+
+    mapPolygon.loadKMLOrSHPFileAsync(file, 1);
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy[0][0].toBool(), true);
+    QCOMPARE(spy[0][1].toInt(), 2);
+    QCOMPARE(mapPolygon.count(), 10);
+}
+
+/// Writes a single polygon entity with one part per ring as .shp/.shx, plus a WGS84 .prj
+QString ShapeFileHelperTest::_writeSHPPolygon(const QString& baseName, const QList<QList<QPointF>>& rings)
+{
+    int pointCount = 0;
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (const QList<QPointF>& ring : rings) {
+        pointCount += ring.count();
+        for (const QPointF& point : ring) {
+            minX = qMin(minX, point.x());
+            minY = qMin(minY, point.y());
+            maxX = qMax(maxX, point.x());
+            maxY = qMax(maxY, point.y());
+        }
+    }
+
+    auto writeHeader = [=](QDataStream& stream, qint32 fileLengthWords) {
+        stream.setByteOrder(QDataStream::BigEndian);
+        stream << qint32(9994) << qint32(0) << qint32(0) << qint32(0) << qint32(0) << qint32(0) << fileLengthWords;
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << qint32(1000) << qint32(5 /* SHPT_POLYGON */);
+        stream << minX << minY << maxX << maxY;
+        stream << 0.0 << 0.0 << 0.0 << 0.0;
+    };
+
+    const qint32 contentBytes = 4 + 32 + 4 + 4 + (4 * rings.count()) + (16 * pointCount);
+
+    QByteArray shp;
+    QDataStream shpStream(&shp, QIODevice::WriteOnly);
+    shpStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    writeHeader(shpStream, (100 + 8 + contentBytes) / 2);
+    shpStream.setByteOrder(QDataStream::BigEndian);
+    shpStream << qint32(1) << qint32(contentBytes / 2);
+    shpStream.setByteOrder(QDataStream::LittleEndian);
+    shpStream << qint32(5 /* SHPT_POLYGON */);
+    shpStream << minX << minY << maxX << maxY;
+    shpStream << qint32(rings.count()) << qint32(pointCount);
+    qint32 partStart = 0;
+    for (const QList<QPointF>& ring : rings) {
+        shpStream << partStart;
+        partStart += ring.count();
+    }
+    for (const QList<QPointF>& ring : rings) {
+        for (const QPointF& point : ring) {
+            shpStream << point.x() << point.y();
+        }
+    }
+
+    QByteArray shx;
+    QDataStream shxStream(&shx, QIODevice::WriteOnly);
+    shxStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    writeHeader(shxStream, (100 + 8) / 2);
+    shxStream.setByteOrder(QDataStream::BigEndian);
+    shxStream << qint32(100 / 2) << qint32(contentBytes / 2);
+
+    (void) _writeFile(baseName + QStringLiteral(".shx"), shx);
+    (void) _writeFile(baseName + QStringLiteral(".prj"), QByteArrayLiteral("GEOGCS[\"GCS_WGS_1984\",DATUM[\"D_WGS_1984\",SPHEROID[\"WGS_1984\",6378137,298.257223563]],PRIMEM[\"Greenwich\",0],UNIT[\"Degree\",0.0174532925199433]]"));
+    return _writeFile(baseName + QStringLiteral(".shp"), shp);
+}
+
+void ShapeFileHelperTest::_testSHPHolesByContainment(void)
+{
+    // Rings are closed by repeating the first vertex. Winding is deliberately wrong for the hole and the second
+    // outer ring, classification must come from containment alone.
+    const QList<QPointF> outer({ { 8.0, 47.0 }, { 8.0, 47.01 }, { 8.01, 47.01 }, { 8.01, 47.0 }, { 8.0, 47.0 } });             // Clockwise
+    const QList<QPointF> hole({ { 8.002, 47.002 }, { 8.002, 47.004 }, { 8.004, 47.004 }, { 8.004, 47.002 }, { 8.002, 47.002 } }); // Clockwise
+    const QList<QPointF> island({ { 8.02, 47.0 }, { 8.03, 47.0 }, { 8.03, 47.01 }, { 8.02, 47.01 }, { 8.02, 47.0 } });         // Counter-clockwise
+
+    const QString file = _writeSHPPolygon(QStringLiteral("holes"), { outer, hole, island });
+    QVERIFY(!file.isEmpty());
+
+    QString errorString;
+    QCOMPARE(ShapeFileHelper::determineShapeType(file, errorString), ShapeFileHelper::Polygon);
+
+    QList<QList<QGeoCoordinate>> polygons;
+    QVERIFY2(ShapeFileHelper::loadPolygonsFromFile(file, 0 /* toleranceMeters */, polygons, errorString), qPrintable(errorString));
+    QCOMPARE(polygons.count(), 2);
+    QCOMPARE(polygons[0].count(), 4);
+    QCOMPARE(polygons[1].count(), 4);
+    QVERIFY(polygons[0].contains(QGeoCoordinate(47.0, 8.0)));
+    QVERIFY(polygons[1].contains(QGeoCoordinate(47.0, 8.02)));
+}
+
+void ShapeFileHelperTest::_testSHPVertexFilter(void)
+{
+    // Vertices closer than 5m to the previous one are dropped, as are those closing the ring, even without simplification
+    const QList<QPointF> ring({
+        { 8.0, 47.0 },
+        { 8.0, 47.00002 },      // ~2.2m from the previous vertex
+        { 8.0, 47.01 },
+        { 8.00002, 47.01 },     // ~1.5m from the previous vertex
+        { 8.01, 47.01 },
+        { 8.01, 47.0 },
+        { 8.00001, 47.0 },      // ~0.8m from the first vertex
+        { 8.0, 47.0 },
+    });
+
+    const QString file = _writeSHPPolygon(QStringLiteral("filter"), { ring });
+    QVERIFY(!file.isEmpty());
+
+    QString errorString;
+    QList<QList<QGeoCoordinate>> polygons;
+    QVERIFY2(ShapeFileHelper::loadPolygonsFromFile(file, 0 /* toleranceMeters */, polygons, errorString), qPrintable(errorString));
+    QCOMPARE(polygons.count(), 1);
+    QCOMPARE(polygons[0].count(), 4);
+    for (const QPointF& corner : { QPointF(8.0, 47.0), QPointF(8.0, 47.01), QPointF(8.01, 47.01), QPointF(8.01, 47.0) }) {
+        QVERIFY(polygons[0].contains(QGeoCoordinate(corner.y(), corner.x())));
+    }
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QPointF>
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/QGeoCoordinate>
+
+class ShapeFileHelperTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testKMLMultiPolygon(void);
+    void _testKMLPolyline(void);
+    void _testKMLParseError(void);
+    void _testSimplifyTolerance(void);
+    void _testSimplifyPreservesTopology(void);
+    void _testLoadAsync(void);
+    void _testSHPHolesByContainment(void);
+    void _testSHPVertexFilter(void);
+
+private:
+    QString                 _writeFile      (const QString& name, const QByteArray& contents);
+    QString                 _kmlPolygon     (const QList<QGeoCoordinate>& outer, const QList<QGeoCoordinate>& inner = QList<QGeoCoordinate>());
+    QString                 _kmlCoordinates (const QList<QGeoCoordinate>& coords);
+    QString                 _writeSHPPolygon(const QString& baseName, const QList<QList<QPointF>>& rings);
+    QList<QGeoCoordinate>   _noisyCircle    (int count, double radius, double noise);
+    static bool             _selfIntersects (const QList<QGeoCoordinate>& polygon);
+
+    QTemporaryDir           _tempDir;
+    const QGeoCoordinate    _center{47.3764, 8.5481};
+};
@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SignalCompressionBenchmark.h"
+#include "SignalCompressionTest.h"
+#include "QGCApplication.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+void SignalCompressionBenchmark::cleanup(void)
+{
+    qgcApp()->removeCompressedSignal(CompressedSignalSender::valueChangedMethod());
+
+    UnitTest::cleanup();
+}
+
+void SignalCompressionBenchmark::_benchmarkCompressedPost_data(void)
+{
+    QTest::addColumn<int>("backlog");
+
+    QTest::newRow("100 pending")    << 100;
+    QTest::newRow("10000 pending")  << 10000;
+}
+
+void SignalCompressionBenchmark::_benchmarkCompressedPost(void)
+{
+    QFETCH(int, backlog);
+
+    qgcApp()->addCompressedSignal(CompressedSignalSender::valueChangedMethod());
+
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    receiver.connectTo(&sender);
+
+    // Calls which are not compressed, behind the pending compressed one
+    emit sender.valueChanged(0);
+    for (int i = 0; i < backlog; i++) {
+        emit sender.otherValueChanged(i);
+    }
+
+    int value = 0;
+    QBENCHMARK {
+        emit sender.valueChanged(++value);
+    }
+
+    receiver.deliver();
+    QCOMPARE(receiver.values, QList<int>({ value }));
+    QCOMPARE(receiver.otherValues.count(), backlog);
+}
+
+void SignalCompressionBenchmark::_addCompression(void)
+{
+    QTest::addColumn<bool>("compressed");
+
+    QTest::newRow("uncompressed")   << false;
+    QTest::newRow("compressed")     << true;
+}
+
+bool SignalCompressionBenchmark::_measureMockLinkLoad(bool compressed, Measurement &measurement)
+{
+    // Vehicle traffic keeps the event loop of the gui thread busy while a worker thread emits at a telemetry rate,
+    // as a link thread does
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    if (compressed) {
+        qgcApp()->addCompressedSignal(CompressedSignalSender::valueChangedMethod());
+    }
+
+    CompressedSignalSender sender;
+    int lastValue = -1;
+    QObject receiver;
+    (void) connect(&sender, &CompressedSignalSender::valueChanged, &receiver, [&](int value) {
+        // Stand-in for the bindings a value change reevaluates
+        measurement.deliveries++;
+        lastValue = value;
+        volatile double work = 0;
+        for (int i = 0; i < 20000; i++) {
+            work = work + i;
+        }
+    }, Qt::QueuedConnection);
+
+    QThread *const emitter = QThread::create([&sender]() {
+        for (int i = 0; i < kEmits; i++) {
+            emit sender.valueChanged(i);
+            if ((i % kBurst) == (kBurst - 1)) {
+                QThread::usleep(500);
+            }
+        }
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    emitter->start();
+    const bool finished = QTest::qWaitFor([emitter]() { return emitter->isFinished(); }, 30000) &&
+                          QTest::qWaitFor([&lastValue]() { return lastValue == kEmits - 1; }, 5000);
+    measurement.elapsedMs = timer.elapsed();
+    if (!finished) {
+        (void) emitter->wait();
+    }
+    delete emitter;
+
+    _disconnectMockLink();
+
+    return finished && (compressed ? (measurement.deliveries <= kEmits) : (measurement.deliveries == kEmits));
+}
+
+void SignalCompressionBenchmark::_benchmarkMockLinkLoad_data(void)
+{
+    _addCompression();
+}
+
+void SignalCompressionBenchmark::_benchmarkMockLinkLoad(void)
+{
+    QFETCH(bool, compressed);
+
+    Measurement measurement;
+    QVERIFY(_measureMockLinkLoad(compressed, measurement));
+
+    QTest::setBenchmarkResult(measurement.elapsedMs, QTest::WalltimeMilliseconds);
+}
+
+void SignalCompressionBenchmark::_benchmarkMockLinkDeliveries_data(void)
+{
+    _addCompression();
+}
+
+void SignalCompressionBenchmark::_benchmarkMockLinkDeliveries(void)
+{
+    QFETCH(bool, compressed);
+
+    Measurement measurement;
+    QVERIFY(_measureMockLinkLoad(compressed, measurement));
+
+    QTest::setBenchmarkResult(measurement.deliveries, QTest::Events);
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Cost of posting a compressed signal and delivery load with and without compression under vehicle traffic.
+/// Only run when requested with --unittest:SignalCompressionBenchmark.
+class SignalCompressionBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    void cleanup(void) override;
+
+private slots:
+    void _benchmarkCompressedPost_data(void);
+    void _benchmarkCompressedPost(void);
+    void _benchmarkMockLinkLoad_data(void);
+    void _benchmarkMockLinkLoad(void);
+    void _benchmarkMockLinkDeliveries_data(void);
+    void _benchmarkMockLinkDeliveries(void);
+
+private:
+    struct Measurement {
+        int     deliveries  = 0;    ///< Calls of the slot
+        qint64  elapsedMs   = 0;    ///< From the first emit until the last value was delivered
+    };
+
+    void _addCompression(void);
+    bool _measureMockLinkLoad(bool compressed, Measurement &measurement);
+
+    static constexpr int kEmits = 20000;
+    static constexpr int kBurst = 50;
+};
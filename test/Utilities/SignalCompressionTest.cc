@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SignalCompressionTest.h"
+#include "QGCApplication.h"
+
+#include <QtTest/QTest>
+
+void SignalCompressionTest::init(void)
+{
+    UnitTest::init();
+
+    qgcApp()->addCompressedSignal(CompressedSignalSender::valueChangedMethod());
+    qgcApp()->resetCompressedSignalStats();
+}
+
+void SignalCompressionTest::cleanup(void)
+{
+    qgcApp()->removeCompressedSignal(CompressedSignalSender::valueChangedMethod());
+
+    UnitTest::cleanup();
+}
+
+void SignalCompressionTest::_testLatestValueWins(void)
+{
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    receiver.connectTo(&sender);
+
+    static constexpr int kEmits = 100;
+    for (int i = 0; i < kEmits; i++) {
+        emit sender.valueChanged(i);
+        emit sender.otherValueChanged(i);
+    }
+    receiver.deliver();
+
+    QCOMPARE(receiver.values, QList<int>({ kEmits - 1 }));
+    QCOMPARE(receiver.otherValues.count(), kEmits);
+
+    const QGCApplication::CompressedSignalStats stats = qgcApp()->compressedSignalStats();
+    QCOMPARE(stats.queued, static_cast<quint64>(kEmits - 1));
+    QCOMPARE(stats.coalesced, static_cast<quint64>(kEmits - 1));
+
+    // Unregistered signals are left alone
+    qgcApp()->removeCompressedSignal(CompressedSignalSender::valueChangedMethod());
+    receiver.values.clear();
+    for (int i = 0; i < kEmits; i++) {
+        emit sender.valueChanged(i);
+    }
+    receiver.deliver();
+    QCOMPARE(receiver.values.count(), kEmits);
+}
+
+void SignalCompressionTest::_testPerReceiver(void)
+{
+    CompressedSignalSender sender;
+    CompressedSignalSender otherSender;
+    CompressedSignalReceiver receiver1;
+    CompressedSignalReceiver receiver2;
+    receiver1.connectTo(&sender);
+    receiver2.connectTo(&sender);
+    receiver2.connectTo(&otherSender);
+
+    for (int i = 0; i < 10; i++) {
+        emit sender.valueChanged(i);
+        emit otherSender.valueChanged(100 + i);
+    }
+    receiver1.deliver();
+    receiver2.deliver();
+
+    // One call per sender and receiver, holding the latest value
+    QCOMPARE(receiver1.values, QList<int>({ 9 }));
+    QCOMPARE(receiver2.values, QList<int>({ 9, 109 }));
+}
+
+void SignalCompressionTest::_testSubclassSender(void)
+{
+    DerivedCompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    receiver.connectTo(&sender);
+
+    for (int i = 0; i < 10; i++) {
+        emit sender.valueChanged(i);
+    }
+    receiver.deliver();
+
+    QCOMPARE(receiver.values, QList<int>({ 9 }));
+}
+
+void SignalCompressionTest::_testIndexedLookup(void)
+{
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    receiver.connectTo(&sender);
+
+    // A long backlog of calls which are not compressed, behind the first compressed one
+    static constexpr int kBacklog = 2000;
+    static constexpr int kEmits = 100;
+    emit sender.valueChanged(0);
+    for (int i = 0; i < kBacklog; i++) {
+        emit sender.otherValueChanged(i);
+    }
+    for (int i = 1; i < kEmits; i++) {
+        emit sender.valueChanged(i);
+    }
+
+    // Only the first duplicate had to be searched for
+    const QGCApplication::CompressedSignalStats stats = qgcApp()->compressedSignalStats();
+    QCOMPARE(stats.coalesced, static_cast<quint64>(kEmits - 1));
+    QCOMPARE(stats.indexHits, static_cast<quint64>(kEmits - 2));
+
+    receiver.deliver();
+    QCOMPARE(receiver.values, QList<int>({ kEmits - 1 }));
+    QCOMPARE(receiver.otherValues.count(), kBacklog);
+}
+
+void SignalCompressionTest::_testStaleIndex(void)
+{
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    receiver.connectTo(&sender);
+
+    // Keeps the posted events from being cleared, so the delivered call leaves a stale index entry behind
+    CompressedSignalReceiver bystander;
+    bystander.connectTo(&sender);
+
+    for (int i = 0; i < 10; i++) {
+        emit sender.valueChanged(i);
+    }
+    receiver.deliver();
+    QCOMPARE(receiver.values, QList<int>({ 9 }));
+    const quint64 scans = qgcApp()->compressedSignalStats().scans;
+
+    // The stale entry is dropped without scanning the posted events again
+    receiver.values.clear();
+    for (int i = 0; i < 10; i++) {
+        emit sender.valueChanged(i);
+    }
+    receiver.deliver();
+    bystander.deliver();
+    QCOMPARE(qgcApp()->compressedSignalStats().scans, scans);
+    QVERIFY(!receiver.values.isEmpty());
+    QVERIFY(receiver.values.count() <= 2);
+    QCOMPARE(receiver.values.last(), 9);
+    QCOMPARE(bystander.values, QList<int>({ 9 }));
+}
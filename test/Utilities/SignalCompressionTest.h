@@ -0,0 +1,68 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMetaMethod>
+
+class SignalCompressionTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init(void) final;
+    void cleanup(void) final;
+
+    void _testLatestValueWins(void);
+    void _testPerReceiver(void);
+    void _testSubclassSender(void);
+    void _testIndexedLookup(void);
+    void _testStaleIndex(void);
+};
+
+/// Emits the signals the tests compress
+class CompressedSignalSender : public QObject
+{
+    Q_OBJECT
+
+public:
+    static QMetaMethod valueChangedMethod(void) { return QMetaMethod::fromSignal(&CompressedSignalSender::valueChanged); }
+
+signals:
+    void valueChanged(int value);
+    void otherValueChanged(int value);
+};
+
+class DerivedCompressedSignalSender : public CompressedSignalSender
+{
+    Q_OBJECT
+};
+
+/// Records the values delivered to it
+class CompressedSignalReceiver : public QObject
+{
+public:
+    void connectTo(CompressedSignalSender *sender)
+    {
+        (void) connect(sender, &CompressedSignalSender::valueChanged, this, [this](int value) {
+            values.append(value);
+        }, Qt::QueuedConnection);
+        (void) connect(sender, &CompressedSignalSender::otherValueChanged, this, [this](int value) {
+            otherValues.append(value);
+        }, Qt::QueuedConnection);
+    }
+
+    void deliver(void) { QCoreApplication::sendPostedEvents(this, QEvent::MetaCall); }
+
+    QList<int> values;
+    QList<int> otherValues;
+};
@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CompInfoParamIndexBenchmark.h"
+#include "CompInfoParamIndex.h"
+#include "FactMetaData.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStandardPaths>
+#include <QtTest/QTest>
+
+static constexpr const char* kMetaDataFile = ":/MockLink/Parameter.MetaData.json";
+
+void CompInfoParamIndexBenchmark::init()
+{
+    UnitTest::init();
+
+    QFile file(kMetaDataFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    _json = file.readAll();
+
+    _names.clear();
+    const QJsonArray parameters = QJsonDocument::fromJson(_json).object()["parameters"].toArray();
+    for (const QJsonValue& parameter : parameters) {
+        _names << parameter.toObject()["name"].toString();
+    }
+    QVERIFY(!_names.isEmpty());
+
+    _indexFileName = QStringLiteral("%1/CompInfoParamIndexBenchmark.%2.index")
+                     .arg(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+                     .arg(QCoreApplication::applicationPid());
+}
+
+void CompInfoParamIndexBenchmark::cleanup()
+{
+    (void) QFile::remove(_indexFileName);
+
+    UnitTest::cleanup();
+}
+
+void CompInfoParamIndexBenchmark::_writeIndexFile()
+{
+    QByteArray index;
+    QString errorString;
+    QVERIFY2(CompInfoParamIndex::compile(_json, index, errorString), qPrintable(errorString));
+
+    QFile indexFile(_indexFileName);
+    QVERIFY(indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(indexFile.write(index), static_cast<qint64>(index.size()));
+}
+
+void CompInfoParamIndexBenchmark::_compileIndexedPatterns()
+{
+    QByteArray indexedJson = R"({ "version": 1, "parameters": [)";
+    _patterns.clear();
+    for (int i = 0; i < 50; i++) {
+        _patterns << QStringLiteral("GROUP%1_PARAM{n}_VALUE").arg(i);
+        indexedJson += QStringLiteral(R"(%1{ "name": "%2", "type": "Int32" })").arg(QLatin1String(i ? "," : ""), _patterns.last()).toUtf8();
+    }
+    indexedJson += "] }";
+
+    QString errorString;
+    QVERIFY2(CompInfoParamIndex::compile(indexedJson, _indexedIndex, errorString), qPrintable(errorString));
+
+    _lookups.clear();
+    for (int i = 0; i < 1000; i++) {
+        _lookups << QStringLiteral("GROUP%1_PARAM%2_VALUE").arg(i % 50).arg(i % 16).toUtf8();
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkJsonMetaData()
+{
+    // What setJson did on every connect: parse the json and build all the metadata
+    QBENCHMARK {
+        QObject parent;
+        QMap<QString, QString> defineMap;
+        const QJsonArray parameters = QJsonDocument::fromJson(_json).object()["parameters"].toArray();
+        for (const QJsonValue& parameter : parameters) {
+            (void) FactMetaData::createFromJsonObject(parameter.toObject(), defineMap, &parent);
+        }
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkCompile()
+{
+    // First connect with this metadata
+    QByteArray index;
+    QString errorString;
+    QBENCHMARK {
+        QVERIFY(CompInfoParamIndex::compile(_json, index, errorString));
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkCachedLookup()
+{
+    _writeIndexFile();
+
+    // Later connects: map the cached index, look up every name
+    QBENCHMARK {
+        CompInfoParamIndex paramIndex;
+        QVERIFY(paramIndex.open(_indexFileName));
+        for (const QString& name : std::as_const(_names)) {
+            QVERIFY(paramIndex.find(name.toUtf8()) >= 0);
+        }
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkCachedMetaData()
+{
+    _writeIndexFile();
+
+    // Same, also building the metadata of every parameter
+    QBENCHMARK {
+        QObject parent;
+        QMap<QString, QString> defineMap;
+        CompInfoParamIndex paramIndex;
+        QVERIFY(paramIndex.open(_indexFileName));
+        for (const QString& name : std::as_const(_names)) {
+            (void) FactMetaData::createFromJsonObject(paramIndex.jsonObject(paramIndex.find(name.toUtf8())), defineMap, &parent);
+        }
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkIndexedMatcher()
+{
+    _compileIndexedPatterns();
+
+    CompInfoParamIndex paramIndex;
+    QVERIFY(paramIndex.setData(_indexedIndex));
+
+    QBENCHMARK {
+        for (const QByteArray& lookup : std::as_const(_lookups)) {
+            QVERIFY(paramIndex.matchIndexed(lookup) >= 0);
+        }
+    }
+}
+
+void CompInfoParamIndexBenchmark::_benchmarkIndexedRegex()
+{
+    _compileIndexedPatterns();
+
+    // The regular expression per pattern which the matcher replaces
+    QBENCHMARK {
+        for (const QByteArray& lookup : std::as_const(_lookups)) {
+            const QString name = QString::fromUtf8(lookup);
+            int match = -1;
+            for (int i = 0; i < _patterns.count(); i++) {
+                QString pattern = _patterns[i];
+                pattern.replace("{n}", "(\\d+)");
+                if (QRegularExpression(pattern).match(name).capturedTexts().count() == 2) {
+                    match = i;
+                }
+            }
+            QVERIFY(match >= 0);
+        }
+    }
+}
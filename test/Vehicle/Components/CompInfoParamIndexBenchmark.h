@@ -0,0 +1,42 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Parameter metadata load paths, json against the compiled index.
+/// Only run when requested with --unittest:CompInfoParamIndexBenchmark.
+class CompInfoParamIndexBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    void init() override;
+    void cleanup() override;
+
+private slots:
+    void _benchmarkJsonMetaData();
+    void _benchmarkCompile();
+    void _benchmarkCachedLookup();
+    void _benchmarkCachedMetaData();
+    void _benchmarkIndexedMatcher();
+    void _benchmarkIndexedRegex();
+
+private:
+    void _writeIndexFile();
+    void _compileIndexedPatterns();
+
+    QByteArray _json;
+    QStringList _names;
+    QString _indexFileName;
+    QByteArray _indexedIndex;
+    QStringList _patterns;
+    QList<QByteArray> _lookups;
+};
@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CompInfoParamIndexTest.h"
+#include "CompInfoParamIndex.h"
+#include "ComponentInformationCache.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QStandardPaths>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr const char* kMetaDataFile = ":/MockLink/Parameter.MetaData.json";
+
+QByteArray readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+} // namespace
+
+void CompInfoParamIndexTest::_testCompile()
+{
+    const QByteArray json = readFile(kMetaDataFile);
+    QVERIFY(!json.isEmpty());
+
+    QByteArray index;
+    QString errorString;
+    QVERIFY2(CompInfoParamIndex::compile(json, index, errorString), qPrintable(errorString));
+
+    CompInfoParamIndex paramIndex;
+    QVERIFY(paramIndex.setData(index));
+
+    QHash<QString, QJsonObject> expected;
+    const QJsonArray parameters = QJsonDocument::fromJson(json).object()["parameters"].toArray();
+    for (const QJsonValue& parameter : parameters) {
+        expected[parameter.toObject()["name"].toString()] = parameter.toObject();
+    }
+    QCOMPARE(paramIndex.count(), expected.count());
+    QCOMPARE(paramIndex.indexedCount(), 0);
+
+    for (auto it = expected.cbegin(); it != expected.cend(); ++it) {
+        const int entry = paramIndex.find(it.key().toUtf8());
+        QVERIFY2(entry >= 0, qPrintable(it.key()));
+        QCOMPARE(paramIndex.name(entry), it.key());
+        QVERIFY2(paramIndex.jsonObject(entry) == it.value(), qPrintable(it.key()));
+    }
+    QCOMPARE(paramIndex.find("NO_SUCH_PARAM"), -1);
+    QCOMPARE(paramIndex.find(""), -1);
+
+    // Damaged indices are refused
+    QVERIFY(!paramIndex.setData(index.left(index.size() / 2)));
+    QVERIFY(!paramIndex.isValid());
+    QByteArray badMagic = index;
+    badMagic[0] = static_cast<char>(~badMagic[0]);
+    QVERIFY(!paramIndex.setData(badMagic));
+
+    QVERIFY(!CompInfoParamIndex::compile(R"({ "version": 2, "parameters": [] })", index, errorString));
+    QVERIFY(!CompInfoParamIndex::compile(R"({ "version": 1, "parameters": [ 1 ] })", index, errorString));
+    QVERIFY(!CompInfoParamIndex::compile("not json", index, errorString));
+}
+
+void CompInfoParamIndexTest::_testIndexedNames()
+{
+    static constexpr const char* json = R"({
+        "version": 1,
+        "parameters": [
+            { "name": "PWM_MAIN_FUNC{n}",   "type": "Int32", "shortDesc": "Output {n} function", "longDesc": "Function of output {n}" },
+            { "name": "CAL_ACC{n}_ID",      "type": "Int32", "shortDesc": "Accel {n} id" },
+            { "name": "CAL_ACC0_ID",        "type": "Int32", "shortDesc": "Primary accel id" },
+            { "name": "A{n}_B{n}",          "type": "Int32" }
+        ]
+    })";
+
+    QByteArray index;
+    QString errorString;
+    QVERIFY2(CompInfoParamIndex::compile(json, index, errorString), qPrintable(errorString));
+
+    CompInfoParamIndex paramIndex;
+    QVERIFY(paramIndex.setData(index));
+    QCOMPARE(paramIndex.count(), 1);
+    QCOMPARE(paramIndex.indexedCount(), 2);
+    QCOMPARE(paramIndex.indexedName(0), QStringLiteral("PWM_MAIN_FUNC{n}"));
+    QCOMPARE(paramIndex.indexedName(1), QStringLiteral("CAL_ACC{n}_ID"));
+
+    // Indexed names are only found through the matcher
+    QCOMPARE(paramIndex.find("PWM_MAIN_FUNC{n}"), -1);
+    QVERIFY(paramIndex.find("CAL_ACC0_ID") >= 0);
+
+    QByteArrayView digits;
+    QCOMPARE(paramIndex.matchIndexed("PWM_MAIN_FUNC12", &digits), 0);
+    QVERIFY(digits == "12");
+    QCOMPARE(paramIndex.matchIndexed("CAL_ACC2_ID", &digits), 1);
+    QVERIFY(digits == "2");
+    QCOMPARE(paramIndex.indexedJsonObject(1)["shortDesc"].toString(), QStringLiteral("Accel {n} id"));
+
+    QCOMPARE(paramIndex.matchIndexed("PWM_MAIN_FUNC"), -1);
+    QCOMPARE(paramIndex.matchIndexed("PWM_MAIN_FUNCX"), -1);
+    QCOMPARE(paramIndex.matchIndexed("PWM_MAIN_FUNC1X"), -1);
+    QCOMPARE(paramIndex.matchIndexed("XPWM_MAIN_FUNC1"), -1);
+    QCOMPARE(paramIndex.matchIndexed("CAL_ACC_ID"), -1);
+}
+
+void CompInfoParamIndexTest::_testCache()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QLatin1String("/QGCCompInfoParamIndexTest");
+    QDir(cacheDir).removeRecursively();
+
+    const QByteArray json = readFile(kMetaDataFile);
+    const QString tag = CompInfoParamIndex::cacheTag(json);
+    QString errorString;
+    QString cachedFile;
+    int count = 0;
+
+    {
+        ComponentInformationCache cache(cacheDir, 5);
+        QVERIFY(cache.access(tag).isEmpty());
+
+        CompInfoParamIndex compiled;
+        QVERIFY2(compiled.load(kMetaDataFile, cache, errorString), qPrintable(errorString));
+        count = compiled.count();
+        QVERIFY(count > 0);
+
+        cachedFile = cache.access(tag);
+        QVERIFY(!cachedFile.isEmpty());
+
+        CompInfoParamIndex cached;
+        QVERIFY2(cached.load(kMetaDataFile, cache, errorString), qPrintable(errorString));
+        QCOMPARE(cached.count(), count);
+        QVERIFY(cached.find("ctl_bw") >= 0);
+    }
+
+    // A damaged cache entry is compiled again and replaced in the cache
+    {
+        QFile file(cachedFile);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("garbage");
+    }
+    {
+        ComponentInformationCache cache(cacheDir, 5);
+        CompInfoParamIndex paramIndex;
+        QVERIFY2(paramIndex.load(kMetaDataFile, cache, errorString), qPrintable(errorString));
+        QCOMPARE(paramIndex.count(), count);
+        QCOMPARE(cache.access(tag), cachedFile);
+    }
+    {
+        CompInfoParamIndex rewritten;
+        QVERIFY(rewritten.open(cachedFile));
+        QCOMPARE(rewritten.count(), count);
+    }
+
+    QDir(cacheDir).removeRecursively();
+}
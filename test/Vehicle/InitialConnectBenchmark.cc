@@ -0,0 +1,62 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "InitialConnectBenchmark.h"
+#include "InitialConnectStagesTest.h"
+#include "InitialConnectStateMachine.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+
+#include <QtTest/QTest>
+
+void InitialConnectBenchmark::_addLatencies(void)
+{
+    QTest::addColumn<int>("latencyMs");
+
+    QTest::newRow("0 ms")   << 0;
+    QTest::newRow("100 ms") << 100;
+    QTest::newRow("250 ms") << 250;
+}
+
+void InitialConnectBenchmark::_benchmarkConnectTime_data(void)
+{
+    _addLatencies();
+}
+
+void InitialConnectBenchmark::_benchmarkConnectTime(void)
+{
+    QFETCH(int, latencyMs);
+
+    QVERIFY(InitialConnectStagesTest::connectWithLatency(latencyMs));
+    const qint64 elapsedMsecs = MultiVehicleManager::instance()->activeVehicle()->initialConnectStateMachine()->elapsedMsecs();
+    QVERIFY(InitialConnectStagesTest::disconnectAll());
+
+    QTest::setBenchmarkResult(elapsedMsecs, QTest::WalltimeMilliseconds);
+}
+
+void InitialConnectBenchmark::_benchmarkStageTimeSum_data(void)
+{
+    _addLatencies();
+}
+
+void InitialConnectBenchmark::_benchmarkStageTimeSum(void)
+{
+    QFETCH(int, latencyMs);
+
+    QVERIFY(InitialConnectStagesTest::connectWithLatency(latencyMs));
+
+    // What the connect would take with every stage waiting for the previous one, compare with _benchmarkConnectTime
+    qint64 stageTotal = 0;
+    for (const InitialConnectStateMachine::StageTiming &timing : MultiVehicleManager::instance()->activeVehicle()->initialConnectStateMachine()->stageTimings()) {
+        stageTotal += timing.endMsecs - timing.startMsecs;
+    }
+    QVERIFY(InitialConnectStagesTest::disconnectAll());
+
+    QTest::setBenchmarkResult(stageTotal, QTest::WalltimeMilliseconds);
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Initial connect time over links with latency. Only run when requested with --unittest:InitialConnectBenchmark.
+class InitialConnectBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkConnectTime_data(void);
+    void _benchmarkConnectTime(void);
+    void _benchmarkStageTimeSum_data(void);
+    void _benchmarkStageTimeSum(void);
+
+private:
+    void _addLatencies(void);
+};
@@ -0,0 +1,64 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "InitialConnectStagesTest.h"
+#include "InitialConnectStateMachine.h"
+#include "LinkManager.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+
+#include <QtTest/QTest>
+
+bool InitialConnectStagesTest::connectWithLatency(int latencyMs)
+{
+    auto mockConfig = std::make_shared<MockConfiguration>(QString{"MockLink"});
+    mockConfig->setLatencyMs(latencyMs);
+
+    SharedLinkConfigurationPtr linkConfig = mockConfig;
+    LinkManager::instance()->createConnectedLink(linkConfig);
+
+    MultiVehicleManager *const mvm = MultiVehicleManager::instance();
+    return QTest::qWaitFor([mvm]() { return mvm->activeVehicle() && mvm->activeVehicle()->isInitialConnectComplete(); }, 60000);
+}
+
+bool InitialConnectStagesTest::disconnectAll(void)
+{
+    LinkManager::instance()->disconnectAll();
+    return QTest::qWaitFor([]() { return !MultiVehicleManager::instance()->activeVehicle(); }, 10000);
+}
+
+void InitialConnectStagesTest::_testStageOrder(void)
+{
+    QVERIFY(connectWithLatency(50));
+    const Vehicle *vehicle = MultiVehicleManager::instance()->activeVehicle();
+    QVERIFY(vehicle);
+
+    const QList<InitialConnectStateMachine::StageTiming> timings = vehicle->initialConnectStateMachine()->stageTimings();
+    QCOMPARE(timings.count(), static_cast<int>(InitialConnectStateMachine::StageCount));
+    for (const InitialConnectStateMachine::StageTiming &timing : timings) {
+        QVERIFY2(timing.startMsecs >= 0, timing.name);
+        QVERIFY2(timing.endMsecs >= timing.startMsecs, timing.name);
+    }
+
+    const auto stage = [&timings](InitialConnectStateMachine::Stage stage) { return timings[stage]; };
+
+    // Requests sharing a protocol still wait for each other
+    QVERIFY(stage(InitialConnectStateMachine::StageProtocolVersion).startMsecs >= stage(InitialConnectStateMachine::StageAutopilotVersion).endMsecs);
+    QVERIFY(stage(InitialConnectStateMachine::StageStandardModes).startMsecs >= stage(InitialConnectStateMachine::StageProtocolVersion).endMsecs);
+    QVERIFY(stage(InitialConnectStateMachine::StageCompInfo).startMsecs >= stage(InitialConnectStateMachine::StageStandardModes).endMsecs);
+    QVERIFY(stage(InitialConnectStateMachine::StageParameters).startMsecs >= stage(InitialConnectStateMachine::StageCompInfo).endMsecs);
+    QVERIFY(stage(InitialConnectStateMachine::StageGeoFence).startMsecs >= stage(InitialConnectStateMachine::StageMission).endMsecs);
+    QVERIFY(stage(InitialConnectStateMachine::StageRallyPoints).startMsecs >= stage(InitialConnectStateMachine::StageGeoFence).endMsecs);
+
+    // The plan is downloaded while the parameters are
+    QVERIFY(stage(InitialConnectStateMachine::StageMission).startMsecs < stage(InitialConnectStateMachine::StageParameters).endMsecs);
+
+    QVERIFY(disconnectAll());
+}
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Ordering of the initial connect stages over a link with latency
+class InitialConnectStagesTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// Connects a MockLink which delays everything sent to the vehicle
+    /// @return true: The initial connect sequence of the new vehicle completed
+    static bool connectWithLatency(int latencyMs);
+
+    /// Disconnects all links
+    /// @return true: The vehicle went away
+    static bool disconnectAll(void);
+
+private slots:
+    void _testStageOrder(void);
+};
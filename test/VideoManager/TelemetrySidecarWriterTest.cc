@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetrySidecarWriterTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+#include <cmath>
+#include <cstring>
+
+QList<TelemetrySidecarWriter::Channel> TelemetrySidecarWriterTest::_channels(void)
+{
+    TelemetrySidecarWriter::Channel altitude;
+    altitude.name = QStringLiteral("altitudeRelative");
+    altitude.label = QStringLiteral("Alt (Rel)");
+    altitude.units = QStringLiteral("m");
+    altitude.decimals = 1;
+
+    TelemetrySidecarWriter::Channel armed;
+    armed.name = QStringLiteral("armed");
+    armed.label = QStringLiteral("Armed");
+    armed.decimals = 0;
+    armed.enumStrings = { QStringLiteral("No"), QStringLiteral("Yes") };
+    armed.enumValues = { 0, 1 };
+
+    return { altitude, armed };
+}
+
+void TelemetrySidecarWriterTest::_writeSamples(TelemetrySidecarWriter &writer)
+{
+    for (int i = 0; i < kSampleCount; i++) {
+        const double values[2] = { (i == 2) ? std::nan("") : (i * 0.5) - 1, static_cast<double>(i % 2) };
+        writer.write(i * kSampleIntervalUsecs, values);
+    }
+}
+
+void TelemetrySidecarWriterTest::_testCsv(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString baseName = tempDir.filePath(QStringLiteral("flight"));
+
+    TelemetrySidecarWriter writer;
+    QVERIFY(writer.open(baseName, _channels(), TelemetrySidecarWriter::TrackCsv, TelemetrySidecarWriter::SubtitleNone));
+    QVERIFY(writer.isOpen());
+    _writeSamples(writer);
+    writer.close();
+    QVERIFY(!writer.isOpen());
+
+    QVERIFY(!QFile::exists(baseName + QStringLiteral(".ass")));
+    QVERIFY(!QFile::exists(baseName + QStringLiteral(".srt")));
+
+    QFile file(baseName + QStringLiteral(".csv"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = file.readAll().split('\n');
+
+    // Header, one row per sample and the empty remainder after the last newline
+    QCOMPARE(lines.count(), kSampleCount + 2);
+    QCOMPARE(lines[0], QByteArray("time_ms,altitudeRelative (m),armed"));
+    QCOMPARE(lines[1], QByteArray("0.000,-1.0,0"));
+    QCOMPARE(lines[2], QByteArray("20.000,-0.5,1"));
+    QCOMPARE(lines[3], QByteArray("40.000,,0"));
+    QCOMPARE(lines[4], QByteArray("60.000,0.5,1"));
+    QCOMPARE(lines[kSampleCount], QByteArray("2480.000,60.0,0"));
+    QVERIFY(lines.last().isEmpty());
+}
+
+void TelemetrySidecarWriterTest::_testBinary(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString baseName = tempDir.filePath(QStringLiteral("flight"));
+
+    TelemetrySidecarWriter writer;
+    QVERIFY(writer.open(baseName, _channels(), TelemetrySidecarWriter::TrackBinary, TelemetrySidecarWriter::SubtitleNone));
+    _writeSamples(writer);
+    writer.close();
+
+    QFile file(baseName + QStringLiteral(".tlm"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+
+    // Magic + version, channel count, "altitudeRelative" "m" "armed" "", then the records
+    const qsizetype headerSize = 8 + 4 + (2 + 16) + (2 + 1) + (2 + 5) + (2 + 0);
+    const qsizetype recordSize = 8 + (2 * 4);
+    QCOMPARE(data.size(), headerSize + (kSampleCount * recordSize));
+
+    QCOMPARE(data.left(8), QByteArray("QGCTLM\0\1", 8));
+    QCOMPARE(qFromLittleEndian<quint32>(data.constData() + 8), 2u);
+    QCOMPARE(qFromLittleEndian<quint16>(data.constData() + 12), quint16(16));
+    QCOMPARE(data.mid(14, 16), QByteArray("altitudeRelative"));
+
+    // Fourth record
+    const char *const record = data.constData() + headerSize + (3 * recordSize);
+    QCOMPARE(qFromLittleEndian<qint64>(record), 3 * kSampleIntervalUsecs);
+    float altitude;
+    const quint32 altitudeBits = qFromLittleEndian<quint32>(record + 8);
+    (void) memcpy(&altitude, &altitudeBits, sizeof(altitude));
+    QCOMPARE(altitude, 0.5f);
+
+    // Unknown values are stored as NaN
+    float unknown;
+    const quint32 unknownBits = qFromLittleEndian<quint32>(data.constData() + headerSize + (2 * recordSize) + 8);
+    (void) memcpy(&unknown, &unknownBits, sizeof(unknown));
+    QVERIFY(std::isnan(unknown));
+}
+
+void TelemetrySidecarWriterTest::_testSubtitles(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString baseName = tempDir.filePath(QStringLiteral("flight"));
+
+    TelemetrySidecarWriter writer;
+    QVERIFY(writer.open(baseName, _channels(), TelemetrySidecarWriter::TrackNone, TelemetrySidecarWriter::SubtitleSrt));
+    _writeSamples(writer);
+    writer.close();
+
+    QFile srtFile(baseName + QStringLiteral(".srt"));
+    QVERIFY(srtFile.open(QIODevice::ReadOnly));
+    const QByteArray srt = srtFile.readAll();
+
+    // One event per second, each showing the first sample of its second
+    QVERIFY(srt.startsWith("1\n00:00:00,000 --> 00:00:01,000\nAlt (Rel): -1.0 m\nArmed: No\n\n"));
+    QVERIFY(srt.contains("2\n00:00:01,000 --> 00:00:02,000\nAlt (Rel): 24.0 m\nArmed: No\n\n"));
+    QVERIFY(srt.contains("3\n00:00:02,000 --> 00:00:03,000\n"));
+    QVERIFY(!srt.contains("\n4\n"));
+
+    // Sized to the video
+    QVERIFY(writer.open(baseName, _channels(), TelemetrySidecarWriter::TrackNone, TelemetrySidecarWriter::SubtitleAss, QSize(1280, 720)));
+    _writeSamples(writer);
+    writer.close();
+
+    QFile assFile(baseName + QStringLiteral(".ass"));
+    QVERIFY(assFile.open(QIODevice::ReadOnly));
+    const QByteArray ass = assFile.readAll();
+
+    QVERIFY(ass.contains("PlayResX: 1280\nPlayResY: 720\n"));
+    // Names and values for each of the three columns plus the date, every second
+    QCOMPARE(ass.count("Dialogue: "), 3 * ((3 * 2) + 1));
+    QVERIFY(ass.contains("Dialogue: 0,0:00:01.00,0:00:02.00,"));
+    QVERIFY(ass.contains("Alt (Rel):"));
+    QVERIFY(ass.contains("}24.0 m\n"));
+}
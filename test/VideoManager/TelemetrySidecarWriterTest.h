@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "TelemetrySidecarWriter.h"
+
+class TelemetrySidecarWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCsv(void);
+    void _testBinary(void);
+    void _testSubtitles(void);
+
+private:
+    static QList<TelemetrySidecarWriter::Channel> _channels(void);
+    static void _writeSamples(TelemetrySidecarWriter &writer);
+
+    static constexpr int kSampleCount = 125;            ///< 2.5 seconds at 50 Hz
+    static constexpr qint64 kSampleIntervalUsecs = 20000;
+};
@@ -0,0 +1,63 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoLatencyBenchmark.h"
+#include "VideoLatencyTest.h"
+
+#include <QtTest/QTest>
+
+static constexpr quint64 kFramesToMeasure = 90;
+
+void VideoLatencyBenchmark::_addProfiles(void)
+{
+    QTest::addColumn<int>("profile");
+
+    QTest::newRow("default")    << static_cast<int>(VideoReceiver::LATENCY_PROFILE_DEFAULT);
+    QTest::newRow("low")        << static_cast<int>(VideoReceiver::LATENCY_PROFILE_LOW);
+}
+
+void VideoLatencyBenchmark::_benchmarkMeanLatency_data(void)
+{
+    _addProfiles();
+}
+
+void VideoLatencyBenchmark::_benchmarkMeanLatency(void)
+{
+    QFETCH(int, profile);
+
+    const QString missing = VideoLatencyTest::missingRequirement();
+    if (!missing.isEmpty()) {
+        QSKIP(qPrintable(missing));
+    }
+
+    VideoReceiverStats::Histogram latency;
+    QVERIFY(VideoLatencyTest::measureLatency(static_cast<VideoReceiver::LATENCY_PROFILE>(profile), kFramesToMeasure, latency));
+
+    QTest::setBenchmarkResult(latency.meanMs(), QTest::WalltimeMilliseconds);
+}
+
+void VideoLatencyBenchmark::_benchmarkP95Latency_data(void)
+{
+    _addProfiles();
+}
+
+void VideoLatencyBenchmark::_benchmarkP95Latency(void)
+{
+    QFETCH(int, profile);
+
+    const QString missing = VideoLatencyTest::missingRequirement();
+    if (!missing.isEmpty()) {
+        QSKIP(qPrintable(missing));
+    }
+
+    VideoReceiverStats::Histogram latency;
+    QVERIFY(VideoLatencyTest::measureLatency(static_cast<VideoReceiver::LATENCY_PROFILE>(profile), kFramesToMeasure, latency));
+
+    QTest::setBenchmarkResult(latency.percentileMs(95), QTest::WalltimeMilliseconds);
+}
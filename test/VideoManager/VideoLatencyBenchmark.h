@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Capture to render latency of each GstVideoReceiver latency profile over a local RTP/H.264 link.
+/// Only run when requested with --unittest:VideoLatencyBenchmark.
+class VideoLatencyBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkMeanLatency_data(void);
+    void _benchmarkMeanLatency(void);
+    void _benchmarkP95Latency_data(void);
+    void _benchmarkP95Latency(void);
+
+private:
+    void _addProfiles(void);
+};
@@ -0,0 +1,257 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoLatencyTest.h"
+#ifdef QGC_GST_STREAMING
+#include "GstVideoReceiver.h"
+#endif
+
+#include <QtCore/QMutex>
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QTest>
+
+#include <cstring>
+#include <vector>
+
+#ifdef QGC_GST_STREAMING
+
+namespace {
+
+constexpr int       kFrameWidth     = 320;
+constexpr int       kFrameHeight    = 240;
+constexpr int       kStampBits      = 16;
+constexpr int       kStampBlock     = 16;   ///< Blocks survive lossy encoding where single pixels would not
+constexpr guint8    kStampBlack     = 16;
+constexpr guint8    kStampWhite     = 235;
+
+struct LatencyContext {
+    QMutex                          mutex;
+    std::vector<gint64>             sentUs = std::vector<gint64>(1 << kStampBits, -1);
+    quint16                         nextFrame = 0;
+    VideoReceiverStats::Histogram   histogram;
+    quint64                         unreadable = 0;
+};
+
+void writeStamp(guint8* luma, int stride, quint16 frame)
+{
+    for (int bit = 0; bit < kStampBits; bit++) {
+        const guint8 value = (frame >> bit) & 1 ? kStampWhite : kStampBlack;
+        for (int row = 0; row < kStampBlock; row++) {
+            memset(luma + (row * stride) + (bit * kStampBlock), value, kStampBlock);
+        }
+    }
+}
+
+bool readStamp(const guint8* luma, int stride, quint16& frame)
+{
+    frame = 0;
+    for (int bit = 0; bit < kStampBits; bit++) {
+        const guint8 value = luma[((kStampBlock / 2) * stride) + (bit * kStampBlock) + (kStampBlock / 2)];
+        const int distance = qMin(qAbs(value - kStampBlack), qAbs(value - kStampWhite));
+        if (distance > 48) {
+            return false;
+        }
+        if (value > (kStampBlack + kStampWhite) / 2) {
+            frame |= 1 << bit;
+        }
+    }
+    return true;
+}
+
+/// Sender side: stamp raw frames just before they are encoded
+GstPadProbeReturn stampProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
+{
+    Q_UNUSED(pad)
+
+    LatencyContext* context = static_cast<LatencyContext*>(user_data);
+
+    GstBuffer* buf = gst_buffer_make_writable(GST_PAD_PROBE_INFO_BUFFER(info));
+    GST_PAD_PROBE_INFO_DATA(info) = buf;
+
+    GstMapInfo map;
+    if (!gst_buffer_map(buf, &map, GST_MAP_WRITE)) {
+        return GST_PAD_PROBE_OK;
+    }
+
+    QMutexLocker lock(&context->mutex);
+    const quint16 frame = context->nextFrame++;
+    writeStamp(map.data, kFrameWidth, frame);
+    context->sentUs[frame] = g_get_monotonic_time();
+
+    gst_buffer_unmap(buf, &map);
+
+    return GST_PAD_PROBE_OK;
+}
+
+/// Receiver side: fakesink hands frames off when it renders them, after clock sync when sync is enabled
+void renderHandoff(GstElement* sink, GstBuffer* buf, GstPad* pad, gpointer user_data)
+{
+    Q_UNUSED(sink)
+
+    const gint64 renderedUs = g_get_monotonic_time();
+    LatencyContext* context = static_cast<LatencyContext*>(user_data);
+
+    GstCaps* caps = gst_pad_get_current_caps(pad);
+    if (caps == nullptr) {
+        return;
+    }
+
+    const GstStructure* s = gst_caps_get_structure(caps, 0);
+    const gchar* format = gst_structure_get_string(s, "format");
+    gint width = 0;
+    gst_structure_get_int(s, "width", &width);
+    // Planar 4:2:0 formats start with a full resolution luma plane
+    const bool planarYuv = format != nullptr && (g_str_equal(format, "I420") || g_str_equal(format, "YV12") || g_str_equal(format, "NV12"));
+    gst_caps_unref(caps);
+
+    GstMapInfo map;
+    if (!planarYuv || width < kStampBits * kStampBlock || !gst_buffer_map(buf, &map, GST_MAP_READ)) {
+        QMutexLocker lock(&context->mutex);
+        context->unreadable++;
+        return;
+    }
+
+    quint16 frame;
+    const bool readable = readStamp(map.data, GST_ROUND_UP_4(width), frame);
+    gst_buffer_unmap(buf, &map);
+
+    QMutexLocker lock(&context->mutex);
+    if (!readable || context->sentUs[frame] < 0) {
+        context->unreadable++;
+        return;
+    }
+    context->histogram.add((renderedUs - context->sentUs[frame]) / 1000.0);
+    context->sentUs[frame] = -1;
+}
+
+bool elementsAvailable(std::initializer_list<const char*> factories)
+{
+    for (const char* factory : factories) {
+        GstElementFactory* elementFactory = gst_element_factory_find(factory);
+        if (elementFactory == nullptr) {
+            return false;
+        }
+        gst_object_unref(elementFactory);
+    }
+    return true;
+}
+
+} // namespace
+
+#endif
+
+QString VideoLatencyTest::missingRequirement(void)
+{
+#ifdef QGC_GST_STREAMING
+    if (!gst_is_initialized()) {
+        return QStringLiteral("GStreamer not initialized");
+    }
+    if (!elementsAvailable({ "videotestsrc", "x264enc", "rtph264pay", "udpsink", "udpsrc", "rtpjitterbuffer", "fakesink", "decodebin3" })) {
+        return QStringLiteral("Required GStreamer elements not available");
+    }
+    return QString();
+#else
+    return QStringLiteral("GStreamer video streaming not enabled");
+#endif
+}
+
+bool VideoLatencyTest::measureLatency(VideoReceiver::LATENCY_PROFILE profile, quint64 framesToMeasure, VideoReceiverStats::Histogram& histogram)
+{
+#ifdef QGC_GST_STREAMING
+    // Let the system pick a free port so parallel runs and other local services can't collide with the stream
+    quint16 udpPort = 0;
+    {
+        QUdpSocket socket;
+        if (!socket.bind(QHostAddress::LocalHost, 0)) {
+            return false;
+        }
+        udpPort = socket.localPort();
+    }
+
+    const bool overlay = elementsAvailable({ "timeoverlay" });
+    const QString senderDescription = QStringLiteral(
+        "videotestsrc is-live=true pattern=ball ! video/x-raw,format=I420,width=%1,height=%2,framerate=30/1 ! %3"
+        "identity name=stamp ! x264enc tune=zerolatency speed-preset=ultrafast key-int-max=15 ! "
+        "rtph264pay config-interval=-1 pt=96 ! udpsink host=127.0.0.1 port=%4 sync=false")
+        .arg(kFrameWidth).arg(kFrameHeight).arg(overlay ? QStringLiteral("timeoverlay valignment=bottom ! ") : QString()).arg(udpPort);
+
+    GError* error = nullptr;
+    GstElement* sender = gst_parse_launch(qPrintable(senderDescription), &error);
+    if (error != nullptr) {
+        qWarning() << "Sender pipeline failed" << error->message;
+        g_error_free(error);
+        error = nullptr;
+    }
+    if (sender == nullptr) {
+        return false;
+    }
+
+    LatencyContext context;
+
+    GstElement* stamp = gst_bin_get_by_name(GST_BIN(sender), "stamp");
+    GstPad* stampPad = gst_element_get_static_pad(stamp, "src");
+    gst_pad_add_probe(stampPad, GST_PAD_PROBE_TYPE_BUFFER, stampProbe, &context, nullptr);
+    gst_object_unref(stampPad);
+    gst_object_unref(stamp);
+
+    GstElement* sink = gst_element_factory_make("fakesink", nullptr);
+    gst_object_ref_sink(sink);
+    g_object_set(sink, "signal-handoffs", TRUE, nullptr);
+    g_signal_connect(sink, "handoff", G_CALLBACK(renderHandoff), &context);
+
+    QAtomicInteger<bool> stopped = false;
+    GstVideoReceiver receiver;
+    (void) connect(&receiver, &VideoReceiver::onStopComplete, &receiver, [&stopped](VideoReceiver::STATUS) { stopped = true; }, Qt::DirectConnection);
+
+    receiver.setLatencyProfile(profile);
+    receiver.start(QStringLiteral("udp://127.0.0.1:%1").arg(udpPort), 5 /* timeout */);
+    receiver.startDecoding(sink);
+
+    (void) gst_element_set_state(sender, GST_STATE_PLAYING);
+
+    const auto measuredFrames = [&context]() {
+        QMutexLocker lock(&context.mutex);
+        return context.histogram.count();
+    };
+    const bool measured = QTest::qWaitFor([&measuredFrames, framesToMeasure]() { return measuredFrames() >= framesToMeasure; }, 15000);
+
+    receiver.stop();
+    (void) QTest::qWaitFor([&stopped]() { return static_cast<bool>(stopped); }, 5000);
+
+    (void) gst_element_set_state(sender, GST_STATE_NULL);
+    gst_object_unref(sender);
+
+    // Nothing can reach the context once both pipelines are down
+    g_signal_handlers_disconnect_by_data(sink, &context);
+    gst_object_unref(sink);
+
+    histogram = context.histogram;
+
+    return measured;
+#else
+    Q_UNUSED(profile)
+    Q_UNUSED(framesToMeasure)
+    Q_UNUSED(histogram)
+    return false;
+#endif
+}
+
+void VideoLatencyTest::_testLowLatencyProfile(void)
+{
+    const QString missing = missingRequirement();
+    if (!missing.isEmpty()) {
+        QSKIP(qPrintable(missing));
+    }
+
+    // Stamped frames make it through the low latency receive pipeline in order to be rendered
+    VideoReceiverStats::Histogram latency;
+    QVERIFY(measureLatency(VideoReceiver::LATENCY_PROFILE_LOW, 30 /* framesToMeasure */, latency));
+    QVERIFY(latency.count() >= 30);
+    QVERIFY(latency.minMs() >= 0);
+}
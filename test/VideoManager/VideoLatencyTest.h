@@ -0,0 +1,36 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "VideoReceiver.h"
+
+/// Measures capture to display latency of GstVideoReceiver over a local RTP/H.264 link.
+///
+/// The sender stamps a frame number into the top row of every raw frame as black and white blocks before encoding
+/// (and draws the running time with timeoverlay when available, for camera based glass to glass checks). The
+/// receiver reads the number back from the decoded frame when the video sink renders it, which gives the latency
+/// of each individual frame without relying on timestamps surviving the RTP hop.
+class VideoLatencyTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// @return Why the latency pipelines can't run here, empty if they can
+    static QString missingRequirement(void);
+
+    /// Streams stamped frames through a GstVideoReceiver using the specified profile
+    ///     @param framesToMeasure Number of rendered frames to collect before stopping
+    /// @return true: framesToMeasure frames were rendered with a readable stamp
+    static bool measureLatency(VideoReceiver::LATENCY_PROFILE profile, quint64 framesToMeasure, VideoReceiverStats::Histogram& histogram);
+
+private slots:
+    void _testLowLatencyProfile(void);
+};
@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoReceiverStatsTest.h"
+#include "VideoReceiverStats.h"
+#ifdef QGC_GST_STREAMING
+#include "GstVideoReceiver.h"
+#endif
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+static constexpr qint64 kMsec = 1000000;
+
+void VideoReceiverStatsTest::_testHistogram(void)
+{
+    VideoReceiverStats::Histogram histogram;
+
+    QCOMPARE(histogram.count(), 0ull);
+    QCOMPARE(histogram.percentileMs(50), 0.0);
+
+    // 90 fast frames and 10 slow ones
+    for (int i = 0; i < 90; i++) {
+        histogram.add(3.0);
+    }
+    for (int i = 0; i < 10; i++) {
+        histogram.add(150.0);
+    }
+
+    QCOMPARE(histogram.count(), 100ull);
+    QCOMPARE(histogram.minMs(), 3.0);
+    QCOMPARE(histogram.maxMs(), 150.0);
+    QCOMPARE(histogram.meanMs(), 17.7);
+
+    // Percentiles are interpolated within a bucket but never leave it
+    const double p50 = histogram.percentileMs(50);
+    QVERIFY(p50 >= 3.0 && p50 <= 5.0);
+    const double p95 = histogram.percentileMs(95);
+    QVERIFY(p95 >= 100.0 && p95 <= 150.0);
+    QCOMPARE(histogram.percentileMs(100), 150.0);
+}
+
+void VideoReceiverStatsTest::_testStageMatching(void)
+{
+    VideoReceiverStats stats;
+
+    // 32 frames at 30 fps, each spending 10ms in the source, 15ms in the decoder and waiting 5ms in the sink
+    const qint64 framePeriod = 1000 * kMsec / 30;
+    qint64 lastRunningTime = 0;
+    for (int frame = 0; frame < 32; frame++) {
+        const qint64 pts = 1000 * kMsec + (frame * framePeriod);
+        stats.noteFrameParsed(pts, pts + (10 * kMsec));
+        lastRunningTime = pts + (25 * kMsec);
+        stats.noteFrameDecoded(pts, lastRunningTime, 5 * kMsec);
+    }
+
+    // Unknown timestamps count as frames but not as samples
+    stats.noteFrameParsed(-1, 5000 * kMsec);
+    stats.noteFrameDecoded(-1, -1, -1);
+
+    // Decoded frame whose parse time has already been pushed out of the history
+    stats.noteFrameDecoded(0, lastRunningTime + kMsec, -1);
+
+    stats.noteQos(3, 2 * kMsec);
+    stats.noteQos(2, -1 * kMsec);
+
+    const VideoReceiverStats::Snapshot snapshot = stats.snapshot();
+    QCOMPARE(snapshot.framesReceived, 33ull);
+    QCOMPARE(snapshot.framesDecoded, 34ull);
+    QCOMPARE(snapshot.framesDropped, 3ull);
+    QCOMPARE(snapshot.framesLate, 1ull);
+    QVERIFY(qAbs(snapshot.fps - 30.0) < 0.5);
+
+    const VideoReceiverStats::Histogram& receive = snapshot.stages[VideoReceiverStats::StageReceiveToParse];
+    QCOMPARE(receive.count(), 32ull);
+    QCOMPARE(receive.meanMs(), 10.0);
+
+    const VideoReceiverStats::Histogram& decode = snapshot.stages[VideoReceiverStats::StageDecode];
+    QCOMPARE(decode.count(), 32ull);
+    QCOMPARE(decode.meanMs(), 15.0);
+
+    const VideoReceiverStats::Histogram& render = snapshot.stages[VideoReceiverStats::StageSinkRender];
+    QCOMPARE(render.count(), 32ull);
+    QCOMPARE(render.meanMs(), 5.0);
+
+    const QVariantMap map = VideoReceiverStats::toVariantMap(snapshot);
+    QCOMPARE(map["framesDecoded"].toULongLong(), 34ull);
+    QCOMPARE(map["decode"].toMap()["meanMs"].toDouble(), 15.0);
+
+    stats.reset();
+    QCOMPARE(stats.snapshot().framesDecoded, 0ull);
+    QCOMPARE(stats.snapshot().stages[VideoReceiverStats::StageDecode].count(), 0ull);
+}
+
+void VideoReceiverStatsTest::_testCsvDump(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath("stats.csv");
+
+    VideoReceiverStats stats;
+    QVERIFY(stats.startCsv(fileName));
+    QVERIFY(stats.csvActive());
+
+    auto readLines = [&fileName]() {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly | QIODevice::Text) ? QString::fromLatin1(file.readAll()).split('\n', Qt::SkipEmptyParts) : QStringList();
+    };
+
+    // Samples are only queued by the streaming threads, nothing reaches the file until it is flushed
+    stats.noteFrameParsed(100 * kMsec, 110 * kMsec);
+    stats.noteFrameDecoded(100 * kMsec, 125 * kMsec, 5 * kMsec);
+    QVERIFY(readLines().count() <= 1);
+
+    stats.flushCsv();
+    QCOMPARE(readLines().count(), 4);
+
+    stats.stopCsv();
+    QVERIFY(!stats.csvActive());
+
+    // No samples are queued once stopped
+    stats.noteFrameParsed(200 * kMsec, 210 * kMsec);
+    stats.flushCsv();
+
+    const QStringList lines = readLines();
+    QCOMPARE(lines.count(), 4);
+    QCOMPARE(lines[0], QStringLiteral("running_time_ms,stage,latency_ms"));
+    QCOMPARE(lines[1], QStringLiteral("110.000,receiveToParse,10.000"));
+    QCOMPARE(lines[2], QStringLiteral("125.000,decode,15.000"));
+    QCOMPARE(lines[3], QStringLiteral("125.000,sinkRender,5.000"));
+}
+
+void VideoReceiverStatsTest::_testVideoTestSrcPipeline(void)
+{
+#ifdef QGC_GST_STREAMING
+    if (!gst_is_initialized()) {
+        QSKIP("GStreamer not initialized");
+    }
+    for (const char* factory : { "videotestsrc", "fakesink", "decodebin3" }) {
+        GstElementFactory* elementFactory = gst_element_factory_find(factory);
+        if (elementFactory == nullptr) {
+            QSKIP("Required GStreamer element not available");
+        }
+        gst_object_unref(elementFactory);
+    }
+
+    GstElement* sink = gst_element_factory_make("fakesink", nullptr);
+    QVERIFY(sink != nullptr);
+    gst_object_ref_sink(sink);
+
+    QAtomicInteger<bool> stopped = false;
+    GstVideoReceiver receiver;
+    (void) connect(&receiver, &VideoReceiver::onStopComplete, &receiver, [&stopped](VideoReceiver::STATUS) { stopped = true; }, Qt::DirectConnection);
+
+    receiver.start(QStringLiteral("videotestsrc://?fps=30&width=160&height=120"), 5 /* timeout */);
+    receiver.startDecoding(sink);
+
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.stats()->snapshot().framesDecoded >= 70, 10000);
+
+    const VideoReceiverStats::Snapshot snapshot = receiver.stats()->snapshot();
+    QVERIFY(snapshot.framesReceived >= snapshot.framesDecoded);
+    QVERIFY(snapshot.stages[VideoReceiverStats::StageDecode].count() > 0);
+    QVERIFY(snapshot.stages[VideoReceiverStats::StageSinkRender].count() > 0);
+    QVERIFY2(snapshot.fps > 20 && snapshot.fps < 40, qPrintable(QString::number(snapshot.fps)));
+
+    receiver.stop();
+    QTRY_VERIFY_WITH_TIMEOUT(stopped, 5000);
+
+    gst_object_unref(sink);
+#else
+    QSKIP("GStreamer video streaming not enabled");
+#endif
+}
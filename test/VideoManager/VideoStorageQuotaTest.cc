@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoStorageQuotaTest.h"
+#include "TelemetrySidecarWriter.h"
+#include "VideoStorageQuota.h"
+#ifdef QGC_GST_STREAMING
+#include "GstVideoReceiver.h"
+#endif
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <limits>
+
+void VideoStorageQuotaTest::_makeFile(const QString &fileName, qint64 size, const QDateTime &modified)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(QByteArray(size, 'x')), size);
+    QVERIFY(file.flush());
+    QVERIFY(file.setFileTime(modified, QFileDevice::FileModificationTime));
+    file.close();
+}
+
+void VideoStorageQuotaTest::_testMaxBytes(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QDateTime now = QDateTime::currentDateTime();
+    for (int i = 1; i <= 5; i++) {
+        _makeFile(tempDir.filePath(QStringLiteral("video%1.mkv").arg(i)), 1000, now.addSecs(-100 * (6 - i)));
+    }
+    // Does not match the filters and must be left alone even though it is the oldest
+    _makeFile(tempDir.filePath(QStringLiteral("notes.txt")), 1000, now.addSecs(-1000));
+
+    VideoStorageQuota quota;
+    quota.setPath(tempDir.path());
+    quota.setNameFilters({ QStringLiteral("*.mkv") });
+    quota.setMaxBytes(2500);
+
+    // video1 is the oldest but still being written
+    quota.protect(tempDir.filePath(QStringLiteral("video1.mkv")));
+
+    const QStringList removed = quota.enforce();
+    QCOMPARE(removed.count(), 3);
+    QCOMPARE(quota.usedBytes(), 2000ull);
+
+    QDir dir(tempDir.path());
+    QVERIFY(dir.exists(QStringLiteral("video1.mkv")));
+    QVERIFY(!dir.exists(QStringLiteral("video2.mkv")));
+    QVERIFY(!dir.exists(QStringLiteral("video3.mkv")));
+    QVERIFY(!dir.exists(QStringLiteral("video4.mkv")));
+    QVERIFY(dir.exists(QStringLiteral("video5.mkv")));
+    QVERIFY(dir.exists(QStringLiteral("notes.txt")));
+
+    // Already within quota
+    QVERIFY(quota.enforce().isEmpty());
+
+    // Once released, the oldest file goes first
+    quota.unprotect(tempDir.filePath(QStringLiteral("video1.mkv")));
+    quota.setMaxBytes(1000);
+    QCOMPARE(quota.enforce(), QStringList({ QFileInfo(tempDir.filePath(QStringLiteral("video1.mkv"))).absoluteFilePath() }));
+}
+
+void VideoStorageQuotaTest::_testSidecarsCounted(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QDateTime now = QDateTime::currentDateTime();
+    _makeFile(tempDir.filePath(QStringLiteral("video1.mkv")), 1000, now.addSecs(-300));
+    _makeFile(tempDir.filePath(QStringLiteral("video1.csv")), 500, now.addSecs(-300));
+    _makeFile(tempDir.filePath(QStringLiteral("video1.srt")), 500, now.addSecs(-300));
+    _makeFile(tempDir.filePath(QStringLiteral("video2.mkv")), 1000, now.addSecs(-100));
+    _makeFile(tempDir.filePath(QStringLiteral("video2.tlm")), 500, now.addSecs(-100));
+
+    VideoStorageQuota quota;
+    quota.setPath(tempDir.path());
+    quota.setNameFilters(QStringList({ QStringLiteral("*.mkv") }) + TelemetrySidecarWriter::nameFilters());
+
+    // The sidecar still being written is kept, the older recording goes with its sidecars
+    quota.protect(tempDir.filePath(QStringLiteral("video2.tlm")));
+    quota.setMaxBytes(1500);
+
+    QCOMPARE(quota.enforce().count(), 3);
+    QCOMPARE(quota.usedBytes(), 1500ull);
+
+    QDir dir(tempDir.path());
+    QVERIFY(!dir.exists(QStringLiteral("video1.mkv")));
+    QVERIFY(!dir.exists(QStringLiteral("video1.csv")));
+    QVERIFY(!dir.exists(QStringLiteral("video1.srt")));
+    QVERIFY(dir.exists(QStringLiteral("video2.mkv")));
+    QVERIFY(dir.exists(QStringLiteral("video2.tlm")));
+}
+
+void VideoStorageQuotaTest::_testMinFreeBytes(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QDateTime now = QDateTime::currentDateTime();
+    _makeFile(tempDir.filePath(QStringLiteral("a.mp4")), 100, now.addSecs(-20));
+    _makeFile(tempDir.filePath(QStringLiteral("b.mp4")), 100, now.addSecs(-10));
+
+    VideoStorageQuota quota;
+    quota.setPath(tempDir.path());
+    quota.setNameFilters({ QStringLiteral("*.mp4") });
+    quota.protect(tempDir.filePath(QStringLiteral("b.mp4")));
+
+    // No limits, nothing to do
+    QVERIFY(quota.enforce().isEmpty());
+
+    // A reserve which can never be met removes everything which is not protected
+    quota.setMinFreeBytes(std::numeric_limits<quint64>::max());
+    QCOMPARE(quota.enforce().count(), 1);
+    QVERIFY(!QFile::exists(tempDir.filePath(QStringLiteral("a.mp4"))));
+    QVERIFY(QFile::exists(tempDir.filePath(QStringLiteral("b.mp4"))));
+}
+
+void VideoStorageQuotaTest::_testSegmentedRecording(void)
+{
+#ifdef QGC_GST_STREAMING
+    if (!gst_is_initialized()) {
+        QSKIP("GStreamer not initialized");
+    }
+    for (const char* factory : { "videotestsrc", "x264enc", "h264parse", "splitmuxsink", "matroskamux", "fakesink", "decodebin3" }) {
+        GstElementFactory* elementFactory = gst_element_factory_find(factory);
+        if (elementFactory == nullptr) {
+            QSKIP("Required GStreamer element not available");
+        }
+        gst_object_unref(elementFactory);
+    }
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // Two streams recorded at once against one epoch, as VideoManager does with the primary and thermal streams
+    constexpr int kStreams = 2;
+    GstVideoReceiver receivers[kStreams];
+    GstElement* sinks[kStreams] = {};
+    QStringList opened;
+    QStringList closed;
+    int stoppedRecording = 0;
+
+    for (int i = 0; i < kStreams; i++) {
+        GstVideoReceiver& receiver = receivers[i];
+        (void) connect(&receiver, &VideoReceiver::recordingFileOpened, this, [&opened](const QString& file) { opened.append(file); });
+        (void) connect(&receiver, &VideoReceiver::recordingFileClosed, this, [&closed](const QString& file) { closed.append(file); });
+        (void) connect(&receiver, &VideoReceiver::recordingChanged, this, [&stoppedRecording](bool active) { if (!active) stoppedRecording++; });
+
+        sinks[i] = gst_element_factory_make("fakesink", nullptr);
+        gst_object_ref_sink(sinks[i]);
+
+        receiver.start(QStringLiteral("videotestsrc://?fps=30&width=160&height=120&encoder=x264&keyint=15"), 5 /* timeout */);
+        receiver.startDecoding(sinks[i]);
+    }
+
+    // Let the encoders produce their first keyframes
+    QTest::qWait(500);
+
+    const qint64 epoch = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < kStreams; i++) {
+        receivers[i].setRecordingSegmentation(1 /* seconds */, 0);
+        receivers[i].setRecordingEpoch(epoch);
+        receivers[i].startRecording(tempDir.filePath(i == 0 ? QStringLiteral("rec.mkv") : QStringLiteral("rec.2.mkv")), VideoReceiver::FILE_FORMAT_MKV);
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(closed.count() >= 2 * kStreams, 10000);
+
+    for (GstVideoReceiver& receiver : receivers) {
+        receiver.stopRecording();
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(stoppedRecording, kStreams, 10000);
+
+    // Every opened segment was finalized
+    QTRY_COMPARE_WITH_TIMEOUT(closed.count(), opened.count(), 5000);
+
+    for (const QString& file : closed) {
+        QVERIFY2(QFileInfo(file).size() > 0, qPrintable(file));
+    }
+
+    const QStringList primarySegments = QDir(tempDir.path()).entryList({ QStringLiteral("rec.[0-9][0-9][0-9].mkv") });
+    const QStringList thermalSegments = QDir(tempDir.path()).entryList({ QStringLiteral("rec.2.[0-9][0-9][0-9].mkv") });
+    QVERIFY(primarySegments.count() >= 2);
+    QVERIFY(thermalSegments.count() >= 2);
+    QVERIFY(primarySegments.contains(QStringLiteral("rec.000.mkv")));
+
+    for (int i = 0; i < kStreams; i++) {
+        (void) disconnect(&receivers[i], nullptr, this, nullptr);
+        receivers[i].stop();
+    }
+    QTest::qWait(500);
+    for (GstElement* sink : sinks) {
+        gst_object_unref(sink);
+    }
+#else
+    QSKIP("GStreamer video streaming not enabled");
+#endif
+}
@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class VideoStorageQuotaTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testMaxBytes(void);
+    void _testMinFreeBytes(void);
+    void _testSidecarsCounted(void);
+    void _testSegmentedRecording(void);
+
+private:
+    static void _makeFile(const QString &fileName, qint64 size, const QDateTime &modified);
+};
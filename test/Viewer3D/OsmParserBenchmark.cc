@@ -0,0 +1,70 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "OsmParserBenchmark.h"
+#include "OsmParserTest.h"
+#include "OsmParser.h"
+#include "OsmParserThread.h"
+
+#include <QtCore/QBuffer>
+#include <QtTest/QTest>
+
+void OsmParserBenchmark::_benchmarkDecode(void)
+{
+    QByteArray osm = OsmParserTest::sampleMap();
+    QVERIFY(!osm.isEmpty());
+
+    QBENCHMARK {
+        QBuffer buffer(&osm);
+        (void) buffer.open(QIODevice::ReadOnly);
+        QHash<uint64_t, OsmParserThread::BuildingType_t> buildings;
+        QGeoCoordinate coordinateMin, coordinateMax, gpsRef;
+        (void) OsmParserThread::decodeOsm(&buffer, buildings, coordinateMin, coordinateMax, gpsRef);
+    }
+}
+
+void OsmParserBenchmark::_benchmarkMesh(void)
+{
+    QByteArray osm = OsmParserTest::sampleMap();
+    QBuffer buffer(&osm);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QHash<uint64_t, OsmParserThread::BuildingType_t> buildings;
+    QGeoCoordinate coordinateMin, coordinateMax, gpsRef;
+    QVERIFY(OsmParserThread::decodeOsm(&buffer, buildings, coordinateMin, coordinateMax, gpsRef));
+
+    // Tile the sample map next to itself to get a city sized set of buildings
+    QList<OsmParserThread::BuildingType_t> copies;
+    copies.reserve(buildings.count() * kBenchmarkCopies * kBenchmarkCopies);
+    for (int x = 0; x < kBenchmarkCopies; x++) {
+        for (int y = 0; y < kBenchmarkCopies; y++) {
+            const QVector2D shift(x * 1000.0f, y * 1000.0f);
+            for (OsmParserThread::BuildingType_t building : std::as_const(buildings)) {
+                for (QVector2D &point : building.points_local) {
+                    point += shift;
+                }
+                for (QVector2D &point : building.points_local_inner) {
+                    point += shift;
+                }
+                building.bb_max += shift;
+                building.bb_min += shift;
+                copies.append(std::move(building));
+            }
+        }
+    }
+
+    QList<const OsmParserThread::BuildingType_t*> all;
+    for (const OsmParserThread::BuildingType_t &building : std::as_const(copies)) {
+        all.append(&building);
+    }
+
+    QBENCHMARK {
+        (void) OsmParser::meshBuildings(all, 3.0f);
+    }
+}
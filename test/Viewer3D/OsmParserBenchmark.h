@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Decode and mesh time of the sample OSM map. Only run when requested with --unittest:OsmParserBenchmark.
+class OsmParserBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkDecode(void);
+    void _benchmarkMesh(void);
+
+private:
+    static constexpr int kBenchmarkCopies = 3; ///< The sample map is meshed kBenchmarkCopies x kBenchmarkCopies times
+};
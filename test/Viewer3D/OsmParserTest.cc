@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "OsmParserTest.h"
+#include "OsmParser.h"
+#include "OsmParserThread.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QFile>
+#include <QtTest/QTest>
+
+#include <cmath>
+
+QByteArray OsmParserTest::sampleMap(void)
+{
+    QFile file(QStringLiteral(":/unittest/map_sim_small.osm"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void OsmParserTest::_testDecode(void)
+{
+    QByteArray osm = QByteArrayLiteral(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<osm version=\"0.6\">\n"
+        " <bounds minlat=\"47.0000\" minlon=\"8.0000\" maxlat=\"47.0010\" maxlon=\"8.0010\"/>\n"
+        " <node id=\"1\" lat=\"47.0004\" lon=\"8.0004\"/>\n"
+        " <node id=\"2\" lat=\"47.0004\" lon=\"8.0006\"><tag k=\"name\" v=\"ignored\"/></node>\n"
+        " <node id=\"3\" lat=\"47.0006\" lon=\"8.0006\"/>\n"
+        " <node id=\"4\" lat=\"47.0006\" lon=\"8.0004\"/>\n"
+        " <way id=\"10\"><nd ref=\"1\"/><nd ref=\"2\"/><nd ref=\"3\"/><nd ref=\"4\"/><nd ref=\"1\"/><tag k=\"building\" v=\"yes\"/></way>\n"
+        " <way id=\"11\"><nd ref=\"1\"/><nd ref=\"2\"/><nd ref=\"99\"/><tag k=\"building\" v=\"yes\"/></way>\n"
+        " <way id=\"12\"><nd ref=\"1\"/><nd ref=\"2\"/><nd ref=\"3\"/><tag k=\"highway\" v=\"path\"/></way>\n"
+        "</osm>\n");
+    QBuffer buffer(&osm);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QHash<uint64_t, OsmParserThread::BuildingType_t> buildings;
+    QGeoCoordinate coordinateMin, coordinateMax, gpsRef;
+    QVERIFY(OsmParserThread::decodeOsm(&buffer, buildings, coordinateMin, coordinateMax, gpsRef));
+
+    QVERIFY(qAbs(gpsRef.latitude() - 47.0005) < 1e-5);
+    QVERIFY(qAbs(gpsRef.longitude() - 8.0005) < 1e-5);
+
+    // Way 11 lost a node outside of the extract, way 12 is not a building
+    QCOMPARE(buildings.count(), 1);
+    const OsmParserThread::BuildingType_t &building = buildings.value(10);
+    QCOMPARE(building.points_local.size(), static_cast<size_t>(5));
+    QCOMPARE(building.levels, 2.0f);
+    QVERIFY(building.points_local_inner.empty());
+
+    // Roughly a 15 m x 22 m box around the reference point
+    QVERIFY(qAbs(building.bb_max.x() + building.bb_min.x()) < 0.5f);
+    QVERIFY(qAbs(building.bb_max.y() + building.bb_min.y()) < 0.5f);
+    QVERIFY(building.bb_max.x() - building.bb_min.x() > 10.0f);
+    QVERIFY(building.bb_max.y() - building.bb_min.y() > 10.0f);
+
+    // Two roof and two floor triangles, the walls of the 5 point ring both ways
+    const QByteArray mesh = OsmParser::meshBuildings({ &building }, 3.0f);
+    QCOMPARE(mesh.size(), static_cast<qsizetype>((12 + 2 * 36) * 3 * sizeof(float)));
+
+    const float *vertices = reinterpret_cast<const float *>(mesh.constData());
+    QCOMPARE(vertices[2], 6.0f);
+
+    QVERIFY(OsmParser::meshBuildings({}, 3.0f).isEmpty());
+}
+
+void OsmParserTest::_testSampleMap(void)
+{
+    QByteArray osm = sampleMap();
+    QVERIFY(!osm.isEmpty());
+    QBuffer buffer(&osm);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QHash<uint64_t, OsmParserThread::BuildingType_t> buildings;
+    QGeoCoordinate coordinateMin, coordinateMax, gpsRef;
+    QVERIFY(OsmParserThread::decodeOsm(&buffer, buildings, coordinateMin, coordinateMax, gpsRef));
+    QVERIFY(!buildings.isEmpty());
+
+    QList<const OsmParserThread::BuildingType_t*> all;
+    for (const OsmParserThread::BuildingType_t &building : std::as_const(buildings)) {
+        QVERIFY(building.points_local.size() > 2);
+        QVERIFY((building.levels > 0) || (building.height > 0));
+        all.append(&building);
+    }
+
+    const QByteArray mesh = OsmParser::meshBuildings(all, 3.0f);
+    QVERIFY(!mesh.isEmpty());
+    QVERIFY((mesh.size() % (9 * sizeof(float))) == 0);
+
+    const float *vertices = reinterpret_cast<const float *>(mesh.constData());
+    const qsizetype count = mesh.size() / sizeof(float);
+    for (qsizetype i = 0; i < count; i++) {
+        QVERIFY(std::isfinite(vertices[i]));
+    }
+
+    // Meshing in parts gives the same amount of geometry as meshing everything at once
+    const QList<const OsmParserThread::BuildingType_t*> firstHalf = all.mid(0, all.count() / 2);
+    const QList<const OsmParserThread::BuildingType_t*> secondHalf = all.mid(all.count() / 2);
+    const QByteArray firstMesh = OsmParser::meshBuildings(firstHalf, 3.0f);
+    QVERIFY(firstMesh.size() < mesh.size());
+    QCOMPARE(firstMesh.size() + OsmParser::meshBuildings(secondHalf, 3.0f).size(), mesh.size());
+}
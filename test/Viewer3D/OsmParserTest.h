@@ -0,0 +1,24 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class OsmParserTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    static QByteArray sampleMap(void);
+
+private slots:
+    void _testDecode(void);
+    void _testSampleMap(void);
+};
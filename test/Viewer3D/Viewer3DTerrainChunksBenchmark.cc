@@ -0,0 +1,56 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Viewer3DTerrainChunksBenchmark.h"
+#include "Viewer3DTerrainChunksTest.h"
+#include "Viewer3DTerrainChunks.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtTest/QTest>
+
+void Viewer3DTerrainChunksBenchmark::_benchmarkBuild(void)
+{
+    Viewer3DTerrainChunks chunks;
+    Viewer3DTerrainChunksTest::setupRegion(chunks);
+
+    const QList<quint64> keys = chunks.selectChunks(QVector3D(0, 0, 0));
+    QList<Viewer3DTerrainChunks::BuildJob> jobs = chunks.staleChunks(keys, false);
+    for (int i = 0; i < jobs.count(); i++) {
+        jobs[i].heights = Viewer3DTerrainChunksTest::terrainHeights(jobs[i].gridSize, i);
+        jobs[i].heightOffset = 400.0f;
+    }
+
+    QBENCHMARK {
+        const QList<Viewer3DTerrainChunks::Chunk> built = QtConcurrent::blockingMapped(jobs, &Viewer3DTerrainChunks::buildChunk);
+        QCOMPARE(built.count(), jobs.count());
+    }
+}
+
+void Viewer3DTerrainChunksBenchmark::_benchmarkFrame(void)
+{
+    Viewer3DTerrainChunks chunks;
+    Viewer3DTerrainChunksTest::setupRegion(chunks);
+
+    // Warm the cache along the path so every frame is selection and upload only
+    constexpr int steps = 50;
+    for (int step = 0; step < steps; step++) {
+        const QList<quint64> keys = chunks.selectChunks(QVector3D(step * 40.0f, step * 20.0f, 100.0f));
+        for (const Viewer3DTerrainChunks::BuildJob &job : chunks.staleChunks(keys, false)) {
+            chunks.insertChunk(Viewer3DTerrainChunks::buildChunk(job));
+        }
+    }
+
+    QBENCHMARK {
+        for (int step = 0; step < steps; step++) {
+            const QList<quint64> keys = chunks.selectChunks(QVector3D(step * 40.0f, step * 20.0f, 100.0f));
+            QVERIFY(chunks.staleChunks(keys, false).isEmpty());
+            QVERIFY(!chunks.vertexData(keys).isEmpty());
+        }
+    }
+}
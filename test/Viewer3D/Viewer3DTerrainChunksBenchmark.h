@@ -0,0 +1,22 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Chunk build and per frame selection time of the terrain chunks. Only run when requested with --unittest:Viewer3DTerrainChunksBenchmark.
+class Viewer3DTerrainChunksBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkBuild(void);
+    void _benchmarkFrame(void);
+};
@@ -0,0 +1,246 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Viewer3DTerrainChunksTest.h"
+#include "Viewer3DTerrainChunks.h"
+
+#include <QtCore/QSet>
+#include <QtCore/QtMath>
+#include <QtTest/QTest>
+
+#include <cmath>
+
+void Viewer3DTerrainChunksTest::setupRegion(Viewer3DTerrainChunks &chunks)
+{
+    chunks.setReference(QGeoCoordinate(47.40, 8.55, 0));
+    chunks.setRegion(QGeoCoordinate(47.35, 8.50), QGeoCoordinate(47.45, 8.60));
+}
+
+std::vector<float> Viewer3DTerrainChunksTest::terrainHeights(int gridSize, int seed)
+{
+    const int stride = gridSize + 3;
+    std::vector<float> heights(stride * stride);
+    for (int i = 0; i < stride; i++) {
+        for (int j = 0; j < stride; j++) {
+            heights[i * stride + j] = 400.0f + 50.0f * std::sin(0.3f * (i + seed)) * std::cos(0.2f * (j - seed));
+        }
+    }
+    return heights;
+}
+
+void Viewer3DTerrainChunksTest::_testSelect(void)
+{
+    Viewer3DTerrainChunks chunks;
+    setupRegion(chunks);
+
+    // From far above only the level 0 cells covering the region are left, no slivers along their edges
+    QList<quint64> keys = chunks.selectChunks(QVector3D(0, 0, 1e6));
+    QCOMPARE(keys.count(), 4);
+
+    keys = chunks.selectChunks(QVector3D(0, 0, 0));
+    QVERIFY(keys.count() > 4);
+
+    // The chunks tile the region without gaps or overlaps, the smallest ones at the view point
+    double area = 0;
+    double smallest = Viewer3DTerrainChunks::kRootSpan;
+    for (const quint64 key : keys) {
+        const Viewer3DTerrainChunks::Rect rect = chunks.chunkRect(key);
+        QVERIFY(!rect.isEmpty());
+        area += (rect.maxLat - rect.minLat) * (rect.maxLon - rect.minLon);
+        smallest = qMin(smallest, rect.maxLon - rect.minLon);
+    }
+    QVERIFY(qAbs(area - 0.01) < 1e-9);
+    QVERIFY(qAbs(smallest - Viewer3DTerrainChunks::kRootSpan / (1 << Viewer3DTerrainChunks::kDefaultMaxLevel)) < 1e-9);
+    QCOMPARE(QSet<quint64>(keys.constBegin(), keys.constEnd()).count(), keys.count());
+
+    // Moving along reuses the chunks far from both view points
+    const QList<quint64> movedKeys = chunks.selectChunks(QVector3D(500, 0, 0));
+    qsizetype shared = 0;
+    for (const quint64 key : movedKeys) {
+        if (keys.contains(key)) {
+            shared++;
+        }
+    }
+    QVERIFY(shared > 0);
+    QVERIFY(shared < movedKeys.count());
+
+    chunks.setRegion(QGeoCoordinate(), QGeoCoordinate());
+    QVERIFY(chunks.selectChunks(QVector3D()).isEmpty());
+}
+
+void Viewer3DTerrainChunksTest::_testNormals(void)
+{
+    constexpr int gridSize = 4;
+    constexpr int stride = gridSize + 3;
+    constexpr int count = gridSize + 1;
+    std::vector<float> heights(stride * stride);
+    std::vector<float> normals(count * count * 3);
+
+    // Rising towards the east by one meter per meter
+    for (int i = 0; i < stride; i++) {
+        for (int j = 0; j < stride; j++) {
+            heights[i * stride + j] = 10.0f * j;
+        }
+    }
+    Viewer3DTerrainChunks::computeNormals(heights.data(), gridSize, 10.0f, 10.0f, normals.data());
+    for (int v = 0; v < count * count; v++) {
+        QVERIFY(qAbs(normals[v * 3] + M_SQRT1_2) < 1e-5);
+        QVERIFY(qAbs(normals[v * 3 + 1]) < 1e-5);
+        QVERIFY(qAbs(normals[v * 3 + 2] - M_SQRT1_2) < 1e-5);
+    }
+
+    // Rising towards the south, rows run from north to south
+    for (int i = 0; i < stride; i++) {
+        for (int j = 0; j < stride; j++) {
+            heights[i * stride + j] = 10.0f * i;
+        }
+    }
+    Viewer3DTerrainChunks::computeNormals(heights.data(), gridSize, 10.0f, 10.0f, normals.data());
+    for (int v = 0; v < count * count; v++) {
+        QVERIFY(qAbs(normals[v * 3]) < 1e-5);
+        QVERIFY(qAbs(normals[v * 3 + 1] - M_SQRT1_2) < 1e-5);
+        QVERIFY(qAbs(normals[v * 3 + 2] - M_SQRT1_2) < 1e-5);
+    }
+}
+
+void Viewer3DTerrainChunksTest::_testBuildChunk(void)
+{
+    Viewer3DTerrainChunks::BuildJob job;
+    job.key = 1;
+    job.rect = Viewer3DTerrainChunks::Rect{ 47.40, 8.55, 47.41, 8.56 };
+    job.reference = QGeoCoordinate(47.40, 8.55, 0);
+
+    const int gridSize = job.gridSize;
+    const qsizetype vertices = Viewer3DTerrainChunks::vertexCount(gridSize);
+    const qsizetype surfaceVertices = gridSize * gridSize * 6;
+
+    // Flat
+    Viewer3DTerrainChunks::Chunk chunk = Viewer3DTerrainChunks::buildChunk(job);
+    QVERIFY(!chunk.elevated);
+    QCOMPARE(chunk.vertexData.size(), vertices * Viewer3DTerrainChunks::kFloatsPerVertex * static_cast<qsizetype>(sizeof(float)));
+
+    const float *vertex = reinterpret_cast<const float *>(chunk.vertexData.constData());
+    for (qsizetype v = 0; v < vertices; v++, vertex += Viewer3DTerrainChunks::kFloatsPerVertex) {
+        if (v < surfaceVertices) {
+            QCOMPARE(vertex[2], 0.0f);
+        } else {
+            QVERIFY(vertex[2] <= 0.0f);
+        }
+        QCOMPARE(vertex[5], 1.0f);
+
+        // Reference in the south west corner, the chunk is about 750 m wide and 1100 m high
+        QVERIFY(vertex[0] > -1.0f && vertex[0] < 800.0f);
+        QVERIFY(vertex[1] > -1.0f && vertex[1] < 1200.0f);
+    }
+
+    // Elevated, relative to the height offset
+    job.heights = terrainHeights(gridSize, 0);
+    job.heightOffset = 400.0f;
+    chunk = Viewer3DTerrainChunks::buildChunk(job);
+    QVERIFY(chunk.elevated);
+    QCOMPARE(chunk.vertexData.size(), vertices * Viewer3DTerrainChunks::kFloatsPerVertex * static_cast<qsizetype>(sizeof(float)));
+
+    vertex = reinterpret_cast<const float *>(chunk.vertexData.constData());
+    bool sloped = false;
+    for (qsizetype v = 0; v < surfaceVertices; v++, vertex += Viewer3DTerrainChunks::kFloatsPerVertex) {
+        QVERIFY(qAbs(vertex[2]) <= 50.0f);
+        const float length = std::sqrt(vertex[3] * vertex[3] + vertex[4] * vertex[4] + vertex[5] * vertex[5]);
+        QVERIFY(qAbs(length - 1.0f) < 1e-4f);
+        QVERIFY(vertex[5] > 0);
+        sloped = sloped || (vertex[5] < 0.9999f);
+    }
+    QVERIFY(sloped);
+}
+
+void Viewer3DTerrainChunksTest::_testTextureCoordinates(void)
+{
+    Viewer3DTerrainChunks chunks;
+    setupRegion(chunks);
+
+    const QList<quint64> keys = chunks.selectChunks(QVector3D(0, 0, 0));
+    for (const Viewer3DTerrainChunks::BuildJob &job : chunks.staleChunks(keys, false)) {
+        chunks.insertChunk(Viewer3DTerrainChunks::buildChunk(job));
+    }
+    const QByteArray vertexData = chunks.vertexData(keys);
+    QCOMPARE(vertexData.size(), keys.count() * Viewer3DTerrainChunks::vertexCount(chunks.gridSize()) * Viewer3DTerrainChunks::kFloatsPerVertex * static_cast<qsizetype>(sizeof(float)));
+
+    // The texture covers exactly the region
+    float minS = 10, maxS = -10, minT = 10, maxT = -10;
+    const float *vertex = reinterpret_cast<const float *>(vertexData.constData());
+    const qsizetype vertices = vertexData.size() / (Viewer3DTerrainChunks::kFloatsPerVertex * sizeof(float));
+    for (qsizetype v = 0; v < vertices; v++, vertex += Viewer3DTerrainChunks::kFloatsPerVertex) {
+        minS = qMin(minS, vertex[6]);
+        maxS = qMax(maxS, vertex[6]);
+        minT = qMin(minT, vertex[7]);
+        maxT = qMax(maxT, vertex[7]);
+    }
+    QVERIFY(qAbs(minS) < 1e-4f);
+    QVERIFY(qAbs(maxS - 1.0f) < 1e-4f);
+    QVERIFY(qAbs(minT) < 1e-4f);
+    QVERIFY(qAbs(maxT - 1.0f) < 1e-4f);
+}
+
+void Viewer3DTerrainChunksTest::_testCache(void)
+{
+    Viewer3DTerrainChunks chunks;
+    setupRegion(chunks);
+
+    const QList<quint64> keys = chunks.selectChunks(QVector3D(0, 0, 0));
+    QList<Viewer3DTerrainChunks::BuildJob> jobs = chunks.staleChunks(keys, true);
+    QCOMPARE(jobs.count(), keys.count());
+    for (const Viewer3DTerrainChunks::BuildJob &job : jobs) {
+        QVERIFY(job.heights.empty());
+        chunks.insertChunk(Viewer3DTerrainChunks::buildChunk(job));
+    }
+    QVERIFY(chunks.staleChunks(keys, true).isEmpty());
+    QCOMPARE(chunks.chunkCount(), keys.count());
+
+    // Elevations arriving make the chunk stale, unless elevations are not used
+    const quint64 key = keys.first();
+    const Viewer3DTerrainChunks::Rect rect = chunks.chunkRect(key);
+    QVERIFY(!chunks.hasHeights(key, rect));
+    chunks.setHeights(key, rect, terrainHeights(chunks.gridSize(), 1));
+    QVERIFY(chunks.hasHeights(key, rect));
+    QVERIFY(chunks.staleChunks(keys, false).isEmpty());
+    jobs = chunks.staleChunks(keys, true);
+    QCOMPARE(jobs.count(), 1);
+    QCOMPARE(jobs.first().key, key);
+    QVERIFY(!jobs.first().heights.empty());
+
+    // No elevations to be had is remembered and leaves the chunk flat
+    chunks.setHeights(keys.last(), chunks.chunkRect(keys.last()), std::vector<float>());
+    QVERIFY(chunks.hasHeights(keys.last(), chunks.chunkRect(keys.last())));
+    QCOMPARE(chunks.staleChunks(keys, true).count(), 1);
+
+    // A chunk built before the height offset changed is not taken
+    const Viewer3DTerrainChunks::Chunk elevated = Viewer3DTerrainChunks::buildChunk(jobs.first());
+    chunks.setHeightOffset(400.0f);
+    chunks.insertChunk(elevated);
+    QCOMPARE(chunks.staleChunks(keys, true).count(), 1);
+    chunks.insertChunk(Viewer3DTerrainChunks::buildChunk(chunks.staleChunks(keys, true).first()));
+    QVERIFY(chunks.staleChunks(keys, true).isEmpty());
+
+    // Elevated chunks are dropped by a height offset change, nothing survives a new reference
+    chunks.setHeightOffset(500.0f);
+    QVERIFY(!chunks.hasChunk(key));
+    QCOMPARE(chunks.chunkCount(), keys.count() - 1);
+    chunks.setReference(QGeoCoordinate(47.41, 8.56, 0));
+    QCOMPARE(chunks.chunkCount(), 0);
+
+    // Shrinking the region changes the chunks along its edge only
+    setupRegion(chunks);
+    for (const Viewer3DTerrainChunks::BuildJob &job : chunks.staleChunks(keys, false)) {
+        chunks.insertChunk(Viewer3DTerrainChunks::buildChunk(job));
+    }
+    chunks.setRegion(QGeoCoordinate(47.35, 8.50), QGeoCoordinate(47.449, 8.60));
+    const QList<quint64> shrunkKeys = chunks.selectChunks(QVector3D(0, 0, 0));
+    const qsizetype stale = chunks.staleChunks(shrunkKeys, false).count();
+    QVERIFY(stale > 0);
+    QVERIFY(stale < shrunkKeys.count());
+}
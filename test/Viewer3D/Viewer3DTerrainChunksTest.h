@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <vector>
+
+class Viewer3DTerrainChunks;
+
+class Viewer3DTerrainChunksTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// A 0.1 x 0.1 degree region with the reference in its middle
+    static void setupRegion(Viewer3DTerrainChunks &chunks);
+
+    /// Elevations for a chunk, a few hills in every direction
+    static std::vector<float> terrainHeights(int gridSize, int seed);
+
+private slots:
+    void _testSelect(void);
+    void _testNormals(void);
+    void _testBuildChunk(void);
+    void _testTextureCoordinates(void);
+    void _testCache(void);
+};
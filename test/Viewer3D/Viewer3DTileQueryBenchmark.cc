@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Viewer3DTileQueryBenchmark.h"
+#include "Viewer3DTileQueryTest.h"
+#include "Viewer3DTileQuery.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtTest/QTest>
+
+void Viewer3DTileQueryBenchmark::_benchmarkComposite(void)
+{
+    // The largest texture the loader asks for, 14 x 14 tiles
+    constexpr int kTiles = 14;
+    MapTileQuery::MapTileContainer_t container;
+    container.init(15, QPoint(0, 0), QPoint(kTiles - 1, kTiles - 1));
+
+    const QList<QColor> colors = { Qt::red, Qt::green, Qt::blue, Qt::yellow, Qt::cyan, Qt::magenta };
+    QList<QPair<QPoint, QByteArray>> tiles;
+    for (int x = 0; x < kTiles; x++) {
+        for (int y = 0; y < kTiles; y++) {
+            tiles.append(qMakePair(QPoint(x, y), Viewer3DTileQueryTest::encodedTile(colors[(x + y) % colors.count()], container.L)));
+        }
+    }
+
+    const int generation = container.generation;
+    const int L = container.L;
+    QBENCHMARK {
+        QtConcurrent::blockingMap(tiles, [&container, generation, L](const QPair<QPoint, QByteArray> &tile) {
+            (void) container.setMapTile(tile.first, MapTileQuery::MapTileContainer_t::decodeTile(tile.second, L), generation);
+        });
+    }
+
+    Viewer3DTileQueryTest::checkPixel(container, QPoint(L + 1, 0), colors[1]);
+}
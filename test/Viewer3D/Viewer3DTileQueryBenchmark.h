@@ -0,0 +1,21 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Decode and composite time of a full map texture. Only run when requested with --unittest:Viewer3DTileQueryBenchmark.
+class Viewer3DTileQueryBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _benchmarkComposite(void);
+};
@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Viewer3DTileQueryTest.h"
+
+#include <QtCore/QBuffer>
+#include <QtTest/QTest>
+
+QByteArray Viewer3DTileQueryTest::encodedTile(const QColor &color, int L)
+{
+    QImage image(L, L, QImage::Format_RGB32);
+    image.fill(color);
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    (void) buffer.open(QIODevice::WriteOnly);
+    (void) image.save(&buffer, "PNG");
+    return data;
+}
+
+void Viewer3DTileQueryTest::checkPixel(const MapTileQuery::MapTileContainer_t &container, const QPoint &pixel, const QColor &color)
+{
+    const QByteArray data = container.getMapData();
+    const qsizetype offset = (static_cast<qsizetype>(pixel.y()) * container.mapWidth + pixel.x()) * 4;
+    QCOMPARE_GE(data.size(), offset + 4);
+    QCOMPARE(static_cast<uchar>(data[offset]), static_cast<uchar>(color.red()));
+    QCOMPARE(static_cast<uchar>(data[offset + 1]), static_cast<uchar>(color.green()));
+    QCOMPARE(static_cast<uchar>(data[offset + 2]), static_cast<uchar>(color.blue()));
+    QCOMPARE(static_cast<uchar>(data[offset + 3]), static_cast<uchar>(255));
+}
+
+void Viewer3DTileQueryTest::_testComposite(void)
+{
+    MapTileQuery::MapTileContainer_t container;
+    container.init(10, QPoint(100, 200), QPoint(101, 200));
+    QCOMPARE(container.mapWidth, 2 * container.L);
+    QCOMPARE(container.mapHeight, container.L);
+    QCOMPARE(container.getMapData().size(), static_cast<qsizetype>(container.mapWidth) * container.mapHeight * 4);
+
+    const QImage tile = MapTileQuery::MapTileContainer_t::decodeTile(encodedTile(Qt::red, container.L), container.L);
+    QVERIFY(!tile.isNull());
+    QVERIFY(container.setMapTile(QPoint(101, 200), tile, container.generation));
+
+    // Right half red, left half still the gray placeholder
+    checkPixel(container, QPoint(container.L, 0), Qt::red);
+    checkPixel(container, QPoint(2 * container.L - 1, container.L - 1), Qt::red);
+    checkPixel(container, QPoint(container.L - 1, 0), Qt::gray);
+
+    // Tiles of another size are scaled to fit
+    const QImage smallTile = MapTileQuery::MapTileContainer_t::decodeTile(encodedTile(Qt::blue, 64), container.L);
+    QCOMPARE(smallTile.size(), QSize(container.L, container.L));
+    QVERIFY(container.setMapTile(QPoint(100, 200), smallTile, container.generation));
+    checkPixel(container, QPoint(0, 0), Qt::blue);
+
+    // Outside the tile range
+    QVERIFY(!container.setMapTile(QPoint(102, 200), tile, container.generation));
+    QVERIFY(!container.setMapTile(QPoint(100, 201), tile, container.generation));
+
+    QVERIFY(MapTileQuery::MapTileContainer_t::decodeTile(QByteArray("not an image"), container.L).isNull());
+}
+
+void Viewer3DTileQueryTest::_testStaleTile(void)
+{
+    MapTileQuery::MapTileContainer_t container;
+    container.init(10, QPoint(0, 0), QPoint(0, 0));
+    const int oldGeneration = container.generation;
+
+    const QImage tile = MapTileQuery::MapTileContainer_t::decodeTile(encodedTile(Qt::red, container.L), container.L);
+
+    // A tile decoded for the previous zoom level finishes after the texture was laid out again
+    container.init(9, QPoint(0, 0), QPoint(1, 1));
+    QVERIFY(container.generation != oldGeneration);
+    QVERIFY(!container.setMapTile(QPoint(0, 0), tile, oldGeneration));
+    checkPixel(container, QPoint(0, 0), Qt::gray);
+
+    QVERIFY(container.setMapTile(QPoint(0, 0), tile, container.generation));
+    checkPixel(container, QPoint(0, 0), Qt::red);
+}
@@ -0,0 +1,29 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "Viewer3DTileQuery.h"
+
+class Viewer3DTileQueryTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// PNG encoded L x L tile of a single color
+    static QByteArray encodedTile(const QColor &color, int L);
+
+    /// Compares a texture pixel, which is RGBA with 8 bits per channel
+    static void checkPixel(const MapTileQuery::MapTileContainer_t &container, const QPoint &pixel, const QColor &color);
+
+private slots:
+    void _testComposite(void);
+    void _testStaleTile(void);
+};